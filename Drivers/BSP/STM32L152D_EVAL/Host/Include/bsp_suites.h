@@ -0,0 +1,55 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        bsp_suites.h
+*
+* Description:  Check and benchmark suites of the host build, one per
+*               BSP driver.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#ifndef _BSP_SUITES_H
+#define _BSP_SUITES_H
+
+#include "host_util.h"
+#include "host_bsp.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Suite of one driver.
+ */
+typedef struct
+{
+  const char *name;               /**< driver name */
+  void (*bench)(void);            /**< counts the device transactions of the driver, or NULL */
+  void (*check)(void);            /**< checks the driver against its model */
+} host_suite_t;
+
+void check_eeprom(void);
+void check_sdlog(void);
+void check_sdcache(void);
+void check_nordb(void);
+void check_extmem(void);
+void bench_lcd(void);
+void check_lcd(void);
+
+/**
+ * @brief All the suites, in the order they run.
+ */
+#define HOST_SUITES                                              \
+  { "eeprom",     NULL,             check_eeprom     },          \
+  { "sdlog",      NULL,             check_sdlog      },          \
+  { "sdcache",    NULL,             check_sdcache    },          \
+  { "nordb",      NULL,             check_nordb      },          \
+  { "extmem",     NULL,             check_extmem     },          \
+  { "lcd",        bench_lcd,        check_lcd        }
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _BSP_SUITES_H */
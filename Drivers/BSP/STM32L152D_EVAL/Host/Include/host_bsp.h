@@ -0,0 +1,170 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        host_bsp.h
+*
+* Description:  Host models of the devices of the board, behind the link
+*               functions of stm32l152d_eval.c and the SD and NOR
+*               functions of stm32l152d_eval_sd.c and stm32l152d_eval_nor.c
+*               that the BSP drivers call: serial EEPROMs on the I2C and
+*               SPI buses, a uSD card kept in a file, with power failures
+*               injected during its writes, a NOR flash mapped at its FSMC
+*               address, with power failures during its programs and
+*               erases, the external SRAM and the TFT LCD controller on
+*               the FSMC.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#ifndef _HOST_BSP_H
+#define _HOST_BSP_H
+
+#include "host_hal.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/* ----------------------------------------------------------------------
+*       Serial EEPROMs
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief Counters of one serial EEPROM, since host_serial_reset().
+ */
+typedef struct
+{
+  uint32_t pageWrites;            /**< write instructions carried out */
+  uint32_t bytes;                 /**< bytes programmed */
+  uint32_t polls;                 /**< acknowledge polls or status reads */
+  uint32_t busyAccesses;          /**< reads and writes sent during a write cycle, ignored */
+  uint32_t pageCrossings;         /**< writes wrapped around the end of their page */
+} host_serial_stats_t;
+
+/* The M24LR64 (BSP_EEPROM_M24LR64) answers at EEPROM_ADDRESS_M24LR64_A01
+ * and the M95040 (BSP_EEPROM_M95040) on the SPI bus. A page write starts
+ * a write cycle that lasts the given number of polls: the device ignores
+ * every other access until then */
+void     host_serial_reset(uint32_t cycle);
+void     host_serial_hold(uint8_t DeviceID, int hold);
+void     host_serial_content(uint8_t DeviceID, uint16_t Address, uint8_t *pData, uint32_t Size);
+uint32_t host_serial_size(uint8_t DeviceID);
+void     host_serial_stats(uint8_t DeviceID, host_serial_stats_t *pStats);
+
+/* ----------------------------------------------------------------------
+*       uSD card
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief Block of the write at which a power cut stops, as the card may
+ *        leave it.
+ */
+typedef enum
+{
+  HOST_SD_CUT = 0,                /**< not written */
+  HOST_SD_TORN,                   /**< first half written */
+  HOST_SD_SKIPPED                 /**< not written, the rest of the transfer written */
+} host_sd_cut_t;
+
+/**
+ * @brief Card counters, since host_sd_open().
+ */
+typedef struct
+{
+  uint32_t transfers;             /**< write commands */
+  uint32_t blocksWritten;         /**< blocks programmed */
+  uint32_t reads;                 /**< read commands */
+  uint32_t blocksRead;            /**< blocks read */
+  uint32_t erases;                /**< erase commands */
+} host_sd_stats_t;
+
+/* A power cut stops the card on one of its block programs or erase
+ * commands, then jumps to host_power_fail */
+int      host_sd_open(const char *path, uint32_t blocks);
+void     host_sd_close(void);
+void     host_sd_fill(uint8_t value);
+void     host_sd_power_cut(uint32_t operations, host_sd_cut_t mode);
+void     host_sd_power_on(void);
+void     host_sd_stats(host_sd_stats_t *pStats);
+
+/* ----------------------------------------------------------------------
+*       NOR flash
+* -------------------------------------------------------------------- */
+#define HOST_NOR_BLOCK_SIZE     0x20000u  /* main block */
+#define HOST_NOR_SIZE           (8u * HOST_NOR_BLOCK_SIZE)
+
+/**
+ * @brief State in which a power cut leaves the program or erase it falls on.
+ */
+typedef enum
+{
+  HOST_NOR_CUT = 0,               /**< not started */
+  HOST_NOR_TORN                   /**< program partly done, block of an erase holding random data */
+} host_nor_cut_t;
+
+/**
+ * @brief NOR counters, since host_nor_open().
+ */
+typedef struct
+{
+  uint32_t programs;              /**< write buffer programs */
+  uint32_t erases;                /**< block erases */
+  uint32_t bitSets;               /**< halfwords programmed with a bit set over a cleared one, left cleared */
+  uint32_t refused;               /**< operations out of the memory or across a write buffer page */
+} host_nor_stats_t;
+
+/* The first HOST_NOR_SIZE bytes of the NOR are mapped at NOR_DEVICE_ADDR.
+ * A power cut stops the memory on one of its programs or erases, then
+ * jumps to host_power_fail */
+int      host_nor_open(const char *path);
+void     host_nor_close(void);
+void     host_nor_fill(uint8_t value);
+void     host_nor_load(const uint8_t *pImage, uint32_t size);
+void     host_nor_power_cut(uint32_t operations, host_nor_cut_t mode);
+void     host_nor_power_on(void);
+void     host_nor_stats(host_nor_stats_t *pStats);
+
+/* ----------------------------------------------------------------------
+*       External SRAM
+* -------------------------------------------------------------------- */
+
+/* SRAM_DEVICE_SIZE bytes of read-write memory at SRAM_DEVICE_ADDR */
+int      host_sram_open(void);
+void     host_sram_close(void);
+
+/* ----------------------------------------------------------------------
+*       TFT LCD
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief Controller counters, since host_lcd_reset(). Every field but
+ *        dmaWrites counts CPU accesses on the FSMC.
+ */
+typedef struct
+{
+  uint32_t indexWrites;           /**< index register writes, reads included */
+  uint32_t registerWrites;        /**< register writes */
+  uint32_t cursorWrites;          /**< of which address counter (R32, R33) writes */
+  uint32_t windowWrites;          /**< of which window (R80 to R83) writes */
+  uint32_t pixelWrites;           /**< GRAM writes */
+  uint32_t dmaWrites;             /**< GRAM writes of the DMA */
+  uint32_t reads;                 /**< register and GRAM reads */
+} host_lcd_stats_t;
+
+/* The controller answers as an ILI9325, with its LCD RAM register at
+ * LCD_IO_GetRamAddress() routed to the model for the DMA: host_dma_reset()
+ * must not be called after host_lcd_reset() */
+void     host_lcd_reset(void);
+uint16_t host_lcd_pixel(uint16_t Xpos, uint16_t Ypos);
+uint16_t host_lcd_register(uint8_t Reg);
+void     host_lcd_stats(host_lcd_stats_t *pStats);
+
+/* main() of Utilities/ImageConverter/lcd_image_conv.c, built in:
+ * lcd_image_conv <input.bmp> <output.c> <symbol> */
+int      lcd_image_conv(int argc, char **argv);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _HOST_BSP_H */
@@ -0,0 +1,66 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        bsp_bench.c
+*
+* Description:  Benchmarks of the BSP drivers, on the host.
+*
+*               bsp_bench [-s suite] [pattern]
+*
+*               -s suite    only runs one suite (lcd, ...)
+*               pattern     only runs the cases whose name contains it
+*
+*               Every case drives a device model and prints the device
+*               transactions it costs: the counts are the ones of the
+*               target, the host time is not measured.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bsp_suites.h"
+
+static const host_suite_t suites[] = { HOST_SUITES };
+
+int main(int argc, char *argv[])
+{
+  const char *suite = NULL;
+  uint32_t s, found = 0u;
+  int i;
+
+  for (i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "-s") == 0) && ((i + 1) < argc))
+    {
+      suite = argv[++i];
+    }
+    else if (argv[i][0] != '-')
+    {
+      host_set_filter(argv[i]);
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [-s suite] [pattern]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  for (s = 0u; s < (sizeof(suites) / sizeof(suites[0])); s++)
+  {
+    if ((suites[s].bench != NULL) && ((suite == NULL) || (strcmp(suite, suites[s].name) == 0)))
+    {
+      host_seed(0u);
+      suites[s].bench();
+      found++;
+    }
+  }
+
+  if (found == 0u)
+  {
+    fprintf(stderr, "no benchmark in suite %s\n", suite);
+    return 2;
+  }
+
+  return 0;
+}
@@ -0,0 +1,67 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        bsp_check.c
+*
+* Description:  Checks of the BSP drivers, on the host.
+*
+*               bsp_check [-s suite] [pattern]
+*
+*               Every driver runs on host models of the devices of the
+*               board it uses, on fixed pseudo-random data, and its
+*               results are compared with a reference model of the
+*               driver. The exit status is the number of failed checks.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bsp_suites.h"
+
+static const host_suite_t suites[] = { HOST_SUITES };
+
+int main(int argc, char *argv[])
+{
+  const char *suite = NULL;
+  uint32_t s, found = 0u, passed, failed;
+  int i;
+
+  for (i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "-s") == 0) && ((i + 1) < argc))
+    {
+      suite = argv[++i];
+    }
+    else if (argv[i][0] != '-')
+    {
+      host_set_filter(argv[i]);
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [-s suite] [pattern]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  for (s = 0u; s < (sizeof(suites) / sizeof(suites[0])); s++)
+  {
+    if ((suite == NULL) || (strcmp(suite, suites[s].name) == 0))
+    {
+      host_seed(0u);
+      suites[s].check();
+      found++;
+    }
+  }
+
+  if (found == 0u)
+  {
+    fprintf(stderr, "unknown suite %s\n", suite);
+    return 2;
+  }
+
+  host_check_summary(&passed, &failed);
+  printf("%u passed, %u failed\n", passed, failed);
+
+  return (failed > 125u) ? 125 : (int)failed;
+}
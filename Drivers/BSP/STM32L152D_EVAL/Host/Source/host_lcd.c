@@ -0,0 +1,247 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        host_lcd.c
+*
+* Description:  TFT LCD of the host checks, in place of the LCD link
+*               functions of stm32l152d_eval.c: an ILI9325 controller
+*               behind the FSMC, with its index register, its registers
+*               and its 240 x 320 GRAM.
+*
+*               As on the controller, a write to the GRAM register (R34)
+*               stores the pixel at the address counter (R32, R33), then
+*               moves the counter as the entry mode (R3) tells, wrapping
+*               inside the window (R80 to R83). The LCD RAM register of
+*               the FSMC is a DMA sink, so that the transfers of the DMA
+*               reach the same model as the CPU writes.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <string.h>
+
+#include "host_bsp.h"
+#include "stm32l152d_eval_lcd.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+#define HOST_LCD_H              240u      /* horizontal GRAM addresses */
+#define HOST_LCD_V              320u      /* vertical GRAM addresses */
+#define HOST_LCD_ID             0x9325u
+
+#define HOST_LCD_ENTRY_MODE     0x03u
+#define HOST_LCD_H_ADDRESS      0x20u
+#define HOST_LCD_V_ADDRESS      0x21u
+#define HOST_LCD_GRAM           0x22u
+#define HOST_LCD_H_START        0x50u
+#define HOST_LCD_H_END          0x51u
+#define HOST_LCD_V_START        0x52u
+#define HOST_LCD_V_END          0x53u
+
+static struct
+{
+  uint8_t index;                  /* index register */
+  uint16_t reg[256];
+  uint16_t h;                     /* address counter */
+  uint16_t v;
+  host_lcd_stats_t stats;
+  uint16_t gram[HOST_LCD_H][HOST_LCD_V];
+} hostLcd;
+
+/* LCD RAM register of the FSMC, destination of the DMA transfers */
+static uint16_t hostLcdRam;
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Moves one address of the counter towards an end of the window.
+ * @return 1 when it wraps around to the other end
+ */
+static int host_lcd_step(uint16_t *pAddress, int increment, uint16_t start, uint16_t end)
+{
+  if (increment)
+  {
+    if (*pAddress >= end)
+    {
+      *pAddress = start;
+      return 1;
+    }
+    (*pAddress)++;
+  }
+  else
+  {
+    if (*pAddress <= start)
+    {
+      *pAddress = end;
+      return 1;
+    }
+    (*pAddress)--;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Moves the address counter past one pixel: AM (bit 3) picks the
+ *         direction moved first, I/D0 and I/D1 (bits 4 and 5) increment
+ *         the horizontal and the vertical address.
+ */
+static void host_lcd_advance(void)
+{
+  uint16_t mode = hostLcd.reg[HOST_LCD_ENTRY_MODE];
+  int hInc = ((mode & 0x10u) != 0u), vInc = ((mode & 0x20u) != 0u);
+  uint16_t *reg = hostLcd.reg;
+
+  if ((mode & 0x08u) != 0u)
+  {
+    if (host_lcd_step(&hostLcd.v, vInc, reg[HOST_LCD_V_START], reg[HOST_LCD_V_END]))
+    {
+      (void)host_lcd_step(&hostLcd.h, hInc, reg[HOST_LCD_H_START], reg[HOST_LCD_H_END]);
+    }
+  }
+  else if (host_lcd_step(&hostLcd.h, hInc, reg[HOST_LCD_H_START], reg[HOST_LCD_H_END]))
+  {
+    (void)host_lcd_step(&hostLcd.v, vInc, reg[HOST_LCD_V_START], reg[HOST_LCD_V_END]);
+  }
+}
+
+/**
+ * @brief  Write to the data register, by the CPU or by the DMA.
+ */
+static void host_lcd_data(uint16_t data, int dma)
+{
+  if (hostLcd.index != HOST_LCD_GRAM)
+  {
+    hostLcd.reg[hostLcd.index] = data;
+    hostLcd.stats.registerWrites++;
+    if (hostLcd.index == HOST_LCD_H_ADDRESS)
+    {
+      hostLcd.h = data;
+      hostLcd.stats.cursorWrites++;
+    }
+    else if (hostLcd.index == HOST_LCD_V_ADDRESS)
+    {
+      hostLcd.v = data;
+      hostLcd.stats.cursorWrites++;
+    }
+    else if ((hostLcd.index >= HOST_LCD_H_START) && (hostLcd.index <= HOST_LCD_V_END))
+    {
+      hostLcd.stats.windowWrites++;
+    }
+    return;
+  }
+
+  if ((hostLcd.h < HOST_LCD_H) && (hostLcd.v < HOST_LCD_V))
+  {
+    hostLcd.gram[hostLcd.h][hostLcd.v] = data;
+  }
+  if (dma)
+  {
+    hostLcd.stats.dmaWrites++;
+  }
+  else
+  {
+    hostLcd.stats.pixelWrites++;
+  }
+  host_lcd_advance();
+}
+
+static void host_lcd_sink(void *ctx, uint32_t data)
+{
+  host_lcd_data((uint16_t)data, 1);
+}
+
+/**
+ * @brief  Resets the controller, clears the GRAM and the counters, and
+ *         routes the DMA transfers to the LCD RAM register through the
+ *         model.
+ */
+void host_lcd_reset(void)
+{
+  memset(&hostLcd, 0, sizeof(hostLcd));
+  hostLcd.reg[HOST_LCD_ENTRY_MODE] = 0x0030u;
+  hostLcd.reg[HOST_LCD_H_END] = HOST_LCD_H - 1u;
+  hostLcd.reg[HOST_LCD_V_END] = HOST_LCD_V - 1u;
+  host_dma_sink((uint32_t)(uintptr_t)&hostLcdRam, host_lcd_sink, NULL);
+}
+
+/**
+ * @brief  Pixel shown at a BSP_LCD position: the BSP drives the panel
+ *         with its X along the decreasing vertical GRAM addresses.
+ */
+uint16_t host_lcd_pixel(uint16_t Xpos, uint16_t Ypos)
+{
+  return hostLcd.gram[Ypos % HOST_LCD_H][(HOST_LCD_V - 1u) - (Xpos % HOST_LCD_V)];
+}
+
+uint16_t host_lcd_register(uint8_t Reg)
+{
+  return hostLcd.reg[Reg];
+}
+
+void host_lcd_stats(host_lcd_stats_t *pStats)
+{
+  *pStats = hostLcd.stats;
+}
+
+/* ----------------------------------------------------------------------
+*       Link functions of stm32l152d_eval.c
+* -------------------------------------------------------------------- */
+
+void LCD_IO_Init(void)
+{
+}
+
+void LCD_IO_WriteData(uint16_t RegValue)
+{
+  host_lcd_data(RegValue, 0);
+}
+
+void LCD_IO_WriteMultipleData(uint8_t *pData, uint32_t Size)
+{
+  uint32_t index;
+
+  for (index = 0u; index < (Size / 2u); index++)
+  {
+    host_lcd_data((uint16_t)(pData[2u * index] | (pData[(2u * index) + 1u] << 8)), 0);
+  }
+}
+
+void LCD_IO_WriteReg(uint8_t Reg)
+{
+  hostLcd.index = Reg;
+  hostLcd.stats.indexWrites++;
+}
+
+/**
+ * @brief  Selects a register and reads it: R0 gives the controller ID,
+ *         R34 the pixel at the address counter.
+ */
+uint16_t LCD_IO_ReadData(uint16_t Reg)
+{
+  LCD_IO_WriteReg((uint8_t)Reg);
+  hostLcd.stats.reads++;
+
+  if (hostLcd.index == 0u)
+  {
+    return HOST_LCD_ID;
+  }
+  if (hostLcd.index == HOST_LCD_GRAM)
+  {
+    return ((hostLcd.h < HOST_LCD_H) && (hostLcd.v < HOST_LCD_V)) ? hostLcd.gram[hostLcd.h][hostLcd.v] : 0u;
+  }
+
+  return hostLcd.reg[hostLcd.index];
+}
+
+uint32_t LCD_IO_GetRamAddress(void)
+{
+  return (uint32_t)(uintptr_t)&hostLcdRam;
+}
+
+void LCD_Delay(uint32_t Delay)
+{
+  HAL_Delay(Delay);
+}
@@ -0,0 +1,273 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        host_nor.c
+*
+* Description:  NOR flash of the host checks, in place of the NOR functions
+*               of stm32l152d_eval_nor.c: a file mapped read-only at
+*               NOR_DEVICE_ADDR, so that the drivers read it in place as
+*               through the FSMC, programmed and erased through the
+*               BSP_NOR functions only. As on the M29W128GL, a program
+*               only clears bits, stays inside one 32-halfword write
+*               buffer page, and an erase sets a whole block.
+*
+*               A power cut armed with host_nor_power_cut() stops the
+*               program or erase operation it falls on, before it starts
+*               or torn: the program is left with its first halfwords
+*               written and some bits of the next one cleared, the erase
+*               with the block holding random data. The memory then
+*               jumps to host_power_fail.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "host_bsp.h"
+#include "host_util.h"
+#include "stm32l152d_eval_nor.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+#define HOST_NOR_PAGE           64u       /* write buffer page, bytes */
+
+static int hostNorFile = -1;
+static uint32_t hostCutArmed = 0u;
+static uint32_t hostCutAfter = 0u;        /* operations left before the cut */
+static host_nor_cut_t hostCutMode = HOST_NOR_CUT;
+static host_nor_stats_t hostNorStats;
+
+/* ----------------------------------------------------------------------
+*       Memory
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Maps the NOR file at NOR_DEVICE_ADDR, erased, and clears the
+ *         counters.
+ * @return 0, or -1 when the file or the mapping cannot be set up
+ */
+int host_nor_open(const char *path)
+{
+  void *map;
+
+  hostNorFile = open(path, O_RDWR | O_CREAT, 0644);
+  if ((hostNorFile < 0) || (ftruncate(hostNorFile, HOST_NOR_SIZE) != 0))
+  {
+    return -1;
+  }
+
+  map = mmap((void *)(uintptr_t)NOR_DEVICE_ADDR, HOST_NOR_SIZE, PROT_READ,
+             MAP_SHARED | MAP_FIXED_NOREPLACE, hostNorFile, 0);
+  if (map != (void *)(uintptr_t)NOR_DEVICE_ADDR)
+  {
+    close(hostNorFile);
+    hostNorFile = -1;
+    return -1;
+  }
+
+  host_nor_fill(0xFFu);
+  hostCutArmed = 0u;
+  memset(&hostNorStats, 0, sizeof(hostNorStats));
+
+  return 0;
+}
+
+/**
+ * @brief  Unmaps the NOR; its content stays in the file.
+ */
+void host_nor_close(void)
+{
+  munmap((void *)(uintptr_t)NOR_DEVICE_ADDR, HOST_NOR_SIZE);
+  close(hostNorFile);
+  hostNorFile = -1;
+}
+
+/**
+ * @brief  Sets every byte of the NOR, as another firmware could have left
+ *         it.
+ */
+void host_nor_fill(uint8_t value)
+{
+  uint8_t page[4096];
+  uint32_t offset;
+
+  memset(page, value, sizeof(page));
+  for (offset = 0u; offset < HOST_NOR_SIZE; offset += sizeof(page))
+  {
+    if (pwrite(hostNorFile, page, sizeof(page), offset) != (ssize_t)sizeof(page))
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief  Sets the first bytes of the NOR, as saved from NOR_DEVICE_ADDR.
+ */
+void host_nor_load(const uint8_t *pImage, uint32_t size)
+{
+  (void)pwrite(hostNorFile, pImage, size, 0);
+}
+
+/**
+ * @brief  Arms a power cut on a program or erase operation.
+ * @param  operations  operations that complete before the cut
+ * @param  mode        state in which the interrupted operation leaves the memory
+ */
+void host_nor_power_cut(uint32_t operations, host_nor_cut_t mode)
+{
+  hostCutArmed = 1u;
+  hostCutAfter = operations;
+  hostCutMode = mode;
+}
+
+/**
+ * @brief  Disarms the power cut.
+ */
+void host_nor_power_on(void)
+{
+  hostCutArmed = 0u;
+}
+
+void host_nor_stats(host_nor_stats_t *pStats)
+{
+  *pStats = hostNorStats;
+}
+
+/**
+ * @brief  Tells whether the armed power cut falls on this operation.
+ */
+static int host_nor_cut(void)
+{
+  if (hostCutArmed && (hostCutAfter-- == 0u))
+  {
+    hostCutArmed = 0u;
+    return 1;
+  }
+
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+*       NOR functions of stm32l152d_eval_nor.c
+* -------------------------------------------------------------------- */
+
+uint8_t BSP_NOR_Init(void)
+{
+  return (hostNorFile < 0) ? NOR_STATUS_ERROR : NOR_STATUS_OK;
+}
+
+void BSP_NOR_ReturnToReadMode(void)
+{
+}
+
+uint8_t BSP_NOR_ReadData(uint32_t uwStartAddress, uint16_t *pData, uint32_t uwDataSize)
+{
+  if ((uwStartAddress + (2u * uwDataSize)) > HOST_NOR_SIZE)
+  {
+    return NOR_STATUS_ERROR;
+  }
+  memcpy(pData, (const void *)(uintptr_t)(NOR_DEVICE_ADDR + uwStartAddress), 2u * uwDataSize);
+
+  return NOR_STATUS_OK;
+}
+
+/**
+ * @brief  Write buffer program at an FSMC address, inside one page: the
+ *         halfwords are ANDed into the memory.
+ */
+uint8_t BSP_NOR_ProgramData(uint32_t uwStartAddress, uint16_t *pData, uint32_t uwDataSize)
+{
+  uint32_t offset = uwStartAddress - NOR_DEVICE_ADDR, i, torn;
+  uint16_t data[HOST_NOR_PAGE / 2u];
+  const uint16_t *pmemory = (const uint16_t *)(uintptr_t)uwStartAddress;
+
+  if ((uwStartAddress < NOR_DEVICE_ADDR) || ((offset % 2u) != 0u) || (uwDataSize == 0u) ||
+      ((offset + (2u * uwDataSize)) > HOST_NOR_SIZE) ||
+      ((offset / HOST_NOR_PAGE) != ((offset + (2u * uwDataSize) - 1u) / HOST_NOR_PAGE)))
+  {
+    hostNorStats.refused++;
+    return NOR_STATUS_ERROR;
+  }
+
+  for (i = 0u; i < uwDataSize; i++)
+  {
+    data[i] = pmemory[i] & pData[i];
+    hostNorStats.bitSets += ((pmemory[i] & pData[i]) != pData[i]) ? 1u : 0u;
+  }
+
+  if (host_nor_cut())
+  {
+    if (hostCutMode == HOST_NOR_CUT)
+    {
+      longjmp(host_power_fail, 1);
+    }
+    torn = host_below(uwDataSize);
+    data[torn] = (uint16_t)(pmemory[torn] & ~((pmemory[torn] & ~data[torn]) & (uint16_t)host_random()));
+    (void)pwrite(hostNorFile, data, 2u * (torn + 1u), offset);
+    longjmp(host_power_fail, 1);
+  }
+
+  if (pwrite(hostNorFile, data, 2u * uwDataSize, offset) != (ssize_t)(2u * uwDataSize))
+  {
+    return NOR_STATUS_ERROR;
+  }
+  hostNorStats.programs++;
+
+  return NOR_STATUS_OK;
+}
+
+/**
+ * @brief  Erases the block holding a NOR offset.
+ */
+uint8_t BSP_NOR_Erase_Block(uint32_t BlockAddress)
+{
+  static uint8_t block[HOST_NOR_BLOCK_SIZE];
+  uint32_t offset = BlockAddress - (BlockAddress % HOST_NOR_BLOCK_SIZE);
+
+  if (BlockAddress >= HOST_NOR_SIZE)
+  {
+    hostNorStats.refused++;
+    return NOR_STATUS_ERROR;
+  }
+
+  if (host_nor_cut())
+  {
+    if (hostCutMode == HOST_NOR_CUT)
+    {
+      longjmp(host_power_fail, 1);
+    }
+    host_bytes(block, sizeof(block));
+    (void)pwrite(hostNorFile, block, sizeof(block), offset);
+    longjmp(host_power_fail, 1);
+  }
+
+  memset(block, 0xFF, sizeof(block));
+  if (pwrite(hostNorFile, block, sizeof(block), offset) != (ssize_t)sizeof(block))
+  {
+    return NOR_STATUS_ERROR;
+  }
+  hostNorStats.erases++;
+
+  return NOR_STATUS_OK;
+}
+
+uint8_t BSP_NOR_Erase_Chip(void)
+{
+  uint32_t offset;
+
+  for (offset = 0u; offset < HOST_NOR_SIZE; offset += HOST_NOR_BLOCK_SIZE)
+  {
+    if (BSP_NOR_Erase_Block(offset) != NOR_STATUS_OK)
+    {
+      return NOR_STATUS_ERROR;
+    }
+  }
+
+  return NOR_STATUS_OK;
+}
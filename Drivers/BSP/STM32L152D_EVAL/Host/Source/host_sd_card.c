@@ -0,0 +1,289 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        host_sd_card.c
+*
+* Description:  uSD card of the host checks, in place of the SD functions
+*               of stm32l152d_eval_sd.c: a file of 512-byte blocks, read
+*               and written with the byte addresses and block counts of
+*               the BSP_SD functions. Erased blocks read as 0.
+*
+*               A power cut armed with host_sd_power_cut() stops the
+*               block program or the erase command it falls on. The
+*               block is left as it was or half written, or left as it
+*               was while the rest of the multi-block transfer is
+*               written, as a card programming its buffer out of order
+*               could leave it. The card then jumps to host_power_fail:
+*               the file holds what a target would find after the reset.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host_bsp.h"
+#include "stm32l152d_eval_sd.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+#define HOST_SD_BLOCK_SIZE      512u
+
+static int hostSdFile = -1;
+static uint32_t hostSdBlocks = 0u;
+static uint32_t hostCutArmed = 0u;
+static uint32_t hostCutAfter = 0u;        /* operations left before the cut */
+static host_sd_cut_t hostCutMode = HOST_SD_CUT;
+static host_sd_stats_t hostSdStats;
+
+/* ----------------------------------------------------------------------
+*       Card
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Opens the card file, creating it erased when it does not
+ *         exist, and clears the counters.
+ * @return 0, or -1 when the file cannot be set up
+ */
+int host_sd_open(const char *path, uint32_t blocks)
+{
+  hostSdFile = open(path, O_RDWR | O_CREAT, 0644);
+  if ((hostSdFile < 0) || (ftruncate(hostSdFile, (off_t)blocks * HOST_SD_BLOCK_SIZE) != 0))
+  {
+    return -1;
+  }
+
+  hostSdBlocks = blocks;
+  hostCutArmed = 0u;
+  memset(&hostSdStats, 0, sizeof(hostSdStats));
+
+  return 0;
+}
+
+/**
+ * @brief  Closes the card file; its content stays in the file.
+ */
+void host_sd_close(void)
+{
+  close(hostSdFile);
+  hostSdFile = -1;
+}
+
+/**
+ * @brief  Sets every byte of the card, as another use could have left it.
+ */
+void host_sd_fill(uint8_t value)
+{
+  uint8_t block[HOST_SD_BLOCK_SIZE];
+  uint32_t b;
+
+  memset(block, value, sizeof(block));
+  for (b = 0u; b < hostSdBlocks; b++)
+  {
+    if (pwrite(hostSdFile, block, sizeof(block), (off_t)b * HOST_SD_BLOCK_SIZE) != (ssize_t)sizeof(block))
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief  Arms a power cut on a block program or an erase command.
+ * @param  operations  block programs and erase commands that complete
+ *                     before the cut
+ * @param  mode        state in which the interrupted write leaves its blocks
+ */
+void host_sd_power_cut(uint32_t operations, host_sd_cut_t mode)
+{
+  hostCutArmed = 1u;
+  hostCutAfter = operations;
+  hostCutMode = mode;
+}
+
+/**
+ * @brief  Disarms the power cut.
+ */
+void host_sd_power_on(void)
+{
+  hostCutArmed = 0u;
+}
+
+void host_sd_stats(host_sd_stats_t *pStats)
+{
+  *pStats = hostSdStats;
+}
+
+/**
+ * @brief  Checks a BSP_SD access: whole blocks inside the card.
+ * @return first block, or hostSdBlocks when the access is refused
+ */
+static uint32_t host_sd_first(uint64_t address, uint32_t blockSize, uint32_t blocks)
+{
+  if ((hostSdFile < 0) || (blockSize != HOST_SD_BLOCK_SIZE) || ((address % HOST_SD_BLOCK_SIZE) != 0u) ||
+      ((address / HOST_SD_BLOCK_SIZE) + blocks > hostSdBlocks))
+  {
+    return hostSdBlocks;
+  }
+
+  return (uint32_t)(address / HOST_SD_BLOCK_SIZE);
+}
+
+/**
+ * @brief  Programs one block.
+ * @return 0, or -1 when the file cannot be written
+ */
+static int host_sd_program(uint32_t block, const uint8_t *pData, uint32_t size)
+{
+  return (pwrite(hostSdFile, pData, size, (off_t)block * HOST_SD_BLOCK_SIZE) == (ssize_t)size) ? 0 : -1;
+}
+
+/**
+ * @brief  Counts one operation, and tells whether the armed power cut
+ *         falls on it.
+ */
+static int host_sd_cut(void)
+{
+  if (hostCutArmed && (hostCutAfter-- == 0u))
+  {
+    hostCutArmed = 0u;
+    return 1;
+  }
+
+  return 0;
+}
+
+static uint8_t host_sd_write(const uint8_t *pData, uint64_t address, uint32_t blockSize, uint32_t blocks)
+{
+  uint32_t first = host_sd_first(address, blockSize, blocks), b;
+
+  if ((first == hostSdBlocks) || (blocks == 0u))
+  {
+    return MSD_ERROR;
+  }
+
+  hostSdStats.transfers++;
+  for (b = 0u; b < blocks; b++, pData += HOST_SD_BLOCK_SIZE)
+  {
+    if (host_sd_cut())
+    {
+      if (hostCutMode == HOST_SD_TORN)
+      {
+        (void)host_sd_program(first + b, pData, HOST_SD_BLOCK_SIZE / 2u);
+      }
+      else if (hostCutMode == HOST_SD_SKIPPED)
+      {
+        for (b++, pData += HOST_SD_BLOCK_SIZE; b < blocks; b++, pData += HOST_SD_BLOCK_SIZE)
+        {
+          (void)host_sd_program(first + b, pData, HOST_SD_BLOCK_SIZE);
+        }
+      }
+      longjmp(host_power_fail, 1);
+    }
+    if (host_sd_program(first + b, pData, HOST_SD_BLOCK_SIZE) != 0)
+    {
+      return MSD_ERROR;
+    }
+    hostSdStats.blocksWritten++;
+  }
+
+  return MSD_OK;
+}
+
+static uint8_t host_sd_read(uint8_t *pData, uint64_t address, uint32_t blockSize, uint32_t blocks)
+{
+  uint32_t first = host_sd_first(address, blockSize, blocks);
+
+  if ((first == hostSdBlocks) ||
+      (pread(hostSdFile, pData, (size_t)blocks * HOST_SD_BLOCK_SIZE, (off_t)first * HOST_SD_BLOCK_SIZE) !=
+       (ssize_t)blocks * HOST_SD_BLOCK_SIZE))
+  {
+    return MSD_ERROR;
+  }
+  hostSdStats.reads++;
+  hostSdStats.blocksRead += blocks;
+
+  return MSD_OK;
+}
+
+/* ----------------------------------------------------------------------
+*       SD functions of stm32l152d_eval_sd.c
+* -------------------------------------------------------------------- */
+
+uint8_t BSP_SD_Init(void)
+{
+  return (hostSdFile < 0) ? MSD_ERROR : MSD_OK;
+}
+
+uint8_t BSP_SD_IsDetected(void)
+{
+  return SD_PRESENT;
+}
+
+uint8_t BSP_SD_ReadBlocks(uint32_t *pData, uint64_t ReadAddr, uint32_t BlockSize, uint32_t NumOfBlocks)
+{
+  return host_sd_read((uint8_t *)pData, ReadAddr, BlockSize, NumOfBlocks);
+}
+
+uint8_t BSP_SD_WriteBlocks(uint32_t *pData, uint64_t WriteAddr, uint32_t BlockSize, uint32_t NumOfBlocks)
+{
+  return host_sd_write((const uint8_t *)pData, WriteAddr, BlockSize, NumOfBlocks);
+}
+
+uint8_t BSP_SD_ReadBlocks_DMA(uint32_t *pData, uint64_t ReadAddr, uint32_t BlockSize, uint32_t NumOfBlocks)
+{
+  return host_sd_read((uint8_t *)pData, ReadAddr, BlockSize, NumOfBlocks);
+}
+
+uint8_t BSP_SD_WriteBlocks_DMA(uint32_t *pData, uint64_t WriteAddr, uint32_t BlockSize, uint32_t NumOfBlocks)
+{
+  return host_sd_write((const uint8_t *)pData, WriteAddr, BlockSize, NumOfBlocks);
+}
+
+/**
+ * @brief  Erases the blocks of a byte range, ends included.
+ */
+uint8_t BSP_SD_Erase(uint64_t StartAddr, uint64_t EndAddr)
+{
+  uint8_t block[HOST_SD_BLOCK_SIZE];
+  uint32_t first, last, b;
+
+  if (EndAddr < StartAddr)
+  {
+    return MSD_ERROR;
+  }
+  first = host_sd_first(StartAddr - (StartAddr % HOST_SD_BLOCK_SIZE), HOST_SD_BLOCK_SIZE, 1u);
+  last = host_sd_first(EndAddr - (EndAddr % HOST_SD_BLOCK_SIZE), HOST_SD_BLOCK_SIZE, 1u);
+  if ((first == hostSdBlocks) || (last == hostSdBlocks))
+  {
+    return MSD_ERROR;
+  }
+
+  if (host_sd_cut())
+  {
+    longjmp(host_power_fail, 1);
+  }
+  memset(block, 0, sizeof(block));
+  for (b = first; b <= last; b++)
+  {
+    if (host_sd_program(b, block, HOST_SD_BLOCK_SIZE) != 0)
+    {
+      return MSD_ERROR;
+    }
+  }
+  hostSdStats.erases++;
+
+  return MSD_OK;
+}
+
+HAL_SD_TransferStateTypedef BSP_SD_GetStatus(void)
+{
+  return SD_TRANSFER_OK;
+}
+
+void BSP_SD_GetCardInfo(HAL_SD_CardInfoTypedef *CardInfo)
+{
+  memset(CardInfo, 0, sizeof(*CardInfo));
+  CardInfo->CardCapacity = (uint64_t)hostSdBlocks * HOST_SD_BLOCK_SIZE;
+  CardInfo->CardBlockSize = HOST_SD_BLOCK_SIZE;
+}
@@ -0,0 +1,265 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        host_serial_eeprom.c
+*
+* Description:  Serial EEPROMs of the host checks, in place of the I2C
+*               and SPI EEPROM link functions of stm32l152d_eval.c: the
+*               8 KB M24LR64 with 4-byte pages and the 512-byte M95040
+*               with 16-byte pages.
+*
+*               As the real devices, a write stays within its page,
+*               wrapping around to the start of the page, and starts a
+*               write cycle during which the device ignores reads and
+*               writes: the I2C device does not acknowledge them, the
+*               SPI device drops the write and returns 0xFF. The cycle
+*               only ends after the driver has polled the device enough
+*               times, so that a missing poll shows in the content and
+*               in the counters.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <string.h>
+
+#include "host_bsp.h"
+#include "stm32l152d_eval_eeprom.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+#define HOST_SERIAL_MAX_SIZE    8192u
+
+typedef struct
+{
+  uint32_t size;                  /* bytes */
+  uint32_t page;                  /* page size, bytes */
+  uint32_t busy;                  /* polls left in the write cycle */
+  int hold;                       /* the write cycle never ends */
+  host_serial_stats_t stats;
+  uint8_t mem[HOST_SERIAL_MAX_SIZE];
+} host_serial_t;
+
+static host_serial_t hostI2c = { .size = 8192u, .page = EEPROM_PAGESIZE_M24LR64 };
+static host_serial_t hostSpi = { .size = 512u, .page = EEPROM_PAGESIZE_M95040 };
+static uint32_t hostCycle = 1u;
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+
+static host_serial_t *host_serial_device(uint8_t DeviceID)
+{
+  return (DeviceID == BSP_EEPROM_M95040) ? &hostSpi : &hostI2c;
+}
+
+/**
+ * @brief  Erases both devices, ends their write cycles and clears the
+ *         counters.
+ * @param  cycle  polls of a write cycle
+ */
+void host_serial_reset(uint32_t cycle)
+{
+  host_serial_t *device[2] = { &hostI2c, &hostSpi };
+  uint32_t d;
+
+  for (d = 0u; d < 2u; d++)
+  {
+    memset(device[d]->mem, 0xFF, sizeof(device[d]->mem));
+    memset(&device[d]->stats, 0, sizeof(device[d]->stats));
+    device[d]->busy = 0u;
+    device[d]->hold = 0;
+  }
+  hostCycle = cycle;
+}
+
+/**
+ * @brief  Keeps the write cycle of a device running, or lets it end.
+ */
+void host_serial_hold(uint8_t DeviceID, int hold)
+{
+  host_serial_device(DeviceID)->hold = hold;
+}
+
+/**
+ * @brief  Reads the content of a device, whatever its state.
+ */
+void host_serial_content(uint8_t DeviceID, uint16_t Address, uint8_t *pData, uint32_t Size)
+{
+  host_serial_t *device = host_serial_device(DeviceID);
+  uint32_t i;
+
+  for (i = 0u; i < Size; i++)
+  {
+    pData[i] = device->mem[(Address + i) % device->size];
+  }
+}
+
+uint32_t host_serial_size(uint8_t DeviceID)
+{
+  return host_serial_device(DeviceID)->size;
+}
+
+void host_serial_stats(uint8_t DeviceID, host_serial_stats_t *pStats)
+{
+  *pStats = host_serial_device(DeviceID)->stats;
+}
+
+/**
+ * @brief  One write instruction: programs the bytes within the page of
+ *         Address, then starts the write cycle.
+ * @return 0, or -1 when the device is in a write cycle
+ */
+static int host_serial_write(host_serial_t *device, uint16_t Address, const uint8_t *pData, uint32_t Size)
+{
+  uint32_t base, offset, i;
+
+  if ((device->busy != 0u) || device->hold)
+  {
+    device->stats.busyAccesses++;
+    return -1;
+  }
+
+  Address %= device->size;
+  base = Address - (Address % device->page);
+  offset = Address - base;
+  if ((offset + Size) > device->page)
+  {
+    device->stats.pageCrossings++;
+  }
+  for (i = 0u; i < Size; i++)
+  {
+    device->mem[base + ((offset + i) % device->page)] = pData[i];
+  }
+
+  device->stats.pageWrites++;
+  device->stats.bytes += Size;
+  device->busy = hostCycle;
+
+  return 0;
+}
+
+/**
+ * @brief  One read instruction.
+ * @return 0, or -1 when the device is in a write cycle
+ */
+static int host_serial_read(host_serial_t *device, uint16_t Address, uint8_t *pData, uint32_t Size)
+{
+  uint32_t i;
+
+  if ((device->busy != 0u) || device->hold)
+  {
+    device->stats.busyAccesses++;
+    return -1;
+  }
+
+  for (i = 0u; i < Size; i++)
+  {
+    pData[i] = device->mem[(Address + i) % device->size];
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  One acknowledge poll or status read.
+ * @return 0 once the write cycle has ended
+ */
+static int host_serial_poll(host_serial_t *device)
+{
+  device->stats.polls++;
+  if (device->hold)
+  {
+    return -1;
+  }
+  if (device->busy == 0u)
+  {
+    return 0;
+  }
+  device->busy--;
+
+  return -1;
+}
+
+/* ----------------------------------------------------------------------
+*       Link functions of stm32l152d_eval.c
+* -------------------------------------------------------------------- */
+
+void EEPROM_I2C_IO_Init(void)
+{
+}
+
+HAL_StatusTypeDef EEPROM_I2C_IO_WriteData(uint16_t DevAddress, uint16_t MemAddress, uint8_t* pBuffer, uint32_t BufferSize)
+{
+  if ((DevAddress != EEPROM_ADDRESS_M24LR64_A01) || (host_serial_write(&hostI2c, MemAddress, pBuffer, BufferSize) != 0))
+  {
+    return HAL_ERROR;
+  }
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef EEPROM_I2C_IO_ReadData(uint16_t DevAddress, uint16_t MemAddress, uint8_t* pBuffer, uint32_t BufferSize)
+{
+  if ((DevAddress != EEPROM_ADDRESS_M24LR64_A01) || (host_serial_read(&hostI2c, MemAddress, pBuffer, BufferSize) != 0))
+  {
+    return HAL_ERROR;
+  }
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef EEPROM_I2C_IO_IsDeviceReady(uint16_t DevAddress, uint32_t Trials)
+{
+  uint32_t trial;
+
+  if (DevAddress != EEPROM_ADDRESS_M24LR64_A01)
+  {
+    return HAL_ERROR;
+  }
+  for (trial = 0u; trial < Trials; trial++)
+  {
+    if (host_serial_poll(&hostI2c) == 0)
+    {
+      return HAL_OK;
+    }
+  }
+
+  return HAL_ERROR;
+}
+
+void EEPROM_SPI_IO_Init(void)
+{
+}
+
+HAL_StatusTypeDef EEPROM_SPI_IO_WriteData(uint16_t MemAddress, uint8_t* pBuffer, uint32_t BufferSize)
+{
+  /* A busy SPI device drops the instruction without telling */
+  (void)host_serial_write(&hostSpi, MemAddress, pBuffer, BufferSize);
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef EEPROM_SPI_IO_ReadData(uint16_t MemAddress, uint8_t* pBuffer, uint32_t BufferSize)
+{
+  if (host_serial_read(&hostSpi, MemAddress, pBuffer, BufferSize) != 0)
+  {
+    memset(pBuffer, 0xFF, BufferSize);
+  }
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef EEPROM_SPI_IO_WaitEepromStandbyState(void)
+{
+  uint32_t trial;
+
+  for (trial = 0u; trial < EEPROM_MAX_TRIALS; trial++)
+  {
+    if (host_serial_poll(&hostSpi) == 0)
+    {
+      return HAL_OK;
+    }
+  }
+
+  return HAL_TIMEOUT;
+}
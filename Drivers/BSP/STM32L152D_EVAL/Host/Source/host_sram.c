@@ -0,0 +1,45 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        host_sram.c
+*
+* Description:  External SRAM of the host checks: memory mapped read and
+*               write at SRAM_DEVICE_ADDR, so that the drivers use it in
+*               place as through the FSMC once BSP_SRAM_Init() has run.
+*               As after a power-up, it holds random data.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#define _GNU_SOURCE
+
+#include <sys/mman.h>
+
+#include "host_bsp.h"
+#include "host_util.h"
+#include "stm32l152d_eval_sram.h"
+
+/**
+ * @brief  Maps the SRAM at SRAM_DEVICE_ADDR, filled with random data.
+ * @return 0, or -1 when the mapping cannot be set up
+ */
+int host_sram_open(void)
+{
+  void *map = mmap((void *)(uintptr_t)SRAM_DEVICE_ADDR, SRAM_DEVICE_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+  if (map != (void *)(uintptr_t)SRAM_DEVICE_ADDR)
+  {
+    return -1;
+  }
+  host_bytes((uint8_t *)map, SRAM_DEVICE_SIZE);
+
+  return 0;
+}
+
+/**
+ * @brief  Unmaps the SRAM.
+ */
+void host_sram_close(void)
+{
+  munmap((void *)(uintptr_t)SRAM_DEVICE_ADDR, SRAM_DEVICE_SIZE);
+}
@@ -0,0 +1,224 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        eeprom.c
+*
+* Description:  Checks of the serial EEPROM driver of
+*               stm32l152d_eval_eeprom.c, direct and through its
+*               write-back page cache, against a model of the EEPROM
+*               content, on the models of the I2C and SPI devices.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bsp_suites.h"
+#include "stm32l152d_eval_eeprom.h"
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+#define EE_CYCLE                3u        /* polls of a write cycle */
+#define EE_LENGTH               56u       /* longest access of the random checks */
+
+/* Expected content of each device */
+static uint8_t eeModel[2][8192];
+static uint8_t eeData[8192];
+
+static uint8_t *ee_model(uint8_t device)
+{
+  return eeModel[(device == BSP_EEPROM_M95040) ? 1 : 0];
+}
+
+/**
+ * @brief  Selects and initializes a device.
+ * @return 0, or 1 when the driver reports an error
+ */
+static uint32_t ee_select(uint8_t device)
+{
+  return ((BSP_EEPROM_SelectDevice(device) != EEPROM_OK) || (BSP_EEPROM_Init() != EEPROM_OK)) ? 1u : 0u;
+}
+
+/**
+ * @brief  Count of the bytes of a device that differ from its model.
+ */
+static uint32_t ee_diff(uint8_t device)
+{
+  uint32_t size = host_serial_size(device), i, bad = 0u;
+  const uint8_t *model = ee_model(device);
+
+  host_serial_content(device, 0u, eeData, size);
+  for (i = 0u; i < size; i++)
+  {
+    bad += (eeData[i] != model[i]) ? 1u : 0u;
+  }
+
+  return bad;
+}
+
+/**
+ * @brief  Device accesses the driver should never make: a read or a
+ *         write during a write cycle, a write across a page boundary.
+ */
+static uint32_t ee_misuse(uint8_t device)
+{
+  host_serial_stats_t stats;
+
+  host_serial_stats(device, &stats);
+
+  return stats.busyAccesses + stats.pageCrossings;
+}
+
+/**
+ * @brief  One random access to the selected device, applied to the model.
+ * @param  cached  nonzero to write through the page cache
+ * @return 0, or 1 when the driver reports an error or reads wrong data
+ */
+static uint32_t ee_step(uint8_t device, int cached)
+{
+  uint8_t buffer[EE_LENGTH];
+  uint8_t *model = ee_model(device);
+  uint32_t op = host_below(10u), length, numbyte;
+  uint16_t address;
+
+  length = 1u + host_below((host_below(2u) != 0u) ? 6u : EE_LENGTH);
+  address = (uint16_t)host_below(host_serial_size(device) - length + 1u);
+
+  if (op < 4u)
+  {
+    numbyte = length;
+    if (BSP_EEPROM_ReadBuffer(buffer, address, &numbyte) != EEPROM_OK)
+    {
+      return 1u;
+    }
+    return (memcmp(buffer, &model[address], length) != 0) ? 1u : 0u;
+  }
+
+  host_bytes(buffer, length);
+  memcpy(&model[address], buffer, length);
+  if (cached && (op < 9u))
+  {
+    return (BSP_EEPROM_WriteBufferCached(buffer, address, length) != EEPROM_OK) ? 1u : 0u;
+  }
+
+  return (BSP_EEPROM_WriteBuffer(buffer, address, length) != EEPROM_OK) ? 1u : 0u;
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Random reads and writes, direct then mostly cached; after a
+ *         flush the device holds the model.
+ */
+static void check_accesses(uint8_t device, const char *name, const char *nameCached)
+{
+  uint32_t i, bad;
+
+  bad = ee_select(device);
+  for (i = 0u; i < 1000u; i++)
+  {
+    bad += ee_step(device, 0);
+  }
+  host_check_equal(name, 1000u, bad + ee_diff(device) + ee_misuse(device));
+
+  bad = 0u;
+  for (i = 0u; i < 1000u; i++)
+  {
+    bad += ee_step(device, 1);
+  }
+  bad += (BSP_EEPROM_Flush() != EEPROM_OK) ? 1u : 0u;
+  host_check_equal(nameCached, 1000u, bad + ee_diff(device) + ee_misuse(device));
+}
+
+/**
+ * @brief  Byte updates of one page, in any order, cost one page write.
+ */
+static void check_page_writes(uint8_t device, uint32_t page, const char *name)
+{
+  host_serial_stats_t before, after;
+  uint8_t *model = ee_model(device);
+  uint32_t i, j, bad;
+  uint16_t base = (uint16_t)(page * 5u), order[16], swap;
+
+  bad = ee_select(device);
+  for (i = 0u; i < page; i++)
+  {
+    order[i] = (uint16_t)i;
+  }
+  for (i = page - 1u; i > 0u; i--)
+  {
+    j = host_below(i + 1u);
+    swap = order[i];
+    order[i] = order[j];
+    order[j] = swap;
+  }
+
+  host_serial_stats(device, &before);
+  for (i = 0u; i < (2u * page); i++)
+  {
+    host_bytes(&model[base + order[i % page]], 1u);
+    bad += (BSP_EEPROM_WriteBufferCached(&model[base + order[i % page]], base + order[i % page], 1u) != EEPROM_OK) ? 1u : 0u;
+  }
+  bad += (BSP_EEPROM_Flush() != EEPROM_OK) ? 1u : 0u;
+  host_serial_stats(device, &after);
+
+  host_check_equal(name, page, bad + ((after.pageWrites - before.pageWrites) != 1u) + ee_diff(device) + ee_misuse(device));
+}
+
+/**
+ * @brief  Data left in the cache for one device reaches that device when
+ *         the other one is selected, and only it; a device still in its
+ *         write cycle keeps the selection.
+ */
+static void check_select(void)
+{
+  uint8_t buffer[EE_LENGTH];
+  uint32_t i, bad, numbyte;
+
+  bad = ee_select(BSP_EEPROM_M24LR64);
+  for (i = 0u; i < 20u; i++)
+  {
+    bad += ee_step(BSP_EEPROM_M24LR64, 1);
+  }
+  bad += ee_select(BSP_EEPROM_M95040);
+  bad += ee_diff(BSP_EEPROM_M24LR64);
+  for (i = 0u; i < 200u; i++)
+  {
+    bad += ee_step(BSP_EEPROM_M95040, 1);
+  }
+  bad += ee_select(BSP_EEPROM_M24LR64);
+  numbyte = EE_LENGTH;
+  bad += (BSP_EEPROM_ReadBuffer(buffer, 0u, &numbyte) != EEPROM_OK) ? 1u : 0u;
+  bad += (memcmp(buffer, ee_model(BSP_EEPROM_M24LR64), EE_LENGTH) != 0) ? 1u : 0u;
+  bad += ee_diff(BSP_EEPROM_M95040) + ee_diff(BSP_EEPROM_M24LR64);
+  host_check_equal("eeprom/select device", 200u, bad + ee_misuse(BSP_EEPROM_M24LR64) + ee_misuse(BSP_EEPROM_M95040));
+
+  /* The flush fails on a device that never ends its write cycle */
+  bad = 0u;
+  for (i = 0u; i < 20u; i++)
+  {
+    bad += ee_step(BSP_EEPROM_M24LR64, 1);
+  }
+  host_serial_hold(BSP_EEPROM_M24LR64, 1);
+  bad += (BSP_EEPROM_SelectDevice(BSP_EEPROM_M95040) == EEPROM_OK) ? 1u : 0u;
+  host_serial_hold(BSP_EEPROM_M24LR64, 0);
+  bad += (BSP_EEPROM_Flush() != EEPROM_OK) ? 1u : 0u;
+  bad += ee_select(BSP_EEPROM_M95040);
+  bad += ee_diff(BSP_EEPROM_M95040) + ee_diff(BSP_EEPROM_M24LR64);
+  host_check_equal("eeprom/select held device", 20u, bad);
+}
+
+void check_eeprom(void)
+{
+  host_serial_reset(EE_CYCLE);
+  memset(eeModel, 0xFF, sizeof(eeModel));
+
+  check_accesses(BSP_EEPROM_M24LR64, "eeprom/i2c", "eeprom/i2c cached");
+  check_accesses(BSP_EEPROM_M95040, "eeprom/spi", "eeprom/spi cached");
+  check_page_writes(BSP_EEPROM_M24LR64, EEPROM_PAGESIZE_M24LR64, "eeprom/i2c page writes");
+  check_page_writes(BSP_EEPROM_M95040, EEPROM_PAGESIZE_M95040, "eeprom/spi page writes");
+  check_select();
+}
@@ -0,0 +1,313 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        extmem.c
+*
+* Description:  Checks of the allocators of stm32l152d_eval_extmem.c over
+*               the SRAM model: carving behind the EXTMEM_SECTION objects,
+*               pools against a model of their fresh blocks and free list,
+*               with MinFreeCount and the blocks PoolFree refuses, and
+*               arenas with nested marks and their peak.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <string.h>
+
+#include "bsp_suites.h"
+#include "stm32l152d_eval_extmem.h"
+
+/* Bounds of the EXTMEM_SECTION objects, set at link time */
+extern uint8_t _sextsram[];
+extern uint8_t _eextsram[];
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+#define EXT_ALIGN(x)            (((x) + EXTMEM_ALIGNMENT - 1u) & ~(uint32_t)(EXTMEM_ALIGNMENT - 1u))
+#define EXT_POOL_BLOCKS         200u
+#define EXT_MARKS               16u
+
+static uint8_t extForeign[64];            /* memory out of the SRAM */
+
+/**
+ * @brief  First address the allocator hands out after BSP_EXTMEM_Init().
+ */
+static uint32_t ext_first(void)
+{
+  return SRAM_DEVICE_ADDR + EXT_ALIGN((uint32_t)(uintptr_t)_eextsram - (uint32_t)(uintptr_t)_sextsram);
+}
+
+static uint32_t ext_address(const void *p)
+{
+  return (uint32_t)(uintptr_t)p;
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  The SRAM is carved behind the EXTMEM_SECTION objects, in order
+ *         and aligned, up to its end.
+ */
+static void check_carve(void)
+{
+  uint32_t left, next, bad = 0u;
+
+  bad += (BSP_EXTMEM_Init() != EXTMEM_OK) ? 1u : 0u;
+  next = ext_first();
+  left = SRAM_DEVICE_ADDR + SRAM_DEVICE_SIZE - next;
+  bad += (BSP_EXTMEM_GetFreeSize() != left) ? 1u : 0u;
+
+  bad += (ext_address(BSP_EXTMEM_Alloc(1u)) != next) ? 1u : 0u;
+  bad += (ext_address(BSP_EXTMEM_Alloc(13u)) != (next + 8u)) ? 1u : 0u;
+  bad += (ext_address(BSP_EXTMEM_Alloc(16u)) != (next + 24u)) ? 1u : 0u;
+  bad += (BSP_EXTMEM_Alloc(0u) != NULL) ? 1u : 0u;
+  next += 40u;
+  left -= 40u;
+  bad += (BSP_EXTMEM_GetFreeSize() != left) ? 1u : 0u;
+
+  /* Too large a request leaves the SRAM as it was; the last bytes go */
+  bad += (BSP_EXTMEM_Alloc(left + 1u) != NULL) ? 1u : 0u;
+  bad += (BSP_EXTMEM_GetFreeSize() != left) ? 1u : 0u;
+  bad += (ext_address(BSP_EXTMEM_Alloc(left)) != next) ? 1u : 0u;
+  bad += (BSP_EXTMEM_GetFreeSize() != 0u) ? 1u : 0u;
+  bad += (BSP_EXTMEM_Alloc(1u) != NULL) ? 1u : 0u;
+
+  /* Memory is carved for the life of the application: only Init resets */
+  bad += (BSP_EXTMEM_Init() != EXTMEM_OK) ? 1u : 0u;
+  bad += (ext_address(BSP_EXTMEM_Alloc(8u)) != ext_first()) ? 1u : 0u;
+
+  host_check_equal("extmem/carve", 1u, bad);
+}
+
+/**
+ * @brief  Random allocations and releases from pools of several block
+ *         sizes: blocks come from the free list, last released first,
+ *         then fresh in order, and the data of the allocated blocks is
+ *         never touched by the pool.
+ */
+static void check_pool(void)
+{
+  static const uint32_t sizes[] = {1u, 8u, 13u, 64u, 100u};
+  static uint32_t freed[EXT_POOL_BLOCKS];       /* free list, last released on top */
+  static uint8_t allocated[EXT_POOL_BLOCKS];
+  EXTMEM_PoolTypeDef pool;
+  uint32_t s, i, op, index, top, fresh, minimum, block, expected, left, bad = 0u;
+  uint8_t *p;
+
+  for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+  {
+    bad += (BSP_EXTMEM_Init() != EXTMEM_OK) ? 1u : 0u;
+    bad += (BSP_EXTMEM_PoolCreate(&pool, sizes[s], EXT_POOL_BLOCKS) != EXTMEM_OK) ? 1u : 0u;
+    block = EXT_ALIGN((sizes[s] < sizeof(void *)) ? (uint32_t)sizeof(void *) : sizes[s]);
+    bad += ((ext_address(pool.pBase) != ext_first()) || (pool.BlockSize != block)) ? 1u : 0u;
+    bad += ((pool.FreeCount != EXT_POOL_BLOCKS) || (pool.MinFreeCount != EXT_POOL_BLOCKS)) ? 1u : 0u;
+
+    memset(allocated, 0, sizeof(allocated));
+    top = 0u;
+    fresh = 0u;
+    minimum = EXT_POOL_BLOCKS;
+    for (op = 0u; op < 4000u; op++)
+    {
+      /* Allocations win for the first half, releases for the second */
+      if (host_below(100u) < ((op < 2000u) ? 60u : 40u))
+      {
+        p = (uint8_t *)BSP_EXTMEM_PoolAlloc(&pool);
+        if (top > 0u)
+        {
+          index = freed[--top];
+        }
+        else if (fresh < EXT_POOL_BLOCKS)
+        {
+          index = fresh++;
+        }
+        else
+        {
+          bad += (p != NULL) ? 1u : 0u;
+          continue;
+        }
+        expected = ext_address(pool.pBase) + (index * block);
+        if (ext_address(p) != expected)
+        {
+          bad++;
+          continue;
+        }
+        allocated[index] = 1u;
+        memset(p, (int)(index & 0xFFu), block);
+      }
+      else
+      {
+        index = host_below(EXT_POOL_BLOCKS);
+        if (allocated[index] == 0u)
+        {
+          continue;
+        }
+        p = pool.pBase + (index * block);
+        for (i = 0u; i < block; i++)
+        {
+          bad += (p[i] != (uint8_t)index) ? 1u : 0u;
+        }
+        bad += (BSP_EXTMEM_PoolFree(&pool, p) != EXTMEM_OK) ? 1u : 0u;
+        allocated[index] = 0u;
+        freed[top++] = index;
+      }
+
+      left = EXT_POOL_BLOCKS - fresh + top;
+      minimum = (left < minimum) ? left : minimum;
+      bad += ((pool.FreeCount != left) || (pool.MinFreeCount != minimum) || (pool.Fresh != fresh)) ? 1u : 0u;
+    }
+
+    /* Blocks still allocated kept their data */
+    for (index = 0u; index < EXT_POOL_BLOCKS; index++)
+    {
+      p = pool.pBase + (index * block);
+      for (i = 0u; (allocated[index] != 0u) && (i < block); i++)
+      {
+        bad += (p[i] != (uint8_t)index) ? 1u : 0u;
+      }
+    }
+  }
+
+  /* Empty and oversized pools are refused, and carve nothing */
+  bad += (BSP_EXTMEM_Init() != EXTMEM_OK) ? 1u : 0u;
+  left = BSP_EXTMEM_GetFreeSize();
+  bad += (BSP_EXTMEM_PoolCreate(&pool, 16u, 0u) != EXTMEM_ERROR) ? 1u : 0u;
+  bad += (BSP_EXTMEM_PoolCreate(&pool, 16u, (left / 16u) + 1u) != EXTMEM_ERROR) ? 1u : 0u;
+  bad += (BSP_EXTMEM_PoolCreate(&pool, 0x10000u, 0x10001u) != EXTMEM_ERROR) ? 1u : 0u;
+  bad += (BSP_EXTMEM_GetFreeSize() != left) ? 1u : 0u;
+  bad += (BSP_EXTMEM_PoolCreate(&pool, 16u, left / 16u) != EXTMEM_OK) ? 1u : 0u;
+  bad += (BSP_EXTMEM_GetFreeSize() != (left % 16u)) ? 1u : 0u;
+
+  host_check_equal("extmem/pool", 1u, bad);
+}
+
+/**
+ * @brief  PoolFree refuses addresses that are not blocks handed out by
+ *         the pool, and leaves the pool as it was.
+ */
+static void check_pool_refused(void)
+{
+  EXTMEM_PoolTypeDef pool, other;
+  uint8_t *refused[8];
+  uint8_t *first, *second;
+  uint32_t i, bad = 0u;
+
+  bad += (BSP_EXTMEM_Init() != EXTMEM_OK) ? 1u : 0u;
+  bad += (BSP_EXTMEM_PoolCreate(&pool, 24u, 10u) != EXTMEM_OK) ? 1u : 0u;
+  bad += (BSP_EXTMEM_PoolCreate(&other, 24u, 10u) != EXTMEM_OK) ? 1u : 0u;
+  first = (uint8_t *)BSP_EXTMEM_PoolAlloc(&pool);
+  second = (uint8_t *)BSP_EXTMEM_PoolAlloc(&pool);
+  (void)BSP_EXTMEM_PoolAlloc(&pool);
+  bad += (BSP_EXTMEM_PoolFree(&pool, second) != EXTMEM_OK) ? 1u : 0u;
+
+  refused[0] = pool.pBase - pool.BlockSize;                       /* before the pool */
+  refused[1] = first + 8u;                                        /* inside a block */
+  refused[2] = second + 4u;
+  refused[3] = pool.pBase + (3u * pool.BlockSize);                /* never handed out */
+  refused[4] = pool.pBase + (pool.NumOfBlocks * pool.BlockSize);  /* behind the pool */
+  refused[5] = (uint8_t *)BSP_EXTMEM_PoolAlloc(&other);           /* of another pool */
+  refused[6] = extForeign;                                        /* out of the SRAM */
+  refused[7] = NULL;
+
+  for (i = 0u; i < (sizeof(refused) / sizeof(refused[0])); i++)
+  {
+    bad += (BSP_EXTMEM_PoolFree(&pool, refused[i]) != EXTMEM_ERROR) ? 1u : 0u;
+    bad += ((pool.FreeCount != 8u) || (pool.Fresh != 3u) || (pool.pFree != second)) ? 1u : 0u;
+  }
+
+  /* The free list is intact: the released block, then fresh ones */
+  bad += (BSP_EXTMEM_PoolAlloc(&pool) != second) ? 1u : 0u;
+  bad += (BSP_EXTMEM_PoolAlloc(&pool) != (pool.pBase + (3u * pool.BlockSize))) ? 1u : 0u;
+  bad += (pool.MinFreeCount != 6u) ? 1u : 0u;
+
+  host_check_equal("extmem/pool refused", (sizeof(refused) / sizeof(refused[0])), bad);
+}
+
+/**
+ * @brief  Random allocations from an arena, with nested marks and their
+ *         releases, stale marks and resets, against a model of its
+ *         position and peak.
+ */
+static void check_arena(void)
+{
+  EXTMEM_ArenaTypeDef arena;
+  uint32_t marks[EXT_MARKS];
+  uint32_t op, size, depth = 0u, used = 0u, peak = 0u, left, bad = 0u;
+  void *p;
+
+  bad += (BSP_EXTMEM_Init() != EXTMEM_OK) ? 1u : 0u;
+  left = BSP_EXTMEM_GetFreeSize();
+  bad += (BSP_EXTMEM_ArenaCreate(&arena, left + 1u) != EXTMEM_ERROR) ? 1u : 0u;
+  bad += (BSP_EXTMEM_GetFreeSize() != left) ? 1u : 0u;
+  bad += (BSP_EXTMEM_ArenaCreate(&arena, 1001u) != EXTMEM_OK) ? 1u : 0u;
+  bad += ((ext_address(arena.pBase) != ext_first()) || (arena.Size != 1008u) ||
+          (arena.Used != 0u) || (arena.Peak != 0u)) ? 1u : 0u;
+  bad += (BSP_EXTMEM_GetFreeSize() != (left - 1008u)) ? 1u : 0u;
+
+  for (op = 0u; op < 5000u; op++)
+  {
+    switch (host_below(8u))
+    {
+      case 0u:
+        if (depth < EXT_MARKS)
+        {
+          marks[depth++] = BSP_EXTMEM_ArenaMark(&arena);
+          bad += (marks[depth - 1u] != used) ? 1u : 0u;
+        }
+        break;
+      case 1u:
+        if (depth > 0u)
+        {
+          used = marks[--depth];
+          BSP_EXTMEM_ArenaRelease(&arena, used);
+        }
+        break;
+      case 2u:
+        /* A mark beyond the position, from before a release, is ignored */
+        BSP_EXTMEM_ArenaRelease(&arena, used + 8u + (8u * host_below(10u)));
+        break;
+      case 3u:
+        if (host_below(20u) == 0u)
+        {
+          BSP_EXTMEM_ArenaReset(&arena);
+          used = 0u;
+          depth = 0u;
+        }
+        break;
+      default:
+        size = host_below(200u);
+        p = BSP_EXTMEM_ArenaAlloc(&arena, size);
+        if (EXT_ALIGN(size) > (1008u - used))
+        {
+          bad += (p != NULL) ? 1u : 0u;
+        }
+        else
+        {
+          bad += (ext_address(p) != (ext_address(arena.pBase) + used)) ? 1u : 0u;
+          used += EXT_ALIGN(size);
+          peak = (used > peak) ? used : peak;
+        }
+        break;
+    }
+    bad += ((arena.Used != used) || (arena.Peak != peak)) ? 1u : 0u;
+  }
+
+  host_check_equal("extmem/arena", 5000u, bad);
+}
+
+void check_extmem(void)
+{
+  if (host_sram_open() != 0)
+  {
+    host_check_equal("extmem/sram map", 1u, 1u);
+    return;
+  }
+
+  check_carve();
+  check_pool();
+  check_pool_refused();
+  check_arena();
+
+  host_sram_close();
+}
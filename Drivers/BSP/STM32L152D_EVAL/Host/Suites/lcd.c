@@ -0,0 +1,1284 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        lcd.c
+*
+* Description:  Checks of the DMA fills and blits of the TFT LCD driver
+*               of stm32l152d_eval_lcd.c and of its RLE images, made by
+*               the image converter, against a reference framebuffer,
+*               on the model of the LCD controller, with the DMA
+*               interrupt serviced by the checks, and of its text output
+*               and glyph cache, and of the filled primitives against
+*               brute force references; count of the controller
+*               transactions of the filled primitives.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bsp_suites.h"
+#include "stm32l152d_eval_lcd.h"
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+#define LCD_XSIZE               320u
+#define LCD_YSIZE               240u
+#define LCD_BMP_HEADER          54u
+
+typedef enum
+{
+  LCD_CIRCLE = 0,
+  LCD_ELLIPSE,
+  LCD_TRIANGLE,
+  LCD_POLYGON,
+  LCD_RECT_DMA
+} lcd_primitive_t;
+
+/* Expected screen */
+static uint16_t lcdModel[LCD_YSIZE][LCD_XSIZE];
+
+/* Sources of the DMA: static, below 4 GB */
+static uint16_t lcdImage[LCD_XSIZE * LCD_YSIZE];
+static uint8_t lcdBmp[LCD_BMP_HEADER + (LCD_YSIZE * ((2u * LCD_XSIZE) + 2u))] __attribute__((aligned(4)));
+
+static uint32_t lcdCompleted = 0u;
+static uint32_t lcdErrors = 0u;
+
+void BSP_LCD_DMA_TransferComplete_CallBack(void)
+{
+  lcdCompleted++;
+}
+
+void BSP_LCD_DMA_Error_CallBack(void)
+{
+  lcdErrors++;
+}
+
+/**
+ * @brief  Count of the pixels of the screen that differ from the model.
+ */
+static uint32_t lcd_diff(void)
+{
+  uint32_t x, y, bad = 0u;
+
+  for (y = 0u; y < LCD_YSIZE; y++)
+  {
+    for (x = 0u; x < LCD_XSIZE; x++)
+    {
+      bad += (host_lcd_pixel((uint16_t)x, (uint16_t)y) != lcdModel[y][x]) ? 1u : 0u;
+    }
+  }
+
+  return bad;
+}
+
+/**
+ * @brief  Services the DMA interrupt until the transfer is over.
+ * @return interrupts taken
+ */
+static uint32_t lcd_service(void)
+{
+  uint32_t irqs = 0u;
+
+  while (BSP_LCD_DMA_IsBusy() && (irqs < 100000u))
+  {
+    BSP_LCD_DMA_IRQHandler();
+    irqs++;
+  }
+
+  return irqs;
+}
+
+/**
+ * @brief  The full screen window the driver leaves behind, in GRAM
+ *         addresses.
+ */
+static uint32_t lcd_window_restored(void)
+{
+  return ((host_lcd_register(0x50u) == 0u) && (host_lcd_register(0x51u) == (LCD_YSIZE - 1u)) &&
+          (host_lcd_register(0x52u) == 0u) && (host_lcd_register(0x53u) == (LCD_XSIZE - 1u))) ? 1u : 0u;
+}
+
+/**
+ * @brief  Checks the end of a transfer: one completion callback, the
+ *         pixels all sent by the DMA, and the window restored.
+ * @param  pBefore  counters before the transfer
+ * @return 0, or the number of faults
+ */
+static uint32_t lcd_finish(const host_lcd_stats_t *pBefore, uint32_t pixels)
+{
+  host_lcd_stats_t after;
+  uint32_t completed = lcdCompleted, bad = 0u;
+
+  (void)lcd_service();
+  host_lcd_stats(&after);
+
+  bad += ((lcdCompleted - completed) != 1u) ? 1u : 0u;
+  bad += ((after.dmaWrites - pBefore->dmaWrites) != pixels) ? 1u : 0u;
+  bad += (after.pixelWrites != pBefore->pixelWrites) ? 1u : 0u;
+  bad += lcd_window_restored() ? 0u : 1u;
+
+  return bad;
+}
+
+static void lcd_random_rect(uint16_t *pX, uint16_t *pY, uint16_t *pWidth, uint16_t *pHeight)
+{
+  *pWidth = (uint16_t)(1u + host_below(LCD_XSIZE));
+  *pHeight = (uint16_t)(1u + host_below(LCD_YSIZE));
+  *pX = (uint16_t)host_below(LCD_XSIZE - *pWidth + 1u);
+  *pY = (uint16_t)host_below(LCD_YSIZE - *pHeight + 1u);
+}
+
+/**
+ * @brief  Writes the header of a bitmap.
+ */
+static void lcd_bmp_header(uint32_t width, uint32_t height, uint16_t bpp, uint32_t compression)
+{
+  uint32_t i;
+
+  memset(lcdBmp, 0, LCD_BMP_HEADER);
+  lcdBmp[0] = 'B';
+  lcdBmp[1] = 'M';
+  lcdBmp[10] = LCD_BMP_HEADER;
+  for (i = 0u; i < 4u; i++)
+  {
+    lcdBmp[18u + i] = (uint8_t)(width >> (8u * i));
+    lcdBmp[22u + i] = (uint8_t)(height >> (8u * i));
+    lcdBmp[30u + i] = (uint8_t)(compression >> (8u * i));
+  }
+  lcdBmp[26] = 1u;
+  lcdBmp[28] = (uint8_t)bpp;
+}
+
+/**
+ * @brief  Writes a 16 bpp bitmap of random pixels, lines bottom-up and
+ *         padded to 4 bytes, and draws it in the model.
+ */
+static void lcd_make_bmp(uint16_t Xpos, uint16_t Ypos, uint32_t width, uint32_t height)
+{
+  uint32_t stride = ((2u * width) + 3u) & ~3u, row, col;
+  uint8_t *pixel;
+
+  lcd_bmp_header(width, height, 16u, (host_below(2u) != 0u) ? 3u : 0u);
+  host_bytes(&lcdBmp[LCD_BMP_HEADER], height * stride);
+
+  for (row = 0u; row < height; row++)
+  {
+    pixel = &lcdBmp[LCD_BMP_HEADER + ((height - 1u - row) * stride)];
+    for (col = 0u; col < width; col++, pixel += 2)
+    {
+      lcdModel[Ypos + row][Xpos + col] = (uint16_t)(pixel[0] | (pixel[1] << 8));
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  The driver finds the controller; a clear of the whole screen,
+ *         more than one DMA request long, ends once its interrupts are
+ *         serviced, and not before.
+ */
+static void check_clear(void)
+{
+  host_lcd_stats_t before;
+  uint32_t bad = 0u, y, x;
+
+  bad += (BSP_LCD_Init() != LCD_OK) ? 1u : 0u;
+  bad += (BSP_LCD_DMA_Init() != LCD_OK) ? 1u : 0u;
+  bad += ((BSP_LCD_GetXSize() != LCD_XSIZE) || (BSP_LCD_GetYSize() != LCD_YSIZE)) ? 1u : 0u;
+
+  host_lcd_stats(&before);
+  bad += (BSP_LCD_Clear_DMA(0x1234u) != LCD_OK) ? 1u : 0u;
+  bad += BSP_LCD_DMA_IsBusy() ? 0u : 1u;
+  bad += (BSP_LCD_DMA_WaitForTransfer(10u) != LCD_TIMEOUT) ? 1u : 0u;
+  bad += (BSP_LCD_FillRect_DMA(0u, 0u, 1u, 1u) != LCD_ERROR) ? 1u : 0u;
+  bad += lcd_finish(&before, LCD_XSIZE * LCD_YSIZE);
+  bad += (BSP_LCD_DMA_WaitForTransfer(10u) != LCD_OK) ? 1u : 0u;
+
+  for (y = 0u; y < LCD_YSIZE; y++)
+  {
+    for (x = 0u; x < LCD_XSIZE; x++)
+    {
+      lcdModel[y][x] = 0x1234u;
+    }
+  }
+  host_check_equal("lcd/clear dma", LCD_XSIZE * LCD_YSIZE, bad + lcd_diff());
+}
+
+/**
+ * @brief  Random rectangles, full screen ones included.
+ */
+static void check_fill_rect(void)
+{
+  host_lcd_stats_t before;
+  uint16_t x, y, width, height, color, row, col;
+  uint32_t i, bad = 0u;
+
+  for (i = 0u; i < 200u; i++)
+  {
+    lcd_random_rect(&x, &y, &width, &height);
+    if ((i % 50u) == 0u)
+    {
+      x = y = 0u;
+      width = LCD_XSIZE;
+      height = LCD_YSIZE;
+    }
+    color = (uint16_t)host_random();
+
+    BSP_LCD_SetTextColor(color);
+    host_lcd_stats(&before);
+    bad += (BSP_LCD_FillRect_DMA(x, y, width, height) != LCD_OK) ? 1u : 0u;
+    bad += lcd_finish(&before, (uint32_t)width * height);
+
+    for (row = y; row < (y + height); row++)
+    {
+      for (col = x; col < (x + width); col++)
+      {
+        lcdModel[row][col] = color;
+      }
+    }
+  }
+  host_check_equal("lcd/fill rect dma", 200u, bad + lcd_diff());
+}
+
+/**
+ * @brief  Random top-down pictures, full screen ones included.
+ */
+static void check_rgb_image(void)
+{
+  host_lcd_stats_t before;
+  uint16_t x, y, width, height, row, col;
+  uint32_t i, bad = 0u;
+
+  for (i = 0u; i < 100u; i++)
+  {
+    lcd_random_rect(&x, &y, &width, &height);
+    if ((i % 25u) == 0u)
+    {
+      x = y = 0u;
+      width = LCD_XSIZE;
+      height = LCD_YSIZE;
+    }
+    host_bytes((uint8_t *)lcdImage, 2u * width * height);
+
+    host_lcd_stats(&before);
+    bad += (BSP_LCD_DrawRGBImage_DMA(x, y, width, height, (uint8_t *)lcdImage) != LCD_OK) ? 1u : 0u;
+    bad += lcd_finish(&before, (uint32_t)width * height);
+
+    for (row = 0u; row < height; row++)
+    {
+      for (col = 0u; col < width; col++)
+      {
+        lcdModel[y + row][x + col] = lcdImage[(row * width) + col];
+      }
+    }
+  }
+  host_check_equal("lcd/rgb image dma", 100u, bad + lcd_diff());
+}
+
+/**
+ * @brief  Random bitmaps, lines of odd widths padded, full screen ones
+ *         included.
+ */
+static void check_bitmap(void)
+{
+  host_lcd_stats_t before;
+  uint16_t x, y, width, height;
+  uint32_t i, bad = 0u;
+
+  for (i = 0u; i < 100u; i++)
+  {
+    lcd_random_rect(&x, &y, &width, &height);
+    if ((i % 25u) == 0u)
+    {
+      x = y = 0u;
+      width = LCD_XSIZE;
+      height = LCD_YSIZE;
+    }
+    lcd_make_bmp(x, y, width, height);
+
+    host_lcd_stats(&before);
+    bad += (BSP_LCD_DrawBitmap_DMA(x, y, lcdBmp) != LCD_OK) ? 1u : 0u;
+    bad += lcd_finish(&before, (uint32_t)width * height);
+  }
+  host_check_equal("lcd/bitmap dma", 100u, bad + lcd_diff());
+}
+
+/**
+ * @brief  Bitmaps the DMA cannot stream as they are, or that do not fit
+ *         in the panel, are refused before anything is sent.
+ */
+static void check_bitmap_refused(void)
+{
+  static const struct
+  {
+    uint16_t x, y;
+    uint32_t width, height;
+    uint16_t bpp;
+    uint32_t compression;
+  } refused[] =
+  {
+    {   0u,   0u,  16u,  16u, 24u, 0u },       /* 24 bpp */
+    {   0u,   0u,  16u,  16u,  8u, 0u },       /* 8 bpp, palette */
+    {   0u,   0u,  16u,  16u, 32u, 3u },       /* 32 bpp bit fields */
+    {   0u,   0u,  16u,  16u, 16u, 1u },       /* RLE8 */
+    {   0u,   0u, 321u,  16u, 16u, 0u },       /* wider than the panel */
+    { 300u,   0u,  21u,  16u, 16u, 0u },       /* past the right edge */
+    {   0u, 225u,  16u,  16u, 16u, 0u },       /* past the bottom edge */
+    {   0u,   0u,  16u, (uint32_t)-16, 16u, 0u }  /* top-down */
+  };
+  host_lcd_stats_t before, after;
+  uint32_t i, bad = 0u;
+
+  host_lcd_stats(&before);
+  for (i = 0u; i < (sizeof(refused) / sizeof(refused[0])); i++)
+  {
+    lcd_bmp_header(refused[i].width, refused[i].height, refused[i].bpp, refused[i].compression);
+    bad += (BSP_LCD_DrawBitmap_DMA(refused[i].x, refused[i].y, lcdBmp) != LCD_ERROR) ? 1u : 0u;
+    bad += BSP_LCD_DMA_IsBusy() ? 1u : 0u;
+  }
+  host_lcd_stats(&after);
+  bad += (memcmp(&before, &after, sizeof(before)) != 0) ? 1u : 0u;
+
+  /* The last pixel of the panel still takes a bitmap */
+  lcd_make_bmp(LCD_XSIZE - 16u, LCD_YSIZE - 16u, 16u, 16u);
+  bad += (BSP_LCD_DrawBitmap_DMA(LCD_XSIZE - 16u, LCD_YSIZE - 16u, lcdBmp) != LCD_OK) ? 1u : 0u;
+  bad += lcd_finish(&after, 16u * 16u);
+
+  host_check_equal("lcd/bitmap refused", i, bad + lcd_diff());
+}
+
+/* ----------------------------------------------------------------------
+*       Run-length encoded images
+* -------------------------------------------------------------------- */
+#define LCD_RLE_MAX             (LCD_RLE_HEADER_SIZE + 512u + (3u * LCD_XSIZE * LCD_YSIZE))
+
+static uint16_t lcdPalette[1024];
+static uint8_t lcdRle[LCD_RLE_MAX];
+
+/**
+ * @brief  Top-down picture of runs of the colors of a palette, all
+ *         different, in lcdImage: the first pixels take each color in
+ *         turn, so that all are used in a large enough picture. The
+ *         other runs are short or longer than a packet, across the lines.
+ */
+static void lcd_make_picture(uint32_t width, uint32_t height, uint32_t colors)
+{
+  uint32_t i, pos = 0u, run, runs = 0u, base = host_random();
+  uint16_t color;
+
+  for (i = 0u; i < colors; i++)
+  {
+    lcdPalette[i] = (uint16_t)(base + (i * 40503u));
+  }
+
+  while (pos < (width * height))
+  {
+    run = (runs < colors) ? 1u : (host_below(4u) == 0u) ? (100u + host_below(300u)) : (1u + host_below(4u));
+    color = lcdPalette[(runs < colors) ? runs : host_below(colors)];
+    for (i = 0u; (i < run) && (pos < (width * height)); i++)
+    {
+      lcdImage[pos++] = color;
+    }
+    runs++;
+  }
+}
+
+/**
+ * @brief  Writes lcdImage to a BMP file: 16 bpp RGB(5-6-5) bit fields, or
+ *         24 bpp, bottom-up or top-down.
+ * @return 0, or -1 when the file cannot be written
+ */
+static int lcd_write_bmp(const char *path, uint32_t width, uint32_t height, uint16_t bpp, int topDown)
+{
+  static const uint8_t masks[12] = { 0x00, 0xF8, 0, 0, 0xE0, 0x07, 0, 0, 0x1F, 0, 0, 0 };
+  uint32_t stride = ((width * (bpp / 8u)) + 3u) & ~3u, offset = (bpp == 16u) ? 66u : LCD_BMP_HEADER;
+  uint32_t row, col, line, i, size = offset + (height * stride);
+  uint8_t header[66], pad[3] = { 0u, 0u, 0u };
+  int32_t rows = topDown ? -(int32_t)height : (int32_t)height;
+  uint16_t color;
+  FILE *file = fopen(path, "wb");
+
+  if (file == NULL)
+  {
+    return -1;
+  }
+
+  memset(header, 0, sizeof(header));
+  header[0] = 'B';
+  header[1] = 'M';
+  for (i = 0u; i < 4u; i++)
+  {
+    header[2u + i] = (uint8_t)(size >> (8u * i));
+    header[10u + i] = (uint8_t)(offset >> (8u * i));
+    header[18u + i] = (uint8_t)(width >> (8u * i));
+    header[22u + i] = (uint8_t)((uint32_t)rows >> (8u * i));
+  }
+  header[14] = 40u;
+  header[26] = 1u;
+  header[28] = (uint8_t)bpp;
+  if (bpp == 16u)
+  {
+    header[30] = 3u;
+    memcpy(&header[LCD_BMP_HEADER], masks, sizeof(masks));
+  }
+  (void)fwrite(header, 1u, offset, file);
+
+  for (row = 0u; row < height; row++)
+  {
+    line = topDown ? row : (height - 1u - row);
+    for (col = 0u; col < width; col++)
+    {
+      color = lcdImage[(line * width) + col];
+      if (bpp == 16u)
+      {
+        (void)fputc(color & 0xFFu, file);
+        (void)fputc(color >> 8, file);
+      }
+      else
+      {
+        (void)fputc((color << 3) & 0xF8u, file);
+        (void)fputc((color >> 3) & 0xFCu, file);
+        (void)fputc((color >> 8) & 0xF8u, file);
+      }
+    }
+    (void)fwrite(pad, 1u, stride - (width * (bpp / 8u)), file);
+  }
+
+  return (fclose(file) == 0) ? 0 : -1;
+}
+
+/**
+ * @brief  Converts a BMP file with the image converter, its messages
+ *         silenced, and reads the bytes of the C array it writes back.
+ * @return size of the image, 0 on failure
+ */
+static uint32_t lcd_convert(char *bmpPath, char *cPath)
+{
+  char *argv[] = { "lcd_image_conv", bmpPath, cPath, "image", NULL };
+  unsigned int byte;
+  uint32_t size = 0u;
+  int out, null, status, c;
+  FILE *file;
+
+  fflush(stdout);
+  out = dup(STDOUT_FILENO);
+  null = open("/dev/null", O_WRONLY);
+  if ((out < 0) || (null < 0))
+  {
+    return 0u;
+  }
+  (void)dup2(null, STDOUT_FILENO);
+  status = lcd_image_conv(4, argv);
+  fflush(stdout);
+  (void)dup2(out, STDOUT_FILENO);
+  (void)close(out);
+  (void)close(null);
+
+  file = (status == 0) ? fopen(cPath, "r") : NULL;
+  if (file == NULL)
+  {
+    return 0u;
+  }
+  do
+  {
+    c = fgetc(file);
+  }
+  while ((c != '{') && (c != EOF));
+  while ((size < LCD_RLE_MAX) && (fscanf(file, " 0x%2x,", &byte) == 1))
+  {
+    lcdRle[size++] = (uint8_t)byte;
+  }
+  (void)fclose(file);
+
+  return size;
+}
+
+/**
+ * @brief  Pictures of up to 256 colors, the converter makes them palette
+ *         indexed, and of more, kept RGB(5-6-5), from 16 and 24 bpp
+ *         files, drawn from their RLE images at random positions. A full
+ *         palette of 256 colors included.
+ */
+static void check_rle_image(void)
+{
+  char bmpPath[] = "/tmp/bsp_check_bmp.XXXXXX", cPath[] = "/tmp/bsp_check_rle.XXXXXX";
+  int bmpFile = mkstemp(bmpPath), cFile = mkstemp(cPath);
+  uint16_t x, y, width, height;
+  uint32_t i, row, col, colors, size, bad = 0u;
+
+  if ((bmpFile < 0) || (cFile < 0))
+  {
+    host_check_equal("lcd/rle image files", 1u, 1u);
+    return;
+  }
+  (void)close(bmpFile);
+  (void)close(cFile);
+
+  for (i = 0u; i < 40u; i++)
+  {
+    lcd_random_rect(&x, &y, &width, &height);
+    colors = (i % 2u) ? (1u + host_below(256u)) : (257u + host_below(700u));
+    colors = (colors > ((uint32_t)width * height)) ? ((uint32_t)width * height) : colors;
+    if ((i % 10u) == 3u)
+    {
+      x = y = 0u;
+      width = LCD_XSIZE;
+      height = LCD_YSIZE;
+      colors = 256u;
+    }
+    lcd_make_picture(width, height, colors);
+
+    size = 0u;
+    if (lcd_write_bmp(bmpPath, width, height, (host_below(2u) != 0u) ? 16u : 24u, host_below(2u) != 0u) == 0)
+    {
+      size = lcd_convert(bmpPath, cPath);
+    }
+    bad += (size == 0u) ? 1u : 0u;
+    /* Indexed when at most 256 colors are used */
+    bad += (lcdRle[8] != ((colors <= 256u) ? LCD_RLE_FORMAT_INDEXED : LCD_RLE_FORMAT_RGB565)) ? 1u : 0u;
+
+    bad += (BSP_LCD_DrawRLEImage(x, y, lcdRle) != LCD_OK) ? 1u : 0u;
+    bad += lcd_window_restored() ? 0u : 1u;
+    for (row = 0u; row < height; row++)
+    {
+      for (col = 0u; col < width; col++)
+      {
+        lcdModel[y + row][x + col] = lcdImage[(row * width) + col];
+      }
+    }
+    bad += lcd_diff();
+  }
+
+  unlink(bmpPath);
+  unlink(cPath);
+  host_check_equal("lcd/rle image", 40u, bad);
+}
+
+/**
+ * @brief  Streams with an index past the palette, in a literal or a
+ *         repeated packet, or a packet past the end of the image stop the
+ *         drawing with LCD_ERROR, after the pixels before the fault.
+ */
+static void check_rle_refused(void)
+{
+  static const uint8_t literal[] = { 'R', 'L', 'I', '1', 4, 0, 1, 0, LCD_RLE_FORMAT_INDEXED, 2, 0, 0,
+                                     0x34, 0x12, 0x78, 0x56, 0x03, 0, 1, 2, 0 };
+  static const uint8_t repeated[] = { 'R', 'L', 'I', '1', 4, 0, 1, 0, LCD_RLE_FORMAT_INDEXED, 2, 0, 0,
+                                      0x34, 0x12, 0x78, 0x56, 0x83, 5 };
+  static const uint8_t overrun[] = { 'R', 'L', 'I', '1', 4, 0, 2, 0, LCD_RLE_FORMAT_RGB565, 0, 0, 0,
+                                     0x03, 1, 0, 2, 0, 3, 0, 4, 0, 0x84, 0xCD, 0xAB };
+  uint32_t col, bad = 0u;
+
+  bad += (BSP_LCD_DrawRLEImage(10u, 20u, literal) != LCD_ERROR) ? 1u : 0u;
+  lcdModel[20][10] = 0x1234u;
+  lcdModel[20][11] = 0x5678u;
+  bad += lcd_window_restored() ? 0u : 1u;
+
+  bad += (BSP_LCD_DrawRLEImage(30u, 40u, repeated) != LCD_ERROR) ? 1u : 0u;
+  bad += lcd_window_restored() ? 0u : 1u;
+
+  bad += (BSP_LCD_DrawRLEImage(50u, 60u, overrun) != LCD_ERROR) ? 1u : 0u;
+  for (col = 0u; col < 4u; col++)
+  {
+    lcdModel[60][50u + col] = (uint16_t)(col + 1u);
+  }
+  bad += lcd_window_restored() ? 0u : 1u;
+
+  host_check_equal("lcd/rle refused", 3u, bad + lcd_diff());
+}
+
+/* ----------------------------------------------------------------------
+*       Text
+* -------------------------------------------------------------------- */
+#define LCD_GLYPHS              95u       /* ' ' to '~' */
+#define LCD_GLYPH_BYTES         (LCD_GLYPHS * 24u * 3u)
+
+/* The fonts of the tree are declarations only: the checks give them the
+ * sizes of the ST fonts and glyphs of their own */
+static sFONT *const lcdFonts[5] = { &Font24, &Font20, &Font16, &Font12, &Font8 };
+static const uint16_t lcdFontSize[5][2] = { { 17u, 24u }, { 14u, 20u }, { 11u, 16u }, { 7u, 12u }, { 5u, 8u } };
+static uint8_t lcdFontTable[5][LCD_GLYPH_BYTES];
+
+static uint32_t lcd_glyph_bit(const sFONT *pFont, uint8_t Ascii, uint32_t row, uint32_t col)
+{
+  uint32_t bytes = (pFont->Width + 7u) / 8u;
+  const uint8_t *pline = &pFont->table[(((Ascii - ' ') * pFont->Height) + row) * bytes];
+
+  return (pline[col / 8u] >> (7u - (col % 8u))) & 1u;
+}
+
+/**
+ * @brief  Draws a character in the model, bit by bit, as the driver did
+ *         before its glyph cache.
+ */
+static void lcd_model_char(uint16_t Xpos, uint16_t Ypos, const sFONT *pFont, uint8_t Ascii,
+                           uint16_t text, uint16_t back)
+{
+  uint32_t row, col;
+
+  for (row = 0u; row < pFont->Height; row++)
+  {
+    for (col = 0u; col < pFont->Width; col++)
+    {
+      lcdModel[Ypos + row][Xpos + col] = lcd_glyph_bit(pFont, Ascii, row, col) ? text : back;
+    }
+  }
+}
+
+/**
+ * @brief  Runs of a glyph, without the splits of the runs over 255.
+ */
+static uint32_t lcd_glyph_runs(const sFONT *pFont, uint8_t Ascii)
+{
+  uint32_t row, col, bit, state = 0u, runs = 1u;
+
+  for (row = 0u; row < pFont->Height; row++)
+  {
+    for (col = 0u; col < pFont->Width; col++)
+    {
+      bit = lcd_glyph_bit(pFont, Ascii, row, col);
+      runs += (bit != state) ? 1u : 0u;
+      state = bit;
+    }
+  }
+
+  return runs;
+}
+
+/**
+ * @brief  Gives each font its size and glyphs: blank, full, checkerboard,
+ *         then random bits, padding bits included.
+ */
+static void lcd_make_fonts(void)
+{
+  uint32_t f, g, row, bytes, b;
+  uint8_t *pglyph;
+
+  for (f = 0u; f < 5u; f++)
+  {
+    lcdFonts[f]->Width = lcdFontSize[f][0];
+    lcdFonts[f]->Height = lcdFontSize[f][1];
+    lcdFonts[f]->table = lcdFontTable[f];
+    bytes = (lcdFontSize[f][0] + 7u) / 8u;
+
+    host_bytes(lcdFontTable[f], LCD_GLYPH_BYTES);
+    for (g = 0u; g < 3u; g++)
+    {
+      pglyph = &lcdFontTable[f][g * lcdFontSize[f][1] * bytes];
+      for (row = 0u; row < lcdFontSize[f][1]; row++)
+      {
+        for (b = 0u; b < bytes; b++)
+        {
+          pglyph[(row * bytes) + b] = (g == 0u) ? 0x00u : (g == 1u) ? 0xFFu : ((row & 1u) ? 0x55u : 0xAAu);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief  Draws a character with the driver and in the model, at a
+ *         random position.
+ */
+static void lcd_draw_char(const sFONT *pFont, uint8_t Ascii, uint16_t text, uint16_t back)
+{
+  uint16_t x = (uint16_t)host_below(LCD_XSIZE - pFont->Width + 1u);
+  uint16_t y = (uint16_t)host_below(LCD_YSIZE - pFont->Height + 1u);
+
+  BSP_LCD_SetTextColor(text);
+  BSP_LCD_SetBackColor(back);
+  BSP_LCD_DisplayChar(x, y, Ascii);
+  lcd_model_char(x, y, pFont, Ascii, text, back);
+}
+
+/**
+ * @brief  Every glyph of every font, drawn from its runs when first
+ *         seen, then from the cache in other colors, gives the bit by bit
+ *         pixels; glyphs with more runs than a cache entry holds, not
+ *         cached, included.
+ */
+static void check_glyphs(void)
+{
+  uint32_t f, g, bad = 0u, over = 0u, under = 0u, runs;
+  uint8_t ascii;
+
+  for (f = 0u; f < 5u; f++)
+  {
+    BSP_LCD_SetFont(lcdFonts[f]);
+    for (g = 0u; g < LCD_GLYPHS; g++)
+    {
+      ascii = (uint8_t)(' ' + g);
+      runs = lcd_glyph_runs(lcdFonts[f], ascii);
+      over += (runs > LCD_GLYPH_MAX_RUNS) ? 1u : 0u;
+      under += (runs <= LCD_GLYPH_MAX_RUNS) ? 1u : 0u;
+
+      lcd_draw_char(lcdFonts[f], ascii, LCD_COLOR_BLACK, LCD_COLOR_WHITE);
+      lcd_draw_char(lcdFonts[f], ascii, (uint16_t)host_random(), (uint16_t)host_random());
+      bad += lcd_diff();
+    }
+  }
+
+  /* Both kinds of glyphs were seen */
+  bad += ((over == 0u) || (under == 0u)) ? 1u : 0u;
+  host_check_equal("lcd/glyphs", 5u * LCD_GLYPHS, bad);
+}
+
+/**
+ * @brief  The cache keeps the LCD_GLYPH_CACHE_SIZE glyphs used last and
+ *         rebuilds the others. A glyph changed in its font table shows
+ *         which: a cached glyph keeps its old runs.
+ */
+static void check_glyph_cache(void)
+{
+  sFONT *pfont = &Font8;
+  uint8_t *pglyph, saved[8];
+  uint32_t i, bad = 0u, bytes = (Font8.Width + 7u) / 8u;
+  uint8_t ascii;
+
+  BSP_LCD_SetFont(pfont);
+
+  /* 'A' is drawn, then kept used while LCD_GLYPH_CACHE_SIZE others come */
+  lcd_draw_char(pfont, 'A', LCD_COLOR_RED, LCD_COLOR_BLUE);
+  for (i = 0u; i < LCD_GLYPH_CACHE_SIZE; i++)
+  {
+    lcd_draw_char(pfont, (uint8_t)('a' + i), LCD_COLOR_RED, LCD_COLOR_BLUE);
+    if ((i % 4u) == 2u)
+    {
+      lcd_draw_char(pfont, 'A', LCD_COLOR_GREEN, LCD_COLOR_BLUE);
+    }
+  }
+  bad += lcd_diff();
+
+  /* Its runs are still cached: the old glyph is drawn */
+  pglyph = (uint8_t *)&pfont->table[('A' - ' ') * pfont->Height * bytes];
+  memcpy(saved, pglyph, sizeof(saved));
+  for (i = 0u; i < sizeof(saved); i++)
+  {
+    pglyph[i] = (uint8_t)~pglyph[i];
+  }
+  BSP_LCD_SetTextColor(LCD_COLOR_YELLOW);
+  BSP_LCD_DisplayChar(0u, 0u, 'A');
+  memcpy(pglyph, saved, sizeof(saved));
+  lcd_model_char(0u, 0u, pfont, 'A', LCD_COLOR_YELLOW, LCD_COLOR_BLUE);
+  for (i = 0u; i < sizeof(saved); i++)
+  {
+    pglyph[i] = (uint8_t)~pglyph[i];
+  }
+  bad += lcd_diff();
+
+  /* LCD_GLYPH_CACHE_SIZE other glyphs evict it: the new glyph is drawn */
+  for (i = 0u; i < LCD_GLYPH_CACHE_SIZE; i++)
+  {
+    ascii = (uint8_t)('0' + i);
+    lcd_draw_char(pfont, ascii, LCD_COLOR_RED, LCD_COLOR_BLUE);
+  }
+  BSP_LCD_DisplayChar(0u, 0u, 'A');
+  lcd_model_char(0u, 0u, pfont, 'A', LCD_COLOR_RED, LCD_COLOR_BLUE);
+  memcpy(pglyph, saved, sizeof(saved));
+  bad += lcd_diff();
+
+  /* Evicted glyphs are rebuilt from their table */
+  for (i = 0u; i < LCD_GLYPH_CACHE_SIZE; i++)
+  {
+    lcd_draw_char(pfont, (uint8_t)('a' + i), LCD_COLOR_WHITE, LCD_COLOR_BLACK);
+  }
+  bad += lcd_diff();
+
+  /* The same character of two fonts makes two entries */
+  for (i = 0u; i < 4u; i++)
+  {
+    pfont = lcdFonts[3u + (i % 2u)];
+    BSP_LCD_SetFont(pfont);
+    lcd_draw_char(pfont, 'Q', LCD_COLOR_WHITE, LCD_COLOR_BLACK);
+  }
+  bad += lcd_diff();
+
+  host_check_equal("lcd/glyph cache", LCD_GLYPH_CACHE_SIZE, bad);
+}
+
+/* ----------------------------------------------------------------------
+*       Filled primitives
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Even-odd test of a pixel against a polygon, edge by edge.
+ *         Like the driver, an edge crosses the lines from its upper end
+ *         to before its lower end, the lowest line of the polygon
+ *         included, at its 16.16 position rounded to the nearest pixel;
+ *         the pixels of the crossings are inside. A flat polygon is the
+ *         line between its ends.
+ */
+static uint32_t lcd_in_polygon(const Point *pPoints, uint32_t count, int32_t px, int32_t py)
+{
+  int32_t x0, y0, x1, y1, tmp, ymin, ymax, xmin, xmax, cross;
+  uint32_t i, before = 0u, on = 0u;
+
+  ymin = ymax = pPoints[0].Y;
+  xmin = xmax = pPoints[0].X;
+  for (i = 0u; i < count; i++)
+  {
+    ymin = (pPoints[i].Y < ymin) ? pPoints[i].Y : ymin;
+    ymax = (pPoints[i].Y > ymax) ? pPoints[i].Y : ymax;
+    xmin = (pPoints[i].X < xmin) ? pPoints[i].X : xmin;
+    xmax = (pPoints[i].X > xmax) ? pPoints[i].X : xmax;
+  }
+  if (ymin == ymax)
+  {
+    return ((py == ymin) && (px >= xmin) && (px <= xmax)) ? 1u : 0u;
+  }
+
+  for (i = 0u; i < count; i++)
+  {
+    x0 = pPoints[i].X;
+    y0 = pPoints[i].Y;
+    x1 = pPoints[(i + 1u) % count].X;
+    y1 = pPoints[(i + 1u) % count].Y;
+    if (y0 > y1)
+    {
+      tmp = x0; x0 = x1; x1 = tmp;
+      tmp = y0; y0 = y1; y1 = tmp;
+    }
+    if ((y0 == y1) || (py < y0) || (py > y1) || ((py == y1) && (py != ymax)))
+    {
+      continue;
+    }
+
+    cross = ((x0 * 65536) + 0x8000 + ((py - y0) * (((x1 - x0) * 65536) / (y1 - y0)))) >> 16;
+    before += (cross < px) ? 1u : 0u;
+    on |= (cross == px) ? 1u : 0u;
+  }
+
+  return ((before & 1u) || on) ? 1u : 0u;
+}
+
+/**
+ * @brief  Pixel centers inside the ellipse of radii rx + 1/2 and
+ *         ry + 1/2, the midpoint rule: a circle of radius r covers the
+ *         pixels with dx^2 + dy^2 <= r^2 + r.
+ */
+static uint32_t lcd_in_ellipse(int32_t dx, int32_t dy, int32_t rx, int32_t ry)
+{
+  int64_t a2 = (int64_t)((2 * rx) + 1) * ((2 * rx) + 1);
+  int64_t b2 = (int64_t)((2 * ry) + 1) * ((2 * ry) + 1);
+
+  return ((4 * (int64_t)dx * dx * b2) + (4 * (int64_t)dy * dy * a2) <= (a2 * b2)) ? 1u : 0u;
+}
+
+/**
+ * @brief  Draws in the model, with the text color, the pixels of the
+ *         screen a shape covers.
+ */
+static void lcd_model_shape(lcd_primitive_t primitive, const int32_t *arg, const Point *pPoints, uint32_t count,
+                            uint16_t color)
+{
+  uint32_t x, y, in = 0u;
+
+  for (y = 0u; y < LCD_YSIZE; y++)
+  {
+    for (x = 0u; x < LCD_XSIZE; x++)
+    {
+      switch (primitive)
+      {
+        case LCD_CIRCLE:
+          in = (((((int32_t)x - arg[0]) * ((int32_t)x - arg[0])) + (((int32_t)y - arg[1]) * ((int32_t)y - arg[1]))) <=
+                ((arg[2] * arg[2]) + arg[2])) ? 1u : 0u;
+          break;
+        case LCD_ELLIPSE:
+          in = lcd_in_ellipse((int32_t)x - arg[0], (int32_t)y - arg[1], arg[2], arg[3]);
+          break;
+        default:
+          in = lcd_in_polygon(pPoints, count, (int32_t)x, (int32_t)y);
+          break;
+      }
+      if (in)
+      {
+        lcdModel[y][x] = color;
+      }
+    }
+  }
+}
+
+/**
+ * @brief  Circles of random centers and radii, radius 0 and circles
+ *         touching or crossing the edges of the screen included.
+ */
+static void check_fill_circle(void)
+{
+  int32_t arg[3];
+  uint16_t color;
+  uint32_t i, bad = 0u;
+
+  for (i = 0u; i < 120u; i++)
+  {
+    arg[0] = (int32_t)host_below(LCD_XSIZE);
+    arg[1] = (int32_t)host_below(LCD_YSIZE);
+    arg[2] = (int32_t)host_below(((i % 3u) == 0u) ? 4u : 160u);
+    if ((i % 4u) == 1u)
+    {
+      /* Touching an edge */
+      arg[0] = (int32_t)(host_below(2u) ? (uint32_t)arg[2] : (LCD_XSIZE - 1u - (uint32_t)arg[2]));
+      arg[1] = (int32_t)(host_below(2u) ? (uint32_t)arg[2] : (LCD_YSIZE - 1u - (uint32_t)arg[2]));
+    }
+    if ((i % 8u) == 2u)
+    {
+      arg[0] = (int32_t)(host_below(2u) ? 0u : (LCD_XSIZE - 1u));
+      arg[1] = (int32_t)(host_below(2u) ? 0u : (LCD_YSIZE - 1u));
+    }
+    color = (uint16_t)host_random();
+
+    BSP_LCD_SetTextColor(color);
+    BSP_LCD_FillCircle((uint16_t)arg[0], (uint16_t)arg[1], (uint16_t)arg[2]);
+    lcd_model_shape(LCD_CIRCLE, arg, NULL, 0u, color);
+    bad += lcd_diff();
+  }
+  host_check_equal("lcd/fill circle", 120u, bad);
+}
+
+/**
+ * @brief  Ellipses of random centers, on the screen or not, and radii,
+ *         flat and single pixel ones included.
+ */
+static void check_fill_ellipse(void)
+{
+  int32_t arg[4];
+  uint16_t color;
+  uint32_t i, bad = 0u;
+
+  for (i = 0u; i < 120u; i++)
+  {
+    arg[0] = (int32_t)host_below(LCD_XSIZE + 120u) - 60;
+    arg[1] = (int32_t)host_below(LCD_YSIZE + 120u) - 60;
+    arg[2] = (int32_t)host_below(((i % 3u) == 0u) ? 4u : 200u);
+    arg[3] = (int32_t)host_below(((i % 5u) == 0u) ? 4u : 150u);
+    if ((i % 4u) == 1u)
+    {
+      /* Touching the left and the top edges */
+      arg[0] = arg[2];
+      arg[1] = arg[3];
+    }
+    color = (uint16_t)host_random();
+
+    BSP_LCD_SetTextColor(color);
+    BSP_LCD_FillEllipse(arg[0], arg[1], arg[2], arg[3]);
+    lcd_model_shape(LCD_ELLIPSE, arg, NULL, 0u, color);
+    bad += lcd_diff();
+  }
+  host_check_equal("lcd/fill ellipse", 120u, bad);
+}
+
+static uint32_t lcd_gcd(uint32_t a, uint32_t b)
+{
+  uint32_t r;
+
+  while (b != 0u)
+  {
+    r = a % b;
+    a = b;
+    b = r;
+  }
+
+  return a;
+}
+
+/**
+ * @brief  Point at a distance along the edges of the 200 x 160 rectangle
+ *         centered on the screen, clockwise from its top left corner.
+ */
+static void lcd_perimeter_point(Point *pPoint, uint32_t distance)
+{
+  int16_t left = 60, top = 40, right = 260, bottom = 200;
+
+  if (distance < 200u)
+  {
+    pPoint->X = (int16_t)(left + (int16_t)distance);
+    pPoint->Y = top;
+  }
+  else if (distance < 360u)
+  {
+    pPoint->X = right;
+    pPoint->Y = (int16_t)(top + (int16_t)(distance - 200u));
+  }
+  else if (distance < 560u)
+  {
+    pPoint->X = (int16_t)(right - (int16_t)(distance - 360u));
+    pPoint->Y = bottom;
+  }
+  else
+  {
+    pPoint->X = left;
+    pPoint->Y = (int16_t)(bottom - (int16_t)(distance - 560u));
+  }
+}
+
+/**
+ * @brief  Random polygons, mostly concave and self-intersecting, with
+ *         vertices off the screen, shared lines and flat ones; stars of
+ *         LCD_POLY_MAX_POINTS points; a polygon of one more point is not
+ *         drawn. Triangles go through BSP_LCD_FillTriangle.
+ */
+static void check_fill_polygon(void)
+{
+  static Point points[LCD_POLY_MAX_POINTS + 1u];
+  uint32_t i, p, count, step, bad = 0u;
+  uint16_t color;
+
+  for (i = 0u; i < 300u; i++)
+  {
+    count = 3u + host_below(LCD_POLY_MAX_POINTS - 2u);
+    if ((i % 10u) == 0u)
+    {
+      count = LCD_POLY_MAX_POINTS;
+    }
+    for (p = 0u; p < count; p++)
+    {
+      points[p].X = (int16_t)((int32_t)host_below(LCD_XSIZE + 80u) - 40);
+      points[p].Y = (int16_t)((int32_t)host_below(LCD_YSIZE + 80u) - 40);
+      if ((i % 3u) == 1u)
+      {
+        /* Horizontal edges and vertices on shared lines */
+        points[p].Y = (int16_t)(20 * (int32_t)host_below(13u) - 10);
+      }
+      if ((i % 50u) == 7u)
+      {
+        points[p].Y = 100;
+      }
+    }
+    if ((i % 10u) == 5u)
+    {
+      /* Star: points spread around a rectangle, joined step by step */
+      step = (count / 2u) - 1u;
+      while (lcd_gcd(count, step) != 1u)
+      {
+        step--;
+      }
+      for (p = 0u; p < count; p++)
+      {
+        lcd_perimeter_point(&points[p], (((p * step) % count) * 720u) / count);
+      }
+    }
+    color = (uint16_t)host_random();
+
+    BSP_LCD_SetTextColor(color);
+    if (count == 3u)
+    {
+      BSP_LCD_FillTriangle((uint16_t)points[0].X, (uint16_t)points[1].X, (uint16_t)points[2].X,
+                           (uint16_t)points[0].Y, (uint16_t)points[1].Y, (uint16_t)points[2].Y);
+    }
+    else
+    {
+      BSP_LCD_FillPolygon(points, (uint16_t)count);
+    }
+    lcd_model_shape(LCD_POLYGON, NULL, points, count, color);
+    bad += lcd_diff();
+  }
+
+  /* Over LCD_POLY_MAX_POINTS points, nothing is drawn */
+  for (p = 0u; p <= LCD_POLY_MAX_POINTS; p++)
+  {
+    points[p].X = (int16_t)host_below(LCD_XSIZE);
+    points[p].Y = (int16_t)host_below(LCD_YSIZE);
+  }
+  BSP_LCD_SetTextColor((uint16_t)host_random());
+  BSP_LCD_FillPolygon(points, LCD_POLY_MAX_POINTS + 1u);
+  bad += lcd_diff();
+
+  host_check_equal("lcd/fill polygon", 301u, bad);
+}
+
+/**
+ * @brief  A transfer error on a later request of a chain ends the
+ *         transfer with the error callback and the window restored; the
+ *         next transfer runs.
+ */
+static void check_error(void)
+{
+  uint32_t bad = 0u, completed = lcdCompleted, errors = lcdErrors;
+
+  BSP_LCD_SetTextColor(0xBEEFu);
+  host_dma_error(1u);
+  bad += (BSP_LCD_FillRect_DMA(0u, 0u, LCD_XSIZE, LCD_YSIZE) != LCD_OK) ? 1u : 0u;
+  (void)lcd_service();
+  bad += ((lcdErrors - errors) != 1u) ? 1u : 0u;
+  bad += (lcdCompleted != completed) ? 1u : 0u;
+  bad += lcd_window_restored() ? 0u : 1u;
+
+  /* The next clear runs its two requests */
+  memset(lcdModel, 0, sizeof(lcdModel));
+  bad += (BSP_LCD_Clear_DMA(0u) != LCD_OK) ? 1u : 0u;
+  bad += (lcd_service() != 2u) ? 1u : 0u;
+  bad += ((lcdCompleted - completed) != 1u) ? 1u : 0u;
+  host_check_equal("lcd/dma error", 1u, bad + lcd_diff());
+}
+
+void check_lcd(void)
+{
+  host_dma_reset();
+  host_lcd_reset();
+  if (host_rcc_map() != 0)
+  {
+    host_check_equal("lcd/rcc registers", 1u, 1u);
+    return;
+  }
+
+  check_clear();
+  check_fill_rect();
+  check_rgb_image();
+  check_bitmap();
+  check_bitmap_refused();
+  check_rle_image();
+  check_rle_refused();
+  check_error();
+
+  lcd_make_fonts();
+  check_glyphs();
+  check_glyph_cache();
+
+  check_fill_circle();
+  check_fill_ellipse();
+  check_fill_polygon();
+}
+
+/* ----------------------------------------------------------------------
+*       Transactions
+* -------------------------------------------------------------------- */
+#define LCD_BENCH_BACK          0x0000u
+#define LCD_BENCH_TEXT          0xFFFFu
+
+typedef struct
+{
+  const char *name;
+  lcd_primitive_t primitive;
+  int16_t arg[6];                 /* circle: x, y, r; ellipse: x, y, rx, ry;
+                                     triangle: x1, y1, x2, y2, x3, y3;
+                                     rectangle: x, y, width, height */
+  const Point *pPoints;           /* polygon */
+  uint16_t count;
+} lcd_bench_t;
+
+static const Point lcdStar[10] =
+{
+  { 160,  20 }, { 184,  87 }, { 255,  89 }, { 199, 132 }, { 219, 200 },
+  { 160, 160 }, { 101, 200 }, { 121, 132 }, {  65,  89 }, { 136,  87 }
+};
+
+static const Point lcdHexagon[6] =
+{
+  { 100,  40 }, { 220,  40 }, { 280, 120 }, { 220, 200 }, { 100, 200 }, {  40, 120 }
+};
+
+static const lcd_bench_t lcdBench[] =
+{
+  { "lcd/circle r10",          LCD_CIRCLE,   { 160, 120,  10 },                 NULL,       0u },
+  { "lcd/circle r50",          LCD_CIRCLE,   { 160, 120,  50 },                 NULL,       0u },
+  { "lcd/circle r110",         LCD_CIRCLE,   { 160, 120, 110 },                 NULL,       0u },
+  { "lcd/circle clipped",      LCD_CIRCLE,   {  10,  10,  60 },                 NULL,       0u },
+  { "lcd/ellipse 100x50",      LCD_ELLIPSE,  { 160, 120, 100,  50 },            NULL,       0u },
+  { "lcd/ellipse 20x100",      LCD_ELLIPSE,  { 160, 120,  20, 100 },            NULL,       0u },
+  { "lcd/triangle small",      LCD_TRIANGLE, { 150, 110, 170, 110, 160, 125 },  NULL,       0u },
+  { "lcd/triangle large",      LCD_TRIANGLE, {  10, 230, 310, 200, 160,  10 },  NULL,       0u },
+  { "lcd/polygon star",        LCD_POLYGON,  { 0 },                             lcdStar,    10u },
+  { "lcd/polygon hexagon",     LCD_POLYGON,  { 0 },                             lcdHexagon, 6u },
+  { "lcd/rect dma 200x100",    LCD_RECT_DMA, {  60,  70, 200, 100 },            NULL,       0u }
+};
+
+static uint32_t lcd_transactions(const host_lcd_stats_t *pStats)
+{
+  return pStats->indexWrites + pStats->registerWrites + pStats->pixelWrites + pStats->reads;
+}
+
+static void lcd_draw(const lcd_bench_t *pBench)
+{
+  static Point points[LCD_POLY_MAX_POINTS];
+  const int16_t *arg = pBench->arg;
+
+  switch (pBench->primitive)
+  {
+    case LCD_CIRCLE:
+      BSP_LCD_FillCircle((uint16_t)arg[0], (uint16_t)arg[1], (uint16_t)arg[2]);
+      break;
+    case LCD_ELLIPSE:
+      BSP_LCD_FillEllipse(arg[0], arg[1], arg[2], arg[3]);
+      break;
+    case LCD_TRIANGLE:
+      BSP_LCD_FillTriangle((uint16_t)arg[0], (uint16_t)arg[2], (uint16_t)arg[4],
+                           (uint16_t)arg[1], (uint16_t)arg[3], (uint16_t)arg[5]);
+      break;
+    case LCD_POLYGON:
+      memcpy(points, pBench->pPoints, pBench->count * sizeof(Point));
+      BSP_LCD_FillPolygon(points, pBench->count);
+      break;
+    case LCD_RECT_DMA:
+      (void)BSP_LCD_FillRect_DMA((uint16_t)arg[0], (uint16_t)arg[1], (uint16_t)arg[2], (uint16_t)arg[3]);
+      (void)lcd_service();
+      break;
+  }
+}
+
+/**
+ * @brief  Draws each primitive on a cleared screen and prints the pixels
+ *         it covers, the controller transactions of the CPU (index,
+ *         register and GRAM writes, reads) and the pixels sent by the
+ *         DMA, next to the transactions of the same pixels drawn one by
+ *         one with the WritePixel function of the controller driver.
+ */
+void bench_lcd(void)
+{
+  host_lcd_stats_t before, after;
+  uint32_t b, x, y, covered, transactions, perPixel;
+
+  host_dma_reset();
+  host_lcd_reset();
+  if ((host_rcc_map() != 0) || (BSP_LCD_Init() != LCD_OK) || (BSP_LCD_DMA_Init() != LCD_OK))
+  {
+    fprintf(stderr, "lcd: no LCD\n");
+    return;
+  }
+
+  host_lcd_stats(&before);
+  ili9325_WritePixel(0u, 0u, LCD_BENCH_TEXT);
+  host_lcd_stats(&after);
+  perPixel = lcd_transactions(&after) - lcd_transactions(&before);
+
+  printf("%-24s %7s %9s %7s %9s %9s %7s %9s %11s\n", "primitive", "pixels", "transact", "index",
+         "register", "gram", "dma", "per pixel", "WritePixel");
+
+  for (b = 0u; b < (sizeof(lcdBench) / sizeof(lcdBench[0])); b++)
+  {
+    if (!host_selected(lcdBench[b].name))
+    {
+      continue;
+    }
+
+    (void)BSP_LCD_Clear_DMA(LCD_BENCH_BACK);
+    (void)lcd_service();
+    BSP_LCD_SetTextColor(LCD_BENCH_TEXT);
+
+    host_lcd_stats(&before);
+    lcd_draw(&lcdBench[b]);
+    host_lcd_stats(&after);
+
+    covered = 0u;
+    for (y = 0u; y < LCD_YSIZE; y++)
+    {
+      for (x = 0u; x < LCD_XSIZE; x++)
+      {
+        covered += (host_lcd_pixel((uint16_t)x, (uint16_t)y) == LCD_BENCH_TEXT) ? 1u : 0u;
+      }
+    }
+    transactions = lcd_transactions(&after) - lcd_transactions(&before);
+
+    printf("%-24s %7u %9u %7u %9u %9u %7u %9.3f %11u\n", lcdBench[b].name, covered, transactions,
+           after.indexWrites - before.indexWrites, after.registerWrites - before.registerWrites,
+           after.pixelWrites - before.pixelWrites, after.dmaWrites - before.dmaWrites,
+           (covered != 0u) ? (double)transactions / (double)covered : 0.0, covered * perPixel);
+  }
+}
@@ -0,0 +1,647 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        nordb.c
+*
+* Description:  Checks of the card UID database of stm32l152d_eval_nordb.c
+*               against a reference set of cards, on the NOR flash model:
+*               lookups of 4 and 7-byte UIDs over indexes of 2^k - 1 and
+*               2^k entries, the Eytzinger layout of the index, updates
+*               through the journal across remounts and compactions, a
+*               full slot, and power failures at every program and erase
+*               of a journal record or a new image.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bsp_suites.h"
+#include "stm32l152d_eval_nordb.h"
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+#define DB_BASE                 NORDB_BLOCK_SIZE          /* NOR offset of the database */
+#define DB_AREA                 (2u * NORDB_SLOT_BLOCKS * NORDB_BLOCK_SIZE)
+#define DB_MAX_CARDS            8300u
+#define DB_PROBES               64u       /* cards looked up that are not in the set */
+
+typedef struct
+{
+  uint8_t  uid[NORDB_UID_MAX_SIZE];
+  uint8_t  size;
+  uint32_t access;
+} db_card_t;
+
+/* Static, as they must survive the longjmp() of a power cut */
+static db_card_t dbModel[DB_MAX_CARDS];
+static uint32_t dbCount;
+static db_card_t dbSaved[DB_MAX_CARDS];   /* set before the interrupted operation */
+static uint32_t dbSavedCount;
+static uint8_t dbImage[DB_BASE + DB_AREA];
+static uint32_t dbErrors;                 /* calls that returned an error */
+
+static uint32_t db_find(const db_card_t *pCard)
+{
+  uint32_t i;
+
+  for (i = 0u; i < dbCount; i++)
+  {
+    if ((dbModel[i].size == pCard->size) && (memcmp(dbModel[i].uid, pCard->uid, pCard->size) == 0))
+    {
+      break;
+    }
+  }
+
+  return i;
+}
+
+/**
+ * @brief  A card not in the set, with a 4 or a 7-byte UID.
+ */
+static void db_new_card(db_card_t *pCard)
+{
+  do
+  {
+    memset(pCard, 0, sizeof(*pCard));
+    pCard->size = (host_below(2u) != 0u) ? 7u : 4u;
+    host_bytes(pCard->uid, pCard->size);
+    pCard->access = host_random();
+  }
+  while (db_find(pCard) < dbCount);
+}
+
+/**
+ * @brief  Grants a card, or changes its access rights, in the database
+ *         and in the set.
+ */
+static void db_put(const db_card_t *pCard)
+{
+  uint32_t i = db_find(pCard);
+
+  if (BSP_NORDB_Put(pCard->uid, pCard->size, pCard->access) != NORDB_OK)
+  {
+    dbErrors++;
+    return;
+  }
+  if (i == dbCount)
+  {
+    dbCount++;
+  }
+  dbModel[i] = *pCard;
+}
+
+/**
+ * @brief  Revokes the card at a position of the set.
+ */
+static void db_delete(uint32_t i)
+{
+  if (BSP_NORDB_Delete(dbModel[i].uid, dbModel[i].size) != NORDB_OK)
+  {
+    dbErrors++;
+    return;
+  }
+  dbModel[i] = dbModel[--dbCount];
+}
+
+/**
+ * @brief  Adds new cards to the database and to the set.
+ */
+static void db_add(uint32_t cards)
+{
+  db_card_t card;
+
+  while (cards-- > 0u)
+  {
+    db_new_card(&card);
+    db_put(&card);
+  }
+}
+
+/**
+ * @brief  Looks up one card of the set.
+ * @return 0, or 1 when the database does not give its access rights
+ */
+static uint32_t db_lookup(const db_card_t *pCard)
+{
+  uint32_t access = ~pCard->access;
+
+  return ((BSP_NORDB_Lookup(pCard->uid, pCard->size, &access) != NORDB_OK) || (access != pCard->access)) ? 1u : 0u;
+}
+
+/**
+ * @brief  Looks up every card of the set, and cards that are not in it:
+ *         random ones, and neighbors of cards of the set, one UID byte
+ *         away or with the same bytes and the other UID size.
+ * @return cards the database gets wrong
+ */
+static uint32_t db_diff(void)
+{
+  db_card_t probe;
+  uint32_t i, bad = 0u;
+
+  for (i = 0u; i < dbCount; i++)
+  {
+    bad += db_lookup(&dbModel[i]);
+  }
+
+  for (i = 0u; i < DB_PROBES; i++)
+  {
+    db_new_card(&probe);
+    if ((dbCount > 0u) && ((i % 2u) != 0u))
+    {
+      probe = dbModel[host_below(dbCount)];
+      if ((i % 4u) == 1u)
+      {
+        probe.uid[probe.size - 1u] += (uint8_t)(1u + host_below(255u));
+      }
+      else
+      {
+        probe.size = (probe.size == 4u) ? 7u : 4u;
+      }
+      if (db_find(&probe) < dbCount)
+      {
+        continue;
+      }
+    }
+    bad += (BSP_NORDB_Lookup(probe.uid, probe.size, NULL) != NORDB_NOT_FOUND) ? 1u : 0u;
+  }
+
+  return bad;
+}
+
+/**
+ * @brief  Ranks of the index nodes, walked in order from node k, that are
+ *         not the next ranks, or whose keys are not the ones of their
+ *         entries.
+ */
+static uint32_t db_walk(const NORDB_NodeTypeDef *pIndex, const NORDB_EntryTypeDef *pEntries, uint32_t count,
+                        uint32_t k, uint32_t *pRank)
+{
+  uint32_t bad = 0u;
+
+  if (k > count)
+  {
+    return 0u;
+  }
+
+  bad += db_walk(pIndex, pEntries, count, 2u * k, pRank);
+  bad += ((pIndex[k].Rank != *pRank) || (pIndex[k].KeyHigh != pEntries[*pRank].KeyHigh) ||
+          (pIndex[k].KeyLow != pEntries[*pRank].KeyLow)) ? 1u : 0u;
+  (*pRank)++;
+  bad += db_walk(pIndex, pEntries, count, (2u * k) + 1u, pRank);
+
+  return bad;
+}
+
+/**
+ * @brief  Checks the image of a compacted database: as many entries as
+ *         cards in the set, sorted by key, and an index that gives them
+ *         in order when walked in order.
+ */
+static uint32_t db_layout(void)
+{
+  const NORDB_HeaderTypeDef *header = BSP_NORDB_GetHeader();
+  const NORDB_EntryTypeDef *entries;
+  uint32_t i, rank = 0u, bad = 0u;
+
+  if (header == NULL)
+  {
+    return 1u;
+  }
+  entries = (const NORDB_EntryTypeDef *)((const uint8_t *)header + header->EntriesOffset);
+
+  bad += (header->Count != dbCount) ? 1u : 0u;
+  for (i = 1u; i < header->Count; i++)
+  {
+    bad += ((entries[i - 1u].KeyHigh > entries[i].KeyHigh) ||
+            ((entries[i - 1u].KeyHigh == entries[i].KeyHigh) && (entries[i - 1u].KeyLow >= entries[i].KeyLow))) ? 1u : 0u;
+  }
+  bad += db_walk((const NORDB_NodeTypeDef *)((const uint8_t *)header + header->IndexOffset), entries,
+                 header->Count, 1u, &rank);
+  bad += (rank != header->Count) ? 1u : 0u;
+
+  return bad;
+}
+
+/**
+ * @brief  Faults of the NOR model: bits set by a program, operations out
+ *         of the memory or across a write buffer page.
+ */
+static uint32_t db_nor_faults(void)
+{
+  host_nor_stats_t stats;
+
+  host_nor_stats(&stats);
+
+  return stats.bitSets + stats.refused;
+}
+
+/**
+ * @brief  Program and erase operations of the NOR so far.
+ */
+static uint32_t db_nor_operations(void)
+{
+  host_nor_stats_t stats;
+
+  host_nor_stats(&stats);
+
+  return stats.programs + stats.erases;
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  A blank or foreign area is formatted at mount; bad arguments
+ *         are refused.
+ */
+static void check_format(void)
+{
+  const NORDB_HeaderTypeDef *header;
+  db_card_t card;
+  uint32_t bad = 0u;
+
+  dbCount = 0u;
+  host_nor_fill(0xFFu);
+  bad += (BSP_NORDB_Init(DB_BASE) != NORDB_OK) ? 1u : 0u;
+  header = BSP_NORDB_GetHeader();
+  bad += ((header == NULL) || (header->Count != 0u) || (header->Sequence != 1u)) ? 1u : 0u;
+  bad += db_diff();
+
+  host_nor_fill(0x00u);
+  bad += (BSP_NORDB_Init(DB_BASE) != NORDB_OK) ? 1u : 0u;
+  bad += db_diff();
+  db_add(3u);
+  bad += db_diff();
+
+  bad += (BSP_NORDB_Init(DB_BASE + 2u) != NORDB_ERROR) ? 1u : 0u;
+  bad += (BSP_NORDB_Init(DB_BASE) != NORDB_OK) ? 1u : 0u;
+  db_new_card(&card);
+  bad += (BSP_NORDB_Put(card.uid, 0u, 1u) != NORDB_ERROR) ? 1u : 0u;
+  bad += (BSP_NORDB_Put(card.uid, NORDB_UID_MAX_SIZE + 1u, 1u) != NORDB_ERROR) ? 1u : 0u;
+  bad += (BSP_NORDB_Lookup(card.uid, NORDB_UID_MAX_SIZE + 1u, NULL) != NORDB_NOT_FOUND) ? 1u : 0u;
+  bad += db_diff();
+
+  host_check_equal("nordb/format", 1u, bad + dbErrors + db_nor_faults());
+}
+
+/**
+ * @brief  Lookups in compacted databases of 0, 1, 2^k - 1 and 2^k cards,
+ *         their 4 and 7-byte UIDs mixed; the largest ones span both
+ *         blocks of a slot.
+ */
+static void check_lookup(void)
+{
+  uint32_t k, n, bad = 0u, sizes = 0u;
+
+  for (k = 0u; k <= 12u; k++)
+  {
+    for (n = (k == 0u) ? 0u : ((1u << k) - 1u); n <= (1u << k); n++)
+    {
+      if ((k == 1u) && (n == 1u))
+      {
+        continue;
+      }
+      dbCount = 0u;
+      bad += (BSP_NORDB_Format() != NORDB_OK) ? 1u : 0u;
+      db_add(n);
+      bad += (BSP_NORDB_Compact() != NORDB_OK) ? 1u : 0u;
+      bad += db_layout();
+      bad += db_diff();
+      sizes++;
+    }
+  }
+
+  host_check_equal("nordb/lookup", sizes, bad + dbErrors + db_nor_faults());
+}
+
+/**
+ * @brief  Cards are granted until the entries do not fit in a slot: the
+ *         grant is refused and the cards already granted stay.
+ */
+static void check_full(void)
+{
+  db_card_t card;
+  uint8_t status = NORDB_OK;
+  uint32_t bad = 0u;
+
+  dbCount = 0u;
+  bad += (BSP_NORDB_Format() != NORDB_OK) ? 1u : 0u;
+  while ((status == NORDB_OK) && (dbCount < DB_MAX_CARDS))
+  {
+    db_new_card(&card);
+    status = BSP_NORDB_Put(card.uid, card.size, card.access);
+    if (status == NORDB_OK)
+    {
+      dbModel[dbCount++] = card;
+    }
+  }
+
+  /* 32 bytes of entry and index node a card, the journal and the header */
+  bad += ((status != NORDB_FULL) ||
+          (dbCount < (((NORDB_SLOT_BLOCKS * NORDB_BLOCK_SIZE) - 4096u) / 32u))) ? 1u : 0u;
+  bad += (BSP_NORDB_Lookup(card.uid, card.size, NULL) != NORDB_NOT_FOUND) ? 1u : 0u;
+  bad += db_diff();
+  bad += (BSP_NORDB_Init(DB_BASE) != NORDB_OK) ? 1u : 0u;
+  bad += db_diff();
+
+  host_check_equal("nordb/full", 1u, bad + dbErrors + db_nor_faults());
+}
+
+/**
+ * @brief  Random grants, changes and revocations through the journal,
+ *         with compactions when it is full, remounts, unchanged cards
+ *         that cost no record, and a last compaction.
+ */
+static void check_journal(void)
+{
+  db_card_t card;
+  uint32_t i, before, bad = 0u;
+
+  dbCount = 0u;
+  bad += (BSP_NORDB_Format() != NORDB_OK) ? 1u : 0u;
+
+  for (i = 0u; i < 3000u; i++)
+  {
+    switch (host_below(8u))
+    {
+      case 0u:
+      case 1u:
+      case 2u:
+        db_new_card(&card);
+        if (dbCount < 500u)
+        {
+          db_put(&card);
+          bad += db_lookup(&card);
+        }
+        break;
+      case 3u:
+      case 4u:
+        if (dbCount > 0u)
+        {
+          card = dbModel[host_below(dbCount)];
+          card.access ^= 1u + host_below(0xFFFFu);
+          db_put(&card);
+          bad += db_lookup(&card);
+        }
+        break;
+      case 5u:
+      case 6u:
+        if (dbCount > 0u)
+        {
+          card = dbModel[host_below(dbCount)];
+          db_delete(db_find(&card));
+          bad += (BSP_NORDB_Lookup(card.uid, card.size, NULL) != NORDB_NOT_FOUND) ? 1u : 0u;
+        }
+        break;
+      default:
+        /* Unchanged cards and absent ones: nothing is programmed */
+        before = db_nor_operations();
+        if (dbCount > 0u)
+        {
+          db_put(&dbModel[host_below(dbCount)]);
+        }
+        db_new_card(&card);
+        bad += (BSP_NORDB_Delete(card.uid, card.size) != NORDB_OK) ? 1u : 0u;
+        bad += (db_nor_operations() != before) ? 1u : 0u;
+        break;
+    }
+
+    if ((i % 250u) == 249u)
+    {
+      bad += (BSP_NORDB_Init(DB_BASE) != NORDB_OK) ? 1u : 0u;
+      bad += db_diff();
+    }
+  }
+
+  bad += (BSP_NORDB_Compact() != NORDB_OK) ? 1u : 0u;
+  bad += db_layout();
+  bad += db_diff();
+
+  host_check_equal("nordb/journal", 3000u, bad + dbErrors + db_nor_faults());
+}
+
+typedef enum
+{
+  DB_PUT = 0,                     /* a journal record */
+  DB_DELETE,
+  DB_COMPACT,                     /* a new image */
+  DB_FORMAT,
+  DB_PUT_FULL                     /* a new image, then a journal record */
+} db_operation_t;
+
+/**
+ * @brief  Runs an operation on a card.
+ */
+static uint8_t db_operation(db_operation_t operation, const db_card_t *pCard)
+{
+  switch (operation)
+  {
+    case DB_DELETE:
+      return BSP_NORDB_Delete(pCard->uid, pCard->size);
+    case DB_COMPACT:
+      return BSP_NORDB_Compact();
+    case DB_FORMAT:
+      return BSP_NORDB_Format();
+    default:
+      return BSP_NORDB_Put(pCard->uid, pCard->size, pCard->access);
+  }
+}
+
+/**
+ * @brief  Sets the set of cards before or after an operation.
+ */
+static void db_expect(db_operation_t operation, const db_card_t *pCard, uint32_t after)
+{
+  uint32_t i;
+
+  memcpy(dbModel, dbSaved, sizeof(dbModel));
+  dbCount = dbSavedCount;
+  if (after == 0u)
+  {
+    return;
+  }
+
+  i = db_find(pCard);
+  switch (operation)
+  {
+    case DB_DELETE:
+      dbModel[i] = dbModel[--dbCount];
+      break;
+    case DB_FORMAT:
+      dbCount = 0u;
+      break;
+    case DB_PUT:
+    case DB_PUT_FULL:
+      dbCount += (i == dbCount) ? 1u : 0u;
+      dbModel[i] = *pCard;
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief  Power cut at every program and erase of an operation, before it
+ *         starts and torn, from the same database each time. The operation
+ *         takes effect with one program, the commit halfword of its journal
+ *         record or the Status of its new image: the mount gives the
+ *         database before the operation when the cut comes earlier, the one
+ *         after it when the cut comes later, either of them when the cut
+ *         tears that program, and the database keeps working.
+ */
+static void check_power_cut(db_operation_t operation, const char *name)
+{
+  static db_card_t card;
+  static uint32_t cut, step, steps, sequence, bad;
+  static host_nor_cut_t mode;
+  uint32_t i, commit, retire;
+  const NORDB_HeaderTypeDef *header;
+
+  bad = 0u;
+  dbCount = 0u;
+  bad += (BSP_NORDB_Format() != NORDB_OK) ? 1u : 0u;
+  db_add(60u);
+  bad += (BSP_NORDB_Compact() != NORDB_OK) ? 1u : 0u;
+
+  /* Journal records over the index, filling the journal for DB_PUT_FULL */
+  for (i = 0u; i < ((operation == DB_PUT_FULL) ? NORDB_JOURNAL_ENTRIES : 40u); i++)
+  {
+    if ((i % 3u) == 0u)
+    {
+      db_add(1u);
+    }
+    else
+    {
+      card = dbModel[host_below(dbCount)];
+      if ((i % 3u) == 1u)
+      {
+        card.access ^= 1u + host_below(0xFFFFu);
+        db_put(&card);
+      }
+      else
+      {
+        db_delete(db_find(&card));
+      }
+    }
+  }
+  if (operation == DB_DELETE)
+  {
+    card = dbModel[host_below(dbCount)];
+  }
+  else
+  {
+    db_new_card(&card);
+  }
+
+  memcpy(dbImage, (const void *)(uintptr_t)NOR_DEVICE_ADDR, sizeof(dbImage));
+  memcpy(dbSaved, dbModel, sizeof(dbSaved));
+  dbSavedCount = dbCount;
+  sequence = BSP_NORDB_GetHeader()->Sequence;
+
+  /* The uninterrupted run, and its result after a remount */
+  steps = db_nor_operations();
+  bad += (db_operation(operation, &card) != NORDB_OK) ? 1u : 0u;
+  steps = db_nor_operations() - steps;
+  bad += (BSP_NORDB_Init(DB_BASE) != NORDB_OK) ? 1u : 0u;
+  db_expect(operation, &card, 1u);
+  bad += db_diff();
+
+  /* A new image ends with its Status, then the one of the previous image;
+     a journal record with its commit halfword */
+  switch (operation)
+  {
+    case DB_PUT:
+    case DB_DELETE:
+      commit = steps - 1u;
+      retire = steps;
+      break;
+    case DB_PUT_FULL:
+      commit = steps - 1u;
+      retire = steps - 4u;
+      break;
+    default:
+      commit = steps - 2u;
+      retire = steps - 2u;
+      break;
+  }
+
+  for (cut = 0u; cut < (2u * steps); cut++)
+  {
+    step = cut / 2u;
+    mode = ((cut % 2u) == 0u) ? HOST_NOR_CUT : HOST_NOR_TORN;
+    host_nor_load(dbImage, sizeof(dbImage));
+    bad += (BSP_NORDB_Init(DB_BASE) != NORDB_OK) ? 1u : 0u;
+
+    host_nor_power_cut(step, mode);
+    if (setjmp(host_power_fail) == 0)
+    {
+      (void)db_operation(operation, &card);
+      /* The cut did not come */
+      bad++;
+    }
+    host_nor_power_on();
+
+    if (BSP_NORDB_Init(DB_BASE) != NORDB_OK)
+    {
+      bad++;
+      continue;
+    }
+    header = BSP_NORDB_GetHeader();
+    bad += (header->Sequence == sequence) ? ((step > retire) ? 1u : 0u) :
+           (((header->Sequence != (sequence + 1u)) || (step < retire) ||
+             ((step == retire) && (mode == HOST_NOR_CUT))) ? 1u : 0u);
+
+    i = 1u;
+    if (step <= commit)
+    {
+      db_expect(operation, &card, 0u);
+      i = db_diff();
+    }
+    if ((i != 0u) && ((step > commit) || ((step == commit) && (mode == HOST_NOR_TORN))))
+    {
+      db_expect(operation, &card, 1u);
+      i = db_diff();
+    }
+    bad += i;
+
+    /* And the database keeps working */
+    db_add(2u);
+    bad += (BSP_NORDB_Compact() != NORDB_OK) ? 1u : 0u;
+    bad += db_layout();
+    bad += db_diff();
+  }
+
+  host_check_equal(name, 2u * steps, bad + dbErrors + db_nor_faults());
+}
+
+void check_nordb(void)
+{
+  char path[] = "/tmp/bsp_check_nor.XXXXXX";
+  int file = mkstemp(path);
+
+  if ((file < 0) || (close(file) != 0) || (host_nor_open(path) != 0))
+  {
+    host_check_equal("nordb/nor file", 1u, 1u);
+    return;
+  }
+
+  dbErrors = 0u;
+  check_format();
+  check_lookup();
+  check_full();
+  check_journal();
+  check_power_cut(DB_PUT, "nordb/power cut put");
+  check_power_cut(DB_DELETE, "nordb/power cut delete");
+  check_power_cut(DB_COMPACT, "nordb/power cut compact");
+  check_power_cut(DB_FORMAT, "nordb/power cut format");
+  check_power_cut(DB_PUT_FULL, "nordb/power cut full journal");
+
+  host_nor_close();
+  unlink(path);
+}
@@ -0,0 +1,410 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        sdcache.c
+*
+* Description:  Checks of the block cache of stm32l152d_eval_sdcache.c
+*               on the file-backed uSD card: hit, miss, read-ahead and
+*               write-back counters, LRU eviction, read-ahead on
+*               sequential misses, write-through against write-back, and
+*               random reads and writes against a flat model of the card.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bsp_suites.h"
+#include "stm32l152d_eval_sdcache.h"
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+#define CACHE_CARD_BLOCKS       256u      /* card size */
+#define CACHE_WORDS             (SDCACHE_BLOCK_SIZE / 4u)
+#define CACHE_MAX_REQUEST       (2u * SDCACHE_READAHEAD_BLOCKS)
+
+/* Content the cache reads should give, and content of the card */
+static uint32_t cacheModel[CACHE_CARD_BLOCKS][CACHE_WORDS];
+static uint32_t cacheCard[CACHE_CARD_BLOCKS][CACHE_WORDS];
+
+/* Buffers of the transfers: static, as for the DMA */
+static uint32_t cacheBuffer[CACHE_MAX_REQUEST][CACHE_WORDS];
+
+static uint32_t cacheErrors;              /* calls that returned an error */
+
+/**
+ * @brief  Fills the card and the model with random blocks, and starts
+ *         the cache empty with a write policy.
+ */
+static void cache_reset(uint32_t policy)
+{
+  host_bytes((uint8_t *)cacheModel, sizeof(cacheModel));
+  cacheErrors += (BSP_SD_WriteBlocks(cacheModel[0], 0u, SDCACHE_BLOCK_SIZE, CACHE_CARD_BLOCKS) != MSD_OK) ? 1u : 0u;
+  BSP_SDCACHE_Init(policy);
+}
+
+/**
+ * @brief  Reads blocks through the cache.
+ * @return blocks that differ from the model
+ */
+static uint32_t cache_read(uint32_t block, uint32_t count)
+{
+  uint32_t b, bad = 0u;
+
+  memset(cacheBuffer, 0, sizeof(cacheBuffer));
+  if (BSP_SDCACHE_ReadBlocks(cacheBuffer[0], (uint64_t)block * SDCACHE_BLOCK_SIZE, SDCACHE_BLOCK_SIZE, count) != MSD_OK)
+  {
+    cacheErrors++;
+    return count;
+  }
+  for (b = 0u; b < count; b++)
+  {
+    bad += (memcmp(cacheBuffer[b], cacheModel[block + b], SDCACHE_BLOCK_SIZE) != 0) ? 1u : 0u;
+  }
+
+  return bad;
+}
+
+/**
+ * @brief  Writes random blocks through the cache and to the model.
+ */
+static void cache_write(uint32_t block, uint32_t count)
+{
+  host_bytes((uint8_t *)cacheBuffer, count * SDCACHE_BLOCK_SIZE);
+  memcpy(cacheModel[block], cacheBuffer, count * SDCACHE_BLOCK_SIZE);
+  if (BSP_SDCACHE_WriteBlocks(cacheBuffer[0], (uint64_t)block * SDCACHE_BLOCK_SIZE, SDCACHE_BLOCK_SIZE, count) != MSD_OK)
+  {
+    cacheErrors++;
+  }
+}
+
+/**
+ * @brief  Blocks of the card, read around the cache, that differ from
+ *         the model.
+ */
+static uint32_t cache_card_diff(void)
+{
+  uint32_t b, bad = 0u;
+
+  cacheErrors += (BSP_SD_ReadBlocks(cacheCard[0], 0u, SDCACHE_BLOCK_SIZE, CACHE_CARD_BLOCKS) != MSD_OK) ? 1u : 0u;
+  for (b = 0u; b < CACHE_CARD_BLOCKS; b++)
+  {
+    bad += (memcmp(cacheCard[b], cacheModel[b], SDCACHE_BLOCK_SIZE) != 0) ? 1u : 0u;
+  }
+
+  return bad;
+}
+
+/**
+ * @brief  Faults in the counters of the cache and of the card.
+ */
+static uint32_t cache_counters(uint32_t hits, uint32_t misses, uint32_t readAheads, uint32_t writeBacks)
+{
+  SDCACHE_StatsTypeDef stats;
+
+  BSP_SDCACHE_GetStats(&stats);
+
+  return ((stats.Hits != hits) ? 1u : 0u) + ((stats.Misses != misses) ? 1u : 0u) +
+         ((stats.ReadAheads != readAheads) ? 1u : 0u) + ((stats.WriteBacks != writeBacks) ? 1u : 0u);
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  A block read twice is a miss, then a hit; the block after the
+ *         last one read is a miss that reads ahead, with one transfer of
+ *         the card, and the blocks read ahead are hits; a read elsewhere
+ *         reads one block.
+ */
+static void check_counters(void)
+{
+  host_sd_stats_t before, after;
+  uint32_t bad = 0u, b;
+
+  cache_reset(SDCACHE_WRITE_THROUGH);
+
+  bad += cache_read(10u, 1u);
+  bad += cache_read(10u, 1u);
+  bad += cache_counters(1u, 1u, 0u, 0u);
+
+  host_sd_stats(&before);
+  bad += cache_read(11u, 1u);
+  host_sd_stats(&after);
+  bad += ((after.reads - before.reads) != 1u) ? 1u : 0u;
+  bad += ((after.blocksRead - before.blocksRead) != SDCACHE_READAHEAD_BLOCKS) ? 1u : 0u;
+  bad += cache_counters(1u, 2u, 1u, 0u);
+
+  for (b = 1u; b < SDCACHE_READAHEAD_BLOCKS; b++)
+  {
+    bad += cache_read(11u + b, 1u);
+  }
+  bad += cache_counters(SDCACHE_READAHEAD_BLOCKS, 2u, 1u, 0u);
+
+  host_sd_stats(&before);
+  bad += cache_read(100u, 1u);
+  host_sd_stats(&after);
+  bad += ((after.blocksRead - before.blocksRead) != 1u) ? 1u : 0u;
+  bad += cache_counters(SDCACHE_READAHEAD_BLOCKS, 3u, 1u, 0u);
+
+  /* Bulk reads bypass the cache */
+  host_sd_stats(&before);
+  bad += cache_read(40u, SDCACHE_READAHEAD_BLOCKS);
+  host_sd_stats(&after);
+  bad += ((after.reads - before.reads) != 1u) ? 1u : 0u;
+  bad += cache_counters(SDCACHE_READAHEAD_BLOCKS, 3u + SDCACHE_READAHEAD_BLOCKS, 1u, 0u);
+
+  BSP_SDCACHE_ResetStats();
+  bad += cache_counters(0u, 0u, 0u, 0u);
+
+  host_check_equal("sdcache/counters", 1u, bad + cacheErrors);
+}
+
+/**
+ * @brief  With SDCACHE_BLOCKS blocks cached, a new block evicts the
+ *         least recently used one; a hit makes its block the most
+ *         recently used.
+ */
+static void check_lru(void)
+{
+  uint32_t bad = 0u, b;
+
+  cache_reset(SDCACHE_WRITE_THROUGH);
+
+  /* Every other block, not to read ahead */
+  for (b = 0u; b < SDCACHE_BLOCKS; b++)
+  {
+    bad += cache_read(2u * b, 1u);
+  }
+  bad += cache_read(0u, 1u);
+  bad += cache_counters(1u, SDCACHE_BLOCKS, 0u, 0u);
+
+  /* Block 2 is the least recently used: it goes, block 0 stays */
+  bad += cache_read(100u, 1u);
+  bad += cache_read(0u, 1u);
+  bad += cache_counters(2u, SDCACHE_BLOCKS + 1u, 0u, 0u);
+  bad += cache_read(2u, 1u);
+  bad += cache_counters(2u, SDCACHE_BLOCKS + 2u, 0u, 0u);
+
+  /* The others are still there, but block 4, evicted by block 2 */
+  for (b = 3u; b < SDCACHE_BLOCKS; b++)
+  {
+    bad += cache_read(2u * b, 1u);
+  }
+  bad += cache_counters(2u + SDCACHE_BLOCKS - 3u, SDCACHE_BLOCKS + 2u, 0u, 0u);
+  bad += cache_read(4u, 1u);
+  bad += cache_counters(2u + SDCACHE_BLOCKS - 3u, SDCACHE_BLOCKS + 3u, 0u, 0u);
+
+  host_check_equal("sdcache/lru", 1u, bad + cacheErrors);
+}
+
+/**
+ * @brief  A sequential scan reads ahead on each miss but the first, and
+ *         a read-ahead past the end of the card falls back to one block.
+ *         Blocks newer in the cache than on the card are not replaced by
+ *         the read-ahead.
+ */
+static void check_read_ahead(void)
+{
+  uint32_t bad = 0u, b, misses;
+
+  cache_reset(SDCACHE_WRITE_BACK);
+
+  for (b = 0u; b < 64u; b++)
+  {
+    bad += cache_read(b, 1u);
+  }
+  misses = 1u + ((63u + SDCACHE_READAHEAD_BLOCKS - 1u) / SDCACHE_READAHEAD_BLOCKS);
+  bad += cache_counters(64u - misses, misses, misses - 1u, 0u);
+
+  /* The end of the card */
+  BSP_SDCACHE_ResetStats();
+  for (b = CACHE_CARD_BLOCKS - 2u; b < CACHE_CARD_BLOCKS; b++)
+  {
+    bad += cache_read(b, 1u);
+  }
+  bad += cache_counters(0u, 2u, 0u, 0u);
+
+  /* The read-ahead takes the lines least recently used as a group: here
+     the last ones, the first ones being used again */
+  BSP_SDCACHE_Init(SDCACHE_WRITE_BACK);
+  for (b = 0u; b < SDCACHE_BLOCKS; b++)
+  {
+    bad += cache_read(2u * b, 1u);
+  }
+  for (b = 0u; b < (SDCACHE_BLOCKS - SDCACHE_READAHEAD_BLOCKS); b++)
+  {
+    bad += cache_read(2u * b, 1u);
+  }
+  bad += cache_read((2u * b) - 1u, 1u);
+  BSP_SDCACHE_ResetStats();
+  for (b = 0u; b < (SDCACHE_BLOCKS - SDCACHE_READAHEAD_BLOCKS); b++)
+  {
+    bad += cache_read(2u * b, 1u);
+  }
+  bad += cache_counters(b, 0u, 0u, 0u);
+
+  /* Dirty blocks inside the range read ahead, in lines after the ones it
+     lands in: their copies on the card are not taken */
+  BSP_SDCACHE_Init(SDCACHE_WRITE_BACK);
+  for (b = 0u; b < SDCACHE_READAHEAD_BLOCKS; b++)
+  {
+    bad += cache_read(200u + (2u * b), 1u);
+  }
+  cache_write(131u, 1u);
+  cache_write(133u, 1u);
+  bad += cache_read(129u, 1u);
+  for (b = 130u; b < 136u; b++)
+  {
+    bad += cache_read(b, 1u);
+  }
+  bad += (BSP_SDCACHE_Flush() != MSD_OK) ? 1u : 0u;
+  bad += cache_card_diff();
+
+  host_check_equal("sdcache/read ahead", 1u, bad + cacheErrors);
+}
+
+/**
+ * @brief  Write-through writes reach the card at once and refresh the
+ *         cached copies; write-back writes stay in the cache until they
+ *         are evicted or flushed.
+ */
+static void check_policies(void)
+{
+  host_sd_stats_t before, after;
+  uint32_t bad = 0u, b;
+
+  cache_reset(SDCACHE_WRITE_THROUGH);
+  bad += cache_read(20u, 1u);
+  host_sd_stats(&before);
+  cache_write(20u, 1u);
+  cache_write(50u, 1u);
+  host_sd_stats(&after);
+  bad += ((after.blocksWritten - before.blocksWritten) != 2u) ? 1u : 0u;
+  bad += cache_card_diff();
+  bad += cache_read(20u, 1u);
+  bad += cache_counters(1u, 1u, 0u, 0u);
+
+  cache_reset(SDCACHE_WRITE_BACK);
+  host_sd_stats(&before);
+  for (b = 0u; b < SDCACHE_BLOCKS; b++)
+  {
+    cache_write(2u * b, 1u);
+  }
+  host_sd_stats(&after);
+  bad += (after.blocksWritten != before.blocksWritten) ? 1u : 0u;
+  bad += (cache_card_diff() != SDCACHE_BLOCKS) ? 1u : 0u;
+  for (b = 0u; b < SDCACHE_BLOCKS; b++)
+  {
+    bad += cache_read(2u * b, 1u);
+  }
+  bad += cache_counters(SDCACHE_BLOCKS, 0u, 0u, 0u);
+
+  /* One eviction writes the least recently used block back */
+  bad += cache_read(200u, 1u);
+  bad += cache_counters(SDCACHE_BLOCKS, 1u, 0u, 1u);
+  bad += (cache_card_diff() != (SDCACHE_BLOCKS - 1u)) ? 1u : 0u;
+
+  /* The flush writes the others, once */
+  bad += (BSP_SDCACHE_Flush() != MSD_OK) ? 1u : 0u;
+  bad += (BSP_SDCACHE_Flush() != MSD_OK) ? 1u : 0u;
+  bad += cache_counters(SDCACHE_BLOCKS, 1u, 0u, SDCACHE_BLOCKS);
+  bad += cache_card_diff();
+
+  /* Bulk writes go to the card in both policies */
+  cache_write(60u, SDCACHE_READAHEAD_BLOCKS);
+  bad += cache_card_diff();
+
+  host_check_equal("sdcache/policies", 1u, bad + cacheErrors);
+}
+
+/**
+ * @brief  Random reads and writes, short and bulk, sequential runs and a
+ *         hot range included, against the model. Write-through keeps the
+ *         card up to date; write-back after a flush. Every block read is
+ *         a hit or a miss.
+ */
+static void check_random(uint32_t policy, const char *name)
+{
+  SDCACHE_StatsTypeDef stats;
+  uint32_t i, block = 0u, count, bad = 0u, read = 0u;
+
+  cache_reset(policy);
+
+  for (i = 0u; i < 4000u; i++)
+  {
+    count = ((host_below(8u) == 0u) ? (1u + host_below(CACHE_MAX_REQUEST)) : (1u + host_below(2u)));
+    switch (host_below(4u))
+    {
+      case 0u:
+        block += count;                                   /* sequential */
+        break;
+      case 1u:
+        block = host_below(3u * SDCACHE_BLOCKS);          /* hot range */
+        break;
+      default:
+        block = host_below(CACHE_CARD_BLOCKS);
+        break;
+    }
+    block = (block + count > CACHE_CARD_BLOCKS) ? (CACHE_CARD_BLOCKS - count) : block;
+
+    if (host_below(3u) == 0u)
+    {
+      cache_write(block, count);
+    }
+    else
+    {
+      bad += cache_read(block, count);
+      read += count;
+    }
+
+    if ((policy == SDCACHE_WRITE_THROUGH) && ((i % 500u) == 0u))
+    {
+      bad += cache_card_diff();
+    }
+  }
+
+  BSP_SDCACHE_GetStats(&stats);
+  bad += ((stats.Hits + stats.Misses) != read) ? 1u : 0u;
+  bad += ((stats.Hits == 0u) || (stats.ReadAheads == 0u)) ? 1u : 0u;
+  bad += ((policy == SDCACHE_WRITE_THROUGH) != (stats.WriteBacks == 0u)) ? 1u : 0u;
+
+  bad += (BSP_SDCACHE_Flush() != MSD_OK) ? 1u : 0u;
+  bad += cache_card_diff();
+
+  /* Nothing is lost across an invalidation */
+  BSP_SDCACHE_Invalidate();
+  for (block = 0u; block < CACHE_CARD_BLOCKS; block += CACHE_MAX_REQUEST)
+  {
+    bad += cache_read(block, CACHE_MAX_REQUEST);
+  }
+
+  host_check_equal(name, 4000u, bad + cacheErrors);
+}
+
+void check_sdcache(void)
+{
+  char path[] = "/tmp/bsp_check_cache.XXXXXX";
+  int file = mkstemp(path);
+
+  if ((file < 0) || (close(file) != 0) || (host_sd_open(path, CACHE_CARD_BLOCKS) != 0))
+  {
+    host_check_equal("sdcache/card file", 1u, 1u);
+    return;
+  }
+
+  cacheErrors = 0u;
+  check_counters();
+  check_lru();
+  check_read_ahead();
+  check_policies();
+  check_random(SDCACHE_WRITE_THROUGH, "sdcache/random write through");
+  check_random(SDCACHE_WRITE_BACK, "sdcache/random write back");
+
+  host_sd_close();
+  unlink(path);
+}
@@ -0,0 +1,393 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L152D-EVAL BSP
+* Title:        sdlog.c
+*
+* Description:  Checks of the event log of stm32l152d_eval_sdlog.c
+*               against a model of its records, on the file-backed uSD
+*               card: time-range queries over timestamps that go back,
+*               replay at mount, and power failures at every block write.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bsp_suites.h"
+#include "stm32l152d_eval_sdlog.h"
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+#define LOG_CARD_BLOCKS         400u      /* card size */
+#define LOG_FIRST               8u        /* first block of the log range */
+#define LOG_DATA_BLOCKS         384u      /* data blocks of the log range, after its 2 superblocks */
+#define LOG_BLOCKS              (2u + LOG_DATA_BLOCKS)
+#define LOG_MAX_RECORDS         (LOG_DATA_BLOCKS * SDLOG_RECORDS_PER_BLOCK)
+#define LOG_SCRIPT              300u      /* appends under the power cut */
+#define LOG_AFTER               60u       /* appends after the restart */
+
+typedef struct
+{
+  uint32_t timestamp;
+  uint16_t type;
+  uint16_t length;
+  uint8_t  data[SDLOG_DATA_SIZE];
+} log_record_t;
+
+/* Static, as they must survive the longjmp() of a power cut */
+static log_record_t logModel[LOG_MAX_RECORDS];
+static uint32_t logCount;                 /* records appended */
+static uint32_t logDurable;               /* records written to the card */
+static uint32_t logClock;                 /* time of the next record */
+static uint32_t logErrors;                /* calls that returned an error */
+static uint32_t logBad, logInterrupted;
+
+/**
+ * @brief  Mounts the log from the card content, as after a reset.
+ */
+static void log_mount(void)
+{
+  logErrors += (BSP_SDLOG_Init(LOG_FIRST, LOG_BLOCKS) != SDLOG_OK) ? 1u : 0u;
+}
+
+/**
+ * @brief  Erases the card and formats an empty log.
+ */
+static void log_reset(void)
+{
+  host_sd_fill(0u);
+  logCount = 0u;
+  logDurable = 0u;
+  logClock = 1000u;
+  log_mount();
+}
+
+/**
+ * @brief  Appends a record to the log and to the model. The time mostly
+ *         moves on and sometimes goes back, as when the RTC is set.
+ */
+static void log_append(void)
+{
+  log_record_t *record = &logModel[logCount];
+  host_sd_stats_t before, after;
+
+  if (host_below(40u) == 0u)
+  {
+    logClock -= host_below(logClock);
+  }
+  logClock += host_below(5u);
+
+  record->timestamp = logClock;
+  record->type = (uint16_t)host_random();
+  record->length = (uint16_t)host_below(SDLOG_DATA_SIZE + 1u);
+  host_bytes(record->data, record->length);
+
+  /* The record may reach the card before the end of the call */
+  logCount++;
+  host_sd_stats(&before);
+  logErrors += (BSP_SDLOG_Append(record->timestamp, record->type, record->data, record->length) != SDLOG_OK) ? 1u : 0u;
+  host_sd_stats(&after);
+  logDurable = (after.transfers != before.transfers) ? logCount : logDurable;
+}
+
+static void log_flush(void)
+{
+  logErrors += (BSP_SDLOG_Flush() != SDLOG_OK) ? 1u : 0u;
+  logDurable = logCount;
+}
+
+/**
+ * @brief  One step of a run: an append, sometimes followed by a flush.
+ */
+static void log_step(void)
+{
+  log_append();
+  if (host_below(20u) == 0u)
+  {
+    log_flush();
+  }
+}
+
+/**
+ * @brief  Runs a time-range query.
+ * @return 0, or 1 when it does not return the records of the model in
+ *         the range, in the order they were appended
+ */
+static uint32_t log_query(uint32_t from, uint32_t to)
+{
+  SDLOG_QueryTypeDef query;
+  SDLOG_RecordTypeDef record;
+  uint32_t i;
+
+  if (BSP_SDLOG_QueryStart(&query, from, to) != SDLOG_OK)
+  {
+    return 1u;
+  }
+  for (i = 0u; i < logCount; i++)
+  {
+    if ((logModel[i].timestamp < from) || (logModel[i].timestamp > to))
+    {
+      continue;
+    }
+    if ((BSP_SDLOG_QueryNext(&query, &record) != SDLOG_OK) || (record.Sequence != i) ||
+        (record.Timestamp != logModel[i].timestamp) || (record.Type != logModel[i].type) ||
+        (record.Length != logModel[i].length) || (memcmp(record.Data, logModel[i].data, record.Length) != 0))
+    {
+      return 1u;
+    }
+  }
+
+  return (BSP_SDLOG_QueryNext(&query, &record) != SDLOG_END) ? 1u : 0u;
+}
+
+/**
+ * @brief  The whole log and random ranges around the model timestamps.
+ * @return queries that failed
+ */
+static uint32_t log_queries(uint32_t count)
+{
+  uint32_t q, from, to, bad;
+
+  bad = log_query(0u, 0xFFFFFFFFu) + ((BSP_SDLOG_GetRecordCount() != logCount) ? 1u : 0u);
+  for (q = 0u; (q < count) && (logCount != 0u); q++)
+  {
+    from = logModel[host_below(logCount)].timestamp - host_below(3u);
+    to = from + ((host_below(2u) != 0u) ? host_below(4u) : host_below(200u));
+    bad += log_query(from, to);
+  }
+
+  return bad;
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  A record below an earlier timestamp is found by the queries,
+ *         staged, written and after a restart.
+ */
+static void check_out_of_order(void)
+{
+  static const uint32_t timestamps[] = { 200u, 50u };
+  uint32_t i, bad = 0u;
+
+  log_reset();
+  for (i = 0u; i < 2u; i++)
+  {
+    memset(&logModel[i], 0, sizeof(logModel[i]));
+    logModel[i].timestamp = timestamps[i];
+    logErrors += (BSP_SDLOG_Append(timestamps[i], 0u, NULL, 0u) != SDLOG_OK) ? 1u : 0u;
+    logCount++;
+  }
+  bad += log_query(0u, 100u) + log_query(50u, 50u) + log_query(100u, 300u);
+  log_flush();
+  bad += log_query(0u, 100u) + log_query(50u, 50u) + log_query(100u, 300u);
+  log_mount();
+  bad += log_query(0u, 100u) + log_query(50u, 50u) + log_query(100u, 300u);
+  host_check_equal("sdlog/out of order", 9u, bad + logErrors);
+}
+
+/**
+ * @brief  Random queries as the log grows, over staged and written
+ *         records, then after a restart from the card file.
+ */
+static void check_queries(const char *path)
+{
+  uint32_t i, bad = 0u;
+
+  logErrors = 0u;
+  log_reset();
+  for (i = 1u; i <= 1000u; i++)
+  {
+    log_step();
+    if ((i % 50u) == 0u)
+    {
+      bad += log_queries(20u);
+    }
+  }
+  host_check_equal("sdlog/queries", 20u * 21u, bad + logErrors);
+
+  /* Only the written records come back, and the log goes on from them */
+  host_sd_close();
+  if (host_sd_open(path, LOG_CARD_BLOCKS) != 0)
+  {
+    host_check_equal("sdlog/replay", 1u, 1u);
+    return;
+  }
+  logCount = logDurable;
+  log_mount();
+  bad = log_queries(50u);
+  for (i = 0u; i < 200u; i++)
+  {
+    log_step();
+  }
+  log_flush();
+  log_mount();
+  bad += log_queries(50u);
+  host_check_equal("sdlog/replay", 2u * 51u, bad + logErrors);
+}
+
+/**
+ * @brief  Full staging blocks go to the card in one multi-block write;
+ *         in a log in time order, a query reads the blocks of its binary
+ *         search and the blocks of its range only.
+ */
+static void check_transfers(void)
+{
+  SDLOG_QueryTypeDef query;
+  SDLOG_RecordTypeDef record;
+  host_sd_stats_t before, after;
+  uint32_t i, from, bad = 0u;
+
+  logErrors = 0u;
+  log_reset();
+  host_sd_stats(&before);
+  for (i = 0u; i < (SDLOG_STAGING_BLOCKS * SDLOG_RECORDS_PER_BLOCK); i++)
+  {
+    logErrors += (BSP_SDLOG_Append(i, 0u, NULL, 0u) != SDLOG_OK) ? 1u : 0u;
+  }
+  host_sd_stats(&after);
+  bad += ((after.transfers - before.transfers) != 1u) ? 1u : 0u;
+  bad += ((after.blocksWritten - before.blocksWritten) != SDLOG_STAGING_BLOCKS) ? 1u : 0u;
+  host_check_equal("sdlog/transfers", SDLOG_STAGING_BLOCKS, bad + logErrors);
+
+  /* 64 blocks in order; a query within a block reads at most 6 blocks
+     for the search, the block before, its block and the next one */
+  bad = 0u;
+  for (; i < (64u * SDLOG_RECORDS_PER_BLOCK); i++)
+  {
+    logErrors += (BSP_SDLOG_Append(i, 0u, NULL, 0u) != SDLOG_OK) ? 1u : 0u;
+  }
+  for (i = 0u; i < 100u; i++)
+  {
+    from = host_below(64u * SDLOG_RECORDS_PER_BLOCK);
+    host_sd_stats(&before);
+    bad += (BSP_SDLOG_QueryStart(&query, from, from) != SDLOG_OK) ? 1u : 0u;
+    bad += ((BSP_SDLOG_QueryNext(&query, &record) != SDLOG_OK) || (record.Timestamp != from)) ? 1u : 0u;
+    bad += (BSP_SDLOG_QueryNext(&query, &record) != SDLOG_END) ? 1u : 0u;
+    host_sd_stats(&after);
+    bad += ((after.blocksRead - before.blocksRead) > 9u) ? 1u : 0u;
+  }
+  host_check_equal("sdlog/query reads", 100u, bad + logErrors);
+}
+
+/**
+ * @brief  A full log refuses records and keeps the ones it holds.
+ */
+static void check_full(void)
+{
+  uint32_t i, bad = 0u;
+  uint8_t status = SDLOG_OK;
+
+  logErrors = 0u;
+  log_reset();
+  for (i = 0u; (i <= LOG_MAX_RECORDS) && (status == SDLOG_OK); i++)
+  {
+    status = BSP_SDLOG_Append(i, 1u, NULL, 0u);
+  }
+  bad += ((status != SDLOG_FULL) || (i != (LOG_MAX_RECORDS + 1u))) ? 1u : 0u;
+  bad += (BSP_SDLOG_Flush() != SDLOG_OK) ? 1u : 0u;
+  log_mount();
+  bad += (BSP_SDLOG_GetRecordCount() != LOG_MAX_RECORDS) ? 1u : 0u;
+  bad += (BSP_SDLOG_Append(i, 1u, NULL, 0u) != SDLOG_FULL) ? 1u : 0u;
+  host_check_equal("sdlog/full", LOG_MAX_RECORDS, bad + logErrors);
+}
+
+/**
+ * @brief  The same run, cut by a power failure at each of its block
+ *         writes and erases in turn. After the restart the log holds a
+ *         prefix of the records that contains every record written
+ *         before the interrupted write, and none of the blocks written
+ *         after it comes back; appends, restarts and queries go on
+ *         matching the model.
+ */
+static void check_power_cut(host_sd_cut_t mode, const char *name)
+{
+  static uint32_t cut;
+  host_sd_stats_t stats;
+  uint32_t operations, i, count;
+
+  /* Block writes and erases of the run, formatting excluded */
+  log_reset();
+  host_sd_stats(&stats);
+  operations = stats.blocksWritten + stats.erases;
+  host_seed(32u);
+  for (i = 0u; i < LOG_SCRIPT; i++)
+  {
+    log_step();
+  }
+  host_sd_stats(&stats);
+  operations = stats.blocksWritten + stats.erases - operations;
+
+  logErrors = 0u;
+  logBad = 0u;
+  logInterrupted = 0u;
+  for (cut = 0u; cut < operations; cut++)
+  {
+    log_reset();
+    host_seed(32u);
+    host_sd_power_cut(cut, mode);
+    if (setjmp(host_power_fail) == 0)
+    {
+      for (i = 0u; i < LOG_SCRIPT; i++)
+      {
+        log_step();
+      }
+      host_sd_power_on();
+    }
+    else
+    {
+      logInterrupted++;
+      log_mount();
+      count = BSP_SDLOG_GetRecordCount();
+      logBad += ((count < logDurable) || (count > logCount)) ? 1u : 0u;
+      logCount = (count < logCount) ? count : logCount;
+      logBad += (log_queries(10u) != 0u) ? 1u : 0u;
+
+      /* A short write next, so that the next mount replays up to the
+         blocks the interrupted write may have left behind it */
+      log_append();
+      log_flush();
+      log_mount();
+      logBad += (log_queries(10u) != 0u) ? 1u : 0u;
+    }
+
+    for (i = 0u; i < LOG_AFTER; i++)
+    {
+      log_step();
+    }
+    log_flush();
+    log_mount();
+    logBad += (log_queries(10u) != 0u) ? 1u : 0u;
+  }
+
+  host_check_equal(name, operations, logBad + logErrors + (operations - logInterrupted));
+}
+
+void check_sdlog(void)
+{
+  char path[] = "/tmp/bsp_check_sd.XXXXXX";
+  int file = mkstemp(path);
+
+  if ((file < 0) || (close(file) != 0) || (host_sd_open(path, LOG_CARD_BLOCKS) != 0))
+  {
+    host_check_equal("sdlog/card file", 1u, 1u);
+    return;
+  }
+
+  logErrors = 0u;
+  check_out_of_order();
+  check_queries(path);
+  check_transfers();
+  check_full();
+  check_power_cut(HOST_SD_CUT, "sdlog/power cut");
+  check_power_cut(HOST_SD_TORN, "sdlog/power cut torn");
+  check_power_cut(HOST_SD_SKIPPED, "sdlog/power cut skipped");
+
+  host_sd_close();
+  unlink(path);
+}
@@ -210,6 +210,7 @@ void            LCD_IO_WriteData(uint16_t RegValue);
 void            LCD_IO_WriteMultipleData(uint8_t *pData, uint32_t Size);
 void            LCD_IO_WriteReg(uint8_t Reg);
 uint16_t        LCD_IO_ReadData(uint16_t Reg);
+uint32_t        LCD_IO_GetRamAddress(void);
 void            LCD_Delay (uint32_t delay);
 #endif /*HAL_SRAM_MODULE_ENABLED*/
 
@@ -1068,6 +1069,16 @@ uint16_t LCD_IO_ReadData(uint16_t Reg)
   return (FSMC_BANK4_ReadData());
 }
 
+/**
+  * @brief  Gets the address of the LCD RAM write register.
+  * @note   Used as fixed destination address by DMA memory to FSMC transfers.
+  * @retval LCD RAM write register address
+  */
+uint32_t LCD_IO_GetRamAddress(void)
+{
+  return (uint32_t)&(TFT_LCD->LCD_RAM_W);
+}
+
 /**
   * @brief  Wait for loop in ms.
   * @param  Delay in ms.
@@ -1138,6 +1149,8 @@ uint8_t EEPROM_SPI_IO_ReadByte(void)
 
 /**
   * @brief  Write data to SPI EEPROM driver
+  * @note   The function returns as soon as the write cycle is started. Use
+  *         EEPROM_SPI_IO_WaitEepromStandbyState() before the next access.
   * @param  MemAddress: Internal memory address
   * @param  pBuffer: Pointer to data buffer
   * @param  BufferSize: Amount of data to be read
@@ -1173,19 +1186,8 @@ HAL_StatusTypeDef EEPROM_SPI_IO_WriteData(uint16_t MemAddress, uint8_t* pBuffer,
     pBuffer++;
   }
   
-  /*!< Deselect the EEPROM: Chip Select high */
-  EEPROM_CS_HIGH();
-  
-  /*!< Wait the end of EEPROM writing */
-  EEPROM_SPI_IO_WaitEepromStandbyState();
-  
-  /*!< Disable the write access to the EEROM */
-  EEPROM_CS_LOW();
-
-  /*!< Send "Write Disable" instruction */
-  SPIx_Write(EEPROM_CMD_WRDI);
-
-  /*!< Deselect the EEPROM: Chip Select high */
+  /*!< Deselect the EEPROM: Chip Select high: the write cycle starts and
+       the write enable latch is reset by the EEPROM when it completes */
   EEPROM_CS_HIGH();
 
   return HAL_OK;
@@ -29,6 +29,12 @@
   *          @note In this driver, basic read and write functions
   *          (BSP_EEPROM_ReadBuffer() and BSP_EEPROM_WriteBuffer())
   *          use Polling mode to perform the data transfer to/from EEPROM memories.
+  *          A page write returns once the EEPROM has started its internal write
+  *          cycle; the end of the cycle is polled (I2C acknowledge or SPI status
+  *          register) only before the next access to the EEPROM.
+  *          BSP_EEPROM_WriteBufferCached() gathers small updates in a RAM page
+  *          cache, so that several updates of one page cost one page write when
+  *          the page is evicted or BSP_EEPROM_Flush() is called.
   *     +-----------------------------------------------------------------+
   *     |               Pin assignment for M24LR64 EEPROM                 |
   *     +---------------------------------------+-----------+-------------+
@@ -103,6 +109,21 @@
   */ 
 
 
+/** @defgroup STM32L152D_EVAL_EEPROM_Private_Types Private Types
+  * @{
+  */
+/* Page of the write-back cache, a line is in use while DirtyMask is not 0 */
+typedef struct
+{
+  uint16_t  PageAddress;                    /* EEPROM address of the page */
+  uint16_t  DirtyMask;                      /* One bit per written byte of the page */
+  uint32_t  Stamp;                          /* Last update, for LRU eviction */
+  uint8_t   Data[EEPROM_CACHE_PAGE_MAX];
+}EEPROM_CacheLineTypeDef;
+/**
+  * @}
+  */
+
 /** @defgroup STM32L152D_EVAL_EEPROM_Private_Variables Private Variables
   * @{
   */
@@ -112,6 +133,12 @@ __IO uint16_t  EEPROMDataRead = 0;
 __IO uint8_t   EEPROMDataWrite = 0;
 
 static EEPROM_DrvTypeDef *EEPROM_SelectedDevice = 0;
+
+/* A page write cycle may still be running in the EEPROM */
+static uint8_t   EEPROMWritePending = 0;
+
+static EEPROM_CacheLineTypeDef EEPROMCache[EEPROM_CACHE_PAGES];
+static uint32_t  EEPROMCacheStamp = 0;
 /**
   * @}
   */ 
@@ -130,11 +157,16 @@ static uint32_t EEPROM_SPI_ReadBuffer(uint8_t* pBuffer, uint16_t ReadAddr, uint3
 static uint32_t EEPROM_SPI_WritePage(uint8_t* pBuffer, uint16_t WriteAddr, uint32_t* NumByteToWrite);
 static uint32_t EEPROM_SPI_WaitEepromStandbyState(void);
 
+static uint32_t EEPROM_WaitPendingWrite(void);
+static uint32_t EEPROM_CacheFlushLine(EEPROM_CacheLineTypeDef *pLine);
+static void     EEPROM_CacheDiscard(uint16_t Addr, uint32_t NumByte);
+static void     EEPROM_CacheOverlay(uint8_t* pBuffer, uint16_t Addr, uint32_t NumByte);
+
 /**
   * @}
   */ 
   
-/** @defgroup STM32L152D_EVAL_EEPROM_Private_Types Private Types
+/** @addtogroup STM32L152D_EVAL_EEPROM_Private_Types
   * @{
   */
 /* EEPROM I2C driver typedef */
@@ -142,7 +174,8 @@ EEPROM_DrvTypeDef EEPROM_I2C_Drv =
 {
   EEPROM_I2C_Init,
   EEPROM_I2C_ReadBuffer,
-  EEPROM_I2C_WritePage
+  EEPROM_I2C_WritePage,
+  EEPROM_I2C_WaitEepromStandbyState
 };
 
 /* EEPROM SPI driver typedef */
@@ -150,7 +183,8 @@ EEPROM_DrvTypeDef EEPROM_SPI_Drv =
 {
   EEPROM_SPI_Init,
   EEPROM_SPI_ReadBuffer,
-  EEPROM_SPI_WritePage
+  EEPROM_SPI_WritePage,
+  EEPROM_SPI_WaitEepromStandbyState
 };
 /**
   * @}
@@ -185,24 +219,44 @@ uint32_t BSP_EEPROM_Init(void)
   *     @arg BSP_EEPROM_M24M01
   *     @arg BSP_EEPROM_M95M01
   * 
+  * @note   The pages held in the write-back cache belong to the device selected
+  *         so far: they are written to it, and its last write cycle is waited
+  *         for, before the other device is selected. The selection does not
+  *         change when this fails.
+  * 
   * @retval EEPROM_OK (0) if operation is correctly performed, else return value 
   *         different from EEPROM_OK (0)
   */
-void BSP_EEPROM_SelectDevice(uint8_t DeviceID)
+uint32_t BSP_EEPROM_SelectDevice(uint8_t DeviceID)
 {
+  EEPROM_DrvTypeDef *device = EEPROM_SelectedDevice;
+  uint32_t status = EEPROM_OK;
+
   switch(DeviceID)
   {
   case BSP_EEPROM_M24LR64 :
-    EEPROM_SelectedDevice = &EEPROM_I2C_Drv;
+    device = &EEPROM_I2C_Drv;
     break;
     
   case BSP_EEPROM_M95040 :
-    EEPROM_SelectedDevice = &EEPROM_SPI_Drv;
+    device = &EEPROM_SPI_Drv;
     break;
 
   default:
     break;
   }
+
+  if((EEPROM_SelectedDevice != 0) && (device != EEPROM_SelectedDevice))
+  {
+    status = BSP_EEPROM_Flush();
+    if(status != EEPROM_OK)
+    {
+      return status;
+    }
+  }
+  EEPROM_SelectedDevice = device;
+
+  return EEPROM_OK;
 }
 
 /**
@@ -216,15 +270,26 @@ void BSP_EEPROM_SelectDevice(uint8_t DeviceID)
   *        @note The variable pointed by NumByteToRead is reset to 0 when all the 
   *              data are read from the EEPROM. Application should monitor this 
   *              variable in order know when the transfer is complete.
+  *
+  *        @note Data still held in the write-back cache is returned in place
+  *              of the EEPROM content.
   * 
   * @retval EEPROM_OK (0) if operation is correctly performed, else return value 
   *         different from EEPROM_OK (0) or the timeout user callback.
   */
 uint32_t BSP_EEPROM_ReadBuffer(uint8_t* pBuffer, uint16_t ReadAddr, uint32_t* NumByteToRead)
 {
+  uint32_t numbyte = *NumByteToRead;
+  uint32_t status = EEPROM_OK;
+
   if(EEPROM_SelectedDevice->ReadBuffer != 0)
   {
-    return (EEPROM_SelectedDevice->ReadBuffer(pBuffer, ReadAddr, NumByteToRead));
+    status = EEPROM_SelectedDevice->ReadBuffer(pBuffer, ReadAddr, NumByteToRead);
+    if(status == EEPROM_OK)
+    {
+      EEPROM_CacheOverlay(pBuffer, ReadAddr, numbyte);
+    }
+    return status;
   }
   else
   {
@@ -238,6 +303,7 @@ uint32_t BSP_EEPROM_ReadBuffer(uint8_t* pBuffer, uint16_t ReadAddr, uint32_t* Nu
   *         to the EEPROM.
   * @param  WriteAddr : EEPROM's internal address to write to.
   * @param  NumByteToWrite : number of bytes to write to the EEPROM.
+  * @note   Cached bytes of the written range are dropped: the new data wins.
   * @retval EEPROM_OK (0) if operation is correctly performed, else return value 
   *         different from EEPROM_OK (0) or the timeout user callback.
   */
@@ -257,6 +323,8 @@ uint32_t BSP_EEPROM_WriteBuffer(uint8_t* pBuffer, uint16_t WriteAddr, uint32_t N
   {
     return EEPROM_FAIL;
   }
+
+  EEPROM_CacheDiscard(WriteAddr, NumByteToWrite);
   
   /*!< If WriteAddr is EEPROM_PAGESIZE aligned  */
   if(addr == 0) 
@@ -390,6 +458,98 @@ uint32_t BSP_EEPROM_WriteBuffer(uint8_t* pBuffer, uint16_t WriteAddr, uint32_t N
   return EEPROM_OK;
 }
 
+/**
+  * @brief  Writes buffer of data to the EEPROM device selected through the
+  *         write-back page cache.
+  * @note   The data reaches the EEPROM when its page is evicted from the cache
+  *         or when BSP_EEPROM_Flush() is called. Only the bytes written are
+  *         programmed, so no page read is needed.
+  * @param  pBuffer : pointer to the buffer  containing the data to be written 
+  *         to the EEPROM.
+  * @param  WriteAddr : EEPROM's internal address to write to.
+  * @param  NumByteToWrite : number of bytes to write to the EEPROM.
+  * @retval EEPROM_OK (0) if operation is correctly performed, else return value 
+  *         different from EEPROM_OK (0) or the timeout user callback.
+  */
+uint32_t BSP_EEPROM_WriteBufferCached(uint8_t* pBuffer, uint16_t WriteAddr, uint32_t NumByteToWrite)
+{
+  EEPROM_CacheLineTypeDef *line = 0;
+  uint32_t index = 0, offset = 0;
+  uint16_t page = 0;
+  uint32_t status = EEPROM_OK;
+
+  if((EEPROMPageSize == 0) || (EEPROMPageSize > EEPROM_CACHE_PAGE_MAX))
+  {
+    return BSP_EEPROM_WriteBuffer(pBuffer, WriteAddr, NumByteToWrite);
+  }
+
+  while(NumByteToWrite != 0)
+  {
+    page = WriteAddr - (WriteAddr % EEPROMPageSize);
+
+    /* Look for the page, else take a free line or the least recently used one */
+    line = 0;
+    for(index = 0; index < EEPROM_CACHE_PAGES; index++)
+    {
+      if((EEPROMCache[index].DirtyMask != 0) && (EEPROMCache[index].PageAddress == page))
+      {
+        line = &EEPROMCache[index];
+        break;
+      }
+      if((line == 0) || ((line->DirtyMask != 0) &&
+         ((EEPROMCache[index].DirtyMask == 0) || (EEPROMCache[index].Stamp < line->Stamp))))
+      {
+        line = &EEPROMCache[index];
+      }
+    }
+
+    if(line->PageAddress != page)
+    {
+      status = EEPROM_CacheFlushLine(line);
+      if(status != EEPROM_OK)
+      {
+        return status;
+      }
+      line->PageAddress = page;
+    }
+
+    /* Merge the bytes falling in this page */
+    for(offset = WriteAddr - page; (offset < EEPROMPageSize) && (NumByteToWrite != 0); offset++)
+    {
+      line->Data[offset] = *pBuffer++;
+      line->DirtyMask |= (uint16_t)(1U << offset);
+      WriteAddr++;
+      NumByteToWrite--;
+    }
+    line->Stamp = ++EEPROMCacheStamp;
+  }
+
+  return EEPROM_OK;
+}
+
+/**
+  * @brief  Writes every page held in the write-back cache to the EEPROM and
+  *         waits for the end of the last write cycle.
+  * @retval EEPROM_OK (0) if operation is correctly performed, else return value 
+  *         different from EEPROM_OK (0) or the timeout user callback.
+  */
+uint32_t BSP_EEPROM_Flush(void)
+{
+  uint32_t index = 0;
+  uint32_t status = EEPROM_OK;
+
+  for(index = 0; index < EEPROM_CACHE_PAGES; index++)
+  {
+    status = EEPROM_CacheFlushLine(&EEPROMCache[index]);
+    if(status != EEPROM_OK)
+    {
+      return status;
+    }
+  }
+
+  return EEPROM_WaitPendingWrite();
+}
+
 /**
   * @brief  Basic management of the timeout situation.
   * @retval None.
@@ -449,6 +609,12 @@ static uint32_t EEPROM_I2C_ReadBuffer(uint8_t* pBuffer, uint16_t ReadAddr, uint3
 {  
   uint32_t buffersize = *NumByteToRead;
   
+  /* Wait for the end of the previous write cycle */
+  if (EEPROM_WaitPendingWrite() != EEPROM_OK)
+  {
+    return EEPROM_FAIL;
+  }
+
   if (EEPROM_I2C_IO_ReadData(EEPROMAddress, ReadAddr, pBuffer, buffersize) != HAL_OK)
   {
     return EEPROM_FAIL;
@@ -486,17 +652,20 @@ static uint32_t EEPROM_I2C_WritePage(uint8_t* pBuffer, uint16_t WriteAddr, uint3
 { 
   uint32_t buffersize = *NumByteToWrite;
 
-  if (EEPROM_I2C_IO_WriteData(EEPROMAddress, WriteAddr, pBuffer, buffersize) != HAL_OK)
+  /* Wait for the end of the previous write cycle */
+  if (EEPROM_WaitPendingWrite() != EEPROM_OK)
   {
     return EEPROM_FAIL;
   }
-  
-  /* Wait for EEPROM Standby state */
-  if (EEPROM_I2C_WaitEepromStandbyState() != EEPROM_OK) 
+
+  if (EEPROM_I2C_IO_WriteData(EEPROMAddress, WriteAddr, pBuffer, buffersize) != HAL_OK)
   {
     return EEPROM_FAIL;
   }
   
+  /* The EEPROM now runs its write cycle: it is polled before the next access */
+  EEPROMWritePending = 1;
+  
   return EEPROM_OK;
 }
 
@@ -522,6 +691,7 @@ static uint32_t EEPROM_I2C_WaitEepromStandbyState(void)
     BSP_EEPROM_TIMEOUT_UserCallback();
     return EEPROM_TIMEOUT;
   }
+  EEPROMWritePending = 0;
   return EEPROM_OK;
 }
 
@@ -561,14 +731,15 @@ static uint32_t EEPROM_SPI_Init(void)
 static uint32_t EEPROM_SPI_ReadBuffer(uint8_t* pBuffer, uint16_t ReadAddr, uint32_t* NumByteToRead)
 {
   uint32_t buffersize = *NumByteToRead;
-  EEPROM_SPI_IO_ReadData(ReadAddr, pBuffer, buffersize);
-  
-    /* Wait for EEPROM Standby state */
-  if (EEPROM_SPI_WaitEepromStandbyState() != EEPROM_OK) 
+
+  /* Wait for the end of the previous write cycle */
+  if (EEPROM_WaitPendingWrite() != EEPROM_OK)
   {
     return EEPROM_FAIL;
   }
 
+  EEPROM_SPI_IO_ReadData(ReadAddr, pBuffer, buffersize);
+
   return EEPROM_OK;
 }
 
@@ -600,16 +771,19 @@ static uint32_t EEPROM_SPI_WritePage(uint8_t* pBuffer, uint16_t WriteAddr, uint3
 {
   uint32_t buffersize = *NumByteToWrite;
 
-  if (EEPROM_SPI_IO_WriteData(WriteAddr, pBuffer, buffersize) !=  HAL_OK)
+  /* Wait for the end of the previous write cycle */
+  if (EEPROM_WaitPendingWrite() != EEPROM_OK)
   {
     return EEPROM_FAIL;
   }
-  
-  /* Wait for EEPROM Standby state */
-  if (EEPROM_SPI_WaitEepromStandbyState() != EEPROM_OK) 
+
+  if (EEPROM_SPI_IO_WriteData(WriteAddr, pBuffer, buffersize) !=  HAL_OK)
   {
     return EEPROM_FAIL;
   }
+  
+  /* The EEPROM now runs its write cycle: it is polled before the next access */
+  EEPROMWritePending = 1;
 
   return EEPROM_OK;
 }
@@ -630,8 +804,106 @@ static uint32_t EEPROM_SPI_WaitEepromStandbyState(void)
     BSP_EEPROM_TIMEOUT_UserCallback();
     return EEPROM_TIMEOUT;
   }
+  EEPROMWritePending = 0;
   return EEPROM_OK;
 }
+
+/**
+  * @brief  Waits for the end of the last page write cycle, if any.
+  * @retval EEPROM_OK (0) if operation is correctly performed, else return value 
+  *         different from EEPROM_OK (0) or the timeout user callback.
+  */
+static uint32_t EEPROM_WaitPendingWrite(void)
+{
+  if(EEPROMWritePending == 0)
+  {
+    return EEPROM_OK;
+  }
+
+  return EEPROM_SelectedDevice->WaitStandby();
+}
+
+/**
+  * @brief  Writes the dirty bytes of a cache line, one page write per run of
+  *         consecutive bytes, then frees the line.
+  * @param  pLine: cache line to flush
+  * @retval EEPROM_OK (0) if operation is correctly performed, else return value 
+  *         different from EEPROM_OK (0) or the timeout user callback.
+  */
+static uint32_t EEPROM_CacheFlushLine(EEPROM_CacheLineTypeDef *pLine)
+{
+  uint32_t start = 0, end = 0, numbyte = 0;
+  uint32_t status = EEPROM_OK;
+
+  while(pLine->DirtyMask != 0)
+  {
+    for(start = 0; (pLine->DirtyMask & (1U << start)) == 0; start++)
+    {
+    }
+    for(end = start; (end < EEPROMPageSize) && ((pLine->DirtyMask & (1U << end)) != 0); end++)
+    {
+    }
+
+    numbyte = end - start;
+    status = EEPROM_SelectedDevice->WritePage(&pLine->Data[start], pLine->PageAddress + start, &numbyte);
+    if(status != EEPROM_OK)
+    {
+      return status;
+    }
+    pLine->DirtyMask &= (uint16_t)~(((1U << end) - 1U) & ~((1U << start) - 1U));
+  }
+
+  return EEPROM_OK;
+}
+
+/**
+  * @brief  Drops the cached bytes of an EEPROM range.
+  * @param  Addr: first EEPROM address of the range
+  * @param  NumByte: range length
+  * @retval None
+  */
+static void EEPROM_CacheDiscard(uint16_t Addr, uint32_t NumByte)
+{
+  uint32_t index = 0, offset = 0, address = 0;
+
+  for(index = 0; index < EEPROM_CACHE_PAGES; index++)
+  {
+    for(offset = 0; (EEPROMCache[index].DirtyMask != 0) && (offset < EEPROMPageSize); offset++)
+    {
+      address = EEPROMCache[index].PageAddress + offset;
+      if((address >= Addr) && (address < (Addr + NumByte)))
+      {
+        EEPROMCache[index].DirtyMask &= (uint16_t)~(1U << offset);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Copies the cached bytes of an EEPROM range over the data read
+  *         from the EEPROM.
+  * @param  pBuffer: data read from the EEPROM
+  * @param  Addr: EEPROM address of pBuffer[0]
+  * @param  NumByte: number of bytes read
+  * @retval None
+  */
+static void EEPROM_CacheOverlay(uint8_t* pBuffer, uint16_t Addr, uint32_t NumByte)
+{
+  uint32_t index = 0, offset = 0, address = 0;
+
+  for(index = 0; index < EEPROM_CACHE_PAGES; index++)
+  {
+    for(offset = 0; (EEPROMCache[index].DirtyMask != 0) && (offset < EEPROMPageSize); offset++)
+    {
+      address = EEPROMCache[index].PageAddress + offset;
+      if(((EEPROMCache[index].DirtyMask & (1U << offset)) != 0) &&
+         (address >= Addr) && (address < (Addr + NumByte)))
+      {
+        pBuffer[address - Addr] = EEPROMCache[index].Data[offset];
+      }
+    }
+  }
+}
 /**
   * @}
   */
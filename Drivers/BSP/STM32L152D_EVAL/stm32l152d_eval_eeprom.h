@@ -65,6 +65,7 @@ typedef struct
   uint32_t  (*Init)(void);
   uint32_t  (*ReadBuffer)(uint8_t* , uint16_t , uint32_t* );
   uint32_t  (*WritePage)(uint8_t* , uint16_t , uint32_t* );
+  uint32_t  (*WaitStandby)(void);
 }EEPROM_DrvTypeDef;
 /**
   * @}
@@ -91,6 +92,12 @@ typedef struct
 
 /* Maximum number of trials for EEPROM_I2C_WaitEepromStandbyState() function */
 #define EEPROM_MAX_TRIALS               300
+
+/* Write-back page cache used by BSP_EEPROM_WriteBufferCached() */
+#ifndef EEPROM_CACHE_PAGES
+#define EEPROM_CACHE_PAGES              8       /* Number of pages held in RAM */
+#endif /* EEPROM_CACHE_PAGES */
+#define EEPROM_CACHE_PAGE_MAX           16      /* Largest page size of the supported EEPROMs */
 /**
   * @}
   */ 
@@ -100,9 +107,11 @@ typedef struct
   * @{
   */ 
 uint32_t  BSP_EEPROM_Init(void);
-void      BSP_EEPROM_SelectDevice(uint8_t DeviceID);
+uint32_t  BSP_EEPROM_SelectDevice(uint8_t DeviceID);
 uint32_t  BSP_EEPROM_ReadBuffer(uint8_t* pBuffer, uint16_t ReadAddr, uint32_t* NumByteToRead);
 uint32_t  BSP_EEPROM_WriteBuffer(uint8_t* pBuffer, uint16_t WriteAddr, uint32_t NumByteToWrite);
+uint32_t  BSP_EEPROM_WriteBufferCached(uint8_t* pBuffer, uint16_t WriteAddr, uint32_t NumByteToWrite);
+uint32_t  BSP_EEPROM_Flush(void);
 
 /* USER Callbacks: This function is declared as __weak in EEPROM driver and 
    should be implemented into user application.  
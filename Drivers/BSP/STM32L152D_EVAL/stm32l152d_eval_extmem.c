@@ -0,0 +1,325 @@
+/**
+  ******************************************************************************
+  * @file    stm32l152d_eval_extmem.c
+  * @brief   This file provides pool and arena allocators placing large buffers
+  *          in the external SRAM, accessed through the FSMC memory window.
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) Initialize the SRAM with BSP_SRAM_Init(), then the allocator with
+       BSP_EXTMEM_Init(). Once initialized, the SRAM is read and written
+       directly at SRAM_DEVICE_ADDR, with byte, halfword or word accesses.
+   (#) Objects whose address must be known at link time are declared with
+       EXTMEM_SECTION, e.g. "EXTMEM_SECTION static q15_t Samples[4096];". The
+       section is not initialized by the startup code, which runs before the
+       FSMC is configured: such objects are written by the application after
+       BSP_SRAM_Init(). They occupy the start of the SRAM: BSP_EXTMEM_Init()
+       reads the bounds of their section from the linker, and the allocator
+       starts behind them.
+   (#) The rest of the SRAM is carved at start-up with BSP_EXTMEM_Alloc(),
+       BSP_EXTMEM_PoolCreate() and BSP_EXTMEM_ArenaCreate(). Carved memory is
+       never returned: there is no general heap and so no fragmentation.
+   (#) A pool hands out blocks of one size, for instance frames or log
+       records, with BSP_EXTMEM_PoolAlloc() and BSP_EXTMEM_PoolFree(). Both
+       run in constant time and may be called from interrupt handlers.
+   (#) An arena hands out scratch memory of any size for the duration of a
+       transaction with BSP_EXTMEM_ArenaAlloc(). Everything allocated since
+       BSP_EXTMEM_ArenaMark() is dropped at once by BSP_EXTMEM_ArenaRelease(),
+       and everything by BSP_EXTMEM_ArenaReset(). Arenas are not protected
+       against concurrent use.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l152d_eval_extmem.h"
+#include <stddef.h>
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL
+  * @{
+  */
+
+/** @defgroup STM32L152D_EVAL_EXTMEM STM32L152D-EVAL EXTMEM
+  * @{
+  */
+
+/** @defgroup STM32L152D_EVAL_EXTMEM_Private_Macros Private Macros
+  * @{
+  */
+#define EXTMEM_ALIGN(x)          (((x) + EXTMEM_ALIGNMENT - 1U) & ~(uint32_t)(EXTMEM_ALIGNMENT - 1U))
+
+/* Bounds of the objects declared with EXTMEM_SECTION, set by the linker */
+#if defined ( __CC_ARM   )
+extern uint8_t Image$$RW_EXTSRAM$$Base[];
+extern uint8_t Image$$RW_EXTSRAM$$ZI$$Limit[];
+#define EXTMEM_STATIC_START      ((uint32_t)Image$$RW_EXTSRAM$$Base)
+#define EXTMEM_STATIC_END        ((uint32_t)Image$$RW_EXTSRAM$$ZI$$Limit)
+#elif defined ( __ICCARM__ )
+#pragma section = "EXTSRAM_BLOCK"
+#define EXTMEM_STATIC_START      ((uint32_t)__section_begin("EXTSRAM_BLOCK"))
+#define EXTMEM_STATIC_END        ((uint32_t)__section_end("EXTSRAM_BLOCK"))
+#elif defined   (  __GNUC__  )
+extern uint8_t _sextsram[];
+extern uint8_t _eextsram[];
+#define EXTMEM_STATIC_START      ((uint32_t)_sextsram)
+#define EXTMEM_STATIC_END        ((uint32_t)_eextsram)
+#endif
+
+/* Pool critical sections, which may be taken from interrupt handlers */
+#ifndef EXTMEM_ENTER_CRITICAL
+#define EXTMEM_ENTER_CRITICAL(primask)  do { (primask) = __get_PRIMASK(); __disable_irq(); } while(0)
+#define EXTMEM_EXIT_CRITICAL(primask)   __set_PRIMASK(primask)
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_EXTMEM_Private_Variables Private Variables
+  * @{
+  */
+static uint32_t EXTMEMNext = 0;                      /* Next free address of the SRAM */
+static uint32_t EXTMEMEnd = 0;                       /* End of the SRAM, 0 before BSP_EXTMEM_Init() */
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_EXTMEM_Exported_Functions Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Initializes the allocator over the external SRAM, behind the
+  *         objects declared with EXTMEM_SECTION.
+  * @note   The SRAM must have been initialized with BSP_SRAM_Init().
+  * @retval EXTMEM_ERROR when the linker did not place the EXTMEM_SECTION
+  *         objects in the SRAM
+  */
+uint8_t BSP_EXTMEM_Init(void)
+{
+  uint32_t start = EXTMEM_STATIC_START, end = EXTMEM_STATIC_END;
+
+  if((start != SRAM_DEVICE_ADDR) || (end < start) || (end - start > SRAM_DEVICE_SIZE))
+  {
+    return EXTMEM_ERROR;
+  }
+
+  EXTMEMNext = SRAM_DEVICE_ADDR + EXTMEM_ALIGN(end - start);
+  EXTMEMEnd  = SRAM_DEVICE_ADDR + SRAM_DEVICE_SIZE;
+
+  return EXTMEM_OK;
+}
+
+/**
+  * @brief  Carves a buffer out of the SRAM for the life of the application.
+  * @param  Size: buffer size in bytes
+  * @retval Buffer address, NULL when the SRAM is exhausted
+  */
+void *BSP_EXTMEM_Alloc(uint32_t Size)
+{
+  uint32_t address = EXTMEMNext;
+
+  Size = EXTMEM_ALIGN(Size);
+  if((Size == 0) || (Size > EXTMEMEnd - EXTMEMNext))
+  {
+    return NULL;
+  }
+  EXTMEMNext += Size;
+
+  return (void *)address;
+}
+
+/**
+  * @brief  Returns the size of the SRAM not carved yet.
+  * @retval Size in bytes
+  */
+uint32_t BSP_EXTMEM_GetFreeSize(void)
+{
+  return EXTMEMEnd - EXTMEMNext;
+}
+
+/**
+  * @brief  Creates a pool of fixed-size blocks.
+  * @note   The blocks are not touched here: a block enters the free list
+  *         the first time it is released.
+  * @param  pPool: pool handle
+  * @param  BlockSize: block size in bytes
+  * @param  NumOfBlocks: number of blocks
+  * @retval EXTMEM status
+  */
+uint8_t BSP_EXTMEM_PoolCreate(EXTMEM_PoolTypeDef *pPool, uint32_t BlockSize, uint32_t NumOfBlocks)
+{
+  BlockSize = EXTMEM_ALIGN((BlockSize < sizeof(void *)) ? sizeof(void *) : BlockSize);
+  if((NumOfBlocks == 0) || (NumOfBlocks > (EXTMEMEnd - EXTMEMNext) / BlockSize))
+  {
+    return EXTMEM_ERROR;
+  }
+
+  pPool->pBase        = (uint8_t *)BSP_EXTMEM_Alloc(BlockSize * NumOfBlocks);
+  pPool->BlockSize    = BlockSize;
+  pPool->NumOfBlocks  = NumOfBlocks;
+  pPool->pFree        = NULL;
+  pPool->Fresh        = 0;
+  pPool->FreeCount    = NumOfBlocks;
+  pPool->MinFreeCount = NumOfBlocks;
+
+  return EXTMEM_OK;
+}
+
+/**
+  * @brief  Takes a block from a pool.
+  * @param  pPool: pool handle
+  * @retval Block address, NULL when the pool is empty
+  */
+void *BSP_EXTMEM_PoolAlloc(EXTMEM_PoolTypeDef *pPool)
+{
+  void *block = NULL;
+  uint32_t primask = 0;
+
+  EXTMEM_ENTER_CRITICAL(primask);
+  if(pPool->pFree != NULL)
+  {
+    block = pPool->pFree;
+    pPool->pFree = *(void **)block;
+  }
+  else if(pPool->Fresh < pPool->NumOfBlocks)
+  {
+    block = pPool->pBase + (pPool->Fresh * pPool->BlockSize);
+    pPool->Fresh++;
+  }
+  if(block != NULL)
+  {
+    pPool->FreeCount--;
+    if(pPool->FreeCount < pPool->MinFreeCount)
+    {
+      pPool->MinFreeCount = pPool->FreeCount;
+    }
+  }
+  EXTMEM_EXIT_CRITICAL(primask);
+
+  return block;
+}
+
+/**
+  * @brief  Returns a block to its pool.
+  * @param  pPool: pool handle
+  * @param  pBlock: block returned by BSP_EXTMEM_PoolAlloc() on this pool
+  * @retval EXTMEM_ERROR when the address is not a block of the pool
+  */
+uint8_t BSP_EXTMEM_PoolFree(EXTMEM_PoolTypeDef *pPool, void *pBlock)
+{
+  uint32_t offset = (uint32_t)pBlock - (uint32_t)pPool->pBase;
+  uint32_t primask = 0;
+
+  if((offset >= pPool->Fresh * pPool->BlockSize) || ((offset % pPool->BlockSize) != 0))
+  {
+    return EXTMEM_ERROR;
+  }
+
+  EXTMEM_ENTER_CRITICAL(primask);
+  *(void **)pBlock = pPool->pFree;
+  pPool->pFree = pBlock;
+  pPool->FreeCount++;
+  EXTMEM_EXIT_CRITICAL(primask);
+
+  return EXTMEM_OK;
+}
+
+/**
+  * @brief  Creates a bump arena.
+  * @param  pArena: arena handle
+  * @param  Size: arena size in bytes
+  * @retval EXTMEM status
+  */
+uint8_t BSP_EXTMEM_ArenaCreate(EXTMEM_ArenaTypeDef *pArena, uint32_t Size)
+{
+  pArena->pBase = (uint8_t *)BSP_EXTMEM_Alloc(Size);
+  if(pArena->pBase == NULL)
+  {
+    return EXTMEM_ERROR;
+  }
+  pArena->Size = EXTMEM_ALIGN(Size);
+  pArena->Used = 0;
+  pArena->Peak = 0;
+
+  return EXTMEM_OK;
+}
+
+/**
+  * @brief  Allocates scratch memory from an arena.
+  * @param  pArena: arena handle
+  * @param  Size: size in bytes
+  * @retval Buffer address, NULL when the arena is exhausted
+  */
+void *BSP_EXTMEM_ArenaAlloc(EXTMEM_ArenaTypeDef *pArena, uint32_t Size)
+{
+  uint8_t *buffer = pArena->pBase + pArena->Used;
+
+  Size = EXTMEM_ALIGN(Size);
+  if(Size > pArena->Size - pArena->Used)
+  {
+    return NULL;
+  }
+  pArena->Used += Size;
+  if(pArena->Used > pArena->Peak)
+  {
+    pArena->Peak = pArena->Used;
+  }
+
+  return buffer;
+}
+
+/**
+  * @brief  Returns the current position of an arena.
+  * @param  pArena: arena handle
+  * @retval Mark to give to BSP_EXTMEM_ArenaRelease()
+  */
+uint32_t BSP_EXTMEM_ArenaMark(EXTMEM_ArenaTypeDef *pArena)
+{
+  return pArena->Used;
+}
+
+/**
+  * @brief  Frees everything allocated from an arena since a mark.
+  * @param  pArena: arena handle
+  * @param  Mark: value returned by BSP_EXTMEM_ArenaMark()
+  * @retval None
+  */
+void BSP_EXTMEM_ArenaRelease(EXTMEM_ArenaTypeDef *pArena, uint32_t Mark)
+{
+  if(Mark < pArena->Used)
+  {
+    pArena->Used = Mark;
+  }
+}
+
+/**
+  * @brief  Frees everything allocated from an arena.
+  * @param  pArena: arena handle
+  * @retval None
+  */
+void BSP_EXTMEM_ArenaReset(EXTMEM_ArenaTypeDef *pArena)
+{
+  pArena->Used = 0;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,162 @@
+/**
+  ******************************************************************************
+  * @file    stm32l152d_eval_extmem.h
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32l152d_eval_extmem.c driver.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32L152D_EVAL_EXTMEM_H
+#define __STM32L152D_EVAL_EXTMEM_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l152d_eval_sram.h"
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL_EXTMEM
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_EXTMEM_Exported_Constants Exported Constants
+  * @{
+  */
+#define EXTMEM_ALIGNMENT            8         /* Alignment of every returned block */
+
+/* EXTMEM status values */
+#define EXTMEM_OK                   0x00
+#define EXTMEM_ERROR                0x01
+/**
+  * @}
+  */
+
+/* Exported macros -----------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_EXTMEM_Exported_Macros Exported Macros
+  * @{
+  */
+
+/**
+  * @brief  EXTMEM_SECTION definition
+  */
+#if defined ( __CC_ARM   )
+/* ARM Compiler
+   ------------
+   Objects are placed in the "EXTSRAM" section. The scatter file maps it to
+   an UNINIT execution region at SRAM_DEVICE_ADDR, whose limit is read by
+   BSP_EXTMEM_Init():
+     RW_EXTSRAM 0x68000000 UNINIT 0x00200000 { *(EXTSRAM) }
+*/
+#define EXTMEM_SECTION  __attribute__((section("EXTSRAM"), zero_init))
+
+#elif defined ( __ICCARM__ )
+/* ICCARM Compiler
+   ---------------
+   Objects are placed in the "EXTSRAM" section. The linker file places it
+   in the EXTSRAM_BLOCK block at the start of the external SRAM region, and
+   declares it "do not initialize".
+*/
+#define EXTMEM_SECTION  _Pragma("location=\"EXTSRAM\"") __no_init
+
+#elif defined   (  __GNUC__  )
+/* GNU Compiler
+   ------------
+   Objects are placed in the ".extsram" section. The linker script maps it to
+   a NOLOAD output section at the start of the EXTSRAM memory region, bounded
+   by the _sextsram and _eextsram symbols.
+*/
+#define EXTMEM_SECTION  __attribute__((section(".extsram")))
+
+#endif
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_EXTMEM_Exported_Types Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Fixed-size block pool
+  */
+typedef struct
+{
+  uint8_t  *pBase;                     /*!< First block */
+  uint32_t BlockSize;                  /*!< Block size in bytes, rounded up to EXTMEM_ALIGNMENT */
+  uint32_t NumOfBlocks;                /*!< Number of blocks of the pool */
+  void     *pFree;                     /*!< List of released blocks */
+  uint32_t Fresh;                      /*!< Blocks never allocated start at this index */
+  uint32_t FreeCount;                  /*!< Number of free blocks */
+  uint32_t MinFreeCount;               /*!< Lowest FreeCount reached */
+}EXTMEM_PoolTypeDef;
+
+/**
+  * @brief  Bump arena
+  */
+typedef struct
+{
+  uint8_t  *pBase;                     /*!< Arena start */
+  uint32_t Size;                       /*!< Arena size in bytes */
+  uint32_t Used;                       /*!< Bytes allocated */
+  uint32_t Peak;                       /*!< Highest Used reached */
+}EXTMEM_ArenaTypeDef;
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+
+/** @addtogroup STM32L152D_EVAL_EXTMEM_Exported_Functions
+  * @{
+  */
+uint8_t  BSP_EXTMEM_Init(void);
+void    *BSP_EXTMEM_Alloc(uint32_t Size);
+uint32_t BSP_EXTMEM_GetFreeSize(void);
+
+uint8_t  BSP_EXTMEM_PoolCreate(EXTMEM_PoolTypeDef *pPool, uint32_t BlockSize, uint32_t NumOfBlocks);
+void    *BSP_EXTMEM_PoolAlloc(EXTMEM_PoolTypeDef *pPool);
+uint8_t  BSP_EXTMEM_PoolFree(EXTMEM_PoolTypeDef *pPool, void *pBlock);
+
+uint8_t  BSP_EXTMEM_ArenaCreate(EXTMEM_ArenaTypeDef *pArena, uint32_t Size);
+void    *BSP_EXTMEM_ArenaAlloc(EXTMEM_ArenaTypeDef *pArena, uint32_t Size);
+uint32_t BSP_EXTMEM_ArenaMark(EXTMEM_ArenaTypeDef *pArena);
+void     BSP_EXTMEM_ArenaRelease(EXTMEM_ArenaTypeDef *pArena, uint32_t Mark);
+void     BSP_EXTMEM_ArenaReset(EXTMEM_ArenaTypeDef *pArena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32L152D_EVAL_EXTMEM_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
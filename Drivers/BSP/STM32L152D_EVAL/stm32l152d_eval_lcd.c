@@ -27,8 +27,22 @@
             function or a complete string line using the BSP_LCD_DisplayStringAtLine() function.
        (++) Display a string line on the specified position (x,y in pixel) and align mode
             using the BSP_LCD_DisplayStringAtLine() function.          
+       (++) Draw a run-length encoded (optionally palette indexed) image produced by
+            the lcd_image_conv host tool using the BSP_LCD_DrawRLEImage() function.
+       (++) Characters are converted once into pixel runs and kept in a cache of
+            LCD_GLYPH_CACHE_SIZE glyphs, then streamed in a display window.
        (++) Draw and fill a basic shapes (dot, line, rectangle, circle, ellipse, .. bitmap, raw picture) 
             on LCD using a set of functions.    
+
+   (#) DMA transfers (memory to FSMC)
+       (++) Initialize the DMA channel using the BSP_LCD_DMA_Init() function and map
+            LCD_DMAx_IRQHandler() on BSP_LCD_DMA_IRQHandler().
+       (++) Clear the screen, fill a rectangle or paint a picture in background using the
+            BSP_LCD_Clear_DMA(), BSP_LCD_FillRect_DMA(), BSP_LCD_DrawRGBImage_DMA() and
+            BSP_LCD_DrawBitmap_DMA() functions. Fills use a constant DMA source, pictures
+            larger than LCD_DMA_MAX_CHUNK pixels are sent as chained chunks.
+       (++) The end of the transfer is signaled by BSP_LCD_DMA_TransferComplete_CallBack().
+            No other LCD function may be called while BSP_LCD_DMA_IsBusy() returns 1.
   @endverbatim
   ******************************************************************************
   * @attention
@@ -68,6 +82,7 @@
 #include "../../../Utilities/Fonts/font16.c"
 #include "../../../Utilities/Fonts/font12.c"
 #include "../../../Utilities/Fonts/font8.c"
+#include <string.h>
 
 /** @addtogroup BSP
   * @{
@@ -82,6 +97,51 @@
   */ 
 
 
+/** @defgroup STM32L152D_EVAL_LCD_Private_TypesDefinitions Private Types Definitions
+  * @{
+  */
+/**
+  * @brief  LCD DMA transfer descriptor.
+  *         A transfer is made of RowsLeft rows of RowPixels pixels. Each row is
+  *         split into LCD_DMA_MAX_CHUNK requests chained from the DMA interrupt.
+  */
+typedef struct
+{
+  uint32_t      SrcAddress;   /* Source address of the current row                */
+  int32_t       SrcStride;    /* Offset in bytes between two consecutive rows     */
+  uint32_t      RowPixels;    /* Number of pixels per row                         */
+  uint32_t      RowsLeft;     /* Number of rows left, current row included        */
+  uint32_t      Offset;       /* Number of pixels of the current row already sent */
+  __IO uint32_t Busy;         /* Transfer on going                                */
+}LCD_DMA_XferTypeDef;
+
+/**
+  * @brief  Glyph cache entry: runs of alternate background and text pixels.
+  */
+typedef struct
+{
+  sFONT    *pFont;                       /* Font of the glyph, NULL if the entry is free */
+  uint32_t Stamp;                        /* Last use, for LRU eviction                   */
+  uint8_t  Ascii;                        /* Character ascii code                         */
+  uint8_t  Count;                        /* Number of runs                               */
+  uint8_t  Runs[LCD_GLYPH_MAX_RUNS];     /* Run lengths, background run first            */
+}LCD_GlyphTypeDef;
+
+/**
+  * @brief  Polygon edge table entry. Edges are active on [YMin, YMax[ except on
+  *         the last line of the polygon where edges ending there are kept.
+  */
+typedef struct
+{
+  int32_t YMin;     /* First line crossed by the edge                */
+  int32_t YMax;     /* Last line of the edge                         */
+  int32_t X;        /* X position on the current line (16.16 fixed)  */
+  int32_t Slope;    /* X increment per line (16.16 fixed)            */
+}LCD_EdgeTypeDef;
+/**
+  * @}
+  */ 
+
 /** @defgroup STM32L152D_EVAL_LCD_Private_Defines Private Defines
   * @{
   */
@@ -90,7 +150,6 @@
 
 #define MAX_HEIGHT_FONT         17
 #define MAX_WIDTH_FONT          24
-#define OFFSET_BITMAP           54
 /**
   * @}
   */ 
@@ -111,10 +170,24 @@ LCD_DrawPropTypeDef DrawProp;
 
 static LCD_DrvTypeDef  *lcd_drv;
 
-/* Max size of bitmap will based on a font24 (17x24) */
-static uint8_t bitmap[MAX_HEIGHT_FONT*MAX_WIDTH_FONT*2+OFFSET_BITMAP] = {0};
+/* Runs of the glyph being drawn: at most one run per pixel of a font24 (17x24),
+   plus the empty background run of a glyph starting with a text pixel */
+static uint8_t GlyphRuns[(MAX_HEIGHT_FONT*MAX_WIDTH_FONT) + 1] = {0};
+
+static LCD_GlyphTypeDef GlyphCache[LCD_GLYPH_CACHE_SIZE];
+static uint32_t GlyphStamp = 0;
+
+/* Scanline rasterizer edge table and line crossings */
+static LCD_EdgeTypeDef PolyEdges[LCD_POLY_MAX_POINTS];
+static int32_t         PolyCross[LCD_POLY_MAX_POINTS];
 
 static uint32_t LCD_SwapXY = 0;
+
+static DMA_HandleTypeDef   hdma_lcd;
+static LCD_DMA_XferTypeDef LCDDmaXfer;
+
+/* Constant source of the DMA fill operations */
+static uint16_t LCDDmaColor = 0;
 /**
   * @}
   */ 
@@ -123,8 +196,23 @@ static uint32_t LCD_SwapXY = 0;
   * @{
   */ 
 static void LCD_DrawPixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode);
-static void LCD_DrawChar(uint16_t Xpos, uint16_t Ypos, const uint8_t *pChar);
+static void LCD_DrawChar(uint16_t Xpos, uint16_t Ypos, uint8_t Ascii);
+static uint32_t LCD_GlyphToRuns(const uint8_t *pChar, uint16_t Width, uint16_t Height, uint8_t *pRuns, uint32_t MaxRuns);
+static void LCD_DrawGlyphRuns(uint16_t Xpos, uint16_t Ypos, const uint8_t *pRuns, uint32_t Count);
+static void LCD_OpenWriteWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+static void LCD_FillSpan(int32_t Xpos, int32_t Ypos, int32_t Length);
+static void LCD_FillPolygonSpans(pPoint pPoints, uint16_t PointCount);
+static uint8_t LCD_RLEReadPixel(const uint8_t **ppData, const uint8_t *pPalette, uint32_t PaletteSize, uint16_t *pColor);
 static void LCD_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+static void LCD_DMA_Config(uint32_t SrcInc);
+static uint8_t LCD_DMA_Start(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+static void LCD_DMA_NextChunk(void);
+static void LCD_DMA_XferCplt(DMA_HandleTypeDef *hdma);
+static void LCD_DMA_XferError(DMA_HandleTypeDef *hdma);
+
+/* Link functions for LCD peripheral */
+void        LCD_IO_WriteData(uint16_t RegValue);
+uint32_t    LCD_IO_GetRamAddress(void);
 /**
   * @}
   */ 
@@ -309,8 +397,7 @@ void BSP_LCD_ClearStringLine(uint16_t Line)
   */
 void BSP_LCD_DisplayChar(uint16_t Xpos, uint16_t Ypos, uint8_t Ascii)
 {
-  LCD_DrawChar(Ypos, Xpos, &DrawProp.pFont->table[(Ascii-' ') *\
-    DrawProp.pFont->Height * ((DrawProp.pFont->Width + 7) / 8)]);
+  LCD_DrawChar(Xpos, Ypos, Ascii);
 }
 
 /**
@@ -719,6 +806,104 @@ void BSP_LCD_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pBmp)
   LCD_SetDisplayWindow(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
 }
 
+/**
+  * @brief  Draws a run-length encoded image.
+  * @note   The image is decoded on the fly and streamed into a display window,
+  *         no RAM buffer is needed. The image layout is:
+  *           - LCD_RLE_HEADER_SIZE bytes header: magic "RLI1", width and height
+  *             (16-bit little endian), format, palette size (0 means 256)
+  *             and 2 reserved bytes
+  *           - LCD_RLE_FORMAT_INDEXED only: palette of RGB(5-6-5) colors
+  *           - packets of top-down pixels: a control byte N < 0x80 is followed
+  *             by N+1 literal pixels, a control byte N >= 0x80 by one pixel
+  *             repeated N-0x80+1 times. A pixel is a palette index byte or a
+  *             little endian RGB(5-6-5) value.
+  * @note   A packet running past the last pixel of the image or an index past
+  *         the end of the palette stops the drawing with LCD_ERROR: the pixels
+  *         decoded before it are drawn.
+  * @param  Xpos: Image X position in the LCD
+  * @param  Ypos: Image Y position in the LCD
+  * @param  pImage: Pointer to the encoded image
+  * @retval LCD state
+  */
+uint8_t BSP_LCD_DrawRLEImage(uint16_t Xpos, uint16_t Ypos, const uint8_t *pImage)
+{
+  const uint8_t *pdata = NULL, *ppalette = NULL;
+  uint32_t width = 0, height = 0, pixels = 0, count = 0, colors = 0;
+  uint16_t color = 0;
+  uint8_t ctrl = 0, status = LCD_OK;
+
+  if((pImage[0] != 'R') || (pImage[1] != 'L') || (pImage[2] != 'I') || (pImage[3] != '1'))
+  {
+    return LCD_ERROR;
+  }
+
+  width  = pImage[4] | (pImage[5] << 8);
+  height = pImage[6] | (pImage[7] << 8);
+  pdata  = pImage + LCD_RLE_HEADER_SIZE;
+
+  if(pImage[8] == LCD_RLE_FORMAT_INDEXED)
+  {
+    ppalette = pdata;
+    colors = (pImage[9] == 0) ? 256 : pImage[9];
+    pdata += colors * 2;
+  }
+  else if(pImage[8] != LCD_RLE_FORMAT_RGB565)
+  {
+    return LCD_ERROR;
+  }
+
+  if((width == 0) || (height == 0) ||
+     ((Xpos + width) > BSP_LCD_GetXSize()) || ((Ypos + height) > BSP_LCD_GetYSize()))
+  {
+    return LCD_ERROR;
+  }
+
+  LCD_OpenWriteWindow(Xpos, Ypos, width, height);
+
+  pixels = width * height;
+  while((pixels > 0) && (status == LCD_OK))
+  {
+    ctrl  = *pdata++;
+    count = (ctrl & 0x7F) + 1;
+    if(count > pixels)
+    {
+      /* Packet past the end of the image: corrupt or truncated stream */
+      status = LCD_ERROR;
+      break;
+    }
+    pixels -= count;
+
+    if(ctrl & 0x80)
+    {
+      /* Repeated pixel */
+      status = LCD_RLEReadPixel(&pdata, ppalette, colors, &color);
+      while((status == LCD_OK) && (count > 0))
+      {
+        LCD_IO_WriteData(color);
+        count--;
+      }
+    }
+    else
+    {
+      /* Literal pixels */
+      while((status == LCD_OK) && (count > 0))
+      {
+        status = LCD_RLEReadPixel(&pdata, ppalette, colors, &color);
+        if(status == LCD_OK)
+        {
+          LCD_IO_WriteData(color);
+        }
+        count--;
+      }
+    }
+  }
+
+  LCD_SetDisplayWindow(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
+
+  return status;
+}
+
 /**
   * @brief  Draws a full rectangle.
   * @param  Xpos: X position
@@ -746,44 +931,26 @@ void BSP_LCD_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Hei
   */
 void BSP_LCD_FillCircle(uint16_t Xpos, uint16_t Ypos, uint16_t Radius)
 {
-  int32_t  decision;        /* Decision Variable */ 
-  uint32_t  curx;    /* Current X Value */
-  uint32_t  cury;    /* Current Y Value */ 
-  
-  decision = 3 - (Radius << 1);
+  int32_t  curx = Radius;   /* Half width of the current span */
+  int32_t  cury = 0;        /* Distance of the current span to the center */
+  int32_t  limit = (int32_t)Radius * Radius + Radius;
 
-  curx = 0;
-  cury = Radius;
-  
   BSP_LCD_SetTextColor(DrawProp.TextColor);
 
-  while (curx <= cury)
+  /* Each line is drawn once, its half width only decreases from the center */
+  for(cury = 0; cury <= Radius; cury++)
   {
-    if(cury > 0) 
+    while((curx * curx) + (cury * cury) > limit)
     {
-      BSP_LCD_DrawVLine(Xpos + curx, Ypos - cury, 2*cury);
-      BSP_LCD_DrawVLine(Xpos - curx, Ypos - cury, 2*cury);
+      curx--;
     }
 
-    if(curx > 0) 
-    {
-      BSP_LCD_DrawVLine(Xpos - cury, Ypos - curx, 2*curx);
-      BSP_LCD_DrawVLine(Xpos + cury, Ypos - curx, 2*curx);
-    }
-    if (decision < 0)
-    { 
-      decision += (curx << 2) + 6;
-    }
-    else
+    LCD_FillSpan(Xpos - curx, Ypos + cury, (2 * curx) + 1);
+    if(cury > 0)
     {
-      decision += ((curx - cury) << 2) + 10;
-      cury--;
+      LCD_FillSpan(Xpos - curx, Ypos - cury, (2 * curx) + 1);
     }
-    curx++;
   }
-
-  BSP_LCD_SetTextColor(DrawProp.TextColor);
-  BSP_LCD_DrawCircle(Xpos, Ypos, Radius);
 }
 
 /**
@@ -798,137 +965,35 @@ void BSP_LCD_FillCircle(uint16_t Xpos, uint16_t Ypos, uint16_t Radius)
   */
 void BSP_LCD_FillTriangle(uint16_t X1, uint16_t X2, uint16_t X3, uint16_t Y1, uint16_t Y2, uint16_t Y3)
 { 
-  int16_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0, 
-  yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0, 
-  curpixel = 0;
-  
-  deltax = ABS(X2 - X1);        /* The difference between the x's */
-  deltay = ABS(Y2 - Y1);        /* The difference between the y's */
-  x = X1;                       /* Start x off at the first pixel */
-  y = Y1;                       /* Start y off at the first pixel */
-  
-  if (X2 >= X1)                 /* The x-values are increasing */
-  {
-    xinc1 = 1;
-    xinc2 = 1;
-  }
-  else                          /* The x-values are decreasing */
-  {
-    xinc1 = -1;
-    xinc2 = -1;
-  }
-  
-  if (Y2 >= Y1)                 /* The y-values are increasing */
-  {
-    yinc1 = 1;
-    yinc2 = 1;
-  }
-  else                          /* The y-values are decreasing */
-  {
-    yinc1 = -1;
-    yinc2 = -1;
-  }
-  
-  if (deltax >= deltay)         /* There is at least one x-value for every y-value */
-  {
-    xinc1 = 0;                  /* Don't change the x when numerator >= denominator */
-    yinc2 = 0;                  /* Don't change the y for every iteration */
-    den = deltax;
-    num = deltax / 2;
-    numadd = deltay;
-    numpixels = deltax;         /* There are more x-values than y-values */
-  }
-  else                          /* There is at least one y-value for every x-value */
-  {
-    xinc2 = 0;                  /* Don't change the x for every iteration */
-    yinc1 = 0;                  /* Don't change the y when numerator >= denominator */
-    den = deltay;
-    num = deltay / 2;
-    numadd = deltax;
-    numpixels = deltay;         /* There are more y-values than x-values */
-  }
-  
-  for (curpixel = 0; curpixel <= numpixels; curpixel++)
-  {
-    BSP_LCD_DrawLine(x, y, X3, Y3);
-    
-    num += numadd;              /* Increase the numerator by the top of the fraction */
-    if (num >= den)             /* Check if numerator >= denominator */
-    {
-      num -= den;               /* Calculate the new numerator value */
-      x += xinc1;               /* Change the x as appropriate */
-      y += yinc1;               /* Change the y as appropriate */
-    }
-    x += xinc2;                 /* Change the x as appropriate */
-    y += yinc2;                 /* Change the y as appropriate */
-  } 
+  Point points[3];
+
+  points[0].X = X1;
+  points[0].Y = Y1;
+  points[1].X = X2;
+  points[1].Y = Y2;
+  points[2].X = X3;
+  points[2].Y = Y3;
+
+  LCD_FillPolygonSpans(points, 3);
 }
 
 /**
   * @brief  Displays a  full poly-line (between many points).
+  * @note   The polygon is filled with the even-odd rule, concave and
+  *         self-intersecting polygons are supported. Polygons with more than
+  *         LCD_POLY_MAX_POINTS points are not drawn.
   * @param  pPoints: pointer to the points array.
   * @param  PointCount: Number of points.
   * @retval None
   */
 void BSP_LCD_FillPolygon(pPoint pPoints, uint16_t PointCount)
 {
-  
-  int16_t x = 0, y = 0, x2 = 0, y2 = 0, xcenter = 0, ycenter = 0, xfirst = 0, yfirst = 0, pixelx = 0, pixely = 0, counter = 0;
-  uint16_t  imageleft = 0, imageright = 0, imagetop = 0, imagebottom = 0;  
-
-  imageleft = imageright = pPoints->X;
-  imagetop= imagebottom = pPoints->Y;
-
-  for(counter = 1; counter < PointCount; counter++)
-  {
-    pixelx = POLY_X(counter);
-    if(pixelx < imageleft)
-    {
-      imageleft = pixelx;
-    }
-    if(pixelx > imageright)
-    {
-      imageright = pixelx;
-    }
-
-    pixely = POLY_Y(counter);
-    if(pixely < imagetop)
-    { 
-      imagetop = pixely;
-    }
-    if(pixely > imagebottom)
-    {
-      imagebottom = pixely;
-    }
-  }  
-
   if(PointCount < 2)
   {
     return;
   }
 
-  xcenter = (imageleft + imageright)/2;
-  ycenter = (imagebottom + imagetop)/2;
- 
-  xfirst = pPoints->X;
-  yfirst = pPoints->Y;
-
-  while(--PointCount)
-  {
-    x = pPoints->X;
-    y = pPoints->Y;
-    pPoints++;
-    x2 = pPoints->X;
-    y2 = pPoints->Y;    
-  
-    BSP_LCD_FillTriangle(x, x2, xcenter, y, y2, ycenter);
-    BSP_LCD_FillTriangle(x, xcenter, x2, y, ycenter, y2);
-    BSP_LCD_FillTriangle(xcenter, x2, x, ycenter, y2, y);   
-  }
-  
-  BSP_LCD_FillTriangle(xfirst, x2, xcenter, yfirst, y2, ycenter);
-  BSP_LCD_FillTriangle(xfirst, xcenter, x2, yfirst, ycenter, y2);
-  BSP_LCD_FillTriangle(xcenter, x2, xfirst, ycenter, y2, yfirst);   
+  LCD_FillPolygonSpans(pPoints, PointCount);
 }
 
 /**
@@ -941,28 +1006,32 @@ void BSP_LCD_FillPolygon(pPoint pPoints, uint16_t PointCount)
   */
 void BSP_LCD_FillEllipse(int Xpos, int Ypos, int XRadius, int YRadius)
 {
-  int x = 0, y = -XRadius, err = 2-2*YRadius, e2;
-  float k = 0, rad1 = 0, rad2 = 0;
-  
-  rad1 = YRadius;
-  rad2 = XRadius;
-  
-  k = (float)(rad2/rad1);    
-  
-  do 
-  { 
-    BSP_LCD_DrawVLine((Xpos+y), (Ypos-(uint16_t)(x/k)), (2*(uint16_t)(x/k) + 1));
-    BSP_LCD_DrawVLine((Xpos-y), (Ypos-(uint16_t)(x/k)), (2*(uint16_t)(x/k) + 1));
-    
-    e2 = err;
-    if (e2 <= x) 
+  int64_t a2 = 0, b2 = 0, limit = 0;
+  int32_t curx = XRadius, cury = 0;
+
+  if((XRadius < 0) || (YRadius < 0))
+  {
+    return;
+  }
+
+  /* Pixel centers inside the ellipse of radii (XRadius + 1/2, YRadius + 1/2) */
+  a2 = (int64_t)((2 * XRadius) + 1) * ((2 * XRadius) + 1);
+  b2 = (int64_t)((2 * YRadius) + 1) * ((2 * YRadius) + 1);
+  limit = a2 * b2;
+
+  for(cury = 0; cury <= YRadius; cury++)
+  {
+    while((curx > 0) && ((4 * (int64_t)curx * curx * b2) + (4 * (int64_t)cury * cury * a2) > limit))
     {
-      err += ++x*2+1;
-      if (-y == x && e2 <= y) e2 = 0;
+      curx--;
+    }
+
+    LCD_FillSpan(Xpos - curx, Ypos + cury, (2 * curx) + 1);
+    if(cury > 0)
+    {
+      LCD_FillSpan(Xpos - curx, Ypos - cury, (2 * curx) + 1);
     }
-    if (e2 > y) err += ++y*2+1;
   }
-  while (y <= 0);
 }
 
 /**
@@ -983,6 +1052,240 @@ void BSP_LCD_DisplayOff(void)
   lcd_drv->DisplayOff();
 }
 
+/**
+  * @brief  Initializes the DMA channel used for memory to FSMC transfers.
+  * @note   BSP_LCD_Init() must have been called before.
+  * @retval LCD state
+  */
+uint8_t BSP_LCD_DMA_Init(void)
+{
+  if((lcd_drv == NULL) || (lcd_drv->SetCursor == NULL) || (lcd_drv->SetDisplayWindow == NULL))
+  {
+    return LCD_ERROR;
+  }
+
+  /* Enable the DMA clock */
+  LCD_DMAx_CLK_ENABLE();
+
+  /* The LCD RAM register is the fixed destination of a memory to memory transfer */
+  hdma_lcd.Instance                 = LCD_DMAx_CHANNEL;
+  hdma_lcd.Init.Direction           = DMA_MEMORY_TO_MEMORY;
+  hdma_lcd.Init.PeriphInc           = DMA_PINC_ENABLE;
+  hdma_lcd.Init.MemInc              = DMA_MINC_DISABLE;
+  hdma_lcd.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hdma_lcd.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+  hdma_lcd.Init.Mode                = DMA_NORMAL;
+  hdma_lcd.Init.Priority            = DMA_PRIORITY_MEDIUM;
+
+  HAL_DMA_DeInit(&hdma_lcd);
+  LCD_DMA_Config(DMA_PINC_ENABLE);
+
+  LCDDmaXfer.Busy = 0;
+
+  /* DMA IRQ Channel configuration */
+  HAL_NVIC_SetPriority(LCD_DMAx_IRQn, LCD_DMA_IRQ_PREPRIO, 0);
+  HAL_NVIC_EnableIRQ(LCD_DMAx_IRQn);
+
+  return LCD_OK;
+}
+
+/**
+  * @brief  Returns the state of the LCD DMA transfer.
+  * @retval 1 if a transfer is on going, 0 otherwise
+  */
+uint8_t BSP_LCD_DMA_IsBusy(void)
+{
+  return (uint8_t)(LCDDmaXfer.Busy != 0);
+}
+
+/**
+  * @brief  Waits for the end of the on going LCD DMA transfer.
+  * @param  Timeout: Timeout duration in ms
+  * @retval LCD state
+  */
+uint8_t BSP_LCD_DMA_WaitForTransfer(uint32_t Timeout)
+{
+  uint32_t tickstart = HAL_GetTick();
+
+  while(LCDDmaXfer.Busy != 0)
+  {
+    if((HAL_GetTick() - tickstart) > Timeout)
+    {
+      return LCD_TIMEOUT;
+    }
+  }
+
+  return LCD_OK;
+}
+
+/**
+  * @brief  Clears the hole LCD using DMA.
+  * @param  Color: Color of the background
+  * @retval LCD state
+  */
+uint8_t BSP_LCD_Clear_DMA(uint16_t Color)
+{
+  if(LCDDmaXfer.Busy != 0)
+  {
+    return LCD_ERROR;
+  }
+
+  LCDDmaColor = Color;
+
+  LCDDmaXfer.SrcAddress = (uint32_t)&LCDDmaColor;
+  LCDDmaXfer.SrcStride  = 0;
+  LCDDmaXfer.RowPixels  = BSP_LCD_GetXSize() * BSP_LCD_GetYSize();
+  LCDDmaXfer.RowsLeft   = 1;
+  LCD_DMA_Config(DMA_PINC_DISABLE);
+
+  return LCD_DMA_Start(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
+}
+
+/**
+  * @brief  Draws a full rectangle with the text color using DMA.
+  * @param  Xpos: X position
+  * @param  Ypos: Y position
+  * @param  Width: Rectangle width  
+  * @param  Height: Rectangle height
+  * @retval LCD state
+  */
+uint8_t BSP_LCD_FillRect_DMA(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+  if((LCDDmaXfer.Busy != 0) || (Width == 0) || (Height == 0))
+  {
+    return LCD_ERROR;
+  }
+
+  LCDDmaColor = DrawProp.TextColor;
+
+  LCDDmaXfer.SrcAddress = (uint32_t)&LCDDmaColor;
+  LCDDmaXfer.SrcStride  = 0;
+  LCDDmaXfer.RowPixels  = (uint32_t)Width * Height;
+  LCDDmaXfer.RowsLeft   = 1;
+  LCD_DMA_Config(DMA_PINC_DISABLE);
+
+  return LCD_DMA_Start(Xpos, Ypos, Width, Height);
+}
+
+/**
+  * @brief  Draws a RGB(5-6-5) picture stored top-down in memory using DMA.
+  * @param  Xpos: Image X position in the LCD
+  * @param  Ypos: Image Y position in the LCD
+  * @param  Xsize: Image X size in the LCD
+  * @param  Ysize: Image Y size in the LCD
+  * @param  pData: Pointer to the picture pixels (must be half-word aligned)
+  * @retval LCD state
+  */
+uint8_t BSP_LCD_DrawRGBImage_DMA(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint8_t *pData)
+{
+  if((LCDDmaXfer.Busy != 0) || (Xsize == 0) || (Ysize == 0))
+  {
+    return LCD_ERROR;
+  }
+
+  LCDDmaXfer.SrcAddress = (uint32_t)pData;
+  LCDDmaXfer.SrcStride  = 0;
+  LCDDmaXfer.RowPixels  = (uint32_t)Xsize * Ysize;
+  LCDDmaXfer.RowsLeft   = 1;
+  LCD_DMA_Config(DMA_PINC_ENABLE);
+
+  return LCD_DMA_Start(Xpos, Ypos, Xsize, Ysize);
+}
+
+/**
+  * @brief  Draws a 16 bpp bitmap picture loaded in the internal Flash using DMA.
+  * @note   Bitmap lines are stored bottom-up: one chunk chain is issued per line,
+  *         starting with the last one, so that no controller scan direction
+  *         change is needed.
+  * @note   Only uncompressed (BI_RGB or BI_BITFIELDS) 16 bpp bitmaps that fit
+  *         in the panel at the given position are drawn.
+  * @param  Xpos: Bmp X position in the LCD
+  * @param  Ypos: Bmp Y position in the LCD
+  * @param  pBmp: Pointer to Bmp picture address in the internal Flash
+  * @retval LCD state
+  */
+uint8_t BSP_LCD_DrawBitmap_DMA(uint16_t Xpos, uint16_t Ypos, uint8_t *pBmp)
+{
+  uint32_t height = 0, width = 0, index = 0, stride = 0, compression = 0;
+
+  if(LCDDmaXfer.Busy != 0)
+  {
+    return LCD_ERROR;
+  }
+
+  /* Read bitmap width */
+  width = *(uint16_t *) (pBmp + 18);
+  width |= (*(uint16_t *) (pBmp + 20)) << 16;
+
+  /* Read bitmap height */
+  height = *(uint16_t *) (pBmp + 22);
+  height |= (*(uint16_t *) (pBmp + 24)) << 16;
+
+  /* Get bitmap data address offset */
+  index = *(uint16_t *) (pBmp + 10);
+  index |= (*(uint16_t *) (pBmp + 12)) << 16;
+
+  /* Get bitmap compression: BI_RGB (0) or BI_BITFIELDS (3) */
+  compression = *(uint16_t *) (pBmp + 30);
+  compression |= (*(uint16_t *) (pBmp + 32)) << 16;
+
+  /* Pixels are streamed as they are: 16 bpp only */
+  if((*(uint16_t *) (pBmp + 28) != 16) || ((compression != 0) && (compression != 3)))
+  {
+    return LCD_ERROR;
+  }
+
+  /* A top-down bitmap (negative height) or one past the panel is refused */
+  if((width == 0) || (height == 0) ||
+     (width > BSP_LCD_GetXSize()) || (Xpos > (BSP_LCD_GetXSize() - width)) ||
+     (height > BSP_LCD_GetYSize()) || (Ypos > (BSP_LCD_GetYSize() - height)))
+  {
+    return LCD_ERROR;
+  }
+
+  /* Bitmap lines are padded to 4 bytes */
+  stride = ((width * 2) + 3) & ~(uint32_t)3;
+
+  LCDDmaXfer.SrcAddress = (uint32_t)(pBmp + index + ((height - 1) * stride));
+  LCDDmaXfer.SrcStride  = -(int32_t)stride;
+  LCDDmaXfer.RowPixels  = width;
+  LCDDmaXfer.RowsLeft   = height;
+  LCD_DMA_Config(DMA_PINC_ENABLE);
+
+  return LCD_DMA_Start(Xpos, Ypos, width, height);
+}
+
+/**
+  * @brief  Handles LCD DMA interrupt request.
+  * @retval None
+  */
+void BSP_LCD_DMA_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_lcd);
+}
+
+/**
+  * @brief  LCD DMA transfer complete callback.
+  * @note   This function is called from the DMA interrupt once the whole 
+  *         picture or fill has been sent to the LCD.
+  * @retval None
+  */
+__weak void BSP_LCD_DMA_TransferComplete_CallBack(void)
+{
+  /* This function should be implemented by the user application.
+     It is called into this driver when the current DMA transfer is completed. */
+}
+
+/**
+  * @brief  LCD DMA transfer error callback.
+  * @retval None
+  */
+__weak void BSP_LCD_DMA_Error_CallBack(void)
+{
+  /* This function should be implemented by the user application.
+     It is called into this driver when a DMA transfer error occurs. */
+}
+
 /**
   * @}
   */
@@ -1018,72 +1321,142 @@ static void LCD_DrawPixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode)
 
 /**
   * @brief  Draws a character on LCD.
-  * @param  Xpos: Line where to display the character shape
-  * @param  Ypos: Start column address
-  * @param  pChar: Pointer to the character data
+  * @note   The glyph is converted once into runs of background and text
+  *         pixels which are kept in a LRU cache. Runs do not depend on the
+  *         colors, so the same entry serves every text/background pair.
+  * @param  Xpos: Start column address
+  * @param  Ypos: Line where to display the character shape
+  * @param  Ascii: Character ascii code
   * @retval None
   */
-static void LCD_DrawChar(uint16_t Xpos, uint16_t Ypos, const uint8_t *pChar)
+static void LCD_DrawChar(uint16_t Xpos, uint16_t Ypos, uint8_t Ascii)
 {
-  uint32_t counterh = 0, counterw = 0, index = 0;
-  uint16_t height = 0, width = 0;
-  uint8_t offset = 0;
-  uint8_t *pchar = NULL;
-  uint32_t line = 0;
-
- 
-  height = DrawProp.pFont->Height;
-  width  = DrawProp.pFont->Width;
-  
-  /* Fill bitmap header*/
-  *(uint16_t *) (bitmap + 2) = (uint16_t)(height*width*2+OFFSET_BITMAP);
-  *(uint16_t *) (bitmap + 4) = (uint16_t)((height*width*2+OFFSET_BITMAP)>>16);
-  *(uint16_t *) (bitmap + 10) = OFFSET_BITMAP;
-  *(uint16_t *) (bitmap + 18) = (uint16_t)(width);
-  *(uint16_t *) (bitmap + 20) = (uint16_t)((width)>>16);
-  *(uint16_t *) (bitmap + 22) = (uint16_t)(height);
-  *(uint16_t *) (bitmap + 24) = (uint16_t)((height)>>16);
+  LCD_GlyphTypeDef *pglyph = NULL;
+  const uint8_t *pchar = NULL;
+  uint32_t count = 0, index = 0;
+  sFONT *pfont = DrawProp.pFont;
 
-  offset =  8 *((width + 7)/8) -  width ;
+  GlyphStamp++;
 
-  for(counterh = 0; counterh < height; counterh++)
+  /* Look for the glyph and for the least recently used entry */
+  for(index = 0; index < LCD_GLYPH_CACHE_SIZE; index++)
   {
-    pchar = ((uint8_t *)pChar + (width + 7)/8 * counterh);
-    
-    if(((width + 7)/8) == 3)
+    if((GlyphCache[index].pFont == pfont) && (GlyphCache[index].Ascii == Ascii))
     {
-      line =  (pchar[0]<< 16) | (pchar[1]<< 8) | pchar[2];
+      GlyphCache[index].Stamp = GlyphStamp;
+      LCD_DrawGlyphRuns(Xpos, Ypos, GlyphCache[index].Runs, GlyphCache[index].Count);
+      return;
     }
-    
-    if(((width + 7)/8) == 2)
+
+    if((pglyph == NULL) || (GlyphCache[index].Stamp < pglyph->Stamp))
     {
-      line =  (pchar[0]<< 8) | pchar[1];
+      pglyph = &GlyphCache[index];
     }
-    
-    if(((width + 7)/8) == 1)
-    {
-      line =  pchar[0];
-    }    
-    
-    for (counterw = 0; counterw < width; counterw++)
+  }
+
+  pchar = &pfont->table[(Ascii-' ') * pfont->Height * ((pfont->Width + 7) / 8)];
+  count = LCD_GlyphToRuns(pchar, pfont->Width, pfont->Height, GlyphRuns, sizeof(GlyphRuns));
+
+  /* Glyphs with too many runs are drawn from the scratch buffer only */
+  if(count <= LCD_GLYPH_MAX_RUNS)
+  {
+    pglyph->pFont = pfont;
+    pglyph->Ascii = Ascii;
+    pglyph->Count = (uint8_t)count;
+    pglyph->Stamp = GlyphStamp;
+    memcpy(pglyph->Runs, GlyphRuns, count);
+  }
+
+  LCD_DrawGlyphRuns(Xpos, Ypos, GlyphRuns, count);
+}
+
+/**
+  * @brief  Converts a font glyph into runs of alternate background and text
+  *         pixels, in window scan order. The first run is a background one.
+  *         Runs longer than 255 pixels are split by a zero length run.
+  * @param  pChar: Pointer to the character data
+  * @param  Width: Glyph width
+  * @param  Height: Glyph height
+  * @param  pRuns: Pointer to the runs buffer
+  * @param  MaxRuns: Size of the runs buffer
+  * @retval Number of runs
+  */
+static uint32_t LCD_GlyphToRuns(const uint8_t *pChar, uint16_t Width, uint16_t Height, uint8_t *pRuns, uint32_t MaxRuns)
+{
+  uint32_t counterh = 0, counterw = 0, count = 0, run = 0, state = 0, bit = 0;
+  uint32_t bytes = (Width + 7) / 8;
+  const uint8_t *pline = NULL;
+
+  for(counterh = 0; counterh < Height; counterh++)
+  {
+    pline = pChar + (bytes * counterh);
+
+    for(counterw = 0; counterw < Width; counterw++)
     {
-      /* Image in the bitmap is written from the bottom to the top */
-      /* Need to invert image in the bitmap */
-      index = (((height-counterh-1)*width)+(counterw))*2+OFFSET_BITMAP;
-      if(line & (1 << (width- counterw + offset- 1))) 
+      bit = (pline[counterw / 8] >> (7 - (counterw % 8))) & 1;
+
+      if(bit == state)
+      {
+        run++;
+        continue;
+      }
+
+      /* Close the current run; keep the background/text alternation when splitting */
+      while((run > 0xFF) && ((count + 2) < MaxRuns))
       {
-        bitmap[index] = (uint8_t)DrawProp.TextColor;
-        bitmap[index+1] = (uint8_t)(DrawProp.TextColor >> 8);
+        pRuns[count++] = 0xFF;
+        pRuns[count++] = 0;
+        run -= 0xFF;
       }
-      else
+      if(count < MaxRuns)
       {
-        bitmap[index] = (uint8_t)DrawProp.BackColor;
-        bitmap[index+1] = (uint8_t)(DrawProp.BackColor >> 8);
-      } 
+        pRuns[count++] = (uint8_t)run;
+      }
+      state = bit;
+      run = 1;
     }
   }
 
-  BSP_LCD_DrawBitmap(Ypos, Xpos, bitmap);
+  while((run > 0xFF) && ((count + 2) < MaxRuns))
+  {
+    pRuns[count++] = 0xFF;
+    pRuns[count++] = 0;
+    run -= 0xFF;
+  }
+  if(count < MaxRuns)
+  {
+    pRuns[count++] = (uint8_t)run;
+  }
+
+  return count;
+}
+
+/**
+  * @brief  Streams glyph runs in a window of the current font size.
+  * @param  Xpos: Start column address
+  * @param  Ypos: Line where to display the character shape
+  * @param  pRuns: Pointer to the runs
+  * @param  Count: Number of runs
+  * @retval None
+  */
+static void LCD_DrawGlyphRuns(uint16_t Xpos, uint16_t Ypos, const uint8_t *pRuns, uint32_t Count)
+{
+  uint32_t index = 0, counter = 0;
+  uint16_t color = 0;
+
+  LCD_OpenWriteWindow(Xpos, Ypos, DrawProp.pFont->Width, DrawProp.pFont->Height);
+
+  for(index = 0; index < Count; index++)
+  {
+    color = (index & 1) ? (uint16_t)DrawProp.TextColor : (uint16_t)DrawProp.BackColor;
+
+    for(counter = pRuns[index]; counter > 0; counter--)
+    {
+      LCD_IO_WriteData(color);
+    }
+  }
+
+  LCD_SetDisplayWindow(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
 }
 
 /**
@@ -1102,6 +1475,314 @@ static void LCD_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, u
   }  
 }
 
+/**
+  * @brief  Opens a display window and prepares the controller to receive its
+  *         pixels as a single GRAM write stream (the controller wraps inside
+  *         the window).
+  * @param  Xpos: Window X position
+  * @param  Ypos: Window Y position
+  * @param  Width: Window width
+  * @param  Height: Window height
+  * @retval None
+  */
+static void LCD_OpenWriteWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+  if (LCD_SwapXY)
+  {
+    uint16_t tmp = Ypos;
+    Ypos = Xpos;
+    Xpos =  tmp;
+  }
+
+  LCD_SetDisplayWindow(Ypos, Xpos, Width, Height);
+  lcd_drv->SetCursor(Ypos, Xpos);
+  LCD_IO_WriteReg(LCD_REG_34);
+}
+
+/**
+  * @brief  Reads one pixel of a run-length encoded image.
+  * @param  ppData: Pointer to the stream pointer, advanced past the pixel
+  * @param  pPalette: Pointer to the palette, NULL for RGB(5-6-5) pixels
+  * @param  PaletteSize: Number of colors of the palette
+  * @param  pColor: Pointer to the RGB pixel color
+  * @retval LCD_ERROR for an index past the end of the palette, LCD_OK otherwise
+  */
+static uint8_t LCD_RLEReadPixel(const uint8_t **ppData, const uint8_t *pPalette, uint32_t PaletteSize, uint16_t *pColor)
+{
+  const uint8_t *pdata = *ppData;
+
+  if(pPalette != NULL)
+  {
+    if(pdata[0] >= PaletteSize)
+    {
+      return LCD_ERROR;
+    }
+    *pColor = pPalette[pdata[0] * 2] | (pPalette[(pdata[0] * 2) + 1] << 8);
+    *ppData = pdata + 1;
+  }
+  else
+  {
+    *pColor = pdata[0] | (pdata[1] << 8);
+    *ppData = pdata + 2;
+  }
+
+  return LCD_OK;
+}
+
+/**
+  * @brief  Draws an horizontal span with the text color, clipped to the screen.
+  * @param  Xpos: Span start X position
+  * @param  Ypos: Span Y position
+  * @param  Length: Span length
+  * @retval None
+  */
+static void LCD_FillSpan(int32_t Xpos, int32_t Ypos, int32_t Length)
+{
+  int32_t xsize = (int32_t)BSP_LCD_GetXSize();
+
+  if((Ypos < 0) || (Ypos >= (int32_t)BSP_LCD_GetYSize()))
+  {
+    return;
+  }
+
+  if(Xpos < 0)
+  {
+    Length += Xpos;
+    Xpos = 0;
+  }
+
+  if((Xpos + Length) > xsize)
+  {
+    Length = xsize - Xpos;
+  }
+
+  if(Length > 0)
+  {
+    BSP_LCD_DrawHLine((uint16_t)Xpos, (uint16_t)Ypos, (uint16_t)Length);
+  }
+}
+
+/**
+  * @brief  Fills a polygon with horizontal spans using an edge table.
+  * @param  pPoints: Pointer to the points array
+  * @param  PointCount: Number of points
+  * @retval None
+  */
+static void LCD_FillPolygonSpans(pPoint pPoints, uint16_t PointCount)
+{
+  LCD_EdgeTypeDef edge;
+  int32_t x0 = 0, y0 = 0, x1 = 0, y1 = 0, tmp = 0;
+  int32_t ymin = 0, ymax = 0, xmin = 0, xmax = 0, line = 0;
+  uint32_t count = 0, next = 0, active = 0, cross = 0, index = 0, pos = 0;
+
+  if((PointCount == 0) || (PointCount > LCD_POLY_MAX_POINTS))
+  {
+    return;
+  }
+
+  ymin = ymax = POLY_Y(0);
+  xmin = xmax = POLY_X(0);
+
+  /* Build the edge table, horizontal edges are covered by their neighbours */
+  for(index = 0; index < PointCount; index++)
+  {
+    x0 = POLY_X(index);
+    y0 = POLY_Y(index);
+    x1 = POLY_X((index + 1) % PointCount);
+    y1 = POLY_Y((index + 1) % PointCount);
+
+    if(y0 < ymin) ymin = y0;
+    if(y0 > ymax) ymax = y0;
+    if(x0 < xmin) xmin = x0;
+    if(x0 > xmax) xmax = x0;
+
+    if(y0 == y1)
+    {
+      continue;
+    }
+
+    if(y0 > y1)
+    {
+      tmp = x0; x0 = x1; x1 = tmp;
+      tmp = y0; y0 = y1; y1 = tmp;
+    }
+
+    edge.YMin  = y0;
+    edge.YMax  = y1;
+    edge.X     = (x0 << 16) + 0x8000;
+    edge.Slope = ((x1 - x0) << 16) / (y1 - y0);
+
+    /* Insertion sort on the first line */
+    pos = count++;
+    while((pos > 0) && (PolyEdges[pos - 1].YMin > edge.YMin))
+    {
+      PolyEdges[pos] = PolyEdges[pos - 1];
+      pos--;
+    }
+    PolyEdges[pos] = edge;
+  }
+
+  /* Flat polygon */
+  if(count == 0)
+  {
+    LCD_FillSpan(xmin, ymin, xmax - xmin + 1);
+    return;
+  }
+
+  /* Active edges are kept in PolyEdges[next - active .. next[ */
+  for(line = ymin; line <= ymax; line++)
+  {
+    while((next < count) && (PolyEdges[next].YMin <= line))
+    {
+      next++;
+      active++;
+    }
+
+    cross = 0;
+    for(index = next - active; index < next; index++)
+    {
+      if((line < PolyEdges[index].YMax) || (line == ymax))
+      {
+        tmp = PolyEdges[index].X >> 16;
+
+        pos = cross++;
+        while((pos > 0) && (PolyCross[pos - 1] > tmp))
+        {
+          PolyCross[pos] = PolyCross[pos - 1];
+          pos--;
+        }
+        PolyCross[pos] = tmp;
+      }
+
+      PolyEdges[index].X += PolyEdges[index].Slope;
+    }
+
+    /* Even-odd rule */
+    for(index = 0; (index + 1) < cross; index += 2)
+    {
+      LCD_FillSpan(PolyCross[index], line, PolyCross[index + 1] - PolyCross[index] + 1);
+    }
+
+    /* Retire the edges ending on this line, keeping the active range contiguous */
+    for(index = next - active; index < next; index++)
+    {
+      if(PolyEdges[index].YMax <= line)
+      {
+        edge = PolyEdges[index];
+        for(pos = index; pos > (next - active); pos--)
+        {
+          PolyEdges[pos] = PolyEdges[pos - 1];
+        }
+        PolyEdges[next - active] = edge;
+        active--;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Configures the LCD DMA source increment mode.
+  * @param  SrcInc: DMA_PINC_DISABLE for a constant source (fill),
+  *                 DMA_PINC_ENABLE for a memory buffer (blit)
+  * @retval None
+  */
+static void LCD_DMA_Config(uint32_t SrcInc)
+{
+  hdma_lcd.Init.PeriphInc = SrcInc;
+  HAL_DMA_Init(&hdma_lcd);
+
+  /* HAL_DMA_Init() resets the callbacks */
+  hdma_lcd.XferCpltCallback  = LCD_DMA_XferCplt;
+  hdma_lcd.XferErrorCallback = LCD_DMA_XferError;
+}
+
+/**
+  * @brief  Opens the LCD window and starts the transfer described by LCDDmaXfer.
+  * @param  Xpos: Window X position
+  * @param  Ypos: Window Y position
+  * @param  Width: Window width
+  * @param  Height: Window height
+  * @retval LCD state
+  */
+static uint8_t LCD_DMA_Start(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+  if(hdma_lcd.Instance == NULL)
+  {
+    return LCD_ERROR;
+  }
+
+  LCD_OpenWriteWindow(Xpos, Ypos, Width, Height);
+
+  LCDDmaXfer.Offset = 0;
+  LCDDmaXfer.Busy   = 1;
+  LCD_DMA_NextChunk();
+
+  return (LCDDmaXfer.Busy != 0) ? LCD_OK : LCD_ERROR;
+}
+
+/**
+  * @brief  Starts the DMA request for the next chunk of the current row.
+  * @retval None
+  */
+static void LCD_DMA_NextChunk(void)
+{
+  uint32_t count = LCDDmaXfer.RowPixels - LCDDmaXfer.Offset;
+  uint32_t src = LCDDmaXfer.SrcAddress;
+
+  if(count > LCD_DMA_MAX_CHUNK)
+  {
+    count = LCD_DMA_MAX_CHUNK;
+  }
+
+  if(hdma_lcd.Init.PeriphInc == DMA_PINC_ENABLE)
+  {
+    src += LCDDmaXfer.Offset * 2;
+  }
+  LCDDmaXfer.Offset += count;
+
+  if(HAL_DMA_Start_IT(&hdma_lcd, src, LCD_IO_GetRamAddress(), count) != HAL_OK)
+  {
+    LCD_DMA_XferError(&hdma_lcd);
+  }
+}
+
+/**
+  * @brief  LCD DMA chunk complete callback: chains the next chunk or row.
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void LCD_DMA_XferCplt(DMA_HandleTypeDef *hdma)
+{
+  if(LCDDmaXfer.Offset >= LCDDmaXfer.RowPixels)
+  {
+    if(--LCDDmaXfer.RowsLeft == 0)
+    {
+      /* Restore the full screen window */
+      LCD_SetDisplayWindow(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
+      LCDDmaXfer.Busy = 0;
+      BSP_LCD_DMA_TransferComplete_CallBack();
+      return;
+    }
+
+    LCDDmaXfer.SrcAddress += LCDDmaXfer.SrcStride;
+    LCDDmaXfer.Offset = 0;
+  }
+
+  LCD_DMA_NextChunk();
+}
+
+/**
+  * @brief  LCD DMA error callback.
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void LCD_DMA_XferError(DMA_HandleTypeDef *hdma)
+{
+  LCD_SetDisplayWindow(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
+  LCDDmaXfer.Busy = 0;
+  BSP_LCD_DMA_Error_CallBack();
+}
+
 /**
   * @}
   */  
@@ -139,6 +139,43 @@ typedef enum
   */ 
 #define LCD_DEFAULT_FONT         Font24
 
+/** 
+  * @brief LCD DMA definitions for memory to FSMC transfers
+  */ 
+#define LCD_DMAx_CLK_ENABLE()    __HAL_RCC_DMA2_CLK_ENABLE()
+#define LCD_DMAx_CHANNEL         DMA2_Channel1
+#define LCD_DMAx_IRQn            DMA2_Channel1_IRQn
+#define LCD_DMAx_IRQHandler      DMA2_Channel1_IRQHandler
+#define LCD_DMA_IRQ_PREPRIO      0x0F
+
+/** 
+  * @brief LCD glyph cache: number of cached characters and maximum number of
+  *        runs per cached character (glyphs needing more runs are not cached)
+  */ 
+#ifndef LCD_GLYPH_CACHE_SIZE
+#define LCD_GLYPH_CACHE_SIZE     16
+#endif
+#ifndef LCD_GLYPH_MAX_RUNS
+#define LCD_GLYPH_MAX_RUNS       96
+#endif
+
+/** 
+  * @brief LCD run-length encoded image format (see BSP_LCD_DrawRLEImage())
+  */ 
+#define LCD_RLE_HEADER_SIZE      12
+#define LCD_RLE_FORMAT_RGB565    0x00   /*!< Pixels are RGB(5-6-5) values         */
+#define LCD_RLE_FORMAT_INDEXED   0x01   /*!< Pixels are indexes in a 256 palette  */
+
+/** 
+  * @brief LCD scanline rasterizer: maximum number of points of a filled polygon
+  */ 
+#ifndef LCD_POLY_MAX_POINTS
+#define LCD_POLY_MAX_POINTS      32
+#endif
+
+/* Maximum number of pixels moved by one DMA request (CNDTR is 16-bit wide) */
+#define LCD_DMA_MAX_CHUNK        ((uint32_t)0xFFFF)
+
 /**
   * @}
   */
@@ -177,6 +214,7 @@ void     BSP_LCD_FillPolygon(pPoint Points, uint16_t PointCount);
 void     BSP_LCD_DrawEllipse(int Xpos, int Ypos, int XRadius, int YRadius);
 void     BSP_LCD_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp);
 void     BSP_LCD_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint8_t *pbmp);
+uint8_t  BSP_LCD_DrawRLEImage(uint16_t Xpos, uint16_t Ypos, const uint8_t *pImage);
 void     BSP_LCD_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
 void     BSP_LCD_FillCircle(uint16_t Xpos, uint16_t Ypos, uint16_t Radius);
 void     BSP_LCD_FillEllipse(int Xpos, int Ypos, int XRadius, int YRadius);
@@ -184,6 +222,17 @@ void     BSP_LCD_FillEllipse(int Xpos, int Ypos, int XRadius, int YRadius);
 void     BSP_LCD_DisplayOff(void);
 void     BSP_LCD_DisplayOn(void);
 
+uint8_t  BSP_LCD_DMA_Init(void);
+uint8_t  BSP_LCD_DMA_IsBusy(void);
+uint8_t  BSP_LCD_DMA_WaitForTransfer(uint32_t Timeout);
+uint8_t  BSP_LCD_Clear_DMA(uint16_t Color);
+uint8_t  BSP_LCD_FillRect_DMA(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+uint8_t  BSP_LCD_DrawRGBImage_DMA(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint8_t *pData);
+uint8_t  BSP_LCD_DrawBitmap_DMA(uint16_t Xpos, uint16_t Ypos, uint8_t *pBmp);
+void     BSP_LCD_DMA_IRQHandler(void);
+void     BSP_LCD_DMA_TransferComplete_CallBack(void);
+void     BSP_LCD_DMA_Error_CallBack(void);
+
 /**
   * @}
   */
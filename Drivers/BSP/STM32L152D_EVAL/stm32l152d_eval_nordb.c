@@ -0,0 +1,778 @@
+/**
+  ******************************************************************************
+  * @file    stm32l152d_eval_nordb.c
+  * @brief   This file provides a card UID database kept in the NOR flash and
+  *          searched in place through the FSMC memory window.
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) Initialize the NOR flash with BSP_NOR_Init(), then mount the database
+       with BSP_NORDB_Init(), giving the block-aligned NOR offset of the two
+       slots it owns (2 x NORDB_SLOT_BLOCKS blocks). An area holding no valid
+       slot is formatted.
+   (#) Check a card with BSP_NORDB_Lookup(). Nothing is copied to RAM: the
+       index and the entries are read directly at NOR_DEVICE_ADDR.
+   (#) Grant, change or revoke a card with BSP_NORDB_Put() and
+       BSP_NORDB_Delete(). Updates are appended to the journal of the active
+       slot; when it is full, BSP_NORDB_Compact() is called to merge it.
+
+                     ##### Storage layout #####
+  ==============================================================================
+  [..]
+   (#) Each slot holds a header, the entries sorted by key, an Eytzinger
+       (breadth-first) copy of the keys and the update journal. A lookup walks
+       the Eytzinger array from its root: the first levels, visited by every
+       search, are packed at the start of the index and the descent needs no
+       bound arithmetic.
+   (#) The journal is only ever programmed, never erased: a record is written,
+       then committed by clearing its last halfword, so that a torn record is
+       ignored. Lookups check the journal, newest record first, before the
+       index.
+   (#) Compaction merges the journal into a new image built in the other slot.
+       Only the blocks the new image needs are erased. The new header is
+       marked valid last, then the old one is marked obsolete; at mount the
+       valid slot with the highest sequence is used.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l152d_eval_nordb.h"
+#include <stddef.h>
+#include <string.h>
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL
+  * @{
+  */
+
+/** @defgroup STM32L152D_EVAL_NORDB STM32L152D-EVAL NORDB
+  * @{
+  */
+
+/** @defgroup STM32L152D_EVAL_NORDB_Private_Types Private Types
+  * @{
+  */
+/* Journal record */
+typedef struct
+{
+  uint32_t KeyHigh;
+  uint32_t KeyLow;
+  uint32_t Access;
+  uint16_t Operation;                   /* NORDB_OP_PUT or NORDB_OP_DELETE */
+  uint16_t Commit;                      /* Cleared once the record is complete */
+}NORDB_RecordTypeDef;
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_NORDB_Private_Defines Private Defines
+  * @{
+  */
+#define NORDB_MAGIC              0x42444955U   /* "UIDB" */
+#define NORDB_STATUS_ERASED      0xFFFFU
+#define NORDB_STATUS_VALID       0x00FFU
+#define NORDB_STATUS_OBSOLETE    0x0000U
+#define NORDB_OP_PUT             0x5AA5U
+#define NORDB_OP_DELETE          0x0FF0U
+#define NORDB_COMMITTED          0x0000U
+#define NORDB_SLOT_SIZE          (NORDB_SLOT_BLOCKS * NORDB_BLOCK_SIZE)
+#define NORDB_HEADER_SIZE        64U           /* Header area, entries start behind it */
+#define NORDB_WRITE_BUFFER       64U           /* Write buffer page, 32 halfwords */
+#define NORDB_ALIGN(x)           (((x) + NORDB_WRITE_BUFFER - 1U) & ~(NORDB_WRITE_BUFFER - 1U))
+#define NORDB_JOURNAL_SIZE       (NORDB_JOURNAL_ENTRIES * sizeof(NORDB_RecordTypeDef))
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_NORDB_Private_Macros Private Macros
+  * @{
+  */
+#define NORDB_SLOT(s)            (NORDBBaseAddress + ((s) * NORDB_SLOT_SIZE))
+#define NORDB_POINTER(offset)    ((const void *)(NOR_DEVICE_ADDR + (offset)))
+#define NORDB_LESS(ah, al, bh, bl)  (((ah) < (bh)) || (((ah) == (bh)) && ((al) < (bl))))
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_NORDB_Private_Variables Private Variables
+  * @{
+  */
+static uint32_t NORDBBaseAddress = 0;                /* NOR offset of slot 0 */
+static uint32_t NORDBSlot = 0;                       /* Active slot */
+static uint32_t NORDBJournalCount = 0;               /* Journal records used, torn ones included */
+static const NORDB_HeaderTypeDef *NORDBHeader = NULL;
+static uint16_t NORDBOrder[NORDB_JOURNAL_ENTRIES];   /* Journal records sorted by key, for compaction */
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_NORDB_Private_Functions Private Functions
+  * @{
+  */
+static void     NORDB_MakeKey(const uint8_t *pUid, uint8_t UidSize, uint32_t *pKeyHigh, uint32_t *pKeyLow);
+static uint32_t NORDB_Crc32(const void *pData, uint32_t Length);
+static uint8_t  NORDB_CheckSlot(uint32_t Slot);
+static uint8_t  NORDB_Program(uint32_t Offset, const void *pData, uint32_t Size);
+static uint8_t  NORDB_Append(uint32_t KeyHigh, uint32_t KeyLow, uint32_t Access, uint16_t Operation);
+static uint32_t NORDB_SortJournal(void);
+static uint8_t  NORDB_Merge(uint32_t Target, uint32_t JournalSize, uint32_t *pCount);
+static uint8_t  NORDB_Build(uint8_t Empty);
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_NORDB_Exported_Functions Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Mounts the database kept in the NOR flash.
+  * @param  BaseAddress: NOR offset of the database area, aligned on a block.
+  *         The area spans 2 x NORDB_SLOT_BLOCKS blocks.
+  * @retval NORDB status
+  */
+uint8_t BSP_NORDB_Init(uint32_t BaseAddress)
+{
+  const NORDB_RecordTypeDef *journal = NULL;
+  const uint32_t *words = NULL;
+  uint8_t valid0 = 0, valid1 = 0;
+
+  if((BaseAddress % NORDB_BLOCK_SIZE) != 0)
+  {
+    return NORDB_ERROR;
+  }
+
+  NORDBBaseAddress = BaseAddress;
+  BSP_NOR_ReturnToReadMode();
+
+  valid0 = NORDB_CheckSlot(0);
+  valid1 = NORDB_CheckSlot(1);
+  if((valid0 == 0) && (valid1 == 0))
+  {
+    NORDBHeader = NULL;
+    return BSP_NORDB_Format();
+  }
+
+  if((valid1 != 0) && ((valid0 == 0) ||
+     (((const NORDB_HeaderTypeDef *)NORDB_POINTER(NORDB_SLOT(1)))->Sequence >
+      ((const NORDB_HeaderTypeDef *)NORDB_POINTER(NORDB_SLOT(0)))->Sequence)))
+  {
+    NORDBSlot = 1;
+  }
+  else
+  {
+    NORDBSlot = 0;
+  }
+  NORDBHeader = (const NORDB_HeaderTypeDef *)NORDB_POINTER(NORDB_SLOT(NORDBSlot));
+
+  /* The journal is used up to its first fully erased record */
+  journal = (const NORDB_RecordTypeDef *)NORDB_POINTER(NORDB_SLOT(NORDBSlot) + NORDBHeader->JournalOffset);
+  for(NORDBJournalCount = 0; NORDBJournalCount < NORDB_JOURNAL_ENTRIES; NORDBJournalCount++)
+  {
+    words = (const uint32_t *)&journal[NORDBJournalCount];
+    if((words[0] & words[1] & words[2] & words[3]) == 0xFFFFFFFFU)
+    {
+      break;
+    }
+  }
+
+  return NORDB_OK;
+}
+
+/**
+  * @brief  Erases the database contents.
+  * @note   The empty database is built in the inactive slot, the active one
+  *         remains valid until it is complete.
+  * @retval NORDB status
+  */
+uint8_t BSP_NORDB_Format(void)
+{
+  return NORDB_Build(1);
+}
+
+/**
+  * @brief  Looks a card up.
+  * @param  pUid: card UID
+  * @param  UidSize: UID size in bytes, at most NORDB_UID_MAX_SIZE
+  * @param  pAccess: receives the access rights of the card, may be NULL
+  * @retval NORDB_OK when the card is found, NORDB_NOT_FOUND otherwise
+  */
+uint8_t BSP_NORDB_Lookup(const uint8_t *pUid, uint8_t UidSize, uint32_t *pAccess)
+{
+  const NORDB_RecordTypeDef *journal = NULL;
+  const NORDB_NodeTypeDef *index = NULL;
+  const NORDB_EntryTypeDef *entries = NULL;
+  uint32_t keyhigh = 0, keylow = 0, count = 0, k = 0, record = 0;
+
+  if((NORDBHeader == NULL) || (UidSize == 0) || (UidSize > NORDB_UID_MAX_SIZE))
+  {
+    return NORDB_NOT_FOUND;
+  }
+  NORDB_MakeKey(pUid, UidSize, &keyhigh, &keylow);
+
+  /* The newest committed journal record of the key overrides the index */
+  journal = (const NORDB_RecordTypeDef *)NORDB_POINTER(NORDB_SLOT(NORDBSlot) + NORDBHeader->JournalOffset);
+  for(record = NORDBJournalCount; record > 0; record--)
+  {
+    if((journal[record - 1].KeyLow == keylow) && (journal[record - 1].KeyHigh == keyhigh) &&
+       (journal[record - 1].Commit == NORDB_COMMITTED))
+    {
+      if(journal[record - 1].Operation != NORDB_OP_PUT)
+      {
+        return NORDB_NOT_FOUND;
+      }
+      if(pAccess != NULL)
+      {
+        *pAccess = journal[record - 1].Access;
+      }
+      return NORDB_OK;
+    }
+  }
+
+  /* Descend the Eytzinger index, going right while the node is lower than the key */
+  count   = NORDBHeader->Count;
+  index   = (const NORDB_NodeTypeDef *)NORDB_POINTER(NORDB_SLOT(NORDBSlot) + NORDBHeader->IndexOffset);
+  entries = (const NORDB_EntryTypeDef *)NORDB_POINTER(NORDB_SLOT(NORDBSlot) + NORDBHeader->EntriesOffset);
+  k = 1;
+  while(k <= count)
+  {
+    k = (2 * k) + (NORDB_LESS(index[k].KeyHigh, index[k].KeyLow, keyhigh, keylow) ? 1 : 0);
+  }
+
+  /* Undo the right turns taken below the last left turn: k is the lower bound */
+  while((k & 1) != 0)
+  {
+    k >>= 1;
+  }
+  k >>= 1;
+
+  if((k == 0) || (index[k].KeyHigh != keyhigh) || (index[k].KeyLow != keylow))
+  {
+    return NORDB_NOT_FOUND;
+  }
+  if(pAccess != NULL)
+  {
+    *pAccess = entries[index[k].Rank].Access;
+  }
+
+  return NORDB_OK;
+}
+
+/**
+  * @brief  Adds a card or changes its access rights.
+  * @param  pUid: card UID
+  * @param  UidSize: UID size in bytes, at most NORDB_UID_MAX_SIZE
+  * @param  Access: access rights of the card
+  * @retval NORDB status
+  */
+uint8_t BSP_NORDB_Put(const uint8_t *pUid, uint8_t UidSize, uint32_t Access)
+{
+  uint32_t keyhigh = 0, keylow = 0, current = 0;
+
+  if((NORDBHeader == NULL) || (UidSize == 0) || (UidSize > NORDB_UID_MAX_SIZE))
+  {
+    return NORDB_ERROR;
+  }
+
+  /* Do not spend a journal record on an unchanged card */
+  if((BSP_NORDB_Lookup(pUid, UidSize, &current) == NORDB_OK) && (current == Access))
+  {
+    return NORDB_OK;
+  }
+
+  NORDB_MakeKey(pUid, UidSize, &keyhigh, &keylow);
+  return NORDB_Append(keyhigh, keylow, Access, NORDB_OP_PUT);
+}
+
+/**
+  * @brief  Removes a card.
+  * @param  pUid: card UID
+  * @param  UidSize: UID size in bytes, at most NORDB_UID_MAX_SIZE
+  * @retval NORDB status
+  */
+uint8_t BSP_NORDB_Delete(const uint8_t *pUid, uint8_t UidSize)
+{
+  uint32_t keyhigh = 0, keylow = 0;
+
+  if((NORDBHeader == NULL) || (UidSize == 0) || (UidSize > NORDB_UID_MAX_SIZE))
+  {
+    return NORDB_ERROR;
+  }
+
+  if(BSP_NORDB_Lookup(pUid, UidSize, NULL) != NORDB_OK)
+  {
+    return NORDB_OK;
+  }
+
+  NORDB_MakeKey(pUid, UidSize, &keyhigh, &keylow);
+  return NORDB_Append(keyhigh, keylow, 0, NORDB_OP_DELETE);
+}
+
+/**
+  * @brief  Merges the journal into a new image in the inactive slot.
+  * @retval NORDB status
+  */
+uint8_t BSP_NORDB_Compact(void)
+{
+  if(NORDBHeader == NULL)
+  {
+    return NORDB_ERROR;
+  }
+
+  return NORDB_Build(0);
+}
+
+/**
+  * @brief  Returns the header of the active slot, read in place.
+  * @retval Header pointer, NULL when no database is mounted
+  */
+const NORDB_HeaderTypeDef *BSP_NORDB_GetHeader(void)
+{
+  return NORDBHeader;
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup STM32L152D_EVAL_NORDB_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Packs a UID into a key: size in the top byte, then the UID bytes.
+  * @param  pUid: card UID
+  * @param  UidSize: UID size in bytes, at most NORDB_UID_MAX_SIZE
+  * @param  pKeyHigh: receives the 4 most significant key bytes
+  * @param  pKeyLow: receives the 4 least significant key bytes
+  * @retval None
+  */
+static void NORDB_MakeKey(const uint8_t *pUid, uint8_t UidSize, uint32_t *pKeyHigh, uint32_t *pKeyLow)
+{
+  uint8_t key[8] = {0};
+
+  key[0] = UidSize;
+  memcpy(&key[1], pUid, UidSize);
+
+  *pKeyHigh = ((uint32_t)key[0] << 24) | ((uint32_t)key[1] << 16) | ((uint32_t)key[2] << 8) | key[3];
+  *pKeyLow  = ((uint32_t)key[4] << 24) | ((uint32_t)key[5] << 16) | ((uint32_t)key[6] << 8) | key[7];
+}
+
+/**
+  * @brief  Computes the CRC-32 (IEEE 802.3) of a buffer.
+  * @param  pData: buffer
+  * @param  Length: buffer length in bytes
+  * @retval CRC value
+  */
+static uint32_t NORDB_Crc32(const void *pData, uint32_t Length)
+{
+  static const uint32_t table[16] =
+  {
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+  };
+  const uint8_t *data = (const uint8_t *)pData;
+  uint32_t crc = 0xFFFFFFFFU;
+
+  while(Length--)
+  {
+    crc ^= *data++;
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+  }
+
+  return ~crc;
+}
+
+/**
+  * @brief  Checks the header of a slot.
+  * @param  Slot: slot number, 0 or 1
+  * @retval 1 when the slot holds a valid database, 0 otherwise
+  */
+static uint8_t NORDB_CheckSlot(uint32_t Slot)
+{
+  const NORDB_HeaderTypeDef *header = (const NORDB_HeaderTypeDef *)NORDB_POINTER(NORDB_SLOT(Slot));
+
+  if((header->Magic != NORDB_MAGIC) || (header->Status != NORDB_STATUS_VALID))
+  {
+    return 0;
+  }
+  if(header->Crc != NORDB_Crc32(&header->Sequence, offsetof(NORDB_HeaderTypeDef, Crc) - offsetof(NORDB_HeaderTypeDef, Sequence)))
+  {
+    return 0;
+  }
+  if((header->JournalOffset > NORDB_SLOT_SIZE - NORDB_JOURNAL_SIZE) ||
+     (header->IndexOffset + ((header->Count + 1) * sizeof(NORDB_NodeTypeDef)) > header->JournalOffset))
+  {
+    return 0;
+  }
+
+  return 1;
+}
+
+/**
+  * @brief  Programs and verifies erased NOR memory.
+  * @note   The data is split along the write buffer pages of the device.
+  * @param  Offset: NOR offset, halfword aligned
+  * @param  pData: data, halfword aligned
+  * @param  Size: size in bytes, even
+  * @retval NORDB status
+  */
+static uint8_t NORDB_Program(uint32_t Offset, const void *pData, uint32_t Size)
+{
+  const uint16_t *data = (const uint16_t *)pData;
+  uint32_t address = NOR_DEVICE_ADDR + Offset;
+  uint32_t halfwords = Size / 2, chunk = 0;
+
+  while(halfwords > 0)
+  {
+    chunk = (NORDB_WRITE_BUFFER - (address % NORDB_WRITE_BUFFER)) / 2;
+    if(chunk > halfwords)
+    {
+      chunk = halfwords;
+    }
+    if(BSP_NOR_ProgramData(address, (uint16_t *)data, chunk) != NOR_STATUS_OK)
+    {
+      BSP_NOR_ReturnToReadMode();
+      return NORDB_ERROR;
+    }
+    address   += chunk * 2;
+    data      += chunk;
+    halfwords -= chunk;
+  }
+
+  if(memcmp(NORDB_POINTER(Offset), pData, Size) != 0)
+  {
+    return NORDB_ERROR;
+  }
+
+  return NORDB_OK;
+}
+
+/**
+  * @brief  Appends a record to the journal, compacting first when it is full.
+  * @param  KeyHigh: key, most significant word
+  * @param  KeyLow: key, least significant word
+  * @param  Access: access rights
+  * @param  Operation: NORDB_OP_PUT or NORDB_OP_DELETE
+  * @retval NORDB status
+  */
+static uint8_t NORDB_Append(uint32_t KeyHigh, uint32_t KeyLow, uint32_t Access, uint16_t Operation)
+{
+  NORDB_RecordTypeDef record;
+  uint32_t offset = 0;
+  uint8_t status = NORDB_OK;
+
+  if(NORDBJournalCount >= NORDB_JOURNAL_ENTRIES)
+  {
+    status = BSP_NORDB_Compact();
+    if(status != NORDB_OK)
+    {
+      return status;
+    }
+  }
+
+  record.KeyHigh   = KeyHigh;
+  record.KeyLow    = KeyLow;
+  record.Access    = Access;
+  record.Operation = Operation;
+  record.Commit    = NORDB_COMMITTED;
+
+  offset = NORDB_SLOT(NORDBSlot) + NORDBHeader->JournalOffset + (NORDBJournalCount * sizeof(NORDB_RecordTypeDef));
+  NORDBJournalCount++;
+
+  /* Write the record, then commit it */
+  if(NORDB_Program(offset, &record, offsetof(NORDB_RecordTypeDef, Commit)) != NORDB_OK)
+  {
+    return NORDB_ERROR;
+  }
+
+  return NORDB_Program(offset + offsetof(NORDB_RecordTypeDef, Commit), &record.Commit, sizeof(record.Commit));
+}
+
+/**
+  * @brief  Sorts the committed journal records by key into NORDBOrder.
+  * @note   The insertion sort is stable: among the records of a key, the
+  *         newest one comes last.
+  * @retval Number of committed records
+  */
+static uint32_t NORDB_SortJournal(void)
+{
+  const NORDB_RecordTypeDef *journal = (const NORDB_RecordTypeDef *)NORDB_POINTER(NORDB_SLOT(NORDBSlot) + NORDBHeader->JournalOffset);
+  uint32_t record = 0, count = 0, position = 0;
+
+  for(record = 0; record < NORDBJournalCount; record++)
+  {
+    if(journal[record].Commit != NORDB_COMMITTED)
+    {
+      continue;
+    }
+    for(position = count; position > 0; position--)
+    {
+      if(!NORDB_LESS(journal[record].KeyHigh, journal[record].KeyLow,
+                     journal[NORDBOrder[position - 1]].KeyHigh, journal[NORDBOrder[position - 1]].KeyLow))
+      {
+        break;
+      }
+      NORDBOrder[position] = NORDBOrder[position - 1];
+    }
+    NORDBOrder[position] = (uint16_t)record;
+    count++;
+  }
+
+  return count;
+}
+
+/**
+  * @brief  Merges the active entries with the sorted journal.
+  * @param  Target: NOR offset the merged entries are programmed to, 0 to
+  *         only count them
+  * @param  JournalSize: number of records sorted in NORDBOrder
+  * @param  pCount: receives the number of merged entries
+  * @retval NORDB status
+  */
+static uint8_t NORDB_Merge(uint32_t Target, uint32_t JournalSize, uint32_t *pCount)
+{
+  const NORDB_EntryTypeDef *entries = (const NORDB_EntryTypeDef *)NORDB_POINTER(NORDB_SLOT(NORDBSlot) + NORDBHeader->EntriesOffset);
+  const NORDB_RecordTypeDef *journal = (const NORDB_RecordTypeDef *)NORDB_POINTER(NORDB_SLOT(NORDBSlot) + NORDBHeader->JournalOffset);
+  const NORDB_RecordTypeDef *record = NULL;
+  NORDB_EntryTypeDef page[NORDB_WRITE_BUFFER / sizeof(NORDB_EntryTypeDef)];
+  const uint32_t pagesize = NORDB_WRITE_BUFFER / sizeof(NORDB_EntryTypeDef);
+  uint32_t entry = 0, next = 0, count = 0, used = 0;
+  uint8_t takeentry = 0, takerecord = 0;
+
+  while((entry < NORDBHeader->Count) || (next < JournalSize))
+  {
+    /* Skip to the newest record of the current journal key */
+    record = NULL;
+    if(next < JournalSize)
+    {
+      while((next + 1 < JournalSize) &&
+            (journal[NORDBOrder[next + 1]].KeyHigh == journal[NORDBOrder[next]].KeyHigh) &&
+            (journal[NORDBOrder[next + 1]].KeyLow == journal[NORDBOrder[next]].KeyLow))
+      {
+        next++;
+      }
+      record = &journal[NORDBOrder[next]];
+    }
+
+    if(record == NULL)
+    {
+      takeentry = 1;
+      takerecord = 0;
+    }
+    else if(entry >= NORDBHeader->Count)
+    {
+      takeentry = 0;
+      takerecord = 1;
+    }
+    else if((entries[entry].KeyHigh == record->KeyHigh) && (entries[entry].KeyLow == record->KeyLow))
+    {
+      /* The record replaces the entry */
+      entry++;
+      takeentry = 0;
+      takerecord = 1;
+    }
+    else
+    {
+      takeentry = NORDB_LESS(entries[entry].KeyHigh, entries[entry].KeyLow, record->KeyHigh, record->KeyLow) ? 1 : 0;
+      takerecord = 1 - takeentry;
+    }
+
+    if(takerecord != 0)
+    {
+      next++;
+      if(record->Operation != NORDB_OP_PUT)
+      {
+        continue;
+      }
+    }
+
+    if(Target != 0)
+    {
+      if(takeentry != 0)
+      {
+        page[used] = entries[entry];
+      }
+      else
+      {
+        page[used].KeyHigh  = record->KeyHigh;
+        page[used].KeyLow   = record->KeyLow;
+        page[used].Access   = record->Access;
+        page[used].Reserved = 0xFFFFFFFFU;
+      }
+      used++;
+      if(used == pagesize)
+      {
+        if(NORDB_Program(Target + ((count + 1 - used) * sizeof(NORDB_EntryTypeDef)), page, sizeof(page)) != NORDB_OK)
+        {
+          return NORDB_ERROR;
+        }
+        used = 0;
+      }
+    }
+    if(takeentry != 0)
+    {
+      entry++;
+    }
+    count++;
+  }
+
+  if((Target != 0) && (used > 0))
+  {
+    if(NORDB_Program(Target + ((count - used) * sizeof(NORDB_EntryTypeDef)), page, used * sizeof(NORDB_EntryTypeDef)) != NORDB_OK)
+    {
+      return NORDB_ERROR;
+    }
+  }
+
+  *pCount = count;
+  return NORDB_OK;
+}
+
+/**
+  * @brief  Builds a new image in the inactive slot and switches to it.
+  * @param  Empty: 1 to build an empty database, 0 to merge the journal
+  * @retval NORDB status
+  */
+static uint8_t NORDB_Build(uint8_t Empty)
+{
+  NORDB_HeaderTypeDef header;
+  NORDB_NodeTypeDef node;
+  const NORDB_EntryTypeDef *entries = NULL;
+  uint32_t target = 0, journalsize = 0, count = 0, size = 0;
+  uint32_t block = 0, rank = 0, k = 0, sequence = 0;
+  uint16_t status = 0;
+
+  target = (NORDBHeader == NULL) ? 0 : (1 - NORDBSlot);
+  sequence = (NORDBHeader == NULL) ? 1 : (NORDBHeader->Sequence + 1);
+
+  /* Count the entries of the new image to lay it out */
+  if(Empty == 0)
+  {
+    journalsize = NORDB_SortJournal();
+    if(NORDB_Merge(0, journalsize, &count) != NORDB_OK)
+    {
+      return NORDB_ERROR;
+    }
+  }
+
+  memset(&header, 0xFF, sizeof(header));
+  header.Magic         = NORDB_MAGIC;
+  header.Status        = NORDB_STATUS_ERASED;
+  header.Sequence      = sequence;
+  header.Count         = count;
+  header.EntriesOffset = NORDB_HEADER_SIZE;
+  header.IndexOffset   = header.EntriesOffset + (count * sizeof(NORDB_EntryTypeDef));
+  header.JournalOffset = NORDB_ALIGN(header.IndexOffset + ((count + 1) * sizeof(NORDB_NodeTypeDef)));
+  header.Crc           = NORDB_Crc32(&header.Sequence, offsetof(NORDB_HeaderTypeDef, Crc) - offsetof(NORDB_HeaderTypeDef, Sequence));
+  size = header.JournalOffset + NORDB_JOURNAL_SIZE;
+  if(size > NORDB_SLOT_SIZE)
+  {
+    return NORDB_FULL;
+  }
+
+  /* Erase only the blocks the new image spans */
+  for(block = 0; block < size; block += NORDB_BLOCK_SIZE)
+  {
+    if(BSP_NOR_Erase_Block(NORDB_SLOT(target) + block) != NOR_STATUS_OK)
+    {
+      BSP_NOR_ReturnToReadMode();
+      return NORDB_ERROR;
+    }
+  }
+  BSP_NOR_ReturnToReadMode();
+
+  if(Empty == 0)
+  {
+    if(NORDB_Merge(NORDB_SLOT(target) + header.EntriesOffset, journalsize, &count) != NORDB_OK)
+    {
+      return NORDB_ERROR;
+    }
+  }
+
+  /* Write the index nodes in key order, walking the implicit tree in order */
+  entries = (const NORDB_EntryTypeDef *)NORDB_POINTER(NORDB_SLOT(target) + header.EntriesOffset);
+  if(count > 0)
+  {
+    k = 1;
+    while((2 * k) <= count)
+    {
+      k = 2 * k;
+    }
+  }
+  for(rank = 0; rank < count; rank++)
+  {
+    node.KeyHigh = entries[rank].KeyHigh;
+    node.KeyLow  = entries[rank].KeyLow;
+    node.Rank    = rank;
+    if(NORDB_Program(NORDB_SLOT(target) + header.IndexOffset + (k * sizeof(NORDB_NodeTypeDef)),
+                     &node, offsetof(NORDB_NodeTypeDef, Reserved)) != NORDB_OK)
+    {
+      return NORDB_ERROR;
+    }
+
+    if(((2 * k) + 1) <= count)
+    {
+      /* Next: leftmost node of the right subtree */
+      k = (2 * k) + 1;
+      while((2 * k) <= count)
+      {
+        k = 2 * k;
+      }
+    }
+    else
+    {
+      /* Next: first ancestor reached from its left subtree */
+      while((k & 1) != 0)
+      {
+        k >>= 1;
+      }
+      k >>= 1;
+    }
+  }
+
+  /* Commit the new image, then retire the previous one */
+  if(NORDB_Program(NORDB_SLOT(target), &header, sizeof(header)) != NORDB_OK)
+  {
+    return NORDB_ERROR;
+  }
+  status = NORDB_STATUS_VALID;
+  if(NORDB_Program(NORDB_SLOT(target) + offsetof(NORDB_HeaderTypeDef, Status), &status, sizeof(status)) != NORDB_OK)
+  {
+    return NORDB_ERROR;
+  }
+  if(NORDBHeader != NULL)
+  {
+    status = NORDB_STATUS_OBSOLETE;
+    NORDB_Program(NORDB_SLOT(NORDBSlot) + offsetof(NORDB_HeaderTypeDef, Status), &status, sizeof(status));
+  }
+
+  NORDBSlot = target;
+  NORDBHeader = (const NORDB_HeaderTypeDef *)NORDB_POINTER(NORDB_SLOT(target));
+  NORDBJournalCount = 0;
+
+  return NORDB_OK;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,139 @@
+/**
+  ******************************************************************************
+  * @file    stm32l152d_eval_nordb.h
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32l152d_eval_nordb.c driver.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32L152D_EVAL_NORDB_H
+#define __STM32L152D_EVAL_NORDB_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l152d_eval_nor.h"
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL_NORDB
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_NORDB_Exported_Constants Exported Constants
+  * @{
+  */
+#define NORDB_BLOCK_SIZE            ((uint32_t)0x20000)  /* M29W128GL/M29W256GL main block size */
+
+#ifndef NORDB_SLOT_BLOCKS
+#define NORDB_SLOT_BLOCKS           2         /* NOR blocks of one database copy */
+#endif /* NORDB_SLOT_BLOCKS */
+
+#ifndef NORDB_JOURNAL_ENTRIES
+#define NORDB_JOURNAL_ENTRIES       128       /* Updates appended before a compaction */
+#endif /* NORDB_JOURNAL_ENTRIES */
+
+#define NORDB_UID_MAX_SIZE          7         /* 4-byte and 7-byte ISO14443A UIDs */
+
+/* NORDB status values */
+#define NORDB_OK                    0x00
+#define NORDB_ERROR                 0x01
+#define NORDB_NOT_FOUND             0x02
+#define NORDB_FULL                  0x03      /* The entries do not fit in a slot */
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_NORDB_Exported_Types Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Database header, at the start of a slot
+  */
+typedef struct
+{
+  uint32_t Magic;
+  uint16_t Status;                     /*!< 0xFFFF written, 0x00FF valid, 0x0000 obsolete */
+  uint16_t Reserved;
+  uint32_t Sequence;                   /*!< The valid slot with the highest sequence is used */
+  uint32_t Count;                      /*!< Number of entries */
+  uint32_t EntriesOffset;              /*!< Sorted entries, from the slot start */
+  uint32_t IndexOffset;                /*!< Eytzinger index, from the slot start */
+  uint32_t JournalOffset;              /*!< Update journal, from the slot start */
+  uint32_t Crc;                        /*!< CRC-32 of the fields above, Status excluded */
+}NORDB_HeaderTypeDef;
+
+/**
+  * @brief  Database entry, sorted by key. The key packs the UID length in its
+  *         top byte followed by the UID bytes, most significant first.
+  */
+typedef struct
+{
+  uint32_t KeyHigh;
+  uint32_t KeyLow;
+  uint32_t Access;                     /*!< Application access rights */
+  uint32_t Reserved;
+}NORDB_EntryTypeDef;
+
+/**
+  * @brief  Eytzinger index node: node k has its children at 2k and 2k+1
+  */
+typedef struct
+{
+  uint32_t KeyHigh;
+  uint32_t KeyLow;
+  uint32_t Rank;                       /*!< Position of the entry in the sorted array */
+  uint32_t Reserved;
+}NORDB_NodeTypeDef;
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+
+/** @addtogroup STM32L152D_EVAL_NORDB_Exported_Functions
+  * @{
+  */
+uint8_t  BSP_NORDB_Init(uint32_t BaseAddress);
+uint8_t  BSP_NORDB_Format(void);
+uint8_t  BSP_NORDB_Lookup(const uint8_t *pUid, uint8_t UidSize, uint32_t *pAccess);
+uint8_t  BSP_NORDB_Put(const uint8_t *pUid, uint8_t UidSize, uint32_t Access);
+uint8_t  BSP_NORDB_Delete(const uint8_t *pUid, uint8_t UidSize);
+uint8_t  BSP_NORDB_Compact(void);
+const NORDB_HeaderTypeDef *BSP_NORDB_GetHeader(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32L152D_EVAL_NORDB_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,455 @@
+/**
+  ******************************************************************************
+  * @file    stm32l152d_eval_sdcache.c
+  * @brief   This file provides a block cache with read-ahead on top of the
+  *          uSD card driver.
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) Initialize the SD card with BSP_SD_Init(), then the cache with
+       BSP_SDCACHE_Init(), choosing the write policy:
+       (++) SDCACHE_WRITE_THROUGH: every write reaches the card at once and
+            refreshes the cached copy.
+       (++) SDCACHE_WRITE_BACK: small writes only update the cache; dirty blocks
+            are written when evicted or when BSP_SDCACHE_Flush() is called.
+   (#) Use BSP_SDCACHE_ReadBlocks() / BSP_SDCACHE_WriteBlocks() in place of
+       BSP_SD_ReadBlocks() / BSP_SD_WriteBlocks(), with the same parameters.
+       Do not mix both APIs on the same blocks without BSP_SDCACHE_Flush()
+       and BSP_SDCACHE_Invalidate().
+   (#) The cache keeps the SDCACHE_BLOCKS least recently used blocks. A miss
+       on the block following the previous read fetches
+       SDCACHE_READAHEAD_BLOCKS blocks with one multi-block DMA read into
+       consecutive cache lines.
+       Requests of SDCACHE_READAHEAD_BLOCKS blocks or more bypass the cache
+       with one DMA transfer, so that bulk transfers do not flush it.
+   (#) BSP_SDCACHE_GetStats() returns the hit, miss, read-ahead and write-back
+       counters.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l152d_eval_sdcache.h"
+#include <string.h>
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL
+  * @{
+  */
+
+/** @defgroup STM32L152D_EVAL_SDCACHE STM32L152D-EVAL SDCACHE
+  * @{
+  */
+
+#if (SDCACHE_READAHEAD_BLOCKS > SDCACHE_BLOCKS)
+#error "SDCACHE_READAHEAD_BLOCKS must not exceed SDCACHE_BLOCKS"
+#endif
+
+/** @defgroup STM32L152D_EVAL_SDCACHE_Private_Types Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t Block;                       /* SD block number */
+  uint32_t Stamp;                       /* Last use, 0 when the line is free */
+  uint32_t Dirty;                       /* Newer than the card */
+}SDCACHE_LineTypeDef;
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_SDCACHE_Private_Variables Private Variables
+  * @{
+  */
+static SDCACHE_LineTypeDef SDCacheLine[SDCACHE_BLOCKS];
+static uint32_t SDCacheData[SDCACHE_BLOCKS][SDCACHE_BLOCK_SIZE / 4];
+static uint32_t SDCachePolicy = SDCACHE_WRITE_THROUGH;
+static uint32_t SDCacheStamp = 0;
+static uint32_t SDCacheNextBlock = 0xFFFFFFFF;   /* Block following the previous read */
+static SDCACHE_StatsTypeDef SDCacheStats;
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_SDCACHE_Private_Macros Private Macros
+  * @{
+  */
+#define SDCACHE_DATA(__CACHELINE__)   (SDCacheData[(__CACHELINE__) - SDCacheLine])
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_SDCACHE_Private_Functions Private Functions
+  * @{
+  */
+static SDCACHE_LineTypeDef *SDCACHE_Find(uint32_t Block);
+static uint8_t SDCACHE_Allocate(uint32_t Block, SDCACHE_LineTypeDef **ppLine);
+static uint8_t SDCACHE_WriteLine(SDCACHE_LineTypeDef *pLine);
+static uint8_t SDCACHE_Fill(uint32_t Block);
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_SDCACHE_Exported_Functions Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Empties the cache and selects its write policy.
+  * @param  Policy: SDCACHE_WRITE_THROUGH or SDCACHE_WRITE_BACK
+  * @retval None
+  */
+void BSP_SDCACHE_Init(uint32_t Policy)
+{
+  BSP_SDCACHE_Invalidate();
+  BSP_SDCACHE_ResetStats();
+  SDCachePolicy = Policy;
+}
+
+/**
+  * @brief  Reads block(s) through the cache.
+  * @param  pData: Pointer to the buffer that will contain the data read
+  * @param  ReadAddr: Address from where data is to be read, a multiple of 512
+  * @param  BlockSize: SD card data block size, that should be 512
+  * @param  NumOfBlocks: Number of SD blocks to read
+  * @retval SD status
+  */
+uint8_t BSP_SDCACHE_ReadBlocks(uint32_t *pData, uint64_t ReadAddr, uint32_t BlockSize, uint32_t NumOfBlocks)
+{
+  SDCACHE_LineTypeDef *line = NULL;
+  uint32_t block = (uint32_t)(ReadAddr / SDCACHE_BLOCK_SIZE);
+  uint32_t index = 0;
+
+  if(BlockSize != SDCACHE_BLOCK_SIZE)
+  {
+    return MSD_ERROR;
+  }
+
+  /* Bulk read: one transfer to the caller buffer, then cached blocks on top
+     as they may be newer than the card */
+  if(NumOfBlocks >= SDCACHE_READAHEAD_BLOCKS)
+  {
+    if(BSP_SD_ReadBlocks_DMA(pData, ReadAddr, BlockSize, NumOfBlocks) != MSD_OK)
+    {
+      return MSD_ERROR;
+    }
+    for(index = 0; index < SDCACHE_BLOCKS; index++)
+    {
+      line = &SDCacheLine[index];
+      if((line->Stamp != 0) && (line->Block >= block) && ((line->Block - block) < NumOfBlocks))
+      {
+        memcpy(&pData[(line->Block - block) * (SDCACHE_BLOCK_SIZE / 4)], SDCACHE_DATA(line), SDCACHE_BLOCK_SIZE);
+      }
+    }
+    SDCacheStats.Misses += NumOfBlocks;
+    SDCacheNextBlock = block + NumOfBlocks;
+    return MSD_OK;
+  }
+
+  for(index = 0; index < NumOfBlocks; index++, block++)
+  {
+    line = SDCACHE_Find(block);
+    if(line != NULL)
+    {
+      SDCacheStats.Hits++;
+    }
+    else
+    {
+      SDCacheStats.Misses++;
+      if(SDCACHE_Fill(block) != MSD_OK)
+      {
+        return MSD_ERROR;
+      }
+      line = SDCACHE_Find(block);
+    }
+
+    line->Stamp = ++SDCacheStamp;
+    memcpy(&pData[index * (SDCACHE_BLOCK_SIZE / 4)], SDCACHE_DATA(line), SDCACHE_BLOCK_SIZE);
+    SDCacheNextBlock = block + 1;
+  }
+
+  return MSD_OK;
+}
+
+/**
+  * @brief  Writes block(s) through the cache.
+  * @param  pData: Pointer to the buffer that will contain the data to transmit
+  * @param  WriteAddr: Address from where data is to be written, a multiple of 512
+  * @param  BlockSize: SD card data block size, that should be 512
+  * @param  NumOfBlocks: Number of SD blocks to write
+  * @retval SD status
+  */
+uint8_t BSP_SDCACHE_WriteBlocks(uint32_t *pData, uint64_t WriteAddr, uint32_t BlockSize, uint32_t NumOfBlocks)
+{
+  SDCACHE_LineTypeDef *line = NULL;
+  uint32_t block = (uint32_t)(WriteAddr / SDCACHE_BLOCK_SIZE);
+  uint32_t index = 0;
+
+  if(BlockSize != SDCACHE_BLOCK_SIZE)
+  {
+    return MSD_ERROR;
+  }
+
+  if((SDCachePolicy == SDCACHE_WRITE_THROUGH) || (NumOfBlocks >= SDCACHE_READAHEAD_BLOCKS))
+  {
+    /* One transfer to the card, then refresh the cached copies */
+    if(BSP_SD_WriteBlocks_DMA(pData, WriteAddr, BlockSize, NumOfBlocks) != MSD_OK)
+    {
+      return MSD_ERROR;
+    }
+    for(index = 0; index < SDCACHE_BLOCKS; index++)
+    {
+      line = &SDCacheLine[index];
+      if((line->Stamp != 0) && (line->Block >= block) && ((line->Block - block) < NumOfBlocks))
+      {
+        memcpy(SDCACHE_DATA(line), &pData[(line->Block - block) * (SDCACHE_BLOCK_SIZE / 4)], SDCACHE_BLOCK_SIZE);
+        line->Dirty = 0;
+      }
+    }
+    return MSD_OK;
+  }
+
+  for(index = 0; index < NumOfBlocks; index++, block++)
+  {
+    line = SDCACHE_Find(block);
+    if((line == NULL) && (SDCACHE_Allocate(block, &line) != MSD_OK))
+    {
+      return MSD_ERROR;
+    }
+    memcpy(SDCACHE_DATA(line), &pData[index * (SDCACHE_BLOCK_SIZE / 4)], SDCACHE_BLOCK_SIZE);
+    line->Dirty = 1;
+    line->Stamp = ++SDCacheStamp;
+  }
+
+  return MSD_OK;
+}
+
+/**
+  * @brief  Writes every dirty block to the card.
+  * @retval SD status
+  */
+uint8_t BSP_SDCACHE_Flush(void)
+{
+  uint32_t index = 0;
+
+  for(index = 0; index < SDCACHE_BLOCKS; index++)
+  {
+    if(SDCACHE_WriteLine(&SDCacheLine[index]) != MSD_OK)
+    {
+      return MSD_ERROR;
+    }
+  }
+
+  return MSD_OK;
+}
+
+/**
+  * @brief  Drops every cached block. Dirty blocks are lost: call
+  *         BSP_SDCACHE_Flush() first to keep them.
+  * @retval None
+  */
+void BSP_SDCACHE_Invalidate(void)
+{
+  memset(SDCacheLine, 0, sizeof(SDCacheLine));
+  SDCacheNextBlock = 0xFFFFFFFF;
+}
+
+/**
+  * @brief  Returns the cache counters.
+  * @param  pStats: receives the counters
+  * @retval None
+  */
+void BSP_SDCACHE_GetStats(SDCACHE_StatsTypeDef *pStats)
+{
+  *pStats = SDCacheStats;
+}
+
+/**
+  * @brief  Clears the cache counters.
+  * @retval None
+  */
+void BSP_SDCACHE_ResetStats(void)
+{
+  memset(&SDCacheStats, 0, sizeof(SDCacheStats));
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup STM32L152D_EVAL_SDCACHE_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Looks a block up in the cache.
+  * @param  Block: SD block number
+  * @retval Cache line holding the block, NULL when it is not cached
+  */
+static SDCACHE_LineTypeDef *SDCACHE_Find(uint32_t Block)
+{
+  uint32_t index = 0;
+
+  for(index = 0; index < SDCACHE_BLOCKS; index++)
+  {
+    if((SDCacheLine[index].Stamp != 0) && (SDCacheLine[index].Block == Block))
+    {
+      return &SDCacheLine[index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  * @brief  Takes a free line or evicts the least recently used one, writing
+  *         it back first when it is dirty.
+  * @param  Block: SD block number the line is given to
+  * @param  ppLine: receives the line
+  * @retval SD status
+  */
+static uint8_t SDCACHE_Allocate(uint32_t Block, SDCACHE_LineTypeDef **ppLine)
+{
+  SDCACHE_LineTypeDef *line = &SDCacheLine[0];
+  uint32_t index = 0;
+
+  for(index = 1; (index < SDCACHE_BLOCKS) && (line->Stamp != 0); index++)
+  {
+    if(SDCacheLine[index].Stamp < line->Stamp)
+    {
+      line = &SDCacheLine[index];
+    }
+  }
+
+  if(SDCACHE_WriteLine(line) != MSD_OK)
+  {
+    return MSD_ERROR;
+  }
+
+  line->Block = Block;
+  line->Stamp = ++SDCacheStamp;
+  line->Dirty = 0;
+  *ppLine = line;
+
+  return MSD_OK;
+}
+
+/**
+  * @brief  Writes a line to the card when it is dirty.
+  * @param  pLine: cache line
+  * @retval SD status
+  */
+static uint8_t SDCACHE_WriteLine(SDCACHE_LineTypeDef *pLine)
+{
+  if((pLine->Stamp == 0) || (pLine->Dirty == 0))
+  {
+    return MSD_OK;
+  }
+
+  if(BSP_SD_WriteBlocks_DMA(SDCACHE_DATA(pLine), (uint64_t)pLine->Block * SDCACHE_BLOCK_SIZE,
+                            SDCACHE_BLOCK_SIZE, 1) != MSD_OK)
+  {
+    return MSD_ERROR;
+  }
+
+  pLine->Dirty = 0;
+  SDCacheStats.WriteBacks++;
+
+  return MSD_OK;
+}
+
+/**
+  * @brief  Loads a missing block. A miss on the block following the previous
+  *         read also loads the next blocks with one multi-block transfer,
+  *         straight into SDCACHE_READAHEAD_BLOCKS consecutive cache lines: the
+  *         ones least recently used as a group.
+  * @param  Block: SD block number
+  * @retval SD status
+  */
+static uint8_t SDCACHE_Fill(uint32_t Block)
+{
+  SDCACHE_LineTypeDef *line = NULL;
+  uint32_t first = 0, index = 0, newest = 0, oldest = 0xFFFFFFFF;
+
+  if(Block == SDCacheNextBlock)
+  {
+    for(index = 0; (index + SDCACHE_READAHEAD_BLOCKS) <= SDCACHE_BLOCKS; index++)
+    {
+      for(newest = 0, line = &SDCacheLine[index]; line < &SDCacheLine[index + SDCACHE_READAHEAD_BLOCKS]; line++)
+      {
+        newest = (line->Stamp > newest) ? line->Stamp : newest;
+      }
+      if(newest < oldest)
+      {
+        oldest = newest;
+        first = index;
+      }
+    }
+
+    /* The lines are written back and freed before the transfer lands in them */
+    for(index = first; index < (first + SDCACHE_READAHEAD_BLOCKS); index++)
+    {
+      if(SDCACHE_WriteLine(&SDCacheLine[index]) != MSD_OK)
+      {
+        return MSD_ERROR;
+      }
+      SDCacheLine[index].Stamp = 0;
+    }
+
+    if(BSP_SD_ReadBlocks_DMA(SDCacheData[first], (uint64_t)Block * SDCACHE_BLOCK_SIZE,
+                             SDCACHE_BLOCK_SIZE, SDCACHE_READAHEAD_BLOCKS) == MSD_OK)
+    {
+      SDCacheStats.ReadAheads++;
+
+      /* Blocks cached in other lines are kept, they may be newer than the
+         card. The requested block is taken last, as the most recently used */
+      for(index = SDCACHE_READAHEAD_BLOCKS; index-- > 0;)
+      {
+        if(SDCACHE_Find(Block + index) == NULL)
+        {
+          line = &SDCacheLine[first + index];
+          line->Block = Block + index;
+          line->Stamp = ++SDCacheStamp;
+          line->Dirty = 0;
+        }
+      }
+      return MSD_OK;
+    }
+
+    /* Read-ahead running past the end of the card: the freed lines stay free */
+  }
+
+  if(SDCACHE_Allocate(Block, &line) != MSD_OK)
+  {
+    return MSD_ERROR;
+  }
+  if(BSP_SD_ReadBlocks_DMA(SDCACHE_DATA(line), (uint64_t)Block * SDCACHE_BLOCK_SIZE,
+                           SDCACHE_BLOCK_SIZE, 1) != MSD_OK)
+  {
+    line->Stamp = 0;
+    return MSD_ERROR;
+  }
+
+  return MSD_OK;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************
+  * @file    stm32l152d_eval_sdcache.h
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32l152d_eval_sdcache.c driver.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32L152D_EVAL_SDCACHE_H
+#define __STM32L152D_EVAL_SDCACHE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l152d_eval_sd.h"
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL_SDCACHE
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_SDCACHE_Exported_Constants Exported Constants
+  * @{
+  */
+#define SDCACHE_BLOCK_SIZE            512       /* SD block size */
+
+#ifndef SDCACHE_BLOCKS
+#define SDCACHE_BLOCKS                8         /* Number of blocks held by the cache */
+#endif /* SDCACHE_BLOCKS */
+
+#ifndef SDCACHE_READAHEAD_BLOCKS
+#define SDCACHE_READAHEAD_BLOCKS      4         /* Blocks fetched at once on a sequential miss */
+#endif /* SDCACHE_READAHEAD_BLOCKS */
+
+/* Write policies */
+#define SDCACHE_WRITE_THROUGH         0x00      /* Writes reach the card at once */
+#define SDCACHE_WRITE_BACK            0x01      /* Writes reach the card on eviction or flush */
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_SDCACHE_Exported_Types Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Cache counters
+  */
+typedef struct
+{
+  uint32_t Hits;                       /*!< Blocks served from the cache */
+  uint32_t Misses;                     /*!< Blocks read from the card */
+  uint32_t ReadAheads;                 /*!< Multi-block read-ahead transfers */
+  uint32_t WriteBacks;                 /*!< Dirty blocks written to the card */
+}SDCACHE_StatsTypeDef;
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+
+/** @addtogroup STM32L152D_EVAL_SDCACHE_Exported_Functions
+  * @{
+  */
+void    BSP_SDCACHE_Init(uint32_t Policy);
+uint8_t BSP_SDCACHE_ReadBlocks(uint32_t *pData, uint64_t ReadAddr, uint32_t BlockSize, uint32_t NumOfBlocks);
+uint8_t BSP_SDCACHE_WriteBlocks(uint32_t *pData, uint64_t WriteAddr, uint32_t BlockSize, uint32_t NumOfBlocks);
+uint8_t BSP_SDCACHE_Flush(void);
+void    BSP_SDCACHE_Invalidate(void);
+void    BSP_SDCACHE_GetStats(SDCACHE_StatsTypeDef *pStats);
+void    BSP_SDCACHE_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32L152D_EVAL_SDCACHE_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
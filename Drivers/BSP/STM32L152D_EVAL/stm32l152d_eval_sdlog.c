@@ -0,0 +1,614 @@
+/**
+  ******************************************************************************
+  * @file    stm32l152d_eval_sdlog.c
+  * @brief   This file provides an append-only event log kept on the uSD card.
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) Initialize the SD card with BSP_SD_Init(), then mount the log with
+       BSP_SDLOG_Init(), giving the raw SD block range reserved to it. A range
+       holding no valid superblock is formatted.
+   (#) Store events with BSP_SDLOG_Append(). Records are gathered in RAM
+       staging blocks; when SDLOG_STAGING_BLOCKS blocks are full they are
+       written with one multi-block DMA transfer.
+   (#) Call BSP_SDLOG_Flush() to write the staged records right away, for
+       instance after an event that must survive a power loss. The current
+       block is written as is and the next record opens a new block.
+   (#) Read back the records of a time range with BSP_SDLOG_QueryStart() and
+       BSP_SDLOG_QueryNext(). Staged records are returned as well.
+
+                     ##### Storage layout #####
+  ==============================================================================
+  [..]
+   (#) The first two blocks of the range hold the superblock, written
+       alternately with an increasing sequence number. It gives the log
+       generation and the data block from which the log is replayed at mount.
+       It is updated every SDLOG_SUPERBLOCK_INTERVAL data blocks.
+   (#) Each data block holds a header (generation, block number, record count,
+       timestamp) and up to SDLOG_RECORDS_PER_BLOCK 32-byte records, protected
+       by a CRC-32. Blocks are never rewritten.
+   (#) At mount, data blocks are replayed from the superblock head while they
+       are valid. The blocks a torn multi-block write may have left behind the
+       first invalid one are erased, so that they can never be replayed later.
+   (#) Record timestamps may go backwards, for instance when the RTC is set.
+       Each block header holds the running maximum of the timestamps at its
+       first record, which never decreases, and the lowest and highest
+       timestamps of its own records. Time-range queries find their first
+       block with a binary search over the running maxima instead of a scan,
+       skip the blocks whose own range misses the query, and stop at the
+       first block above the range once every later record is in order.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l152d_eval_sdlog.h"
+#include <stddef.h>
+#include <string.h>
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL
+  * @{
+  */
+
+/** @defgroup STM32L152D_EVAL_SDLOG STM32L152D-EVAL SDLOG
+  * @{
+  */
+
+/** @defgroup STM32L152D_EVAL_SDLOG_Private_Types Private Types
+  * @{
+  */
+/* Log data block, one SD block */
+typedef struct
+{
+  uint32_t Magic;
+  uint32_t Generation;                  /* Log generation, changed by BSP_SDLOG_Format() */
+  uint32_t Index;                       /* Data block number */
+  uint32_t Count;                       /* Number of records */
+  uint32_t Timestamp;                   /* Running maximum timestamp at the first record */
+  SDLOG_RecordTypeDef Records[SDLOG_RECORDS_PER_BLOCK];
+  uint32_t Min;                         /* Lowest record timestamp of the block */
+  uint32_t Max;                         /* Highest record timestamp of the block */
+  uint32_t Crc;
+}SDLOG_BlockTypeDef;
+
+/* Superblock, one SD block */
+typedef struct
+{
+  uint32_t Magic;
+  uint32_t Sequence;                    /* The valid copy with the highest sequence wins */
+  uint32_t Generation;
+  uint32_t HeadBlock;                   /* Data block the replay starts from */
+  uint32_t NextSequence;                /* Record sequence at HeadBlock */
+  uint32_t Timestamp;                   /* Running maximum timestamp at HeadBlock */
+  uint32_t OrderedFrom;                 /* Ordered data block at HeadBlock */
+  uint32_t Reserved[120];
+  uint32_t Crc;
+}SDLOG_SuperTypeDef;
+
+typedef union
+{
+  SDLOG_BlockTypeDef Block;
+  SDLOG_SuperTypeDef Super;
+  uint32_t           Words[SDLOG_BLOCK_SIZE / 4];
+}SDLOG_BufferTypeDef;
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_SDLOG_Private_Defines Private Defines
+  * @{
+  */
+#define SDLOG_BLOCK_MAGIC        0x474F4C53U   /* "SLOG" */
+#define SDLOG_SUPER_MAGIC        0x50555353U   /* "SSUP" */
+#define SDLOG_SUPER_BLOCKS       2U
+#define SDLOG_NO_BLOCK           0xFFFFFFFFU
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_SDLOG_Private_Variables Private Variables
+  * @{
+  */
+static SDLOG_BlockTypeDef  SDLOGStaging[SDLOG_STAGING_BLOCKS];
+static SDLOG_BufferTypeDef SDLOGBuffer;
+static uint32_t SDLOGBufferBlock = SDLOG_NO_BLOCK;    /* Data block held by SDLOGBuffer */
+
+static uint32_t SDLOGFirstBlock = 0;                  /* First SD block of the log range */
+static uint32_t SDLOGDataBlocks = 0;                  /* Number of data blocks */
+static uint32_t SDLOGGeneration = 0;
+static uint32_t SDLOGSuperSequence = 0;
+static uint32_t SDLOGSuperHead = 0;                   /* HeadBlock of the last superblock */
+
+static uint32_t SDLOGStagingBlock = 0;                /* Data block of SDLOGStaging[0] */
+static uint32_t SDLOGStagingCount = 0;                /* Number of staged records */
+static uint32_t SDLOGNextSequence = 0;
+static uint32_t SDLOGTimestamp = 0;                   /* Running maximum timestamp */
+static uint32_t SDLOGOrderedFrom = 0;                 /* No record below the running maximum from this block on */
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_SDLOG_Private_Functions Private Functions
+  * @{
+  */
+static uint32_t SDLOG_Crc32(const void *pData, uint32_t Length);
+static uint8_t  SDLOG_ReadSuper(uint32_t Slot, SDLOG_SuperTypeDef *pSuper);
+static uint8_t  SDLOG_WriteSuper(void);
+static uint8_t  SDLOG_ReadBlock(uint32_t Index, SDLOG_BlockTypeDef **ppBlock);
+/**
+  * @}
+  */
+
+/** @defgroup STM32L152D_EVAL_SDLOG_Exported_Functions Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Mounts the log kept in a range of SD blocks.
+  * @param  FirstBlock: first SD block of the range
+  * @param  NumOfBlocks: number of blocks of the range, at least 3
+  * @retval SDLOG status
+  */
+uint8_t BSP_SDLOG_Init(uint32_t FirstBlock, uint32_t NumOfBlocks)
+{
+  SDLOG_SuperTypeDef super0, super1;
+  SDLOG_SuperTypeDef *super = NULL;
+  SDLOG_BlockTypeDef *block = NULL;
+  uint8_t valid0 = 0, valid1 = 0;
+  uint32_t index = 0, last = 0, record = 0;
+
+  if(NumOfBlocks <= SDLOG_SUPER_BLOCKS)
+  {
+    return SDLOG_ERROR;
+  }
+
+  SDLOGFirstBlock = FirstBlock;
+  SDLOGDataBlocks = NumOfBlocks - SDLOG_SUPER_BLOCKS;
+  SDLOGBufferBlock = SDLOG_NO_BLOCK;
+  SDLOGStagingCount = 0;
+
+  valid0 = SDLOG_ReadSuper(0, &super0);
+  valid1 = SDLOG_ReadSuper(1, &super1);
+  if((valid0 == 0) && (valid1 == 0))
+  {
+    return BSP_SDLOG_Format();
+  }
+  super = ((valid1 != 0) && ((valid0 == 0) || (super1.Sequence > super0.Sequence))) ? &super1 : &super0;
+
+  SDLOGGeneration    = super->Generation;
+  SDLOGSuperSequence = super->Sequence;
+  SDLOGSuperHead     = super->HeadBlock;
+  SDLOGNextSequence  = super->NextSequence;
+  SDLOGTimestamp     = super->Timestamp;
+  SDLOGOrderedFrom   = super->OrderedFrom;
+
+  /* Replay the blocks written since the last superblock update */
+  for(index = SDLOGSuperHead; index < SDLOGDataBlocks; index++)
+  {
+    if(SDLOG_ReadBlock(index, &block) != SDLOG_OK)
+    {
+      break;
+    }
+    SDLOGNextSequence = block->Records[block->Count - 1].Sequence + 1;
+    for(record = 0; record < block->Count; record++)
+    {
+      if(block->Records[record].Timestamp < SDLOGTimestamp)
+      {
+        SDLOGOrderedFrom = index + 1;
+      }
+      else
+      {
+        SDLOGTimestamp = block->Records[record].Timestamp;
+      }
+    }
+  }
+  SDLOGStagingBlock = index;
+
+  /* Erase what an interrupted multi-block write may have left after the
+     first invalid block */
+  if((index + 1) < SDLOGDataBlocks)
+  {
+    last = ((index + SDLOG_STAGING_BLOCKS) < SDLOGDataBlocks) ? (index + SDLOG_STAGING_BLOCKS) : SDLOGDataBlocks;
+    if(BSP_SD_Erase((uint64_t)(SDLOGFirstBlock + SDLOG_SUPER_BLOCKS + index + 1) * SDLOG_BLOCK_SIZE,
+                    (uint64_t)(SDLOGFirstBlock + SDLOG_SUPER_BLOCKS + last) * SDLOG_BLOCK_SIZE - 1) != MSD_OK)
+    {
+      return SDLOG_ERROR;
+    }
+    SDLOGBufferBlock = SDLOG_NO_BLOCK;
+  }
+
+  return SDLOG_OK;
+}
+
+/**
+  * @brief  Empties the log. Blocks of the previous generation are left on the
+  *         card but are never replayed.
+  * @retval SDLOG status
+  */
+uint8_t BSP_SDLOG_Format(void)
+{
+  SDLOG_SuperTypeDef super;
+  uint32_t slot = 0;
+
+  SDLOGGeneration = 0;
+  SDLOGSuperSequence = 0;
+  for(slot = 0; slot < SDLOG_SUPER_BLOCKS; slot++)
+  {
+    if(SDLOG_ReadSuper(slot, &super) != 0)
+    {
+      SDLOGGeneration = (super.Generation > SDLOGGeneration) ? super.Generation : SDLOGGeneration;
+      SDLOGSuperSequence = (super.Sequence > SDLOGSuperSequence) ? super.Sequence : SDLOGSuperSequence;
+    }
+  }
+
+  SDLOGGeneration++;
+  SDLOGStagingBlock = 0;
+  SDLOGStagingCount = 0;
+  SDLOGNextSequence = 0;
+  SDLOGTimestamp = 0;
+  SDLOGOrderedFrom = 0;
+  SDLOGBufferBlock = SDLOG_NO_BLOCK;
+
+  /* Write both copies so that no older superblock can win */
+  for(slot = 0; slot < SDLOG_SUPER_BLOCKS; slot++)
+  {
+    if(SDLOG_WriteSuper() != SDLOG_OK)
+    {
+      return SDLOG_ERROR;
+    }
+  }
+
+  return SDLOG_OK;
+}
+
+/**
+  * @brief  Appends an event to the log.
+  * @param  Timestamp: event time
+  * @param  Type: application event code
+  * @param  pData: event payload
+  * @param  Length: payload length, up to SDLOG_DATA_SIZE bytes
+  * @note   The record is staged in RAM: it reaches the card when the staging
+  *         blocks are full or when BSP_SDLOG_Flush() is called.
+  * @note   Timestamps need not increase, but queries read every block up to
+  *         the last one holding a record below an earlier timestamp.
+  * @retval SDLOG status: SDLOG_FULL when the log range is full.
+  */
+uint8_t BSP_SDLOG_Append(uint32_t Timestamp, uint16_t Type, const uint8_t *pData, uint16_t Length)
+{
+  SDLOG_BlockTypeDef *block = &SDLOGStaging[SDLOGStagingCount / SDLOG_RECORDS_PER_BLOCK];
+  SDLOG_RecordTypeDef *record = NULL;
+
+  if(Length > SDLOG_DATA_SIZE)
+  {
+    return SDLOG_ERROR;
+  }
+  if((SDLOGStagingBlock + (SDLOGStagingCount / SDLOG_RECORDS_PER_BLOCK)) >= SDLOGDataBlocks)
+  {
+    return SDLOG_FULL;
+  }
+
+  if(Timestamp < SDLOGTimestamp)
+  {
+    SDLOGOrderedFrom = SDLOGStagingBlock + (SDLOGStagingCount / SDLOG_RECORDS_PER_BLOCK) + 1;
+  }
+  else
+  {
+    SDLOGTimestamp = Timestamp;
+  }
+
+  /* First record of a block: fill in its header */
+  if((SDLOGStagingCount % SDLOG_RECORDS_PER_BLOCK) == 0)
+  {
+    memset(block, 0, sizeof(SDLOG_BlockTypeDef));
+    block->Magic      = SDLOG_BLOCK_MAGIC;
+    block->Generation = SDLOGGeneration;
+    block->Index      = SDLOGStagingBlock + (SDLOGStagingCount / SDLOG_RECORDS_PER_BLOCK);
+    block->Timestamp  = SDLOGTimestamp;
+    block->Min        = Timestamp;
+    block->Max        = Timestamp;
+  }
+  block->Min = (Timestamp < block->Min) ? Timestamp : block->Min;
+  block->Max = (Timestamp > block->Max) ? Timestamp : block->Max;
+
+  record = &block->Records[block->Count++];
+  record->Sequence  = SDLOGNextSequence++;
+  record->Timestamp = Timestamp;
+  record->Type      = Type;
+  record->Length    = Length;
+  if(Length != 0)
+  {
+    memcpy(record->Data, pData, Length);
+  }
+  SDLOGStagingCount++;
+
+  if(SDLOGStagingCount == (SDLOG_STAGING_BLOCKS * SDLOG_RECORDS_PER_BLOCK))
+  {
+    return BSP_SDLOG_Flush();
+  }
+
+  return SDLOG_OK;
+}
+
+/**
+  * @brief  Writes the staged records to the card with one multi-block DMA
+  *         transfer, then updates the superblock when it is due.
+  * @retval SDLOG status
+  */
+uint8_t BSP_SDLOG_Flush(void)
+{
+  uint32_t numblocks = (SDLOGStagingCount + SDLOG_RECORDS_PER_BLOCK - 1) / SDLOG_RECORDS_PER_BLOCK;
+  uint32_t index = 0;
+
+  if(numblocks == 0)
+  {
+    return SDLOG_OK;
+  }
+
+  for(index = 0; index < numblocks; index++)
+  {
+    SDLOGStaging[index].Crc = SDLOG_Crc32(&SDLOGStaging[index], offsetof(SDLOG_BlockTypeDef, Crc));
+  }
+
+  if(BSP_SD_WriteBlocks_DMA((uint32_t *)SDLOGStaging,
+                            (uint64_t)(SDLOGFirstBlock + SDLOG_SUPER_BLOCKS + SDLOGStagingBlock) * SDLOG_BLOCK_SIZE,
+                            SDLOG_BLOCK_SIZE, numblocks) != MSD_OK)
+  {
+    return SDLOG_ERROR;
+  }
+
+  SDLOGStagingBlock += numblocks;
+  SDLOGStagingCount = 0;
+
+  if((SDLOGStagingBlock - SDLOGSuperHead) >= SDLOG_SUPERBLOCK_INTERVAL)
+  {
+    return SDLOG_WriteSuper();
+  }
+
+  return SDLOG_OK;
+}
+
+/**
+  * @brief  Starts a time-range query.
+  * @param  pQuery: query cursor to initialize
+  * @param  From: first timestamp of the range
+  * @param  To: last timestamp of the range
+  * @retval SDLOG status
+  */
+uint8_t BSP_SDLOG_QueryStart(SDLOG_QueryTypeDef *pQuery, uint32_t From, uint32_t To)
+{
+  SDLOG_BlockTypeDef *block = NULL;
+  uint32_t low = 0, high = SDLOGStagingBlock, middle = 0;
+
+  pQuery->From = From;
+  pQuery->To = To;
+  pQuery->Record = 0;
+
+  /* Find the first written block whose running maximum is not below From:
+     the records of the blocks before the one before it are all below From */
+  while(low < high)
+  {
+    middle = (low + high) / 2;
+    if(SDLOG_ReadBlock(middle, &block) != SDLOG_OK)
+    {
+      return SDLOG_ERROR;
+    }
+    if(block->Timestamp < From)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  pQuery->Block = (low > 0) ? (low - 1) : 0;
+
+  return SDLOG_OK;
+}
+
+/**
+  * @brief  Returns the next record of a time-range query.
+  * @param  pQuery: query cursor
+  * @param  pRecord: receives the record
+  * @retval SDLOG status: SDLOG_END when no record is left in the range.
+  */
+uint8_t BSP_SDLOG_QueryNext(SDLOG_QueryTypeDef *pQuery, SDLOG_RecordTypeDef *pRecord)
+{
+  SDLOG_BlockTypeDef *block = NULL;
+  SDLOG_RecordTypeDef *record = NULL;
+  uint32_t staged = (SDLOGStagingCount + SDLOG_RECORDS_PER_BLOCK - 1) / SDLOG_RECORDS_PER_BLOCK;
+
+  while(pQuery->Block < (SDLOGStagingBlock + staged))
+  {
+    if(pQuery->Block >= SDLOGStagingBlock)
+    {
+      block = &SDLOGStaging[pQuery->Block - SDLOGStagingBlock];
+    }
+    else if(SDLOG_ReadBlock(pQuery->Block, &block) != SDLOG_OK)
+    {
+      return SDLOG_ERROR;
+    }
+
+    /* From the ordered blocks on, every record is at or above the running
+       maximum of its block: nothing further can match */
+    if((pQuery->Block >= SDLOGOrderedFrom) && (block->Timestamp > pQuery->To))
+    {
+      break;
+    }
+
+    if((block->Min > pQuery->To) || (block->Max < pQuery->From))
+    {
+      pQuery->Record = block->Count;
+    }
+
+    while(pQuery->Record < block->Count)
+    {
+      record = &block->Records[pQuery->Record++];
+      if((record->Timestamp >= pQuery->From) && (record->Timestamp <= pQuery->To))
+      {
+        *pRecord = *record;
+        return SDLOG_OK;
+      }
+    }
+
+    pQuery->Block++;
+    pQuery->Record = 0;
+  }
+
+  return SDLOG_END;
+}
+
+/**
+  * @brief  Returns the number of records appended since the log was formatted.
+  * @retval Number of records
+  */
+uint32_t BSP_SDLOG_GetRecordCount(void)
+{
+  return SDLOGNextSequence;
+}
+
+/**
+  * @}
+  */
+
+/** @addtogroup STM32L152D_EVAL_SDLOG_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Computes a CRC-32 (IEEE 802.3), four bits at a time.
+  * @param  pData: data to checksum
+  * @param  Length: data length in bytes
+  * @retval CRC value
+  */
+static uint32_t SDLOG_Crc32(const void *pData, uint32_t Length)
+{
+  static const uint32_t table[16] =
+  {
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+  };
+  const uint8_t *data = (const uint8_t *)pData;
+  uint32_t crc = 0xFFFFFFFFU;
+
+  while(Length--)
+  {
+    crc ^= *data++;
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+  }
+
+  return ~crc;
+}
+
+/**
+  * @brief  Reads and checks one superblock copy.
+  * @param  Slot: superblock copy, 0 or 1
+  * @param  pSuper: receives the superblock
+  * @retval 1 when the copy is valid, 0 otherwise
+  */
+static uint8_t SDLOG_ReadSuper(uint32_t Slot, SDLOG_SuperTypeDef *pSuper)
+{
+  SDLOGBufferBlock = SDLOG_NO_BLOCK;
+  if(BSP_SD_ReadBlocks_DMA(SDLOGBuffer.Words, (uint64_t)(SDLOGFirstBlock + Slot) * SDLOG_BLOCK_SIZE,
+                           SDLOG_BLOCK_SIZE, 1) != MSD_OK)
+  {
+    return 0;
+  }
+
+  *pSuper = SDLOGBuffer.Super;
+
+  return ((pSuper->Magic == SDLOG_SUPER_MAGIC) &&
+          (pSuper->Crc == SDLOG_Crc32(pSuper, offsetof(SDLOG_SuperTypeDef, Crc)))) ? 1 : 0;
+}
+
+/**
+  * @brief  Writes the next superblock copy, pointing at the first staged block.
+  * @retval SDLOG status
+  */
+static uint8_t SDLOG_WriteSuper(void)
+{
+  SDLOG_SuperTypeDef *super = &SDLOGBuffer.Super;
+
+  SDLOGBufferBlock = SDLOG_NO_BLOCK;
+  memset(super, 0, sizeof(SDLOG_SuperTypeDef));
+  super->Magic        = SDLOG_SUPER_MAGIC;
+  super->Sequence     = SDLOGSuperSequence + 1;
+  super->Generation   = SDLOGGeneration;
+  super->HeadBlock    = SDLOGStagingBlock;
+  super->NextSequence = SDLOGNextSequence - SDLOGStagingCount;
+  super->Timestamp    = SDLOGTimestamp;
+  super->OrderedFrom  = SDLOGOrderedFrom;
+  super->Crc          = SDLOG_Crc32(super, offsetof(SDLOG_SuperTypeDef, Crc));
+
+  if(BSP_SD_WriteBlocks_DMA(SDLOGBuffer.Words,
+                            (uint64_t)(SDLOGFirstBlock + (super->Sequence % SDLOG_SUPER_BLOCKS)) * SDLOG_BLOCK_SIZE,
+                            SDLOG_BLOCK_SIZE, 1) != MSD_OK)
+  {
+    return SDLOG_ERROR;
+  }
+
+  SDLOGSuperSequence = super->Sequence;
+  SDLOGSuperHead = SDLOGStagingBlock;
+
+  return SDLOG_OK;
+}
+
+/**
+  * @brief  Reads and checks a data block, keeping the last one read in RAM.
+  * @param  Index: data block number
+  * @param  ppBlock: receives a pointer to the block
+  * @retval SDLOG status: SDLOG_ERROR when the block does not belong to the log.
+  */
+static uint8_t SDLOG_ReadBlock(uint32_t Index, SDLOG_BlockTypeDef **ppBlock)
+{
+  SDLOG_BlockTypeDef *block = &SDLOGBuffer.Block;
+
+  *ppBlock = block;
+  if(SDLOGBufferBlock == Index)
+  {
+    return SDLOG_OK;
+  }
+
+  SDLOGBufferBlock = SDLOG_NO_BLOCK;
+  if(BSP_SD_ReadBlocks_DMA(SDLOGBuffer.Words,
+                           (uint64_t)(SDLOGFirstBlock + SDLOG_SUPER_BLOCKS + Index) * SDLOG_BLOCK_SIZE,
+                           SDLOG_BLOCK_SIZE, 1) != MSD_OK)
+  {
+    return SDLOG_ERROR;
+  }
+
+  if((block->Magic != SDLOG_BLOCK_MAGIC) || (block->Generation != SDLOGGeneration) ||
+     (block->Index != Index) || (block->Count == 0) || (block->Count > SDLOG_RECORDS_PER_BLOCK) ||
+     (block->Crc != SDLOG_Crc32(block, offsetof(SDLOG_BlockTypeDef, Crc))))
+  {
+    return SDLOG_ERROR;
+  }
+
+  SDLOGBufferBlock = Index;
+
+  return SDLOG_OK;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,123 @@
+/**
+  ******************************************************************************
+  * @file    stm32l152d_eval_sdlog.h
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32l152d_eval_sdlog.c driver.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32L152D_EVAL_SDLOG_H
+#define __STM32L152D_EVAL_SDLOG_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l152d_eval_sd.h"
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL
+  * @{
+  */
+
+/** @addtogroup STM32L152D_EVAL_SDLOG
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_SDLOG_Exported_Constants Exported Constants
+  * @{
+  */
+#define SDLOG_BLOCK_SIZE              512       /* SD block size */
+#define SDLOG_DATA_SIZE               20        /* Payload bytes of one record */
+#define SDLOG_RECORDS_PER_BLOCK       15        /* Records held by one log block */
+
+#ifndef SDLOG_STAGING_BLOCKS
+#define SDLOG_STAGING_BLOCKS          4         /* Blocks gathered in RAM and written with one multi-block transfer */
+#endif /* SDLOG_STAGING_BLOCKS */
+
+#ifndef SDLOG_SUPERBLOCK_INTERVAL
+#define SDLOG_SUPERBLOCK_INTERVAL     64        /* Data blocks written between two superblock updates */
+#endif /* SDLOG_SUPERBLOCK_INTERVAL */
+
+/* SDLOG status values */
+#define SDLOG_OK                      0x00
+#define SDLOG_ERROR                   0x01
+#define SDLOG_FULL                    0x02      /* No free block left in the log area */
+#define SDLOG_END                     0x03      /* No more record matches the query */
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+
+/** @defgroup STM32L152D_EVAL_SDLOG_Exported_Types Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Log record, 32 bytes
+  */
+typedef struct
+{
+  uint32_t Sequence;                   /*!< Record number, set by BSP_SDLOG_Append() */
+  uint32_t Timestamp;                  /*!< Event time, for instance RTC seconds */
+  uint16_t Type;                       /*!< Application event code */
+  uint16_t Length;                     /*!< Number of used bytes in Data */
+  uint8_t  Data[SDLOG_DATA_SIZE];      /*!< Event payload, e.g. a card UID */
+}SDLOG_RecordTypeDef;
+
+/**
+  * @brief  Time-range query cursor
+  */
+typedef struct
+{
+  uint32_t From;                       /*!< First timestamp returned */
+  uint32_t To;                         /*!< Last timestamp returned */
+  uint32_t Block;                      /*!< Data block being read */
+  uint32_t Record;                     /*!< Next record in this block */
+}SDLOG_QueryTypeDef;
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+
+/** @addtogroup STM32L152D_EVAL_SDLOG_Exported_Functions
+  * @{
+  */
+uint8_t  BSP_SDLOG_Init(uint32_t FirstBlock, uint32_t NumOfBlocks);
+uint8_t  BSP_SDLOG_Format(void);
+uint8_t  BSP_SDLOG_Append(uint32_t Timestamp, uint16_t Type, const uint8_t *pData, uint16_t Length);
+uint8_t  BSP_SDLOG_Flush(void);
+uint8_t  BSP_SDLOG_QueryStart(SDLOG_QueryTypeDef *pQuery, uint32_t From, uint32_t To);
+uint8_t  BSP_SDLOG_QueryNext(SDLOG_QueryTypeDef *pQuery, SDLOG_RecordTypeDef *pRecord);
+uint32_t BSP_SDLOG_GetRecordCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32L152D_EVAL_SDLOG_H */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_cm3.h
+*
+* Description:  Forced include of the host build for ARM_MATH_CORE=CM3.
+*               Loads the generic part of core_cm3.h, then replaces the
+*               intrinsics that cmsis_gcc.h implements with ARM inline
+*               assembly by equivalent C, so that the Cortex-M3 code paths
+*               of the library (loop unrolling, 64-bit accumulators) run
+*               unchanged on the build machine.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#ifndef _ARM_HOST_CM3_H
+#define _ARM_HOST_CM3_H
+
+#include <stdint.h>
+
+#define __CMSIS_GENERIC         /* only the core definitions, no NVIC/SysTick */
+#include "core_cm3.h"
+#undef  __CMSIS_GENERIC
+
+/**
+ * @brief Signed saturation of val to sat bits, as the SSAT instruction.
+ */
+static inline int32_t arm_host_ssat(int32_t val, uint32_t sat)
+{
+  const int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+  const int32_t min = -1 - max;
+
+  return (val > max) ? max : ((val < min) ? min : val);
+}
+
+/**
+ * @brief Unsigned saturation of val to sat bits, as the USAT instruction.
+ */
+static inline uint32_t arm_host_usat(int32_t val, uint32_t sat)
+{
+  const uint32_t max = (1U << sat) - 1U;
+
+  return (val < 0) ? 0U : (((uint32_t)val > max) ? max : (uint32_t)val);
+}
+
+/**
+ * @brief Count of leading zeros, 32 for a zero value as the CLZ instruction.
+ */
+static inline uint8_t arm_host_clz(uint32_t val)
+{
+  return (val == 0U) ? 32U : (uint8_t)__builtin_clz(val);
+}
+
+#undef  __SSAT
+#undef  __USAT
+#undef  __CLZ
+#define __SSAT(ARG1, ARG2)      arm_host_ssat((int32_t)(ARG1), (ARG2))
+#define __USAT(ARG1, ARG2)      arm_host_usat((int32_t)(ARG1), (ARG2))
+#define __CLZ(ARG1)             arm_host_clz((uint32_t)(ARG1))
+
+#endif /* _ARM_HOST_CM3_H */
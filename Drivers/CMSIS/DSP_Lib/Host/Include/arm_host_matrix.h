@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_matrix.h
+*
+* Description:  Tiled and threaded arm_mat_mult_f32 and arm_mat_mult_q31
+*               for the host build (SIMD=1).
+*
+*               The library sources of the two functions are compiled under
+*               the names arm_mat_mult_f32_c and arm_mat_mult_q31_c
+*               (Include/arm_host_simd_rename.h), and arm_mat_mult_f32 and
+*               arm_mat_mult_q31 keep their API and results: small products
+*               go to the library kernels, larger ones to a cache-blocked
+*               kernel that packs panels of B and slivers of A and computes
+*               register tiles of C with a micro-kernel, the C, SSE2 or
+*               AVX2 one of the level of arm_host_simd_current().
+*               The largest products split the rows of C among threads.
+*
+*               Every element of C adds its products in the order of the
+*               inner dimension, from 0, as the library kernels do: the
+*               results are bit-exact with them at every level and thread
+*               count. The library kernels index C on 16 bits, and wrap
+*               past 65535 elements; the tiled products do not.
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+#ifndef _ARM_HOST_MATRIX_H
+#define _ARM_HOST_MATRIX_H
+
+#include "arm_math.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Library kernels, under their host names.
+ */
+arm_status arm_mat_mult_f32_c(const arm_matrix_instance_f32 * pSrcA, const arm_matrix_instance_f32 * pSrcB,
+                              arm_matrix_instance_f32 * pDst);
+arm_status arm_mat_mult_q31_c(const arm_matrix_instance_q31 * pSrcA, const arm_matrix_instance_q31 * pSrcB,
+                              arm_matrix_instance_q31 * pDst);
+
+/**
+ * @brief Micro-kernels: C[mr x nr] = (accumulate ? C : 0) + A sliver * B sliver,
+ *        over kc steps of the packed slivers, mr values of A and nr of B per step.
+ *        The C kernel computes 4 x 4 tiles, the SSE2 one 6 x 8 and the AVX2 one 6 x 16.
+ */
+void arm_mat_kernel_f32_c(uint32_t kc, const float32_t * pA, const float32_t * pB,
+                          float32_t * pC, uint32_t ldc, uint32_t accumulate);
+void arm_mat_kernel_f32_sse2(uint32_t kc, const float32_t * pA, const float32_t * pB,
+                             float32_t * pC, uint32_t ldc, uint32_t accumulate);
+void arm_mat_kernel_f32_avx2(uint32_t kc, const float32_t * pA, const float32_t * pB,
+                             float32_t * pC, uint32_t ldc, uint32_t accumulate);
+
+/**
+ * @brief  Sets the number of threads of the largest products.
+ * @param[in] numThreads  0 for the default: the ARM_HOST_THREADS environment
+ *                        variable, or else the online CPUs
+ */
+void arm_host_matrix_set_threads(uint32_t numThreads);
+
+/**
+ * @brief  Number of threads of the largest products.
+ */
+uint32_t arm_host_matrix_threads(void);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _ARM_HOST_MATRIX_H */
@@ -0,0 +1,194 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_simd.h
+*
+* Description:  x86 SIMD backend of the BasicMathFunctions, of the
+*               multi-channel Biquad cascade and of the block fast math
+*               functions for the host build (SIMD=1).
+*
+*               The library sources of these kernels are compiled under the
+*               names arm_<kernel>_c (Include/arm_host_simd_rename.h).
+*               arm_<kernel> is then a dispatcher through the kernel table
+*               of the selected level: the generic C, SSE2 or AVX2. The
+*               level defaults to the best one the CPU supports, and the
+*               ARM_HOST_SIMD environment variable (none, sse2 or avx2)
+*               can lower it.
+*
+*               The SSE2 and AVX2 kernels are bit-exact with the C ones,
+*               saturation included, but for arm_dot_prod_f32 whose
+*               partial sums are added in another order.
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+#ifndef _ARM_HOST_SIMD_H
+#define _ARM_HOST_SIMD_H
+
+#include "arm_math.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Kernels of the backend: X(name, parameters, arguments).
+ */
+#define ARM_HOST_SIMD_KERNELS(X)                                                                      \
+  X(add_f32,      (float32_t * pSrcA, float32_t * pSrcB, float32_t * pDst, uint32_t blockSize),      \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(add_q31,      (q31_t * pSrcA, q31_t * pSrcB, q31_t * pDst, uint32_t blockSize),                  \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(add_q15,      (q15_t * pSrcA, q15_t * pSrcB, q15_t * pDst, uint32_t blockSize),                  \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(add_q7,       (q7_t * pSrcA, q7_t * pSrcB, q7_t * pDst, uint32_t blockSize),                     \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(sub_f32,      (float32_t * pSrcA, float32_t * pSrcB, float32_t * pDst, uint32_t blockSize),      \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(sub_q31,      (q31_t * pSrcA, q31_t * pSrcB, q31_t * pDst, uint32_t blockSize),                  \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(sub_q15,      (q15_t * pSrcA, q15_t * pSrcB, q15_t * pDst, uint32_t blockSize),                  \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(sub_q7,       (q7_t * pSrcA, q7_t * pSrcB, q7_t * pDst, uint32_t blockSize),                     \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(mult_f32,     (float32_t * pSrcA, float32_t * pSrcB, float32_t * pDst, uint32_t blockSize),      \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(mult_q31,     (q31_t * pSrcA, q31_t * pSrcB, q31_t * pDst, uint32_t blockSize),                  \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(mult_q15,     (q15_t * pSrcA, q15_t * pSrcB, q15_t * pDst, uint32_t blockSize),                  \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(mult_q7,      (q7_t * pSrcA, q7_t * pSrcB, q7_t * pDst, uint32_t blockSize),                     \
+                  (pSrcA, pSrcB, pDst, blockSize))                                                  \
+  X(scale_f32,    (float32_t * pSrc, float32_t scale, float32_t * pDst, uint32_t blockSize),         \
+                  (pSrc, scale, pDst, blockSize))                                                   \
+  X(scale_q31,    (q31_t * pSrc, q31_t scaleFract, int8_t shift, q31_t * pDst, uint32_t blockSize),  \
+                  (pSrc, scaleFract, shift, pDst, blockSize))                                       \
+  X(scale_q15,    (q15_t * pSrc, q15_t scaleFract, int8_t shift, q15_t * pDst, uint32_t blockSize),  \
+                  (pSrc, scaleFract, shift, pDst, blockSize))                                       \
+  X(scale_q7,     (q7_t * pSrc, q7_t scaleFract, int8_t shift, q7_t * pDst, uint32_t blockSize),     \
+                  (pSrc, scaleFract, shift, pDst, blockSize))                                       \
+  X(offset_f32,   (float32_t * pSrc, float32_t offset, float32_t * pDst, uint32_t blockSize),        \
+                  (pSrc, offset, pDst, blockSize))                                                  \
+  X(offset_q31,   (q31_t * pSrc, q31_t offset, q31_t * pDst, uint32_t blockSize),                    \
+                  (pSrc, offset, pDst, blockSize))                                                  \
+  X(offset_q15,   (q15_t * pSrc, q15_t offset, q15_t * pDst, uint32_t blockSize),                    \
+                  (pSrc, offset, pDst, blockSize))                                                  \
+  X(offset_q7,    (q7_t * pSrc, q7_t offset, q7_t * pDst, uint32_t blockSize),                       \
+                  (pSrc, offset, pDst, blockSize))                                                  \
+  X(negate_f32,   (float32_t * pSrc, float32_t * pDst, uint32_t blockSize),                          \
+                  (pSrc, pDst, blockSize))                                                          \
+  X(negate_q31,   (q31_t * pSrc, q31_t * pDst, uint32_t blockSize),                                  \
+                  (pSrc, pDst, blockSize))                                                          \
+  X(negate_q15,   (q15_t * pSrc, q15_t * pDst, uint32_t blockSize),                                  \
+                  (pSrc, pDst, blockSize))                                                          \
+  X(negate_q7,    (q7_t * pSrc, q7_t * pDst, uint32_t blockSize),                                    \
+                  (pSrc, pDst, blockSize))                                                          \
+  X(abs_f32,      (float32_t * pSrc, float32_t * pDst, uint32_t blockSize),                          \
+                  (pSrc, pDst, blockSize))                                                          \
+  X(abs_q31,      (q31_t * pSrc, q31_t * pDst, uint32_t blockSize),                                  \
+                  (pSrc, pDst, blockSize))                                                          \
+  X(abs_q15,      (q15_t * pSrc, q15_t * pDst, uint32_t blockSize),                                  \
+                  (pSrc, pDst, blockSize))                                                          \
+  X(abs_q7,       (q7_t * pSrc, q7_t * pDst, uint32_t blockSize),                                    \
+                  (pSrc, pDst, blockSize))                                                          \
+  X(shift_q31,    (q31_t * pSrc, int8_t shiftBits, q31_t * pDst, uint32_t blockSize),                \
+                  (pSrc, shiftBits, pDst, blockSize))                                               \
+  X(shift_q15,    (q15_t * pSrc, int8_t shiftBits, q15_t * pDst, uint32_t blockSize),                \
+                  (pSrc, shiftBits, pDst, blockSize))                                               \
+  X(shift_q7,     (q7_t * pSrc, int8_t shiftBits, q7_t * pDst, uint32_t blockSize),                  \
+                  (pSrc, shiftBits, pDst, blockSize))                                               \
+  X(dot_prod_f32, (float32_t * pSrcA, float32_t * pSrcB, uint32_t blockSize, float32_t * result),    \
+                  (pSrcA, pSrcB, blockSize, result))                                                \
+  X(dot_prod_q31, (q31_t * pSrcA, q31_t * pSrcB, uint32_t blockSize, q63_t * result),                \
+                  (pSrcA, pSrcB, blockSize, result))                                                \
+  X(dot_prod_q15, (q15_t * pSrcA, q15_t * pSrcB, uint32_t blockSize, q63_t * result),                \
+                  (pSrcA, pSrcB, blockSize, result))                                                \
+  X(dot_prod_q7,  (q7_t * pSrcA, q7_t * pSrcB, uint32_t blockSize, q31_t * result),                  \
+                  (pSrcA, pSrcB, blockSize, result))                                                \
+  X(biquad_cascade_multi_df2T_f32,                                                                  \
+                  (const arm_biquad_cascade_multi_df2T_instance_f32 * S, float32_t * pSrc,          \
+                   float32_t * pDst, uint32_t blockSize),                                           \
+                  (S, pSrc, pDst, blockSize))                                                       \
+  X(sin_block_f32,   (const float32_t * pSrc, float32_t * pDst, uint32_t blockSize),                 \
+                     (pSrc, pDst, blockSize))                                                       \
+  X(cos_block_f32,   (const float32_t * pSrc, float32_t * pDst, uint32_t blockSize),                 \
+                     (pSrc, pDst, blockSize))                                                       \
+  X(sqrt_block_f32,  (const float32_t * pSrc, float32_t * pDst, uint32_t blockSize),                 \
+                     (pSrc, pDst, blockSize))                                                       \
+  X(exp_block_f32,   (const float32_t * pSrc, float32_t * pDst, uint32_t blockSize),                 \
+                     (pSrc, pDst, blockSize))                                                       \
+  X(log_block_f32,   (const float32_t * pSrc, float32_t * pDst, uint32_t blockSize),                 \
+                     (pSrc, pDst, blockSize))                                                       \
+  X(atan2_block_f32, (const float32_t * pSrcY, const float32_t * pSrcX, float32_t * pDst,            \
+                      uint32_t blockSize),                                                          \
+                     (pSrcY, pSrcX, pDst, blockSize))
+
+/**
+ * @brief Levels of the backend.
+ */
+typedef enum
+{
+  ARM_HOST_SIMD_NONE = 0,         /**< generic C of the library */
+  ARM_HOST_SIMD_SSE2 = 1,         /**< 128-bit SSE2 kernels */
+  ARM_HOST_SIMD_AVX2 = 2          /**< 256-bit AVX2 kernels */
+} arm_host_simd_level;
+
+#define ARM_HOST_SIMD_LEVELS    3u
+
+/**
+ * @brief Kernel table of one level.
+ */
+#define ARM_HOST_SIMD_MEMBER(NAME, PARAMS, ARGS)  void (*NAME) PARAMS;
+
+typedef struct
+{
+  ARM_HOST_SIMD_KERNELS(ARM_HOST_SIMD_MEMBER)
+} arm_host_simd_ops;
+
+#undef ARM_HOST_SIMD_MEMBER
+
+/**
+ * @brief Generic C kernels of the library, and the SSE2 and AVX2 ones.
+ */
+#define ARM_HOST_SIMD_PROTOTYPES(NAME, PARAMS, ARGS)  \
+  void arm_##NAME##_c PARAMS;                         \
+  void arm_##NAME##_sse2 PARAMS;                      \
+  void arm_##NAME##_avx2 PARAMS;
+
+ARM_HOST_SIMD_KERNELS(ARM_HOST_SIMD_PROTOTYPES)
+
+#undef ARM_HOST_SIMD_PROTOTYPES
+
+/**
+ * @brief  Best level supported by the CPU.
+ */
+arm_host_simd_level arm_host_simd_detect(void);
+
+/**
+ * @brief  Selects the level of the dispatchers.
+ * @param[in] level  requested level, lowered to the best one supported
+ * @return the level selected
+ */
+arm_host_simd_level arm_host_simd_select(arm_host_simd_level level);
+
+/**
+ * @brief  Level the dispatchers use.
+ */
+arm_host_simd_level arm_host_simd_current(void);
+
+/**
+ * @brief  Kernel table of a level.
+ * @return NULL when the CPU does not support the level
+ */
+const arm_host_simd_ops *arm_host_simd_table(arm_host_simd_level level);
+
+/**
+ * @brief  Name of a level: "c", "sse2" or "avx2".
+ */
+const char *arm_host_simd_name(arm_host_simd_level level);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _ARM_HOST_SIMD_H */
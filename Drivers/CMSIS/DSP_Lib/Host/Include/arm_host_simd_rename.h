@@ -0,0 +1,68 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_simd_rename.h
+*
+* Description:  Forced include of the BasicMathFunctions sources, of
+*               arm_biquad_cascade_multi_df2T_f32.c, of the block fast math
+*               functions (arm_<function>_block_f32.c) and of the
+*               arm_mat_mult_f32.c and arm_mat_mult_q31.c in the host build
+*               with SIMD=1: compiles every kernel under the
+*               name arm_<kernel>_c, so that arm_<kernel> can dispatch
+*               between it and the SIMD kernels (arm_host_simd.h) or the
+*               tiled products (arm_host_matrix.h).
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+#ifndef _ARM_HOST_SIMD_RENAME_H
+#define _ARM_HOST_SIMD_RENAME_H
+
+#define arm_add_f32             arm_add_f32_c
+#define arm_add_q31             arm_add_q31_c
+#define arm_add_q15             arm_add_q15_c
+#define arm_add_q7              arm_add_q7_c
+#define arm_sub_f32             arm_sub_f32_c
+#define arm_sub_q31             arm_sub_q31_c
+#define arm_sub_q15             arm_sub_q15_c
+#define arm_sub_q7              arm_sub_q7_c
+#define arm_mult_f32            arm_mult_f32_c
+#define arm_mult_q31            arm_mult_q31_c
+#define arm_mult_q15            arm_mult_q15_c
+#define arm_mult_q7             arm_mult_q7_c
+#define arm_scale_f32           arm_scale_f32_c
+#define arm_scale_q31           arm_scale_q31_c
+#define arm_scale_q15           arm_scale_q15_c
+#define arm_scale_q7            arm_scale_q7_c
+#define arm_offset_f32          arm_offset_f32_c
+#define arm_offset_q31          arm_offset_q31_c
+#define arm_offset_q15          arm_offset_q15_c
+#define arm_offset_q7           arm_offset_q7_c
+#define arm_negate_f32          arm_negate_f32_c
+#define arm_negate_q31          arm_negate_q31_c
+#define arm_negate_q15          arm_negate_q15_c
+#define arm_negate_q7           arm_negate_q7_c
+#define arm_abs_f32             arm_abs_f32_c
+#define arm_abs_q31             arm_abs_q31_c
+#define arm_abs_q15             arm_abs_q15_c
+#define arm_abs_q7              arm_abs_q7_c
+#define arm_shift_q31           arm_shift_q31_c
+#define arm_shift_q15           arm_shift_q15_c
+#define arm_shift_q7            arm_shift_q7_c
+#define arm_dot_prod_f32        arm_dot_prod_f32_c
+#define arm_dot_prod_q31        arm_dot_prod_q31_c
+#define arm_dot_prod_q15        arm_dot_prod_q15_c
+#define arm_dot_prod_q7         arm_dot_prod_q7_c
+
+#define arm_biquad_cascade_multi_df2T_f32 arm_biquad_cascade_multi_df2T_f32_c
+
+#define arm_sin_block_f32       arm_sin_block_f32_c
+#define arm_cos_block_f32       arm_cos_block_f32_c
+#define arm_sqrt_block_f32      arm_sqrt_block_f32_c
+#define arm_exp_block_f32       arm_exp_block_f32_c
+#define arm_log_block_f32       arm_log_block_f32_c
+#define arm_atan2_block_f32     arm_atan2_block_f32_c
+
+#define arm_mat_mult_f32        arm_mat_mult_f32_c
+#define arm_mat_mult_q31        arm_mat_mult_q31_c
+
+#endif /* _ARM_HOST_SIMD_RENAME_H */
@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        host_suites.h
+*
+* Description:  Benchmark and golden-check suites of the host build, one
+*               pair per function group.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#ifndef _HOST_SUITES_H
+#define _HOST_SUITES_H
+
+#include "host_util.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Suite of one function group.
+ */
+typedef struct
+{
+  const char *name;               /**< group name */
+  void (*bench)(void);            /**< times the kernels of the group */
+  void (*check)(void);            /**< checks the kernels against double-precision references */
+} host_suite_t;
+
+void bench_basic(void);
+void check_basic(void);
+void bench_filtering(void);
+void check_filtering(void);
+void bench_transform(void);
+void check_transform(void);
+void bench_matrix(void);
+void check_matrix(void);
+void bench_statistics(void);
+void check_statistics(void);
+void bench_support(void);
+void check_support(void);
+void bench_fastmath(void);
+void check_fastmath(void);
+void bench_simd(void);
+void check_simd(void);
+
+/**
+ * @brief All the suites, in the order they run.
+ */
+#define HOST_SUITES                                              \
+  { "basic",      bench_basic,      check_basic      },          \
+  { "filtering",  bench_filtering,  check_filtering  },          \
+  { "transform",  bench_transform,  check_transform  },          \
+  { "matrix",     bench_matrix,     check_matrix     },          \
+  { "statistics", bench_statistics, check_statistics },          \
+  { "support",    bench_support,    check_support    },          \
+  { "fastmath",   bench_fastmath,   check_fastmath   }          \
+  HOST_SUITE_SIMD
+
+/* The x86 SIMD backend of the basic math functions, with SIMD=1 */
+#if defined(ARM_HOST_SIMD)
+#define HOST_SUITE_SIMD                                          \
+  , { "simd",     bench_simd,       check_simd       }
+#else
+#define HOST_SUITE_SIMD
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _HOST_SUITES_H */
@@ -0,0 +1,79 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        host_util.h
+*
+* Description:  Helpers shared by the host benchmark suite and the golden
+*               checks: cycle counter, test signals, error measures and
+*               result reporting.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#ifndef _HOST_UTIL_H
+#define _HOST_UTIL_H
+
+#include "arm_math.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/* ----------------------------------------------------------------------
+*       Sizes
+* -------------------------------------------------------------------- */
+#define HOST_MAX_SAMPLES        8192u     /* largest vector of the suites */
+#define HOST_MAX_TAPS           2048u     /* largest FIR of the suites */
+#define HOST_MAX_STAGES         8u        /* largest biquad cascade */
+#define HOST_MAX_DIM            64u       /* largest matrix dimension */
+
+/* ----------------------------------------------------------------------
+*       Timing
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief Kernel run by host_bench(): one call processes one block.
+ */
+typedef void (*host_kernel_t)(void *ctx);
+
+uint64_t host_cycles(void);
+double   host_seconds(void);
+const char *host_cycle_unit(void);
+
+/* ----------------------------------------------------------------------
+*       Test signals
+* -------------------------------------------------------------------- */
+void     host_seed(uint32_t seed);
+double   host_uniform(void);
+void     host_signal(double *pDst, uint32_t n, double amplitude);
+void     host_to_f32(const double *pSrc, float32_t *pDst, uint32_t n);
+void     host_to_q31(const double *pSrc, q31_t *pDst, uint32_t n);
+void     host_to_q15(const double *pSrc, q15_t *pDst, uint32_t n);
+void     host_to_q7(const double *pSrc, q7_t *pDst, uint32_t n);
+
+/* ----------------------------------------------------------------------
+*       Error measures against a double-precision reference
+* -------------------------------------------------------------------- */
+double   host_snr_f32(const double *pRef, const float32_t *pTest, uint32_t n);
+double   host_snr_f64(const double *pRef, const float64_t *pTest, uint32_t n);
+double   host_snr_q31(const double *pRef, const q31_t *pTest, uint32_t n, double scale);
+double   host_snr_q15(const double *pRef, const q15_t *pTest, uint32_t n, double scale);
+double   host_snr_q7(const double *pRef, const q7_t *pTest, uint32_t n, double scale);
+
+/* ----------------------------------------------------------------------
+*       Reporting
+* -------------------------------------------------------------------- */
+void     host_set_filter(const char *pattern);
+int      host_selected(const char *name);
+void     host_set_csv(int enable);
+int      host_csv(void);
+double   host_bench(const char *name, uint32_t size, uint32_t samples, host_kernel_t kernel, void *ctx);
+int      host_check_snr(const char *name, uint32_t size, double snr, double minSnr);
+int      host_check_equal(const char *name, uint32_t size, uint32_t mismatches);
+void     host_check_summary(uint32_t *pPassed, uint32_t *pFailed);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _HOST_UTIL_H */
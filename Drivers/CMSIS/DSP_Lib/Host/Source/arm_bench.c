@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_bench.c
+*
+* Description:  Benchmark suite of the host build.
+*
+*               arm_bench [-c] [-s suite] [pattern]
+*
+*               -c          CSV output
+*               -s suite    only runs one suite (basic, filtering, ...)
+*               pattern     only runs the kernels whose name contains it
+*
+*               For every kernel and size, prints the median time of one
+*               call in host_cycle_unit() units, the time per output
+*               sample, the samples per cycle and the throughput.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_suites.h"
+
+static const host_suite_t suites[] = { HOST_SUITES };
+
+int main(int argc, char *argv[])
+{
+  const char *suite = NULL;
+  int csv = 0, i;
+  uint32_t s, found = 0u;
+
+  for (i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-c") == 0)
+    {
+      csv = 1;
+    }
+    else if ((strcmp(argv[i], "-s") == 0) && ((i + 1) < argc))
+    {
+      suite = argv[++i];
+    }
+    else if (argv[i][0] != '-')
+    {
+      host_set_filter(argv[i]);
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [-c] [-s suite] [pattern]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  host_set_csv(csv);
+
+  for (s = 0u; s < (sizeof(suites) / sizeof(suites[0])); s++)
+  {
+    if ((suite == NULL) || (strcmp(suite, suites[s].name) == 0))
+    {
+      host_seed(0u);
+      suites[s].bench();
+      found++;
+    }
+  }
+
+  if (found == 0u)
+  {
+    fprintf(stderr, "unknown suite %s\n", suite);
+    return 2;
+  }
+
+  return 0;
+}
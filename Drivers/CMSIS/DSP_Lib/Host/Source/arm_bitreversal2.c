@@ -0,0 +1,75 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_bitreversal2.c
+*
+* Description:  C version of arm_bitreversal2.S for the host build: the
+*               in-place bit reversal run after arm_cfft_f32(),
+*               arm_cfft_q31() and arm_cfft_q15().
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @brief  In-place bit reversal of 32-bit complex data (f32, q31).
+ * @param[in, out] *pSrc        points to the in-place buffer of unknown 32-bit data type.
+ * @param[in]      bitRevLen    bit reversal table length
+ * @param[in]      *pBitRevTab  points to bit reversal table: pairs of byte
+ *                              offsets of the complex samples to swap.
+ * @return none.
+ */
+void arm_bitreversal_32(
+  uint32_t * pSrc,
+  const uint16_t bitRevLen,
+  const uint16_t * pBitRevTab)
+{
+  uint32_t a, b, i, tmp;
+
+  for (i = 0u; (i + 1u) < bitRevLen; i += 2u)
+  {
+    a = pBitRevTab[i] >> 2u;
+    b = pBitRevTab[i + 1u] >> 2u;
+
+    /* swap real parts */
+    tmp = pSrc[a];
+    pSrc[a] = pSrc[b];
+    pSrc[b] = tmp;
+
+    /* swap imaginary parts */
+    tmp = pSrc[a + 1u];
+    pSrc[a + 1u] = pSrc[b + 1u];
+    pSrc[b + 1u] = tmp;
+  }
+}
+
+/**
+ * @brief  In-place bit reversal of 16-bit complex data (q15).
+ * @param[in, out] *pSrc        points to the in-place buffer of unknown 16-bit data type.
+ * @param[in]      bitRevLen    bit reversal table length
+ * @param[in]      *pBitRevTab  points to bit reversal table, with the offsets
+ *                              of 32-bit complex data: they are halved here.
+ * @return none.
+ */
+void arm_bitreversal_16(
+  uint16_t * pSrc,
+  const uint16_t bitRevLen,
+  const uint16_t * pBitRevTab)
+{
+  uint32_t a, b, i, tmp;
+
+  for (i = 0u; (i + 1u) < bitRevLen; i += 2u)
+  {
+    a = pBitRevTab[i] >> 2u;
+    b = pBitRevTab[i + 1u] >> 2u;
+
+    /* swap real and imaginary parts together */
+    tmp = pSrc[a];
+    pSrc[a] = pSrc[b];
+    pSrc[b] = (uint16_t)tmp;
+
+    tmp = pSrc[a + 1u];
+    pSrc[a + 1u] = pSrc[b + 1u];
+    pSrc[b + 1u] = (uint16_t)tmp;
+  }
+}
@@ -0,0 +1,493 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_matrix.c
+*
+* Description:  Tiled and threaded arm_mat_mult_f32 and arm_mat_mult_q31
+*               of the host build (Include/arm_host_matrix.h).
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "arm_host_simd.h"
+#include "arm_host_matrix.h"
+
+/* ----------------------------------------------------------------------
+*       Blocking
+* -------------------------------------------------------------------- */
+#define MAT_KC                  256u      /* depth of the packed slivers: A and B slivers in L1 */
+#define MAT_MC                  96u       /* rows of a packed block of A, in L2; multiple of 4 and 6 */
+#define MAT_NC                  2048u     /* columns of a packed panel of B, in L3 */
+#define MAT_MAX_TILE            (6u * 16u)  /* largest micro-kernel tile */
+
+#define MAT_Q31_MR              2u        /* rows of a Q31 tile */
+#define MAT_Q31_NR              4u        /* columns of a Q31 tile */
+#define MAT_Q31_PANEL           (1u << 18)  /* values of a packed panel of B in Q31 */
+
+/* Output of a Q31 sum, as in the library kernel: saturated on the Cortex-M0 path */
+#ifndef ARM_MATH_CM0_FAMILY
+#define MAT_Q31_OUT(sum)        ((q31_t) ((sum) >> 31))
+#else
+#define MAT_Q31_OUT(sum)        ((q31_t) clip_q63_to_q31((sum) >> 31))
+#endif
+
+#define MAT_TILED_MIN           (16u * 16u * 16u)   /* multiply-accumulates of the smallest tiled product */
+#define MAT_THREADED_MIN        (1u << 22)          /* multiply-accumulates per thread of a threaded product */
+#define MAT_MAX_THREADS         64u
+
+/**
+ * @brief Micro-kernel of a level, with its tile.
+ */
+typedef struct
+{
+  uint32_t mr;                    /**< rows of the tile */
+  uint32_t nr;                    /**< columns of the tile */
+  void (*kernel)(uint32_t kc, const float32_t * pA, const float32_t * pB,
+                 float32_t * pC, uint32_t ldc, uint32_t accumulate);
+} mat_kernel_f32_t;
+
+static const mat_kernel_f32_t matKernels[ARM_HOST_SIMD_LEVELS] =
+{
+  { 4u, 4u,  arm_mat_kernel_f32_c },
+  { 6u, 8u,  arm_mat_kernel_f32_sse2 },
+  { 6u, 16u, arm_mat_kernel_f32_avx2 }
+};
+
+/**
+ * @brief Rows of a product that one thread computes.
+ */
+typedef struct
+{
+  const void *pA;                 /**< first row of A */
+  const void *pB;                 /**< B */
+  void *pC;                       /**< first row of C */
+  uint32_t rows;                  /**< rows of A and C */
+  uint32_t inner;                 /**< columns of A, rows of B */
+  uint32_t cols;                  /**< columns of B and C */
+  const mat_kernel_f32_t *pKernel;  /**< micro-kernel of the f32 products */
+  void (*run)(const void *pJob);  /**< computes the rows */
+  pthread_t thread;               /**< thread of the job */
+} mat_job_t;
+
+static uint32_t matThreads = 0u;
+
+/* ----------------------------------------------------------------------
+*       Threads
+* -------------------------------------------------------------------- */
+
+void arm_host_matrix_set_threads(uint32_t numThreads)
+{
+  const char *env = getenv("ARM_HOST_THREADS");
+  long cpus;
+
+  if ((numThreads == 0u) && (env != NULL))
+  {
+    numThreads = (uint32_t)strtoul(env, NULL, 10);
+  }
+  if (numThreads == 0u)
+  {
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    numThreads = (cpus > 0) ? (uint32_t)cpus : 1u;
+  }
+
+  matThreads = (numThreads > MAT_MAX_THREADS) ? MAT_MAX_THREADS : numThreads;
+}
+
+uint32_t arm_host_matrix_threads(void)
+{
+  if (matThreads == 0u)
+  {
+    arm_host_matrix_set_threads(0u);
+  }
+  return matThreads;
+}
+
+static void *mat_thread(void *p)
+{
+  const mat_job_t *pJob = p;
+
+  pJob->run(pJob);
+  return NULL;
+}
+
+/**
+ * @brief  Splits the rows of C among the threads, in multiples of rowStep,
+ *         and runs the jobs; the first one in the calling thread.
+ */
+static void mat_run(mat_job_t *pJob, uint32_t elemSize, uint32_t rowStep)
+{
+  mat_job_t jobs[MAT_MAX_THREADS];
+  const uint64_t macs = (uint64_t)pJob->rows * pJob->inner * pJob->cols;
+  uint64_t numThreads = macs / MAT_THREADED_MIN;
+  uint32_t rowsPerThread, row, t, n;
+
+  numThreads = (numThreads < arm_host_matrix_threads()) ? numThreads : arm_host_matrix_threads();
+  numThreads = (numThreads < ((pJob->rows + rowStep - 1u) / rowStep)) ? numThreads : ((pJob->rows + rowStep - 1u) / rowStep);
+  if (numThreads <= 1u)
+  {
+    pJob->run(pJob);
+    return;
+  }
+
+  rowsPerThread = (uint32_t)((pJob->rows + numThreads - 1u) / numThreads);
+  rowsPerThread = ((rowsPerThread + rowStep - 1u) / rowStep) * rowStep;
+
+  for (row = 0u, n = 0u; row < pJob->rows; row += rowsPerThread, n++)
+  {
+    jobs[n] = *pJob;
+    jobs[n].rows = ((pJob->rows - row) < rowsPerThread) ? (pJob->rows - row) : rowsPerThread;
+    jobs[n].pA = (const uint8_t *)pJob->pA + (size_t)row * pJob->inner * elemSize;
+    jobs[n].pC = (uint8_t *)pJob->pC + (size_t)row * pJob->cols * elemSize;
+  }
+
+  /* A job whose thread cannot start runs in the calling thread */
+  for (t = 1u; t < n; t++)
+  {
+    if (pthread_create(&jobs[t].thread, NULL, mat_thread, &jobs[t]) != 0)
+    {
+      jobs[t].run(&jobs[t]);
+      jobs[t].run = NULL;
+    }
+  }
+  jobs[0].run(&jobs[0]);
+  for (t = 1u; t < n; t++)
+  {
+    if (jobs[t].run != NULL)
+    {
+      pthread_join(jobs[t].thread, NULL);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Floating-point product
+* -------------------------------------------------------------------- */
+
+/* 4 x 4 tile in sixteen accumulators, for the level without SIMD */
+void arm_mat_kernel_f32_c(uint32_t kc, const float32_t * pA, const float32_t * pB,
+                          float32_t * pC, uint32_t ldc, uint32_t accumulate)
+{
+  float32_t c[4][4];
+  uint32_t i, j, k;
+
+  for (i = 0u; i < 4u; i++)
+  {
+    for (j = 0u; j < 4u; j++)
+    {
+      c[i][j] = (accumulate != 0u) ? pC[i * ldc + j] : 0.0f;
+    }
+  }
+
+  for (k = 0u; k < kc; k++)
+  {
+    for (i = 0u; i < 4u; i++)
+    {
+      for (j = 0u; j < 4u; j++)
+      {
+        c[i][j] += pA[i] * pB[j];
+      }
+    }
+    pA += 4u;
+    pB += 4u;
+  }
+
+  for (i = 0u; i < 4u; i++)
+  {
+    for (j = 0u; j < 4u; j++)
+    {
+      pC[i * ldc + j] = c[i][j];
+    }
+  }
+}
+
+/**
+ * @brief  Rows of a floating-point product: panels of MAT_NC columns of B,
+ *         cut in slivers of MAT_KC rows and packed nr columns wide; blocks of
+ *         MAT_MC rows of A, packed mr rows wide; tiles of C by the micro-kernel.
+ *         The partial tiles go through a buffer, with the padding of the
+ *         packed slivers at zero.
+ */
+static void mat_mult_f32_rows(const void *p)
+{
+  const mat_job_t *pJob = p;
+  const float32_t *pA = pJob->pA, *pB = pJob->pB;
+  float32_t *pC = pJob->pC;
+  const uint32_t M = pJob->rows, K = pJob->inner, N = pJob->cols;
+  const uint32_t mr = pJob->pKernel->mr, nr = pJob->pKernel->nr;
+  float32_t tile[MAT_MAX_TILE];
+  float32_t *pPackA, *pPackB, *pDst, *pTile;
+  uint32_t jc, pc, ic, nc, kc, mc, i0, j0, i, j, k, rows, cols;
+
+  pPackA = malloc(((MAT_MC + 5u) * MAT_KC) * sizeof(float32_t));
+  pPackB = malloc(((MAT_NC + 15u) * MAT_KC) * sizeof(float32_t));
+  if ((pPackA == NULL) || (pPackB == NULL))
+  {
+    /* Without buffers, the library kernel computes the rows */
+    arm_matrix_instance_f32 a = { (uint16_t)M, (uint16_t)K, (float32_t *)pA };
+    arm_matrix_instance_f32 b = { (uint16_t)K, (uint16_t)N, (float32_t *)pB };
+    arm_matrix_instance_f32 c = { (uint16_t)M, (uint16_t)N, pC };
+    arm_mat_mult_f32_c(&a, &b, &c);
+    free(pPackA);
+    free(pPackB);
+    return;
+  }
+
+  for (jc = 0u; jc < N; jc += MAT_NC)
+  {
+    nc = ((N - jc) < MAT_NC) ? (N - jc) : MAT_NC;
+
+    for (pc = 0u; pc < K; pc += MAT_KC)
+    {
+      kc = ((K - pc) < MAT_KC) ? (K - pc) : MAT_KC;
+
+      /* Slivers of B: kc rows of nr columns, row after row */
+      for (j0 = 0u; j0 < nc; j0 += nr)
+      {
+        pDst = pPackB + j0 * kc;
+        cols = ((nc - j0) < nr) ? (nc - j0) : nr;
+        for (k = 0u; k < kc; k++)
+        {
+          for (j = 0u; j < nr; j++)
+          {
+            *pDst++ = (j < cols) ? pB[(pc + k) * N + jc + j0 + j] : 0.0f;
+          }
+        }
+      }
+
+      for (ic = 0u; ic < M; ic += MAT_MC)
+      {
+        mc = ((M - ic) < MAT_MC) ? (M - ic) : MAT_MC;
+
+        /* Slivers of A: kc columns of mr rows, column after column */
+        for (i0 = 0u; i0 < mc; i0 += mr)
+        {
+          pDst = pPackA + i0 * kc;
+          rows = ((mc - i0) < mr) ? (mc - i0) : mr;
+          for (k = 0u; k < kc; k++)
+          {
+            for (i = 0u; i < mr; i++)
+            {
+              *pDst++ = (i < rows) ? pA[(ic + i0 + i) * K + pc + k] : 0.0f;
+            }
+          }
+        }
+
+        for (j0 = 0u; j0 < nc; j0 += nr)
+        {
+          cols = ((nc - j0) < nr) ? (nc - j0) : nr;
+          for (i0 = 0u; i0 < mc; i0 += mr)
+          {
+            rows = ((mc - i0) < mr) ? (mc - i0) : mr;
+            pTile = pC + (ic + i0) * N + jc + j0;
+
+            if ((rows == mr) && (cols == nr))
+            {
+              pJob->pKernel->kernel(kc, pPackA + i0 * kc, pPackB + j0 * kc, pTile, N, pc > 0u);
+              continue;
+            }
+
+            for (i = 0u; (pc > 0u) && (i < rows); i++)
+            {
+              for (j = 0u; j < cols; j++)
+              {
+                tile[i * nr + j] = pTile[i * N + j];
+              }
+            }
+            pJob->pKernel->kernel(kc, pPackA + i0 * kc, pPackB + j0 * kc, tile, nr, pc > 0u);
+            for (i = 0u; i < rows; i++)
+            {
+              for (j = 0u; j < cols; j++)
+              {
+                pTile[i * N + j] = tile[i * nr + j];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  free(pPackA);
+  free(pPackB);
+}
+
+arm_status arm_mat_mult_f32(
+  const arm_matrix_instance_f32 * pSrcA,
+  const arm_matrix_instance_f32 * pSrcB,
+  arm_matrix_instance_f32 * pDst)
+{
+  mat_job_t job;
+
+#ifdef ARM_MATH_MATRIX_CHECK
+  if ((pSrcA->numCols != pSrcB->numRows) ||
+      (pSrcA->numRows != pDst->numRows) || (pSrcB->numCols != pDst->numCols))
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+#endif
+
+  if (((uint64_t)pSrcA->numRows * pSrcA->numCols * pSrcB->numCols) < MAT_TILED_MIN)
+  {
+    return arm_mat_mult_f32_c(pSrcA, pSrcB, pDst);
+  }
+
+  job.pA = pSrcA->pData;
+  job.pB = pSrcB->pData;
+  job.pC = pDst->pData;
+  job.rows = pSrcA->numRows;
+  job.inner = pSrcA->numCols;
+  job.cols = pSrcB->numCols;
+  job.pKernel = &matKernels[arm_host_simd_current()];
+  job.run = mat_mult_f32_rows;
+
+  /* Rows in multiples of the tiles of every level */
+  mat_run(&job, sizeof(float32_t), 12u);
+
+  return ARM_MATH_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------
+*       Q31 product
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Rows of a Q31 product: panels of B packed MAT_Q31_NR columns
+ *         wide over the whole inner dimension, so that every output keeps
+ *         its 64-bit sum until the final shift, and 2 x 4 tiles of C in
+ *         eight accumulators. The sums wrap around as in the library kernel.
+ */
+static void mat_mult_q31_rows(const void *p)
+{
+  const mat_job_t *pJob = p;
+  const q31_t *pA = pJob->pA, *pB = pJob->pB;
+  q31_t *pC = pJob->pC;
+  const uint32_t M = pJob->rows, K = pJob->inner, N = pJob->cols;
+  uint32_t ncMax = (MAT_Q31_PANEL / K) & ~(MAT_Q31_NR - 1u);
+  const q31_t *pA0, *pA1, *pb;
+  q31_t *pPackB, *pDst;
+  q63_t s00, s01, s02, s03, s10, s11, s12, s13, sum;
+  uint32_t jc, nc, i0, j0, i, j, k, rows, cols;
+
+  ncMax = (ncMax < MAT_Q31_NR) ? MAT_Q31_NR : ncMax;
+  pPackB = malloc(((size_t)ncMax + MAT_Q31_NR) * K * sizeof(q31_t));
+  if (pPackB == NULL)
+  {
+    arm_matrix_instance_q31 a = { (uint16_t)M, (uint16_t)K, (q31_t *)pA };
+    arm_matrix_instance_q31 b = { (uint16_t)K, (uint16_t)N, (q31_t *)pB };
+    arm_matrix_instance_q31 c = { (uint16_t)M, (uint16_t)N, pC };
+    arm_mat_mult_q31_c(&a, &b, &c);
+    return;
+  }
+
+  for (jc = 0u; jc < N; jc += ncMax)
+  {
+    nc = ((N - jc) < ncMax) ? (N - jc) : ncMax;
+
+    /* Panels of B: K rows of 4 columns, row after row */
+    for (j0 = 0u; j0 < nc; j0 += MAT_Q31_NR)
+    {
+      pDst = pPackB + j0 * K;
+      cols = ((nc - j0) < MAT_Q31_NR) ? (nc - j0) : MAT_Q31_NR;
+      for (k = 0u; k < K; k++)
+      {
+        for (j = 0u; j < MAT_Q31_NR; j++)
+        {
+          *pDst++ = (j < cols) ? pB[k * N + jc + j0 + j] : 0;
+        }
+      }
+    }
+
+    for (i0 = 0u; i0 < M; i0 += MAT_Q31_MR)
+    {
+      rows = ((M - i0) < MAT_Q31_MR) ? (M - i0) : MAT_Q31_MR;
+      pA0 = pA + i0 * K;
+      pA1 = pA0 + K;
+
+      for (j0 = 0u; j0 < nc; j0 += MAT_Q31_NR)
+      {
+        cols = ((nc - j0) < MAT_Q31_NR) ? (nc - j0) : MAT_Q31_NR;
+        pb = pPackB + j0 * K;
+
+        if ((rows == MAT_Q31_MR) && (cols == MAT_Q31_NR))
+        {
+          s00 = s01 = s02 = s03 = s10 = s11 = s12 = s13 = 0;
+          for (k = 0u; k < K; k++)
+          {
+            s00 += (q63_t) pA0[k] * pb[0];
+            s01 += (q63_t) pA0[k] * pb[1];
+            s02 += (q63_t) pA0[k] * pb[2];
+            s03 += (q63_t) pA0[k] * pb[3];
+            s10 += (q63_t) pA1[k] * pb[0];
+            s11 += (q63_t) pA1[k] * pb[1];
+            s12 += (q63_t) pA1[k] * pb[2];
+            s13 += (q63_t) pA1[k] * pb[3];
+            pb += MAT_Q31_NR;
+          }
+          pDst = pC + i0 * N + jc + j0;
+          pDst[0] = MAT_Q31_OUT(s00);
+          pDst[1] = MAT_Q31_OUT(s01);
+          pDst[2] = MAT_Q31_OUT(s02);
+          pDst[3] = MAT_Q31_OUT(s03);
+          pDst[N] = MAT_Q31_OUT(s10);
+          pDst[N + 1u] = MAT_Q31_OUT(s11);
+          pDst[N + 2u] = MAT_Q31_OUT(s12);
+          pDst[N + 3u] = MAT_Q31_OUT(s13);
+          continue;
+        }
+
+        /* Partial tiles, one output at a time */
+        for (i = 0u; i < rows; i++)
+        {
+          for (j = 0u; j < cols; j++)
+          {
+            sum = 0;
+            for (k = 0u; k < K; k++)
+            {
+              sum += (q63_t) pA0[i * K + k] * pb[k * MAT_Q31_NR + j];
+            }
+            pC[(i0 + i) * N + jc + j0 + j] = MAT_Q31_OUT(sum);
+          }
+        }
+      }
+    }
+  }
+
+  free(pPackB);
+}
+
+arm_status arm_mat_mult_q31(
+  const arm_matrix_instance_q31 * pSrcA,
+  const arm_matrix_instance_q31 * pSrcB,
+  arm_matrix_instance_q31 * pDst)
+{
+  mat_job_t job;
+
+#ifdef ARM_MATH_MATRIX_CHECK
+  if ((pSrcA->numCols != pSrcB->numRows) ||
+      (pSrcA->numRows != pDst->numRows) || (pSrcB->numCols != pDst->numCols))
+  {
+    return ARM_MATH_SIZE_MISMATCH;
+  }
+#endif
+
+  if (((uint64_t)pSrcA->numRows * pSrcA->numCols * pSrcB->numCols) < MAT_TILED_MIN)
+  {
+    return arm_mat_mult_q31_c(pSrcA, pSrcB, pDst);
+  }
+
+  job.pA = pSrcA->pData;
+  job.pB = pSrcB->pData;
+  job.pC = pDst->pData;
+  job.rows = pSrcA->numRows;
+  job.inner = pSrcA->numCols;
+  job.cols = pSrcB->numCols;
+  job.pKernel = NULL;
+  job.run = mat_mult_q31_rows;
+
+  mat_run(&job, sizeof(q31_t), MAT_Q31_MR);
+
+  return ARM_MATH_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_simd.c
+*
+* Description:  CPU feature detection and dispatchers of the x86 SIMD
+*               backend of the BasicMathFunctions, of the multi-channel
+*               Biquad cascade and of the block fast math functions.
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arm_host_simd.h"
+
+/* ----------------------------------------------------------------------
+*       Kernel tables
+* -------------------------------------------------------------------- */
+#define ARM_HOST_SIMD_C(NAME, PARAMS, ARGS)     arm_##NAME##_c,
+#define ARM_HOST_SIMD_SSE2(NAME, PARAMS, ARGS)  arm_##NAME##_sse2,
+#define ARM_HOST_SIMD_AVX2(NAME, PARAMS, ARGS)  arm_##NAME##_avx2,
+
+static const arm_host_simd_ops simdTables[ARM_HOST_SIMD_LEVELS] =
+{
+  { ARM_HOST_SIMD_KERNELS(ARM_HOST_SIMD_C) },
+  { ARM_HOST_SIMD_KERNELS(ARM_HOST_SIMD_SSE2) },
+  { ARM_HOST_SIMD_KERNELS(ARM_HOST_SIMD_AVX2) }
+};
+
+static const char *const simdNames[ARM_HOST_SIMD_LEVELS] = { "c", "sse2", "avx2" };
+
+/* Table of the dispatchers: the generic C until the constructor runs */
+static const arm_host_simd_ops *simdOps = &simdTables[ARM_HOST_SIMD_NONE];
+static arm_host_simd_level simdLevel = ARM_HOST_SIMD_NONE;
+
+/* ----------------------------------------------------------------------
+*       Level selection
+* -------------------------------------------------------------------- */
+
+arm_host_simd_level arm_host_simd_detect(void)
+{
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return ARM_HOST_SIMD_AVX2;
+  }
+  if (__builtin_cpu_supports("sse2"))
+  {
+    return ARM_HOST_SIMD_SSE2;
+  }
+  return ARM_HOST_SIMD_NONE;
+}
+
+arm_host_simd_level arm_host_simd_select(arm_host_simd_level level)
+{
+  const arm_host_simd_level best = arm_host_simd_detect();
+
+  simdLevel = (level > best) ? best : level;
+  simdOps = &simdTables[simdLevel];
+
+  return simdLevel;
+}
+
+arm_host_simd_level arm_host_simd_current(void)
+{
+  return simdLevel;
+}
+
+const arm_host_simd_ops *arm_host_simd_table(arm_host_simd_level level)
+{
+  return ((uint32_t)level < ARM_HOST_SIMD_LEVELS) && (level <= arm_host_simd_detect()) ?
+         &simdTables[level] : NULL;
+}
+
+const char *arm_host_simd_name(arm_host_simd_level level)
+{
+  return ((uint32_t)level < ARM_HOST_SIMD_LEVELS) ? simdNames[level] : "?";
+}
+
+/**
+ * @brief  Selects the best level before main(), or the one named by the
+ *         ARM_HOST_SIMD environment variable.
+ */
+__attribute__((constructor)) static void arm_host_simd_init(void)
+{
+  const char *env = getenv("ARM_HOST_SIMD");
+  arm_host_simd_level level = ARM_HOST_SIMD_AVX2;
+  uint32_t i;
+
+  if (env != NULL)
+  {
+    for (i = 0u; i < ARM_HOST_SIMD_LEVELS; i++)
+    {
+      if ((strcmp(env, simdNames[i]) == 0) || ((i == 0u) && (strcmp(env, "none") == 0)))
+      {
+        level = (arm_host_simd_level)i;
+      }
+    }
+  }
+
+  arm_host_simd_select(level);
+}
+
+/* ----------------------------------------------------------------------
+*       Dispatchers
+* -------------------------------------------------------------------- */
+#define ARM_HOST_SIMD_DISPATCH(NAME, PARAMS, ARGS)  \
+  void arm_##NAME PARAMS                            \
+  {                                                 \
+    simdOps->NAME ARGS;                             \
+  }
+
+ARM_HOST_SIMD_KERNELS(ARM_HOST_SIMD_DISPATCH)
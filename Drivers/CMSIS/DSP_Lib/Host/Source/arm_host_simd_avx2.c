@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_simd_avx2.c
+*
+* Description:  AVX2 kernels of the x86 SIMD backend of the
+*               BasicMathFunctions, of the multi-channel Biquad cascade
+*               and of the block fast math functions: 256-bit vectors,
+*               compiled with -mavx2.
+*               The unpacks and packs work within 128-bit halves, so the
+*               widen, compute and pack sequences keep the sample order
+*               as on SSE2.
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+#include <immintrin.h>
+
+#include "arm_host_simd.h"
+#include "arm_host_matrix.h"
+#include "arm_common_tables.h"
+
+#define SIMD_FN(NAME)           arm_##NAME##_avx2
+#define SIMD_BYTES              32u
+
+typedef __m256i simd_i;
+typedef __m256  simd_f;
+
+#define V_LOAD(p)               _mm256_loadu_si256((const __m256i *)(p))
+#define V_STORE(p, x)           _mm256_storeu_si256((__m256i *)(p), (x))
+#define V_ZERO()                _mm256_setzero_si256()
+#define V_SET1_8(x)             _mm256_set1_epi8(x)
+#define V_SET1_16(x)            _mm256_set1_epi16(x)
+#define V_SET1_32(x)            _mm256_set1_epi32(x)
+
+#define V_AND(a, b)             _mm256_and_si256((a), (b))
+#define V_ANDNOT(a, b)          _mm256_andnot_si256((a), (b))
+#define V_OR(a, b)              _mm256_or_si256((a), (b))
+#define V_XOR(a, b)             _mm256_xor_si256((a), (b))
+
+#define V_ADDS8(a, b)           _mm256_adds_epi8((a), (b))
+#define V_SUBS8(a, b)           _mm256_subs_epi8((a), (b))
+#define V_ADDS16(a, b)          _mm256_adds_epi16((a), (b))
+#define V_SUBS16(a, b)          _mm256_subs_epi16((a), (b))
+#define V_ADD32(a, b)           _mm256_add_epi32((a), (b))
+#define V_SUB32(a, b)           _mm256_sub_epi32((a), (b))
+#define V_ADD64(a, b)           _mm256_add_epi64((a), (b))
+
+#define V_CMPGT8(a, b)          _mm256_cmpgt_epi8((a), (b))
+#define V_CMPEQ16(a, b)         _mm256_cmpeq_epi16((a), (b))
+#define V_CMPEQ32(a, b)         _mm256_cmpeq_epi32((a), (b))
+
+#define V_SRAI16(x, n)          _mm256_srai_epi16((x), (n))
+#define V_SRAI32(x, n)          _mm256_srai_epi32((x), (n))
+#define V_SLLI32(x, n)          _mm256_slli_epi32((x), (n))
+#define V_SRLI32(x, n)          _mm256_srli_epi32((x), (n))
+#define V_SLLI64(x, n)          _mm256_slli_epi64((x), (n))
+#define V_SRLI64(x, n)          _mm256_srli_epi64((x), (n))
+#define V_SLL16(x, c)           _mm256_sll_epi16((x), (c))
+#define V_SRA16(x, c)           _mm256_sra_epi16((x), (c))
+#define V_SLL32(x, c)           _mm256_sll_epi32((x), (c))
+#define V_SRA32(x, c)           _mm256_sra_epi32((x), (c))
+
+#define V_MULLO16(a, b)         _mm256_mullo_epi16((a), (b))
+#define V_MULHI16(a, b)         _mm256_mulhi_epi16((a), (b))
+#define V_MADD16(a, b)          _mm256_madd_epi16((a), (b))
+#define V_MUL_EPU32(a, b)       _mm256_mul_epu32((a), (b))
+
+#define V_SHUFFLE32(x, imm)     _mm256_shuffle_epi32((x), (imm))
+#define V_UNPACKLO8(a, b)       _mm256_unpacklo_epi8((a), (b))
+#define V_UNPACKHI8(a, b)       _mm256_unpackhi_epi8((a), (b))
+#define V_UNPACKLO16(a, b)      _mm256_unpacklo_epi16((a), (b))
+#define V_UNPACKHI16(a, b)      _mm256_unpackhi_epi16((a), (b))
+#define V_UNPACKLO32(a, b)      _mm256_unpacklo_epi32((a), (b))
+#define V_UNPACKHI32(a, b)      _mm256_unpackhi_epi32((a), (b))
+#define V_PACKS16(a, b)         _mm256_packs_epi16((a), (b))
+#define V_PACKS32(a, b)         _mm256_packs_epi32((a), (b))
+
+#define VF_LOAD(p)              _mm256_loadu_ps(p)
+#define VF_STORE(p, x)          _mm256_storeu_ps((p), (x))
+#define VF_SET1(x)              _mm256_set1_ps(x)
+#define VF_ADD(a, b)            _mm256_add_ps((a), (b))
+#define VF_SUB(a, b)            _mm256_sub_ps((a), (b))
+#define VF_MUL(a, b)            _mm256_mul_ps((a), (b))
+#define VF_XOR(a, b)            _mm256_xor_ps((a), (b))
+#define VF_ANDNOT(a, b)         _mm256_andnot_ps((a), (b))
+#define VF_AND(a, b)            _mm256_and_ps((a), (b))
+#define VF_OR(a, b)             _mm256_or_ps((a), (b))
+#define VF_DIV(a, b)            _mm256_div_ps((a), (b))
+#define VF_SQRT(x)              _mm256_sqrt_ps(x)
+#define VF_CMPLT(a, b)          _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+#define VF_CMPGT(a, b)          _mm256_cmp_ps((a), (b), _CMP_GT_OQ)
+#define VF_CMPEQ(a, b)          _mm256_cmp_ps((a), (b), _CMP_EQ_OQ)
+#define VF_CVTT_I32(x)          _mm256_cvttps_epi32(x)
+#define VF_CVT_F32(x)           _mm256_cvtepi32_ps(x)
+#define VF_AS_I(x)              _mm256_castps_si256(x)
+#define VF_AS_F(x)              _mm256_castsi256_ps(x)
+
+/**
+ * @brief  Sums of the lanes of an accumulator.
+ */
+static inline float32_t simd_hsum_f32(simd_f x)
+{
+  __m128 y = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+
+  y = _mm_add_ps(y, _mm_movehl_ps(y, y));
+  y = _mm_add_ss(y, _mm_shuffle_ps(y, y, _MM_SHUFFLE(1, 1, 1, 1)));
+
+  return _mm_cvtss_f32(y);
+}
+
+/**
+ * @brief  Table values at the indices of the lanes.
+ */
+static inline simd_f simd_gather_f32(const float32_t * pTable, simd_i index)
+{
+  return _mm256_i32gather_ps(pTable, index, 4);
+}
+
+static inline int64_t simd_hsum_i64(simd_i x)
+{
+  int64_t lanes[4];
+
+  _mm256_storeu_si256((__m256i *)lanes, x);
+  return (int64_t)((uint64_t)lanes[0] + (uint64_t)lanes[1] + (uint64_t)lanes[2] + (uint64_t)lanes[3]);
+}
+
+static inline int32_t simd_hsum_i32(simd_i x)
+{
+  __m128i y = _mm_add_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+
+  y = _mm_add_epi32(y, _mm_shuffle_epi32(y, _MM_SHUFFLE(1, 0, 3, 2)));
+  y = _mm_add_epi32(y, _mm_shuffle_epi32(y, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  return _mm_cvtsi128_si32(y);
+}
+
+#include "arm_host_simd_kernels.h"
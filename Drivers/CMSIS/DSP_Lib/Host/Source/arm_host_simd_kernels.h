@@ -0,0 +1,906 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_simd_kernels.h
+*
+* Description:  BasicMathFunctions, multi-channel Biquad cascade and
+*               block fast math kernels of the x86 SIMD backend, and the
+*               micro-kernel of the tiled matrix multiplication
+*               (arm_host_matrix.h), written once over the vector macros
+*               that arm_host_simd_sse2.c and arm_host_simd_avx2.c define,
+*               and included by both.
+*
+*               Every kernel computes the whole vectors of the block, then
+*               hands the 0 to (lanes - 1) remaining samples to the generic
+*               C kernel, so that the tails are bit-exact by construction.
+*               The bodies follow the C kernels operation by operation:
+*               the saturations of __SSAT and clip_q63_to_q31 become
+*               saturating adds and packs where SSE2 has them, and explicit
+*               overflow masks on 32-bit lanes; the selections of the block
+*               fast math functions become compare masks.
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+/* Lanes of a vector for a sample type */
+#define SIMD_LANES(TYPE)        (SIMD_BYTES / sizeof(TYPE))
+
+/* ----------------------------------------------------------------------
+*       Lane helpers
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Lanes of a where mask is set, of b elsewhere.
+ */
+static inline simd_i simd_blend(simd_i mask, simd_i a, simd_i b)
+{
+  return V_OR(V_AND(mask, a), V_ANDNOT(mask, b));
+}
+
+/**
+ * @brief  Saturated value of the sign of x, 0x7FFFFFFF ^ (x >> 31).
+ */
+static inline simd_i simd_sat32(simd_i x)
+{
+  return V_XOR(V_SRAI32(x, 31), V_SET1_32(0x7FFFFFFF));
+}
+
+/**
+ * @brief  a + b on 32-bit lanes, saturated as clip_q63_to_q31().
+ */
+static inline simd_i simd_adds32(simd_i a, simd_i b)
+{
+  const simd_i r = V_ADD32(a, b);
+  const simd_i overflow = V_SRAI32(V_AND(V_XOR(a, r), V_XOR(b, r)), 31);
+
+  return simd_blend(overflow, simd_sat32(a), r);
+}
+
+/**
+ * @brief  a - b on 32-bit lanes, saturated as clip_q63_to_q31().
+ */
+static inline simd_i simd_subs32(simd_i a, simd_i b)
+{
+  const simd_i r = V_SUB32(a, b);
+  const simd_i overflow = V_SRAI32(V_AND(V_XOR(a, b), V_XOR(a, r)), 31);
+
+  return simd_blend(overflow, simd_sat32(a), r);
+}
+
+/**
+ * @brief  Signed 32 x 32 -> 64-bit products of the lanes, as their low and
+ *         high halves. The unsigned products are corrected by the
+ *         operands of the negative lanes.
+ */
+static inline void simd_mul32(simd_i a, simd_i b, simd_i *pLo, simd_i *pHi)
+{
+  const simd_i even = V_SHUFFLE32(V_MUL_EPU32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+  const simd_i odd = V_SHUFFLE32(V_MUL_EPU32(V_SRLI64(a, 32), V_SRLI64(b, 32)),
+                                 _MM_SHUFFLE(3, 1, 2, 0));
+  simd_i hi = V_UNPACKHI32(even, odd);
+
+  hi = V_SUB32(hi, V_AND(V_SRAI32(a, 31), b));
+  hi = V_SUB32(hi, V_AND(V_SRAI32(b, 31), a));
+
+  *pLo = V_UNPACKLO32(even, odd);
+  *pHi = hi;
+}
+
+/**
+ * @brief  Arithmetic right shift of 64-bit lanes by 14 bits: logical shift,
+ *         then the sign of the high half in the top 14 bits.
+ */
+static inline simd_i simd_sra64_14(simd_i x)
+{
+  const simd_i sign = V_SHUFFLE32(V_SRAI32(x, 31), _MM_SHUFFLE(3, 3, 1, 1));
+
+  return V_OR(V_SRLI64(x, 14), V_SLLI64(sign, 50));
+}
+
+/**
+ * @brief  x << shift on 32-bit lanes, saturated when the value does not
+ *         fit, as clip_q63_to_q31((q63_t) x << shift).
+ */
+static inline simd_i simd_shl_sat32(simd_i x, __m128i shift)
+{
+  const simd_i y = V_SLL32(x, shift);
+
+  return simd_blend(V_CMPEQ32(V_SRA32(y, shift), x), y, simd_sat32(x));
+}
+
+/**
+ * @brief  x << shift on 16-bit lanes, saturated when the value does not
+ *         fit, as __SSAT((q31_t) x << shift, 16).
+ */
+static inline simd_i simd_shl_sat16(simd_i x, __m128i shift)
+{
+  const simd_i y = V_SLL16(x, shift);
+  const simd_i sat = V_XOR(V_SRAI16(x, 15), V_SET1_16(0x7FFF));
+
+  return simd_blend(V_CMPEQ16(V_SRA16(y, shift), x), y, sat);
+}
+
+/**
+ * @brief  Sign extension of the low and high halves of q7 lanes to 16 bits.
+ */
+static inline simd_i simd_widen_lo8(simd_i x)
+{
+  return V_SRAI16(V_UNPACKLO8(x, x), 8);
+}
+
+static inline simd_i simd_widen_hi8(simd_i x)
+{
+  return V_SRAI16(V_UNPACKHI8(x, x), 8);
+}
+
+/**
+ * @brief  Signed 16 x 16 -> 32-bit products of the low and high halves of
+ *         q15 lanes.
+ */
+static inline simd_i simd_mul_lo16(simd_i a, simd_i b)
+{
+  return V_UNPACKLO16(V_MULLO16(a, b), V_MULHI16(a, b));
+}
+
+static inline simd_i simd_mul_hi16(simd_i a, simd_i b)
+{
+  return V_UNPACKHI16(V_MULLO16(a, b), V_MULHI16(a, b));
+}
+
+/* ----------------------------------------------------------------------
+*       Lane operations of the element-wise kernels
+* -------------------------------------------------------------------- */
+static inline simd_f simd_add_f32(simd_f a, simd_f b)  { return VF_ADD(a, b); }
+static inline simd_f simd_sub_f32(simd_f a, simd_f b)  { return VF_SUB(a, b); }
+static inline simd_f simd_mult_f32(simd_f a, simd_f b) { return VF_MUL(a, b); }
+
+static inline simd_i simd_add_q31(simd_i a, simd_i b)  { return simd_adds32(a, b); }
+static inline simd_i simd_sub_q31(simd_i a, simd_i b)  { return simd_subs32(a, b); }
+static inline simd_i simd_add_q15(simd_i a, simd_i b)  { return V_ADDS16(a, b); }
+static inline simd_i simd_sub_q15(simd_i a, simd_i b)  { return V_SUBS16(a, b); }
+static inline simd_i simd_add_q7(simd_i a, simd_i b)   { return V_ADDS8(a, b); }
+static inline simd_i simd_sub_q7(simd_i a, simd_i b)   { return V_SUBS8(a, b); }
+
+/* Only 0x80000000 squared saturates. The generic C computes
+ * clip_q63_to_q31((a * b) >> 31), the Cortex-M3 code __SSAT((a * b) >> 32,
+ * 31) << 1, which drops the last bit. */
+static inline simd_i simd_mult_q31(simd_i a, simd_i b)
+{
+  const simd_i min = V_SET1_32((int32_t)0x80000000);
+  const simd_i sat = V_AND(V_CMPEQ32(a, min), V_CMPEQ32(b, min));
+  simd_i lo, hi;
+
+  simd_mul32(a, b, &lo, &hi);
+#if defined(ARM_MATH_CM0_FAMILY)
+  return V_XOR(V_OR(V_SLLI32(hi, 1), V_SRLI32(lo, 31)), sat);
+#else
+  return V_XOR(V_SLLI32(hi, 1), V_AND(sat, V_SET1_32((int32_t)0xFFFFFFFE)));
+#endif
+}
+
+/* __SSAT((a * b) >> 15, 16) */
+static inline simd_i simd_mult_q15(simd_i a, simd_i b)
+{
+  return V_PACKS32(V_SRAI32(simd_mul_lo16(a, b), 15), V_SRAI32(simd_mul_hi16(a, b), 15));
+}
+
+/* __SSAT((a * b) >> 7, 8) */
+static inline simd_i simd_mult_q7(simd_i a, simd_i b)
+{
+  const simd_i lo = V_SRAI16(V_MULLO16(simd_widen_lo8(a), simd_widen_lo8(b)), 7);
+  const simd_i hi = V_SRAI16(V_MULLO16(simd_widen_hi8(a), simd_widen_hi8(b)), 7);
+
+  return V_PACKS16(lo, hi);
+}
+
+static inline simd_f simd_negate_f32(simd_f x) { return VF_XOR(x, VF_SET1(-0.0f)); }
+static inline simd_f simd_abs_f32(simd_f x)    { return VF_ANDNOT(VF_SET1(-0.0f), x); }
+
+/* -x, 0x80000000 going to 0x7FFFFFFF */
+static inline simd_i simd_negate_q31(simd_i x)
+{
+  return V_XOR(V_SUB32(V_ZERO(), x), V_CMPEQ32(x, V_SET1_32((int32_t)0x80000000)));
+}
+
+static inline simd_i simd_negate_q15(simd_i x) { return V_SUBS16(V_ZERO(), x); }
+static inline simd_i simd_negate_q7(simd_i x)  { return V_SUBS8(V_ZERO(), x); }
+
+/* (x ^ s) - s with s the sign mask: 0x80000000 wraps to itself, and the
+ * addition of its sign turns it into 0x7FFFFFFF */
+static inline simd_i simd_abs_q31(simd_i x)
+{
+  const simd_i s = V_SRAI32(x, 31);
+  const simd_i r = V_SUB32(V_XOR(x, s), s);
+
+  return V_ADD32(r, V_SRAI32(r, 31));
+}
+
+static inline simd_i simd_abs_q15(simd_i x)
+{
+  const simd_i s = V_SRAI16(x, 15);
+
+  return V_SUBS16(V_XOR(x, s), s);
+}
+
+static inline simd_i simd_abs_q7(simd_i x)
+{
+  const simd_i s = V_CMPGT8(V_ZERO(), x);
+
+  return V_SUBS8(V_XOR(x, s), s);
+}
+
+/* ----------------------------------------------------------------------
+*       Element-wise kernels
+* -------------------------------------------------------------------- */
+
+/* Kernel of two float vectors */
+#define SIMD_BINARY_F32(NAME)                                                          \
+  void SIMD_FN(NAME)(float32_t * pSrcA, float32_t * pSrcB, float32_t * pDst,           \
+                     uint32_t blockSize)                                               \
+  {                                                                                    \
+    uint32_t i;                                                                        \
+                                                                                       \
+    for (i = 0u; (i + SIMD_LANES(float32_t)) <= blockSize; i += SIMD_LANES(float32_t)) \
+    {                                                                                  \
+      VF_STORE(pDst + i, simd_##NAME(VF_LOAD(pSrcA + i), VF_LOAD(pSrcB + i)));         \
+    }                                                                                  \
+    arm_##NAME##_c(pSrcA + i, pSrcB + i, pDst + i, blockSize - i);                     \
+  }
+
+/* Kernel of two integer vectors */
+#define SIMD_BINARY_Q(NAME, TYPE)                                                      \
+  void SIMD_FN(NAME)(TYPE * pSrcA, TYPE * pSrcB, TYPE * pDst, uint32_t blockSize)      \
+  {                                                                                    \
+    uint32_t i;                                                                        \
+                                                                                       \
+    for (i = 0u; (i + SIMD_LANES(TYPE)) <= blockSize; i += SIMD_LANES(TYPE))           \
+    {                                                                                  \
+      V_STORE(pDst + i, simd_##NAME(V_LOAD(pSrcA + i), V_LOAD(pSrcB + i)));            \
+    }                                                                                  \
+    arm_##NAME##_c(pSrcA + i, pSrcB + i, pDst + i, blockSize - i);                     \
+  }
+
+/* Kernel of one float vector */
+#define SIMD_UNARY_F32(NAME)                                                           \
+  void SIMD_FN(NAME)(float32_t * pSrc, float32_t * pDst, uint32_t blockSize)           \
+  {                                                                                    \
+    uint32_t i;                                                                        \
+                                                                                       \
+    for (i = 0u; (i + SIMD_LANES(float32_t)) <= blockSize; i += SIMD_LANES(float32_t)) \
+    {                                                                                  \
+      VF_STORE(pDst + i, simd_##NAME(VF_LOAD(pSrc + i)));                              \
+    }                                                                                  \
+    arm_##NAME##_c(pSrc + i, pDst + i, blockSize - i);                                 \
+  }
+
+/* Kernel of one integer vector */
+#define SIMD_UNARY_Q(NAME, TYPE)                                                       \
+  void SIMD_FN(NAME)(TYPE * pSrc, TYPE * pDst, uint32_t blockSize)                     \
+  {                                                                                    \
+    uint32_t i;                                                                        \
+                                                                                       \
+    for (i = 0u; (i + SIMD_LANES(TYPE)) <= blockSize; i += SIMD_LANES(TYPE))           \
+    {                                                                                  \
+      V_STORE(pDst + i, simd_##NAME(V_LOAD(pSrc + i)));                                \
+    }                                                                                  \
+    arm_##NAME##_c(pSrc + i, pDst + i, blockSize - i);                                 \
+  }
+
+SIMD_BINARY_F32(add_f32)
+SIMD_BINARY_F32(sub_f32)
+SIMD_BINARY_F32(mult_f32)
+SIMD_BINARY_Q(add_q31, q31_t)
+SIMD_BINARY_Q(add_q15, q15_t)
+SIMD_BINARY_Q(add_q7, q7_t)
+SIMD_BINARY_Q(sub_q31, q31_t)
+SIMD_BINARY_Q(sub_q15, q15_t)
+SIMD_BINARY_Q(sub_q7, q7_t)
+SIMD_BINARY_Q(mult_q31, q31_t)
+SIMD_BINARY_Q(mult_q15, q15_t)
+SIMD_BINARY_Q(mult_q7, q7_t)
+SIMD_UNARY_F32(negate_f32)
+SIMD_UNARY_F32(abs_f32)
+SIMD_UNARY_Q(negate_q31, q31_t)
+SIMD_UNARY_Q(negate_q15, q15_t)
+SIMD_UNARY_Q(negate_q7, q7_t)
+SIMD_UNARY_Q(abs_q31, q31_t)
+SIMD_UNARY_Q(abs_q15, q15_t)
+SIMD_UNARY_Q(abs_q7, q7_t)
+
+/* ----------------------------------------------------------------------
+*       Kernels with a scalar parameter
+* -------------------------------------------------------------------- */
+
+void SIMD_FN(scale_f32)(float32_t * pSrc, float32_t scale, float32_t * pDst, uint32_t blockSize)
+{
+  const simd_f k = VF_SET1(scale);
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(float32_t)) <= blockSize; i += SIMD_LANES(float32_t))
+  {
+    VF_STORE(pDst + i, VF_MUL(VF_LOAD(pSrc + i), k));
+  }
+  arm_scale_f32_c(pSrc + i, scale, pDst + i, blockSize - i);
+}
+
+void SIMD_FN(offset_f32)(float32_t * pSrc, float32_t offset, float32_t * pDst, uint32_t blockSize)
+{
+  const simd_f k = VF_SET1(offset);
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(float32_t)) <= blockSize; i += SIMD_LANES(float32_t))
+  {
+    VF_STORE(pDst + i, VF_ADD(VF_LOAD(pSrc + i), k));
+  }
+  arm_offset_f32_c(pSrc + i, offset, pDst + i, blockSize - i);
+}
+
+void SIMD_FN(offset_q31)(q31_t * pSrc, q31_t offset, q31_t * pDst, uint32_t blockSize)
+{
+  const simd_i k = V_SET1_32(offset);
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q31_t)) <= blockSize; i += SIMD_LANES(q31_t))
+  {
+    V_STORE(pDst + i, simd_adds32(V_LOAD(pSrc + i), k));
+  }
+  arm_offset_q31_c(pSrc + i, offset, pDst + i, blockSize - i);
+}
+
+void SIMD_FN(offset_q15)(q15_t * pSrc, q15_t offset, q15_t * pDst, uint32_t blockSize)
+{
+  const simd_i k = V_SET1_16(offset);
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q15_t)) <= blockSize; i += SIMD_LANES(q15_t))
+  {
+    V_STORE(pDst + i, V_ADDS16(V_LOAD(pSrc + i), k));
+  }
+  arm_offset_q15_c(pSrc + i, offset, pDst + i, blockSize - i);
+}
+
+void SIMD_FN(offset_q7)(q7_t * pSrc, q7_t offset, q7_t * pDst, uint32_t blockSize)
+{
+  const simd_i k = V_SET1_8(offset);
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q7_t)) <= blockSize; i += SIMD_LANES(q7_t))
+  {
+    V_STORE(pDst + i, V_ADDS8(V_LOAD(pSrc + i), k));
+  }
+  arm_offset_q7_c(pSrc + i, offset, pDst + i, blockSize - i);
+}
+
+/* High half of x * scaleFract, shifted by shift + 1 bits with saturation
+ * to the left, or to the right when negative */
+void SIMD_FN(scale_q31)(q31_t * pSrc, q31_t scaleFract, int8_t shift, q31_t * pDst, uint32_t blockSize)
+{
+  const int8_t kShift = shift + 1;
+  const simd_i k = V_SET1_32(scaleFract);
+  const __m128i count = _mm_cvtsi32_si128((kShift & 0x80) ? -kShift : kShift);
+  simd_i lo, hi;
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q31_t)) <= blockSize; i += SIMD_LANES(q31_t))
+  {
+    simd_mul32(V_LOAD(pSrc + i), k, &lo, &hi);
+    V_STORE(pDst + i, (kShift & 0x80) ? V_SRA32(hi, count) : simd_shl_sat32(hi, count));
+  }
+  arm_scale_q31_c(pSrc + i, scaleFract, shift, pDst + i, blockSize - i);
+}
+
+/* __SSAT((x * scaleFract) >> (15 - shift), 16) */
+void SIMD_FN(scale_q15)(q15_t * pSrc, q15_t scaleFract, int8_t shift, q15_t * pDst, uint32_t blockSize)
+{
+  const simd_i k = V_SET1_16(scaleFract);
+  const __m128i count = _mm_cvtsi32_si128(15 - shift);
+  simd_i x;
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q15_t)) <= blockSize; i += SIMD_LANES(q15_t))
+  {
+    x = V_LOAD(pSrc + i);
+    V_STORE(pDst + i, V_PACKS32(V_SRA32(simd_mul_lo16(x, k), count),
+                                V_SRA32(simd_mul_hi16(x, k), count)));
+  }
+  arm_scale_q15_c(pSrc + i, scaleFract, shift, pDst + i, blockSize - i);
+}
+
+/* __SSAT((x * scaleFract) >> (7 - shift), 8), the product fitting 16 bits */
+void SIMD_FN(scale_q7)(q7_t * pSrc, q7_t scaleFract, int8_t shift, q7_t * pDst, uint32_t blockSize)
+{
+  const simd_i k = V_SET1_16(scaleFract);
+  const __m128i count = _mm_cvtsi32_si128(7 - shift);
+  simd_i x;
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q7_t)) <= blockSize; i += SIMD_LANES(q7_t))
+  {
+    x = V_LOAD(pSrc + i);
+    V_STORE(pDst + i, V_PACKS16(V_SRA16(V_MULLO16(simd_widen_lo8(x), k), count),
+                                V_SRA16(V_MULLO16(simd_widen_hi8(x), k), count)));
+  }
+  arm_scale_q7_c(pSrc + i, scaleFract, shift, pDst + i, blockSize - i);
+}
+
+void SIMD_FN(shift_q31)(q31_t * pSrc, int8_t shiftBits, q31_t * pDst, uint32_t blockSize)
+{
+  const uint8_t sign = (shiftBits & 0x80);
+  const __m128i count = _mm_cvtsi32_si128((sign == 0u) ? shiftBits : -shiftBits);
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q31_t)) <= blockSize; i += SIMD_LANES(q31_t))
+  {
+    V_STORE(pDst + i, (sign == 0u) ? simd_shl_sat32(V_LOAD(pSrc + i), count) :
+                                     V_SRA32(V_LOAD(pSrc + i), count));
+  }
+  arm_shift_q31_c(pSrc + i, shiftBits, pDst + i, blockSize - i);
+}
+
+void SIMD_FN(shift_q15)(q15_t * pSrc, int8_t shiftBits, q15_t * pDst, uint32_t blockSize)
+{
+  const uint8_t sign = (shiftBits & 0x80);
+  const __m128i count = _mm_cvtsi32_si128((sign == 0u) ? shiftBits : -shiftBits);
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q15_t)) <= blockSize; i += SIMD_LANES(q15_t))
+  {
+    V_STORE(pDst + i, (sign == 0u) ? simd_shl_sat16(V_LOAD(pSrc + i), count) :
+                                     V_SRA16(V_LOAD(pSrc + i), count));
+  }
+  arm_shift_q15_c(pSrc + i, shiftBits, pDst + i, blockSize - i);
+}
+
+/* On 16-bit lanes, where the shifted value is exact or saturated with the
+ * sign of the input, and then packed with saturation to 8 bits */
+void SIMD_FN(shift_q7)(q7_t * pSrc, int8_t shiftBits, q7_t * pDst, uint32_t blockSize)
+{
+  const uint8_t sign = (shiftBits & 0x80);
+  const __m128i count = _mm_cvtsi32_si128((sign == 0u) ? shiftBits : -shiftBits);
+  simd_i x;
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q7_t)) <= blockSize; i += SIMD_LANES(q7_t))
+  {
+    x = V_LOAD(pSrc + i);
+    if (sign == 0u)
+    {
+      V_STORE(pDst + i, V_PACKS16(simd_shl_sat16(simd_widen_lo8(x), count),
+                                  simd_shl_sat16(simd_widen_hi8(x), count)));
+    }
+    else
+    {
+      V_STORE(pDst + i, V_PACKS16(V_SRA16(simd_widen_lo8(x), count),
+                                  V_SRA16(simd_widen_hi8(x), count)));
+    }
+  }
+  arm_shift_q7_c(pSrc + i, shiftBits, pDst + i, blockSize - i);
+}
+
+/* ----------------------------------------------------------------------
+*       Dot products
+* -------------------------------------------------------------------- */
+
+/* One accumulator per lane: the partial sums are added in another order
+ * than the single accumulator of the C kernel */
+void SIMD_FN(dot_prod_f32)(float32_t * pSrcA, float32_t * pSrcB, uint32_t blockSize, float32_t * result)
+{
+  simd_f acc = VF_SET1(0.0f);
+  float32_t tail;
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(float32_t)) <= blockSize; i += SIMD_LANES(float32_t))
+  {
+    acc = VF_ADD(acc, VF_MUL(VF_LOAD(pSrcA + i), VF_LOAD(pSrcB + i)));
+  }
+  arm_dot_prod_f32_c(pSrcA + i, pSrcB + i, blockSize - i, &tail);
+
+  *result = simd_hsum_f32(acc) + tail;
+}
+
+/* Sum of the 64-bit products shifted by 14 bits: the products of the even
+ * and odd lanes are rebuilt from their halves, and shifted with the sign
+ * of their high half */
+void SIMD_FN(dot_prod_q31)(q31_t * pSrcA, q31_t * pSrcB, uint32_t blockSize, q63_t * result)
+{
+  simd_i acc = V_ZERO(), a, b, lo, hi;
+  q63_t tail;
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q31_t)) <= blockSize; i += SIMD_LANES(q31_t))
+  {
+    a = V_LOAD(pSrcA + i);
+    b = V_LOAD(pSrcB + i);
+    simd_mul32(a, b, &lo, &hi);
+    acc = V_ADD64(acc, simd_sra64_14(V_UNPACKLO32(lo, hi)));
+    acc = V_ADD64(acc, simd_sra64_14(V_UNPACKHI32(lo, hi)));
+  }
+  arm_dot_prod_q31_c(pSrcA + i, pSrcB + i, blockSize - i, &tail);
+
+  *result = simd_hsum_i64(acc) + tail;
+}
+
+/* Sums of pairs of 32-bit products, widened to 64 bits. A pair sum can
+ * only reach 0x80000000 as 2 * 0x8000 * 0x8000, which is positive. */
+void SIMD_FN(dot_prod_q15)(q15_t * pSrcA, q15_t * pSrcB, uint32_t blockSize, q63_t * result)
+{
+  const simd_i min = V_SET1_32((int32_t)0x80000000);
+  simd_i acc = V_ZERO(), pairs, sign;
+  q63_t tail;
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q15_t)) <= blockSize; i += SIMD_LANES(q15_t))
+  {
+    pairs = V_MADD16(V_LOAD(pSrcA + i), V_LOAD(pSrcB + i));
+    sign = V_ANDNOT(V_CMPEQ32(pairs, min), V_SRAI32(pairs, 31));
+    acc = V_ADD64(acc, V_UNPACKLO32(pairs, sign));
+    acc = V_ADD64(acc, V_UNPACKHI32(pairs, sign));
+  }
+  arm_dot_prod_q15_c(pSrcA + i, pSrcB + i, blockSize - i, &tail);
+
+  *result = simd_hsum_i64(acc) + tail;
+}
+
+/* 32-bit sums of pairs of 16-bit products, wrapping as the q31_t
+ * accumulator of the C kernel */
+void SIMD_FN(dot_prod_q7)(q7_t * pSrcA, q7_t * pSrcB, uint32_t blockSize, q31_t * result)
+{
+  simd_i acc = V_ZERO(), a, b;
+  q31_t tail;
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(q7_t)) <= blockSize; i += SIMD_LANES(q7_t))
+  {
+    a = V_LOAD(pSrcA + i);
+    b = V_LOAD(pSrcB + i);
+    acc = V_ADD32(acc, V_MADD16(simd_widen_lo8(a), simd_widen_lo8(b)));
+    acc = V_ADD32(acc, V_MADD16(simd_widen_hi8(a), simd_widen_hi8(b)));
+  }
+  arm_dot_prod_q7_c(pSrcA + i, pSrcB + i, blockSize - i, &tail);
+
+  *result = (q31_t)((uint32_t)simd_hsum_i32(acc) + (uint32_t)tail);
+}
+
+/* ----------------------------------------------------------------------
+*       Multi-channel Biquad cascade
+* -------------------------------------------------------------------- */
+
+/* One step of the transposed direct form II recursion on the channels of
+ * one vector, with the operations of the C kernel in the same order */
+#define SIMD_DF2T_STEP(X, Y, D1, D2)                                        \
+  do                                                                        \
+  {                                                                         \
+    Y = VF_ADD(VF_MUL(b0, X), D1);                                          \
+    D1 = VF_ADD(VF_ADD(VF_MUL(b1, X), VF_MUL(a1, Y)), D2);                  \
+    D2 = VF_ADD(VF_MUL(b2, X), VF_MUL(a2, Y));                              \
+  } while (0)
+
+/* One channel per lane. Two vectors of channels run side by side, so that
+ * two independent recursions hide the latency of each other; the 0 to
+ * (lanes - 1) remaining channels run in scalar code with the same
+ * operations. The result is bit-exact with the C kernel. */
+void SIMD_FN(biquad_cascade_multi_df2T_f32)(const arm_biquad_cascade_multi_df2T_instance_f32 * S,
+                                            float32_t * pSrc, float32_t * pDst, uint32_t blockSize)
+{
+  const uint32_t numCh = S->numChannels, lanes = SIMD_LANES(float32_t);
+  float32_t *pIn = pSrc, *pState = S->pState, *pCoeffs = S->pCoeffs;
+  simd_f b0, b1, b2, a1, a2, x, y, d1, d2, xb, yb, d1b, d2b;
+  float32_t xs, ys, d1s, d2s;
+  uint32_t stage, ch, n;
+
+  for (stage = 0u; stage < S->numStages; stage++)
+  {
+    b0 = VF_SET1(pCoeffs[0]);
+    b1 = VF_SET1(pCoeffs[1]);
+    b2 = VF_SET1(pCoeffs[2]);
+    a1 = VF_SET1(pCoeffs[3]);
+    a2 = VF_SET1(pCoeffs[4]);
+
+    for (ch = 0u; (ch + (2u * lanes)) <= numCh; ch += 2u * lanes)
+    {
+      d1 = VF_LOAD(pState + ch);
+      d1b = VF_LOAD(pState + ch + lanes);
+      d2 = VF_LOAD(pState + numCh + ch);
+      d2b = VF_LOAD(pState + numCh + ch + lanes);
+      for (n = 0u; n < blockSize; n++)
+      {
+        x = VF_LOAD(pIn + (n * numCh) + ch);
+        xb = VF_LOAD(pIn + (n * numCh) + ch + lanes);
+        SIMD_DF2T_STEP(x, y, d1, d2);
+        SIMD_DF2T_STEP(xb, yb, d1b, d2b);
+        VF_STORE(pDst + (n * numCh) + ch, y);
+        VF_STORE(pDst + (n * numCh) + ch + lanes, yb);
+      }
+      VF_STORE(pState + ch, d1);
+      VF_STORE(pState + ch + lanes, d1b);
+      VF_STORE(pState + numCh + ch, d2);
+      VF_STORE(pState + numCh + ch + lanes, d2b);
+    }
+
+    for (; (ch + lanes) <= numCh; ch += lanes)
+    {
+      d1 = VF_LOAD(pState + ch);
+      d2 = VF_LOAD(pState + numCh + ch);
+      for (n = 0u; n < blockSize; n++)
+      {
+        x = VF_LOAD(pIn + (n * numCh) + ch);
+        SIMD_DF2T_STEP(x, y, d1, d2);
+        VF_STORE(pDst + (n * numCh) + ch, y);
+      }
+      VF_STORE(pState + ch, d1);
+      VF_STORE(pState + numCh + ch, d2);
+    }
+
+    for (; ch < numCh; ch++)
+    {
+      d1s = pState[ch];
+      d2s = pState[numCh + ch];
+      for (n = 0u; n < blockSize; n++)
+      {
+        xs = pIn[(n * numCh) + ch];
+        ys = (pCoeffs[0] * xs) + d1s;
+        d1s = ((pCoeffs[1] * xs) + (pCoeffs[3] * ys)) + d2s;
+        d2s = (pCoeffs[2] * xs) + (pCoeffs[4] * ys);
+        pDst[(n * numCh) + ch] = ys;
+      }
+      pState[ch] = d1s;
+      pState[numCh + ch] = d2s;
+    }
+
+    /* The current stage input is given as the output to the next stage */
+    pIn = pDst;
+    pCoeffs += 5u;
+    pState += 2u * numCh;
+  }
+}
+
+#undef SIMD_DF2T_STEP
+
+/* ----------------------------------------------------------------------
+*       Block fast math functions
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Lanes of a where mask is set, of b elsewhere, on float lanes.
+ */
+static inline simd_f simd_select_f32(simd_f mask, simd_f a, simd_f b)
+{
+  return VF_OR(VF_AND(mask, a), VF_ANDNOT(mask, b));
+}
+
+/**
+ * @brief  Integer floor of the lanes: truncation, minus 1 where it rounded up.
+ */
+static inline simd_i simd_floor_i32(simd_f x)
+{
+  const simd_i n = VF_CVTT_I32(x);
+
+  return V_ADD32(n, VF_AS_I(VF_CMPLT(x, VF_CVT_F32(n))));
+}
+
+/* Interpolation in sinTable_f32 at x turns plus offset turns */
+static inline simd_f simd_sin_turns_f32(simd_f x, simd_f offset)
+{
+  const simd_f in = VF_ADD(VF_MUL(x, VF_SET1(0.159154943092f)), offset);
+  const simd_f frac = VF_SUB(in, VF_CVT_F32(simd_floor_i32(in)));
+  const simd_f findex = VF_MUL(VF_SET1((float32_t) FAST_MATH_TABLE_SIZE), frac);
+  const simd_i index = VF_CVTT_I32(findex);
+  const simd_f fract = VF_SUB(findex, VF_CVT_F32(index));
+  const simd_i wrapped = V_AND(index, V_SET1_32(FAST_MATH_TABLE_SIZE - 1));
+
+  return VF_ADD(VF_MUL(VF_SUB(VF_SET1(1.0f), fract), simd_gather_f32(sinTable_f32, wrapped)),
+                VF_MUL(fract, simd_gather_f32(sinTable_f32 + 1, wrapped)));
+}
+
+/* x * c + 0 is exact, and -0 lands on the same table entry as +0 */
+static inline simd_f simd_sin_block_f32(simd_f x)
+{
+  return simd_sin_turns_f32(x, VF_SET1(0.0f));
+}
+
+static inline simd_f simd_cos_block_f32(simd_f x)
+{
+  return simd_sin_turns_f32(x, VF_SET1(0.25f));
+}
+
+/* sqrt of the positive lanes, 0 for the others: NaN compares false */
+static inline simd_f simd_sqrt_block_f32(simd_f x)
+{
+  return VF_SQRT(VF_AND(VF_CMPGT(x, VF_SET1(0.0f)), x));
+}
+
+static inline simd_f simd_exp_block_f32(simd_f x)
+{
+  const simd_f hi = VF_SET1(88.7228394f), lo = VF_SET1(-87.3365479f);
+  simd_f in, fn, r, z, y;
+  simd_i n, n1;
+
+  in = simd_select_f32(VF_CMPGT(x, hi), hi, x);
+  in = simd_select_f32(VF_CMPLT(in, lo), lo, in);
+
+  fn = VF_ADD(VF_MUL(in, VF_SET1(1.44269504089f)), VF_SET1(0.5f));
+  n = simd_floor_i32(fn);
+  fn = VF_CVT_F32(n);
+  r = VF_SUB(VF_SUB(in, VF_MUL(fn, VF_SET1(0.693359375f))), VF_MUL(fn, VF_SET1(-2.12194440e-4f)));
+
+  z = VF_MUL(r, r);
+  y = VF_SET1(1.9875691500e-4f);
+  y = VF_ADD(VF_MUL(y, r), VF_SET1(1.3981999507e-3f));
+  y = VF_ADD(VF_MUL(y, r), VF_SET1(8.3334519073e-3f));
+  y = VF_ADD(VF_MUL(y, r), VF_SET1(4.1665795894e-2f));
+  y = VF_ADD(VF_MUL(y, r), VF_SET1(1.6666665459e-1f));
+  y = VF_ADD(VF_MUL(y, r), VF_SET1(5.0000001201e-1f));
+  y = VF_ADD(VF_ADD(VF_MUL(y, z), r), VF_SET1(1.0f));
+
+  n1 = V_SRAI32(n, 1);
+  y = VF_MUL(y, VF_AS_F(V_SLLI32(V_ADD32(n1, V_SET1_32(127)), 23)));
+  y = VF_MUL(y, VF_AS_F(V_SLLI32(V_ADD32(V_SUB32(n, n1), V_SET1_32(127)), 23)));
+
+  y = simd_select_f32(VF_CMPLT(x, lo), VF_SET1(0.0f), y);
+  return simd_select_f32(VF_CMPGT(x, hi), VF_SET1(INFINITY), y);
+}
+
+static inline simd_f simd_log_block_f32(simd_f x)
+{
+  const simd_f small = VF_CMPLT(x, VF_SET1(1.17549435e-38f));
+  simd_f in, u, low, m, fe, z, y;
+  simd_i bits, e;
+
+  in = simd_select_f32(small, VF_MUL(x, VF_SET1(8388608.0f)), x);
+
+  bits = VF_AS_I(in);
+  e = V_SUB32(V_AND(V_SRAI32(bits, 23), V_SET1_32(0xFF)), V_SET1_32(126));
+  e = V_SUB32(e, V_AND(VF_AS_I(small), V_SET1_32(23)));
+  u = VF_AS_F(V_OR(V_AND(bits, V_SET1_32(0x007FFFFF)), V_SET1_32(0x3F000000)));
+  low = VF_CMPLT(u, VF_SET1(0.707106781186547524f));
+  e = V_ADD32(e, VF_AS_I(low));
+  m = simd_select_f32(low, VF_SUB(VF_ADD(u, u), VF_SET1(1.0f)), VF_SUB(u, VF_SET1(1.0f)));
+  fe = VF_CVT_F32(e);
+
+  z = VF_MUL(m, m);
+  y = VF_SET1(7.0376836292e-2f);
+  y = VF_SUB(VF_MUL(y, m), VF_SET1(1.1514610310e-1f));
+  y = VF_ADD(VF_MUL(y, m), VF_SET1(1.1676998740e-1f));
+  y = VF_SUB(VF_MUL(y, m), VF_SET1(1.2420140846e-1f));
+  y = VF_ADD(VF_MUL(y, m), VF_SET1(1.4249322787e-1f));
+  y = VF_SUB(VF_MUL(y, m), VF_SET1(1.6668057665e-1f));
+  y = VF_ADD(VF_MUL(y, m), VF_SET1(2.0000714765e-1f));
+  y = VF_SUB(VF_MUL(y, m), VF_SET1(2.4999993993e-1f));
+  y = VF_ADD(VF_MUL(y, m), VF_SET1(3.3333331174e-1f));
+  y = VF_MUL(VF_MUL(y, m), z);
+
+  y = VF_ADD(y, VF_MUL(fe, VF_SET1(-2.12194440e-4f)));
+  y = VF_SUB(y, VF_MUL(VF_SET1(0.5f), z));
+  y = VF_ADD(VF_ADD(m, y), VF_MUL(fe, VF_SET1(0.693359375f)));
+
+  y = simd_select_f32(VF_CMPLT(x, VF_SET1(INFINITY)), y, x);
+  return simd_select_f32(VF_CMPGT(x, VF_SET1(0.0f)), y,
+                         simd_select_f32(VF_CMPEQ(x, VF_SET1(0.0f)), VF_SET1(-INFINITY), VF_SET1(NAN)));
+}
+
+static inline simd_f simd_atan2_block_f32(simd_f y, simd_f x)
+{
+  const simd_f sign = VF_SET1(-0.0f);
+  const simd_f ax = VF_ANDNOT(sign, x), ay = VF_ANDNOT(sign, y);
+  const simd_f swap = VF_CMPLT(ax, ay);
+  const simd_f both = VF_CMPGT(simd_select_f32(swap, ax, ay), VF_SET1(3.40282347e+38f));
+  const simd_f mx = simd_select_f32(both, VF_SET1(1.0f), simd_select_f32(swap, ay, ax));
+  const simd_f mn = simd_select_f32(both, VF_SET1(1.0f), simd_select_f32(swap, ax, ay));
+  const simd_f big = VF_CMPGT(mn, VF_MUL(VF_SET1(0.414213562373f), mx));
+  simd_f num, den, t, z, r;
+
+  num = simd_select_f32(big, VF_SUB(mn, mx), mn);
+  den = simd_select_f32(big, VF_ADD(mn, mx), mx);
+  den = simd_select_f32(VF_CMPEQ(den, VF_SET1(0.0f)), VF_SET1(1.0f), den);
+  t = VF_DIV(num, den);
+
+  z = VF_MUL(t, t);
+  r = VF_SET1(8.05374449538e-2f);
+  r = VF_SUB(VF_MUL(r, z), VF_SET1(1.38776856032e-1f));
+  r = VF_ADD(VF_MUL(r, z), VF_SET1(1.99777106478e-1f));
+  r = VF_SUB(VF_MUL(r, z), VF_SET1(3.33329491539e-1f));
+  r = VF_ADD(VF_MUL(VF_MUL(r, z), t), t);
+  r = simd_select_f32(big, VF_ADD(r, VF_SET1(0.785398163397f)), r);
+
+  r = simd_select_f32(swap, VF_SUB(VF_SET1(1.57079632679f), r), r);
+  r = simd_select_f32(VF_AS_F(V_SRAI32(VF_AS_I(x), 31)), VF_SUB(VF_SET1(3.14159265359f), r), r);
+
+  return VF_OR(r, VF_AND(y, sign));
+}
+
+/* Kernel of one float vector, with a const source */
+#define SIMD_BLOCK_F32(NAME)                                                           \
+  void SIMD_FN(NAME)(const float32_t * pSrc, float32_t * pDst, uint32_t blockSize)     \
+  {                                                                                    \
+    uint32_t i;                                                                        \
+                                                                                       \
+    for (i = 0u; (i + SIMD_LANES(float32_t)) <= blockSize; i += SIMD_LANES(float32_t)) \
+    {                                                                                  \
+      VF_STORE(pDst + i, simd_##NAME(VF_LOAD(pSrc + i)));                              \
+    }                                                                                  \
+    arm_##NAME##_c(pSrc + i, pDst + i, blockSize - i);                                 \
+  }
+
+SIMD_BLOCK_F32(sin_block_f32)
+SIMD_BLOCK_F32(cos_block_f32)
+SIMD_BLOCK_F32(sqrt_block_f32)
+SIMD_BLOCK_F32(exp_block_f32)
+SIMD_BLOCK_F32(log_block_f32)
+
+void SIMD_FN(atan2_block_f32)(const float32_t * pSrcY, const float32_t * pSrcX, float32_t * pDst,
+                              uint32_t blockSize)
+{
+  uint32_t i;
+
+  for (i = 0u; (i + SIMD_LANES(float32_t)) <= blockSize; i += SIMD_LANES(float32_t))
+  {
+    VF_STORE(pDst + i, simd_atan2_block_f32(VF_LOAD(pSrcY + i), VF_LOAD(pSrcX + i)));
+  }
+  arm_atan2_block_f32_c(pSrcY + i, pSrcX + i, pDst + i, blockSize - i);
+}
+
+#undef SIMD_BLOCK_F32
+
+/* ----------------------------------------------------------------------
+*       Matrix multiplication micro-kernel
+* -------------------------------------------------------------------- */
+
+/* One row of the tile: the broadcast element of A times the two vectors
+ * of the B sliver, added to the accumulators of the row */
+#define SIMD_GEMM_ROW(I, C0, C1)                                            \
+  do                                                                        \
+  {                                                                         \
+    a = VF_SET1(pA[I]);                                                     \
+    C0 = VF_ADD(C0, VF_MUL(a, b0));                                         \
+    C1 = VF_ADD(C1, VF_MUL(a, b1));                                         \
+  } while (0)
+
+/* A 6 x (2 * lanes) tile of C in twelve accumulators, over kc steps of a
+ * packed A sliver (6 values per step) and a packed B sliver (2 * lanes
+ * values per step). Every element adds its products in the order of k,
+ * starting from 0 or from C, as the C kernel of arm_mat_mult_f32() does:
+ * the result is bit-exact with it. */
+void SIMD_FN(mat_kernel_f32)(uint32_t kc, const float32_t * pA, const float32_t * pB,
+                             float32_t * pC, uint32_t ldc, uint32_t accumulate)
+{
+  const uint32_t lanes = SIMD_LANES(float32_t);
+  simd_f c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51, a, b0, b1;
+  uint32_t k;
+
+  if (accumulate != 0u)
+  {
+    c00 = VF_LOAD(pC);                c01 = VF_LOAD(pC + lanes);
+    c10 = VF_LOAD(pC + ldc);          c11 = VF_LOAD(pC + ldc + lanes);
+    c20 = VF_LOAD(pC + 2u * ldc);     c21 = VF_LOAD(pC + 2u * ldc + lanes);
+    c30 = VF_LOAD(pC + 3u * ldc);     c31 = VF_LOAD(pC + 3u * ldc + lanes);
+    c40 = VF_LOAD(pC + 4u * ldc);     c41 = VF_LOAD(pC + 4u * ldc + lanes);
+    c50 = VF_LOAD(pC + 5u * ldc);     c51 = VF_LOAD(pC + 5u * ldc + lanes);
+  }
+  else
+  {
+    c00 = c01 = c10 = c11 = c20 = c21 = VF_SET1(0.0f);
+    c30 = c31 = c40 = c41 = c50 = c51 = VF_SET1(0.0f);
+  }
+
+  for (k = 0u; k < kc; k++)
+  {
+    b0 = VF_LOAD(pB);
+    b1 = VF_LOAD(pB + lanes);
+    SIMD_GEMM_ROW(0, c00, c01);
+    SIMD_GEMM_ROW(1, c10, c11);
+    SIMD_GEMM_ROW(2, c20, c21);
+    SIMD_GEMM_ROW(3, c30, c31);
+    SIMD_GEMM_ROW(4, c40, c41);
+    SIMD_GEMM_ROW(5, c50, c51);
+    pA += 6u;
+    pB += 2u * lanes;
+  }
+
+  VF_STORE(pC, c00);                  VF_STORE(pC + lanes, c01);
+  VF_STORE(pC + ldc, c10);            VF_STORE(pC + ldc + lanes, c11);
+  VF_STORE(pC + 2u * ldc, c20);       VF_STORE(pC + 2u * ldc + lanes, c21);
+  VF_STORE(pC + 3u * ldc, c30);       VF_STORE(pC + 3u * ldc + lanes, c31);
+  VF_STORE(pC + 4u * ldc, c40);       VF_STORE(pC + 4u * ldc + lanes, c41);
+  VF_STORE(pC + 5u * ldc, c50);       VF_STORE(pC + 5u * ldc + lanes, c51);
+}
+
+#undef SIMD_GEMM_ROW
@@ -0,0 +1,133 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_host_simd_sse2.c
+*
+* Description:  SSE2 kernels of the x86 SIMD backend of the
+*               BasicMathFunctions, of the multi-channel Biquad cascade
+*               and of the block fast math functions: 128-bit vectors,
+*               compiled with -msse2.
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+#include <emmintrin.h>
+
+#include "arm_host_simd.h"
+#include "arm_host_matrix.h"
+#include "arm_common_tables.h"
+
+#define SIMD_FN(NAME)           arm_##NAME##_sse2
+#define SIMD_BYTES              16u
+
+typedef __m128i simd_i;
+typedef __m128  simd_f;
+
+#define V_LOAD(p)               _mm_loadu_si128((const __m128i *)(p))
+#define V_STORE(p, x)           _mm_storeu_si128((__m128i *)(p), (x))
+#define V_ZERO()                _mm_setzero_si128()
+#define V_SET1_8(x)             _mm_set1_epi8(x)
+#define V_SET1_16(x)            _mm_set1_epi16(x)
+#define V_SET1_32(x)            _mm_set1_epi32(x)
+
+#define V_AND(a, b)             _mm_and_si128((a), (b))
+#define V_ANDNOT(a, b)          _mm_andnot_si128((a), (b))
+#define V_OR(a, b)              _mm_or_si128((a), (b))
+#define V_XOR(a, b)             _mm_xor_si128((a), (b))
+
+#define V_ADDS8(a, b)           _mm_adds_epi8((a), (b))
+#define V_SUBS8(a, b)           _mm_subs_epi8((a), (b))
+#define V_ADDS16(a, b)          _mm_adds_epi16((a), (b))
+#define V_SUBS16(a, b)          _mm_subs_epi16((a), (b))
+#define V_ADD32(a, b)           _mm_add_epi32((a), (b))
+#define V_SUB32(a, b)           _mm_sub_epi32((a), (b))
+#define V_ADD64(a, b)           _mm_add_epi64((a), (b))
+
+#define V_CMPGT8(a, b)          _mm_cmpgt_epi8((a), (b))
+#define V_CMPEQ16(a, b)         _mm_cmpeq_epi16((a), (b))
+#define V_CMPEQ32(a, b)         _mm_cmpeq_epi32((a), (b))
+
+#define V_SRAI16(x, n)          _mm_srai_epi16((x), (n))
+#define V_SRAI32(x, n)          _mm_srai_epi32((x), (n))
+#define V_SLLI32(x, n)          _mm_slli_epi32((x), (n))
+#define V_SRLI32(x, n)          _mm_srli_epi32((x), (n))
+#define V_SLLI64(x, n)          _mm_slli_epi64((x), (n))
+#define V_SRLI64(x, n)          _mm_srli_epi64((x), (n))
+#define V_SLL16(x, c)           _mm_sll_epi16((x), (c))
+#define V_SRA16(x, c)           _mm_sra_epi16((x), (c))
+#define V_SLL32(x, c)           _mm_sll_epi32((x), (c))
+#define V_SRA32(x, c)           _mm_sra_epi32((x), (c))
+
+#define V_MULLO16(a, b)         _mm_mullo_epi16((a), (b))
+#define V_MULHI16(a, b)         _mm_mulhi_epi16((a), (b))
+#define V_MADD16(a, b)          _mm_madd_epi16((a), (b))
+#define V_MUL_EPU32(a, b)       _mm_mul_epu32((a), (b))
+
+#define V_SHUFFLE32(x, imm)     _mm_shuffle_epi32((x), (imm))
+#define V_UNPACKLO8(a, b)       _mm_unpacklo_epi8((a), (b))
+#define V_UNPACKHI8(a, b)       _mm_unpackhi_epi8((a), (b))
+#define V_UNPACKLO16(a, b)      _mm_unpacklo_epi16((a), (b))
+#define V_UNPACKHI16(a, b)      _mm_unpackhi_epi16((a), (b))
+#define V_UNPACKLO32(a, b)      _mm_unpacklo_epi32((a), (b))
+#define V_UNPACKHI32(a, b)      _mm_unpackhi_epi32((a), (b))
+#define V_PACKS16(a, b)         _mm_packs_epi16((a), (b))
+#define V_PACKS32(a, b)         _mm_packs_epi32((a), (b))
+
+#define VF_LOAD(p)              _mm_loadu_ps(p)
+#define VF_STORE(p, x)          _mm_storeu_ps((p), (x))
+#define VF_SET1(x)              _mm_set1_ps(x)
+#define VF_ADD(a, b)            _mm_add_ps((a), (b))
+#define VF_SUB(a, b)            _mm_sub_ps((a), (b))
+#define VF_MUL(a, b)            _mm_mul_ps((a), (b))
+#define VF_XOR(a, b)            _mm_xor_ps((a), (b))
+#define VF_ANDNOT(a, b)         _mm_andnot_ps((a), (b))
+#define VF_AND(a, b)            _mm_and_ps((a), (b))
+#define VF_OR(a, b)             _mm_or_ps((a), (b))
+#define VF_DIV(a, b)            _mm_div_ps((a), (b))
+#define VF_SQRT(x)              _mm_sqrt_ps(x)
+#define VF_CMPLT(a, b)          _mm_cmplt_ps((a), (b))
+#define VF_CMPGT(a, b)          _mm_cmpgt_ps((a), (b))
+#define VF_CMPEQ(a, b)          _mm_cmpeq_ps((a), (b))
+#define VF_CVTT_I32(x)          _mm_cvttps_epi32(x)
+#define VF_CVT_F32(x)           _mm_cvtepi32_ps(x)
+#define VF_AS_I(x)              _mm_castps_si128(x)
+#define VF_AS_F(x)              _mm_castsi128_ps(x)
+
+/**
+ * @brief  Sums of the lanes of an accumulator.
+ */
+static inline float32_t simd_hsum_f32(simd_f x)
+{
+  x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+  x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+
+  return _mm_cvtss_f32(x);
+}
+
+/**
+ * @brief  Table values at the indices of the lanes: SSE2 has no gather.
+ */
+static inline simd_f simd_gather_f32(const float32_t * pTable, simd_i index)
+{
+  int32_t lanes[4];
+
+  _mm_storeu_si128((__m128i *)lanes, index);
+  return _mm_setr_ps(pTable[lanes[0]], pTable[lanes[1]], pTable[lanes[2]], pTable[lanes[3]]);
+}
+
+static inline int64_t simd_hsum_i64(simd_i x)
+{
+  int64_t lanes[2];
+
+  _mm_storeu_si128((__m128i *)lanes, x);
+  return (int64_t)((uint64_t)lanes[0] + (uint64_t)lanes[1]);
+}
+
+static inline int32_t simd_hsum_i32(simd_i x)
+{
+  x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+  x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  return _mm_cvtsi128_si32(x);
+}
+
+#include "arm_host_simd_kernels.h"
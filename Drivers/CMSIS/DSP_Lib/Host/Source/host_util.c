@@ -0,0 +1,420 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        host_util.c
+*
+* Description:  Helpers shared by the host benchmark suite and the golden
+*               checks.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "host_util.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+#define HOST_BENCH_REPEATS      9u        /* timed repetitions, median reported */
+#define HOST_BENCH_MIN_TIME     2.0e-3    /* s, minimum duration of a repetition */
+#define HOST_SNR_EXACT          300.0     /* dB reported for an exact result */
+
+static uint32_t hostRandom = 0x12345678u;
+static const char *hostFilter = NULL;
+static int hostCsv = 0;
+static uint32_t hostPassed = 0u;
+static uint32_t hostFailed = 0u;
+
+/* ----------------------------------------------------------------------
+*       Timing
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Reads the cycle counter: the time stamp counter on x86, the
+ *         virtual counter on AArch64, nanoseconds elsewhere.
+ * @return counter value
+ */
+uint64_t host_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  uint64_t t;
+
+  _mm_lfence();
+  t = __rdtsc();
+  _mm_lfence();
+  return t;
+#elif defined(__aarch64__)
+  uint64_t t;
+
+  __asm__ volatile ("isb; mrs %0, cntvct_el0" : "=r" (t));
+  return t;
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief  Name of the unit counted by host_cycles().
+ */
+const char *host_cycle_unit(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return "cycles";
+#elif defined(__aarch64__)
+  return "ticks";
+#else
+  return "ns";
+#endif
+}
+
+/**
+ * @brief  Monotonic wall clock.
+ * @return seconds
+ */
+double host_seconds(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+/* ----------------------------------------------------------------------
+*       Test signals
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Restarts the test signal generator, so that every suite sees the
+ *         same data whatever ran before.
+ */
+void host_seed(uint32_t seed)
+{
+  hostRandom = (seed != 0u) ? seed : 0x12345678u;
+}
+
+/**
+ * @brief  Uniform random value (xorshift32).
+ * @return value in [-1, 1)
+ */
+double host_uniform(void)
+{
+  hostRandom ^= hostRandom << 13;
+  hostRandom ^= hostRandom >> 17;
+  hostRandom ^= hostRandom << 5;
+
+  return ((double)hostRandom / 2147483648.0) - 1.0;
+}
+
+/**
+ * @brief  Fills a buffer with uniform noise in [-amplitude, amplitude).
+ */
+void host_signal(double *pDst, uint32_t n, double amplitude)
+{
+  uint32_t i;
+
+  for (i = 0u; i < n; i++)
+  {
+    pDst[i] = amplitude * host_uniform();
+  }
+}
+
+void host_to_f32(const double *pSrc, float32_t *pDst, uint32_t n)
+{
+  uint32_t i;
+
+  for (i = 0u; i < n; i++)
+  {
+    pDst[i] = (float32_t)pSrc[i];
+  }
+}
+
+/**
+ * @brief  Rounds to Q31, saturated. The references are computed from the
+ *         quantized values, read back with the host_snr_q31() scaling.
+ */
+void host_to_q31(const double *pSrc, q31_t *pDst, uint32_t n)
+{
+  uint32_t i;
+  double v;
+
+  for (i = 0u; i < n; i++)
+  {
+    v = floor(pSrc[i] * 2147483648.0 + 0.5);
+    pDst[i] = (v >= 2147483647.0) ? 0x7FFFFFFF : ((v <= -2147483648.0) ? (q31_t)0x80000000 : (q31_t)v);
+  }
+}
+
+void host_to_q15(const double *pSrc, q15_t *pDst, uint32_t n)
+{
+  uint32_t i;
+  double v;
+
+  for (i = 0u; i < n; i++)
+  {
+    v = floor(pSrc[i] * 32768.0 + 0.5);
+    pDst[i] = (v >= 32767.0) ? 0x7FFF : ((v <= -32768.0) ? (q15_t)0x8000 : (q15_t)v);
+  }
+}
+
+void host_to_q7(const double *pSrc, q7_t *pDst, uint32_t n)
+{
+  uint32_t i;
+  double v;
+
+  for (i = 0u; i < n; i++)
+  {
+    v = floor(pSrc[i] * 128.0 + 0.5);
+    pDst[i] = (v >= 127.0) ? 0x7F : ((v <= -128.0) ? (q7_t)0x80 : (q7_t)v);
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Error measures
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Signal to noise ratio of a result against its reference.
+ * @return dB, HOST_SNR_EXACT for an exact result, -HOST_SNR_EXACT if
+ *         the result holds a NaN or an infinity
+ */
+static double host_snr(double signal, double noise)
+{
+  if (!(noise == noise) || (noise > 1.0e300))
+  {
+    return -HOST_SNR_EXACT;
+  }
+  if (noise == 0.0)
+  {
+    return HOST_SNR_EXACT;
+  }
+  if (signal == 0.0)
+  {
+    return -HOST_SNR_EXACT;
+  }
+
+  return 10.0 * log10(signal / noise);
+}
+
+#define HOST_SNR_BODY(EXPR)                                    \
+  double signal = 0.0, noise = 0.0, d;                         \
+  uint32_t i;                                                  \
+  for (i = 0u; i < n; i++)                                     \
+  {                                                            \
+    d = pRef[i] - (EXPR);                                      \
+    signal += pRef[i] * pRef[i];                               \
+    noise += d * d;                                            \
+  }                                                            \
+  return host_snr(signal, noise)
+
+double host_snr_f32(const double *pRef, const float32_t *pTest, uint32_t n)
+{
+  HOST_SNR_BODY((double)pTest[i]);
+}
+
+double host_snr_f64(const double *pRef, const float64_t *pTest, uint32_t n)
+{
+  HOST_SNR_BODY(pTest[i]);
+}
+
+/**
+ * @brief  SNR of a fixed-point result, read as pTest[i] * scale / 2^31.
+ */
+double host_snr_q31(const double *pRef, const q31_t *pTest, uint32_t n, double scale)
+{
+  HOST_SNR_BODY((double)pTest[i] * scale / 2147483648.0);
+}
+
+double host_snr_q15(const double *pRef, const q15_t *pTest, uint32_t n, double scale)
+{
+  HOST_SNR_BODY((double)pTest[i] * scale / 32768.0);
+}
+
+double host_snr_q7(const double *pRef, const q7_t *pTest, uint32_t n, double scale)
+{
+  HOST_SNR_BODY((double)pTest[i] * scale / 128.0);
+}
+
+/* ----------------------------------------------------------------------
+*       Reporting
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Restricts the runs to the names containing pattern, NULL for all.
+ */
+void host_set_filter(const char *pattern)
+{
+  hostFilter = pattern;
+}
+
+int host_selected(const char *name)
+{
+  return (hostFilter == NULL) || (strstr(name, hostFilter) != NULL);
+}
+
+void host_set_csv(int enable)
+{
+  hostCsv = enable;
+
+  if (hostCsv != 0)
+  {
+    printf("kernel,size,%s_per_call,%s_per_sample,samples_per_%s,msamples_per_s\n",
+           host_cycle_unit(), host_cycle_unit(), host_cycle_unit());
+  }
+  else
+  {
+    printf("%-28s %6s %14s %10s %10s %10s\n", "kernel", "size", host_cycle_unit(),
+           "per smp", "smp/cyc", "Msmp/s");
+  }
+}
+
+int host_csv(void)
+{
+  return hostCsv;
+}
+
+static int host_compare_u64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief  Times a kernel and prints its throughput.
+ * @param[in] name     kernel name, matched against the filter
+ * @param[in] size     block size shown in the report
+ * @param[in] samples  output samples produced by one call
+ * @param[in] kernel   kernel wrapper
+ * @param[in] ctx      kernel arguments
+ * @return mean seconds per call, or 0 if the filter skipped the kernel
+ * @note   Each repetition runs the kernel enough times to last at least
+ *         HOST_BENCH_MIN_TIME; the median repetition is reported, which
+ *         is robust to interrupts and frequency changes.
+ */
+double host_bench(const char *name, uint32_t size, uint32_t samples, host_kernel_t kernel, void *ctx)
+{
+  uint64_t ticks[HOST_BENCH_REPEATS], start;
+  uint32_t calls = 1u, i, r;
+  double t0, seconds = 0.0, perCall, perSample;
+
+  if (!host_selected(name))
+  {
+    return 0.0;
+  }
+
+  /* Warm the caches and size the repetitions */
+  for (;;)
+  {
+    t0 = host_seconds();
+    for (i = 0u; i < calls; i++)
+    {
+      kernel(ctx);
+    }
+    if (((host_seconds() - t0) >= HOST_BENCH_MIN_TIME) || (calls >= (1u << 30)))
+    {
+      break;
+    }
+    calls <<= 1;
+  }
+
+  for (r = 0u; r < HOST_BENCH_REPEATS; r++)
+  {
+    t0 = host_seconds();
+    start = host_cycles();
+    for (i = 0u; i < calls; i++)
+    {
+      kernel(ctx);
+    }
+    ticks[r] = host_cycles() - start;
+    seconds += host_seconds() - t0;
+  }
+
+  qsort(ticks, HOST_BENCH_REPEATS, sizeof(ticks[0]), host_compare_u64);
+  perCall = (double)ticks[HOST_BENCH_REPEATS / 2u] / (double)calls;
+  perSample = perCall / (double)samples;
+  seconds /= (double)HOST_BENCH_REPEATS * (double)calls;
+
+  if (hostCsv != 0)
+  {
+    printf("%s,%u,%.1f,%.3f,%.4f,%.2f\n", name, size, perCall, perSample, 1.0 / perSample,
+           (double)samples / seconds * 1.0e-6);
+  }
+  else
+  {
+    printf("%-28s %6u %14.1f %10.3f %10.4f %10.2f\n", name, size, perCall, perSample,
+           1.0 / perSample, (double)samples / seconds * 1.0e-6);
+  }
+  fflush(stdout);
+
+  return seconds;
+}
+
+/**
+ * @brief  Reports a result checked against its reference.
+ * @return 0 if snr reaches minSnr, 1 otherwise
+ */
+int host_check_snr(const char *name, uint32_t size, double snr, double minSnr)
+{
+  int failed = !(snr >= minSnr);
+
+  if (!host_selected(name))
+  {
+    return 0;
+  }
+
+  printf("%s %-28s %6u  SNR %7.2f dB (min %6.2f)\n", failed ? "FAIL" : "pass", name, size, snr, minSnr);
+  if (failed)
+  {
+    hostFailed++;
+  }
+  else
+  {
+    hostPassed++;
+  }
+
+  return failed;
+}
+
+/**
+ * @brief  Reports a result that must match its reference exactly.
+ * @return 0 if there is no mismatch, 1 otherwise
+ */
+int host_check_equal(const char *name, uint32_t size, uint32_t mismatches)
+{
+  int failed = (mismatches != 0u);
+
+  if (!host_selected(name))
+  {
+    return 0;
+  }
+
+  printf("%s %-28s %6u  %u mismatch(es)\n", failed ? "FAIL" : "pass", name, size, mismatches);
+  if (failed)
+  {
+    hostFailed++;
+  }
+  else
+  {
+    hostPassed++;
+  }
+
+  return failed;
+}
+
+void host_check_summary(uint32_t *pPassed, uint32_t *pFailed)
+{
+  *pPassed = hostPassed;
+  *pFailed = hostFailed;
+}
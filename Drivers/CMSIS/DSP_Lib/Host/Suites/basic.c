@@ -0,0 +1,290 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        basic.c
+*
+* Description:  Host benchmarks and golden checks of the basic math
+*               functions.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+
+#include "host_suites.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+#define BASIC_SCALE             0.75      /* scale factor of the scale kernels */
+#define BASIC_OFFSET            0.375     /* offset of the offset kernels */
+#define BASIC_SHIFT             1         /* shift of the shift and scale kernels */
+
+static double    refA[HOST_MAX_SAMPLES], refB[HOST_MAX_SAMPLES], refOut[HOST_MAX_SAMPLES];
+static float32_t aF32[HOST_MAX_SAMPLES], bF32[HOST_MAX_SAMPLES], outF32[HOST_MAX_SAMPLES];
+static q31_t     aQ31[HOST_MAX_SAMPLES], bQ31[HOST_MAX_SAMPLES], outQ31[HOST_MAX_SAMPLES];
+static q15_t     aQ15[HOST_MAX_SAMPLES], bQ15[HOST_MAX_SAMPLES], outQ15[HOST_MAX_SAMPLES];
+static q7_t      aQ7[HOST_MAX_SAMPLES], bQ7[HOST_MAX_SAMPLES], outQ7[HOST_MAX_SAMPLES];
+
+/**
+ * @brief  Operands spanning the whole range, with the extreme values of
+ *         the Q formats in the first samples so that every saturation
+ *         path is taken.
+ */
+static void basic_operands(uint32_t n)
+{
+  static const double extremes[] = { -1.0, -1.0, 0.999, -1.0, 0.999, 0.999 };
+  uint32_t i;
+
+  host_signal(refA, n, 0.999);
+  host_signal(refB, n, 0.999);
+  for (i = 0u; (i < (sizeof(extremes) / sizeof(extremes[0]))) && (i < n); i += 2u)
+  {
+    refA[i] = extremes[i];
+    refB[i] = extremes[i + 1u];
+  }
+
+  host_to_f32(refA, aF32, n);
+  host_to_f32(refB, bF32, n);
+  host_to_q31(refA, aQ31, n);
+  host_to_q31(refB, bQ31, n);
+  host_to_q15(refA, aQ15, n);
+  host_to_q15(refB, bQ15, n);
+  host_to_q7(refA, aQ7, n);
+  host_to_q7(refB, bQ7, n);
+}
+
+/* ----------------------------------------------------------------------
+*       Benchmarks
+* -------------------------------------------------------------------- */
+typedef struct
+{
+  uint32_t n;
+} basic_ctx_t;
+
+#define N (((basic_ctx_t *)p)->n)
+
+static void run_add_f32(void *p)    { arm_add_f32(aF32, bF32, outF32, N); }
+static void run_add_q31(void *p)    { arm_add_q31(aQ31, bQ31, outQ31, N); }
+static void run_add_q15(void *p)    { arm_add_q15(aQ15, bQ15, outQ15, N); }
+static void run_add_q7(void *p)     { arm_add_q7(aQ7, bQ7, outQ7, N); }
+static void run_sub_f32(void *p)    { arm_sub_f32(aF32, bF32, outF32, N); }
+static void run_sub_q31(void *p)    { arm_sub_q31(aQ31, bQ31, outQ31, N); }
+static void run_sub_q15(void *p)    { arm_sub_q15(aQ15, bQ15, outQ15, N); }
+static void run_sub_q7(void *p)     { arm_sub_q7(aQ7, bQ7, outQ7, N); }
+static void run_mult_f32(void *p)   { arm_mult_f32(aF32, bF32, outF32, N); }
+static void run_mult_q31(void *p)   { arm_mult_q31(aQ31, bQ31, outQ31, N); }
+static void run_mult_q15(void *p)   { arm_mult_q15(aQ15, bQ15, outQ15, N); }
+static void run_mult_q7(void *p)    { arm_mult_q7(aQ7, bQ7, outQ7, N); }
+static void run_scale_f32(void *p)  { arm_scale_f32(aF32, 0.75f, outF32, N); }
+static void run_scale_q31(void *p)  { arm_scale_q31(aQ31, 0x60000000, BASIC_SHIFT, outQ31, N); }
+static void run_scale_q15(void *p)  { arm_scale_q15(aQ15, 0x6000, BASIC_SHIFT, outQ15, N); }
+static void run_scale_q7(void *p)   { arm_scale_q7(aQ7, 0x60, BASIC_SHIFT, outQ7, N); }
+static void run_offset_f32(void *p) { arm_offset_f32(aF32, 0.375f, outF32, N); }
+static void run_offset_q31(void *p) { arm_offset_q31(aQ31, 0x30000000, outQ31, N); }
+static void run_offset_q15(void *p) { arm_offset_q15(aQ15, 0x3000, outQ15, N); }
+static void run_offset_q7(void *p)  { arm_offset_q7(aQ7, 0x30, outQ7, N); }
+static void run_shift_q31(void *p)  { arm_shift_q31(aQ31, BASIC_SHIFT, outQ31, N); }
+static void run_shift_q15(void *p)  { arm_shift_q15(aQ15, BASIC_SHIFT, outQ15, N); }
+static void run_shift_q7(void *p)   { arm_shift_q7(aQ7, BASIC_SHIFT, outQ7, N); }
+static void run_negate_f32(void *p) { arm_negate_f32(aF32, outF32, N); }
+static void run_negate_q31(void *p) { arm_negate_q31(aQ31, outQ31, N); }
+static void run_negate_q15(void *p) { arm_negate_q15(aQ15, outQ15, N); }
+static void run_negate_q7(void *p)  { arm_negate_q7(aQ7, outQ7, N); }
+static void run_abs_f32(void *p)    { arm_abs_f32(aF32, outF32, N); }
+static void run_abs_q31(void *p)    { arm_abs_q31(aQ31, outQ31, N); }
+static void run_abs_q15(void *p)    { arm_abs_q15(aQ15, outQ15, N); }
+static void run_abs_q7(void *p)     { arm_abs_q7(aQ7, outQ7, N); }
+static void run_dot_prod_f32(void *p) { static float32_t r; arm_dot_prod_f32(aF32, bF32, N, &r); }
+static void run_dot_prod_q31(void *p) { static q63_t r; arm_dot_prod_q31(aQ31, bQ31, N, &r); }
+static void run_dot_prod_q15(void *p) { static q63_t r; arm_dot_prod_q15(aQ15, bQ15, N, &r); }
+static void run_dot_prod_q7(void *p)  { static q31_t r; arm_dot_prod_q7(aQ7, bQ7, N, &r); }
+
+#undef N
+
+void bench_basic(void)
+{
+  static const struct
+  {
+    const char *name;
+    host_kernel_t run;
+  } kernels[] =
+  {
+    { "add_f32", run_add_f32 },       { "add_q31", run_add_q31 },       { "add_q15", run_add_q15 },
+    { "add_q7", run_add_q7 },         { "sub_f32", run_sub_f32 },       { "sub_q31", run_sub_q31 },
+    { "sub_q15", run_sub_q15 },       { "sub_q7", run_sub_q7 },         { "mult_f32", run_mult_f32 },
+    { "mult_q31", run_mult_q31 },     { "mult_q15", run_mult_q15 },     { "mult_q7", run_mult_q7 },
+    { "scale_f32", run_scale_f32 },   { "scale_q31", run_scale_q31 },   { "scale_q15", run_scale_q15 },
+    { "scale_q7", run_scale_q7 },     { "offset_f32", run_offset_f32 }, { "offset_q31", run_offset_q31 },
+    { "offset_q15", run_offset_q15 }, { "offset_q7", run_offset_q7 },   { "shift_q31", run_shift_q31 },
+    { "shift_q15", run_shift_q15 },   { "shift_q7", run_shift_q7 },     { "negate_f32", run_negate_f32 },
+    { "negate_q31", run_negate_q31 }, { "negate_q15", run_negate_q15 }, { "negate_q7", run_negate_q7 },
+    { "abs_f32", run_abs_f32 },       { "abs_q31", run_abs_q31 },       { "abs_q15", run_abs_q15 },
+    { "abs_q7", run_abs_q7 },         { "dot_prod_f32", run_dot_prod_f32 }, { "dot_prod_q31", run_dot_prod_q31 },
+    { "dot_prod_q15", run_dot_prod_q15 }, { "dot_prod_q7", run_dot_prod_q7 }
+  };
+  static const uint32_t sizes[] = { 64u, 256u, 1024u, 4096u };
+  basic_ctx_t c;
+  uint32_t k, s;
+
+  basic_operands(HOST_MAX_SAMPLES);
+
+  for (k = 0u; k < (sizeof(kernels) / sizeof(kernels[0])); k++)
+  {
+    for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+    {
+      c.n = sizes[s];
+      host_bench(kernels[k].name, c.n, c.n, kernels[k].run, &c);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Golden checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Element-wise operations of the reference.
+ */
+typedef enum
+{
+  BASIC_ADD, BASIC_SUB, BASIC_MULT, BASIC_SCALE_OP, BASIC_OFFSET_OP, BASIC_SHIFT_OP, BASIC_NEGATE, BASIC_ABS
+} basic_op_t;
+
+/**
+ * @brief  Double-precision reference of an element-wise operation,
+ *         saturated to [-1, max] as the Q formats do.
+ * @param  max  largest value of the format, 1 for floating point (no
+ *              saturation)
+ */
+static void ref_basic(basic_op_t op, const double *pA, const double *pB, double *pOut, uint32_t n, double max)
+{
+  double v = 0.0;
+  uint32_t i;
+
+  for (i = 0u; i < n; i++)
+  {
+    switch (op)
+    {
+    case BASIC_ADD:       v = pA[i] + pB[i];                           break;
+    case BASIC_SUB:       v = pA[i] - pB[i];                           break;
+    case BASIC_MULT:      v = pA[i] * pB[i];                           break;
+    case BASIC_SCALE_OP:  v = pA[i] * BASIC_SCALE * (1 << BASIC_SHIFT); break;
+    case BASIC_OFFSET_OP: v = pA[i] + BASIC_OFFSET;                    break;
+    case BASIC_SHIFT_OP:  v = pA[i] * (1 << BASIC_SHIFT);              break;
+    case BASIC_NEGATE:    v = -pA[i];                                  break;
+    case BASIC_ABS:       v = fabs(pA[i]);                             break;
+    }
+    if (max < 1.0)
+    {
+      v = (v > max) ? max : ((v < -1.0) ? -1.0 : v);
+    }
+    pOut[i] = v;
+  }
+}
+
+/* Reads the Q operands back into refA and refB */
+#define BASIC_DEQUANTIZE(A, B, SCALE)                                \
+  for (i = 0u; i < n; i++)                                           \
+  {                                                                  \
+    refA[i] = (double)A[i] / (SCALE);                                \
+    refB[i] = (double)B[i] / (SCALE);                                \
+  }
+
+#define BASIC_CHECK(NAME, OP, CALL, SNR_FN, MAX, MIN_SNR)            \
+  ref_basic(OP, refA, refB, refOut, n, MAX);                         \
+  CALL;                                                              \
+  host_check_snr(NAME, n, SNR_FN, MIN_SNR)
+
+static void check_size(uint32_t n)
+{
+  const double maxQ31 = 1.0 - ldexp(1.0, -31), maxQ15 = 1.0 - ldexp(1.0, -15), maxQ7 = 1.0 - ldexp(1.0, -7);
+  double dot, test;
+  float32_t rF32;
+  q63_t rQ63;
+  q31_t rQ31;
+  uint32_t i;
+
+  basic_operands(n);
+
+  for (i = 0u; i < n; i++)
+  {
+    refA[i] = (double)aF32[i];
+    refB[i] = (double)bF32[i];
+  }
+  BASIC_CHECK("add_f32", BASIC_ADD, arm_add_f32(aF32, bF32, outF32, n), host_snr_f32(refOut, outF32, n), 1.0, 140.0);
+  BASIC_CHECK("sub_f32", BASIC_SUB, arm_sub_f32(aF32, bF32, outF32, n), host_snr_f32(refOut, outF32, n), 1.0, 140.0);
+  BASIC_CHECK("mult_f32", BASIC_MULT, arm_mult_f32(aF32, bF32, outF32, n), host_snr_f32(refOut, outF32, n), 1.0, 140.0);
+  BASIC_CHECK("scale_f32", BASIC_SCALE_OP, arm_scale_f32(aF32, 1.5f, outF32, n), host_snr_f32(refOut, outF32, n), 1.0, 140.0);
+  BASIC_CHECK("offset_f32", BASIC_OFFSET_OP, arm_offset_f32(aF32, 0.375f, outF32, n), host_snr_f32(refOut, outF32, n), 1.0, 140.0);
+  BASIC_CHECK("negate_f32", BASIC_NEGATE, arm_negate_f32(aF32, outF32, n), host_snr_f32(refOut, outF32, n), 1.0, 300.0);
+  BASIC_CHECK("abs_f32", BASIC_ABS, arm_abs_f32(aF32, outF32, n), host_snr_f32(refOut, outF32, n), 1.0, 300.0);
+  for (i = 0u, dot = 0.0; i < n; i++)
+  {
+    dot += refA[i] * refB[i];
+  }
+  arm_dot_prod_f32(aF32, bF32, n, &rF32);
+  test = rF32;
+  host_check_snr("dot_prod_f32", n, host_snr_f64(&dot, &test, 1u), 85.0);
+
+  BASIC_DEQUANTIZE(aQ31, bQ31, 2147483648.0);
+  BASIC_CHECK("add_q31", BASIC_ADD, arm_add_q31(aQ31, bQ31, outQ31, n), host_snr_q31(refOut, outQ31, n, 1.0), maxQ31, 300.0);
+  BASIC_CHECK("sub_q31", BASIC_SUB, arm_sub_q31(aQ31, bQ31, outQ31, n), host_snr_q31(refOut, outQ31, n, 1.0), maxQ31, 300.0);
+  BASIC_CHECK("mult_q31", BASIC_MULT, arm_mult_q31(aQ31, bQ31, outQ31, n), host_snr_q31(refOut, outQ31, n, 1.0), maxQ31, 170.0);
+  BASIC_CHECK("scale_q31", BASIC_SCALE_OP, arm_scale_q31(aQ31, 0x60000000, BASIC_SHIFT, outQ31, n), host_snr_q31(refOut, outQ31, n, 1.0), maxQ31, 170.0);
+  BASIC_CHECK("offset_q31", BASIC_OFFSET_OP, arm_offset_q31(aQ31, 0x30000000, outQ31, n), host_snr_q31(refOut, outQ31, n, 1.0), maxQ31, 300.0);
+  BASIC_CHECK("shift_q31", BASIC_SHIFT_OP, arm_shift_q31(aQ31, BASIC_SHIFT, outQ31, n), host_snr_q31(refOut, outQ31, n, 1.0), maxQ31, 300.0);
+  BASIC_CHECK("negate_q31", BASIC_NEGATE, arm_negate_q31(aQ31, outQ31, n), host_snr_q31(refOut, outQ31, n, 1.0), maxQ31, 180.0);
+  BASIC_CHECK("abs_q31", BASIC_ABS, arm_abs_q31(aQ31, outQ31, n), host_snr_q31(refOut, outQ31, n, 1.0), maxQ31, 180.0);
+  for (i = 0u, dot = 0.0; i < n; i++)
+  {
+    dot += refA[i] * refB[i];
+  }
+  arm_dot_prod_q31(aQ31, bQ31, n, &rQ63);
+  test = (double)rQ63 / 281474976710656.0;
+  host_check_snr("dot_prod_q31", n, host_snr_f64(&dot, &test, 1u), 120.0);
+
+  BASIC_DEQUANTIZE(aQ15, bQ15, 32768.0);
+  BASIC_CHECK("add_q15", BASIC_ADD, arm_add_q15(aQ15, bQ15, outQ15, n), host_snr_q15(refOut, outQ15, n, 1.0), maxQ15, 300.0);
+  BASIC_CHECK("sub_q15", BASIC_SUB, arm_sub_q15(aQ15, bQ15, outQ15, n), host_snr_q15(refOut, outQ15, n, 1.0), maxQ15, 300.0);
+  BASIC_CHECK("mult_q15", BASIC_MULT, arm_mult_q15(aQ15, bQ15, outQ15, n), host_snr_q15(refOut, outQ15, n, 1.0), maxQ15, 85.0);
+  BASIC_CHECK("scale_q15", BASIC_SCALE_OP, arm_scale_q15(aQ15, 0x6000, BASIC_SHIFT, outQ15, n), host_snr_q15(refOut, outQ15, n, 1.0), maxQ15, 85.0);
+  BASIC_CHECK("offset_q15", BASIC_OFFSET_OP, arm_offset_q15(aQ15, 0x3000, outQ15, n), host_snr_q15(refOut, outQ15, n, 1.0), maxQ15, 300.0);
+  BASIC_CHECK("shift_q15", BASIC_SHIFT_OP, arm_shift_q15(aQ15, BASIC_SHIFT, outQ15, n), host_snr_q15(refOut, outQ15, n, 1.0), maxQ15, 300.0);
+  BASIC_CHECK("negate_q15", BASIC_NEGATE, arm_negate_q15(aQ15, outQ15, n), host_snr_q15(refOut, outQ15, n, 1.0), maxQ15, 85.0);
+  BASIC_CHECK("abs_q15", BASIC_ABS, arm_abs_q15(aQ15, outQ15, n), host_snr_q15(refOut, outQ15, n, 1.0), maxQ15, 85.0);
+  for (i = 0u, dot = 0.0; i < n; i++)
+  {
+    dot += refA[i] * refB[i];
+  }
+  arm_dot_prod_q15(aQ15, bQ15, n, &rQ63);
+  test = (double)rQ63 / 1073741824.0;
+  host_check_snr("dot_prod_q15", n, host_snr_f64(&dot, &test, 1u), 300.0);
+
+  BASIC_DEQUANTIZE(aQ7, bQ7, 128.0);
+  BASIC_CHECK("add_q7", BASIC_ADD, arm_add_q7(aQ7, bQ7, outQ7, n), host_snr_q7(refOut, outQ7, n, 1.0), maxQ7, 300.0);
+  BASIC_CHECK("sub_q7", BASIC_SUB, arm_sub_q7(aQ7, bQ7, outQ7, n), host_snr_q7(refOut, outQ7, n, 1.0), maxQ7, 300.0);
+  BASIC_CHECK("mult_q7", BASIC_MULT, arm_mult_q7(aQ7, bQ7, outQ7, n), host_snr_q7(refOut, outQ7, n, 1.0), maxQ7, 35.0);
+  BASIC_CHECK("scale_q7", BASIC_SCALE_OP, arm_scale_q7(aQ7, 0x60, BASIC_SHIFT, outQ7, n), host_snr_q7(refOut, outQ7, n, 1.0), maxQ7, 35.0);
+  BASIC_CHECK("offset_q7", BASIC_OFFSET_OP, arm_offset_q7(aQ7, 0x30, outQ7, n), host_snr_q7(refOut, outQ7, n, 1.0), maxQ7, 300.0);
+  BASIC_CHECK("shift_q7", BASIC_SHIFT_OP, arm_shift_q7(aQ7, BASIC_SHIFT, outQ7, n), host_snr_q7(refOut, outQ7, n, 1.0), maxQ7, 300.0);
+  BASIC_CHECK("negate_q7", BASIC_NEGATE, arm_negate_q7(aQ7, outQ7, n), host_snr_q7(refOut, outQ7, n, 1.0), maxQ7, 35.0);
+  BASIC_CHECK("abs_q7", BASIC_ABS, arm_abs_q7(aQ7, outQ7, n), host_snr_q7(refOut, outQ7, n, 1.0), maxQ7, 35.0);
+  for (i = 0u, dot = 0.0; i < n; i++)
+  {
+    dot += refA[i] * refB[i];
+  }
+  arm_dot_prod_q7(aQ7, bQ7, n, &rQ31);
+  test = (double)rQ31 / 16384.0;
+  host_check_snr("dot_prod_q7", n, host_snr_f64(&dot, &test, 1u), 300.0);
+}
+
+void check_basic(void)
+{
+  static const uint32_t sizes[] = { 1u, 3u, 4u, 7u, 64u, 1023u };
+  uint32_t s;
+
+  for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+  {
+    check_size(sizes[s]);
+  }
+}
@@ -0,0 +1,322 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        fastmath.c
+*
+* Description:  Host benchmarks of the block fast math functions against
+*               a loop of the scalar functions, and golden checks against
+*               the C library in double precision.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+
+#include "host_suites.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+static double    refIn[HOST_MAX_SAMPLES], refOut[HOST_MAX_SAMPLES];
+static float32_t inF32[HOST_MAX_SAMPLES], in2F32[HOST_MAX_SAMPLES];
+static float32_t outF32[HOST_MAX_SAMPLES];
+
+/**
+ * @brief  Float arguments in [-range, range).
+ */
+static void fastmath_signal(float32_t *pDst, uint32_t n, double range)
+{
+  host_signal(refIn, n, range);
+  host_to_f32(refIn, pDst, n);
+}
+
+/* ----------------------------------------------------------------------
+*       Benchmarks
+* -------------------------------------------------------------------- */
+typedef struct
+{
+  uint32_t n;
+} fastmath_ctx_t;
+
+#define N (((fastmath_ctx_t *)p)->n)
+
+static void run_sin_f32(void *p)
+{
+  uint32_t i;
+
+  for (i = 0u; i < N; i++)
+  {
+    outF32[i] = arm_sin_f32(inF32[i]);
+  }
+}
+
+static void run_cos_f32(void *p)
+{
+  uint32_t i;
+
+  for (i = 0u; i < N; i++)
+  {
+    outF32[i] = arm_cos_f32(inF32[i]);
+  }
+}
+
+static void run_sqrt_f32(void *p)
+{
+  uint32_t i;
+
+  for (i = 0u; i < N; i++)
+  {
+    arm_sqrt_f32(inF32[i], &outF32[i]);
+  }
+}
+
+static void run_expf(void *p)
+{
+  uint32_t i;
+
+  for (i = 0u; i < N; i++)
+  {
+    outF32[i] = expf(inF32[i]);
+  }
+}
+
+static void run_logf(void *p)
+{
+  uint32_t i;
+
+  for (i = 0u; i < N; i++)
+  {
+    outF32[i] = logf(inF32[i]);
+  }
+}
+
+static void run_atan2f(void *p)
+{
+  uint32_t i;
+
+  for (i = 0u; i < N; i++)
+  {
+    outF32[i] = atan2f(inF32[i], in2F32[i]);
+  }
+}
+
+static void run_sin_block_f32(void *p)   { arm_sin_block_f32(inF32, outF32, N); }
+static void run_cos_block_f32(void *p)   { arm_cos_block_f32(inF32, outF32, N); }
+static void run_sqrt_block_f32(void *p)  { arm_sqrt_block_f32(inF32, outF32, N); }
+static void run_exp_block_f32(void *p)   { arm_exp_block_f32(inF32, outF32, N); }
+static void run_log_block_f32(void *p)   { arm_log_block_f32(inF32, outF32, N); }
+static void run_atan2_block_f32(void *p) { arm_atan2_block_f32(inF32, in2F32, outF32, N); }
+
+#undef N
+
+void bench_fastmath(void)
+{
+  static const struct
+  {
+    const char *name;
+    host_kernel_t run;
+  } kernels[] =
+  {
+    { "sin_f32", run_sin_f32 },     { "sin_block_f32", run_sin_block_f32 },
+    { "cos_f32", run_cos_f32 },     { "cos_block_f32", run_cos_block_f32 },
+    { "sqrt_f32", run_sqrt_f32 },   { "sqrt_block_f32", run_sqrt_block_f32 },
+    { "expf", run_expf },           { "exp_block_f32", run_exp_block_f32 },
+    { "logf", run_logf },           { "log_block_f32", run_log_block_f32 },
+    { "atan2f", run_atan2f },       { "atan2_block_f32", run_atan2_block_f32 }
+  };
+  static const uint32_t sizes[] = { 64u, 1024u, 4096u };
+  fastmath_ctx_t c;
+  uint32_t k, s, i;
+
+  /* Positive arguments for sqrt and log, within the range of exp */
+  fastmath_signal(inF32, HOST_MAX_SAMPLES, 80.0);
+  fastmath_signal(in2F32, HOST_MAX_SAMPLES, 1.0);
+  for (i = 0u; i < HOST_MAX_SAMPLES; i++)
+  {
+    inF32[i] = fabsf(inF32[i]);
+  }
+
+  for (k = 0u; k < (sizeof(kernels) / sizeof(kernels[0])); k++)
+  {
+    for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+    {
+      c.n = sizes[s];
+      host_bench(kernels[k].name, c.n, c.n, kernels[k].run, &c);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Golden checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Count of the outputs whose error to the double-precision
+ *         reference exceeds tol, relative to the reference above 1 in
+ *         magnitude and absolute below.
+ */
+static uint32_t fastmath_beyond(const float32_t *pTest, uint32_t n, double tol)
+{
+  uint32_t i, bad = 0u;
+  double scale;
+
+  for (i = 0u; i < n; i++)
+  {
+    scale = (fabs(refOut[i]) > 1.0) ? fabs(refOut[i]) : 1.0;
+    bad += (fabs((double)pTest[i] - refOut[i]) > (tol * scale)) ? 1u : 0u;
+  }
+
+  return bad;
+}
+
+/* Counts the outputs that differ from their reference */
+#define FASTMATH_COUNT(EXPR)                                         \
+  for (i = 0u, bad = 0u; i < n; i++)                                 \
+  {                                                                  \
+    bad += (EXPR) ? 1u : 0u;                                         \
+  }
+
+static void check_size(uint32_t n)
+{
+  uint32_t i, bad;
+
+  /* sin and cos over several periods: the block sine is the scalar one,
+   * and both interpolate the same table */
+  fastmath_signal(inF32, n, 50.0);
+  arm_sin_block_f32(inF32, outF32, n);
+  FASTMATH_COUNT(outF32[i] != arm_sin_f32(inF32[i]));
+  host_check_equal("sin_block_f32/scalar", n, bad);
+  for (i = 0u; i < n; i++)
+  {
+    refOut[i] = sin((double)inF32[i]);
+  }
+  host_check_snr("sin_block_f32", n, host_snr_f32(refOut, outF32, n), 90.0);
+  arm_cos_block_f32(inF32, outF32, n);
+  for (i = 0u; i < n; i++)
+  {
+    refOut[i] = cos((double)inF32[i]);
+  }
+  host_check_snr("cos_block_f32", n, host_snr_f32(refOut, outF32, n), 90.0);
+
+  /* sqrt rounds correctly, and gives 0 below 0 */
+  fastmath_signal(inF32, n, 1000.0);
+  arm_sqrt_block_f32(inF32, outF32, n);
+  FASTMATH_COUNT(outF32[i] != ((inF32[i] > 0.0f) ? (float32_t)sqrt((double)inF32[i]) : 0.0f));
+  host_check_equal("sqrt_block_f32", n, bad);
+
+  /* exp over its whole range of normal results */
+  fastmath_signal(inF32, n, 87.0);
+  arm_exp_block_f32(inF32, outF32, n);
+  for (i = 0u; i < n; i++)
+  {
+    refOut[i] = exp((double)inF32[i]);
+  }
+  host_check_equal("exp_block_f32", n, fastmath_beyond(outF32, n, 3.0e-7));
+
+  /* log over the exponents of the normal floats, from exp of the signal */
+  fastmath_signal(in2F32, n, 87.0);
+  for (i = 0u; i < n; i++)
+  {
+    inF32[i] = (float32_t)exp((double)in2F32[i]);
+    refOut[i] = log((double)inF32[i]);
+  }
+  arm_log_block_f32(inF32, outF32, n);
+  host_check_equal("log_block_f32", n, fastmath_beyond(outF32, n, 3.0e-7));
+
+  /* atan2 in the four quadrants */
+  fastmath_signal(inF32, n, 1.0);
+  fastmath_signal(in2F32, n, 1.0);
+  for (i = 0u; i < n; i++)
+  {
+    refOut[i] = atan2((double)inF32[i], (double)in2F32[i]);
+  }
+  arm_atan2_block_f32(inF32, in2F32, outF32, n);
+  host_check_equal("atan2_block_f32", n, fastmath_beyond(outF32, n, 3.0e-7));
+}
+
+/**
+ * @brief  Zeros, denormals, infinities, NaN and the boundaries of the
+ *         ranges, against the C library.
+ */
+static void check_special(void)
+{
+  static const float32_t args[] =
+  {
+    0.0f, -0.0f, 1.0e-45f, 1.0e-40f, 1.17549435e-38f, 1.0f, -1.0f, 2.0f, 0.5f,
+    88.7228394f, 88.8f, -87.3365479f, -87.5f, -103.0f, 1.0e30f, -1.0e30f,
+    INFINITY, -INFINITY, NAN
+  };
+  const uint32_t n = sizeof(args) / sizeof(args[0]);
+  uint32_t i, j, bad;
+  double ref;
+
+  arm_sqrt_block_f32(args, outF32, n);
+  FASTMATH_COUNT(!((args[i] > 0.0f) ? (outF32[i] == sqrtf(args[i])) : (outF32[i] == 0.0f)));
+  host_check_equal("sqrt_block_f32/special", n, bad);
+
+  /* exp flushes the results below the normal range to 0, overflows to
+   * +inf as the float of the C library, and gives NaN for NaN */
+  arm_exp_block_f32(args, outF32, n);
+  for (i = 0u, bad = 0u; i < n; i++)
+  {
+    ref = exp((double)args[i]);
+    if (isnan(args[i]))
+    {
+      bad += isnan(outF32[i]) ? 0u : 1u;
+    }
+    else if (args[i] < -87.3365479f)
+    {
+      bad += (outF32[i] != 0.0f) ? 1u : 0u;
+    }
+    else if (isinf((float32_t)ref))
+    {
+      bad += (outF32[i] != INFINITY) ? 1u : 0u;
+    }
+    else
+    {
+      bad += (fabs((double)outF32[i] - ref) > (3.0e-7 * ref)) ? 1u : 0u;
+    }
+  }
+  host_check_equal("exp_block_f32/special", n, bad);
+
+  /* log of the denormals is exact to the float, and of 0, +inf, the
+   * negatives and NaN follows the C library */
+  arm_log_block_f32(args, outF32, n);
+  for (i = 0u, bad = 0u; i < n; i++)
+  {
+    ref = log((double)args[i]);
+    if (isnan(ref) || isinf(ref))
+    {
+      bad += (isnan(ref) ? !isnan(outF32[i]) : (outF32[i] != (float32_t)ref)) ? 1u : 0u;
+    }
+    else
+    {
+      bad += (fabs((double)outF32[i] - ref) > (3.0e-7 * ((fabs(ref) > 1.0) ? fabs(ref) : 1.0))) ? 1u : 0u;
+    }
+  }
+  host_check_equal("log_block_f32/special", n, bad);
+
+  /* atan2 of every pair of finite values and infinities, pairs of
+   * infinities and zeros signs included */
+  for (i = 0u, bad = 0u; i < (n - 1u); i++)
+  {
+    for (j = 0u; j < (n - 1u); j++)
+    {
+      arm_atan2_block_f32(&args[i], &args[j], outF32, 1u);
+      ref = atan2((double)args[i], (double)args[j]);
+      bad += ((fabs((double)outF32[0] - ref) > 3.0e-7) || ((signbit(outF32[0]) != 0) != (signbit(ref) != 0))) ? 1u : 0u;
+    }
+  }
+  host_check_equal("atan2_block_f32/special", (n - 1u) * (n - 1u), bad);
+}
+
+void check_fastmath(void)
+{
+  static const uint32_t sizes[] = { 1u, 2u, 3u, 5u, 64u, 1023u };
+  uint32_t s;
+
+  for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+  {
+    check_size(sizes[s]);
+  }
+  check_special();
+}
@@ -0,0 +1,1424 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        filtering.c
+*
+* Description:  Host benchmarks and golden checks of the FIR and biquad
+*               cascade filters, of the partitioned and circular FIRs, of
+*               the multi-channel biquad cascades, of the FFT
+*               convolution and correlation against their direct forms,
+*               and of the responses of the filter design functions.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+
+#include "host_suites.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+#define FILT_STAGES             4u        /* biquad stages of the suites */
+#define FILT_CHECK_BLOCK        160u      /* samples per call in the checks */
+#define FILT_CHECK_CALLS        3u        /* calls per check, to test the state */
+#define FILT_CHECK_SAMPLES      (FILT_CHECK_BLOCK * FILT_CHECK_CALLS)
+
+static double    refIn[HOST_MAX_SAMPLES * 2u], refOut[HOST_MAX_SAMPLES * 2u];
+static double    refTaps[HOST_MAX_TAPS];
+static double    refSos[HOST_MAX_STAGES * 5u];
+
+static float32_t inF32[HOST_MAX_SAMPLES * 2u], outF32[HOST_MAX_SAMPLES * 2u];
+static float64_t inF64[HOST_MAX_SAMPLES], outF64[HOST_MAX_SAMPLES];
+static q31_t     inQ31[HOST_MAX_SAMPLES], outQ31[HOST_MAX_SAMPLES];
+static q15_t     inQ15[HOST_MAX_SAMPLES], outQ15[HOST_MAX_SAMPLES];
+static q7_t      inQ7[HOST_MAX_SAMPLES], outQ7[HOST_MAX_SAMPLES];
+
+static float32_t tapsF32[HOST_MAX_TAPS];
+static q31_t     tapsQ31[HOST_MAX_TAPS];
+static q15_t     tapsQ15[HOST_MAX_TAPS];
+static q7_t      tapsQ7[HOST_MAX_TAPS];
+
+static float32_t stateF32[HOST_MAX_SAMPLES + HOST_MAX_TAPS];
+static q31_t     stateQ31[HOST_MAX_SAMPLES + HOST_MAX_TAPS];
+static q15_t     stateQ15[HOST_MAX_SAMPLES + HOST_MAX_TAPS];
+static q7_t      stateQ7[HOST_MAX_SAMPLES + HOST_MAX_TAPS];
+static float64_t stateF64[4u * HOST_MAX_STAGES];
+static q63_t     stateQ63[4u * HOST_MAX_STAGES];
+
+static float32_t sosF32[HOST_MAX_STAGES * 5u];
+static float64_t sosF64[HOST_MAX_STAGES * 5u];
+static q31_t     sosQ31[HOST_MAX_STAGES * 5u];
+static q15_t     sosQ15[HOST_MAX_STAGES * 6u];
+
+static float32_t circStateF32[2u * (HOST_MAX_TAPS + 3u)];
+static q31_t     circStateQ31[2u * (HOST_MAX_TAPS + 3u)];
+static q15_t     circStateQ15[2u * (HOST_MAX_TAPS + 3u)];
+static q7_t      circStateQ7[2u * (HOST_MAX_TAPS + 3u)];
+static q31_t     circOutQ31[HOST_MAX_SAMPLES];
+static q15_t     circOutQ15[HOST_MAX_SAMPLES];
+static q15_t     padTapsQ15[HOST_MAX_TAPS + 1u];
+static q7_t      circOutQ7[HOST_MAX_SAMPLES];
+
+#define FILT_MULTI_CHANNELS     16u       /* most channels of the multi-channel biquads */
+
+static arm_biquad_cascade_df2T_instance_f32 chanF32[FILT_MULTI_CHANNELS];
+static arm_biquad_casd_df1_inst_q31 chanQ31[FILT_MULTI_CHANNELS];
+static float32_t multiStateF32[2u * HOST_MAX_STAGES * FILT_MULTI_CHANNELS];
+static q31_t     multiStateQ31[4u * HOST_MAX_STAGES * FILT_MULTI_CHANNELS];
+static float32_t multiOutF32[HOST_MAX_SAMPLES];
+static q31_t     multiInQ31[HOST_MAX_SAMPLES], multiOutQ31[HOST_MAX_SAMPLES];
+
+#define FILT_PART_MAX           256u      /* longest partition of the partitioned FIR */
+
+static float32_t partSpectraF32[2u * (HOST_MAX_TAPS + FILT_PART_MAX)];
+static float32_t partStateF32[2u * HOST_MAX_TAPS + 8u * FILT_PART_MAX];
+
+#define FILT_CONV_MAX           4096u     /* longest sequence of the convolutions */
+#define FILT_CONV_SIGNAL        4096u     /* signal length of the crossover benchmark */
+
+static double    convRefA[FILT_CONV_MAX], convRefB[FILT_CONV_MAX], convRefOut[2u * FILT_CONV_MAX];
+static float32_t convAF32[FILT_CONV_MAX], convBF32[FILT_CONV_MAX], convOutF32[2u * FILT_CONV_MAX];
+static q31_t     convAQ31[FILT_CONV_MAX], convBQ31[FILT_CONV_MAX], convOutQ31[2u * FILT_CONV_MAX];
+static float32_t convScratchF32[3u * 4096u];
+static q31_t     convScratchQ31[4u * 4096u];
+
+/* Overlap-save engines, to time the FFT form where the direct form is picked */
+extern void arm_conv_fft_os_f32(float32_t *pSig, uint32_t sigLen, float32_t *pFilt, uint32_t filtLen,
+                                uint8_t flipFilt, float32_t *pDst, int32_t dstInc, uint32_t fftLen,
+                                float32_t *pScratch);
+extern void arm_conv_fft_os_q31(q31_t *pSig, uint32_t sigLen, q31_t *pFilt, uint32_t filtLen,
+                                uint8_t flipFilt, q31_t *pDst, int32_t dstInc, uint32_t fftLen,
+                                q31_t *pScratch);
+
+/**
+ * @brief  Random FIR taps whose absolute sum is 0.9, so that no Q format
+ *         output can overflow, stored in time order in refTaps and
+ *         time-reversed (the CMSIS order) in the kernel buffers.
+ */
+static void filt_taps(uint32_t numTaps)
+{
+  double sum = 0.0;
+  uint32_t i;
+
+  host_signal(refTaps, numTaps, 1.0);
+  for (i = 0u; i < numTaps; i++)
+  {
+    sum += fabs(refTaps[i]);
+  }
+  for (i = 0u; i < numTaps; i++)
+  {
+    refTaps[i] *= 0.9 / sum;
+  }
+  for (i = 0u; i < numTaps; i++)
+  {
+    refOut[i] = refTaps[numTaps - 1u - i];
+  }
+
+  host_to_f32(refOut, tapsF32, numTaps);
+  host_to_q31(refOut, tapsQ31, numTaps);
+  host_to_q15(refOut, tapsQ15, numTaps);
+  host_to_q7(refOut, tapsQ7, numTaps);
+}
+
+/**
+ * @brief  Low-pass cascade with cutoffs spread over the band, stored as
+ *         {b0, b1, b2, -a1, -a2} per stage (the CMSIS sign convention),
+ *         and in the Q31 and Q15 layouts with coefficients divided by
+ *         2^postShift.
+ */
+static void filt_sos(uint32_t numStages, uint32_t postShift)
+{
+  double w, alpha, a0, cw;
+  double scale = ldexp(1.0, -(int)postShift);
+  uint32_t s, k;
+
+  for (s = 0u; s < numStages; s++)
+  {
+    w = PI * (0.05 + 0.4 * (double)s / (double)numStages);
+    cw = cos(w);
+    alpha = sin(w) / (2.0 * 0.8);
+    a0 = 1.0 + alpha;
+
+    refSos[5u * s + 0u] = (1.0 - cw) / 2.0 / a0;
+    refSos[5u * s + 1u] = (1.0 - cw) / a0;
+    refSos[5u * s + 2u] = (1.0 - cw) / 2.0 / a0;
+    refSos[5u * s + 3u] = 2.0 * cw / a0;
+    refSos[5u * s + 4u] = -(1.0 - alpha) / a0;
+  }
+
+  for (k = 0u; k < (5u * numStages); k++)
+  {
+    sosF32[k] = (float32_t)refSos[k];
+    sosF64[k] = refSos[k];
+    refOut[k] = refSos[k] * scale;
+  }
+  host_to_q31(refOut, sosQ31, 5u * numStages);
+
+  for (s = 0u; s < numStages; s++)
+  {
+    host_to_q15(&refOut[5u * s], &sosQ15[6u * s], 1u);
+    sosQ15[6u * s + 1u] = 0;
+    host_to_q15(&refOut[5u * s + 1u], &sosQ15[6u * s + 2u], 4u);
+  }
+}
+
+/**
+ * @brief  Double-precision FIR reference, zero initial state.
+ */
+static void ref_fir(const double *pIn, double *pOut, uint32_t n, uint32_t numTaps)
+{
+  double acc;
+  uint32_t i, k;
+
+  for (i = 0u; i < n; i++)
+  {
+    acc = 0.0;
+    for (k = 0u; (k < numTaps) && (k <= i); k++)
+    {
+      acc += refTaps[k] * pIn[i - k];
+    }
+    pOut[i] = acc;
+  }
+}
+
+/**
+ * @brief  Double-precision direct form I reference, zero initial state.
+ * @param  pSos  coefficients, {b0, b1, b2, -a1, -a2} per stage
+ */
+static void ref_biquad(const double *pSos, const double *pIn, double *pOut, uint32_t n,
+                       uint32_t numStages, uint32_t stride)
+{
+  double x1, x2, y1, y2, x, y;
+  uint32_t i, s;
+
+  for (i = 0u; i < n; i++)
+  {
+    pOut[i] = pIn[i * stride];
+  }
+
+  for (s = 0u; s < numStages; s++)
+  {
+    x1 = x2 = y1 = y2 = 0.0;
+    for (i = 0u; i < n; i++)
+    {
+      x = pOut[i];
+      y = pSos[5u * s] * x + pSos[5u * s + 1u] * x1 + pSos[5u * s + 2u] * x2
+        + pSos[5u * s + 3u] * y1 + pSos[5u * s + 4u] * y2;
+      x2 = x1;
+      x1 = x;
+      y2 = y1;
+      y1 = y;
+      pOut[i] = y;
+    }
+  }
+}
+
+/**
+ * @brief  Double-precision linear convolution, srcALen + srcBLen - 1 samples.
+ */
+static void ref_conv(const double *pA, uint32_t srcALen, const double *pB, uint32_t srcBLen, double *pOut)
+{
+  uint32_t i, k;
+
+  for (i = 0u; i < (srcALen + srcBLen - 1u); i++)
+  {
+    pOut[i] = 0.0;
+  }
+  for (i = 0u; i < srcALen; i++)
+  {
+    for (k = 0u; k < srcBLen; k++)
+    {
+      pOut[i + k] += pA[i] * pB[k];
+    }
+  }
+}
+
+/**
+ * @brief  Double-precision correlation in the CMSIS layout,
+ *         2 * max(srcALen, srcBLen) - 1 samples.
+ */
+static void ref_correlate(const double *pA, uint32_t srcALen, const double *pB, uint32_t srcBLen, double *pOut)
+{
+  const uint32_t n = 2u * ((srcALen > srcBLen) ? srcALen : srcBLen) - 1u;
+  const uint32_t pad = (srcALen > srcBLen) ? (srcALen - srcBLen) : 0u;
+  uint32_t i, k;
+
+  for (i = 0u; i < n; i++)
+  {
+    pOut[i] = 0.0;
+  }
+  for (i = 0u; i < srcALen; i++)
+  {
+    for (k = 0u; k < srcBLen; k++)
+    {
+      pOut[pad + i + (srcBLen - 1u - k)] += pA[i] * pB[k];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Benchmarks
+* -------------------------------------------------------------------- */
+typedef struct
+{
+  void *S;
+  uint32_t blockSize;
+} filt_ctx_t;
+
+static void run_fir_f32(void *p)       { filt_ctx_t *c = p; arm_fir_f32(c->S, inF32, outF32, c->blockSize); }
+static void run_fir_q31(void *p)       { filt_ctx_t *c = p; arm_fir_q31(c->S, inQ31, outQ31, c->blockSize); }
+static void run_fir_fast_q31(void *p)  { filt_ctx_t *c = p; arm_fir_fast_q31(c->S, inQ31, outQ31, c->blockSize); }
+static void run_fir_q15(void *p)       { filt_ctx_t *c = p; arm_fir_q15(c->S, inQ15, outQ15, c->blockSize); }
+static void run_fir_fast_q15(void *p)  { filt_ctx_t *c = p; arm_fir_fast_q15(c->S, inQ15, outQ15, c->blockSize); }
+static void run_fir_q7(void *p)        { filt_ctx_t *c = p; arm_fir_q7(c->S, inQ7, outQ7, c->blockSize); }
+
+static void run_df1_f32(void *p)       { filt_ctx_t *c = p; arm_biquad_cascade_df1_f32(c->S, inF32, outF32, c->blockSize); }
+static void run_df1_q31(void *p)       { filt_ctx_t *c = p; arm_biquad_cascade_df1_q31(c->S, inQ31, outQ31, c->blockSize); }
+static void run_df1_fast_q31(void *p)  { filt_ctx_t *c = p; arm_biquad_cascade_df1_fast_q31(c->S, inQ31, outQ31, c->blockSize); }
+static void run_df1_32x64_q31(void *p) { filt_ctx_t *c = p; arm_biquad_cas_df1_32x64_q31(c->S, inQ31, outQ31, c->blockSize); }
+static void run_df1_q15(void *p)       { filt_ctx_t *c = p; arm_biquad_cascade_df1_q15(c->S, inQ15, outQ15, c->blockSize); }
+static void run_df1_fast_q15(void *p)  { filt_ctx_t *c = p; arm_biquad_cascade_df1_fast_q15(c->S, inQ15, outQ15, c->blockSize); }
+static void run_df2T_f32(void *p)      { filt_ctx_t *c = p; arm_biquad_cascade_df2T_f32(c->S, inF32, outF32, c->blockSize); }
+static void run_df2T_f64(void *p)      { filt_ctx_t *c = p; arm_biquad_cascade_df2T_f64(c->S, inF64, outF64, c->blockSize); }
+static void run_stereo_df2T_f32(void *p) { filt_ctx_t *c = p; arm_biquad_cascade_stereo_df2T_f32(c->S, inF32, outF32, c->blockSize); }
+
+/* Channel by channel with the single-channel filters, on deinterleaved
+ * blocks of blockSize samples: the baseline of the multi-channel filters */
+static void run_chan_df2T_f32(void *p)
+{
+  filt_ctx_t *c = p;
+  uint32_t ch, numCh = ((arm_biquad_cascade_multi_df2T_instance_f32 *)c->S)->numChannels;
+
+  for (ch = 0u; ch < numCh; ch++)
+  {
+    arm_biquad_cascade_df2T_f32(&chanF32[ch], &inF32[ch * c->blockSize], &outF32[ch * c->blockSize], c->blockSize);
+  }
+}
+
+static void run_chan_df1_q31(void *p)
+{
+  filt_ctx_t *c = p;
+  uint32_t ch, numCh = ((arm_biquad_cascade_multi_df1_instance_q31 *)c->S)->numChannels;
+
+  for (ch = 0u; ch < numCh; ch++)
+  {
+    arm_biquad_cascade_df1_q31(&chanQ31[ch], &inQ31[ch * c->blockSize], &outQ31[ch * c->blockSize], c->blockSize);
+  }
+}
+
+static void run_multi_df2T_f32(void *p) { filt_ctx_t *c = p; arm_biquad_cascade_multi_df2T_f32(c->S, inF32, outF32, c->blockSize); }
+static void run_multi_df1_q31(void *p)  { filt_ctx_t *c = p; arm_biquad_cascade_multi_df1_q31(c->S, inQ31, outQ31, c->blockSize); }
+
+static void run_fir_circular_f32(void *p) { filt_ctx_t *c = p; arm_fir_circular_f32(c->S, inF32, outF32, c->blockSize); }
+static void run_fir_circular_q31(void *p) { filt_ctx_t *c = p; arm_fir_circular_q31(c->S, inQ31, outQ31, c->blockSize); }
+static void run_fir_circular_q15(void *p) { filt_ctx_t *c = p; arm_fir_circular_q15(c->S, inQ15, outQ15, c->blockSize); }
+static void run_fir_circular_q7(void *p)  { filt_ctx_t *c = p; arm_fir_circular_q7(c->S, inQ7, outQ7, c->blockSize); }
+
+/**
+ * @brief  FIR filters against their circular delay line variants, over
+ *         blockSize and numTaps sweeps: the state copy of the FIR filters
+ *         weighs most with small blocks and many taps.
+ */
+static void bench_fir_circular(void)
+{
+  static const uint32_t taps[] = { 16u, 64u, 256u, 1024u };
+  static const uint32_t blocks[] = { 4u, 16u, 64u, 256u };
+  arm_fir_instance_f32 firF32;
+  arm_fir_instance_q31 firQ31;
+  arm_fir_instance_q15 firQ15;
+  arm_fir_instance_q7 firQ7;
+  arm_fir_circular_instance_f32 circF32;
+  arm_fir_circular_instance_q31 circQ31;
+  arm_fir_circular_instance_q15 circQ15;
+  arm_fir_circular_instance_q7 circQ7;
+  filt_ctx_t c;
+  char name[40];
+  uint32_t t, b, n;
+
+  for (t = 0u; t < (sizeof(taps) / sizeof(taps[0])); t++)
+  {
+    filt_taps(taps[t]);
+    arm_fir_circular_init_f32(&circF32, (uint16_t)taps[t], tapsF32, circStateF32);
+    arm_fir_circular_init_q31(&circQ31, (uint16_t)taps[t], tapsQ31, circStateQ31);
+    arm_fir_circular_init_q15(&circQ15, (uint16_t)taps[t], tapsQ15, circStateQ15);
+    arm_fir_circular_init_q7(&circQ7, (uint16_t)taps[t], tapsQ7, circStateQ7);
+
+    for (b = 0u; b < (sizeof(blocks) / sizeof(blocks[0])); b++)
+    {
+      n = blocks[b];
+      c.blockSize = n;
+
+      arm_fir_init_f32(&firF32, (uint16_t)taps[t], tapsF32, stateF32, n);
+      arm_fir_init_q31(&firQ31, (uint16_t)taps[t], tapsQ31, stateQ31, n);
+      arm_fir_init_q15(&firQ15, (uint16_t)taps[t], tapsQ15, stateQ15, n);
+      arm_fir_init_q7(&firQ7, (uint16_t)taps[t], tapsQ7, stateQ7, n);
+
+      snprintf(name, sizeof(name), "fir_f32/%u", taps[t]);
+      c.S = &firF32;
+      host_bench(name, n, n, run_fir_f32, &c);
+      snprintf(name, sizeof(name), "fir_circular_f32/%u", taps[t]);
+      c.S = &circF32;
+      host_bench(name, n, n, run_fir_circular_f32, &c);
+      snprintf(name, sizeof(name), "fir_q31/%u", taps[t]);
+      c.S = &firQ31;
+      host_bench(name, n, n, run_fir_q31, &c);
+      snprintf(name, sizeof(name), "fir_circular_q31/%u", taps[t]);
+      c.S = &circQ31;
+      host_bench(name, n, n, run_fir_circular_q31, &c);
+      snprintf(name, sizeof(name), "fir_q15/%u", taps[t]);
+      c.S = &firQ15;
+      host_bench(name, n, n, run_fir_q15, &c);
+      snprintf(name, sizeof(name), "fir_circular_q15/%u", taps[t]);
+      c.S = &circQ15;
+      host_bench(name, n, n, run_fir_circular_q15, &c);
+      snprintf(name, sizeof(name), "fir_q7/%u", taps[t]);
+      c.S = &firQ7;
+      host_bench(name, n, n, run_fir_q7, &c);
+      snprintf(name, sizeof(name), "fir_circular_q7/%u", taps[t]);
+      c.S = &circQ7;
+      host_bench(name, n, n, run_fir_circular_q7, &c);
+    }
+  }
+}
+
+static void run_fir_partitioned_f32(void *p)
+{
+  filt_ctx_t *c = p;
+  arm_fir_partitioned_f32(c->S, inF32, outF32, c->blockSize);
+}
+
+/**
+ * @brief  Long filters: the partitioned FIR against arm_fir_f32, both
+ *         with blocks of one partition.
+ */
+static void bench_fir_partitioned(void)
+{
+  static const uint32_t taps[] = { 256u, 1024u, 2048u };
+  static const uint32_t parts[] = { 32u, 64u, 128u, 256u };
+  arm_fir_instance_f32 firF32;
+  arm_fir_partitioned_instance_f32 partF32;
+  filt_ctx_t c;
+  char name[40];
+  uint32_t t, b;
+
+  for (t = 0u; t < (sizeof(taps) / sizeof(taps[0])); t++)
+  {
+    filt_taps(taps[t]);
+    for (b = 0u; b < (sizeof(parts) / sizeof(parts[0])); b++)
+    {
+      c.blockSize = parts[b];
+
+      arm_fir_init_f32(&firF32, (uint16_t)taps[t], tapsF32, stateF32, c.blockSize);
+      snprintf(name, sizeof(name), "fir_f32/%u", taps[t]);
+      c.S = &firF32;
+      host_bench(name, c.blockSize, c.blockSize, run_fir_f32, &c);
+
+      arm_fir_partitioned_init_f32(&partF32, (uint16_t)taps[t], tapsF32, partSpectraF32, partStateF32,
+                                   (uint16_t)parts[b]);
+      snprintf(name, sizeof(name), "fir_partitioned_f32/%u", taps[t]);
+      c.S = &partF32;
+      host_bench(name, c.blockSize, c.blockSize, run_fir_partitioned_f32, &c);
+    }
+  }
+}
+
+typedef struct
+{
+  uint32_t sigLen;
+  uint32_t filtLen;
+  uint32_t fftLen;
+} conv_ctx_t;
+
+static void run_conv_f32(void *p)
+{
+  conv_ctx_t *c = p;
+  arm_conv_f32(convAF32, c->sigLen, convBF32, c->filtLen, convOutF32);
+}
+
+static void run_conv_os_f32(void *p)
+{
+  conv_ctx_t *c = p;
+  arm_conv_fft_os_f32(convAF32, c->sigLen, convBF32, c->filtLen, 0u, convOutF32, 1, c->fftLen, convScratchF32);
+}
+
+static void run_conv_fft_f32(void *p)
+{
+  conv_ctx_t *c = p;
+  arm_conv_fft_f32(convAF32, c->sigLen, convBF32, c->filtLen, convOutF32, convScratchF32);
+}
+
+static void run_conv_q31(void *p)
+{
+  conv_ctx_t *c = p;
+  arm_conv_q31(convAQ31, c->sigLen, convBQ31, c->filtLen, convOutQ31);
+}
+
+static void run_conv_os_q31(void *p)
+{
+  conv_ctx_t *c = p;
+  arm_conv_fft_os_q31(convAQ31, c->sigLen, convBQ31, c->filtLen, 0u, convOutQ31, 1, c->fftLen, convScratchQ31);
+}
+
+static void run_conv_fft_q31(void *p)
+{
+  conv_ctx_t *c = p;
+  arm_conv_fft_q31(convAQ31, c->sigLen, convBQ31, c->filtLen, convOutQ31, convScratchQ31);
+}
+
+/**
+ * @brief  Crossover of the direct and the FFT convolution: a signal of
+ *         FILT_CONV_SIGNAL samples against filters of 8 to 2048 taps.
+ *         conv_os_* times each transform length that the filter allows,
+ *         conv_fft_* the length that the cost model picks (/0: direct).
+ */
+static void bench_conv(void)
+{
+  conv_ctx_t c;
+  char name[40];
+  uint32_t m, len;
+
+  host_signal(convRefA, FILT_CONV_MAX, 0.5);
+  host_signal(convRefB, FILT_CONV_MAX, 1.0 / 2048.0);
+  host_to_f32(convRefA, convAF32, FILT_CONV_MAX);
+  host_to_f32(convRefB, convBF32, FILT_CONV_MAX);
+  host_to_q31(convRefA, convAQ31, FILT_CONV_MAX);
+  host_to_q31(convRefB, convBQ31, FILT_CONV_MAX);
+  c.sigLen = FILT_CONV_SIGNAL;
+
+  for (m = 8u; m <= 2048u; m <<= 1u)
+  {
+    c.filtLen = m;
+
+    snprintf(name, sizeof(name), "conv_f32/%u", m);
+    host_bench(name, c.sigLen, c.sigLen + m - 1u, run_conv_f32, &c);
+    for (len = 32u; len <= 4096u; len <<= 1u)
+    {
+      if ((len >= 2u * m) && (len <= 16u * m))
+      {
+        c.fftLen = len;
+        snprintf(name, sizeof(name), "conv_os_f32/%u/%u", m, len);
+        host_bench(name, c.sigLen, c.sigLen + m - 1u, run_conv_os_f32, &c);
+      }
+    }
+    snprintf(name, sizeof(name), "conv_fft_f32/%u/%u", m, arm_conv_fft_len_f32(c.sigLen, m));
+    host_bench(name, c.sigLen, c.sigLen + m - 1u, run_conv_fft_f32, &c);
+
+    snprintf(name, sizeof(name), "conv_q31/%u", m);
+    host_bench(name, c.sigLen, c.sigLen + m - 1u, run_conv_q31, &c);
+    for (len = 16u; len <= 4096u; len <<= 1u)
+    {
+      if ((len >= 2u * m) && (len <= 16u * m))
+      {
+        c.fftLen = len;
+        snprintf(name, sizeof(name), "conv_os_q31/%u/%u", m, len);
+        host_bench(name, c.sigLen, c.sigLen + m - 1u, run_conv_os_q31, &c);
+      }
+    }
+    snprintf(name, sizeof(name), "conv_fft_q31/%u/%u", m, arm_conv_fft_len_q31(c.sigLen, m));
+    host_bench(name, c.sigLen, c.sigLen + m - 1u, run_conv_fft_q31, &c);
+  }
+}
+
+/**
+ * @brief  Multi-channel biquad cascades against one single-channel filter
+ *         per channel, for 2 to 16 channels of 256 samples.
+ */
+static void bench_biquad_multi(void)
+{
+  static const uint32_t channels[] = { 2u, 8u, 16u };
+  const uint32_t n = 256u;
+  arm_biquad_cascade_multi_df2T_instance_f32 multiF32;
+  arm_biquad_cascade_multi_df1_instance_q31 multiQ31;
+  filt_ctx_t c;
+  char name[40];
+  uint32_t k, ch, numCh;
+
+  filt_sos(FILT_STAGES, 1u);
+  c.blockSize = n;
+
+  for (k = 0u; k < (sizeof(channels) / sizeof(channels[0])); k++)
+  {
+    numCh = channels[k];
+    arm_biquad_cascade_multi_df2T_init_f32(&multiF32, FILT_STAGES, (uint16_t)numCh, sosF32, multiStateF32);
+    arm_biquad_cascade_multi_df1_init_q31(&multiQ31, FILT_STAGES, (uint16_t)numCh, sosQ31, multiStateQ31, 1);
+    for (ch = 0u; ch < numCh; ch++)
+    {
+      arm_biquad_cascade_df2T_init_f32(&chanF32[ch], FILT_STAGES, sosF32, &stateF32[2u * FILT_STAGES * ch]);
+      arm_biquad_cascade_df1_init_q31(&chanQ31[ch], FILT_STAGES, sosQ31, &stateQ31[4u * FILT_STAGES * ch], 1);
+    }
+
+    snprintf(name, sizeof(name), "biquad_df2T_f32/4/x%u", numCh);
+    c.S = &multiF32;
+    host_bench(name, n, n * numCh, run_chan_df2T_f32, &c);
+    snprintf(name, sizeof(name), "biquad_multi_df2T_f32/4/x%u", numCh);
+    host_bench(name, n, n * numCh, run_multi_df2T_f32, &c);
+    snprintf(name, sizeof(name), "biquad_df1_q31/4/x%u", numCh);
+    c.S = &multiQ31;
+    host_bench(name, n, n * numCh, run_chan_df1_q31, &c);
+    snprintf(name, sizeof(name), "biquad_multi_df1_q31/4/x%u", numCh);
+    host_bench(name, n, n * numCh, run_multi_df1_q31, &c);
+  }
+}
+
+void bench_filtering(void)
+{
+  static const uint32_t taps[] = { 16u, 64u };
+  static const uint32_t blocks[] = { 64u, 256u, 1024u };
+  arm_fir_instance_f32 firF32;
+  arm_fir_instance_q31 firQ31;
+  arm_fir_instance_q15 firQ15;
+  arm_fir_instance_q7 firQ7;
+  arm_biquad_casd_df1_inst_f32 df1F32;
+  arm_biquad_casd_df1_inst_q31 df1Q31;
+  arm_biquad_casd_df1_inst_q15 df1Q15;
+  arm_biquad_cas_df1_32x64_ins_q31 df1Q31x64;
+  arm_biquad_cascade_df2T_instance_f32 df2TF32;
+  arm_biquad_cascade_df2T_instance_f64 df2TF64;
+  arm_biquad_cascade_stereo_df2T_instance_f32 stereoF32;
+  filt_ctx_t c;
+  char name[40];
+  uint32_t t, b, n;
+
+  host_signal(refIn, 2u * HOST_MAX_SAMPLES, 0.5);
+  host_to_f32(refIn, inF32, 2u * HOST_MAX_SAMPLES);
+  host_to_q31(refIn, inQ31, HOST_MAX_SAMPLES);
+  host_to_q15(refIn, inQ15, HOST_MAX_SAMPLES);
+  host_to_q7(refIn, inQ7, HOST_MAX_SAMPLES);
+  for (n = 0u; n < HOST_MAX_SAMPLES; n++)
+  {
+    inF64[n] = refIn[n];
+  }
+
+  for (t = 0u; t < (sizeof(taps) / sizeof(taps[0])); t++)
+  {
+    filt_taps(taps[t]);
+    for (b = 0u; b < (sizeof(blocks) / sizeof(blocks[0])); b++)
+    {
+      n = blocks[b];
+      c.blockSize = n;
+
+      arm_fir_init_f32(&firF32, (uint16_t)taps[t], tapsF32, stateF32, n);
+      arm_fir_init_q31(&firQ31, (uint16_t)taps[t], tapsQ31, stateQ31, n);
+      arm_fir_init_q15(&firQ15, (uint16_t)taps[t], tapsQ15, stateQ15, n);
+      arm_fir_init_q7(&firQ7, (uint16_t)taps[t], tapsQ7, stateQ7, n);
+
+      snprintf(name, sizeof(name), "fir_f32/%u", taps[t]);
+      c.S = &firF32;
+      host_bench(name, n, n, run_fir_f32, &c);
+      snprintf(name, sizeof(name), "fir_q31/%u", taps[t]);
+      c.S = &firQ31;
+      host_bench(name, n, n, run_fir_q31, &c);
+      snprintf(name, sizeof(name), "fir_fast_q31/%u", taps[t]);
+      host_bench(name, n, n, run_fir_fast_q31, &c);
+      snprintf(name, sizeof(name), "fir_q15/%u", taps[t]);
+      c.S = &firQ15;
+      host_bench(name, n, n, run_fir_q15, &c);
+      snprintf(name, sizeof(name), "fir_fast_q15/%u", taps[t]);
+      host_bench(name, n, n, run_fir_fast_q15, &c);
+      snprintf(name, sizeof(name), "fir_q7/%u", taps[t]);
+      c.S = &firQ7;
+      host_bench(name, n, n, run_fir_q7, &c);
+    }
+  }
+
+  filt_sos(FILT_STAGES, 1u);
+  arm_biquad_cascade_df1_init_f32(&df1F32, FILT_STAGES, sosF32, stateF32);
+  arm_biquad_cascade_df1_init_q31(&df1Q31, FILT_STAGES, sosQ31, stateQ31, 1);
+  arm_biquad_cas_df1_32x64_init_q31(&df1Q31x64, FILT_STAGES, sosQ31, stateQ63, 1u);
+  arm_biquad_cascade_df1_init_q15(&df1Q15, FILT_STAGES, sosQ15, stateQ15, 1);
+  arm_biquad_cascade_df2T_init_f32(&df2TF32, FILT_STAGES, sosF32, &stateF32[4u * FILT_STAGES]);
+  arm_biquad_cascade_df2T_init_f64(&df2TF64, FILT_STAGES, sosF64, stateF64);
+  arm_biquad_cascade_stereo_df2T_init_f32(&stereoF32, FILT_STAGES, sosF32, &stateF32[8u * FILT_STAGES]);
+
+  for (b = 0u; b < (sizeof(blocks) / sizeof(blocks[0])); b++)
+  {
+    n = blocks[b];
+    c.blockSize = n;
+
+    c.S = &df1F32;
+    host_bench("biquad_df1_f32/4", n, n, run_df1_f32, &c);
+    c.S = &df1Q31;
+    host_bench("biquad_df1_q31/4", n, n, run_df1_q31, &c);
+    host_bench("biquad_df1_fast_q31/4", n, n, run_df1_fast_q31, &c);
+    c.S = &df1Q31x64;
+    host_bench("biquad_df1_32x64_q31/4", n, n, run_df1_32x64_q31, &c);
+    c.S = &df1Q15;
+    host_bench("biquad_df1_q15/4", n, n, run_df1_q15, &c);
+    host_bench("biquad_df1_fast_q15/4", n, n, run_df1_fast_q15, &c);
+    c.S = &df2TF32;
+    host_bench("biquad_df2T_f32/4", n, n, run_df2T_f32, &c);
+    c.S = &df2TF64;
+    host_bench("biquad_df2T_f64/4", n, n, run_df2T_f64, &c);
+    c.S = &stereoF32;
+    host_bench("biquad_stereo_df2T_f32/4", n, 2u * n, run_stereo_df2T_f32, &c);
+  }
+
+  bench_biquad_multi();
+  bench_fir_circular();
+  bench_fir_partitioned();
+  bench_conv();
+}
+
+/* ----------------------------------------------------------------------
+*       Golden checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Runs a filter over FILT_CHECK_CALLS consecutive blocks.
+ */
+#define FILT_RUN(CALL, IN, OUT)                                      \
+  for (k = 0u; k < FILT_CHECK_CALLS; k++)                            \
+  {                                                                  \
+    CALL(&S, &IN[k * FILT_CHECK_BLOCK], &OUT[k * FILT_CHECK_BLOCK],  \
+         FILT_CHECK_BLOCK);                                          \
+  }
+
+static void check_fir(uint32_t numTaps)
+{
+  const uint32_t n = FILT_CHECK_SAMPLES;
+  uint32_t k;
+
+  filt_taps(numTaps);
+  host_signal(refIn, n, 0.5);
+  host_to_f32(refIn, inF32, n);
+  host_to_q31(refIn, inQ31, n);
+  host_to_q15(refIn, inQ15, n);
+  host_to_q7(refIn, inQ7, n);
+
+  /* The references of the Q formats run on the quantized taps and input */
+  ref_fir(refIn, refOut, n, numTaps);
+  {
+    arm_fir_instance_f32 S;
+    arm_fir_init_f32(&S, (uint16_t)numTaps, tapsF32, stateF32, FILT_CHECK_BLOCK);
+    FILT_RUN(arm_fir_f32, inF32, outF32);
+    host_check_snr("fir_f32", numTaps, host_snr_f32(refOut, outF32, n), 120.0);
+  }
+
+  for (k = 0u; k < numTaps; k++)
+  {
+    refTaps[k] = (double)tapsQ31[numTaps - 1u - k] / 2147483648.0;
+  }
+  for (k = 0u; k < n; k++)
+  {
+    refIn[k] = (double)inQ31[k] / 2147483648.0;
+  }
+  ref_fir(refIn, refOut, n, numTaps);
+  {
+    arm_fir_instance_q31 S;
+    arm_fir_init_q31(&S, (uint16_t)numTaps, tapsQ31, stateQ31, FILT_CHECK_BLOCK);
+    FILT_RUN(arm_fir_q31, inQ31, outQ31);
+    host_check_snr("fir_q31", numTaps, host_snr_q31(refOut, outQ31, n, 1.0), 155.0);
+    arm_fir_init_q31(&S, (uint16_t)numTaps, tapsQ31, stateQ31, FILT_CHECK_BLOCK);
+    FILT_RUN(arm_fir_fast_q31, inQ31, outQ31);
+    host_check_snr("fir_fast_q31", numTaps, host_snr_q31(refOut, outQ31, n, 1.0), 135.0);
+  }
+
+  for (k = 0u; k < numTaps; k++)
+  {
+    refTaps[k] = (double)tapsQ15[numTaps - 1u - k] / 32768.0;
+  }
+  for (k = 0u; k < n; k++)
+  {
+    refIn[k] = (double)inQ15[k] / 32768.0;
+  }
+  ref_fir(refIn, refOut, n, numTaps);
+  if ((numTaps & 1u) == 0u)
+  {
+    arm_fir_instance_q15 S;
+    arm_fir_init_q15(&S, (uint16_t)numTaps, tapsQ15, stateQ15, FILT_CHECK_BLOCK);
+    FILT_RUN(arm_fir_q15, inQ15, outQ15);
+    host_check_snr("fir_q15", numTaps, host_snr_q15(refOut, outQ15, n, 1.0), 60.0);
+    arm_fir_init_q15(&S, (uint16_t)numTaps, tapsQ15, stateQ15, FILT_CHECK_BLOCK);
+    FILT_RUN(arm_fir_fast_q15, inQ15, outQ15);
+    host_check_snr("fir_fast_q15", numTaps, host_snr_q15(refOut, outQ15, n, 1.0), 60.0);
+  }
+
+  for (k = 0u; k < numTaps; k++)
+  {
+    refTaps[k] = (double)tapsQ7[numTaps - 1u - k] / 128.0;
+  }
+  for (k = 0u; k < n; k++)
+  {
+    refIn[k] = (double)inQ7[k] / 128.0;
+  }
+  ref_fir(refIn, refOut, n, numTaps);
+  {
+    arm_fir_instance_q7 S;
+    arm_fir_init_q7(&S, (uint16_t)numTaps, tapsQ7, stateQ7, FILT_CHECK_BLOCK);
+    FILT_RUN(arm_fir_q7, inQ7, outQ7);
+    host_check_snr("fir_q7", numTaps, host_snr_q7(refOut, outQ7, n, 1.0), 12.0);
+  }
+}
+
+/**
+ * @brief  Circular FIRs against the FIR filters, over calls of uneven
+ *         sizes that move the newest sample across the wrap of the delay
+ *         line: the same outputs, bit for bit. arm_fir_q15() takes an even
+ *         number of taps: for an odd one, it runs on the taps with a zero
+ *         prepended.
+ */
+static void check_fir_circular(uint32_t numTaps)
+{
+  static const uint32_t calls[] = { 1u, 3u, 4u, 7u, 13u, 32u, 5u, FILT_CHECK_BLOCK, 2u, 64u };
+  arm_fir_instance_f32 firF32;
+  arm_fir_instance_q31 firQ31;
+  arm_fir_instance_q15 firQ15;
+  arm_fir_instance_q7 firQ7;
+  arm_fir_circular_instance_f32 circF32;
+  arm_fir_circular_instance_q31 circQ31;
+  arm_fir_circular_instance_q15 circQ15;
+  arm_fir_circular_instance_q7 circQ7;
+  uint32_t k, i, n, misQ31 = 0u, misQ15 = 0u, misQ7 = 0u;
+  float32_t *pOut = outF32 + HOST_MAX_SAMPLES;
+
+  filt_taps(numTaps);
+  host_signal(refIn, HOST_MAX_SAMPLES, 0.5);
+  host_to_f32(refIn, inF32, HOST_MAX_SAMPLES);
+  host_to_q31(refIn, inQ31, HOST_MAX_SAMPLES);
+  host_to_q15(refIn, inQ15, HOST_MAX_SAMPLES);
+  host_to_q7(refIn, inQ7, HOST_MAX_SAMPLES);
+
+  arm_fir_init_f32(&firF32, (uint16_t)numTaps, tapsF32, stateF32, FILT_CHECK_BLOCK);
+  arm_fir_init_q31(&firQ31, (uint16_t)numTaps, tapsQ31, stateQ31, FILT_CHECK_BLOCK);
+  padTapsQ15[0] = 0;
+  memcpy(&padTapsQ15[1], tapsQ15, numTaps * sizeof(q15_t));
+  if ((numTaps & 1u) != 0u)
+  {
+    arm_fir_init_q15(&firQ15, (uint16_t)(numTaps + 1u), padTapsQ15, stateQ15, FILT_CHECK_BLOCK);
+  }
+  else
+  {
+    arm_fir_init_q15(&firQ15, (uint16_t)numTaps, tapsQ15, stateQ15, FILT_CHECK_BLOCK);
+  }
+  arm_fir_init_q7(&firQ7, (uint16_t)numTaps, tapsQ7, stateQ7, FILT_CHECK_BLOCK);
+  arm_fir_circular_init_f32(&circF32, (uint16_t)numTaps, tapsF32, circStateF32);
+  arm_fir_circular_init_q31(&circQ31, (uint16_t)numTaps, tapsQ31, circStateQ31);
+  arm_fir_circular_init_q15(&circQ15, (uint16_t)numTaps, tapsQ15, circStateQ15);
+  arm_fir_circular_init_q7(&circQ7, (uint16_t)numTaps, tapsQ7, circStateQ7);
+
+  for (k = 0u, i = 0u; (k + FILT_CHECK_BLOCK) <= HOST_MAX_SAMPLES; k += n, i++)
+  {
+    n = calls[i % (sizeof(calls) / sizeof(calls[0]))];
+    arm_fir_f32(&firF32, &inF32[k], &outF32[k], n);
+    arm_fir_circular_f32(&circF32, &inF32[k], &pOut[k], n);
+    arm_fir_q31(&firQ31, &inQ31[k], &outQ31[k], n);
+    arm_fir_circular_q31(&circQ31, &inQ31[k], &circOutQ31[k], n);
+    arm_fir_q15(&firQ15, &inQ15[k], &outQ15[k], n);
+    arm_fir_circular_q15(&circQ15, &inQ15[k], &circOutQ15[k], n);
+    arm_fir_q7(&firQ7, &inQ7[k], &outQ7[k], n);
+    arm_fir_circular_q7(&circQ7, &inQ7[k], &circOutQ7[k], n);
+  }
+
+  for (i = 0u; i < k; i++)
+  {
+    refOut[i] = (double)outF32[i];
+    misQ31 += (outQ31[i] != circOutQ31[i]);
+    misQ15 += (outQ15[i] != circOutQ15[i]);
+    misQ7 += (outQ7[i] != circOutQ7[i]);
+  }
+  host_check_snr("fir_circular_f32", numTaps, host_snr_f32(refOut, pOut, k), 130.0);
+  host_check_equal("fir_circular_q31", numTaps, misQ31);
+  host_check_equal("fir_circular_q15", numTaps, misQ15);
+  host_check_equal("fir_circular_q7", numTaps, misQ7);
+}
+
+/**
+ * @brief  Partitioned FIR over blocks of two partitions, against the
+ *         reference on the single-precision taps and input.
+ */
+/**
+ * @brief  Multi-channel biquad cascades against the single-channel filters
+ *         run on each deinterleaved channel: bit-exact, over calls of
+ *         uneven sizes.
+ */
+static void check_biquad_multi(uint32_t numCh)
+{
+  static const uint32_t calls[] = { 1u, 37u, 4u, 91u, 160u, 3u, 184u };
+  const uint32_t n = FILT_CHECK_SAMPLES;
+  arm_biquad_cascade_multi_df2T_instance_f32 multiF32;
+  arm_biquad_cascade_multi_df1_instance_q31 multiQ31;
+  float32_t *pChanIn = inF32 + HOST_MAX_SAMPLES;
+  uint32_t misF32 = 0u, misQ31 = 0u;
+  uint32_t i, k, ch;
+
+  filt_sos(FILT_STAGES, 1u);
+  host_signal(refIn, n * numCh, 0.25);
+  host_to_f32(refIn, inF32, n * numCh);
+  host_to_q31(refIn, inQ31, n * numCh);
+
+  /* Single-channel filters on the deinterleaved channels */
+  for (ch = 0u; ch < numCh; ch++)
+  {
+    for (i = 0u; i < n; i++)
+    {
+      pChanIn[(ch * n) + i] = inF32[(i * numCh) + ch];
+      multiInQ31[(ch * n) + i] = inQ31[(i * numCh) + ch];
+    }
+    arm_biquad_cascade_df2T_init_f32(&chanF32[0], FILT_STAGES, sosF32, stateF32);
+    arm_biquad_cascade_df2T_f32(&chanF32[0], &pChanIn[ch * n], &outF32[ch * n], n);
+    arm_biquad_cascade_df1_init_q31(&chanQ31[0], FILT_STAGES, sosQ31, stateQ31, 1);
+    arm_biquad_cascade_df1_q31(&chanQ31[0], &multiInQ31[ch * n], &outQ31[ch * n], n);
+  }
+
+  arm_biquad_cascade_multi_df2T_init_f32(&multiF32, FILT_STAGES, (uint16_t)numCh, sosF32, multiStateF32);
+  arm_biquad_cascade_multi_df1_init_q31(&multiQ31, FILT_STAGES, (uint16_t)numCh, sosQ31, multiStateQ31, 1);
+  for (i = 0u, k = 0u; i < n; i += calls[k], k++)
+  {
+    arm_biquad_cascade_multi_df2T_f32(&multiF32, &inF32[i * numCh], &multiOutF32[i * numCh], calls[k]);
+    arm_biquad_cascade_multi_df1_q31(&multiQ31, &inQ31[i * numCh], &multiOutQ31[i * numCh], calls[k]);
+  }
+
+  for (ch = 0u; ch < numCh; ch++)
+  {
+    for (i = 0u; i < n; i++)
+    {
+      misF32 += (multiOutF32[(i * numCh) + ch] != outF32[(ch * n) + i]);
+      misQ31 += (multiOutQ31[(i * numCh) + ch] != outQ31[(ch * n) + i]);
+    }
+  }
+  host_check_equal("biquad_multi_df2T_f32", numCh, misF32);
+  host_check_equal("biquad_multi_df1_q31", numCh, misQ31);
+}
+
+static void check_fir_partitioned(uint32_t numTaps, uint32_t partLen)
+{
+  const uint32_t blockSize = 2u * partLen;
+  const uint32_t n = (HOST_MAX_SAMPLES / blockSize) * blockSize;
+  arm_fir_partitioned_instance_f32 S;
+  arm_status status;
+  uint32_t k;
+
+  filt_taps(numTaps);
+  host_signal(refIn, n, 0.5);
+  host_to_f32(refIn, inF32, n);
+  for (k = 0u; k < numTaps; k++)
+  {
+    refTaps[k] = (double)tapsF32[numTaps - 1u - k];
+  }
+  for (k = 0u; k < n; k++)
+  {
+    refIn[k] = (double)inF32[k];
+  }
+  ref_fir(refIn, refOut, n, numTaps);
+
+  /* Partitions whose transform the real FFT does not support */
+  status = arm_fir_partitioned_init_f32(&S, (uint16_t)numTaps, tapsF32, partSpectraF32, partStateF32,
+                                        (uint16_t)(partLen + partLen / 2u));
+  host_check_equal("fir_partitioned_init_f32/len", partLen + partLen / 2u, status != ARM_MATH_ARGUMENT_ERROR);
+
+  status = arm_fir_partitioned_init_f32(&S, (uint16_t)numTaps, tapsF32, partSpectraF32, partStateF32,
+                                        (uint16_t)partLen);
+  host_check_equal("fir_partitioned_init_f32", partLen, status != ARM_MATH_SUCCESS);
+  for (k = 0u; k < n; k += blockSize)
+  {
+    arm_fir_partitioned_f32(&S, &inF32[k], &outF32[k], blockSize);
+  }
+  host_check_snr("fir_partitioned_f32", numTaps, host_snr_f32(refOut, outF32, n), 115.0);
+}
+
+static void check_biquad(uint32_t numStages)
+{
+  const uint32_t n = FILT_CHECK_SAMPLES;
+  double sos[HOST_MAX_STAGES * 5u];
+  uint32_t k, s;
+
+  filt_sos(numStages, 1u);
+  host_signal(refIn, 2u * n, 0.25);
+  host_to_f32(refIn, inF32, 2u * n);
+  host_to_q31(refIn, inQ31, n);
+  host_to_q15(refIn, inQ15, n);
+  for (k = 0u; k < n; k++)
+  {
+    inF64[k] = refIn[k];
+  }
+
+  ref_biquad(refSos, refIn, refOut, n, numStages, 1u);
+  {
+    arm_biquad_cascade_df2T_instance_f64 S;
+    arm_biquad_cascade_df2T_init_f64(&S, (uint8_t)numStages, sosF64, stateF64);
+    FILT_RUN(arm_biquad_cascade_df2T_f64, inF64, outF64);
+    host_check_snr("biquad_df2T_f64", numStages, host_snr_f64(refOut, outF64, n), 250.0);
+  }
+
+  for (k = 0u; k < (5u * numStages); k++)
+  {
+    sos[k] = (double)sosF32[k];
+  }
+  for (k = 0u; k < n; k++)
+  {
+    refIn[k] = (double)inF32[k];
+  }
+  ref_biquad(sos, refIn, refOut, n, numStages, 1u);
+  {
+    arm_biquad_casd_df1_inst_f32 S;
+    arm_biquad_cascade_df1_init_f32(&S, (uint8_t)numStages, sosF32, stateF32);
+    FILT_RUN(arm_biquad_cascade_df1_f32, inF32, outF32);
+    host_check_snr("biquad_df1_f32", numStages, host_snr_f32(refOut, outF32, n), 110.0);
+  }
+  {
+    arm_biquad_cascade_df2T_instance_f32 S;
+    arm_biquad_cascade_df2T_init_f32(&S, (uint8_t)numStages, sosF32, stateF32);
+    FILT_RUN(arm_biquad_cascade_df2T_f32, inF32, outF32);
+    host_check_snr("biquad_df2T_f32", numStages, host_snr_f32(refOut, outF32, n), 110.0);
+  }
+  {
+    /* Stereo: two interleaved channels of FILT_CHECK_BLOCK samples per call */
+    arm_biquad_cascade_stereo_df2T_instance_f32 S;
+    for (k = 0u; k < 2u * n; k++)
+    {
+      refIn[k] = (double)inF32[k];
+    }
+    arm_biquad_cascade_stereo_df2T_init_f32(&S, (uint8_t)numStages, sosF32, stateF32);
+    for (k = 0u; k < FILT_CHECK_CALLS; k++)
+    {
+      arm_biquad_cascade_stereo_df2T_f32(&S, &inF32[2u * k * FILT_CHECK_BLOCK],
+                                         &outF32[2u * k * FILT_CHECK_BLOCK], FILT_CHECK_BLOCK);
+    }
+    for (s = 0u; s < 2u; s++)
+    {
+      ref_biquad(sos, &refIn[s], refOut, n, numStages, 2u);
+      for (k = 0u; k < n; k++)
+      {
+        inF32[k] = outF32[2u * k + s];
+      }
+      host_check_snr(s == 0u ? "biquad_stereo_df2T_f32/l" : "biquad_stereo_df2T_f32/r", numStages,
+                     host_snr_f32(refOut, inF32, n), 110.0);
+    }
+  }
+
+  for (k = 0u; k < (5u * numStages); k++)
+  {
+    sos[k] = (double)sosQ31[k] / 1073741824.0;
+  }
+  for (k = 0u; k < n; k++)
+  {
+    refIn[k] = (double)inQ31[k] / 2147483648.0;
+  }
+  ref_biquad(sos, refIn, refOut, n, numStages, 1u);
+  {
+    arm_biquad_casd_df1_inst_q31 S;
+    arm_biquad_cascade_df1_init_q31(&S, (uint8_t)numStages, sosQ31, stateQ31, 1);
+    FILT_RUN(arm_biquad_cascade_df1_q31, inQ31, outQ31);
+    host_check_snr("biquad_df1_q31", numStages, host_snr_q31(refOut, outQ31, n, 1.0), 120.0);
+    arm_biquad_cascade_df1_init_q31(&S, (uint8_t)numStages, sosQ31, stateQ31, 1);
+    FILT_RUN(arm_biquad_cascade_df1_fast_q31, inQ31, outQ31);
+    host_check_snr("biquad_df1_fast_q31", numStages, host_snr_q31(refOut, outQ31, n, 1.0), 115.0);
+  }
+  {
+    arm_biquad_cas_df1_32x64_ins_q31 S;
+    arm_biquad_cas_df1_32x64_init_q31(&S, (uint8_t)numStages, sosQ31, stateQ63, 1u);
+    FILT_RUN(arm_biquad_cas_df1_32x64_q31, inQ31, outQ31);
+    host_check_snr("biquad_df1_32x64_q31", numStages, host_snr_q31(refOut, outQ31, n, 1.0), 150.0);
+  }
+
+  for (s = 0u; s < numStages; s++)
+  {
+    sos[5u * s] = (double)sosQ15[6u * s] / 16384.0;
+    for (k = 1u; k < 5u; k++)
+    {
+      sos[5u * s + k] = (double)sosQ15[6u * s + k + 1u] / 16384.0;
+    }
+  }
+  for (k = 0u; k < n; k++)
+  {
+    refIn[k] = (double)inQ15[k] / 32768.0;
+  }
+  ref_biquad(sos, refIn, refOut, n, numStages, 1u);
+  {
+    arm_biquad_casd_df1_inst_q15 S;
+    arm_biquad_cascade_df1_init_q15(&S, (uint8_t)numStages, sosQ15, stateQ15, 1);
+    FILT_RUN(arm_biquad_cascade_df1_q15, inQ15, outQ15);
+    host_check_snr("biquad_df1_q15", numStages, host_snr_q15(refOut, outQ15, n, 1.0), 25.0);
+    arm_biquad_cascade_df1_init_q15(&S, (uint8_t)numStages, sosQ15, stateQ15, 1);
+    FILT_RUN(arm_biquad_cascade_df1_fast_q15, inQ15, outQ15);
+    host_check_snr("biquad_df1_fast_q15", numStages, host_snr_q15(refOut, outQ15, n, 1.0), 25.0);
+  }
+}
+
+/**
+ * @brief  FFT convolution and correlation of an srcALen by srcBLen pair,
+ *         against double-precision references on the quantized inputs.
+ *         The names tell which form the length rule picked.
+ */
+static void check_conv_fft(uint32_t srcALen, uint32_t srcBLen)
+{
+  const uint32_t nConv = srcALen + srcBLen - 1u;
+  const uint32_t nCorr = 2u * ((srcALen > srcBLen) ? srcALen : srcBLen) - 1u;
+  const char *formF32 = (arm_conv_fft_len_f32(srcALen, srcBLen) != 0u) ? "fft" : "direct";
+  const char *formQ31 = (arm_conv_fft_len_q31(srcALen, srcBLen) != 0u) ? "fft" : "direct";
+  char name[48];
+  double sum = 0.0;
+  uint32_t k;
+
+  /* B sums to 0.9 in absolute value, so that no Q31 output overflows */
+  host_signal(convRefA, srcALen, 0.5);
+  host_signal(convRefB, srcBLen, 1.0);
+  for (k = 0u; k < srcBLen; k++)
+  {
+    sum += fabs(convRefB[k]);
+  }
+  for (k = 0u; k < srcBLen; k++)
+  {
+    convRefB[k] *= 0.9 / sum;
+  }
+
+  host_to_f32(convRefA, convAF32, srcALen);
+  host_to_f32(convRefB, convBF32, srcBLen);
+  for (k = 0u; k < srcALen; k++)
+  {
+    convRefA[k] = (double)convAF32[k];
+  }
+  for (k = 0u; k < srcBLen; k++)
+  {
+    convRefB[k] = (double)convBF32[k];
+  }
+
+  ref_conv(convRefA, srcALen, convRefB, srcBLen, convRefOut);
+  arm_conv_fft_f32(convAF32, srcALen, convBF32, srcBLen, convOutF32, convScratchF32);
+  snprintf(name, sizeof(name), "conv_fft_f32/%u/%s", srcBLen, formF32);
+  host_check_snr(name, srcALen, host_snr_f32(convRefOut, convOutF32, nConv), 115.0);
+
+  ref_correlate(convRefA, srcALen, convRefB, srcBLen, convRefOut);
+  arm_fill_f32(1.0f, convOutF32, nCorr);
+  arm_correlate_fft_f32(convAF32, srcALen, convBF32, srcBLen, convOutF32, convScratchF32);
+  snprintf(name, sizeof(name), "correlate_fft_f32/%u/%s", srcBLen, formF32);
+  host_check_snr(name, srcALen, host_snr_f32(convRefOut, convOutF32, nCorr), 115.0);
+
+  host_to_q31(convRefA, convAQ31, srcALen);
+  host_to_q31(convRefB, convBQ31, srcBLen);
+  for (k = 0u; k < srcALen; k++)
+  {
+    convRefA[k] = (double)convAQ31[k] / 2147483648.0;
+  }
+  for (k = 0u; k < srcBLen; k++)
+  {
+    convRefB[k] = (double)convBQ31[k] / 2147483648.0;
+  }
+
+  ref_conv(convRefA, srcALen, convRefB, srcBLen, convRefOut);
+  arm_conv_fft_q31(convAQ31, srcALen, convBQ31, srcBLen, convOutQ31, convScratchQ31);
+  snprintf(name, sizeof(name), "conv_fft_q31/%u/%s", srcBLen, formQ31);
+  host_check_snr(name, srcALen, host_snr_q31(convRefOut, convOutQ31, nConv, 1.0), 105.0);
+
+  ref_correlate(convRefA, srcALen, convRefB, srcBLen, convRefOut);
+  arm_fill_q31(0x7FFFFFFF, convOutQ31, nCorr);
+  arm_correlate_fft_q31(convAQ31, srcALen, convBQ31, srcBLen, convOutQ31, convScratchQ31);
+  snprintf(name, sizeof(name), "correlate_fft_q31/%u/%s", srcBLen, formQ31);
+  host_check_snr(name, srcALen, host_snr_q31(convRefOut, convOutQ31, nCorr, 1.0), 105.0);
+}
+
+#define FILT_DESIGN_POINTS      512u      /* frequencies of the response checks */
+#define FILT_DESIGN_TAPS        255u      /* longest equiripple design */
+
+static float32_t designF32[FILT_DESIGN_TAPS];
+static float64_t designScratch[42u * (FILT_DESIGN_TAPS + 1u) + 11u * 4u + 5u];
+
+/**
+ * @brief  Magnitude response at f (fraction of the sample rate) of a cascade
+ *         in the CMSIS layout, {b0, b1, b2, -a1, -a2} per stage.
+ */
+static double filt_sos_mag(const float32_t *pCoeffs, uint32_t numStages, double f)
+{
+  double c1 = cos(2.0 * PI * f), s1 = -sin(2.0 * PI * f);
+  double c2 = cos(4.0 * PI * f), s2 = -sin(4.0 * PI * f);
+  double nr, ni, dr, di, mag = 1.0;
+  uint32_t s;
+
+  for (s = 0u; s < numStages; s++, pCoeffs += 5u)
+  {
+    nr = pCoeffs[0] + pCoeffs[1] * c1 + pCoeffs[2] * c2;
+    ni = pCoeffs[1] * s1 + pCoeffs[2] * s2;
+    dr = 1.0 - pCoeffs[3] * c1 - pCoeffs[4] * c2;
+    di = -pCoeffs[3] * s1 - pCoeffs[4] * s2;
+    mag *= sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+  }
+  return mag;
+}
+
+/**
+ * @brief  Magnitude response at f of an FIR filter.
+ */
+static double filt_fir_mag(const float32_t *pCoeffs, uint32_t numTaps, double f)
+{
+  double re = 0.0, im = 0.0;
+  uint32_t k;
+
+  for (k = 0u; k < numTaps; k++)
+  {
+    re += pCoeffs[k] * cos(2.0 * PI * f * (double)k);
+    im -= pCoeffs[k] * sin(2.0 * PI * f * (double)k);
+  }
+  return sqrt(re * re + im * im);
+}
+
+static double filt_db(double mag)
+{
+  return 20.0 * log10(mag);
+}
+
+/**
+ * @brief  1 unless postShift is the smallest shift that brings the
+ *         numCoeffs coefficients within [-1 1).
+ */
+static uint32_t filt_bad_shift(const float32_t *pCoeffs, uint32_t numCoeffs, int8_t postShift)
+{
+  double maxAbs = 0.0;
+  uint32_t k;
+
+  for (k = 0u; k < numCoeffs; k++)
+  {
+    maxAbs = fmax(maxAbs, fabs(pCoeffs[k]));
+  }
+  return (maxAbs >= ldexp(1.0, postShift)) || ((postShift > 0) && (maxAbs < ldexp(1.0, postShift - 1)));
+}
+
+/**
+ * @brief  Butterworth and Chebyshev cascades against the analog prototype
+ *         mapped by the bilinear transform, and their Q31 and Q15 forms run
+ *         through the fixed-point cascades against the floating-point design.
+ */
+static void check_design_cascade(uint32_t order)
+{
+  const uint32_t numStages = (order + 1u) / 2u;
+  const uint32_t n = FILT_CHECK_SAMPLES;
+  const double fc = 0.1, ripple = 0.5;
+  const double eps2 = pow(10.0, ripple / 10.0) - 1.0;
+  double sos[HOST_MAX_STAGES * 5u];
+  double f, x, t, err, errCheb;
+  uint32_t i, k, hp, bad;
+  int8_t postShift;
+  arm_status status;
+
+  for (hp = 0u; hp < 2u; hp++)
+  {
+    arm_filter_type type = (hp != 0u) ? ARM_FILTER_HIGHPASS : ARM_FILTER_LOWPASS;
+
+    status = arm_biquad_design_butterworth_f32(type, (uint8_t)order, (float32_t)fc, sosF32);
+    status |= arm_biquad_design_chebyshev1_f32(type, (uint8_t)order, (float32_t)fc, (float32_t)ripple, &sosF32[5u * numStages]);
+
+    err = 0.0;
+    errCheb = 0.0;
+    for (i = 1u; i < FILT_DESIGN_POINTS; i++)
+    {
+      f = 0.5 * (double)i / (double)FILT_DESIGN_POINTS;
+      x = tan(PI * f) / tan(PI * fc);
+      x = (hp != 0u) ? (1.0 / x) : x;
+
+      /* |H|^2 = 1 / (1 + x^2n) and 1 / (1 + eps^2 Tn(x)^2) */
+      t = fabs(filt_sos_mag(sosF32, numStages, f) - 1.0 / sqrt(1.0 + pow(x, 2.0 * (double)order)));
+      err = (t > err) ? t : err;
+      t = (x <= 1.0) ? cos((double)order * acos(x)) : cosh((double)order * acosh(x));
+      t = fabs(filt_sos_mag(&sosF32[5u * numStages], numStages, f) - 1.0 / sqrt(1.0 + eps2 * t * t));
+      errCheb = (t > errCheb) ? t : errCheb;
+    }
+
+    /* Response errors of -80 dB relative to the passband */
+    host_check_equal(hp ? "design_butterworth_f32/hp" : "design_butterworth_f32/lp", order,
+                     (status != ARM_MATH_SUCCESS) + (err > 1e-4) +
+                     (fabs(filt_db(filt_sos_mag(sosF32, numStages, fc)) + 3.0103) > 1e-3));
+    host_check_equal(hp ? "design_chebyshev1_f32/hp" : "design_chebyshev1_f32/lp", order,
+                     (errCheb > 1e-4) +
+                     (fabs(filt_db(filt_sos_mag(&sosF32[5u * numStages], numStages, fc)) + ripple) > 1e-3));
+  }
+
+  /* The Butterworth low-pass in Q31 and Q15, against the floating-point design */
+  status = arm_biquad_design_butterworth_f32(ARM_FILTER_LOWPASS, (uint8_t)order, 0.2f, sosF32);
+  for (k = 0u; k < (5u * numStages); k++)
+  {
+    sos[k] = (double)sosF32[k];
+  }
+  host_signal(refIn, n, 0.25);
+  host_to_q31(refIn, inQ31, n);
+  for (k = 0u; k < n; k++)
+  {
+    refIn[k] = (double)inQ31[k] / 2147483648.0;
+  }
+  ref_biquad(sos, refIn, refOut, n, numStages, 1u);
+
+  bad = (arm_biquad_design_to_q31(sosF32, (uint8_t)numStages, sosQ31, &postShift) != ARM_MATH_SUCCESS);
+  bad += filt_bad_shift(sosF32, 5u * numStages, postShift);
+  {
+    arm_biquad_casd_df1_inst_q31 S;
+    arm_biquad_cascade_df1_init_q31(&S, (uint8_t)numStages, sosQ31, stateQ31, postShift);
+    FILT_RUN(arm_biquad_cascade_df1_q31, inQ31, outQ31);
+    host_check_equal("design_to_q31", order, bad);
+    host_check_snr("design_to_q31", order, host_snr_q31(refOut, outQ31, n, 1.0), 120.0);
+  }
+
+  host_to_q15(refIn, inQ15, n);
+  bad = (arm_biquad_design_to_q15(sosF32, (uint8_t)numStages, sosQ15, &postShift) != ARM_MATH_SUCCESS);
+  bad += filt_bad_shift(sosF32, 5u * numStages, postShift);
+  {
+    arm_biquad_casd_df1_inst_q15 S;
+    arm_biquad_cascade_df1_init_q15(&S, (uint8_t)numStages, sosQ15, stateQ15, postShift);
+    FILT_RUN(arm_biquad_cascade_df1_q15, inQ15, outQ15);
+    host_check_equal("design_to_q15", order, bad);
+    host_check_snr("design_to_q15", order, host_snr_q15(refOut, outQ15, n, 1.0), 40.0);
+  }
+}
+
+/**
+ * @brief  RBJ sections at their characteristic frequencies, and the postShift
+ *         of a high-gain section.
+ */
+static void check_design_rbj(void)
+{
+  const double f0 = 0.05, q = 2.0, g = 9.0;
+  float32_t c[5];
+  q31_t cQ31[5];
+  int8_t postShift;
+  uint32_t bad = 0u, i;
+
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_LOWPASS, (float32_t)f0, (float32_t)q, 0.0f, c) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_sos_mag(c, 1u, 0.0) - 1.0) > 1e-5) + (fabs(filt_sos_mag(c, 1u, f0) - q) > 1e-4);
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_HIGHPASS, (float32_t)f0, (float32_t)q, 0.0f, c) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_sos_mag(c, 1u, 0.5) - 1.0) > 1e-5) + (fabs(filt_sos_mag(c, 1u, f0) - q) > 1e-4);
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_BANDPASS, (float32_t)f0, (float32_t)q, 0.0f, c) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_sos_mag(c, 1u, f0) - 1.0) > 1e-5) + (filt_sos_mag(c, 1u, 0.0) > 1e-6);
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_BANDSTOP, (float32_t)f0, (float32_t)q, 0.0f, c) != ARM_MATH_SUCCESS);
+  bad += (filt_db(filt_sos_mag(c, 1u, f0)) > -80.0) + (fabs(filt_sos_mag(c, 1u, 0.5) - 1.0) > 1e-5);
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_PEAKING, (float32_t)f0, (float32_t)q, (float32_t)g, c) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_db(filt_sos_mag(c, 1u, f0)) - g) > 1e-3) + (fabs(filt_sos_mag(c, 1u, 0.0) - 1.0) > 1e-5);
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_LOWSHELF, (float32_t)f0, 0.7071f, (float32_t)g, c) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_db(filt_sos_mag(c, 1u, 0.0)) - g) > 1e-3) + (fabs(filt_db(filt_sos_mag(c, 1u, f0)) - g / 2.0) > 1e-3);
+  bad += (fabs(filt_sos_mag(c, 1u, 0.5) - 1.0) > 1e-5);
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_HIGHSHELF, (float32_t)f0, 0.7071f, (float32_t)-g, c) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_db(filt_sos_mag(c, 1u, 0.5)) + g) > 1e-3) + (fabs(filt_db(filt_sos_mag(c, 1u, f0)) + g / 2.0) > 1e-3);
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_ALLPASS, (float32_t)f0, (float32_t)q, 0.0f, c) != ARM_MATH_SUCCESS);
+  for (i = 0u; i <= 16u; i++)
+  {
+    bad += (fabs(filt_sos_mag(c, 1u, 0.5 * (double)i / 16.0) - 1.0) > 1e-5);
+  }
+  host_check_equal("design_rbj_f32", 8u, bad);
+
+  /* Out of range arguments */
+  bad = (arm_biquad_design_rbj_f32(ARM_FILTER_LOWPASS, 0.5f, 1.0f, 0.0f, c) != ARM_MATH_ARGUMENT_ERROR);
+  bad += (arm_biquad_design_rbj_f32(ARM_FILTER_LOWPASS, 0.1f, 0.0f, 0.0f, c) != ARM_MATH_ARGUMENT_ERROR);
+  bad += (arm_biquad_design_butterworth_f32(ARM_FILTER_BANDPASS, 4u, 0.1f, c) != ARM_MATH_ARGUMENT_ERROR);
+  bad += (arm_fir_design_window_f32(ARM_FILTER_HIGHPASS, 64u, 0.1f, 0.0f, ARM_WINDOW_HANN, 0.0f, designF32) != ARM_MATH_ARGUMENT_ERROR);
+  host_check_equal("design_rbj_f32/args", 4u, bad);
+
+  /* A wide +30 dB peak has b0 above 4, and needs a postShift of 3 */
+  bad = (arm_biquad_design_rbj_f32(ARM_FILTER_PEAKING, 0.1f, 0.3f, 30.0f, c) != ARM_MATH_SUCCESS);
+  bad += (arm_biquad_design_to_q31(c, 1u, cQ31, &postShift) != ARM_MATH_SUCCESS);
+  bad += (postShift != 3) + filt_bad_shift(c, 5u, postShift);
+  bad += (fabs((double)cQ31[0] / ldexp(1.0, 28) - c[0]) > 1e-8);
+  host_check_equal("design_to_q31/shift", 1u, bad);
+}
+
+/**
+ * @brief  Window designs: unit gain where the type has it, -6 dB at the
+ *         edges, and the stopband attenuation of the window.
+ */
+static void check_design_window(void)
+{
+  const uint32_t numTaps = 73u;
+  uint32_t bad = 0u, i;
+  double f, stop = 0.0;
+
+  /* Kaiser for 60 dB over a transition of 0.05 */
+  bad += (arm_fir_design_window_f32(ARM_FILTER_LOWPASS, numTaps, 0.2f, 0.0f, ARM_WINDOW_KAISER,
+                                    (float32_t)(0.1102 * (60.0 - 8.7)), designF32) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_fir_mag(designF32, numTaps, 0.0) - 1.0) > 1e-6);
+  bad += (fabs(filt_db(filt_fir_mag(designF32, numTaps, 0.2)) + 6.02) > 0.1);
+  for (i = 0u; i <= FILT_DESIGN_POINTS; i++)
+  {
+    f = 0.225 + 0.275 * (double)i / (double)FILT_DESIGN_POINTS;
+    stop = fmax(stop, filt_fir_mag(designF32, numTaps, f));
+  }
+  bad += (filt_db(stop) > -57.0);
+  host_check_equal("design_window_f32/kaiser", numTaps, bad);
+
+  bad = (arm_fir_design_window_f32(ARM_FILTER_HIGHPASS, numTaps, 0.2f, 0.0f, ARM_WINDOW_BLACKMAN, 0.0f, designF32) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_fir_mag(designF32, numTaps, 0.5) - 1.0) > 1e-6) + (filt_db(filt_fir_mag(designF32, numTaps, 0.1)) > -70.0);
+  bad += (arm_fir_design_window_f32(ARM_FILTER_BANDPASS, numTaps, 0.1f, 0.3f, ARM_WINDOW_HAMMING, 0.0f, designF32) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_fir_mag(designF32, numTaps, 0.2) - 1.0) > 1e-6) + (filt_db(filt_fir_mag(designF32, numTaps, 0.03)) > -50.0);
+  bad += (fabs(filt_db(filt_fir_mag(designF32, numTaps, 0.3)) + 6.02) > 0.1);
+  bad += (arm_fir_design_window_f32(ARM_FILTER_BANDSTOP, numTaps, 0.1f, 0.3f, ARM_WINDOW_HANN, 0.0f, designF32) != ARM_MATH_SUCCESS);
+  bad += (fabs(filt_fir_mag(designF32, numTaps, 0.0) - 1.0) > 1e-6) + (filt_db(filt_fir_mag(designF32, numTaps, 0.2)) > -40.0);
+  host_check_equal("design_window_f32", numTaps, bad);
+}
+
+/**
+ * @brief  Equiripple designs: the weighted errors of the bands ripple with
+ *         one magnitude, and the band edges meet it.
+ */
+static void check_design_remez(uint32_t numTaps, uint32_t numBands, const float32_t *pBands,
+                               const float32_t *pDesired, const float32_t *pWeights, double minAttenDb)
+{
+  char name[48];
+  double f, e, eMax[4] = { 0.0, 0.0, 0.0, 0.0 }, all = 0.0, least = 1.0;
+  uint32_t bad, b, i;
+
+  bad = (arm_fir_design_remez_f32((uint16_t)numTaps, (uint16_t)numBands, pBands, pDesired, pWeights,
+                                  designF32, designScratch) != ARM_MATH_SUCCESS);
+  for (b = 0u; b < numBands; b++)
+  {
+    for (i = 0u; i <= FILT_DESIGN_POINTS; i++)
+    {
+      f = pBands[2u * b] + (pBands[2u * b + 1u] - pBands[2u * b]) * (double)i / (double)FILT_DESIGN_POINTS;
+      e = pWeights[b] * fabs(filt_fir_mag(designF32, numTaps, f) - pDesired[b]);
+      eMax[b] = (e > eMax[b]) ? e : eMax[b];
+    }
+    all = (eMax[b] > all) ? eMax[b] : all;
+    least = (eMax[b] < least) ? eMax[b] : least;
+    if(pDesired[b] == 0.0f)
+    {
+      bad += (filt_db(eMax[b] / pWeights[b]) > -minAttenDb);
+    }
+  }
+
+  /* Equal weighted ripples, to the convergence tolerance and the float rounding of the taps */
+  bad += ((all - least) > 1e-2 * all);
+  snprintf(name, sizeof(name), "design_remez_f32/%ub", numBands);
+  host_check_equal(name, numTaps, bad);
+}
+
+static void check_design(void)
+{
+  static const float32_t lpBands[4] = { 0.0f, 0.1f, 0.15f, 0.5f };
+  static const float32_t lpDesired[2] = { 1.0f, 0.0f };
+  static const float32_t lpWeights[2] = { 1.0f, 10.0f };
+  static const float32_t bpBands[6] = { 0.0f, 0.1f, 0.15f, 0.3f, 0.35f, 0.5f };
+  static const float32_t bpDesired[3] = { 0.0f, 1.0f, 0.0f };
+  static const float32_t bpWeights[3] = { 1.0f, 1.0f, 1.0f };
+  static const float32_t narrowBands[4] = { 0.0f, 0.1f, 0.11f, 0.5f };
+
+  check_design_cascade(1u);
+  check_design_cascade(2u);
+  check_design_cascade(5u);
+  check_design_cascade(8u);
+  check_design_rbj();
+  check_design_window();
+  check_design_remez(45u, 2u, lpBands, lpDesired, lpWeights, 50.0);
+  check_design_remez(61u, 3u, bpBands, bpDesired, bpWeights, 40.0);
+  check_design_remez(255u, 2u, narrowBands, lpDesired, lpWeights, 55.0);
+}
+
+void check_filtering(void)
+{
+  check_fir(4u);
+  check_fir(29u);
+  check_fir(64u);
+  check_fir_partitioned(29u, 16u);
+  check_fir_partitioned(1000u, 64u);
+  check_fir_partitioned(2048u, 256u);
+  check_biquad(1u);
+  check_biquad(FILT_STAGES);
+  check_conv_fft(24u, 40u);
+  check_conv_fft(1000u, 200u);
+  check_conv_fft(150u, 3000u);
+  check_conv_fft(512u, 512u);
+  check_conv_fft(4096u, 2048u);
+  check_fir_circular(4u);
+  check_fir_circular(7u);
+  check_fir_circular(30u);
+  check_fir_circular(33u);
+  check_fir_circular(256u);
+  check_biquad_multi(1u);
+  check_biquad_multi(3u);
+  check_biquad_multi(8u);
+  check_biquad_multi(13u);
+  check_biquad_multi(16u);
+  check_design();
+}
@@ -0,0 +1,621 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        matrix.c
+*
+* Description:  Host benchmarks and golden checks of the matrix functions.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_suites.h"
+#if defined(ARM_HOST_SIMD)
+#include "arm_host_simd.h"
+#include "arm_host_matrix.h"
+#endif
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+#define MAT_MAX_ELEMS           (HOST_MAX_DIM * HOST_MAX_DIM)
+
+/* Factorizations: up to MAT_RHS right-hand sides, and matrices of up to
+ * HOST_MAX_DIM + MAT_QR_EXTRA rows for the overdetermined QR systems */
+#define MAT_RHS                 3u
+#define MAT_QR_EXTRA            3u
+#define MAT_MAX_RHS             ((HOST_MAX_DIM + MAT_QR_EXTRA) * MAT_RHS)
+#define MAT_MAX_FACTOR          ((HOST_MAX_DIM + MAT_QR_EXTRA) * HOST_MAX_DIM)
+
+static double    refA[MAT_MAX_FACTOR], refB[MAT_MAX_ELEMS], refC[MAT_MAX_ELEMS], refD[MAT_MAX_ELEMS];
+static float32_t aF32[MAT_MAX_FACTOR], bF32[MAT_MAX_ELEMS], cF32[MAT_MAX_ELEMS];
+static float64_t aF64[MAT_MAX_ELEMS], cF64[MAT_MAX_ELEMS];
+static q31_t     aQ31[MAT_MAX_ELEMS], bQ31[MAT_MAX_ELEMS], cQ31[MAT_MAX_ELEMS];
+static q15_t     aQ15[MAT_MAX_ELEMS], bQ15[MAT_MAX_ELEMS], cQ15[MAT_MAX_ELEMS];
+static q15_t     scratchQ15[MAT_MAX_ELEMS];
+
+static float32_t factorF32[MAT_MAX_FACTOR];
+static float32_t tauF32[HOST_MAX_DIM], scratchF32[HOST_MAX_DIM + MAT_QR_EXTRA];
+static uint16_t  pivots[HOST_MAX_DIM];
+static double    refX[MAT_MAX_RHS], refY[MAT_MAX_RHS];
+static float32_t xF32[MAT_MAX_RHS], yF32[MAT_MAX_RHS];
+
+/**
+ * @brief  Random n x n operands whose products cannot overflow the Q
+ *         formats: the entries are below 0.9 / sqrt(n).
+ */
+static void mat_operands(uint32_t n)
+{
+  const double amplitude = 0.9 / sqrt((double)n);
+
+  host_signal(refA, n * n, amplitude);
+  host_signal(refB, n * n, amplitude);
+  host_to_f32(refA, aF32, n * n);
+  host_to_f32(refB, bF32, n * n);
+  host_to_q31(refA, aQ31, n * n);
+  host_to_q31(refB, bQ31, n * n);
+  host_to_q15(refA, aQ15, n * n);
+  host_to_q15(refB, bQ15, n * n);
+}
+
+/**
+ * @brief  Random diagonally dominant matrix, well conditioned for the
+ *         inversions, in refA, aF32 and aF64.
+ */
+static void mat_invertible(uint32_t n)
+{
+  uint32_t i;
+
+  host_signal(refA, n * n, 1.0);
+  for (i = 0u; i < n; i++)
+  {
+    refA[i * n + i] += (double)n;
+  }
+  host_to_f32(refA, aF32, n * n);
+  for (i = 0u; i < n * n; i++)
+  {
+    refA[i] = (double)aF32[i];
+    aF64[i] = refA[i];
+  }
+}
+
+/**
+ * @brief  Symmetric part of the diagonally dominant matrix of
+ *         mat_invertible(), positive definite, in refA and aF32.
+ */
+static void mat_spd(uint32_t n)
+{
+  uint32_t i, j;
+
+  mat_invertible(n);
+  for (i = 0u; i < n; i++)
+  {
+    for (j = 0u; j < i; j++)
+    {
+      aF32[i * n + j] = aF32[j * n + i];
+      refA[i * n + j] = refA[j * n + i];
+    }
+  }
+}
+
+/**
+ * @brief  Double-precision product of two n x n matrices.
+ */
+static void ref_mult(const double *pA, const double *pB, double *pC, uint32_t n)
+{
+  double acc;
+  uint32_t i, j, k;
+
+  for (i = 0u; i < n; i++)
+  {
+    for (j = 0u; j < n; j++)
+    {
+      acc = 0.0;
+      for (k = 0u; k < n; k++)
+      {
+        acc += pA[i * n + k] * pB[k * n + j];
+      }
+      pC[i * n + j] = acc;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Benchmarks
+* -------------------------------------------------------------------- */
+typedef struct
+{
+  arm_matrix_instance_f32 aF32, bF32, cF32;
+  arm_matrix_instance_f64 aF64, cF64;
+  arm_matrix_instance_q31 aQ31, bQ31, cQ31;
+  arm_matrix_instance_q15 aQ15, bQ15, cQ15;
+  arm_matrix_instance_f32 bVec, xVec;
+  arm_mat_lu_instance_f32 lu;
+  arm_mat_cholesky_instance_f32 chol;
+  arm_mat_qr_instance_f32 qr;
+  uint32_t n;
+} mat_ctx_t;
+
+static void run_mult_f32(void *p)      { mat_ctx_t *c = p; arm_mat_mult_f32(&c->aF32, &c->bF32, &c->cF32); }
+static void run_mult_q31(void *p)      { mat_ctx_t *c = p; arm_mat_mult_q31(&c->aQ31, &c->bQ31, &c->cQ31); }
+static void run_mult_fast_q31(void *p) { mat_ctx_t *c = p; arm_mat_mult_fast_q31(&c->aQ31, &c->bQ31, &c->cQ31); }
+static void run_mult_q15(void *p)      { mat_ctx_t *c = p; arm_mat_mult_q15(&c->aQ15, &c->bQ15, &c->cQ15, scratchQ15); }
+static void run_mult_fast_q15(void *p) { mat_ctx_t *c = p; arm_mat_mult_fast_q15(&c->aQ15, &c->bQ15, &c->cQ15, scratchQ15); }
+static void run_add_f32(void *p)       { mat_ctx_t *c = p; arm_mat_add_f32(&c->aF32, &c->bF32, &c->cF32); }
+static void run_trans_f32(void *p)     { mat_ctx_t *c = p; arm_mat_trans_f32(&c->aF32, &c->cF32); }
+static void run_scale_f32(void *p)     { mat_ctx_t *c = p; arm_mat_scale_f32(&c->aF32, 0.5f, &c->cF32); }
+
+/* The inversions overwrite their source: it is restored on every call */
+static void run_inverse_f32(void *p)
+{
+  mat_ctx_t *c = p;
+  memcpy(bF32, aF32, c->n * c->n * sizeof(float32_t));
+  arm_mat_inverse_f32(&c->bF32, &c->cF32);
+}
+
+static void run_inverse_f64(void *p)
+{
+  mat_ctx_t *c = p;
+  memcpy(cF64, aF64, c->n * c->n * sizeof(float64_t));
+  arm_mat_inverse_f64(&c->cF64, &c->aF64);
+}
+
+static void run_lu_f32(void *p)             { mat_ctx_t *c = p; arm_mat_lu_f32(&c->lu, &c->aF32); }
+static void run_lu_solve_f32(void *p)       { mat_ctx_t *c = p; arm_mat_lu_solve_f32(&c->lu, &c->bVec, &c->xVec); }
+static void run_cholesky_f32(void *p)       { mat_ctx_t *c = p; arm_mat_cholesky_f32(&c->chol, &c->aF32); }
+static void run_cholesky_solve_f32(void *p) { mat_ctx_t *c = p; arm_mat_cholesky_solve_f32(&c->chol, &c->bVec, &c->xVec); }
+static void run_qr_f32(void *p)             { mat_ctx_t *c = p; arm_mat_qr_f32(&c->qr, &c->aF32); }
+static void run_qr_solve_f32(void *p)       { mat_ctx_t *c = p; arm_mat_qr_solve_f32(&c->qr, &c->bVec, &c->xVec, scratchF32); }
+
+static void mat_instances(mat_ctx_t *c, uint32_t n)
+{
+  c->n = n;
+  arm_mat_init_f32(&c->aF32, (uint16_t)n, (uint16_t)n, aF32);
+  arm_mat_init_f32(&c->bF32, (uint16_t)n, (uint16_t)n, bF32);
+  arm_mat_init_f32(&c->cF32, (uint16_t)n, (uint16_t)n, cF32);
+  c->aF64.numRows = c->aF64.numCols = (uint16_t)n;
+  c->aF64.pData = aF64;
+  c->cF64.numRows = c->cF64.numCols = (uint16_t)n;
+  c->cF64.pData = cF64;
+  arm_mat_init_q31(&c->aQ31, (uint16_t)n, (uint16_t)n, aQ31);
+  arm_mat_init_q31(&c->bQ31, (uint16_t)n, (uint16_t)n, bQ31);
+  arm_mat_init_q31(&c->cQ31, (uint16_t)n, (uint16_t)n, cQ31);
+  arm_mat_init_q15(&c->aQ15, (uint16_t)n, (uint16_t)n, aQ15);
+  arm_mat_init_q15(&c->bQ15, (uint16_t)n, (uint16_t)n, bQ15);
+  arm_mat_init_q15(&c->cQ15, (uint16_t)n, (uint16_t)n, cQ15);
+  arm_mat_init_f32(&c->bVec, (uint16_t)n, 1u, yF32);
+  arm_mat_init_f32(&c->xVec, (uint16_t)n, 1u, xF32);
+  arm_mat_lu_init_f32(&c->lu, (uint16_t)n, factorF32, pivots);
+  arm_mat_cholesky_init_f32(&c->chol, (uint16_t)n, factorF32);
+  arm_mat_qr_init_f32(&c->qr, (uint16_t)n, (uint16_t)n, factorF32, tauF32);
+}
+
+/* ----------------------------------------------------------------------
+*       Products up to 1024 x 1024
+* -------------------------------------------------------------------- */
+#define GEMM_MAX_DIM            1024u
+
+typedef struct
+{
+  arm_matrix_instance_f32 aF32, bF32, cF32;
+  arm_matrix_instance_q31 aQ31, bQ31, cQ31;
+} gemm_ctx_t;
+
+static void run_gemm_f32(void *p)   { gemm_ctx_t *c = p; arm_mat_mult_f32(&c->aF32, &c->bF32, &c->cF32); }
+static void run_gemm_q31(void *p)   { gemm_ctx_t *c = p; arm_mat_mult_q31(&c->aQ31, &c->bQ31, &c->cQ31); }
+#if defined(ARM_HOST_SIMD)
+static void run_gemm_f32_c(void *p) { gemm_ctx_t *c = p; arm_mat_mult_f32_c(&c->aF32, &c->bF32, &c->cF32); }
+static void run_gemm_q31_c(void *p) { gemm_ctx_t *c = p; arm_mat_mult_q31_c(&c->aQ31, &c->bQ31, &c->cQ31); }
+#endif
+
+/**
+ * @brief  Times an n x n product and prints its rate: 2 n^3 operations.
+ */
+static void gemm_bench(const char *name, uint32_t n, host_kernel_t kernel, gemm_ctx_t *c)
+{
+  double seconds = host_bench(name, n, n * n, kernel, c);
+
+  if ((seconds > 0.0) && (host_csv() == 0))
+  {
+    printf("%-28s %6u %14.2f GFLOP/s\n", name, n, 2.0 * (double)n * n * n / seconds * 1.0e-9);
+  }
+}
+
+/**
+ * @brief  Rates of arm_mat_mult_f32 and arm_mat_mult_q31 from 4 x 4 to
+ *         1024 x 1024; with SIMD=1, of the library kernels (_c) and of
+ *         the tiled products at every level the CPU supports.
+ */
+static void bench_gemm(void)
+{
+  gemm_ctx_t c;
+  float32_t *pF32;
+  q31_t *pQ31;
+  uint32_t n, i;
+#if defined(ARM_HOST_SIMD)
+  arm_host_simd_level current = arm_host_simd_current();
+  char name[48];
+  uint32_t level;
+#endif
+
+  pF32 = malloc(3u * GEMM_MAX_DIM * GEMM_MAX_DIM * sizeof(float32_t));
+  pQ31 = malloc(3u * GEMM_MAX_DIM * GEMM_MAX_DIM * sizeof(q31_t));
+  if ((pF32 == NULL) || (pQ31 == NULL))
+  {
+    printf("skip mat_gemm: out of memory\n");
+    free(pF32);
+    free(pQ31);
+    return;
+  }
+
+  for (n = 4u; n <= GEMM_MAX_DIM; n *= 2u)
+  {
+    for (i = 0u; i < 2u * n * n; i++)
+    {
+      pF32[i] = (float32_t)(host_uniform() / sqrt((double)n));
+      pQ31[i] = (q31_t)(pF32[i] * 2147483648.0f);
+    }
+    arm_mat_init_f32(&c.aF32, (uint16_t)n, (uint16_t)n, pF32);
+    arm_mat_init_f32(&c.bF32, (uint16_t)n, (uint16_t)n, pF32 + n * n);
+    arm_mat_init_f32(&c.cF32, (uint16_t)n, (uint16_t)n, pF32 + 2u * n * n);
+    arm_mat_init_q31(&c.aQ31, (uint16_t)n, (uint16_t)n, pQ31);
+    arm_mat_init_q31(&c.bQ31, (uint16_t)n, (uint16_t)n, pQ31 + n * n);
+    arm_mat_init_q31(&c.cQ31, (uint16_t)n, (uint16_t)n, pQ31 + 2u * n * n);
+
+#if defined(ARM_HOST_SIMD)
+    gemm_bench("mat_gemm_f32/lib", n, run_gemm_f32_c, &c);
+    for (level = 0u; level < ARM_HOST_SIMD_LEVELS; level++)
+    {
+      if (arm_host_simd_table((arm_host_simd_level)level) != NULL)
+      {
+        arm_host_simd_select((arm_host_simd_level)level);
+        snprintf(name, sizeof(name), "mat_gemm_f32/%s", arm_host_simd_name((arm_host_simd_level)level));
+        gemm_bench(name, n, run_gemm_f32, &c);
+      }
+    }
+    arm_host_simd_select(current);
+    gemm_bench("mat_gemm_q31/lib", n, run_gemm_q31_c, &c);
+    gemm_bench("mat_gemm_q31/tiled", n, run_gemm_q31, &c);
+#else
+    gemm_bench("mat_gemm_f32", n, run_gemm_f32, &c);
+    gemm_bench("mat_gemm_q31", n, run_gemm_q31, &c);
+#endif
+  }
+
+  free(pF32);
+  free(pQ31);
+}
+
+void bench_matrix(void)
+{
+  static const uint32_t dims[] = { 4u, 8u, 16u, 32u, 64u };
+  mat_ctx_t c;
+  uint32_t d, n;
+
+  for (d = 0u; d < (sizeof(dims) / sizeof(dims[0])); d++)
+  {
+    n = dims[d];
+    mat_operands(n);
+    mat_instances(&c, n);
+
+    host_bench("mat_mult_f32", n, n * n, run_mult_f32, &c);
+    host_bench("mat_mult_q31", n, n * n, run_mult_q31, &c);
+    host_bench("mat_mult_fast_q31", n, n * n, run_mult_fast_q31, &c);
+    host_bench("mat_mult_q15", n, n * n, run_mult_q15, &c);
+    host_bench("mat_mult_fast_q15", n, n * n, run_mult_fast_q15, &c);
+    host_bench("mat_add_f32", n, n * n, run_add_f32, &c);
+    host_bench("mat_scale_f32", n, n * n, run_scale_f32, &c);
+    host_bench("mat_trans_f32", n, n * n, run_trans_f32, &c);
+
+    mat_invertible(n);
+    host_bench("mat_inverse_f32", n, n * n, run_inverse_f32, &c);
+    host_bench("mat_inverse_f64", n, n * n, run_inverse_f64, &c);
+
+    /* Factorizations, and one right-hand side solved from the factors */
+    host_to_f32(refA, yF32, n);
+    host_bench("mat_lu_f32", n, n * n, run_lu_f32, &c);
+    host_bench("mat_lu_solve_f32", n, n, run_lu_solve_f32, &c);
+    host_bench("mat_qr_f32", n, n * n, run_qr_f32, &c);
+    host_bench("mat_qr_solve_f32", n, n, run_qr_solve_f32, &c);
+    mat_spd(n);
+    host_bench("mat_cholesky_f32", n, n * n, run_cholesky_f32, &c);
+    host_bench("mat_cholesky_solve_f32", n, n, run_cholesky_solve_f32, &c);
+  }
+
+  bench_gemm();
+}
+
+/* ----------------------------------------------------------------------
+*       Golden checks
+* -------------------------------------------------------------------- */
+
+static void check_dim(uint32_t n)
+{
+  mat_ctx_t c;
+  uint32_t i;
+
+  mat_operands(n);
+  mat_instances(&c, n);
+
+  for (i = 0u; i < n * n; i++)
+  {
+    refA[i] = (double)aF32[i];
+    refB[i] = (double)bF32[i];
+  }
+  ref_mult(refA, refB, refC, n);
+  arm_mat_mult_f32(&c.aF32, &c.bF32, &c.cF32);
+  host_check_snr("mat_mult_f32", n, host_snr_f32(refC, cF32, n * n), 120.0);
+
+  for (i = 0u; i < n * n; i++)
+  {
+    refC[i] = refA[i] + refB[i];
+  }
+  arm_mat_add_f32(&c.aF32, &c.bF32, &c.cF32);
+  host_check_snr("mat_add_f32", n, host_snr_f32(refC, cF32, n * n), 140.0);
+
+  for (i = 0u; i < n * n; i++)
+  {
+    refC[i] = refA[(i % n) * n + (i / n)];
+  }
+  arm_mat_trans_f32(&c.aF32, &c.cF32);
+  host_check_snr("mat_trans_f32", n, host_snr_f32(refC, cF32, n * n), 300.0);
+
+  for (i = 0u; i < n * n; i++)
+  {
+    refA[i] = (double)aQ31[i] / 2147483648.0;
+    refB[i] = (double)bQ31[i] / 2147483648.0;
+  }
+  ref_mult(refA, refB, refC, n);
+  arm_mat_mult_q31(&c.aQ31, &c.bQ31, &c.cQ31);
+  host_check_snr("mat_mult_q31", n, host_snr_q31(refC, cQ31, n * n, 1.0), 150.0);
+  arm_mat_mult_fast_q31(&c.aQ31, &c.bQ31, &c.cQ31);
+  host_check_snr("mat_mult_fast_q31", n, host_snr_q31(refC, cQ31, n * n, 1.0), 110.0);
+
+  for (i = 0u; i < n * n; i++)
+  {
+    refA[i] = (double)aQ15[i] / 32768.0;
+    refB[i] = (double)bQ15[i] / 32768.0;
+  }
+  ref_mult(refA, refB, refC, n);
+  arm_mat_mult_q15(&c.aQ15, &c.bQ15, &c.cQ15, scratchQ15);
+  host_check_snr("mat_mult_q15", n, host_snr_q15(refC, cQ15, n * n, 1.0), 58.0);
+  arm_mat_mult_fast_q15(&c.aQ15, &c.bQ15, &c.cQ15, scratchQ15);
+  host_check_snr("mat_mult_fast_q15", n, host_snr_q15(refC, cQ15, n * n, 1.0), 58.0);
+
+  /* Inverse: A * inv(A) is the identity */
+  mat_invertible(n);
+  for (i = 0u; i < n * n; i++)
+  {
+    refC[i] = ((i % (n + 1u)) == 0u) ? 1.0 : 0.0;
+  }
+  memcpy(bF32, aF32, n * n * sizeof(float32_t));
+  arm_mat_inverse_f32(&c.bF32, &c.cF32);
+  for (i = 0u; i < n * n; i++)
+  {
+    refB[i] = (double)cF32[i];
+  }
+  ref_mult(refA, refB, refD, n);
+  host_check_snr("mat_inverse_f32", n, host_snr_f64(refC, refD, n * n), 110.0);
+
+  memcpy(cF64, aF64, n * n * sizeof(float64_t));
+  arm_mat_inverse_f64(&c.cF64, &c.aF64);
+  ref_mult(refA, aF64, refD, n);
+  host_check_snr("mat_inverse_f64", n, host_snr_f64(refC, refD, n * n), 250.0);
+}
+
+#if defined(ARM_HOST_SIMD)
+/**
+ * @brief  Tiled products against the library kernels, bit for bit, on shapes
+ *         with partial tiles, inner dimensions over one packed sliver of A
+ *         and B, and row counts split among threads.
+ */
+static uint32_t gemm_mismatches(uint32_t M, uint32_t K, uint32_t N, uint32_t isQ31)
+{
+  const uint32_t sizeA = M * K, sizeB = K * N, sizeC = M * N;
+  arm_matrix_instance_f32 aF, bF, cF, dF;
+  arm_matrix_instance_q31 aQ, bQ, cQ, dQ;
+  float32_t *pF32 = malloc((sizeA + sizeB + 2u * sizeC) * sizeof(float32_t));
+  q31_t *pQ31 = malloc((sizeA + sizeB + 2u * sizeC) * sizeof(q31_t));
+  uint32_t i, bad = 0u;
+
+  if ((pF32 == NULL) || (pQ31 == NULL))
+  {
+    free(pF32);
+    free(pQ31);
+    return 1u;
+  }
+
+  for (i = 0u; i < sizeA + sizeB; i++)
+  {
+    pF32[i] = (float32_t)host_uniform();
+    pQ31[i] = (q31_t)(host_uniform() * 2147483648.0);
+  }
+
+  if (isQ31 != 0u)
+  {
+    arm_mat_init_q31(&aQ, (uint16_t)M, (uint16_t)K, pQ31);
+    arm_mat_init_q31(&bQ, (uint16_t)K, (uint16_t)N, pQ31 + sizeA);
+    arm_mat_init_q31(&cQ, (uint16_t)M, (uint16_t)N, pQ31 + sizeA + sizeB);
+    arm_mat_init_q31(&dQ, (uint16_t)M, (uint16_t)N, pQ31 + sizeA + sizeB + sizeC);
+    arm_mat_mult_q31(&aQ, &bQ, &cQ);
+    arm_mat_mult_q31_c(&aQ, &bQ, &dQ);
+    for (i = 0u; i < sizeC; i++)
+    {
+      bad += (cQ.pData[i] != dQ.pData[i]);
+    }
+  }
+  else
+  {
+    arm_mat_init_f32(&aF, (uint16_t)M, (uint16_t)K, pF32);
+    arm_mat_init_f32(&bF, (uint16_t)K, (uint16_t)N, pF32 + sizeA);
+    arm_mat_init_f32(&cF, (uint16_t)M, (uint16_t)N, pF32 + sizeA + sizeB);
+    arm_mat_init_f32(&dF, (uint16_t)M, (uint16_t)N, pF32 + sizeA + sizeB + sizeC);
+    arm_mat_mult_f32(&aF, &bF, &cF);
+    arm_mat_mult_f32_c(&aF, &bF, &dF);
+    bad += (uint32_t)(memcmp(cF.pData, dF.pData, sizeC * sizeof(float32_t)) != 0);
+  }
+
+  free(pF32);
+  free(pQ31);
+  return bad;
+}
+
+static void check_gemm(void)
+{
+  static const uint32_t shapes[][3] =
+  {
+    { 1u, 1u, 1u },    { 16u, 16u, 16u }, { 7u, 37u, 100u }, { 100u, 7u, 37u }, { 37u, 100u, 7u },
+    { 130u, 130u, 130u }, { 97u, 513u, 65u }, { 6u, 300u, 16u }, { 20u, 40u, 2100u }, { 60u, 1000u, 1000u }
+  };
+  static const uint32_t threads[] = { 1u, 3u };
+  const uint32_t numShapes = sizeof(shapes) / sizeof(shapes[0]);
+  arm_host_simd_level current = arm_host_simd_current();
+  char name[48];
+  uint32_t level, t, s, bad;
+
+  for (t = 0u; t < (sizeof(threads) / sizeof(threads[0])); t++)
+  {
+    arm_host_matrix_set_threads(threads[t]);
+
+    for (level = 0u; level < ARM_HOST_SIMD_LEVELS; level++)
+    {
+      if (arm_host_simd_table((arm_host_simd_level)level) == NULL)
+      {
+        continue;
+      }
+      arm_host_simd_select((arm_host_simd_level)level);
+
+      bad = 0u;
+      for (s = 0u; s < numShapes; s++)
+      {
+        bad += gemm_mismatches(shapes[s][0], shapes[s][1], shapes[s][2], 0u);
+      }
+      snprintf(name, sizeof(name), "mat_mult_f32/%s/%u", arm_host_simd_name((arm_host_simd_level)level), threads[t]);
+      host_check_equal(name, numShapes, bad);
+    }
+    arm_host_simd_select(current);
+
+    bad = 0u;
+    for (s = 0u; s < numShapes; s++)
+    {
+      bad += gemm_mismatches(shapes[s][0], shapes[s][1], shapes[s][2], 1u);
+    }
+    snprintf(name, sizeof(name), "mat_mult_q31/tiled/%u", threads[t]);
+    host_check_equal(name, numShapes, bad);
+  }
+
+  arm_host_matrix_set_threads(0u);
+}
+#endif /* defined(ARM_HOST_SIMD) */
+
+/**
+ * @brief  Right-hand sides B = A * X of MAT_RHS random solutions X, for an
+ *         m x n matrix A in refA: X in refX, B in yF32.
+ */
+static void factor_rhs(uint32_t m, uint32_t n)
+{
+  uint32_t i, j, k;
+
+  host_signal(refX, n * MAT_RHS, 1.0);
+  for (i = 0u; i < m; i++)
+  {
+    for (j = 0u; j < MAT_RHS; j++)
+    {
+      refY[i * MAT_RHS + j] = 0.0;
+      for (k = 0u; k < n; k++)
+      {
+        refY[i * MAT_RHS + j] += refA[i * n + k] * refX[k * MAT_RHS + j];
+      }
+    }
+  }
+  host_to_f32(refY, yF32, m * MAT_RHS);
+}
+
+/**
+ * @brief  Solutions of the factorizations against the double-precision
+ *         ones, and the detection of the singular matrices.
+ */
+static void check_factor(uint32_t n)
+{
+  const uint32_t m = n + MAT_QR_EXTRA;
+  arm_matrix_instance_f32 a, f, b, x;
+  arm_mat_lu_instance_f32 lu;
+  arm_mat_cholesky_instance_f32 chol;
+  arm_mat_qr_instance_f32 qr;
+  arm_status status;
+  uint32_t i;
+
+  arm_mat_init_f32(&b, (uint16_t)n, MAT_RHS, yF32);
+  arm_mat_init_f32(&x, (uint16_t)n, MAT_RHS, xF32);
+
+  /* LU of a general matrix, out of place */
+  mat_invertible(n);
+  factor_rhs(n, n);
+  arm_mat_init_f32(&a, (uint16_t)n, (uint16_t)n, aF32);
+  arm_mat_lu_init_f32(&lu, (uint16_t)n, factorF32, pivots);
+  status = arm_mat_lu_f32(&lu, &a);
+  status |= arm_mat_lu_solve_f32(&lu, &b, &x);
+  host_check_snr("mat_lu_solve_f32", n, (status == ARM_MATH_SUCCESS) ? host_snr_f32(refX, xF32, n * MAT_RHS) : 0.0, 100.0);
+
+  /* Cholesky of a positive definite matrix, factored and solved in place */
+  mat_spd(n);
+  factor_rhs(n, n);
+  memcpy(factorF32, aF32, n * n * sizeof(float32_t));
+  arm_mat_init_f32(&f, (uint16_t)n, (uint16_t)n, factorF32);
+  arm_mat_cholesky_init_f32(&chol, (uint16_t)n, factorF32);
+  status = arm_mat_cholesky_f32(&chol, &f);
+  status |= arm_mat_cholesky_solve_f32(&chol, &b, &b);
+  host_check_snr("mat_cholesky_solve_f32", n, (status == ARM_MATH_SUCCESS) ? host_snr_f32(refX, yF32, n * MAT_RHS) : 0.0, 100.0);
+
+  /* QR of a consistent overdetermined system, whose least-squares solution is exact */
+  host_signal(refA, m * n, 1.0);
+  host_to_f32(refA, aF32, m * n);
+  for (i = 0u; i < m * n; i++)
+  {
+    refA[i] = (double)aF32[i];
+  }
+  factor_rhs(m, n);
+  arm_mat_init_f32(&a, (uint16_t)m, (uint16_t)n, aF32);
+  arm_mat_init_f32(&b, (uint16_t)m, MAT_RHS, yF32);
+  arm_mat_qr_init_f32(&qr, (uint16_t)m, (uint16_t)n, factorF32, tauF32);
+  status = arm_mat_qr_f32(&qr, &a);
+  status |= arm_mat_qr_solve_f32(&qr, &b, &x, scratchF32);
+  host_check_snr("mat_qr_solve_f32", n, (status == ARM_MATH_SUCCESS) ? host_snr_f32(refX, xF32, n * MAT_RHS) : 0.0, 90.0);
+
+  /* A zero last column makes the three factorizations fail */
+  for (i = 0u; i < m; i++)
+  {
+    aF32[i * n + n - 1u] = 0.0f;
+  }
+  status = arm_mat_qr_f32(&qr, &a);
+  host_check_equal("mat_qr_f32/singular", n, status != ARM_MATH_SINGULAR);
+  arm_mat_init_f32(&a, (uint16_t)n, (uint16_t)n, aF32);
+  status = arm_mat_lu_f32(&lu, &a);
+  host_check_equal("mat_lu_f32/singular", n, status != ARM_MATH_SINGULAR);
+  status = arm_mat_cholesky_f32(&chol, &a);
+  host_check_equal("mat_cholesky_f32/singular", n, status != ARM_MATH_SINGULAR);
+}
+
+void check_matrix(void)
+{
+  uint32_t n;
+
+  for (n = 1u; n <= 16u; n++)
+  {
+    check_dim(n);
+  }
+  check_dim(HOST_MAX_DIM);
+
+#if defined(ARM_HOST_SIMD)
+  check_gemm();
+#endif
+
+  for (n = 1u; n <= 8u; n++)
+  {
+    check_factor(n);
+  }
+  check_factor(33u);
+  check_factor(HOST_MAX_DIM);
+}
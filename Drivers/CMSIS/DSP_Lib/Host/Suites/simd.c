@@ -0,0 +1,453 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        simd.c
+*
+* Description:  Host benchmarks of the x86 SIMD backend of the basic math
+*               and block fast math functions against the generic C
+*               kernels, and bit-exactness checks of every SSE2 and AVX2
+*               kernel the CPU supports.
+*
+* Target Processor: Host (x86, x86-64)
+* -------------------------------------------------------------------- */
+
+#if defined(ARM_HOST_SIMD)
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_suites.h"
+#include "arm_host_simd.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+#define SIMD_MAX_SAMPLES        1024u
+
+/* The operands start one sample into their buffers, so that the vector
+ * loads are misaligned */
+static double    refA[SIMD_MAX_SAMPLES], refB[SIMD_MAX_SAMPLES];
+static float32_t aF32[SIMD_MAX_SAMPLES + 1u], bF32[SIMD_MAX_SAMPLES + 1u];
+static q31_t     aQ31[SIMD_MAX_SAMPLES + 1u], bQ31[SIMD_MAX_SAMPLES + 1u];
+static q15_t     aQ15[SIMD_MAX_SAMPLES + 1u], bQ15[SIMD_MAX_SAMPLES + 1u];
+static q7_t      aQ7[SIMD_MAX_SAMPLES + 1u], bQ7[SIMD_MAX_SAMPLES + 1u];
+
+/* Arguments of the block fast math benchmarks, without the denormals of
+ * the operands, whose assists would dominate the timings */
+static float32_t argF32[SIMD_MAX_SAMPLES + 1u], arg2F32[SIMD_MAX_SAMPLES + 1u];
+
+/* Outputs of the C and of the vector kernels, with a guard sample on each
+ * side */
+static q63_t     outC[SIMD_MAX_SAMPLES + 2u], outV[SIMD_MAX_SAMPLES + 2u];
+
+#define A_F32   (aF32 + 1)
+#define B_F32   (bF32 + 1)
+#define A_Q31   (aQ31 + 1)
+#define B_Q31   (bQ31 + 1)
+#define A_Q15   (aQ15 + 1)
+#define B_Q15   (bQ15 + 1)
+#define A_Q7    (aQ7 + 1)
+#define B_Q7    (bQ7 + 1)
+#define ARG_F32 (argF32 + 1)
+#define ARG2_F32 (arg2F32 + 1)
+
+/**
+ * @brief  Full-range operands, with every pair of the extreme values of
+ *         the Q formats (minimum, maximum, -1 LSB, 0) on the multiples of
+ *         three, so that every saturation path is taken.
+ */
+static void simd_operands(uint32_t n)
+{
+  static const q31_t extQ31[4] = { INT32_MIN, INT32_MAX, -1, 0 };
+  static const q15_t extQ15[4] = { INT16_MIN, INT16_MAX, -1, 0 };
+  static const q7_t  extQ7[4]  = { INT8_MIN, INT8_MAX, -1, 0 };
+  static const float32_t extF32[4] = { -0.0f, 1.0e30f, -1.0e-40f, 0.0f };
+  uint32_t i;
+
+  host_signal(refA, n, 1.0);
+  host_signal(refB, n, 1.0);
+  host_to_f32(refA, A_F32, n);
+  host_to_f32(refB, B_F32, n);
+  host_to_q31(refA, A_Q31, n);
+  host_to_q31(refB, B_Q31, n);
+  host_to_q15(refA, A_Q15, n);
+  host_to_q15(refB, B_Q15, n);
+  host_to_q7(refA, A_Q7, n);
+  host_to_q7(refB, B_Q7, n);
+
+  for (i = 0u; i < n; i += 3u)
+  {
+    A_Q31[i] = extQ31[(i / 3u) % 4u];
+    B_Q31[i] = extQ31[(i / 12u) % 4u];
+    A_Q15[i] = extQ15[(i / 3u) % 4u];
+    B_Q15[i] = extQ15[(i / 12u) % 4u];
+    A_Q7[i]  = extQ7[(i / 3u) % 4u];
+    B_Q7[i]  = extQ7[(i / 12u) % 4u];
+    A_F32[i] = extF32[(i / 3u) % 4u];
+    B_F32[i] = extF32[(i / 12u) % 4u];
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Benchmarks
+* -------------------------------------------------------------------- */
+typedef struct
+{
+  const arm_host_simd_ops *ops;
+  uint32_t n;
+} simd_ctx_t;
+
+#define OPS (((simd_ctx_t *)p)->ops)
+#define N   (((simd_ctx_t *)p)->n)
+#define OUT_F32 ((float32_t *)outV)
+#define OUT_Q31 ((q31_t *)outV)
+#define OUT_Q15 ((q15_t *)outV)
+#define OUT_Q7  ((q7_t *)outV)
+
+static void run_add_f32(void *p)    { OPS->add_f32(A_F32, B_F32, OUT_F32, N); }
+static void run_add_q31(void *p)    { OPS->add_q31(A_Q31, B_Q31, OUT_Q31, N); }
+static void run_add_q15(void *p)    { OPS->add_q15(A_Q15, B_Q15, OUT_Q15, N); }
+static void run_add_q7(void *p)     { OPS->add_q7(A_Q7, B_Q7, OUT_Q7, N); }
+static void run_sub_f32(void *p)    { OPS->sub_f32(A_F32, B_F32, OUT_F32, N); }
+static void run_sub_q31(void *p)    { OPS->sub_q31(A_Q31, B_Q31, OUT_Q31, N); }
+static void run_sub_q15(void *p)    { OPS->sub_q15(A_Q15, B_Q15, OUT_Q15, N); }
+static void run_sub_q7(void *p)     { OPS->sub_q7(A_Q7, B_Q7, OUT_Q7, N); }
+static void run_mult_f32(void *p)   { OPS->mult_f32(A_F32, B_F32, OUT_F32, N); }
+static void run_mult_q31(void *p)   { OPS->mult_q31(A_Q31, B_Q31, OUT_Q31, N); }
+static void run_mult_q15(void *p)   { OPS->mult_q15(A_Q15, B_Q15, OUT_Q15, N); }
+static void run_mult_q7(void *p)    { OPS->mult_q7(A_Q7, B_Q7, OUT_Q7, N); }
+static void run_scale_f32(void *p)  { OPS->scale_f32(A_F32, 0.75f, OUT_F32, N); }
+static void run_scale_q31(void *p)  { OPS->scale_q31(A_Q31, 0x60000000, 1, OUT_Q31, N); }
+static void run_scale_q15(void *p)  { OPS->scale_q15(A_Q15, 0x6000, 1, OUT_Q15, N); }
+static void run_scale_q7(void *p)   { OPS->scale_q7(A_Q7, 0x60, 1, OUT_Q7, N); }
+static void run_offset_f32(void *p) { OPS->offset_f32(A_F32, 0.375f, OUT_F32, N); }
+static void run_offset_q31(void *p) { OPS->offset_q31(A_Q31, 0x30000000, OUT_Q31, N); }
+static void run_offset_q15(void *p) { OPS->offset_q15(A_Q15, 0x3000, OUT_Q15, N); }
+static void run_offset_q7(void *p)  { OPS->offset_q7(A_Q7, 0x30, OUT_Q7, N); }
+static void run_shift_q31(void *p)  { OPS->shift_q31(A_Q31, 1, OUT_Q31, N); }
+static void run_shift_q15(void *p)  { OPS->shift_q15(A_Q15, 1, OUT_Q15, N); }
+static void run_shift_q7(void *p)   { OPS->shift_q7(A_Q7, 1, OUT_Q7, N); }
+static void run_negate_f32(void *p) { OPS->negate_f32(A_F32, OUT_F32, N); }
+static void run_negate_q31(void *p) { OPS->negate_q31(A_Q31, OUT_Q31, N); }
+static void run_negate_q15(void *p) { OPS->negate_q15(A_Q15, OUT_Q15, N); }
+static void run_negate_q7(void *p)  { OPS->negate_q7(A_Q7, OUT_Q7, N); }
+static void run_abs_f32(void *p)    { OPS->abs_f32(A_F32, OUT_F32, N); }
+static void run_abs_q31(void *p)    { OPS->abs_q31(A_Q31, OUT_Q31, N); }
+static void run_abs_q15(void *p)    { OPS->abs_q15(A_Q15, OUT_Q15, N); }
+static void run_abs_q7(void *p)     { OPS->abs_q7(A_Q7, OUT_Q7, N); }
+static void run_dot_prod_f32(void *p) { OPS->dot_prod_f32(A_F32, B_F32, N, OUT_F32); }
+static void run_dot_prod_q31(void *p) { OPS->dot_prod_q31(A_Q31, B_Q31, N, outV); }
+static void run_dot_prod_q15(void *p) { OPS->dot_prod_q15(A_Q15, B_Q15, N, outV); }
+static void run_dot_prod_q7(void *p)  { OPS->dot_prod_q7(A_Q7, B_Q7, N, OUT_Q31); }
+static void run_sin_block_f32(void *p)   { OPS->sin_block_f32(ARG_F32, OUT_F32, N); }
+static void run_cos_block_f32(void *p)   { OPS->cos_block_f32(ARG_F32, OUT_F32, N); }
+static void run_sqrt_block_f32(void *p)  { OPS->sqrt_block_f32(ARG_F32, OUT_F32, N); }
+static void run_exp_block_f32(void *p)   { OPS->exp_block_f32(ARG_F32, OUT_F32, N); }
+static void run_log_block_f32(void *p)   { OPS->log_block_f32(ARG_F32, OUT_F32, N); }
+static void run_atan2_block_f32(void *p) { OPS->atan2_block_f32(ARG_F32, ARG2_F32, OUT_F32, N); }
+
+#undef OPS
+#undef N
+
+void bench_simd(void)
+{
+  static const struct
+  {
+    const char *name;
+    host_kernel_t run;
+  } kernels[] =
+  {
+    { "add_f32", run_add_f32 },       { "add_q31", run_add_q31 },       { "add_q15", run_add_q15 },
+    { "add_q7", run_add_q7 },         { "sub_f32", run_sub_f32 },       { "sub_q31", run_sub_q31 },
+    { "sub_q15", run_sub_q15 },       { "sub_q7", run_sub_q7 },         { "mult_f32", run_mult_f32 },
+    { "mult_q31", run_mult_q31 },     { "mult_q15", run_mult_q15 },     { "mult_q7", run_mult_q7 },
+    { "scale_f32", run_scale_f32 },   { "scale_q31", run_scale_q31 },   { "scale_q15", run_scale_q15 },
+    { "scale_q7", run_scale_q7 },     { "offset_f32", run_offset_f32 }, { "offset_q31", run_offset_q31 },
+    { "offset_q15", run_offset_q15 }, { "offset_q7", run_offset_q7 },   { "shift_q31", run_shift_q31 },
+    { "shift_q15", run_shift_q15 },   { "shift_q7", run_shift_q7 },     { "negate_f32", run_negate_f32 },
+    { "negate_q31", run_negate_q31 }, { "negate_q15", run_negate_q15 }, { "negate_q7", run_negate_q7 },
+    { "abs_f32", run_abs_f32 },       { "abs_q31", run_abs_q31 },       { "abs_q15", run_abs_q15 },
+    { "abs_q7", run_abs_q7 },         { "dot_prod_f32", run_dot_prod_f32 }, { "dot_prod_q31", run_dot_prod_q31 },
+    { "dot_prod_q15", run_dot_prod_q15 }, { "dot_prod_q7", run_dot_prod_q7 },
+    { "sin_block_f32", run_sin_block_f32 }, { "cos_block_f32", run_cos_block_f32 },
+    { "sqrt_block_f32", run_sqrt_block_f32 }, { "exp_block_f32", run_exp_block_f32 },
+    { "log_block_f32", run_log_block_f32 }, { "atan2_block_f32", run_atan2_block_f32 }
+  };
+  static const uint32_t sizes[] = { 64u, 1024u };
+  char name[48];
+  simd_ctx_t c;
+  uint32_t k, s, level;
+
+  simd_operands(SIMD_MAX_SAMPLES);
+  host_signal(refA, SIMD_MAX_SAMPLES, 10.0);
+  host_to_f32(refA, ARG_F32, SIMD_MAX_SAMPLES);
+  host_signal(refB, SIMD_MAX_SAMPLES, 10.0);
+  host_to_f32(refB, ARG2_F32, SIMD_MAX_SAMPLES);
+
+  for (k = 0u; k < (sizeof(kernels) / sizeof(kernels[0])); k++)
+  {
+    for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+    {
+      for (level = 0u; level < ARM_HOST_SIMD_LEVELS; level++)
+      {
+        c.ops = arm_host_simd_table((arm_host_simd_level)level);
+        c.n = sizes[s];
+        if (c.ops != NULL)
+        {
+          snprintf(name, sizeof(name), "%s/%s", kernels[k].name,
+                   arm_host_simd_name((arm_host_simd_level)level));
+          host_bench(name, c.n, c.n, kernels[k].run, &c);
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Bit-exactness checks
+* -------------------------------------------------------------------- */
+
+/* Index of every kernel of the backend */
+#define SIMD_INDEX(NAME, PARAMS, ARGS)  K_##NAME,
+#define SIMD_NAME(NAME, PARAMS, ARGS)   #NAME,
+
+enum { ARM_HOST_SIMD_KERNELS(SIMD_INDEX) SIMD_KERNELS };
+static const char *const simdKernelNames[SIMD_KERNELS] = { ARM_HOST_SIMD_KERNELS(SIMD_NAME) };
+
+#undef SIMD_INDEX
+#undef SIMD_NAME
+
+/**
+ * @brief  Count of the samples of size bytes that differ between outC and
+ *         outV, guard samples included.
+ */
+static uint32_t simd_mismatches(uint32_t n, uint32_t size)
+{
+  const uint8_t *pC = (const uint8_t *)outC, *pV = (const uint8_t *)outV;
+  uint32_t i, bad = 0u;
+
+  for (i = 0u; i < n; i++)
+  {
+    bad += (memcmp(pC + i * size, pV + i * size, size) != 0) ? 1u : 0u;
+  }
+
+  return bad;
+}
+
+/* Runs the C kernel and the vector kernel with the same arguments, DST
+ * naming their output, and adds the mismatches to the kernel */
+#define SIMD_COMPARE(NAME, TYPE, ARGS)                               \
+  do                                                                 \
+  {                                                                  \
+    TYPE *DST;                                                       \
+    memset(outC, 0x5A, sizeof(outC));                                \
+    memset(outV, 0x5A, sizeof(outV));                                \
+    DST = (TYPE *)outC + 1;                                          \
+    arm_##NAME##_c ARGS;                                             \
+    DST = (TYPE *)outV + 1;                                          \
+    ops->NAME ARGS;                                                  \
+    bad[K_##NAME] += simd_mismatches(n + 2u, sizeof(TYPE));          \
+  } while (0)
+
+/**
+ * @brief  Checks every kernel of a level on one block size.
+ */
+static void check_size(const arm_host_simd_ops *ops, uint32_t n, uint32_t *bad, double *snr)
+{
+  static const q31_t  fracQ31[] = { 0x60000000, INT32_MIN, INT32_MAX };
+  static const q15_t  fracQ15[] = { 0x6000, INT16_MIN, INT16_MAX };
+  static const q7_t   fracQ7[]  = { 0x60, INT8_MIN, INT8_MAX };
+  static const int8_t scaleShifts[] = { -3, -1, 0, 2 };
+  static const int8_t shiftQ31[] = { -31, -5, -1, 0, 1, 5, 31 };
+  static const int8_t shiftQ15[] = { -15, -5, -1, 0, 1, 5, 15 };
+  static const int8_t shiftQ7[]  = { -7, -3, -1, 0, 1, 3, 7 };
+  double dot = 0.0, test;
+  float32_t dotF32;
+  uint32_t i, f, s;
+
+  simd_operands(n);
+
+  SIMD_COMPARE(add_f32, float32_t, (A_F32, B_F32, DST, n));
+  SIMD_COMPARE(add_q31, q31_t, (A_Q31, B_Q31, DST, n));
+  SIMD_COMPARE(add_q15, q15_t, (A_Q15, B_Q15, DST, n));
+  SIMD_COMPARE(add_q7, q7_t, (A_Q7, B_Q7, DST, n));
+  SIMD_COMPARE(sub_f32, float32_t, (A_F32, B_F32, DST, n));
+  SIMD_COMPARE(sub_q31, q31_t, (A_Q31, B_Q31, DST, n));
+  SIMD_COMPARE(sub_q15, q15_t, (A_Q15, B_Q15, DST, n));
+  SIMD_COMPARE(sub_q7, q7_t, (A_Q7, B_Q7, DST, n));
+  SIMD_COMPARE(mult_f32, float32_t, (A_F32, B_F32, DST, n));
+  SIMD_COMPARE(mult_q31, q31_t, (A_Q31, B_Q31, DST, n));
+  SIMD_COMPARE(mult_q15, q15_t, (A_Q15, B_Q15, DST, n));
+  SIMD_COMPARE(mult_q7, q7_t, (A_Q7, B_Q7, DST, n));
+  SIMD_COMPARE(negate_f32, float32_t, (A_F32, DST, n));
+  SIMD_COMPARE(negate_q31, q31_t, (A_Q31, DST, n));
+  SIMD_COMPARE(negate_q15, q15_t, (A_Q15, DST, n));
+  SIMD_COMPARE(negate_q7, q7_t, (A_Q7, DST, n));
+  SIMD_COMPARE(abs_f32, float32_t, (A_F32, DST, n));
+  SIMD_COMPARE(abs_q31, q31_t, (A_Q31, DST, n));
+  SIMD_COMPARE(abs_q15, q15_t, (A_Q15, DST, n));
+  SIMD_COMPARE(abs_q7, q7_t, (A_Q7, DST, n));
+
+  SIMD_COMPARE(scale_f32, float32_t, (A_F32, -0.75f, DST, n));
+  SIMD_COMPARE(offset_f32, float32_t, (A_F32, 0.375f, DST, n));
+  for (f = 0u; f < 3u; f++)
+  {
+    SIMD_COMPARE(offset_q31, q31_t, (A_Q31, fracQ31[f], DST, n));
+    SIMD_COMPARE(offset_q15, q15_t, (A_Q15, fracQ15[f], DST, n));
+    SIMD_COMPARE(offset_q7, q7_t, (A_Q7, fracQ7[f], DST, n));
+    for (s = 0u; s < (sizeof(scaleShifts) / sizeof(scaleShifts[0])); s++)
+    {
+      SIMD_COMPARE(scale_q31, q31_t, (A_Q31, fracQ31[f], scaleShifts[s], DST, n));
+      SIMD_COMPARE(scale_q15, q15_t, (A_Q15, fracQ15[f], scaleShifts[s], DST, n));
+      SIMD_COMPARE(scale_q7, q7_t, (A_Q7, fracQ7[f], scaleShifts[s], DST, n));
+    }
+  }
+  for (s = 0u; s < (sizeof(shiftQ31) / sizeof(shiftQ31[0])); s++)
+  {
+    SIMD_COMPARE(shift_q31, q31_t, (A_Q31, shiftQ31[s], DST, n));
+    SIMD_COMPARE(shift_q15, q15_t, (A_Q15, shiftQ15[s], DST, n));
+    SIMD_COMPARE(shift_q7, q7_t, (A_Q7, shiftQ7[s], DST, n));
+  }
+
+  SIMD_COMPARE(dot_prod_q31, q63_t, (A_Q31, B_Q31, n, DST));
+  SIMD_COMPARE(dot_prod_q15, q63_t, (A_Q15, B_Q15, n, DST));
+  SIMD_COMPARE(dot_prod_q7, q31_t, (A_Q7, B_Q7, n, DST));
+
+  /* The float dot product sums in another order: checked by its SNR
+   * against a double-precision reference, on operands without the
+   * extremes */
+  host_signal(refA, n, 1.0);
+  host_signal(refB, n, 1.0);
+  host_to_f32(refA, A_F32, n);
+  host_to_f32(refB, B_F32, n);
+  for (i = 0u; i < n; i++)
+  {
+    dot += (double)A_F32[i] * (double)B_F32[i];
+  }
+  ops->dot_prod_f32(A_F32, B_F32, n, &dotF32);
+  test = (double)dotF32;
+  if (host_snr_f64(&dot, &test, 1u) < *snr)
+  {
+    *snr = host_snr_f64(&dot, &test, 1u);
+  }
+}
+
+/**
+ * @brief  Checks the block fast math functions of a level on one block
+ *         size, over several periods and beyond the range of exp, with
+ *         zeros, denormals, infinities and NaN on the multiples of three.
+ */
+static void check_fast_math(const arm_host_simd_ops *ops, uint32_t n, uint32_t *bad)
+{
+  static const float32_t extF32[8] = { -0.0f, 1.0e30f, -1.0e-40f, 0.0f,
+                                       INFINITY, NAN, 1.0e-40f, -INFINITY };
+  uint32_t i;
+
+  host_signal(refA, n, 1.0);
+  host_signal(refB, n, 1.0);
+  for (i = 0u; i < n; i++)
+  {
+    A_F32[i] = (float32_t)(100.0 * refA[i]);
+    B_F32[i] = (float32_t)(100.0 * refB[i]);
+  }
+  for (i = 0u; i < n; i += 3u)
+  {
+    A_F32[i] = extF32[(i / 3u) % 8u];
+    B_F32[i] = extF32[(i / 24u) % 8u];
+  }
+
+  SIMD_COMPARE(sin_block_f32, float32_t, (A_F32, DST, n));
+  SIMD_COMPARE(cos_block_f32, float32_t, (A_F32, DST, n));
+  SIMD_COMPARE(sqrt_block_f32, float32_t, (A_F32, DST, n));
+  SIMD_COMPARE(exp_block_f32, float32_t, (A_F32, DST, n));
+  SIMD_COMPARE(log_block_f32, float32_t, (A_F32, DST, n));
+  SIMD_COMPARE(atan2_block_f32, float32_t, (A_F32, B_F32, DST, n));
+}
+
+/**
+ * @brief  Checks the multi-channel Biquad cascade of a level on channel
+ *         counts around the vector widths: outputs and final states.
+ */
+static void check_biquad_multi(const arm_host_simd_ops *ops, uint32_t *bad)
+{
+  static const uint32_t channels[] = { 1u, 3u, 4u, 5u, 8u, 12u, 16u, 17u, 24u };
+  static float32_t sos[10] = { 0.0675f, 0.135f, 0.0675f, 1.1429f, -0.4128f,
+                               0.2929f, 0.5858f, 0.2929f, 0.0f, -0.1716f };
+  float32_t stateC[4u * 24u], stateV[4u * 24u];
+  arm_biquad_cascade_multi_df2T_instance_f32 S;
+  uint32_t k, numCh, frames, call;
+
+  /* A signal without the extremes, which the recursion would take to
+   * infinity */
+  host_signal(refA, SIMD_MAX_SAMPLES, 1.0);
+  host_to_f32(refA, A_F32, SIMD_MAX_SAMPLES);
+
+  for (k = 0u; k < (sizeof(channels) / sizeof(channels[0])); k++)
+  {
+    numCh = channels[k];
+    frames = SIMD_MAX_SAMPLES / numCh;
+    memset(outC, 0x5A, sizeof(outC));
+    memset(outV, 0x5A, sizeof(outV));
+
+    /* Two calls, to carry the state from one to the next */
+    arm_biquad_cascade_multi_df2T_init_f32(&S, 2u, (uint16_t)numCh, sos, stateC);
+    for (call = 0u; call < 2u; call++)
+    {
+      arm_biquad_cascade_multi_df2T_f32_c(&S, A_F32 + (call * (frames / 2u) * numCh),
+                                          (float32_t *)outC + 1 + (call * (frames / 2u) * numCh), frames / 2u);
+    }
+    arm_biquad_cascade_multi_df2T_init_f32(&S, 2u, (uint16_t)numCh, sos, stateV);
+    for (call = 0u; call < 2u; call++)
+    {
+      ops->biquad_cascade_multi_df2T_f32(&S, A_F32 + (call * (frames / 2u) * numCh),
+                                         (float32_t *)outV + 1 + (call * (frames / 2u) * numCh), frames / 2u);
+    }
+
+    bad[K_biquad_cascade_multi_df2T_f32] += simd_mismatches(2u * (frames / 2u) * numCh + 2u, sizeof(float32_t));
+    bad[K_biquad_cascade_multi_df2T_f32] += (memcmp(stateC, stateV, 4u * numCh * sizeof(float32_t)) != 0) ? 1u : 0u;
+  }
+}
+
+void check_simd(void)
+{
+  static const uint32_t sizes[] = { 1u, 2u, 3u, 7u, 15u, 16u, 17u, 31u, 32u, 33u, 64u, 65u, 255u, 1023u };
+  const arm_host_simd_ops *ops;
+  uint32_t bad[SIMD_KERNELS];
+  char name[48];
+  double snr;
+  uint32_t level, k, s;
+
+  for (level = ARM_HOST_SIMD_SSE2; level < ARM_HOST_SIMD_LEVELS; level++)
+  {
+    ops = arm_host_simd_table((arm_host_simd_level)level);
+    if (ops == NULL)
+    {
+      printf("skip %s: not supported by the CPU\n", arm_host_simd_name((arm_host_simd_level)level));
+      continue;
+    }
+
+    memset(bad, 0, sizeof(bad));
+    snr = 300.0;
+    for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+    {
+      check_size(ops, sizes[s], bad, &snr);
+      check_fast_math(ops, sizes[s], bad);
+    }
+    check_biquad_multi(ops, bad);
+
+    for (k = 0u; k < SIMD_KERNELS; k++)
+    {
+      snprintf(name, sizeof(name), "%s/%s", simdKernelNames[k], arm_host_simd_name((arm_host_simd_level)level));
+      if (k == K_dot_prod_f32)
+      {
+        host_check_snr(name, sizes[s - 1u], snr, 85.0);
+      }
+      else
+      {
+        host_check_equal(name, sizes[s - 1u], bad[k]);
+      }
+    }
+  }
+}
+
+#endif /* defined(ARM_HOST_SIMD) */
@@ -0,0 +1,784 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        statistics.c
+*
+* Description:  Host benchmarks and golden checks of the statistics
+*               functions.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_suites.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+static double    refIn[HOST_MAX_SAMPLES];
+static float32_t inF32[HOST_MAX_SAMPLES];
+static q31_t     inQ31[HOST_MAX_SAMPLES], scaledQ31[HOST_MAX_SAMPLES];
+static q15_t     inQ15[HOST_MAX_SAMPLES];
+static q7_t      inQ7[HOST_MAX_SAMPLES];
+
+/* Outputs of the sorts, copies for the selections, and radix scratch */
+static float32_t outF32[HOST_MAX_SAMPLES], refF32[HOST_MAX_SAMPLES];
+static q31_t     outQ31[HOST_MAX_SAMPLES], refQ31[HOST_MAX_SAMPLES], tmpQ31[HOST_MAX_SAMPLES];
+static q15_t     outQ15[HOST_MAX_SAMPLES], refQ15[HOST_MAX_SAMPLES], tmpQ15[HOST_MAX_SAMPLES];
+static q7_t      outQ7[HOST_MAX_SAMPLES], refQ7[HOST_MAX_SAMPLES];
+static uint32_t  hist[65536], refHist[256];
+
+/**
+ * @brief  Noise with a DC offset, so that the variance has a mean to remove.
+ */
+static void stat_signal(uint32_t n)
+{
+  uint32_t i;
+
+  host_signal(refIn, n, 0.4);
+  for (i = 0u; i < n; i++)
+  {
+    refIn[i] += 0.1;
+  }
+  host_to_f32(refIn, inF32, n);
+  host_to_q31(refIn, inQ31, n);
+  host_to_q15(refIn, inQ15, n);
+  host_to_q7(refIn, inQ7, n);
+}
+
+/* ----------------------------------------------------------------------
+*       Benchmarks
+* -------------------------------------------------------------------- */
+typedef struct
+{
+  uint32_t n;
+} stat_ctx_t;
+
+/* Wrapper of a kernel with a single result */
+#define STAT_RUN(NAME, IN, TYPE)                                     \
+  static void run_##NAME(void *p)                                    \
+  {                                                                  \
+    static TYPE result;                                              \
+    arm_##NAME(IN, ((stat_ctx_t *)p)->n, &result);                   \
+  }
+
+/* Wrapper of a kernel with a result and an index */
+#define STAT_RUN_INDEX(NAME, IN, TYPE)                               \
+  static void run_##NAME(void *p)                                    \
+  {                                                                  \
+    static TYPE result;                                              \
+    static uint32_t index;                                           \
+    arm_##NAME(IN, ((stat_ctx_t *)p)->n, &result, &index);           \
+  }
+
+STAT_RUN(mean_f32, inF32, float32_t)
+STAT_RUN(mean_q31, inQ31, q31_t)
+STAT_RUN(mean_q15, inQ15, q15_t)
+STAT_RUN(mean_q7, inQ7, q7_t)
+STAT_RUN(var_f32, inF32, float32_t)
+STAT_RUN(var_q31, inQ31, q31_t)
+STAT_RUN(var_q15, inQ15, q15_t)
+STAT_RUN(std_f32, inF32, float32_t)
+STAT_RUN(std_q31, inQ31, q31_t)
+STAT_RUN(std_q15, inQ15, q15_t)
+STAT_RUN(rms_f32, inF32, float32_t)
+STAT_RUN(rms_q31, inQ31, q31_t)
+STAT_RUN(rms_q15, inQ15, q15_t)
+STAT_RUN(power_f32, inF32, float32_t)
+STAT_RUN(power_q31, inQ31, q63_t)
+STAT_RUN(power_q15, inQ15, q63_t)
+STAT_RUN(power_q7, inQ7, q31_t)
+STAT_RUN_INDEX(max_f32, inF32, float32_t)
+STAT_RUN_INDEX(max_q31, inQ31, q31_t)
+STAT_RUN_INDEX(max_q15, inQ15, q15_t)
+STAT_RUN_INDEX(max_q7, inQ7, q7_t)
+STAT_RUN_INDEX(min_f32, inF32, float32_t)
+STAT_RUN_INDEX(min_q31, inQ31, q31_t)
+STAT_RUN_INDEX(min_q15, inQ15, q15_t)
+STAT_RUN_INDEX(min_q7, inQ7, q7_t)
+STAT_RUN(stats_f32, inF32, arm_stats_result_f32)
+STAT_RUN(stats_q31, inQ31, arm_stats_result_q31)
+
+/* Wrapper of an out-of-place sort */
+#define STAT_RUN_SORT(NAME, IN, OUT)                                 \
+  static void run_##NAME(void *p)                                    \
+  {                                                                  \
+    arm_##NAME(IN, OUT, ((stat_ctx_t *)p)->n);                       \
+  }
+
+/* Wrapper of a selection, which reorders a copy of the input */
+#define STAT_RUN_SELECT(NAME, IN, WORK, TYPE)                        \
+  static void run_##NAME(void *p)                                    \
+  {                                                                  \
+    static TYPE result;                                              \
+    memcpy(WORK, IN, ((stat_ctx_t *)p)->n * sizeof(TYPE));           \
+    arm_##NAME(WORK, ((stat_ctx_t *)p)->n, &result);                 \
+  }
+
+STAT_RUN_SORT(sort_f32, inF32, outF32)
+STAT_RUN_SORT(sort_bitonic_f32, inF32, outF32)
+STAT_RUN_SORT(sort_q7, inQ7, outQ7)
+STAT_RUN_SELECT(median_f32, inF32, outF32, float32_t)
+STAT_RUN_SELECT(median_q31, inQ31, outQ31, q31_t)
+STAT_RUN_SELECT(median_q15, inQ15, outQ15, q15_t)
+
+static void run_sort_q31(void *p)
+{
+  arm_sort_q31(inQ31, outQ31, tmpQ31, ((stat_ctx_t *)p)->n);
+}
+
+static void run_sort_q15(void *p)
+{
+  arm_sort_q15(inQ15, outQ15, tmpQ15, ((stat_ctx_t *)p)->n);
+}
+
+static void run_percentile_f32(void *p)
+{
+  static float32_t result;
+  memcpy(outF32, inF32, ((stat_ctx_t *)p)->n * sizeof(float32_t));
+  arm_percentile_f32(outF32, ((stat_ctx_t *)p)->n, 0.9f, &result);
+}
+
+static arm_median_filter_instance_f32 medianF32;
+static arm_median_filter_instance_q15 medianQ15;
+static float32_t medianStateF32[2u * 15u];
+static q15_t     medianStateQ15[2u * 15u];
+
+static void run_median_filter_f32(void *p)
+{
+  arm_median_filter_f32(&medianF32, inF32, outF32, ((stat_ctx_t *)p)->n);
+}
+
+static void run_median_filter_q15(void *p)
+{
+  arm_median_filter_q15(&medianQ15, inQ15, outQ15, ((stat_ctx_t *)p)->n);
+}
+
+/* 64 bins over the range of stat_signal(), [-0.3, 0.5] */
+static void run_histogram_f32(void *p)
+{
+  arm_histogram_f32(inF32, ((stat_ctx_t *)p)->n, -0.3f, 0.5f, 64u, hist);
+}
+
+static void run_histogram_q15(void *p)
+{
+  arm_histogram_q15(inQ15, ((stat_ctx_t *)p)->n, -9830, 16384, 64u, hist);
+}
+
+static void run_histogram_q7(void *p)
+{
+  arm_histogram_q7(inQ7, ((stat_ctx_t *)p)->n, -38, 64, 64u, hist);
+}
+
+void bench_statistics(void)
+{
+  static const struct
+  {
+    const char *name;
+    host_kernel_t run;
+  } kernels[] =
+  {
+    { "mean_f32", run_mean_f32 },   { "mean_q31", run_mean_q31 },   { "mean_q15", run_mean_q15 },
+    { "mean_q7", run_mean_q7 },     { "var_f32", run_var_f32 },     { "var_q31", run_var_q31 },
+    { "var_q15", run_var_q15 },     { "std_f32", run_std_f32 },     { "std_q31", run_std_q31 },
+    { "std_q15", run_std_q15 },     { "rms_f32", run_rms_f32 },     { "rms_q31", run_rms_q31 },
+    { "rms_q15", run_rms_q15 },     { "power_f32", run_power_f32 }, { "power_q31", run_power_q31 },
+    { "power_q15", run_power_q15 }, { "power_q7", run_power_q7 },   { "max_f32", run_max_f32 },
+    { "max_q31", run_max_q31 },     { "max_q15", run_max_q15 },     { "max_q7", run_max_q7 },
+    { "min_f32", run_min_f32 },     { "min_q31", run_min_q31 },     { "min_q15", run_min_q15 },
+    { "min_q7", run_min_q7 },       { "stats_f32", run_stats_f32 }, { "stats_q31", run_stats_q31 },
+    { "sort_f32", run_sort_f32 },   { "sort_bitonic_f32", run_sort_bitonic_f32 },
+    { "sort_q31", run_sort_q31 },   { "sort_q15", run_sort_q15 },   { "sort_q7", run_sort_q7 },
+    { "median_f32", run_median_f32 }, { "median_q31", run_median_q31 },
+    { "median_q15", run_median_q15 }, { "percentile_f32", run_percentile_f32 },
+    { "median_filter_f32", run_median_filter_f32 }, { "median_filter_q15", run_median_filter_q15 },
+    { "histogram_f32", run_histogram_f32 }, { "histogram_q15", run_histogram_q15 },
+    { "histogram_q7", run_histogram_q7 }
+  };
+  static const uint32_t sizes[] = { 64u, 256u, 1024u, 4096u };
+  stat_ctx_t c;
+  uint32_t k, s;
+
+  stat_signal(HOST_MAX_SAMPLES);
+  arm_median_filter_init_f32(&medianF32, 15u, medianStateF32);
+  arm_median_filter_init_q15(&medianQ15, 15u, medianStateQ15);
+
+  for (k = 0u; k < (sizeof(kernels) / sizeof(kernels[0])); k++)
+  {
+    for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+    {
+      c.n = sizes[s];
+      host_bench(kernels[k].name, c.n, c.n, kernels[k].run, &c);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Golden checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Double-precision references of one input.
+ */
+typedef struct
+{
+  double mean, var, std, rms, power;
+  double max, min;
+  uint32_t maxIndex, minIndex;
+} stat_ref_t;
+
+static void ref_stats(const double *pIn, uint32_t n, stat_ref_t *pRef)
+{
+  double sum = 0.0, sum2 = 0.0, d;
+  uint32_t i;
+
+  pRef->max = pRef->min = pIn[0];
+  pRef->maxIndex = pRef->minIndex = 0u;
+  for (i = 0u; i < n; i++)
+  {
+    sum += pIn[i];
+    sum2 += pIn[i] * pIn[i];
+    if (pIn[i] > pRef->max)
+    {
+      pRef->max = pIn[i];
+      pRef->maxIndex = i;
+    }
+    if (pIn[i] < pRef->min)
+    {
+      pRef->min = pIn[i];
+      pRef->minIndex = i;
+    }
+  }
+  pRef->mean = sum / (double)n;
+  pRef->power = sum2;
+  pRef->rms = sqrt(sum2 / (double)n);
+
+  /* Sample variance, as the library computes it */
+  sum2 = 0.0;
+  for (i = 0u; i < n; i++)
+  {
+    d = pIn[i] - pRef->mean;
+    sum2 += d * d;
+  }
+  pRef->var = (n > 1u) ? (sum2 / (double)(n - 1u)) : 0.0;
+  pRef->std = sqrt(pRef->var);
+}
+
+/**
+ * @brief  Smallest k with 2^k >= n.
+ */
+static uint32_t stat_log2(uint32_t n)
+{
+  uint32_t k = 0u;
+
+  while ((1u << k) < n)
+  {
+    k++;
+  }
+  return (k);
+}
+
+/**
+ * @brief  inQ31 shifted down by shift bits into scaledQ31, and read back
+ *         into refIn.
+ */
+static void stat_scale_q31(uint32_t n, uint32_t shift)
+{
+  uint32_t i;
+
+  for (i = 0u; i < n; i++)
+  {
+    scaledQ31[i] = inQ31[i] >> shift;
+    refIn[i] = (double)scaledQ31[i] / 2147483648.0;
+  }
+}
+
+static void stat_check(const char *name, uint32_t n, double ref, double test, double minSnr)
+{
+  host_check_snr(name, n, host_snr_f64(&ref, &test, 1u), minSnr);
+}
+
+static void check_size(uint32_t n)
+{
+  stat_ref_t ref;
+  float32_t rF32;
+  q31_t rQ31;
+  q15_t rQ15;
+  q7_t rQ7;
+  q63_t rQ63;
+  uint32_t i, index;
+
+  stat_signal(n);
+
+  for (i = 0u; i < n; i++)
+  {
+    refIn[i] = (double)inF32[i];
+  }
+  ref_stats(refIn, n, &ref);
+  arm_mean_f32(inF32, n, &rF32);
+  stat_check("mean_f32", n, ref.mean, rF32, 100.0);
+  arm_power_f32(inF32, n, &rF32);
+  stat_check("power_f32", n, ref.power, rF32, 100.0);
+  arm_rms_f32(inF32, n, &rF32);
+  stat_check("rms_f32", n, ref.rms, rF32, 100.0);
+  if (n > 1u)
+  {
+    arm_var_f32(inF32, n, &rF32);
+    stat_check("var_f32", n, ref.var, rF32, 80.0);
+    arm_std_f32(inF32, n, &rF32);
+    stat_check("std_f32", n, ref.std, rF32, 80.0);
+  }
+  arm_max_f32(inF32, n, &rF32, &index);
+  host_check_equal("max_f32", n, (rF32 != (float32_t)ref.max) + (index != ref.maxIndex));
+  arm_min_f32(inF32, n, &rF32, &index);
+  host_check_equal("min_f32", n, (rF32 != (float32_t)ref.min) + (index != ref.minIndex));
+
+  for (i = 0u; i < n; i++)
+  {
+    refIn[i] = (double)inQ31[i] / 2147483648.0;
+  }
+  ref_stats(refIn, n, &ref);
+  arm_mean_q31(inQ31, n, &rQ31);
+  stat_check("mean_q31", n, ref.mean, (double)rQ31 / 2147483648.0, 140.0);
+  arm_power_q31(inQ31, n, &rQ63);
+  stat_check("power_q31", n, ref.power, (double)rQ63 / 281474976710656.0, 120.0);
+  arm_max_q31(inQ31, n, &rQ31, &index);
+  host_check_equal("max_q31", n, (rQ31 != inQ31[ref.maxIndex]) + (index != ref.maxIndex));
+  arm_min_q31(inQ31, n, &rQ31, &index);
+  host_check_equal("min_q31", n, (rQ31 != inQ31[ref.minIndex]) + (index != ref.minIndex));
+
+  /* The Q31 rms and variance accumulators wrap unless the input is scaled
+   * down: the rms sums squares with a single guard bit, so half of
+   * log2(blockSize) bits are enough, and the variance needs
+   * log2(blockSize) - 8 bits, as documented. */
+  stat_scale_q31(n, (stat_log2(n) + 1u) / 2u);
+  ref_stats(refIn, n, &ref);
+  arm_rms_q31(scaledQ31, n, &rQ31);
+  stat_check("rms_q31", n, ref.rms, (double)rQ31 / 2147483648.0, 90.0);
+  if (n > 1u)
+  {
+    stat_scale_q31(n, (stat_log2(n) > 8u) ? (stat_log2(n) - 8u) : 0u);
+    ref_stats(refIn, n, &ref);
+    arm_var_q31(scaledQ31, n, &rQ31);
+    stat_check("var_q31", n, ref.var, (double)rQ31 / 2147483648.0, 80.0);
+    arm_std_q31(scaledQ31, n, &rQ31);
+    stat_check("std_q31", n, ref.std, (double)rQ31 / 2147483648.0, 80.0);
+  }
+
+  for (i = 0u; i < n; i++)
+  {
+    refIn[i] = (double)inQ15[i] / 32768.0;
+  }
+  ref_stats(refIn, n, &ref);
+  arm_mean_q15(inQ15, n, &rQ15);
+  stat_check("mean_q15", n, ref.mean, (double)rQ15 / 32768.0, 45.0);
+  arm_power_q15(inQ15, n, &rQ63);
+  stat_check("power_q15", n, ref.power, (double)rQ63 / 1073741824.0, 250.0);
+  arm_rms_q15(inQ15, n, &rQ15);
+  stat_check("rms_q15", n, ref.rms, (double)rQ15 / 32768.0, 60.0);
+  if (n > 1u)
+  {
+    arm_var_q15(inQ15, n, &rQ15);
+    stat_check("var_q15", n, ref.var, (double)rQ15 / 32768.0, 40.0);
+    arm_std_q15(inQ15, n, &rQ15);
+    stat_check("std_q15", n, ref.std, (double)rQ15 / 32768.0, 50.0);
+  }
+  arm_max_q15(inQ15, n, &rQ15, &index);
+  host_check_equal("max_q15", n, (rQ15 != inQ15[ref.maxIndex]) + (index != ref.maxIndex));
+  arm_min_q15(inQ15, n, &rQ15, &index);
+  host_check_equal("min_q15", n, (rQ15 != inQ15[ref.minIndex]) + (index != ref.minIndex));
+
+  for (i = 0u; i < n; i++)
+  {
+    refIn[i] = (double)inQ7[i] / 128.0;
+  }
+  ref_stats(refIn, n, &ref);
+  arm_mean_q7(inQ7, n, &rQ7);
+  stat_check("mean_q7", n, ref.mean, (double)rQ7 / 128.0, 20.0);
+  arm_power_q7(inQ7, n, &rQ31);
+  stat_check("power_q7", n, ref.power, (double)rQ31 / 16384.0, 250.0);
+  arm_max_q7(inQ7, n, &rQ7, &index);
+  host_check_equal("max_q7", n, (rQ7 != inQ7[ref.maxIndex]) + (index != ref.maxIndex));
+  arm_min_q7(inQ7, n, &rQ7, &index);
+  host_check_equal("min_q7", n, (rQ7 != inQ7[ref.minIndex]) + (index != ref.minIndex));
+}
+
+/**
+ * @brief  Fused statistics against the references and the separate functions.
+ */
+static void check_fused(uint32_t n)
+{
+  static const uint32_t chunks[] = { 1u, 5u, 64u, 13u, 100u, 2u };
+  stat_ref_t ref;
+  arm_stats_result_f32 rF32, sF32;
+  arm_stats_result_q31 rQ31;
+  arm_stats_instance_f32 S;
+  q31_t mean, var, std, rms, minVal, maxVal;
+  uint32_t i, k, len, shift, minIndex, maxIndex;
+
+  stat_signal(n);
+
+  /* One-shot, then with a large offset that cancels in arm_var_f32() */
+  for (k = 0u; k < 2u; k++)
+  {
+    for (i = 0u; i < n; i++)
+    {
+      inF32[i] += (k == 0u) ? 0.0f : 1000.0f;
+      refIn[i] = (double)inF32[i];
+    }
+    ref_stats(refIn, n, &ref);
+    arm_stats_f32(inF32, n, &rF32);
+    stat_check("stats_f32 mean", n, ref.mean, rF32.mean, 100.0);
+    stat_check("stats_f32 rms", n, ref.rms, rF32.rms, 100.0);
+    if (n > 1u)
+    {
+      stat_check("stats_f32 var", n, ref.var, rF32.var, 80.0);
+      stat_check("stats_f32 std", n, ref.std, rF32.std, 80.0);
+    }
+    host_check_equal("stats_f32 extrema", n,
+                     (rF32.min != (float32_t)ref.min) + (rF32.minIndex != ref.minIndex) +
+                     (rF32.max != (float32_t)ref.max) + (rF32.maxIndex != ref.maxIndex));
+  }
+
+  /* Streaming in uneven blocks */
+  arm_stats_init_f32(&S);
+  for (i = 0u, k = 0u; i < n; i += len, k++)
+  {
+    len = chunks[k % (sizeof(chunks) / sizeof(chunks[0]))];
+    len = (len < (n - i)) ? len : (n - i);
+    arm_stats_update_f32(&S, inF32 + i, len);
+  }
+  arm_stats_get_f32(&S, &sF32);
+  stat_check("stats_f32 stream mean", n, rF32.mean, sF32.mean, 100.0);
+  stat_check("stats_f32 stream rms", n, rF32.rms, sF32.rms, 100.0);
+  if (n > 1u)
+  {
+    stat_check("stats_f32 stream var", n, rF32.var, sF32.var, 80.0);
+  }
+  host_check_equal("stats_f32 stream extrema", n,
+                   (sF32.min != rF32.min) + (sF32.minIndex != rF32.minIndex) +
+                   (sF32.max != rF32.max) + (sF32.maxIndex != rF32.maxIndex));
+
+  /* Q31, bit for bit, on an input scaled for both the rms and the variance */
+  shift = (stat_log2(n) + 1u) / 2u;
+  if ((stat_log2(n) > 8u) && ((stat_log2(n) - 8u) > shift))
+  {
+    shift = stat_log2(n) - 8u;
+  }
+  stat_scale_q31(n, shift);
+  arm_stats_q31(scaledQ31, n, &rQ31);
+  arm_mean_q31(scaledQ31, n, &mean);
+  arm_rms_q31(scaledQ31, n, &rms);
+  arm_min_q31(scaledQ31, n, &minVal, &minIndex);
+  arm_max_q31(scaledQ31, n, &maxVal, &maxIndex);
+  var = 0;
+  std = 0;
+  if (n > 1u)
+  {
+    arm_var_q31(scaledQ31, n, &var);
+    arm_std_q31(scaledQ31, n, &std);
+  }
+  host_check_equal("stats_q31", n,
+                   (rQ31.mean != mean) + (rQ31.var != var) + (rQ31.std != std) + (rQ31.rms != rms) +
+                   (rQ31.min != minVal) + (rQ31.minIndex != minIndex) +
+                   (rQ31.max != maxVal) + (rQ31.maxIndex != maxIndex));
+}
+
+static int cmp_f32(const void *a, const void *b)
+{
+  float32_t x = *(const float32_t *)a, y = *(const float32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_q31(const void *a, const void *b)
+{
+  q31_t x = *(const q31_t *)a, y = *(const q31_t *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_q15(const void *a, const void *b)
+{
+  return (int)*(const q15_t *)a - (int)*(const q15_t *)b;
+}
+
+static int cmp_q7(const void *a, const void *b)
+{
+  return (int)*(const q7_t *)a - (int)*(const q7_t *)b;
+}
+
+/**
+ * @brief  Mismatches of a sort against qsort(), out of place then in place.
+ */
+static uint32_t sort_mismatches_f32(uint32_t n, int bitonic)
+{
+  uint32_t i, bad = 0u;
+
+  memcpy(refF32, inF32, n * sizeof(float32_t));
+  qsort(refF32, n, sizeof(float32_t), cmp_f32);
+  if (bitonic)
+  {
+    arm_sort_bitonic_f32(inF32, outF32, n);
+  }
+  else
+  {
+    arm_sort_f32(inF32, outF32, n);
+  }
+  bad += (uint32_t)(memcmp(outF32, refF32, n * sizeof(float32_t)) != 0);
+
+  memcpy(outF32, inF32, n * sizeof(float32_t));
+  if (bitonic)
+  {
+    arm_sort_bitonic_f32(outF32, outF32, n);
+  }
+  else
+  {
+    arm_sort_f32(outF32, outF32, n);
+  }
+  for (i = 0u; i < n; i++)
+  {
+    bad += (outF32[i] != refF32[i]);
+  }
+  return (bad);
+}
+
+/**
+ * @brief  Brute-force running median of inF32 and inQ15, from a window of zeros.
+ */
+static uint32_t median_filter_mismatches(uint32_t n, uint16_t window)
+{
+  static float32_t stateF32[2u * 64u], winF32[64u];
+  static q15_t stateQ15[2u * 64u], winQ15[64u];
+  arm_median_filter_instance_f32 SF32;
+  arm_median_filter_instance_q15 SQ15;
+  uint32_t i, j, mid = window / 2u, bad = 0u;
+  float32_t refF;
+  q15_t refQ;
+
+  arm_median_filter_init_f32(&SF32, window, stateF32);
+  arm_median_filter_init_q15(&SQ15, window, stateQ15);
+
+  /* Two blocks, the second one in place */
+  memcpy(outF32, inF32, n * sizeof(float32_t));
+  memcpy(outQ15, inQ15, n * sizeof(q15_t));
+  arm_median_filter_f32(&SF32, inF32, outF32, n / 3u);
+  arm_median_filter_f32(&SF32, outF32 + (n / 3u), outF32 + (n / 3u), n - (n / 3u));
+  arm_median_filter_q15(&SQ15, inQ15, outQ15, n / 3u);
+  arm_median_filter_q15(&SQ15, outQ15 + (n / 3u), outQ15 + (n / 3u), n - (n / 3u));
+
+  for (i = 0u; i < n; i++)
+  {
+    for (j = 0u; j < window; j++)
+    {
+      winF32[j] = (i + j + 1u >= window) ? inF32[i + j + 1u - window] : 0.0f;
+      winQ15[j] = (i + j + 1u >= window) ? inQ15[i + j + 1u - window] : 0;
+    }
+    qsort(winF32, window, sizeof(float32_t), cmp_f32);
+    qsort(winQ15, window, sizeof(q15_t), cmp_q15);
+    refF = (window & 1u) ? winF32[mid] : (0.5f * (winF32[mid - 1u] + winF32[mid]));
+    refQ = (window & 1u) ? winQ15[mid] : (q15_t)(((q31_t)winQ15[mid - 1u] + winQ15[mid]) >> 1);
+    bad += (outF32[i] != refF) + (outQ15[i] != refQ);
+  }
+  return (bad);
+}
+
+/**
+ * @brief  Sorts, medians, percentiles, running medians and histograms
+ *         against qsort() and brute-force references.
+ */
+static void check_order(uint32_t n)
+{
+  static const float32_t percents[] = { 0.0f, 0.1f, 0.5f, 0.9f, 0.999f, 1.0f };
+  float32_t rF32, pos, frac;
+  q31_t rQ31, pQ31;
+  q15_t rQ15, pQ15;
+  q63_t posQ;
+  uint32_t i, k, bad, pattern;
+
+  for (pattern = 0u; pattern < 4u; pattern++)
+  {
+    /* Noise, then sorted, reversed, and few distinct values */
+    stat_signal(n);
+    for (i = 0u; (pattern > 0u) && (i < n); i++)
+    {
+      inF32[i] = (pattern == 1u) ? (float32_t)i : ((pattern == 2u) ? (float32_t)(n - i) : (float32_t)(i % 5u));
+    }
+    host_check_equal("sort_f32", n, sort_mismatches_f32(n, 0));
+    host_check_equal("sort_bitonic_f32", n, sort_mismatches_f32(n, 1));
+  }
+
+  /* Radix sorts, also on a small signal whose upper digits are all equal */
+  stat_signal(n);
+  for (k = 0u; k < 2u; k++)
+  {
+    for (i = 0u; (k > 0u) && (i < n); i++)
+    {
+      inQ31[i] >>= 20;
+      inQ15[i] >>= 9;
+    }
+    memcpy(refQ31, inQ31, n * sizeof(q31_t));
+    qsort(refQ31, n, sizeof(q31_t), cmp_q31);
+    memcpy(refQ15, inQ15, n * sizeof(q15_t));
+    qsort(refQ15, n, sizeof(q15_t), cmp_q15);
+    arm_sort_q31(inQ31, outQ31, tmpQ31, n);
+    arm_sort_q15(inQ15, outQ15, tmpQ15, n);
+    bad = (uint32_t)(memcmp(outQ31, refQ31, n * sizeof(q31_t)) != 0) +
+          (uint32_t)(memcmp(outQ15, refQ15, n * sizeof(q15_t)) != 0);
+    memcpy(outQ31, inQ31, n * sizeof(q31_t));
+    memcpy(outQ15, inQ15, n * sizeof(q15_t));
+    arm_sort_q31(outQ31, outQ31, tmpQ31, n);
+    arm_sort_q15(outQ15, outQ15, tmpQ15, n);
+    bad += (uint32_t)(memcmp(outQ31, refQ31, n * sizeof(q31_t)) != 0) +
+           (uint32_t)(memcmp(outQ15, refQ15, n * sizeof(q15_t)) != 0);
+    host_check_equal("sort_q31 q15", n, bad);
+  }
+  memcpy(refQ7, inQ7, n * sizeof(q7_t));
+  qsort(refQ7, n, sizeof(q7_t), cmp_q7);
+  memcpy(outQ7, inQ7, n * sizeof(q7_t));
+  arm_sort_q7(outQ7, outQ7, n);
+  host_check_equal("sort_q7", n, (uint32_t)(memcmp(outQ7, refQ7, n * sizeof(q7_t)) != 0));
+
+  /* Medians and percentiles against the sorted references */
+  stat_signal(n);
+  memcpy(refF32, inF32, n * sizeof(float32_t));
+  qsort(refF32, n, sizeof(float32_t), cmp_f32);
+  memcpy(refQ31, inQ31, n * sizeof(q31_t));
+  qsort(refQ31, n, sizeof(q31_t), cmp_q31);
+  memcpy(refQ15, inQ15, n * sizeof(q15_t));
+  qsort(refQ15, n, sizeof(q15_t), cmp_q15);
+
+  k = n / 2u;
+  memcpy(outF32, inF32, n * sizeof(float32_t));
+  arm_median_f32(outF32, n, &rF32);
+  memcpy(outQ31, inQ31, n * sizeof(q31_t));
+  arm_median_q31(outQ31, n, &rQ31);
+  memcpy(outQ15, inQ15, n * sizeof(q15_t));
+  arm_median_q15(outQ15, n, &rQ15);
+  bad = (n & 1u) ? ((rF32 != refF32[k]) + (rQ31 != refQ31[k]) + (rQ15 != refQ15[k]))
+                 : ((rF32 != 0.5f * (refF32[k - 1u] + refF32[k])) +
+                    (rQ31 != (q31_t)(((q63_t)refQ31[k - 1u] + refQ31[k]) >> 1)) +
+                    (rQ15 != (q15_t)(((q31_t)refQ15[k - 1u] + refQ15[k]) >> 1)));
+  host_check_equal("median", n, bad);
+
+  bad = 0u;
+  for (i = 0u; i < (sizeof(percents) / sizeof(percents[0])); i++)
+  {
+    pos = percents[i] * (float32_t)(n - 1u);
+    k = (uint32_t)pos;
+    frac = pos - (float32_t)k;
+    memcpy(outF32, inF32, n * sizeof(float32_t));
+    arm_percentile_f32(outF32, n, percents[i], &rF32);
+    bad += (rF32 != ((frac > 0.0f) ? (refF32[k] + frac * (refF32[k + 1u] - refF32[k])) : refF32[k]));
+
+    pQ31 = (percents[i] < 1.0f) ? (q31_t)(percents[i] * 2147483648.0f) : 0x7FFFFFFF;
+    posQ = (q63_t)pQ31 * (n - 1u);
+    k = (uint32_t)(posQ >> 31);
+    memcpy(outQ31, inQ31, n * sizeof(q31_t));
+    arm_percentile_q31(outQ31, n, pQ31, &rQ31);
+    bad += (rQ31 != (((posQ & 0x7FFFFFFF) != 0) ?
+                     (q31_t)(refQ31[k] + ((((q63_t)refQ31[k + 1u] - refQ31[k]) * (posQ & 0x7FFFFFFF)) >> 31)) :
+                     refQ31[k]));
+
+    pQ15 = (percents[i] < 1.0f) ? (q15_t)(percents[i] * 32768.0f) : 0x7FFF;
+    posQ = (q63_t)pQ15 * (n - 1u);
+    k = (uint32_t)(posQ >> 15);
+    memcpy(outQ15, inQ15, n * sizeof(q15_t));
+    arm_percentile_q15(outQ15, n, pQ15, &rQ15);
+    bad += (rQ15 != (((posQ & 0x7FFF) != 0) ?
+                     (q15_t)(refQ15[k] + ((((q63_t)refQ15[k + 1u] - refQ15[k]) * (posQ & 0x7FFF)) >> 15)) :
+                     refQ15[k]));
+  }
+  host_check_equal("percentile", n, bad);
+
+  /* Running medians, odd and even windows */
+  host_check_equal("median_filter 1", n, median_filter_mismatches(n, 1u));
+  host_check_equal("median_filter 4", n, median_filter_mismatches(n, 4u));
+  host_check_equal("median_filter 15", n, median_filter_mismatches(n, 15u));
+  host_check_equal("median_filter 64", n, median_filter_mismatches(n, 64u));
+
+  /* Floating-point histogram, with samples out of the range, added to the previous counts */
+  memset(hist, 0, 37u * sizeof(uint32_t));
+  memset(refHist, 0, sizeof(refHist));
+  for (k = 0u; k < 2u; k++)
+  {
+    arm_histogram_f32(inF32, n, -0.2f, 0.3f, 37u, hist);
+    for (i = 0u; i < n; i++)
+    {
+      pos = (inF32[i] - -0.2f) * (37.0f / (0.3f - -0.2f));
+      refHist[(pos <= 0.0f) ? 0u : ((pos < 36.0f) ? (uint32_t)pos : 36u)]++;
+    }
+  }
+  host_check_equal("histogram_f32", n, (uint32_t)(memcmp(hist, refHist, 37u * sizeof(uint32_t)) != 0));
+}
+
+/**
+ * @brief  Fixed-point histograms of every value against a division per value.
+ */
+static void check_histogram(void)
+{
+  static const struct
+  {
+    q15_t minVal, maxVal;
+    uint32_t numBins;
+  } ranges[] =
+  {
+    { -32768, 32767, 1u },   { -32768, 32767, 256u }, { -32768, 32767, 65536u },
+    { -1000, 3000, 7u },     { -1000, 3000, 4001u },  { 5, 5, 1u },
+    { -128, 127, 10u },      { -100, 27, 128u },      { 0, 63, 64u }
+  };
+  q15_t inQ;
+  q7_t inB;
+  uint32_t r, v, bin, bad;
+
+  /* Each value in turn: its bin holds 1, cleared again for the next value */
+  memset(hist, 0, sizeof(hist));
+  for (r = 0u; r < (sizeof(ranges) / sizeof(ranges[0])); r++)
+  {
+    bad = 0u;
+    for (v = 0u; v < 65536u; v++)
+    {
+      inQ = (q15_t)(v - 32768u);
+      arm_histogram_q15(&inQ, 1u, ranges[r].minVal, ranges[r].maxVal, ranges[r].numBins, hist);
+      bin = (inQ < ranges[r].minVal) ? 0u : ((inQ > ranges[r].maxVal) ? (ranges[r].numBins - 1u) :
+            (uint32_t)(((int32_t)inQ - ranges[r].minVal) * (uint64_t)ranges[r].numBins /
+                       (uint32_t)((int32_t)ranges[r].maxVal - ranges[r].minVal + 1)));
+      bad += (hist[bin] != 1u);
+      hist[bin] = 0u;
+
+      if ((v < 256u) && (ranges[r].minVal >= -128) && (ranges[r].maxVal <= 127))
+      {
+        inB = (q7_t)(v - 128u);
+        arm_histogram_q7(&inB, 1u, (q7_t)ranges[r].minVal, (q7_t)ranges[r].maxVal, ranges[r].numBins, hist);
+        bin = (inB < ranges[r].minVal) ? 0u : ((inB > ranges[r].maxVal) ? (ranges[r].numBins - 1u) :
+              (uint32_t)(((int32_t)inB - ranges[r].minVal) * ranges[r].numBins /
+                         (uint32_t)((int32_t)ranges[r].maxVal - ranges[r].minVal + 1)));
+        bad += (hist[bin] != 1u);
+        hist[bin] = 0u;
+      }
+    }
+    host_check_equal("histogram_q15 q7", ranges[r].numBins, bad);
+  }
+}
+
+void check_statistics(void)
+{
+  static const uint32_t sizes[] = { 1u, 2u, 3u, 7u, 64u, 255u, 1024u, 4096u };
+  uint32_t s;
+
+  for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+  {
+    check_size(sizes[s]);
+  }
+
+  for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+  {
+    check_fused(sizes[s]);
+  }
+
+  for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+  {
+    check_order(sizes[s]);
+  }
+  check_histogram();
+}
@@ -0,0 +1,187 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        support.c
+*
+* Description:  Host benchmarks and golden checks of the conversion, copy
+*               and fill functions.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+
+#include "host_suites.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+static double    refIn[HOST_MAX_SAMPLES];
+static float32_t inF32[HOST_MAX_SAMPLES], outF32[HOST_MAX_SAMPLES];
+static q31_t     inQ31[HOST_MAX_SAMPLES], outQ31[HOST_MAX_SAMPLES];
+static q15_t     inQ15[HOST_MAX_SAMPLES], outQ15[HOST_MAX_SAMPLES];
+static q7_t      inQ7[HOST_MAX_SAMPLES], outQ7[HOST_MAX_SAMPLES];
+
+/**
+ * @brief  Values beyond [-1, 1), so that the conversions to Q formats
+ *         saturate.
+ */
+static void support_signal(uint32_t n)
+{
+  host_signal(refIn, n, 1.25);
+  host_to_f32(refIn, inF32, n);
+  host_to_q31(refIn, inQ31, n);
+  host_to_q15(refIn, inQ15, n);
+  host_to_q7(refIn, inQ7, n);
+}
+
+/* ----------------------------------------------------------------------
+*       Benchmarks
+* -------------------------------------------------------------------- */
+typedef struct
+{
+  uint32_t n;
+} support_ctx_t;
+
+#define N (((support_ctx_t *)p)->n)
+
+static void run_float_to_q31(void *p) { arm_float_to_q31(inF32, outQ31, N); }
+static void run_float_to_q15(void *p) { arm_float_to_q15(inF32, outQ15, N); }
+static void run_float_to_q7(void *p)  { arm_float_to_q7(inF32, outQ7, N); }
+static void run_q31_to_float(void *p) { arm_q31_to_float(inQ31, outF32, N); }
+static void run_q31_to_q15(void *p)   { arm_q31_to_q15(inQ31, outQ15, N); }
+static void run_q31_to_q7(void *p)    { arm_q31_to_q7(inQ31, outQ7, N); }
+static void run_q15_to_float(void *p) { arm_q15_to_float(inQ15, outF32, N); }
+static void run_q15_to_q31(void *p)   { arm_q15_to_q31(inQ15, outQ31, N); }
+static void run_q15_to_q7(void *p)    { arm_q15_to_q7(inQ15, outQ7, N); }
+static void run_q7_to_float(void *p)  { arm_q7_to_float(inQ7, outF32, N); }
+static void run_q7_to_q31(void *p)    { arm_q7_to_q31(inQ7, outQ31, N); }
+static void run_q7_to_q15(void *p)    { arm_q7_to_q15(inQ7, outQ15, N); }
+static void run_copy_f32(void *p)     { arm_copy_f32(inF32, outF32, N); }
+static void run_copy_q15(void *p)     { arm_copy_q15(inQ15, outQ15, N); }
+static void run_fill_f32(void *p)     { arm_fill_f32(0.5f, outF32, N); }
+static void run_fill_q15(void *p)     { arm_fill_q15(0x4000, outQ15, N); }
+
+#undef N
+
+void bench_support(void)
+{
+  static const struct
+  {
+    const char *name;
+    host_kernel_t run;
+  } kernels[] =
+  {
+    { "float_to_q31", run_float_to_q31 }, { "float_to_q15", run_float_to_q15 }, { "float_to_q7", run_float_to_q7 },
+    { "q31_to_float", run_q31_to_float }, { "q31_to_q15", run_q31_to_q15 },     { "q31_to_q7", run_q31_to_q7 },
+    { "q15_to_float", run_q15_to_float }, { "q15_to_q31", run_q15_to_q31 },     { "q15_to_q7", run_q15_to_q7 },
+    { "q7_to_float", run_q7_to_float },   { "q7_to_q31", run_q7_to_q31 },       { "q7_to_q15", run_q7_to_q15 },
+    { "copy_f32", run_copy_f32 },         { "copy_q15", run_copy_q15 },         { "fill_f32", run_fill_f32 },
+    { "fill_q15", run_fill_q15 }
+  };
+  static const uint32_t sizes[] = { 64u, 256u, 1024u, 4096u };
+  support_ctx_t c;
+  uint32_t k, s;
+
+  support_signal(HOST_MAX_SAMPLES);
+
+  for (k = 0u; k < (sizeof(kernels) / sizeof(kernels[0])); k++)
+  {
+    for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+    {
+      c.n = sizes[s];
+      host_bench(kernels[k].name, c.n, c.n, kernels[k].run, &c);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Golden checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Conversion of a float to a Q format as the library does it:
+ *         truncated towards zero, then saturated.
+ */
+static int64_t ref_float_to_q(float32_t x, int bits)
+{
+  const double max = ldexp(1.0, bits - 1);
+  double v = trunc((double)x * max);
+
+  return (v >= max) ? (int64_t)max - 1 : ((v < -max) ? -(int64_t)max : (int64_t)v);
+}
+
+/* Counts the outputs that differ from their reference */
+#define SUPPORT_COUNT(EXPR)                                          \
+  for (i = 0u, bad = 0u; i < n; i++)                                 \
+  {                                                                  \
+    bad += (EXPR) ? 1u : 0u;                                         \
+  }
+
+static void check_size(uint32_t n)
+{
+  uint32_t i, bad;
+
+  support_signal(n);
+
+  arm_float_to_q31(inF32, outQ31, n);
+  SUPPORT_COUNT(outQ31[i] != ref_float_to_q(inF32[i], 32));
+  host_check_equal("float_to_q31", n, bad);
+  arm_float_to_q15(inF32, outQ15, n);
+  SUPPORT_COUNT(outQ15[i] != ref_float_to_q(inF32[i], 16));
+  host_check_equal("float_to_q15", n, bad);
+  arm_float_to_q7(inF32, outQ7, n);
+  SUPPORT_COUNT(outQ7[i] != ref_float_to_q(inF32[i], 8));
+  host_check_equal("float_to_q7", n, bad);
+
+  /* The Q to float conversions are exact but for the rounding of Q31 */
+  arm_q31_to_float(inQ31, outF32, n);
+  SUPPORT_COUNT(outF32[i] != (float32_t)((double)inQ31[i] / 2147483648.0));
+  host_check_equal("q31_to_float", n, bad);
+  arm_q15_to_float(inQ15, outF32, n);
+  SUPPORT_COUNT((double)outF32[i] != (double)inQ15[i] / 32768.0);
+  host_check_equal("q15_to_float", n, bad);
+  arm_q7_to_float(inQ7, outF32, n);
+  SUPPORT_COUNT((double)outF32[i] != (double)inQ7[i] / 128.0);
+  host_check_equal("q7_to_float", n, bad);
+
+  /* Narrowing conversions keep the upper bits, widening ones shift up */
+  arm_q31_to_q15(inQ31, outQ15, n);
+  SUPPORT_COUNT(outQ15[i] != (q15_t)(inQ31[i] >> 16));
+  host_check_equal("q31_to_q15", n, bad);
+  arm_q31_to_q7(inQ31, outQ7, n);
+  SUPPORT_COUNT(outQ7[i] != (q7_t)(inQ31[i] >> 24));
+  host_check_equal("q31_to_q7", n, bad);
+  arm_q15_to_q7(inQ15, outQ7, n);
+  SUPPORT_COUNT(outQ7[i] != (q7_t)(inQ15[i] >> 8));
+  host_check_equal("q15_to_q7", n, bad);
+  arm_q15_to_q31(inQ15, outQ31, n);
+  SUPPORT_COUNT(outQ31[i] != (q31_t)inQ15[i] * 65536);
+  host_check_equal("q15_to_q31", n, bad);
+  arm_q7_to_q31(inQ7, outQ31, n);
+  SUPPORT_COUNT(outQ31[i] != (q31_t)inQ7[i] * 16777216);
+  host_check_equal("q7_to_q31", n, bad);
+  arm_q7_to_q15(inQ7, outQ15, n);
+  SUPPORT_COUNT(outQ15[i] != (q15_t)(inQ7[i] * 256));
+  host_check_equal("q7_to_q15", n, bad);
+
+  arm_copy_f32(inF32, outF32, n);
+  SUPPORT_COUNT(outF32[i] != inF32[i]);
+  host_check_equal("copy_f32", n, bad);
+  arm_copy_q7(inQ7, outQ7, n);
+  SUPPORT_COUNT(outQ7[i] != inQ7[i]);
+  host_check_equal("copy_q7", n, bad);
+  arm_fill_q15(0x4000, outQ15, n);
+  SUPPORT_COUNT(outQ15[i] != 0x4000);
+  host_check_equal("fill_q15", n, bad);
+}
+
+void check_support(void)
+{
+  static const uint32_t sizes[] = { 1u, 2u, 3u, 5u, 64u, 1023u };
+  uint32_t s;
+
+  for (s = 0u; s < (sizeof(sizes) / sizeof(sizes[0])); s++)
+  {
+    check_size(sizes[s]);
+  }
+}
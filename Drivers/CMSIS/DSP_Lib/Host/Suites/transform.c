@@ -0,0 +1,292 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        transform.c
+*
+* Description:  Host benchmarks and golden checks of the complex and real
+*               FFTs.
+*
+* Target Processor: Host (x86, x86-64, AArch64)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_suites.h"
+#include "arm_const_structs.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+#define XF_MIN_LOG2             4u        /* 16-point */
+#define XF_MAX_LOG2             12u       /* 4096-point */
+#define XF_MAX_LEN              (1u << XF_MAX_LOG2)
+#define XF_CHECK_MAX_LEN        1024u     /* largest size checked against the DFT */
+
+static const arm_cfft_instance_f32 *const cfftF32[] =
+{
+  &arm_cfft_sR_f32_len16, &arm_cfft_sR_f32_len32, &arm_cfft_sR_f32_len64,
+  &arm_cfft_sR_f32_len128, &arm_cfft_sR_f32_len256, &arm_cfft_sR_f32_len512,
+  &arm_cfft_sR_f32_len1024, &arm_cfft_sR_f32_len2048, &arm_cfft_sR_f32_len4096
+};
+
+static const arm_cfft_instance_q31 *const cfftQ31[] =
+{
+  &arm_cfft_sR_q31_len16, &arm_cfft_sR_q31_len32, &arm_cfft_sR_q31_len64,
+  &arm_cfft_sR_q31_len128, &arm_cfft_sR_q31_len256, &arm_cfft_sR_q31_len512,
+  &arm_cfft_sR_q31_len1024, &arm_cfft_sR_q31_len2048, &arm_cfft_sR_q31_len4096
+};
+
+static const arm_cfft_instance_q15 *const cfftQ15[] =
+{
+  &arm_cfft_sR_q15_len16, &arm_cfft_sR_q15_len32, &arm_cfft_sR_q15_len64,
+  &arm_cfft_sR_q15_len128, &arm_cfft_sR_q15_len256, &arm_cfft_sR_q15_len512,
+  &arm_cfft_sR_q15_len1024, &arm_cfft_sR_q15_len2048, &arm_cfft_sR_q15_len4096
+};
+
+static double    refIn[2u * XF_MAX_LEN], refOut[2u * XF_MAX_LEN];
+static float32_t srcF32[2u * XF_MAX_LEN], bufF32[2u * XF_MAX_LEN], outF32[2u * XF_MAX_LEN];
+static q31_t     srcQ31[2u * XF_MAX_LEN], bufQ31[2u * XF_MAX_LEN], outQ31[2u * XF_MAX_LEN];
+static q15_t     srcQ15[2u * XF_MAX_LEN], bufQ15[2u * XF_MAX_LEN], outQ15[2u * XF_MAX_LEN];
+
+/**
+ * @brief  Double-precision DFT of interleaved complex data.
+ * @param  sign  -1 for the forward transform, +1 for the inverse
+ */
+static void ref_dft(const double *pIn, double *pOut, uint32_t n, int sign)
+{
+  double re, im, w;
+  uint32_t k, t;
+
+  for (k = 0u; k < n; k++)
+  {
+    re = im = 0.0;
+    for (t = 0u; t < n; t++)
+    {
+      w = (double)sign * 2.0 * PI * (double)((k * t) % n) / (double)n;
+      re += pIn[2u * t] * cos(w) - pIn[2u * t + 1u] * sin(w);
+      im += pIn[2u * t] * sin(w) + pIn[2u * t + 1u] * cos(w);
+    }
+    pOut[2u * k] = re;
+    pOut[2u * k + 1u] = im;
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Benchmarks
+* -------------------------------------------------------------------- */
+typedef struct
+{
+  const void *S;
+  void *R;
+  uint32_t n;
+  uint8_t ifft;
+} xf_ctx_t;
+
+/* In-place transforms start from a fresh copy of the input on every call,
+ * so that the data does not grow or vanish over the runs: the copy is
+ * part of the reported time. */
+static void run_cfft_f32(void *p)
+{
+  xf_ctx_t *c = p;
+  memcpy(bufF32, srcF32, 2u * c->n * sizeof(float32_t));
+  arm_cfft_f32(c->S, bufF32, c->ifft, 1u);
+}
+
+static void run_cfft_q31(void *p)
+{
+  xf_ctx_t *c = p;
+  memcpy(bufQ31, srcQ31, 2u * c->n * sizeof(q31_t));
+  arm_cfft_q31(c->S, bufQ31, c->ifft, 1u);
+}
+
+static void run_cfft_q15(void *p)
+{
+  xf_ctx_t *c = p;
+  memcpy(bufQ15, srcQ15, 2u * c->n * sizeof(q15_t));
+  arm_cfft_q15(c->S, bufQ15, c->ifft, 1u);
+}
+
+static void run_rfft_fast_f32(void *p)
+{
+  xf_ctx_t *c = p;
+  memcpy(bufF32, srcF32, c->n * sizeof(float32_t));
+  arm_rfft_fast_f32(c->R, bufF32, outF32, c->ifft);
+}
+
+static void run_rfft_q31(void *p)
+{
+  xf_ctx_t *c = p;
+  memcpy(bufQ31, srcQ31, c->n * sizeof(q31_t));
+  arm_rfft_q31(c->R, bufQ31, outQ31);
+}
+
+static void run_rfft_q15(void *p)
+{
+  xf_ctx_t *c = p;
+  memcpy(bufQ15, srcQ15, c->n * sizeof(q15_t));
+  arm_rfft_q15(c->R, bufQ15, outQ15);
+}
+
+void bench_transform(void)
+{
+  arm_rfft_fast_instance_f32 rfftF32;
+  arm_rfft_instance_q31 rfftQ31;
+  arm_rfft_instance_q15 rfftQ15;
+  xf_ctx_t c;
+  uint32_t l;
+
+  host_signal(refIn, 2u * XF_MAX_LEN, 0.5);
+  host_to_f32(refIn, srcF32, 2u * XF_MAX_LEN);
+  host_to_q31(refIn, srcQ31, 2u * XF_MAX_LEN);
+  host_to_q15(refIn, srcQ15, 2u * XF_MAX_LEN);
+
+  for (l = 6u; l <= XF_MAX_LOG2; l += 2u)
+  {
+    c.n = 1u << l;
+    c.ifft = 0u;
+
+    c.S = cfftF32[l - XF_MIN_LOG2];
+    host_bench("cfft_f32", c.n, c.n, run_cfft_f32, &c);
+    c.ifft = 1u;
+    host_bench("cifft_f32", c.n, c.n, run_cfft_f32, &c);
+    c.ifft = 0u;
+    c.S = cfftQ31[l - XF_MIN_LOG2];
+    host_bench("cfft_q31", c.n, c.n, run_cfft_q31, &c);
+    c.S = cfftQ15[l - XF_MIN_LOG2];
+    host_bench("cfft_q15", c.n, c.n, run_cfft_q15, &c);
+
+    arm_rfft_fast_init_f32(&rfftF32, (uint16_t)c.n);
+    c.R = &rfftF32;
+    host_bench("rfft_fast_f32", c.n, c.n, run_rfft_fast_f32, &c);
+    c.ifft = 1u;
+    host_bench("rifft_fast_f32", c.n, c.n, run_rfft_fast_f32, &c);
+    c.ifft = 0u;
+    arm_rfft_init_q31(&rfftQ31, c.n, 0u, 1u);
+    c.R = &rfftQ31;
+    host_bench("rfft_q31", c.n, c.n, run_rfft_q31, &c);
+    arm_rfft_init_q15(&rfftQ15, c.n, 0u, 1u);
+    c.R = &rfftQ15;
+    host_bench("rfft_q15", c.n, c.n, run_rfft_q15, &c);
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Golden checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Checks the complex FFTs of one size. The Q formats scale their
+ *         output down by n.
+ */
+static void check_cfft(uint32_t l)
+{
+  const uint32_t n = 1u << l;
+  uint32_t k;
+
+  host_signal(refIn, 2u * n, 0.5);
+  host_to_f32(refIn, bufF32, 2u * n);
+  for (k = 0u; k < 2u * n; k++)
+  {
+    refIn[k] = (double)bufF32[k];
+  }
+  ref_dft(refIn, refOut, n, -1);
+  arm_cfft_f32(cfftF32[l - XF_MIN_LOG2], bufF32, 0u, 1u);
+  host_check_snr("cfft_f32", n, host_snr_f32(refOut, bufF32, 2u * n), 120.0);
+
+  /* Inverse transform of the spectrum gives back the input */
+  arm_cfft_f32(cfftF32[l - XF_MIN_LOG2], bufF32, 1u, 1u);
+  host_check_snr("cifft_f32", n, host_snr_f32(refIn, bufF32, 2u * n), 120.0);
+
+  host_to_q31(refIn, bufQ31, 2u * n);
+  for (k = 0u; k < 2u * n; k++)
+  {
+    refIn[k] = (double)bufQ31[k] / 2147483648.0;
+  }
+  ref_dft(refIn, refOut, n, -1);
+  arm_cfft_q31(cfftQ31[l - XF_MIN_LOG2], bufQ31, 0u, 1u);
+  host_check_snr("cfft_q31", n, host_snr_q31(refOut, bufQ31, 2u * n, (double)n), 125.0);
+
+  host_to_q15(refIn, bufQ15, 2u * n);
+  for (k = 0u; k < 2u * n; k++)
+  {
+    refIn[k] = (double)bufQ15[k] / 32768.0;
+  }
+  ref_dft(refIn, refOut, n, -1);
+  arm_cfft_q15(cfftQ15[l - XF_MIN_LOG2], bufQ15, 0u, 1u);
+  host_check_snr("cfft_q15", n, host_snr_q15(refOut, bufQ15, 2u * n, (double)n), 40.0);
+}
+
+/**
+ * @brief  Checks the real FFTs of one size: bins 0 to n/2.
+ */
+static void check_rfft(uint32_t l)
+{
+  const uint32_t n = 1u << l;
+  arm_rfft_fast_instance_f32 rfftF32;
+  arm_rfft_instance_q31 rfftQ31;
+  arm_rfft_instance_q15 rfftQ15;
+  double spectrum[2u * XF_CHECK_MAX_LEN + 2u];
+  uint32_t k;
+
+  host_signal(refOut, n, 0.5);
+  host_to_f32(refOut, bufF32, n);
+  for (k = 0u; k < n; k++)
+  {
+    refIn[2u * k] = (double)bufF32[k];
+    refIn[2u * k + 1u] = 0.0;
+  }
+  ref_dft(refIn, refOut, n, -1);
+
+  /* arm_rfft_fast_f32() packs the real bin n/2 in the imaginary part of bin 0 */
+  memcpy(spectrum, refOut, n * sizeof(double));
+  spectrum[1] = refOut[n];
+  arm_rfft_fast_init_f32(&rfftF32, (uint16_t)n);
+  arm_rfft_fast_f32(&rfftF32, bufF32, outF32, 0u);
+  host_check_snr("rfft_fast_f32", n, host_snr_f32(spectrum, outF32, n), 120.0);
+
+  for (k = 0u; k < n; k++)
+  {
+    spectrum[k] = refIn[2u * k];
+  }
+  arm_rfft_fast_f32(&rfftF32, outF32, bufF32, 1u);
+  host_check_snr("rifft_fast_f32", n, host_snr_f32(spectrum, bufF32, n), 120.0);
+
+  /* Q formats: bins 0 to n/2 of the full spectrum, scaled down by n */
+  for (k = 0u; k < n; k++)
+  {
+    refOut[k] = refIn[2u * k];
+  }
+  host_to_q31(refOut, bufQ31, n);
+  for (k = 0u; k < n; k++)
+  {
+    refIn[2u * k] = (double)bufQ31[k] / 2147483648.0;
+  }
+  ref_dft(refIn, spectrum, n, -1);
+  arm_rfft_init_q31(&rfftQ31, n, 0u, 1u);
+  arm_rfft_q31(&rfftQ31, bufQ31, outQ31);
+  host_check_snr("rfft_q31", n, host_snr_q31(spectrum, outQ31, n + 2u, (double)n), 125.0);
+
+  host_to_q15(refOut, bufQ15, n);
+  for (k = 0u; k < n; k++)
+  {
+    refIn[2u * k] = (double)bufQ15[k] / 32768.0;
+  }
+  ref_dft(refIn, spectrum, n, -1);
+  arm_rfft_init_q15(&rfftQ15, n, 0u, 1u);
+  arm_rfft_q15(&rfftQ15, bufQ15, outQ15);
+  host_check_snr("rfft_q15", n, host_snr_q15(spectrum, outQ15, n + 2u, (double)n), 35.0);
+}
+
+void check_transform(void)
+{
+  uint32_t l;
+
+  for (l = XF_MIN_LOG2; (1u << l) <= XF_CHECK_MAX_LEN; l++)
+  {
+    check_cfft(l);
+  }
+  for (l = 5u; (1u << l) <= XF_CHECK_MAX_LEN; l++)
+  {
+    check_rfft(l);
+  }
+}
@@ -104,7 +104,7 @@ void arm_dot_prod_q15(
   {
     /* C = A[0]* B[0] + A[1]* B[1] + A[2]* B[2] + .....+ A[blockSize-1]* B[blockSize-1] */
     /* Calculate dot product and then store the results in a temporary buffer. */
-    sum = __SMLALD(*pSrcA++, *pSrcB++, sum);
+    sum += (q63_t) ((q31_t) * pSrcA++ * *pSrcB++);
 
     /* Decrement the loop counter */
     blkCnt--;
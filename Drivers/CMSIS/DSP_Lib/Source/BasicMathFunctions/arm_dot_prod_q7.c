@@ -122,7 +122,7 @@ void arm_dot_prod_q7(
   {
     /* C = A[0]* B[0] + A[1]* B[1] + A[2]* B[2] + .....+ A[blockSize-1]* B[blockSize-1] */
     /* Dot product and then store the results in a temporary buffer. */
-    sum = __SMLAD(*pSrcA++, *pSrcB++, sum);
+    sum += (q31_t) ((q15_t) * pSrcA++ * *pSrcB++);
 
     /* Decrement the loop counter */
     blkCnt--;
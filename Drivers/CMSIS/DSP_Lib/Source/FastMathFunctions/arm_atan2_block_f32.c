@@ -0,0 +1,156 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_atan2_block_f32.c
+*
+* Description:  Four-quadrant arctangent of a block of floating-point
+*               coordinates.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @defgroup atan2 Four-Quadrant Arctangent
+ *
+ * Computes the angle of the points <code>(x, y)</code>, in <code>[-pi, pi]</code>, such as the
+ * phase of complex samples in a demodulator.
+ *
+ * The ratio of the smaller to the larger of <code>|x|</code> and <code>|y|</code> is in
+ * <code>[0, 1]</code>.  Above <code>tan(pi/8)</code>, it is replaced by
+ * <code>(t - 1) / (t + 1)</code>, whose arctangent is <code>pi/4</code> less, so that a single
+ * division gives an argument within <code>tan(pi/8)</code> of 0.  A polynomial of degree 9
+ * gives its arctangent, and the octant moves it back in place.  The absolute error is
+ * within <code>2e-7</code> radians.
+ *
+ * \par
+ * <code>atan2(0, 0)</code> is 0 and two infinities give an odd multiple of <code>pi/4</code>,
+ * as in the C library, and the sign of the result is the sign bit of <code>y</code>, zeros
+ * included.  Every operation is done on each value, with selections
+ * instead of tests, so that the loop has no data-dependent branch.
+ */
+
+/**
+ * @addtogroup atan2
+ * @{
+ */
+
+/**
+ * @brief  Arctangent of one point, without branches.
+ * @param[in] y  ordinate.
+ * @param[in] x  abscissa.
+ * @return atan2(y, x).
+ */
+
+static __INLINE float32_t arm_atan2_block_sample_f32(
+  float32_t y,
+  float32_t x)
+{
+  float32_t ax, ay, mn, mx, num, den, t, z, r;   /* Octant reduction and polynomial */
+  int32_t swap, big, both;                       /* Octant */
+  union
+  {
+    float32_t f;
+    int32_t i;
+  } ux, uy, ur;                                  /* Sign bits */
+
+  ax = fabsf(x);
+  ay = fabsf(y);
+  swap = (ax < ay);
+  mx = swap ? ay : ax;
+  mn = swap ? ax : ay;
+
+  /* Two infinities have the ratio of two equal finite magnitudes */
+  both = (mn > 3.40282347e+38f);
+  mx = both ? 1.0f : mx;
+  mn = both ? 1.0f : mn;
+
+  /* t = mn / mx in [0, tan(pi/8)], or (mn - mx) / (mn + mx) in (-tan(pi/8), 0] */
+  big = (mn > 0.414213562373f * mx);
+  num = big ? (mn - mx) : mn;
+  den = big ? (mn + mx) : mx;
+  den = (den == 0.0f) ? 1.0f : den;
+  t = num / den;
+
+  /* atan(t) */
+  z = t * t;
+  r = 8.05374449538e-2f;
+  r = r * z - 1.38776856032e-1f;
+  r = r * z + 1.99777106478e-1f;
+  r = r * z - 3.33329491539e-1f;
+  r = ((r * z) * t) + t;
+  r = big ? (r + 0.785398163397f) : r;
+
+  /* Octant, quadrant, then the sign of y */
+  r = swap ? (1.57079632679f - r) : r;
+  ux.f = x;
+  r = (ux.i < 0) ? (3.14159265359f - r) : r;
+  uy.f = y;
+  ur.f = r;
+  ur.i |= (uy.i & (int32_t) 0x80000000);
+
+  return (ur.f);
+}
+
+/**
+ * @brief  Four-quadrant arctangent of a block of floating-point coordinates.
+ * @param[in]  *pSrcY     points to the ordinates.
+ * @param[in]  *pSrcX     points to the abscissas.
+ * @param[out] *pDst      points to the angles in radians; may be pSrcY or pSrcX.
+ * @param[in]  blockSize  number of points.
+ * @return none.
+ */
+
+void arm_atan2_block_f32(
+  const float32_t * pSrcY,
+  const float32_t * pSrcX,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t blkCnt;                               /* Loop counter */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    pDst[0] = arm_atan2_block_sample_f32(pSrcY[0], pSrcX[0]);
+    pDst[1] = arm_atan2_block_sample_f32(pSrcY[1], pSrcX[1]);
+    pDst[2] = arm_atan2_block_sample_f32(pSrcY[2], pSrcX[2]);
+    pDst[3] = arm_atan2_block_sample_f32(pSrcY[3], pSrcX[3]);
+    pSrcY += 4u;
+    pSrcX += 4u;
+    pDst += 4u;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    *pDst++ = arm_atan2_block_sample_f32(*pSrcY++, *pSrcX++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of atan2 group
+ */
@@ -0,0 +1,143 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_exp_block_f32.c
+*
+* Description:  Natural exponential of a block of floating-point values.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @defgroup exp Exponential
+ *
+ * Computes the natural exponential of a block of floating-point values.
+ *
+ * The input is reduced to <code>x = n*ln(2) + r</code>, with <code>n</code> the nearest
+ * integer and <code>|r| <= ln(2)/2</code>; <code>ln(2)</code> is split in two constants so that
+ * the reduction is exact.  A polynomial of degree 6 gives <code>exp(r)</code>, which the
+ * exponent bits of <code>2^n</code> then scale.  The relative error is within 2 ulp.
+ *
+ * \par
+ * The inputs below <code>-87.34</code>, whose exponential is not a normal value, give 0,
+ * and the inputs above <code>88.72</code> give <code>+inf</code>.  Every operation is done on
+ * each value, with selections instead of tests, so that the loop has no data-dependent
+ * branch.
+ */
+
+/**
+ * @addtogroup exp
+ * @{
+ */
+
+/**
+ * @brief  Exponential of one sample, without branches.
+ * @param[in] x  input value.
+ * @return exp(x).
+ */
+
+static __INLINE float32_t arm_exp_block_sample_f32(
+  float32_t x)
+{
+  float32_t in, fn, r, z, y;                     /* Reduced argument and polynomial */
+  int32_t n, n1;                                 /* Power of 2 */
+  union
+  {
+    float32_t f;
+    int32_t i;
+  } s1, s2;                                      /* Scales 2^n1 and 2^(n - n1) */
+
+  /* Clamp to the range of normal results */
+  in = (x > 88.7228394f) ? 88.7228394f : x;
+  in = (in < -87.3365479f) ? -87.3365479f : in;
+
+  /* n = round(x / ln(2)), and r = x - n * ln(2) in two parts, for |r| <= ln(2)/2 */
+  fn = in * 1.44269504089f + 0.5f;
+  n = (int32_t) fn;
+  n -= (fn < (float32_t) n);
+  fn = (float32_t) n;
+  r = (in - fn * 0.693359375f) - fn * -2.12194440e-4f;
+
+  /* exp(r) */
+  z = r * r;
+  y = 1.9875691500e-4f;
+  y = y * r + 1.3981999507e-3f;
+  y = y * r + 8.3334519073e-3f;
+  y = y * r + 4.1665795894e-2f;
+  y = y * r + 1.6666665459e-1f;
+  y = y * r + 5.0000001201e-1f;
+  y = (y * z + r) + 1.0f;
+
+  /* 2^n in two normal factors, n from -126 to 128 */
+  n1 = n >> 1;
+  s1.i = (n1 + 127) << 23;
+  s2.i = ((n - n1) + 127) << 23;
+  y = (y * s1.f) * s2.f;
+
+  /* Beyond the clamps: 0 below, +inf above */
+  y = (x < -87.3365479f) ? 0.0f : y;
+  y = (x > 88.7228394f) ? INFINITY : y;
+
+  return (y);
+}
+
+/**
+ * @brief  Natural exponential of a block of floating-point values.
+ * @param[in]  *pSrc      points to the input values.
+ * @param[out] *pDst      points to the exponentials; may be pSrc.
+ * @param[in]  blockSize  number of values.
+ * @return none.
+ */
+
+void arm_exp_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t blkCnt;                               /* Loop counter */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    pDst[0] = arm_exp_block_sample_f32(pSrc[0]);
+    pDst[1] = arm_exp_block_sample_f32(pSrc[1]);
+    pDst[2] = arm_exp_block_sample_f32(pSrc[2]);
+    pDst[3] = arm_exp_block_sample_f32(pSrc[3]);
+    pSrc += 4u;
+    pDst += 4u;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    *pDst++ = arm_exp_block_sample_f32(*pSrc++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of exp group
+ */
@@ -0,0 +1,146 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_log_block_f32.c
+*
+* Description:  Natural logarithm of a block of floating-point values.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @defgroup log Natural Logarithm
+ *
+ * Computes the natural logarithm of a block of floating-point values.
+ *
+ * The exponent and mantissa bits give <code>x = 2^e * (1 + m)</code>, with
+ * <code>1 + m</code> in <code>[sqrt(1/2), sqrt(2))</code>, and a polynomial of degree 9
+ * gives <code>log(1 + m)</code>, to which <code>e*ln(2)</code> is added.  The relative error
+ * is within 2 ulp.  Denormal inputs are scaled into the normal range first.
+ *
+ * \par
+ * <code>log(0)</code> is <code>-inf</code>, <code>log(+inf)</code> is <code>+inf</code>, and
+ * the negative inputs give NaN.  Every operation is done on each value, with selections
+ * instead of tests, so that the loop has no data-dependent branch.
+ */
+
+/**
+ * @addtogroup log
+ * @{
+ */
+
+/**
+ * @brief  Logarithm of one sample, without branches.
+ * @param[in] x  input value.
+ * @return log(x).
+ */
+
+static __INLINE float32_t arm_log_block_sample_f32(
+  float32_t x)
+{
+  float32_t in, m, z, y, fe;                     /* Mantissa and polynomial */
+  int32_t e, small, low;                         /* Exponent, denormal input and low mantissa */
+  union
+  {
+    float32_t f;
+    int32_t i;
+  } u;                                           /* Bits of the input */
+
+  /* Denormals scaled up by 2^23 */
+  small = (x < 1.17549435e-38f);
+  in = small ? (x * 8388608.0f) : x;
+
+  /* x = 2^e * (1 + m), with 1 + m in [sqrt(1/2), sqrt(2)), from a mantissa in [1/2, 1) */
+  u.f = in;
+  e = ((u.i >> 23) & 0xFF) - 126 - (small ? 23 : 0);
+  u.i = (u.i & 0x007FFFFF) | 0x3F000000;
+  low = (u.f < 0.707106781186547524f);
+  e -= low;
+  m = low ? ((u.f + u.f) - 1.0f) : (u.f - 1.0f);
+  fe = (float32_t) e;
+
+  /* log(1 + m) */
+  z = m * m;
+  y = 7.0376836292e-2f;
+  y = y * m - 1.1514610310e-1f;
+  y = y * m + 1.1676998740e-1f;
+  y = y * m - 1.2420140846e-1f;
+  y = y * m + 1.4249322787e-1f;
+  y = y * m - 1.6668057665e-1f;
+  y = y * m + 2.0000714765e-1f;
+  y = y * m - 2.4999993993e-1f;
+  y = y * m + 3.3333331174e-1f;
+  y = (y * m) * z;
+
+  /* e * ln(2) in two parts */
+  y = y + fe * -2.12194440e-4f;
+  y = y - 0.5f * z;
+  y = (m + y) + fe * 0.693359375f;
+
+  /* log(+inf) = +inf, log(0) = -inf, and NaN for NaN and the negative inputs */
+  y = (x < INFINITY) ? y : x;
+  y = (x > 0.0f) ? y : ((x == 0.0f) ? -INFINITY : NAN);
+
+  return (y);
+}
+
+/**
+ * @brief  Natural logarithm of a block of floating-point values.
+ * @param[in]  *pSrc      points to the input values.
+ * @param[out] *pDst      points to the logarithms; may be pSrc.
+ * @param[in]  blockSize  number of values.
+ * @return none.
+ */
+
+void arm_log_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t blkCnt;                               /* Loop counter */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    pDst[0] = arm_log_block_sample_f32(pSrc[0]);
+    pDst[1] = arm_log_block_sample_f32(pSrc[1]);
+    pDst[2] = arm_log_block_sample_f32(pSrc[2]);
+    pDst[3] = arm_log_block_sample_f32(pSrc[3]);
+    pSrc += 4u;
+    pDst += 4u;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    *pDst++ = arm_log_block_sample_f32(*pSrc++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of log group
+ */
@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_sin_block_f32.c
+*
+* Description:  Fast approximation to the sine of a block of
+*               floating-point values.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_common_tables.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @addtogroup sin
+ * @{
+ */
+
+/**
+ * @brief  Sine of one sample by the table of arm_sin_f32(), without branches.
+ * @param[in] x  input value in radians.
+ * @return sin(x).
+ *
+ * \par
+ * The floor of the scaled input subtracts the comparison instead of testing the
+ * sign, and the index that rounds up to <code>FAST_MATH_TABLE_SIZE</code> wraps
+ * to 0 with a zero fraction, instead of being tested.
+ */
+
+static __INLINE float32_t arm_sin_block_sample_f32(
+  float32_t x)
+{
+  float32_t in, findex, fract;                   /* Scaled input, table position and fraction */
+  int32_t n, index;                              /* Floor and table index */
+
+  /* Scale the input to turns, and keep the fraction of turn in [0 1] */
+  in = x * 0.159154943092f;
+  n = (int32_t) in;
+  n -= (in < (float32_t) n);
+  in = in - (float32_t) n;
+
+  /* Table index and fraction */
+  findex = (float32_t) FAST_MATH_TABLE_SIZE * in;
+  index = (int32_t) findex;
+  fract = findex - (float32_t) index;
+  index &= (FAST_MATH_TABLE_SIZE - 1);
+
+  /* Linear interpolation between the two nearest values */
+  return ((1.0f - fract) * sinTable_f32[index] + fract * sinTable_f32[index + 1]);
+}
+
+/**
+ * @brief  Fast approximation to the sine of a block of floating-point values.
+ * @param[in]  *pSrc      points to the input values in radians.
+ * @param[out] *pDst      points to the sines; may be pSrc.
+ * @param[in]  blockSize  number of values.
+ * @return none.
+ *
+ * \par
+ * The results are those of <code>arm_sin_f32()</code>, with the same table and
+ * interpolation, computed without a data-dependent branch.
+ */
+
+void arm_sin_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t blkCnt;                               /* Loop counter */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    pDst[0] = arm_sin_block_sample_f32(pSrc[0]);
+    pDst[1] = arm_sin_block_sample_f32(pSrc[1]);
+    pDst[2] = arm_sin_block_sample_f32(pSrc[2]);
+    pDst[3] = arm_sin_block_sample_f32(pSrc[3]);
+    pSrc += 4u;
+    pDst += 4u;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    *pDst++ = arm_sin_block_sample_f32(*pSrc++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of sin group
+ */
@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_sqrt_block_f32.c
+*
+* Description:  Square root of a block of floating-point values.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFastMath
+ */
+
+/**
+ * @addtogroup SQRT
+ * @{
+ */
+
+/**
+ * @brief  Square root of one sample, 0 for a negative or NaN input.
+ * @param[in] x  input value.
+ * @return sqrt(x).
+ */
+
+static __INLINE float32_t arm_sqrt_block_sample_f32(
+  float32_t x)
+{
+  float32_t out;                                 /* Square root */
+
+  /* The selection replaces the test of arm_sqrt_f32(), whose square root is then always taken */
+  arm_sqrt_f32((x > 0.0f) ? x : 0.0f, &out);
+
+  return (out);
+}
+
+/**
+ * @brief  Square root of a block of floating-point values.
+ * @param[in]  *pSrc      points to the input values.
+ * @param[out] *pDst      points to the square roots; may be pSrc.
+ * @param[in]  blockSize  number of values.
+ * @return none.
+ *
+ * \par
+ * The square roots are those of <code>arm_sqrt_f32()</code>, and 0 for the negative
+ * inputs, without a data-dependent branch.
+ */
+
+void arm_sqrt_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t blkCnt;                               /* Loop counter */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    pDst[0] = arm_sqrt_block_sample_f32(pSrc[0]);
+    pDst[1] = arm_sqrt_block_sample_f32(pSrc[1]);
+    pDst[2] = arm_sqrt_block_sample_f32(pSrc[2]);
+    pDst[3] = arm_sqrt_block_sample_f32(pSrc[3]);
+    pSrc += 4u;
+    pDst += 4u;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    *pDst++ = arm_sqrt_block_sample_f32(*pSrc++);
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of SQRT group
+ */
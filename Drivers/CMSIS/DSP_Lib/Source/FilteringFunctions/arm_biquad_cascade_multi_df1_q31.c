@@ -0,0 +1,270 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_biquad_cascade_multi_df1_q31.c
+*
+* Description:  Q31 direct form I Biquad cascade filter for N interleaved
+*               channels.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup BiquadCascadeMulti
+ * @{
+ */
+
+/**
+ * @brief Processing function for the Q31 multi-channel direct form I Biquad cascade filter.
+ * @param[in]  *S        points to an instance of the filter data structure.
+ * @param[in]  *pSrc     points to the block of interleaved input data.
+ * @param[out] *pDst     points to the block of interleaved output data.
+ * @param[in]  blockSize number of frames to process.
+ * @return none.
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * Those of <code>arm_biquad_cascade_df1_q31()</code>: the 5 multiply-accumulates use a
+ * 2.62 accumulator that wraps around on overflow, and the result is shifted by
+ * <code>postShift</code> bits and truncated to 1.31 format.  The outputs are bit-exact
+ * with that function, channel by channel.
+ */
+
+void arm_biquad_cascade_multi_df1_q31(
+  const arm_biquad_cascade_multi_df1_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q63_t acc;                                     /*  accumulator                   */
+  uint32_t lShift = 31u - (uint32_t) S->postShift; /*  Shift to be applied to the output */
+  q31_t *pIn = pSrc;                             /*  input pointer initialization  */
+  q31_t *pState = S->pState;                     /*  pState pointer initialization */
+  q31_t *pCoeffs = S->pCoeffs;                   /*  coeff pointer initialization  */
+  q31_t *px, *py;                                /*  sample pointers               */
+  q31_t Xn1, Xn2, Yn1, Yn2;                      /*  Filter state variables        */
+  q31_t b0, b1, b2, a1, a2;                      /*  Filter coefficients           */
+  q31_t Xn;                                      /*  temporary input               */
+  uint32_t numCh = S->numChannels;               /*  number of channels            */
+  uint32_t sample, ch, stage = S->numStages;     /*  loop counters                 */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  q63_t accB;                                    /*  accumulator                   */
+  q31_t Xn1b, Xn2b, Yn1b, Yn2b;                  /*  Filter state variables        */
+  q31_t Xnb;                                     /*  temporary input               */
+
+  do
+  {
+    /* Reading the coefficients */
+    b0 = *pCoeffs++;
+    b1 = *pCoeffs++;
+    b2 = *pCoeffs++;
+    a1 = *pCoeffs++;
+    a2 = *pCoeffs++;
+
+    /* Pairs of channels: two independent recursions.  The eight states and
+     * the five coefficients fill the registers of the core. */
+    ch = 0u;
+    while((ch + 2u) <= numCh)
+    {
+      /* Reading the state values */
+      Xn1 = pState[ch];
+      Xn1b = pState[ch + 1u];
+      Xn2 = pState[numCh + ch];
+      Xn2b = pState[numCh + ch + 1u];
+      Yn1 = pState[(2u * numCh) + ch];
+      Yn1b = pState[(2u * numCh) + ch + 1u];
+      Yn2 = pState[(3u * numCh) + ch];
+      Yn2b = pState[(3u * numCh) + ch + 1u];
+
+      px = pIn + ch;
+      py = pDst + ch;
+      sample = blockSize;
+
+      while(sample > 0u)
+      {
+        /* Read the inputs of the two channels */
+        Xn = px[0];
+        Xnb = px[1];
+        px += numCh;
+
+        /* acc =  b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2] */
+        acc = (q63_t) b0 *Xn;
+        accB = (q63_t) b0 *Xnb;
+        acc += (q63_t) b1 *Xn1;
+        accB += (q63_t) b1 *Xn1b;
+        acc += (q63_t) b2 *Xn2;
+        accB += (q63_t) b2 *Xn2b;
+        acc += (q63_t) a1 *Yn1;
+        accB += (q63_t) a1 *Yn1b;
+        acc += (q63_t) a2 *Yn2;
+        accB += (q63_t) a2 *Yn2b;
+
+        /* Every time after the output is computed state should be updated. */
+        Xn2 = Xn1;
+        Xn2b = Xn1b;
+        Xn1 = Xn;
+        Xn1b = Xnb;
+        Yn2 = Yn1;
+        Yn2b = Yn1b;
+
+        /* The result is converted to 1.31 */
+        Yn1 = (q31_t) (acc >> lShift);
+        Yn1b = (q31_t) (accB >> lShift);
+
+        py[0] = Yn1;
+        py[1] = Yn1b;
+        py += numCh;
+
+        sample--;
+      }
+
+      /* Store the updated state variables back into the state array */
+      pState[ch] = Xn1;
+      pState[ch + 1u] = Xn1b;
+      pState[numCh + ch] = Xn2;
+      pState[numCh + ch + 1u] = Xn2b;
+      pState[(2u * numCh) + ch] = Yn1;
+      pState[(2u * numCh) + ch + 1u] = Yn1b;
+      pState[(3u * numCh) + ch] = Yn2;
+      pState[(3u * numCh) + ch + 1u] = Yn2b;
+
+      ch += 2u;
+    }
+
+    /* The last channel of an odd count */
+    if(ch < numCh)
+    {
+      Xn1 = pState[ch];
+      Xn2 = pState[numCh + ch];
+      Yn1 = pState[(2u * numCh) + ch];
+      Yn2 = pState[(3u * numCh) + ch];
+
+      px = pIn + ch;
+      py = pDst + ch;
+      sample = blockSize;
+
+      while(sample > 0u)
+      {
+        Xn = *px;
+        px += numCh;
+
+        acc = (q63_t) b0 *Xn;
+        acc += (q63_t) b1 *Xn1;
+        acc += (q63_t) b2 *Xn2;
+        acc += (q63_t) a1 *Yn1;
+        acc += (q63_t) a2 *Yn2;
+
+        Xn2 = Xn1;
+        Xn1 = Xn;
+        Yn2 = Yn1;
+        Yn1 = (q31_t) (acc >> lShift);
+
+        *py = Yn1;
+        py += numCh;
+
+        sample--;
+      }
+
+      pState[ch] = Xn1;
+      pState[numCh + ch] = Xn2;
+      pState[(2u * numCh) + ch] = Yn1;
+      pState[(3u * numCh) + ch] = Yn2;
+    }
+
+    /* The current stage input is given as the output to the next stage */
+    pIn = pDst;
+
+    pState += 4u * numCh;
+
+    /* decrement the loop counter */
+    stage--;
+
+  } while(stage > 0u);
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  do
+  {
+    /* Reading the coefficients */
+    b0 = *pCoeffs++;
+    b1 = *pCoeffs++;
+    b2 = *pCoeffs++;
+    a1 = *pCoeffs++;
+    a2 = *pCoeffs++;
+
+    for (ch = 0u; ch < numCh; ch++)
+    {
+      /* Reading the state values */
+      Xn1 = pState[ch];
+      Xn2 = pState[numCh + ch];
+      Yn1 = pState[(2u * numCh) + ch];
+      Yn2 = pState[(3u * numCh) + ch];
+
+      px = pIn + ch;
+      py = pDst + ch;
+      sample = blockSize;
+
+      while(sample > 0u)
+      {
+        /* Read the input */
+        Xn = *px;
+        px += numCh;
+
+        /* acc =  b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2] */
+        acc = (q63_t) b0 *Xn;
+        acc += (q63_t) b1 *Xn1;
+        acc += (q63_t) b2 *Xn2;
+        acc += (q63_t) a1 *Yn1;
+        acc += (q63_t) a2 *Yn2;
+
+        /* Every time after the output is computed state should be updated. */
+        Xn2 = Xn1;
+        Xn1 = Xn;
+        Yn2 = Yn1;
+
+        /* The result is converted to 1.31 */
+        Yn1 = (q31_t) (acc >> lShift);
+
+        /* Store the output in the destination buffer. */
+        *py = Yn1;
+        py += numCh;
+
+        /* decrement the loop counter */
+        sample--;
+      }
+
+      /* Store the updated state variables back into the state array */
+      pState[ch] = Xn1;
+      pState[numCh + ch] = Xn2;
+      pState[(2u * numCh) + ch] = Yn1;
+      pState[(3u * numCh) + ch] = Yn2;
+    }
+
+    /* The current stage input is given as the output to the next stage */
+    pIn = pDst;
+
+    pState += 4u * numCh;
+
+    /* decrement the loop counter */
+    stage--;
+
+  } while(stage > 0u);
+
+#endif /*   #ifndef ARM_MATH_CM0_FAMILY */
+
+}
+
+/**
+ * @} end of BiquadCascadeMulti group
+ */
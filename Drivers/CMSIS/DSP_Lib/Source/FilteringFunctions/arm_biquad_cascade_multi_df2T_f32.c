@@ -0,0 +1,281 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_biquad_cascade_multi_df2T_f32.c
+*
+* Description:  Floating-point transposed direct form II Biquad cascade
+*               filter for N interleaved channels.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @defgroup BiquadCascadeMulti Multi-Channel Biquad Cascade Filters
+ *
+ * These functions filter <code>numChannels</code> interleaved channels with the same
+ * Biquad cascade, each channel with its own state.  They compute, channel by channel, the
+ * output of <code>arm_biquad_cascade_df2T_f32()</code> and <code>arm_biquad_cascade_df1_q31()</code>.
+ * <code>arm_biquad_cascade_stereo_df2T_f32()</code> is the two-channel case of the first one.
+ *
+ * \par
+ * The input and output blocks hold <code>blockSize</code> frames of <code>numChannels</code>
+ * samples, so <code>blockSize*numChannels</code> values:
+ * <pre>
+ *     {x0[0], x1[0], ..., xN-1[0], x0[1], x1[1], ..., xN-1[1], ...}
+ * </pre>
+ * where <code>xc[n]</code> is sample <code>n</code> of channel <code>c</code>.
+ * The coefficients are those of the single-channel filter: <code>5*numStages</code> values.
+ *
+ * \par Algorithm
+ * The recursion of one channel is a chain of dependent multiply-accumulates, and its
+ * latency bounds the single-channel filters.  The channels are independent: the functions
+ * keep the five coefficients of a stage in registers, and run the recursions of four
+ * channels (two for Q31) side by side on Cortex-M3 and Cortex-M4, one channel at a time
+ * on Cortex-M0.
+ * The states of the channels of a group stay in registers for the whole block.
+ * On the host build with SIMD=1, the floating-point function runs one channel per vector lane.
+ *
+ * \par
+ * <code>pState</code> holds the states of each stage, channel by channel:
+ * <pre>
+ *     {d1[0..N-1], d2[0..N-1]} of stage 1, then of stage 2, ...                for the df2T function
+ *     {x[n-1][0..N-1], x[n-2][0..N-1], y[n-1][0..N-1], y[n-2][0..N-1]}, ...   for the df1 function
+ * </pre>
+ * of length <code>2*numStages*numChannels</code> and <code>4*numStages*numChannels</code> values.
+ * The state variables are updated after each block of data is processed; the coefficients are untouched.
+ *
+ * \par Instance Structure
+ * The instance holds the number of stages and of channels, and the pointers to the state and
+ * coefficient arrays.  The coefficients may be shared among several instances, the states may not.
+ * The init functions set the fields and clear the state.
+ */
+
+/**
+ * @addtogroup BiquadCascadeMulti
+ * @{
+ */
+
+/**
+ * @brief Processing function for the floating-point multi-channel transposed direct form II Biquad cascade filter.
+ * @param[in]  *S        points to an instance of the filter data structure.
+ * @param[in]  *pSrc     points to the block of interleaved input data.
+ * @param[out] *pDst     points to the block of interleaved output data.
+ * @param[in]  blockSize number of frames to process.
+ * @return none.
+ */
+
+void arm_biquad_cascade_multi_df2T_f32(
+  const arm_biquad_cascade_multi_df2T_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pIn = pSrc;                         /*  source pointer            */
+  float32_t *pState = S->pState;                 /*  State pointer             */
+  float32_t *pCoeffs = S->pCoeffs;               /*  coefficient pointer       */
+  float32_t *px, *py;                            /*  sample pointers           */
+  float32_t acc1;                                /*  accumulator               */
+  float32_t b0, b1, b2, a1, a2;                  /*  Filter coefficients       */
+  float32_t Xn1;                                 /*  temporary input           */
+  float32_t d1a, d2a;                            /*  state variables           */
+  uint32_t numCh = S->numChannels;               /*  number of channels        */
+  uint32_t sample, ch, stage = S->numStages;     /*  loop counters             */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  float32_t acc2, acc3, acc4;                    /*  accumulators              */
+  float32_t Xn2, Xn3, Xn4;                       /*  temporary inputs          */
+  float32_t d1b, d2b, d1c, d2c, d1d, d2d;        /*  state variables           */
+
+  do
+  {
+    /* Reading the coefficients */
+    b0 = *pCoeffs++;
+    b1 = *pCoeffs++;
+    b2 = *pCoeffs++;
+    a1 = *pCoeffs++;
+    a2 = *pCoeffs++;
+
+    /* Groups of four channels: four independent recursions */
+    ch = 0u;
+    while((ch + 4u) <= numCh)
+    {
+      /* Reading the state values */
+      d1a = pState[ch];
+      d1b = pState[ch + 1u];
+      d1c = pState[ch + 2u];
+      d1d = pState[ch + 3u];
+      d2a = pState[numCh + ch];
+      d2b = pState[numCh + ch + 1u];
+      d2c = pState[numCh + ch + 2u];
+      d2d = pState[numCh + ch + 3u];
+
+      px = pIn + ch;
+      py = pDst + ch;
+      sample = blockSize;
+
+      while(sample > 0u)
+      {
+        /* Read the inputs of the four channels */
+        Xn1 = px[0];
+        Xn2 = px[1];
+        Xn3 = px[2];
+        Xn4 = px[3];
+        px += numCh;
+
+        /* y[n] = b0 * x[n] + d1 */
+        acc1 = (b0 * Xn1) + d1a;
+        acc2 = (b0 * Xn2) + d1b;
+        acc3 = (b0 * Xn3) + d1c;
+        acc4 = (b0 * Xn4) + d1d;
+
+        /* d1 = b1 * x[n] + a1 * y[n] + d2 */
+        d1a = ((b1 * Xn1) + (a1 * acc1)) + d2a;
+        d1b = ((b1 * Xn2) + (a1 * acc2)) + d2b;
+        d1c = ((b1 * Xn3) + (a1 * acc3)) + d2c;
+        d1d = ((b1 * Xn4) + (a1 * acc4)) + d2d;
+
+        /* d2 = b2 * x[n] + a2 * y[n] */
+        d2a = (b2 * Xn1) + (a2 * acc1);
+        d2b = (b2 * Xn2) + (a2 * acc2);
+        d2c = (b2 * Xn3) + (a2 * acc3);
+        d2d = (b2 * Xn4) + (a2 * acc4);
+
+        py[0] = acc1;
+        py[1] = acc2;
+        py[2] = acc3;
+        py[3] = acc4;
+        py += numCh;
+
+        sample--;
+      }
+
+      /* Store the updated state variables back into the state array */
+      pState[ch] = d1a;
+      pState[ch + 1u] = d1b;
+      pState[ch + 2u] = d1c;
+      pState[ch + 3u] = d1d;
+      pState[numCh + ch] = d2a;
+      pState[numCh + ch + 1u] = d2b;
+      pState[numCh + ch + 2u] = d2c;
+      pState[numCh + ch + 3u] = d2d;
+
+      ch += 4u;
+    }
+
+    /* The remaining 1 to 3 channels, one at a time */
+    while(ch < numCh)
+    {
+      d1a = pState[ch];
+      d2a = pState[numCh + ch];
+
+      px = pIn + ch;
+      py = pDst + ch;
+      sample = blockSize;
+
+      while(sample > 0u)
+      {
+        Xn1 = *px;
+        px += numCh;
+
+        acc1 = (b0 * Xn1) + d1a;
+        d1a = ((b1 * Xn1) + (a1 * acc1)) + d2a;
+        d2a = (b2 * Xn1) + (a2 * acc1);
+
+        *py = acc1;
+        py += numCh;
+
+        sample--;
+      }
+
+      pState[ch] = d1a;
+      pState[numCh + ch] = d2a;
+
+      ch++;
+    }
+
+    /* The current stage input is given as the output to the next stage */
+    pIn = pDst;
+
+    pState += 2u * numCh;
+
+    /* decrement the loop counter */
+    stage--;
+
+  } while(stage > 0u);
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  do
+  {
+    /* Reading the coefficients */
+    b0 = *pCoeffs++;
+    b1 = *pCoeffs++;
+    b2 = *pCoeffs++;
+    a1 = *pCoeffs++;
+    a2 = *pCoeffs++;
+
+    for (ch = 0u; ch < numCh; ch++)
+    {
+      /* Reading the state values */
+      d1a = pState[ch];
+      d2a = pState[numCh + ch];
+
+      px = pIn + ch;
+      py = pDst + ch;
+      sample = blockSize;
+
+      while(sample > 0u)
+      {
+        /* Read the input */
+        Xn1 = *px;
+        px += numCh;
+
+        /* y[n] = b0 * x[n] + d1 */
+        acc1 = (b0 * Xn1) + d1a;
+
+        /* Store the result in the destination buffer. */
+        *py = acc1;
+        py += numCh;
+
+        /* d1 = b1 * x[n] + a1 * y[n] + d2 */
+        d1a = ((b1 * Xn1) + (a1 * acc1)) + d2a;
+
+        /* d2 = b2 * x[n] + a2 * y[n] */
+        d2a = (b2 * Xn1) + (a2 * acc1);
+
+        /* decrement the loop counter */
+        sample--;
+      }
+
+      /* Store the updated state variables back into the state array */
+      pState[ch] = d1a;
+      pState[numCh + ch] = d2a;
+    }
+
+    /* The current stage input is given as the output to the next stage */
+    pIn = pDst;
+
+    pState += 2u * numCh;
+
+    /* decrement the loop counter */
+    stage--;
+
+  } while(stage > 0u);
+
+#endif /*   #ifndef ARM_MATH_CM0_FAMILY */
+
+}
+
+/**
+ * @} end of BiquadCascadeMulti group
+ */
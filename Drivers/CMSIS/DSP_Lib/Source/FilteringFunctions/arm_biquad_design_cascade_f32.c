@@ -0,0 +1,201 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_biquad_design_cascade_f32.c
+*
+* Description:  Butterworth and Chebyshev type I Biquad cascade design.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FilterDesign
+ * @{
+ */
+
+#define CASCADE_PI_F64 3.14159265358979323846
+
+/**
+ * @brief  Bilinear transform of the analog prototype, common to both designs.
+ * @param[in]  type      ARM_FILTER_LOWPASS or ARM_FILTER_HIGHPASS.
+ * @param[in]  order     filter order.
+ * @param[in]  freq      edge frequency, as a fraction of the sample rate.
+ * @param[in]  sh        scale of the real parts of the prototype poles.
+ * @param[in]  ch        scale of the imaginary parts of the prototype poles.
+ * @param[in]  gain      gain of the first stage.
+ * @param[out] *pCoeffs  points to the coefficients.
+ * @return none.
+ *
+ * The poles of the prototype of edge 1 rad/s are <code>-sh*sin(t) + j*ch*cos(t)</code>,
+ * <code>t = pi*(2k+1)/(2*order)</code>.  The edge is prewarped to <code>K = tan(pi*freq)</code>,
+ * and <code>s = (1 - z^-1) / (1 + z^-1)</code>.
+ */
+
+static void arm_biquad_design_poles(
+  arm_filter_type type,
+  uint8_t order,
+  float32_t freq,
+  float64_t sh,
+  float64_t ch,
+  float64_t gain,
+  float32_t * pCoeffs)
+{
+  float64_t K = tan(CASCADE_PI_F64 * (float64_t) freq);    /* Prewarped edge frequency */
+  float64_t t, re, im, a, w2, c;                 /* Pole of the prototype and its section */
+  float64_t b0, b1, b2, a0, a1, a2;              /* Coefficients before normalization */
+  uint32_t numPairs = (uint32_t) order >> 1u;    /* Complex conjugate pole pairs */
+  uint32_t k;                                    /* Loop counter */
+
+  /* The real pole of an odd order gives a 1st order stage, at the head of the cascade */
+  if((order & 1u) != 0u)
+  {
+    c = sh;
+
+    if(type == ARM_FILTER_LOWPASS)
+    {
+      b0 = c * K;
+      b1 = c * K;
+      a0 = 1.0 + (c * K);
+      a1 = (c * K) - 1.0;
+    }
+    else
+    {
+      b0 = c;
+      b1 = -c;
+      a0 = K + c;
+      a1 = K - c;
+    }
+
+    b0 *= gain;
+    b1 *= gain;
+    gain = 1.0;
+
+    *pCoeffs++ = (float32_t) (b0 / a0);
+    *pCoeffs++ = (float32_t) (b1 / a0);
+    *pCoeffs++ = 0.0f;
+    *pCoeffs++ = (float32_t) (-a1 / a0);
+    *pCoeffs++ = 0.0f;
+  }
+
+  /* The pairs by increasing Q: the pole of k = 0 is the closest to the imaginary axis */
+  for (k = numPairs; k > 0u; k--)
+  {
+    t = (CASCADE_PI_F64 * (float64_t) ((2u * k) - 1u)) / (2.0 * (float64_t) order);
+    re = -sh * sin(t);
+    im = ch * cos(t);
+
+    /* Section w2 / (s^2 + a*s + w2) of the prototype */
+    a = -2.0 * re;
+    w2 = (re * re) + (im * im);
+
+    if(type == ARM_FILTER_LOWPASS)
+    {
+      b0 = w2 * K * K;
+      b1 = 2.0 * b0;
+      b2 = b0;
+      a0 = (1.0 + (a * K)) + (w2 * K * K);
+      a1 = -2.0 + (2.0 * w2 * K * K);
+      a2 = (1.0 - (a * K)) + (w2 * K * K);
+    }
+    else
+    {
+      b0 = w2;
+      b1 = -2.0 * w2;
+      b2 = w2;
+      a0 = ((K * K) + (a * K)) + w2;
+      a1 = (2.0 * K * K) - (2.0 * w2);
+      a2 = ((K * K) - (a * K)) + w2;
+    }
+
+    b0 *= gain;
+    b1 *= gain;
+    b2 *= gain;
+    gain = 1.0;
+
+    *pCoeffs++ = (float32_t) (b0 / a0);
+    *pCoeffs++ = (float32_t) (b1 / a0);
+    *pCoeffs++ = (float32_t) (b2 / a0);
+    *pCoeffs++ = (float32_t) (-a1 / a0);
+    *pCoeffs++ = (float32_t) (-a2 / a0);
+  }
+}
+
+/**
+ * @brief  Designs a Butterworth low-pass or high-pass Biquad cascade.
+ * @param[in]  type      ARM_FILTER_LOWPASS or ARM_FILTER_HIGHPASS.
+ * @param[in]  order     filter order, 1 to 255.  The cascade has (order+1)/2 stages.
+ * @param[in]  freq      -3 dB frequency, as a fraction of the sample rate, in (0, 0.5).
+ * @param[out] *pCoeffs  points to the 5*((order+1)/2) coefficients.
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if an argument is out of range.
+ *
+ * \par
+ * The response is maximally flat, with a gain of 1 in the passband and of -3.01 dB at <code>freq</code>.
+ */
+
+arm_status arm_biquad_design_butterworth_f32(
+  arm_filter_type type,
+  uint8_t order,
+  float32_t freq,
+  float32_t * pCoeffs)
+{
+  if(((type != ARM_FILTER_LOWPASS) && (type != ARM_FILTER_HIGHPASS)) ||
+     (order == 0u) || (freq <= 0.0f) || (freq >= 0.5f))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  /* The Butterworth poles lie on the unit circle */
+  arm_biquad_design_poles(type, order, freq, 1.0, 1.0, 1.0, pCoeffs);
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @brief  Designs a Chebyshev type I low-pass or high-pass Biquad cascade.
+ * @param[in]  type      ARM_FILTER_LOWPASS or ARM_FILTER_HIGHPASS.
+ * @param[in]  order     filter order, 1 to 255.  The cascade has (order+1)/2 stages.
+ * @param[in]  freq      passband edge, as a fraction of the sample rate, in (0, 0.5).
+ * @param[in]  rippleDb  passband ripple in dB, greater than 0.
+ * @param[out] *pCoeffs  points to the 5*((order+1)/2) coefficients.
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if an argument is out of range.
+ *
+ * \par
+ * The gain ripples between 1 and <code>-rippleDb</code> dB in the passband, and is
+ * <code>-rippleDb</code> dB at <code>freq</code>.
+ */
+
+arm_status arm_biquad_design_chebyshev1_f32(
+  arm_filter_type type,
+  uint8_t order,
+  float32_t freq,
+  float32_t rippleDb,
+  float32_t * pCoeffs)
+{
+  float64_t eps, mu, gain;                       /* Ripple factor and pole scale */
+
+  if(((type != ARM_FILTER_LOWPASS) && (type != ARM_FILTER_HIGHPASS)) ||
+     (order == 0u) || (freq <= 0.0f) || (freq >= 0.5f) || (rippleDb <= 0.0f))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  eps = sqrt(pow(10.0, (float64_t) rippleDb / 10.0) - 1.0);
+  mu = log((1.0 / eps) + sqrt((1.0 / (eps * eps)) + 1.0)) / (float64_t) order;
+
+  /* An even order starts the passband at the bottom of the ripple */
+  gain = ((order & 1u) != 0u) ? 1.0 : (1.0 / sqrt(1.0 + (eps * eps)));
+
+  /* The Chebyshev poles lie on an ellipse */
+  arm_biquad_design_poles(type, order, freq, sinh(mu), cosh(mu), gain, pCoeffs);
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of FilterDesign group
+ */
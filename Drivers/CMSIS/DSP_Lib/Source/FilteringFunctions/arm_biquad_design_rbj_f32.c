@@ -0,0 +1,178 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_biquad_design_rbj_f32.c
+*
+* Description:  Biquad section design from the RBJ audio EQ cookbook.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @defgroup FilterDesign Filter Design
+ *
+ * These functions compute, at run time, the coefficients of the Biquad cascades and of
+ * the FIR filters, in the layout that the init functions of the filters expect.
+ *
+ * \par Biquad cascades
+ * <code>arm_biquad_design_rbj_f32()</code> designs one 2nd order section from the formulas of
+ * the RBJ audio EQ cookbook: low-pass, high-pass, band-pass, notch, all-pass, peaking and shelf.
+ * <code>arm_biquad_design_butterworth_f32()</code> and <code>arm_biquad_design_chebyshev1_f32()</code>
+ * design low-pass and high-pass cascades of any order, by the bilinear transform of the analog
+ * prototype.  Each pair of complex conjugate poles gives a stage, and the stages come by
+ * increasing Q, so that the resonant ones see a signal already filtered.  An odd order adds
+ * a 1st order stage, with <code>b2 = a2 = 0</code>, at the head of the cascade.
+ *
+ * \par
+ * The coefficients are written 5 per stage, in the order and with the sign convention of
+ * <code>arm_biquad_cascade_df1_f32()</code> and <code>arm_biquad_cascade_df2T_f32()</code>:
+ * <pre>
+ *     {b10, b11, b12, a11, a12, b20, b21, b22, a21, a22, ...}
+ * </pre>
+ * with the feedback coefficients negated, so that <code>y[n] = ... + a1 * y[n-1] + a2 * y[n-2]</code>.
+ * <code>arm_biquad_design_to_q31()</code> and <code>arm_biquad_design_to_q15()</code> convert
+ * them to the layout of <code>arm_biquad_cascade_df1_q31()</code> and
+ * <code>arm_biquad_cascade_df1_q15()</code>, and compute the <code>postShift</code> of the init
+ * functions.
+ *
+ * \par FIR filters
+ * <code>arm_fir_design_window_f32()</code> designs linear-phase filters by the window method,
+ * and <code>arm_fir_design_remez_f32()</code> equiripple filters by the Parks-McClellan
+ * algorithm.  The coefficients are symmetric, so that the time-reversed order of
+ * <code>arm_fir_init_f32()</code> is also the natural one.  The fixed-point FIR filters take
+ * them through <code>arm_float_to_q31()</code>, <code>arm_float_to_q15()</code> or
+ * <code>arm_float_to_q7()</code>; the window and Parks-McClellan designs have a gain of at most
+ * about 1 at every frequency, and their coefficients are below 1 in magnitude.
+ *
+ * \par
+ * The frequencies are fractions of the sample rate, in <code>(0, 0.5)</code>.
+ * The design is computed in double precision, and the functions are meant for set-up
+ * time rather than for the processing loop.
+ */
+
+/**
+ * @addtogroup FilterDesign
+ * @{
+ */
+
+#define RBJ_PI_F64 3.14159265358979323846
+
+/**
+ * @brief  Designs one Biquad section from the RBJ audio EQ cookbook.
+ * @param[in]  type      response type.
+ * @param[in]  freq      cutoff or center frequency, as a fraction of the sample rate, in (0, 0.5).
+ * @param[in]  q         quality factor, greater than 0.
+ * @param[in]  gainDb    gain in dB of the peaking and shelf types, ignored by the others.
+ * @param[out] *pCoeffs  points to the 5 coefficients {b0, b1, b2, a1, a2}.
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if an argument is out of range.
+ *
+ * \par
+ * For the shelf types, <code>q</code> sets the slope of the transition; 0.7071 gives the
+ * steepest slope without overshoot.
+ */
+
+arm_status arm_biquad_design_rbj_f32(
+  arm_filter_type type,
+  float32_t freq,
+  float32_t q,
+  float32_t gainDb,
+  float32_t * pCoeffs)
+{
+  float64_t w0, cw, alpha, A, sA;                /* Intermediate values of the cookbook */
+  float64_t b0, b1, b2, a0, a1, a2;              /* Coefficients before normalization */
+
+  if((freq <= 0.0f) || (freq >= 0.5f) || (q <= 0.0f))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  w0 = 2.0 * RBJ_PI_F64 * (float64_t) freq;
+  cw = cos(w0);
+  alpha = sin(w0) / (2.0 * (float64_t) q);
+  A = pow(10.0, (float64_t) gainDb / 40.0);
+  sA = 2.0 * sqrt(A) * alpha;
+
+  a0 = 1.0 + alpha;
+  a1 = -2.0 * cw;
+  a2 = 1.0 - alpha;
+
+  switch (type)
+  {
+  case ARM_FILTER_LOWPASS:
+    b1 = 1.0 - cw;
+    b0 = 0.5 * b1;
+    b2 = b0;
+    break;
+
+  case ARM_FILTER_HIGHPASS:
+    b1 = -(1.0 + cw);
+    b0 = -0.5 * b1;
+    b2 = b0;
+    break;
+
+  case ARM_FILTER_BANDPASS:
+    b0 = alpha;
+    b1 = 0.0;
+    b2 = -alpha;
+    break;
+
+  case ARM_FILTER_BANDSTOP:
+    b0 = 1.0;
+    b1 = -2.0 * cw;
+    b2 = 1.0;
+    break;
+
+  case ARM_FILTER_ALLPASS:
+    b0 = 1.0 - alpha;
+    b1 = -2.0 * cw;
+    b2 = 1.0 + alpha;
+    break;
+
+  case ARM_FILTER_PEAKING:
+    b0 = 1.0 + (alpha * A);
+    b1 = -2.0 * cw;
+    b2 = 1.0 - (alpha * A);
+    a0 = 1.0 + (alpha / A);
+    a2 = 1.0 - (alpha / A);
+    break;
+
+  case ARM_FILTER_LOWSHELF:
+    b0 = A * (((A + 1.0) - ((A - 1.0) * cw)) + sA);
+    b1 = 2.0 * A * ((A - 1.0) - ((A + 1.0) * cw));
+    b2 = A * (((A + 1.0) - ((A - 1.0) * cw)) - sA);
+    a0 = ((A + 1.0) + ((A - 1.0) * cw)) + sA;
+    a1 = -2.0 * ((A - 1.0) + ((A + 1.0) * cw));
+    a2 = ((A + 1.0) + ((A - 1.0) * cw)) - sA;
+    break;
+
+  case ARM_FILTER_HIGHSHELF:
+    b0 = A * (((A + 1.0) + ((A - 1.0) * cw)) + sA);
+    b1 = -2.0 * A * ((A - 1.0) + ((A + 1.0) * cw));
+    b2 = A * (((A + 1.0) + ((A - 1.0) * cw)) - sA);
+    a0 = ((A + 1.0) - ((A - 1.0) * cw)) + sA;
+    a1 = 2.0 * ((A - 1.0) - ((A + 1.0) * cw));
+    a2 = ((A + 1.0) - ((A - 1.0) * cw)) - sA;
+    break;
+
+  default:
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  /* Normalize by a0, and negate the feedback coefficients for the Biquad cascades */
+  pCoeffs[0] = (float32_t) (b0 / a0);
+  pCoeffs[1] = (float32_t) (b1 / a0);
+  pCoeffs[2] = (float32_t) (b2 / a0);
+  pCoeffs[3] = (float32_t) (-a1 / a0);
+  pCoeffs[4] = (float32_t) (-a2 / a0);
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of FilterDesign group
+ */
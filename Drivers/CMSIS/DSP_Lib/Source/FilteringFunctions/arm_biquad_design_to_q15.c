@@ -0,0 +1,100 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_biquad_design_to_q15.c
+*
+* Description:  Conversion of designed Biquad coefficients to Q15.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FilterDesign
+ * @{
+ */
+
+/**
+ * @brief  Converts designed Biquad coefficients to the layout of the Q15 Biquad cascades.
+ * @param[in]  *pSrc        points to the 5*numStages floating-point coefficients.
+ * @param[in]  numStages    number of 2nd order stages.
+ * @param[out] *pDst        points to the 6*numStages Q15 coefficients.
+ * @param[out] *pPostShift  points to the postShift of the init function.
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if a coefficient needs a postShift above 15.
+ *
+ * \par
+ * The coefficients of <code>arm_biquad_cascade_df1_q15()</code> are in 1.15 format, scaled
+ * down by <code>2^postShift</code>, with a zero after <code>b0</code> for the dual multiplies:
+ * <pre>
+ *     {b10, 0, b11, b12, a11, a12, b20, 0, b21, b22, a21, a22, ...}
+ * </pre>
+ * The function picks the smallest <code>postShift</code> that fits the largest coefficient
+ * of the cascade, and rounds the coefficients to nearest, with saturation.
+ * The 15-bit coefficients limit the precision of poles close to the unit circle: narrow
+ * band-pass sections and low cutoffs are better served by the Q31 cascades.
+ */
+
+arm_status arm_biquad_design_to_q15(
+  const float32_t * pSrc,
+  uint8_t numStages,
+  q15_t * pDst,
+  int8_t * pPostShift)
+{
+  uint32_t numCoeffs = 5u * (uint32_t) numStages;  /* Number of coefficients */
+  float64_t maxAbs = 0.0, scale, v;              /* Largest magnitude and conversion scale */
+  int32_t shift = 0;                             /* postShift */
+  uint32_t i;                                    /* Loop counter */
+  q15_t c[5];                                    /* Coefficients of a stage */
+
+  for (i = 0u; i < numCoeffs; i++)
+  {
+    v = fabs((float64_t) pSrc[i]);
+    if(v > maxAbs)
+    {
+      maxAbs = v;
+    }
+  }
+
+  /* Smallest shift that brings the coefficients within [-1 1) */
+  while((maxAbs >= ldexp(1.0, shift)) && (shift <= 15))
+  {
+    shift++;
+  }
+
+  if(shift > 15)
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  scale = ldexp(1.0, 15 - shift);
+
+  for (i = 0u; i < numCoeffs; i++)
+  {
+    /* Round to nearest, and saturate the values at +1 */
+    v = floor(((float64_t) pSrc[i] * scale) + 0.5);
+    c[i % 5u] = (v >= 32767.0) ? (q15_t) 0x7FFF : (q15_t) v;
+
+    /* Write the stage with the zero after b0 */
+    if((i % 5u) == 4u)
+    {
+      *pDst++ = c[0];
+      *pDst++ = 0;
+      *pDst++ = c[1];
+      *pDst++ = c[2];
+      *pDst++ = c[3];
+      *pDst++ = c[4];
+    }
+  }
+
+  *pPostShift = (int8_t) shift;
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of FilterDesign group
+ */
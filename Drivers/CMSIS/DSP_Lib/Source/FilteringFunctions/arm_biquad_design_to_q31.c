@@ -0,0 +1,86 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_biquad_design_to_q31.c
+*
+* Description:  Conversion of designed Biquad coefficients to Q31.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FilterDesign
+ * @{
+ */
+
+/**
+ * @brief  Converts designed Biquad coefficients to the layout of the Q31 Biquad cascades.
+ * @param[in]  *pSrc        points to the 5*numStages floating-point coefficients.
+ * @param[in]  numStages    number of 2nd order stages.
+ * @param[out] *pDst        points to the 5*numStages Q31 coefficients.
+ * @param[out] *pPostShift  points to the postShift of the init function.
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if a coefficient needs a postShift above 15.
+ *
+ * \par
+ * The coefficients of <code>arm_biquad_cascade_df1_q31()</code> are in 1.31 format, scaled
+ * down by <code>2^postShift</code>.  The function picks the smallest <code>postShift</code>
+ * that fits the largest coefficient of the cascade, and rounds the coefficients to nearest,
+ * with saturation.  The coefficients of Biquad design are usually within [-2 2), for
+ * a <code>postShift</code> of 1; shelf and peaking sections of large gain need more.
+ * The result suits <code>arm_biquad_cascade_df1_init_q31()</code>,
+ * <code>arm_biquad_cas_df1_32x64_init_q31()</code> and the multi-channel Q31 cascade.
+ */
+
+arm_status arm_biquad_design_to_q31(
+  const float32_t * pSrc,
+  uint8_t numStages,
+  q31_t * pDst,
+  int8_t * pPostShift)
+{
+  uint32_t numCoeffs = 5u * (uint32_t) numStages;  /* Number of coefficients */
+  float64_t maxAbs = 0.0, scale, v;              /* Largest magnitude and conversion scale */
+  int32_t shift = 0;                             /* postShift */
+  uint32_t i;                                    /* Loop counter */
+
+  for (i = 0u; i < numCoeffs; i++)
+  {
+    v = fabs((float64_t) pSrc[i]);
+    if(v > maxAbs)
+    {
+      maxAbs = v;
+    }
+  }
+
+  /* Smallest shift that brings the coefficients within [-1 1) */
+  while((maxAbs >= ldexp(1.0, shift)) && (shift <= 15))
+  {
+    shift++;
+  }
+
+  if(shift > 15)
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  scale = ldexp(1.0, 31 - shift);
+
+  for (i = 0u; i < numCoeffs; i++)
+  {
+    /* Round to nearest, and saturate the values at +1 */
+    v = floor(((float64_t) pSrc[i] * scale) + 0.5);
+    pDst[i] = (v >= 2147483647.0) ? (q31_t) 0x7FFFFFFF : (q31_t) v;
+  }
+
+  *pPostShift = (int8_t) shift;
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of FilterDesign group
+ */
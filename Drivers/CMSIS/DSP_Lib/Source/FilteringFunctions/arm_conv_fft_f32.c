@@ -0,0 +1,243 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_conv_fft_f32.c
+*
+* Description:  Fast convolution of floating-point sequences by overlap-save
+*               on the real FFT.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup Conv
+ * @{
+ */
+
+/**
+ * <b>FFT Versions</b>
+ *
+ * \par
+ * <code>arm_conv_fft_f32()</code> and <code>arm_conv_fft_q31()</code> compute the same
+ * result as <code>arm_conv_f32()</code> and <code>arm_conv_q31()</code> by overlap-save:
+ * the shorter sequence is the filter, its spectrum is computed once, and the longer
+ * sequence is cut in overlapping blocks of <code>fftLen</code> samples that are
+ * transformed, multiplied by the filter spectrum and transformed back.
+ * Each block yields <code>fftLen - min(srcALen, srcBLen) + 1</code> output samples,
+ * so the cost grows with <code>log2(fftLen)</code> per output sample instead of
+ * <code>min(srcALen, srcBLen)</code>.
+ *
+ * \par
+ * The transform length is picked by <code>arm_conv_fft_len_f32()</code> and
+ * <code>arm_conv_fft_len_q31()</code>, from a cost model of the direct and the FFT
+ * form.  They return 0 when the direct form is cheaper, and the FFT versions then
+ * call the direct function.  The caller sizes the scratch buffer from the returned
+ * length.  The filter is limited to half the largest FFT (2048 samples): longer
+ * filters use the direct form.
+ */
+
+/* Relative cost of one transform block, per fftLen * log2(fftLen), in units of
+ * one step of the inner loop of the direct form.  Measured on the host build
+ * with the crossover benchmark of the filtering suite. */
+#if defined (ARM_MATH_CM0_FAMILY)
+#define CONV_FFT_BLOCK_COST_F32      1.8f
+#else
+#define CONV_FFT_BLOCK_COST_F32      6.5f
+#endif
+
+#define CONV_FFT_MIN_LEN_F32         32u
+#define CONV_FFT_MAX_LEN_F32         4096u
+
+/**
+ * @brief Transform length of the FFT convolution of floating-point sequences.
+ * @param[in] srcALen length of the first input sequence.
+ * @param[in] srcBLen length of the second input sequence.
+ * @return fftLen of <code>arm_conv_fft_f32()</code> and <code>arm_correlate_fft_f32()</code>,
+ * or 0 when they use the direct form.
+ *
+ * \par
+ * The scratch buffer of the FFT versions holds <code>3 * fftLen</code> samples.
+ */
+
+uint32_t arm_conv_fft_len_f32(
+  uint32_t srcALen,
+  uint32_t srcBLen)
+{
+  uint32_t lenM, lenN, fftLen, log2Len, step, numBlocks, bestLen = 0u;
+  float32_t cost, bestCost;
+
+  /* The shorter sequence is the filter */
+  lenM = (srcALen < srcBLen) ? srcALen : srcBLen;
+  lenN = (srcALen < srcBLen) ? srcBLen : srcALen;
+
+  /* Cost of the direct form */
+#if defined (ARM_MATH_CM0_FAMILY)
+  /* The generic loop visits every earlier sample for each output */
+  bestCost = 0.5f * (float32_t) (lenN + lenM - 1u) * (float32_t) (lenN + lenM);
+#else
+  bestCost = (float32_t) lenM *(float32_t) lenN;
+#endif
+
+  /* Smallest transform of at least twice the filter length */
+  fftLen = CONV_FFT_MIN_LEN_F32;
+  log2Len = 5u;
+  while(fftLen < (2u * lenM))
+  {
+    fftLen <<= 1u;
+    log2Len++;
+  }
+
+  /* Try each longer transform: fewer blocks against a larger cost per block */
+  while((lenM > 0u) && (fftLen <= CONV_FFT_MAX_LEN_F32))
+  {
+    step = fftLen - lenM + 1u;
+    numBlocks = (lenN + lenM - 1u + step - 1u) / step;
+
+    /* One extra half block for the spectrum of the filter */
+    cost = ((float32_t) numBlocks + 0.5f) * CONV_FFT_BLOCK_COST_F32 *
+      (float32_t) fftLen *(float32_t) log2Len;
+
+    if(cost < bestCost)
+    {
+      bestCost = cost;
+      bestLen = fftLen;
+    }
+
+    fftLen <<= 1u;
+    log2Len++;
+  }
+
+  return (bestLen);
+}
+
+/**
+ * @brief Overlap-save engine of the FFT convolution and correlation.
+ * @param[in]  *pSig points to the longer input sequence.
+ * @param[in]  sigLen length of the longer input sequence.
+ * @param[in]  *pFilt points to the shorter input sequence.
+ * @param[in]  filtLen length of the shorter input sequence.
+ * @param[in]  flipFilt when 1, the filter is read in reverse order.
+ * @param[out] *pDst points to the first output sample written.
+ * @param[in]  dstInc step between output samples, 1 or -1.
+ * @param[in]  fftLen transform length from <code>arm_conv_fft_len_f32()</code>.
+ * @param[in]  *pScratch points to a buffer of <code>3 * fftLen</code> samples.
+ * @return none.
+ *
+ * \par
+ * Writes the <code>sigLen + filtLen - 1</code> samples of the linear convolution.
+ */
+
+void arm_conv_fft_os_f32(
+  float32_t * pSig,
+  uint32_t sigLen,
+  float32_t * pFilt,
+  uint32_t filtLen,
+  uint8_t flipFilt,
+  float32_t * pDst,
+  int32_t dstInc,
+  uint32_t fftLen,
+  float32_t * pScratch)
+{
+  arm_rfft_fast_instance_f32 S;                  /* Real FFT instance */
+  float32_t *pH = pScratch;                      /* Filter spectrum */
+  float32_t *pA = pScratch + fftLen;             /* Time-domain block */
+  float32_t *pB = pScratch + (2u * fftLen);      /* Frequency-domain block */
+  float32_t xr, xi, hr, hi;                      /* Spectrum values */
+  uint32_t outLen = (sigLen + filtLen) - 1u;     /* Output length */
+  uint32_t step = (fftLen - filtLen) + 1u;       /* Output samples per block */
+  uint32_t outPos, numOut, i;                    /* Output position and count */
+  int32_t idx;                                   /* Index of the input sample */
+
+  arm_rfft_fast_init_f32(&S, (uint16_t) fftLen);
+
+  /* Filter spectrum, from the filter zero-padded to fftLen */
+  for (i = 0u; i < filtLen; i++)
+  {
+    pA[i] = (flipFilt == 1u) ? pFilt[filtLen - 1u - i] : pFilt[i];
+  }
+  arm_fill_f32(0.0f, pA + filtLen, fftLen - filtLen);
+  arm_rfft_fast_f32(&S, pA, pH, 0u);
+
+  for (outPos = 0u; outPos < outLen; outPos += step)
+  {
+    /* Block of the input that precedes the outputs by filtLen - 1 samples,
+     * with zeros before the start and after the end of the input */
+    idx = (int32_t) outPos - (int32_t) (filtLen - 1u);
+    for (i = 0u; i < fftLen; i++, idx++)
+    {
+      pA[i] = ((idx >= 0) && (idx < (int32_t) sigLen)) ? pSig[idx] : 0.0f;
+    }
+
+    arm_rfft_fast_f32(&S, pA, pB, 0u);
+
+    /* Packed spectra: DC and Nyquist are real and share the first pair */
+    pB[0] *= pH[0];
+    pB[1] *= pH[1];
+    for (i = 2u; i < fftLen; i += 2u)
+    {
+      xr = pB[i];
+      xi = pB[i + 1u];
+      hr = pH[i];
+      hi = pH[i + 1u];
+      pB[i] = (xr * hr) - (xi * hi);
+      pB[i + 1u] = (xr * hi) + (xi * hr);
+    }
+
+    arm_rfft_fast_f32(&S, pB, pA, 1u);
+
+    /* The first filtLen - 1 samples of the circular convolution wrap around */
+    numOut = ((outLen - outPos) < step) ? (outLen - outPos) : step;
+    for (i = 0u; i < numOut; i++)
+    {
+      pDst[(int32_t) (outPos + i) * dstInc] = pA[filtLen - 1u + i];
+    }
+  }
+}
+
+/**
+ * @brief Convolution of floating-point sequences, by FFT for long sequences.
+ * @param[in]  *pSrcA points to the first input sequence.
+ * @param[in]  srcALen length of the first input sequence.
+ * @param[in]  *pSrcB points to the second input sequence.
+ * @param[in]  srcBLen length of the second input sequence.
+ * @param[out] *pDst points to the location where the output result is written.  Length srcALen+srcBLen-1.
+ * @param[in]  *pScratch points to a scratch buffer of <code>3 * arm_conv_fft_len_f32(srcALen, srcBLen)</code> samples.
+ * @return none.
+ *
+ * \par
+ * Uses <code>arm_conv_f32()</code> when <code>arm_conv_fft_len_f32()</code> returns 0,
+ * and the scratch buffer is then not accessed.
+ */
+
+void arm_conv_fft_f32(
+  float32_t * pSrcA,
+  uint32_t srcALen,
+  float32_t * pSrcB,
+  uint32_t srcBLen,
+  float32_t * pDst,
+  float32_t * pScratch)
+{
+  uint32_t fftLen = arm_conv_fft_len_f32(srcALen, srcBLen);
+
+  if(fftLen == 0u)
+  {
+    arm_conv_f32(pSrcA, srcALen, pSrcB, srcBLen, pDst);
+  }
+  else if(srcALen >= srcBLen)
+  {
+    arm_conv_fft_os_f32(pSrcA, srcALen, pSrcB, srcBLen, 0u, pDst, 1, fftLen, pScratch);
+  }
+  else
+  {
+    arm_conv_fft_os_f32(pSrcB, srcBLen, pSrcA, srcALen, 0u, pDst, 1, fftLen, pScratch);
+  }
+}
+
+/**
+ * @} end of Conv group
+ */
@@ -0,0 +1,354 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_conv_fft_q31.c
+*
+* Description:  Fast convolution of Q31 sequences by overlap-save on the
+*               complex FFT, with block floating-point scaling.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+#include "arm_const_structs.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup Conv
+ * @{
+ */
+
+/* Relative cost of one complex transform block (two blocks of output), per
+ * fftLen * log2(fftLen), in units of one step of the inner loop of the direct
+ * form.  Measured on the host build with the crossover benchmark of the
+ * filtering suite. */
+#if defined (ARM_MATH_CM0_FAMILY)
+#define CONV_FFT_BLOCK_COST_Q31      3.0f
+#else
+#define CONV_FFT_BLOCK_COST_Q31      10.0f
+#endif
+
+#define CONV_FFT_MIN_LEN_Q31         16u
+#define CONV_FFT_MAX_LEN_Q31         4096u
+
+/**
+ * @brief Transform length of the FFT convolution of Q31 sequences.
+ * @param[in] srcALen length of the first input sequence.
+ * @param[in] srcBLen length of the second input sequence.
+ * @return fftLen of <code>arm_conv_fft_q31()</code> and <code>arm_correlate_fft_q31()</code>,
+ * or 0 when they use the direct form.
+ *
+ * \par
+ * The scratch buffer of the FFT versions holds <code>4 * fftLen</code> samples.
+ */
+
+uint32_t arm_conv_fft_len_q31(
+  uint32_t srcALen,
+  uint32_t srcBLen)
+{
+  uint32_t lenM, lenN, fftLen, log2Len, step, numPairs, bestLen = 0u;
+  float32_t cost, bestCost;
+
+  /* The shorter sequence is the filter */
+  lenM = (srcALen < srcBLen) ? srcALen : srcBLen;
+  lenN = (srcALen < srcBLen) ? srcBLen : srcALen;
+
+  /* Cost of the direct form */
+#if defined (ARM_MATH_CM0_FAMILY)
+  /* The generic loop visits every earlier sample for each output */
+  bestCost = 0.5f * (float32_t) (lenN + lenM - 1u) * (float32_t) (lenN + lenM);
+#else
+  bestCost = (float32_t) lenM *(float32_t) lenN;
+#endif
+
+  /* Smallest transform of at least twice the filter length */
+  fftLen = CONV_FFT_MIN_LEN_Q31;
+  log2Len = 4u;
+  while(fftLen < (2u * lenM))
+  {
+    fftLen <<= 1u;
+    log2Len++;
+  }
+
+  /* Try each longer transform: fewer blocks against a larger cost per block */
+  while((lenM > 0u) && (fftLen <= CONV_FFT_MAX_LEN_Q31))
+  {
+    step = fftLen - lenM + 1u;
+    numPairs = (lenN + lenM - 1u + (2u * step) - 1u) / (2u * step);
+
+    /* One extra half block for the spectrum of the filter */
+    cost = ((float32_t) numPairs + 0.5f) * CONV_FFT_BLOCK_COST_Q31 *
+      (float32_t) fftLen *(float32_t) log2Len;
+
+    if(cost < bestCost)
+    {
+      bestCost = cost;
+      bestLen = fftLen;
+    }
+
+    fftLen <<= 1u;
+    log2Len++;
+  }
+
+  return (bestLen);
+}
+
+/**
+ * @brief Left shift that brings the largest magnitude of a buffer just
+ * below 0.5, 0 when it is already above.
+ */
+static uint32_t arm_conv_fft_headroom_q31(
+  q31_t * pSrc,
+  uint32_t numSamples)
+{
+  uint32_t mag, maxMag = 0u;                     /* Magnitudes */
+  uint32_t i;
+
+  for (i = 0u; i < numSamples; i++)
+  {
+    mag = (pSrc[i] < 0) ? (uint32_t) (-(q63_t) pSrc[i]) : (uint32_t) pSrc[i];
+    maxMag |= mag;
+  }
+
+  return ((__CLZ(maxMag) > 2u) ? (__CLZ(maxMag) - 2u) : 0u);
+}
+
+/**
+ * @brief Overlap-save engine of the FFT convolution and correlation.
+ * @param[in]  *pSig points to the longer input sequence.
+ * @param[in]  sigLen length of the longer input sequence.
+ * @param[in]  *pFilt points to the shorter input sequence.
+ * @param[in]  filtLen length of the shorter input sequence.
+ * @param[in]  flipFilt when 1, the filter is read in reverse order.
+ * @param[out] *pDst points to the first output sample written.
+ * @param[in]  dstInc step between output samples, 1 or -1.
+ * @param[in]  fftLen transform length from <code>arm_conv_fft_len_q31()</code>.
+ * @param[in]  *pScratch points to a buffer of <code>4 * fftLen</code> samples.
+ * @return none.
+ *
+ * \par
+ * Writes the <code>sigLen + filtLen - 1</code> samples of the linear convolution.
+ * The filter is real, so two consecutive blocks of the input go through one complex
+ * transform, as its real and imaginary parts.  The filter and each pair of input
+ * blocks are normalized before their transform, and the product of the spectra is
+ * rescaled to its own peak before the inverse transform; the exponents of the three
+ * scalings give the final shift of the output, which saturates to 1.31 as in
+ * <code>arm_conv_q31()</code>.
+ */
+
+void arm_conv_fft_os_q31(
+  q31_t * pSig,
+  uint32_t sigLen,
+  q31_t * pFilt,
+  uint32_t filtLen,
+  uint8_t flipFilt,
+  q31_t * pDst,
+  int32_t dstInc,
+  uint32_t fftLen,
+  q31_t * pScratch)
+{
+  const arm_cfft_instance_q31 *S;                /* Complex FFT instance */
+  q31_t *pH = pScratch;                          /* Filter spectrum */
+  q31_t *pW = pScratch + (2u * fftLen);          /* Working block */
+  q31_t xr, xi, hr, hi;                          /* Spectrum values */
+  q63_t re, im;                                  /* Products of the spectra */
+  uint64_t mag, maxMag;                          /* Magnitudes of the products */
+  uint32_t outLen = (sigLen + filtLen) - 1u;     /* Output length */
+  uint32_t step = (fftLen - filtLen) + 1u;       /* Output samples per block */
+  uint32_t outPos, numOut, pos, i, j;            /* Output positions and counts */
+  uint32_t log2Len, shiftH, shiftX;              /* Scaling exponents */
+  int32_t shiftP, shiftOut, idx;                 /* Scaling exponents and input index */
+  uint32_t hiWord;                               /* Upper word of the largest product */
+
+  switch (fftLen)
+  {
+  case 16u:
+    S = &arm_cfft_sR_q31_len16;
+    break;
+  case 32u:
+    S = &arm_cfft_sR_q31_len32;
+    break;
+  case 64u:
+    S = &arm_cfft_sR_q31_len64;
+    break;
+  case 128u:
+    S = &arm_cfft_sR_q31_len128;
+    break;
+  case 256u:
+    S = &arm_cfft_sR_q31_len256;
+    break;
+  case 512u:
+    S = &arm_cfft_sR_q31_len512;
+    break;
+  case 1024u:
+    S = &arm_cfft_sR_q31_len1024;
+    break;
+  case 2048u:
+    S = &arm_cfft_sR_q31_len2048;
+    break;
+  default:
+    S = &arm_cfft_sR_q31_len4096;
+    break;
+  }
+  log2Len = 31u - __CLZ(fftLen);
+
+  /* Filter spectrum, from the normalized filter zero-padded to fftLen */
+  arm_fill_q31(0, pH, 2u * fftLen);
+  for (i = 0u; i < filtLen; i++)
+  {
+    pH[2u * i] = (flipFilt == 1u) ? pFilt[filtLen - 1u - i] : pFilt[i];
+  }
+  shiftH = arm_conv_fft_headroom_q31(pH, 2u * filtLen);
+  for (i = 0u; i < filtLen; i++)
+  {
+    pH[2u * i] <<= shiftH;
+  }
+  arm_cfft_q31(S, pH, 0u, 1u);
+
+  for (outPos = 0u; outPos < outLen; outPos += 2u * step)
+  {
+    /* Blocks of the input that precede the two output blocks by filtLen - 1
+     * samples, in the real and the imaginary parts */
+    for (j = 0u; j < 2u; j++)
+    {
+      idx = (int32_t) (outPos + (j * step)) - (int32_t) (filtLen - 1u);
+      for (i = 0u; i < fftLen; i++, idx++)
+      {
+        pW[(2u * i) + j] = ((idx >= 0) && (idx < (int32_t) sigLen)) ? pSig[idx] : 0;
+      }
+    }
+    shiftX = arm_conv_fft_headroom_q31(pW, 2u * fftLen);
+    for (i = 0u; i < (2u * fftLen); i++)
+    {
+      pW[i] <<= shiftX;
+    }
+
+    arm_cfft_q31(S, pW, 0u, 1u);
+
+    /* Peak of the product of the spectra, in 3.61 format */
+    maxMag = 0u;
+    for (i = 0u; i < (2u * fftLen); i += 2u)
+    {
+      xr = pW[i];
+      xi = pW[i + 1u];
+      hr = pH[i];
+      hi = pH[i + 1u];
+      re = (((q63_t) xr * hr) >> 1) - (((q63_t) xi * hi) >> 1);
+      im = (((q63_t) xr * hi) >> 1) + (((q63_t) xi * hr) >> 1);
+      mag = (re < 0) ? (uint64_t) (-re) : (uint64_t) re;
+      maxMag |= mag;
+      mag = (im < 0) ? (uint64_t) (-im) : (uint64_t) im;
+      maxMag |= mag;
+    }
+
+    /* Shift that brings the peak just below 0.25 in 1.31 format, to leave
+     * the inverse transform its headroom */
+    hiWord = (uint32_t) (maxMag >> 32);
+    shiftP = (hiWord != 0u) ? (int32_t) (64u - __CLZ(hiWord)) :
+      (int32_t) (32u - __CLZ((uint32_t) maxMag));
+    shiftP -= 29;
+
+    for (i = 0u; i < (2u * fftLen); i += 2u)
+    {
+      xr = pW[i];
+      xi = pW[i + 1u];
+      hr = pH[i];
+      hi = pH[i + 1u];
+      re = (((q63_t) xr * hr) >> 1) - (((q63_t) xi * hi) >> 1);
+      im = (((q63_t) xr * hi) >> 1) + (((q63_t) xi * hr) >> 1);
+      if(shiftP >= 0)
+      {
+        pW[i] = (q31_t) (re >> shiftP);
+        pW[i + 1u] = (q31_t) (im >> shiftP);
+      }
+      else
+      {
+        pW[i] = (q31_t) (re << -shiftP);
+        pW[i + 1u] = (q31_t) (im << -shiftP);
+      }
+    }
+
+    arm_cfft_q31(S, pW, 1u, 1u);
+
+    /* The forward transforms scale by 1/fftLen each, the inverse one is the
+     * exact inverse: undo the spectra scaling and the three normalizations */
+    shiftOut = (int32_t) (2u * log2Len) + shiftP - 30 - (int32_t) shiftX - (int32_t) shiftH;
+    if(shiftOut > 32)
+    {
+      shiftOut = 32;
+    }
+    if(shiftOut < -31)
+    {
+      shiftOut = -31;
+    }
+
+    /* The first filtLen - 1 samples of the circular convolution wrap around */
+    for (j = 0u; j < 2u; j++)
+    {
+      pos = outPos + (j * step);
+      if(pos >= outLen)
+      {
+        break;
+      }
+      numOut = ((outLen - pos) < step) ? (outLen - pos) : step;
+      for (i = 0u; i < numOut; i++)
+      {
+        re = pW[(2u * (filtLen - 1u + i)) + j];
+        re = (shiftOut >= 0) ? (re << shiftOut) : (re >> -shiftOut);
+        pDst[(int32_t) (pos + i) * dstInc] = clip_q63_to_q31(re);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Convolution of Q31 sequences, by FFT for long sequences.
+ * @param[in]  *pSrcA points to the first input sequence.
+ * @param[in]  srcALen length of the first input sequence.
+ * @param[in]  *pSrcB points to the second input sequence.
+ * @param[in]  srcBLen length of the second input sequence.
+ * @param[out] *pDst points to the location where the output result is written.  Length srcALen+srcBLen-1.
+ * @param[in]  *pScratch points to a scratch buffer of <code>4 * arm_conv_fft_len_q31(srcALen, srcBLen)</code> samples.
+ * @return none.
+ *
+ * @details
+ * <b>Scaling and Overflow Behavior:</b>
+ *
+ * \par
+ * The result is in 1.31 format and saturates, as with <code>arm_conv_q31()</code>.
+ * The inputs need no scaling in the FFT form: the transforms run in block floating
+ * point, and the precision is that of a 31-bit mantissa less about
+ * <code>log2(fftLen)</code> bits of rounding in the transforms.
+ * Uses <code>arm_conv_q31()</code>, and its scaling requirements, when
+ * <code>arm_conv_fft_len_q31()</code> returns 0; the scratch buffer is then not accessed.
+ */
+
+void arm_conv_fft_q31(
+  q31_t * pSrcA,
+  uint32_t srcALen,
+  q31_t * pSrcB,
+  uint32_t srcBLen,
+  q31_t * pDst,
+  q31_t * pScratch)
+{
+  uint32_t fftLen = arm_conv_fft_len_q31(srcALen, srcBLen);
+
+  if(fftLen == 0u)
+  {
+    arm_conv_q31(pSrcA, srcALen, pSrcB, srcBLen, pDst);
+  }
+  else if(srcALen >= srcBLen)
+  {
+    arm_conv_fft_os_q31(pSrcA, srcALen, pSrcB, srcBLen, 0u, pDst, 1, fftLen, pScratch);
+  }
+  else
+  {
+    arm_conv_fft_os_q31(pSrcB, srcBLen, pSrcA, srcALen, 0u, pDst, 1, fftLen, pScratch);
+  }
+}
+
+/**
+ * @} end of Conv group
+ */
@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_correlate_fft_f32.c
+*
+* Description:  Fast correlation of floating-point sequences by overlap-save
+*               on the real FFT.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+extern void arm_conv_fft_os_f32(
+  float32_t * pSig,
+  uint32_t sigLen,
+  float32_t * pFilt,
+  uint32_t filtLen,
+  uint8_t flipFilt,
+  float32_t * pDst,
+  int32_t dstInc,
+  uint32_t fftLen,
+  float32_t * pScratch);
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup Corr
+ * @{
+ */
+
+/**
+ * @brief Correlation of floating-point sequences, by FFT for long sequences.
+ * @param[in]  *pSrcA points to the first input sequence.
+ * @param[in]  srcALen length of the first input sequence.
+ * @param[in]  *pSrcB points to the second input sequence.
+ * @param[in]  srcBLen length of the second input sequence.
+ * @param[out] *pDst points to the location where the output result is written.  Length 2 * max(srcALen, srcBLen) - 1.
+ * @param[in]  *pScratch points to a scratch buffer of <code>3 * arm_conv_fft_len_f32(srcALen, srcBLen)</code> samples.
+ * @return none.
+ *
+ * \par
+ * The output has the layout of <code>arm_correlate_f32()</code>, including the zero
+ * padding, which this function writes: <code>pDst</code> need not be cleared.
+ * Uses <code>arm_correlate_f32()</code> when <code>arm_conv_fft_len_f32()</code> returns 0.
+ */
+
+void arm_correlate_fft_f32(
+  float32_t * pSrcA,
+  uint32_t srcALen,
+  float32_t * pSrcB,
+  uint32_t srcBLen,
+  float32_t * pDst,
+  float32_t * pScratch)
+{
+  uint32_t fftLen = arm_conv_fft_len_f32(srcALen, srcBLen);
+  uint32_t tot = (srcALen + srcBLen) - 1u;       /* Length of the non-padded output */
+
+  if(fftLen == 0u)
+  {
+    arm_fill_f32(0.0f, pDst, (2u * ((srcALen > srcBLen) ? srcALen : srcBLen)) - 1u);
+    arm_correlate_f32(pSrcA, srcALen, pSrcB, srcBLen, pDst);
+  }
+  else if(srcALen >= srcBLen)
+  {
+    /* c[n] = a[n] * b[-n], after srcALen - srcBLen zeros */
+    arm_fill_f32(0.0f, pDst, srcALen - srcBLen);
+    arm_conv_fft_os_f32(pSrcA, srcALen, pSrcB, srcBLen, 1u, pDst + (srcALen - srcBLen), 1,
+                        fftLen, pScratch);
+  }
+  else
+  {
+    /* CORR(a, b) is the reverse of CORR(b, a), followed by srcBLen - srcALen zeros */
+    arm_conv_fft_os_f32(pSrcB, srcBLen, pSrcA, srcALen, 1u, pDst + (tot - 1u), -1,
+                        fftLen, pScratch);
+    arm_fill_f32(0.0f, pDst + tot, srcBLen - srcALen);
+  }
+}
+
+/**
+ * @} end of Corr group
+ */
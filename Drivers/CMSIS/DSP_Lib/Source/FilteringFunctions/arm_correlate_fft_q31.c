@@ -0,0 +1,85 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_correlate_fft_q31.c
+*
+* Description:  Fast correlation of Q31 sequences by overlap-save on the
+*               complex FFT, with block floating-point scaling.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+extern void arm_conv_fft_os_q31(
+  q31_t * pSig,
+  uint32_t sigLen,
+  q31_t * pFilt,
+  uint32_t filtLen,
+  uint8_t flipFilt,
+  q31_t * pDst,
+  int32_t dstInc,
+  uint32_t fftLen,
+  q31_t * pScratch);
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup Corr
+ * @{
+ */
+
+/**
+ * @brief Correlation of Q31 sequences, by FFT for long sequences.
+ * @param[in]  *pSrcA points to the first input sequence.
+ * @param[in]  srcALen length of the first input sequence.
+ * @param[in]  *pSrcB points to the second input sequence.
+ * @param[in]  srcBLen length of the second input sequence.
+ * @param[out] *pDst points to the location where the output result is written.  Length 2 * max(srcALen, srcBLen) - 1.
+ * @param[in]  *pScratch points to a scratch buffer of <code>4 * arm_conv_fft_len_q31(srcALen, srcBLen)</code> samples.
+ * @return none.
+ *
+ * \par
+ * The output has the layout of <code>arm_correlate_q31()</code>, including the zero
+ * padding, which this function writes: <code>pDst</code> need not be cleared.
+ * The result saturates to 1.31 format, with the precision of <code>arm_conv_fft_q31()</code>.
+ * Uses <code>arm_correlate_q31()</code>, and its scaling requirements, when
+ * <code>arm_conv_fft_len_q31()</code> returns 0.
+ */
+
+void arm_correlate_fft_q31(
+  q31_t * pSrcA,
+  uint32_t srcALen,
+  q31_t * pSrcB,
+  uint32_t srcBLen,
+  q31_t * pDst,
+  q31_t * pScratch)
+{
+  uint32_t fftLen = arm_conv_fft_len_q31(srcALen, srcBLen);
+  uint32_t tot = (srcALen + srcBLen) - 1u;       /* Length of the non-padded output */
+
+  if(fftLen == 0u)
+  {
+    arm_fill_q31(0, pDst, (2u * ((srcALen > srcBLen) ? srcALen : srcBLen)) - 1u);
+    arm_correlate_q31(pSrcA, srcALen, pSrcB, srcBLen, pDst);
+  }
+  else if(srcALen >= srcBLen)
+  {
+    /* c[n] = a[n] * b[-n], after srcALen - srcBLen zeros */
+    arm_fill_q31(0, pDst, srcALen - srcBLen);
+    arm_conv_fft_os_q31(pSrcA, srcALen, pSrcB, srcBLen, 1u, pDst + (srcALen - srcBLen), 1,
+                        fftLen, pScratch);
+  }
+  else
+  {
+    /* CORR(a, b) is the reverse of CORR(b, a), followed by srcBLen - srcALen zeros */
+    arm_conv_fft_os_q31(pSrcB, srcBLen, pSrcA, srcALen, 1u, pDst + (tot - 1u), -1,
+                        fftLen, pScratch);
+    arm_fill_q31(0, pDst + tot, srcBLen - srcALen);
+  }
+}
+
+/**
+ * @} end of Corr group
+ */
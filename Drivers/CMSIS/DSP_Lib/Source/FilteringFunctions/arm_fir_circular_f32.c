@@ -0,0 +1,238 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_fir_circular_f32.c
+*
+* Description:  Floating-point FIR filter on a mirrored circular delay line.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @defgroup FIR_Circular FIR Filters on a Circular Delay Line
+ *
+ * These functions compute the output of <code>arm_fir_f32()</code>, <code>arm_fir_q31()</code>,
+ * <code>arm_fir_q15()</code> and <code>arm_fir_q7()</code> without the copy of
+ * <code>numTaps-1</code> state samples that those functions do at the end of every call.
+ *
+ * \par Algorithm:
+ * The delay line is a circular buffer of <code>D = numTaps+3</code> slots, stored twice in
+ * a row: every input sample is written to its slot <code>i</code> and to its mirror
+ * <code>i+D</code>.  Whatever the position of the newest sample, the last <code>numTaps</code>
+ * samples are then contiguous in the state buffer, and the inner loop reads them, oldest
+ * first, with the time-reversed coefficients of <code>arm_fir_f32()</code>.
+ * <pre>
+ *    {x[n-numTaps+1], ..., x[n-1], x[n]} = pState[i+4 ... i+D]
+ * </pre>
+ * The state advances by one slot per sample, and nothing is moved between calls.
+ * The three extra slots let groups of four outputs share the coefficient loads, as in
+ * <code>arm_fir_f32()</code>: the four new samples are written first, and the slots they
+ * overwrite are outside the window of the oldest output of the group.
+ *
+ * \par
+ * <code>pState</code> points to a state array of size <code>2*(numTaps+3)</code>, which does
+ * not depend on <code>blockSize</code>.  Calls may use any <code>blockSize</code>.
+ * The coefficients are those of the FIR filter of the same data type, and the outputs,
+ * including the scaling and saturation of the fixed-point types, are those of the FIR filter.
+ *
+ * \par Instance Structure
+ * The instance holds <code>numTaps</code>, the slot of the next input sample and the
+ * pointers to the state and coefficient arrays.  The init functions clear the state.
+ */
+
+/**
+ * @addtogroup FIR_Circular
+ * @{
+ */
+
+/**
+ * @param[in,out] *S points to an instance of the floating-point circular FIR structure.
+ * @param[in]     *pSrc points to the block of input data.
+ * @param[out]    *pDst points to the block of output data.
+ * @param[in]     blockSize number of samples to process per call.
+ * @return        none.
+ */
+
+void arm_fir_circular_f32(
+  arm_fir_circular_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pState = S->pState;                 /* State pointer */
+  float32_t *pCoeffs = S->pCoeffs;               /* Coefficient pointer */
+  float32_t *px, *pb;                            /* Temporary pointers for state and coefficient buffers */
+  uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+  uint32_t lenD = numTaps + 3u;                  /* Slots of the circular delay line */
+  uint32_t slot = S->stateIndex;                 /* Slot of the next input sample */
+  uint32_t blkCnt = blockSize, tapCnt;           /* Loop counters */
+  float32_t acc0;                                /* Accumulator */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  float32_t acc1, acc2, acc3;                    /* Accumulators */
+  float32_t x0, x1, x2, x3, c0;                  /* Temporary variables to hold state and coefficient values */
+
+  /* Groups of four outputs, as long as the four slots do not wrap around */
+  while(blkCnt > 0u)
+  {
+    if((blkCnt < 4u) || ((slot + 4u) > lenD))
+    {
+      /* Write the new sample to its slot and to the mirror */
+      pState[slot] = *pSrc;
+      pState[slot + lenD] = *pSrc++;
+
+      px = pState + slot + 4u;
+      pb = pCoeffs;
+      acc0 = 0.0f;
+
+      tapCnt = numTaps;
+      while(tapCnt > 0u)
+      {
+        acc0 += *px++ * *pb++;
+        tapCnt--;
+      }
+
+      *pDst++ = acc0;
+
+      slot = (slot + 1u == lenD) ? 0u : (slot + 1u);
+      blkCnt--;
+      continue;
+    }
+
+    /* Write the four new samples to their slots and to the mirrors */
+    pState[slot] = pState[slot + lenD] = pSrc[0];
+    pState[slot + 1u] = pState[slot + lenD + 1u] = pSrc[1];
+    pState[slot + 2u] = pState[slot + lenD + 2u] = pSrc[2];
+    pState[slot + 3u] = pState[slot + lenD + 3u] = pSrc[3];
+    pSrc += 4u;
+
+    /* The windows of the four outputs start one sample apart */
+    px = pState + slot + 4u;
+    pb = pCoeffs;
+    acc0 = 0.0f;
+    acc1 = 0.0f;
+    acc2 = 0.0f;
+    acc3 = 0.0f;
+
+    x0 = *px++;
+    x1 = *px++;
+    x2 = *px++;
+
+    /* Loop unrolling: four taps per iteration, rotating the samples of the
+     * four windows through x0..x3 */
+    tapCnt = numTaps >> 2u;
+    while(tapCnt > 0u)
+    {
+      /* Read b[numTaps-1] and the newest sample of the fourth window */
+      c0 = pb[0u];
+      x3 = px[0u];
+      acc0 += x0 * c0;
+      acc1 += x1 * c0;
+      acc2 += x2 * c0;
+      acc3 += x3 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[1u];
+      x0 = px[1u];
+      acc0 += x1 * c0;
+      acc1 += x2 * c0;
+      acc2 += x3 * c0;
+      acc3 += x0 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[2u];
+      x1 = px[2u];
+      acc0 += x2 * c0;
+      acc1 += x3 * c0;
+      acc2 += x0 * c0;
+      acc3 += x1 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[3u];
+      x2 = px[3u];
+      acc0 += x3 * c0;
+      acc1 += x0 * c0;
+      acc2 += x1 * c0;
+      acc3 += x2 * c0;
+
+      pb += 4u;
+      px += 4u;
+      tapCnt--;
+    }
+
+    /* If the filter length is not a multiple of 4, compute the remaining filter taps */
+    tapCnt = numTaps & 0x3u;
+    while(tapCnt > 0u)
+    {
+      /* Read the coefficient and the newest sample of the fourth window */
+      c0 = *pb++;
+      x3 = *px++;
+
+      /* Perform the multiply-accumulates */
+      acc0 += x0 * c0;
+      acc1 += x1 * c0;
+      acc2 += x2 * c0;
+      acc3 += x3 * c0;
+
+      /* Reuse the present sample states for next sample */
+      x0 = x1;
+      x1 = x2;
+      x2 = x3;
+
+      tapCnt--;
+    }
+
+    *pDst++ = acc0;
+    *pDst++ = acc1;
+    *pDst++ = acc2;
+    *pDst++ = acc3;
+
+    slot = (slot + 4u == lenD) ? 0u : (slot + 4u);
+    blkCnt -= 4u;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  while(blkCnt > 0u)
+  {
+    /* Write the new sample to its slot and to the mirror */
+    pState[slot] = *pSrc;
+    pState[slot + lenD] = *pSrc++;
+
+    /* The last numTaps samples are contiguous, oldest first */
+    px = pState + slot + 4u;
+    pb = pCoeffs;
+    acc0 = 0.0f;
+
+    tapCnt = numTaps;
+    while(tapCnt > 0u)
+    {
+      acc0 += *px++ * *pb++;
+      tapCnt--;
+    }
+
+    *pDst++ = acc0;
+
+    /* Advance the slot, without moving the state */
+    slot = (slot + 1u == lenD) ? 0u : (slot + 1u);
+    blkCnt--;
+  }
+
+#endif /*   #ifndef ARM_MATH_CM0_FAMILY */
+
+  S->stateIndex = (uint16_t) slot;
+}
+
+/**
+ * @} end of FIR_Circular group
+ */
@@ -0,0 +1,216 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_fir_circular_q15.c
+*
+* Description:  Q15 FIR filter on a mirrored circular delay line.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FIR_Circular
+ * @{
+ */
+
+/**
+ * @details
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * As in <code>arm_fir_q15()</code>: the products accumulate in a 64-bit 34.30 accumulator,
+ * which is truncated to 34.15 format and saturated to 1.15 format.
+ * Unlike <code>arm_fir_q15()</code>, any <code>numTaps</code> is supported.
+ * \par
+ * On Cortex-M3 and Cortex-M4, the taps are processed in pairs with the dual
+ * multiply-accumulate <code>__SMLALD()</code>, as in <code>arm_fir_q15()</code>.
+ *
+ * @param[in,out] *S points to an instance of the Q15 circular FIR structure.
+ * @param[in]     *pSrc points to the block of input data.
+ * @param[out]    *pDst points to the block of output data.
+ * @param[in]     blockSize number of samples to process per call.
+ * @return        none.
+ */
+
+void arm_fir_circular_q15(
+  arm_fir_circular_instance_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize)
+{
+  q15_t *pState = S->pState;                     /* State pointer */
+  q15_t *pCoeffs = S->pCoeffs;                   /* Coefficient pointer */
+  q15_t *px, *pb;                                /* Temporary pointers for state and coefficient buffers */
+  uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+  uint32_t lenD = numTaps + 3u;                  /* Slots of the circular delay line */
+  uint32_t slot = S->stateIndex;                 /* Slot of the next input sample */
+  uint32_t blkCnt = blockSize, tapCnt;           /* Loop counters */
+  q63_t acc0;                                    /* Accumulator */
+
+#if !defined(ARM_MATH_CM0_FAMILY) && !defined(UNALIGNED_SUPPORT_DISABLE)
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  q63_t acc1, acc2, acc3;                        /* Accumulators */
+  q31_t x0, x1, x2, x3, c0;                      /* Pairs of state and coefficient values */
+
+  /* Groups of four outputs, as long as the four slots do not wrap around */
+  while(blkCnt > 0u)
+  {
+    if((blkCnt < 4u) || ((slot + 4u) > lenD))
+    {
+      /* Write the new sample to its slot and to the mirror */
+      pState[slot] = *pSrc;
+      pState[slot + lenD] = *pSrc++;
+
+      px = pState + slot + 4u;
+      pb = pCoeffs;
+      acc0 = 0;
+
+      /* Two taps per dual multiply-accumulate */
+      tapCnt = numTaps >> 1u;
+      while(tapCnt > 0u)
+      {
+        c0 = *__SIMD32(pb)++;
+        x0 = _SIMD32_OFFSET(px);
+        acc0 = __SMLALD(x0, c0, acc0);
+        px += 2u;
+        tapCnt--;
+      }
+
+      if((numTaps & 0x1u) != 0u)
+      {
+        acc0 += (q31_t) *px * *pb;
+      }
+
+      *pDst++ = (q15_t) __SSAT((acc0 >> 15u), 16);
+
+      slot = (slot + 1u == lenD) ? 0u : (slot + 1u);
+      blkCnt--;
+      continue;
+    }
+
+    /* Write the four new samples to their slots and to the mirrors */
+    pState[slot] = pState[slot + lenD] = pSrc[0];
+    pState[slot + 1u] = pState[slot + lenD + 1u] = pSrc[1];
+    pState[slot + 2u] = pState[slot + lenD + 2u] = pSrc[2];
+    pState[slot + 3u] = pState[slot + lenD + 3u] = pSrc[3];
+    pSrc += 4u;
+
+    /* The windows of the four outputs start one sample apart: the pairs
+     * of samples of the first two windows are x0 and x1 */
+    px = pState + slot + 4u;
+    pb = pCoeffs;
+    acc0 = 0;
+    acc1 = 0;
+    acc2 = 0;
+    acc3 = 0;
+
+    x0 = _SIMD32_OFFSET(px);
+    x1 = _SIMD32_OFFSET(px + 1u);
+
+    /* Loop unrolling: four taps per iteration, as two pairs of coefficients
+     * against the pairs of samples of the four windows, as in arm_fir_q15() */
+    tapCnt = numTaps >> 2u;
+    while(tapCnt > 0u)
+    {
+      /* Read b[numTaps-1] and b[numTaps-2] */
+      c0 = *__SIMD32(pb)++;
+      acc0 = __SMLALD(x0, c0, acc0);
+      acc1 = __SMLALD(x1, c0, acc1);
+
+      /* Read the pairs of the third and fourth windows */
+      x2 = _SIMD32_OFFSET(px + 2u);
+      x3 = _SIMD32_OFFSET(px + 3u);
+      acc2 = __SMLALD(x2, c0, acc2);
+      acc3 = __SMLALD(x3, c0, acc3);
+
+      /* Read the next two coefficients */
+      c0 = *__SIMD32(pb)++;
+      acc0 = __SMLALD(x2, c0, acc0);
+      acc1 = __SMLALD(x3, c0, acc1);
+
+      /* Read the next pairs of the third and fourth windows */
+      x0 = _SIMD32_OFFSET(px + 4u);
+      x1 = _SIMD32_OFFSET(px + 5u);
+      acc2 = __SMLALD(x0, c0, acc2);
+      acc3 = __SMLALD(x1, c0, acc3);
+
+      px += 4u;
+      tapCnt--;
+    }
+
+    /* If the filter length is not a multiple of 4, compute the remaining
+     * pair of taps, then the last odd tap */
+    if((numTaps & 0x2u) != 0u)
+    {
+      c0 = *__SIMD32(pb)++;
+      x2 = _SIMD32_OFFSET(px + 2u);
+      x3 = _SIMD32_OFFSET(px + 3u);
+      acc0 = __SMLALD(x0, c0, acc0);
+      acc1 = __SMLALD(x1, c0, acc1);
+      acc2 = __SMLALD(x2, c0, acc2);
+      acc3 = __SMLALD(x3, c0, acc3);
+      px += 2u;
+    }
+
+    if((numTaps & 0x1u) != 0u)
+    {
+      c0 = *pb;
+      acc0 += (q31_t) px[0] * c0;
+      acc1 += (q31_t) px[1] * c0;
+      acc2 += (q31_t) px[2] * c0;
+      acc3 += (q31_t) px[3] * c0;
+    }
+
+    *pDst++ = (q15_t) __SSAT((acc0 >> 15u), 16);
+    *pDst++ = (q15_t) __SSAT((acc1 >> 15u), 16);
+    *pDst++ = (q15_t) __SSAT((acc2 >> 15u), 16);
+    *pDst++ = (q15_t) __SSAT((acc3 >> 15u), 16);
+
+    slot = (slot + 4u == lenD) ? 0u : (slot + 4u);
+    blkCnt -= 4u;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0, and for Cortex-M3 and Cortex-M4
+   * without unaligned accesses */
+
+  while(blkCnt > 0u)
+  {
+    /* Write the new sample to its slot and to the mirror */
+    pState[slot] = *pSrc;
+    pState[slot + lenD] = *pSrc++;
+
+    /* The last numTaps samples are contiguous, oldest first */
+    px = pState + slot + 4u;
+    pb = pCoeffs;
+    acc0 = 0;
+
+    tapCnt = numTaps;
+    while(tapCnt > 0u)
+    {
+      acc0 += (q31_t) *px++ * *pb++;
+      tapCnt--;
+    }
+
+    *pDst++ = (q15_t) __SSAT((acc0 >> 15u), 16);
+
+    /* Advance the slot, without moving the state */
+    slot = (slot + 1u == lenD) ? 0u : (slot + 1u);
+    blkCnt--;
+  }
+
+#endif /* #if !defined(ARM_MATH_CM0_FAMILY) && !defined(UNALIGNED_SUPPORT_DISABLE) */
+
+  S->stateIndex = (uint16_t) slot;
+}
+
+/**
+ * @} end of FIR_Circular group
+ */
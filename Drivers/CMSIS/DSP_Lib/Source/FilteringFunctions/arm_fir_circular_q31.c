@@ -0,0 +1,212 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_fir_circular_q31.c
+*
+* Description:  Q31 FIR filter on a mirrored circular delay line.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FIR_Circular
+ * @{
+ */
+
+/**
+ * @details
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * As in <code>arm_fir_q31()</code>: the 64-bit accumulator has a 2.62 format and a single guard bit,
+ * and it is truncated to 1.31 format.  Scale the input by log2(numTaps) bits to avoid overflows.
+ *
+ * @param[in,out] *S points to an instance of the Q31 circular FIR structure.
+ * @param[in]     *pSrc points to the block of input data.
+ * @param[out]    *pDst points to the block of output data.
+ * @param[in]     blockSize number of samples to process per call.
+ * @return        none.
+ */
+
+void arm_fir_circular_q31(
+  arm_fir_circular_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize)
+{
+  q31_t *pState = S->pState;                     /* State pointer */
+  q31_t *pCoeffs = S->pCoeffs;                   /* Coefficient pointer */
+  q31_t *px, *pb;                                /* Temporary pointers for state and coefficient buffers */
+  uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+  uint32_t lenD = numTaps + 3u;                  /* Slots of the circular delay line */
+  uint32_t slot = S->stateIndex;                 /* Slot of the next input sample */
+  uint32_t blkCnt = blockSize, tapCnt;           /* Loop counters */
+  q63_t acc0;                                    /* Accumulator */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  q63_t acc1, acc2, acc3;                        /* Accumulators */
+  q31_t x0, x1, x2, x3, c0;                      /* Temporary variables to hold state and coefficient values */
+
+  /* Groups of four outputs, as long as the four slots do not wrap around */
+  while(blkCnt > 0u)
+  {
+    if((blkCnt < 4u) || ((slot + 4u) > lenD))
+    {
+      /* Write the new sample to its slot and to the mirror */
+      pState[slot] = *pSrc;
+      pState[slot + lenD] = *pSrc++;
+
+      px = pState + slot + 4u;
+      pb = pCoeffs;
+      acc0 = 0;
+
+      tapCnt = numTaps;
+      while(tapCnt > 0u)
+      {
+        acc0 += (q63_t) *px++ * *pb++;
+        tapCnt--;
+      }
+
+      *pDst++ = (q31_t) (acc0 >> 31u);
+
+      slot = (slot + 1u == lenD) ? 0u : (slot + 1u);
+      blkCnt--;
+      continue;
+    }
+
+    /* Write the four new samples to their slots and to the mirrors */
+    pState[slot] = pState[slot + lenD] = pSrc[0];
+    pState[slot + 1u] = pState[slot + lenD + 1u] = pSrc[1];
+    pState[slot + 2u] = pState[slot + lenD + 2u] = pSrc[2];
+    pState[slot + 3u] = pState[slot + lenD + 3u] = pSrc[3];
+    pSrc += 4u;
+
+    /* The windows of the four outputs start one sample apart */
+    px = pState + slot + 4u;
+    pb = pCoeffs;
+    acc0 = 0;
+    acc1 = 0;
+    acc2 = 0;
+    acc3 = 0;
+
+    x0 = *px++;
+    x1 = *px++;
+    x2 = *px++;
+
+    /* Loop unrolling: four taps per iteration, rotating the samples of the
+     * four windows through x0..x3 */
+    tapCnt = numTaps >> 2u;
+    while(tapCnt > 0u)
+    {
+      /* Read b[numTaps-1] and the newest sample of the fourth window */
+      c0 = pb[0u];
+      x3 = px[0u];
+      acc0 += (q63_t) x0 * c0;
+      acc1 += (q63_t) x1 * c0;
+      acc2 += (q63_t) x2 * c0;
+      acc3 += (q63_t) x3 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[1u];
+      x0 = px[1u];
+      acc0 += (q63_t) x1 * c0;
+      acc1 += (q63_t) x2 * c0;
+      acc2 += (q63_t) x3 * c0;
+      acc3 += (q63_t) x0 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[2u];
+      x1 = px[2u];
+      acc0 += (q63_t) x2 * c0;
+      acc1 += (q63_t) x3 * c0;
+      acc2 += (q63_t) x0 * c0;
+      acc3 += (q63_t) x1 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[3u];
+      x2 = px[3u];
+      acc0 += (q63_t) x3 * c0;
+      acc1 += (q63_t) x0 * c0;
+      acc2 += (q63_t) x1 * c0;
+      acc3 += (q63_t) x2 * c0;
+
+      pb += 4u;
+      px += 4u;
+      tapCnt--;
+    }
+
+    /* If the filter length is not a multiple of 4, compute the remaining filter taps */
+    tapCnt = numTaps & 0x3u;
+    while(tapCnt > 0u)
+    {
+      /* Read the coefficient and the newest sample of the fourth window */
+      c0 = *pb++;
+      x3 = *px++;
+
+      /* Perform the multiply-accumulates */
+      acc0 += (q63_t) x0 * c0;
+      acc1 += (q63_t) x1 * c0;
+      acc2 += (q63_t) x2 * c0;
+      acc3 += (q63_t) x3 * c0;
+
+      /* Reuse the present sample states for next sample */
+      x0 = x1;
+      x1 = x2;
+      x2 = x3;
+
+      tapCnt--;
+    }
+
+    *pDst++ = (q31_t) (acc0 >> 31u);
+    *pDst++ = (q31_t) (acc1 >> 31u);
+    *pDst++ = (q31_t) (acc2 >> 31u);
+    *pDst++ = (q31_t) (acc3 >> 31u);
+
+    slot = (slot + 4u == lenD) ? 0u : (slot + 4u);
+    blkCnt -= 4u;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  while(blkCnt > 0u)
+  {
+    /* Write the new sample to its slot and to the mirror */
+    pState[slot] = *pSrc;
+    pState[slot + lenD] = *pSrc++;
+
+    /* The last numTaps samples are contiguous, oldest first */
+    px = pState + slot + 4u;
+    pb = pCoeffs;
+    acc0 = 0;
+
+    tapCnt = numTaps;
+    while(tapCnt > 0u)
+    {
+      acc0 += (q63_t) *px++ * *pb++;
+      tapCnt--;
+    }
+
+    *pDst++ = (q31_t) (acc0 >> 31u);
+
+    /* Advance the slot, without moving the state */
+    slot = (slot + 1u == lenD) ? 0u : (slot + 1u);
+    blkCnt--;
+  }
+
+#endif /*   #ifndef ARM_MATH_CM0_FAMILY */
+
+  S->stateIndex = (uint16_t) slot;
+}
+
+/**
+ * @} end of FIR_Circular group
+ */
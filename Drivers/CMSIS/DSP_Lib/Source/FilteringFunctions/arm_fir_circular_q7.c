@@ -0,0 +1,212 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_fir_circular_q7.c
+*
+* Description:  Q7 FIR filter on a mirrored circular delay line.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FIR_Circular
+ * @{
+ */
+
+/**
+ * @details
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * As in <code>arm_fir_q7()</code>: the products accumulate in a 32-bit 18.14 accumulator,
+ * which is truncated to 18.7 format and saturated to 1.7 format.
+ *
+ * @param[in,out] *S points to an instance of the Q7 circular FIR structure.
+ * @param[in]     *pSrc points to the block of input data.
+ * @param[out]    *pDst points to the block of output data.
+ * @param[in]     blockSize number of samples to process per call.
+ * @return        none.
+ */
+
+void arm_fir_circular_q7(
+  arm_fir_circular_instance_q7 * S,
+  q7_t * pSrc,
+  q7_t * pDst,
+  uint32_t blockSize)
+{
+  q7_t *pState = S->pState;                      /* State pointer */
+  q7_t *pCoeffs = S->pCoeffs;                    /* Coefficient pointer */
+  q7_t *px, *pb;                                 /* Temporary pointers for state and coefficient buffers */
+  uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+  uint32_t lenD = numTaps + 3u;                  /* Slots of the circular delay line */
+  uint32_t slot = S->stateIndex;                 /* Slot of the next input sample */
+  uint32_t blkCnt = blockSize, tapCnt;           /* Loop counters */
+  q31_t acc0;                                    /* Accumulator */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  q31_t acc1, acc2, acc3;                        /* Accumulators */
+  q7_t x0, x1, x2, x3, c0;                       /* Temporary variables to hold state and coefficient values */
+
+  /* Groups of four outputs, as long as the four slots do not wrap around */
+  while(blkCnt > 0u)
+  {
+    if((blkCnt < 4u) || ((slot + 4u) > lenD))
+    {
+      /* Write the new sample to its slot and to the mirror */
+      pState[slot] = *pSrc;
+      pState[slot + lenD] = *pSrc++;
+
+      px = pState + slot + 4u;
+      pb = pCoeffs;
+      acc0 = 0;
+
+      tapCnt = numTaps;
+      while(tapCnt > 0u)
+      {
+        acc0 += (q15_t) *px++ * *pb++;
+        tapCnt--;
+      }
+
+      *pDst++ = (q7_t) __SSAT((acc0 >> 7u), 8);
+
+      slot = (slot + 1u == lenD) ? 0u : (slot + 1u);
+      blkCnt--;
+      continue;
+    }
+
+    /* Write the four new samples to their slots and to the mirrors */
+    pState[slot] = pState[slot + lenD] = pSrc[0];
+    pState[slot + 1u] = pState[slot + lenD + 1u] = pSrc[1];
+    pState[slot + 2u] = pState[slot + lenD + 2u] = pSrc[2];
+    pState[slot + 3u] = pState[slot + lenD + 3u] = pSrc[3];
+    pSrc += 4u;
+
+    /* The windows of the four outputs start one sample apart */
+    px = pState + slot + 4u;
+    pb = pCoeffs;
+    acc0 = 0;
+    acc1 = 0;
+    acc2 = 0;
+    acc3 = 0;
+
+    x0 = *px++;
+    x1 = *px++;
+    x2 = *px++;
+
+    /* Loop unrolling: four taps per iteration, rotating the samples of the
+     * four windows through x0..x3 */
+    tapCnt = numTaps >> 2u;
+    while(tapCnt > 0u)
+    {
+      /* Read b[numTaps-1] and the newest sample of the fourth window */
+      c0 = pb[0u];
+      x3 = px[0u];
+      acc0 += (q15_t) x0 * c0;
+      acc1 += (q15_t) x1 * c0;
+      acc2 += (q15_t) x2 * c0;
+      acc3 += (q15_t) x3 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[1u];
+      x0 = px[1u];
+      acc0 += (q15_t) x1 * c0;
+      acc1 += (q15_t) x2 * c0;
+      acc2 += (q15_t) x3 * c0;
+      acc3 += (q15_t) x0 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[2u];
+      x1 = px[2u];
+      acc0 += (q15_t) x2 * c0;
+      acc1 += (q15_t) x3 * c0;
+      acc2 += (q15_t) x0 * c0;
+      acc3 += (q15_t) x1 * c0;
+
+      /* Read the next coefficient and sample */
+      c0 = pb[3u];
+      x2 = px[3u];
+      acc0 += (q15_t) x3 * c0;
+      acc1 += (q15_t) x0 * c0;
+      acc2 += (q15_t) x1 * c0;
+      acc3 += (q15_t) x2 * c0;
+
+      pb += 4u;
+      px += 4u;
+      tapCnt--;
+    }
+
+    /* If the filter length is not a multiple of 4, compute the remaining filter taps */
+    tapCnt = numTaps & 0x3u;
+    while(tapCnt > 0u)
+    {
+      /* Read the coefficient and the newest sample of the fourth window */
+      c0 = *pb++;
+      x3 = *px++;
+
+      /* Perform the multiply-accumulates */
+      acc0 += (q15_t) x0 * c0;
+      acc1 += (q15_t) x1 * c0;
+      acc2 += (q15_t) x2 * c0;
+      acc3 += (q15_t) x3 * c0;
+
+      /* Reuse the present sample states for next sample */
+      x0 = x1;
+      x1 = x2;
+      x2 = x3;
+
+      tapCnt--;
+    }
+
+    *pDst++ = (q7_t) __SSAT((acc0 >> 7u), 8);
+    *pDst++ = (q7_t) __SSAT((acc1 >> 7u), 8);
+    *pDst++ = (q7_t) __SSAT((acc2 >> 7u), 8);
+    *pDst++ = (q7_t) __SSAT((acc3 >> 7u), 8);
+
+    slot = (slot + 4u == lenD) ? 0u : (slot + 4u);
+    blkCnt -= 4u;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  while(blkCnt > 0u)
+  {
+    /* Write the new sample to its slot and to the mirror */
+    pState[slot] = *pSrc;
+    pState[slot + lenD] = *pSrc++;
+
+    /* The last numTaps samples are contiguous, oldest first */
+    px = pState + slot + 4u;
+    pb = pCoeffs;
+    acc0 = 0;
+
+    tapCnt = numTaps;
+    while(tapCnt > 0u)
+    {
+      acc0 += (q15_t) *px++ * *pb++;
+      tapCnt--;
+    }
+
+    *pDst++ = (q7_t) __SSAT((acc0 >> 7u), 8);
+
+    /* Advance the slot, without moving the state */
+    slot = (slot + 1u == lenD) ? 0u : (slot + 1u);
+    blkCnt--;
+  }
+
+#endif /*   #ifndef ARM_MATH_CM0_FAMILY */
+
+  S->stateIndex = (uint16_t) slot;
+}
+
+/**
+ * @} end of FIR_Circular group
+ */
@@ -0,0 +1,339 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_fir_design_remez_f32.c
+*
+* Description:  Equiripple linear-phase FIR filter design by the
+*               Parks-McClellan algorithm.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FilterDesign
+ * @{
+ */
+
+#define REMEZ_PI_F64        3.14159265358979323846
+#define REMEZ_GRID_DENSITY  16u
+#define REMEZ_MAX_ITER      40u
+
+/**
+ * @brief  Barycentric weights of a set of interpolation points.
+ * @param[in]  *pXe  points to the interpolation points.
+ * @param[in]  n     number of points.
+ * @param[out] *pAd  points to the weights.
+ * @return none.
+ *
+ * The differences are scaled by 2, the inverse of the capacity of [-1 1], which keeps
+ * the products in range for any number of points.
+ */
+
+static void arm_fir_design_remez_weights(
+  const float64_t * pXe,
+  uint32_t n,
+  float64_t * pAd)
+{
+  float64_t prod;                                /* Product of the differences */
+  uint32_t j, k;                                 /* Loop counters */
+
+  for (j = 0u; j < n; j++)
+  {
+    prod = 1.0;
+    for (k = 0u; k < n; k++)
+    {
+      if(k != j)
+      {
+        prod *= 2.0 * (pXe[j] - pXe[k]);
+      }
+    }
+    pAd[j] = 1.0 / prod;
+  }
+}
+
+/**
+ * @brief  Barycentric Lagrange interpolation of the amplitude response.
+ * @param[in]  x     abscissa, cos(w).
+ * @param[in]  *pXe  points to the interpolation points.
+ * @param[in]  *pAd  points to their weights.
+ * @param[in]  *pY   points to the values at the points.
+ * @param[in]  n     number of points.
+ * @return the interpolated value.
+ */
+
+static float64_t arm_fir_design_remez_eval(
+  float64_t x,
+  const float64_t * pXe,
+  const float64_t * pAd,
+  const float64_t * pY,
+  uint32_t n)
+{
+  float64_t num = 0.0, den = 0.0, c, d;          /* Sums of the barycentric formula */
+  uint32_t j;                                    /* Loop counter */
+
+  for (j = 0u; j < n; j++)
+  {
+    d = x - pXe[j];
+    if(d == 0.0)
+    {
+      return (pY[j]);
+    }
+    c = pAd[j] / d;
+    num += c * pY[j];
+    den += c;
+  }
+
+  return (num / den);
+}
+
+/**
+ * @brief  Designs an equiripple linear-phase FIR filter by the Parks-McClellan algorithm.
+ * @param[in]  numTaps    number of coefficients, odd, 3 to 255.
+ * @param[in]  numBands   number of bands.
+ * @param[in]  *pBands    points to the 2*numBands band edges, as fractions of the sample rate, increasing in [0, 0.5].
+ * @param[in]  *pDesired  points to the numBands desired gains.
+ * @param[in]  *pWeights  points to the numBands error weights, greater than 0.
+ * @param[out] *pCoeffs   points to the numTaps coefficients, in the order of arm_fir_init_f32().
+ * @param[in]  *pScratch  points to a scratch buffer of 42*(numTaps+1) + 11*numBands + 5 values.
+ * @return ARM_MATH_SUCCESS, ARM_MATH_ARGUMENT_ERROR if an argument is out of range, or
+ * ARM_MATH_TEST_FAILURE if the exchange did not converge.
+ *
+ * \par
+ * The filter minimizes the largest weighted error <code>W(f)*(D(f)-H(f))</code> over the
+ * bands, where the desired gain <code>D</code> and the weight <code>W</code> are constant
+ * in each band, and the gaps between the bands are transition bands.  The weighted error
+ * of the result ripples with equal magnitude over all the bands: a weight of 10 on the
+ * stopband gives it a ripple 10 times smaller than the passband's.
+ *
+ * \par
+ * This is the type I case of the algorithm: an odd number of taps and a symmetric
+ * response, which suits low-pass, high-pass, band-pass and band-stop designs.
+ * The Remez exchange runs on a grid of 16 points per extremal frequency, and stops when
+ * the extremal errors agree to 1e-4, or after 40 iterations.  On failure, the coefficients
+ * of the last iteration are written anyway.
+ */
+
+arm_status arm_fir_design_remez_f32(
+  uint16_t numTaps,
+  uint16_t numBands,
+  const float32_t * pBands,
+  const float32_t * pDesired,
+  const float32_t * pWeights,
+  float32_t * pCoeffs,
+  float64_t * pScratch)
+{
+  uint32_t M = ((uint32_t) numTaps - 1u) >> 1u;  /* Index of the center tap */
+  uint32_t r = M + 1u;                           /* Number of cosine terms */
+  uint32_t maxGrid = (REMEZ_GRID_DENSITY * r) + (2u * (uint32_t) numBands);  /* Bound on the grid size */
+  float64_t *pX = pScratch;                      /* Grid abscissas cos(2*pi*f) */
+  float64_t *pD = pX + maxGrid;                  /* Desired gains on the grid */
+  float64_t *pW = pD + maxGrid;                  /* Weights on the grid */
+  float64_t *pE = pW + maxGrid;                  /* Weighted errors on the grid */
+  uint32_t *pCand = (uint32_t *) (pE + maxGrid); /* Candidate extremal indices */
+  uint32_t *pExt = (uint32_t *) (pE + (2u * maxGrid));  /* Extremal indices */
+  float64_t *pXe = pE + (2u * maxGrid) + (r + 1u);      /* Extremal abscissas */
+  float64_t *pAd = pXe + (r + 1u);               /* Barycentric weights */
+  float64_t *pY = pAd + (r + 1u);                /* Amplitude at the extremals */
+  uint32_t *pBandEnd = (uint32_t *) (pY + (r + 1u));    /* First grid index of each band */
+  float64_t delf = 0.5 / (float64_t) (REMEZ_GRID_DENSITY * r);  /* Grid spacing */
+  float64_t fl, fh, num, den, delta, sgn, e, eMax, eMin, w, acc;  /* Intermediate values */
+  uint32_t numGrid, numCand, first, last, count, b, i, j, iter;  /* Counters */
+  arm_status status = ARM_MATH_TEST_FAILURE;     /* Convergence status */
+
+  if(((numTaps & 1u) == 0u) || (numTaps < 3u) || (numTaps > 255u) || (numBands == 0u))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  for (b = 0u; b < (2u * (uint32_t) numBands); b++)
+  {
+    if((pBands[b] < 0.0f) || (pBands[b] > 0.5f) || ((b > 0u) && (pBands[b] <= pBands[b - 1u])))
+    {
+      return (ARM_MATH_ARGUMENT_ERROR);
+    }
+  }
+
+  /* Dense grid: each band gets points about delf apart, with both edges on the grid */
+  numGrid = 0u;
+  for (b = 0u; b < numBands; b++)
+  {
+    if(pWeights[b] <= 0.0f)
+    {
+      return (ARM_MATH_ARGUMENT_ERROR);
+    }
+
+    fl = (float64_t) pBands[2u * b];
+    fh = (float64_t) pBands[(2u * b) + 1u];
+    count = (uint32_t) ((fh - fl) / delf) + 1u;
+    count = (count < 2u) ? 2u : count;
+
+    pBandEnd[b] = numGrid;
+    for (i = 0u; i < count; i++)
+    {
+      pX[numGrid] = cos(2.0 * REMEZ_PI_F64 * (fl + (((fh - fl) * (float64_t) i) / (float64_t) (count - 1u))));
+      pD[numGrid] = (float64_t) pDesired[b];
+      pW[numGrid] = (float64_t) pWeights[b];
+      numGrid++;
+    }
+  }
+  pBandEnd[numBands] = numGrid;
+
+  if(numGrid < (r + 1u))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  /* Initial extremals, evenly spread over the grid */
+  for (j = 0u; j <= r; j++)
+  {
+    pExt[j] = (j * (numGrid - 1u)) / r;
+  }
+
+  for (iter = 0u; iter < REMEZ_MAX_ITER; iter++)
+  {
+    /* Deviation of the alternating interpolation through the r+1 extremals */
+    for (j = 0u; j <= r; j++)
+    {
+      pXe[j] = pX[pExt[j]];
+    }
+    arm_fir_design_remez_weights(pXe, r + 1u, pAd);
+
+    num = 0.0;
+    den = 0.0;
+    sgn = 1.0;
+    for (j = 0u; j <= r; j++)
+    {
+      num += pAd[j] * pD[pExt[j]];
+      den += (sgn * pAd[j]) / pW[pExt[j]];
+      sgn = -sgn;
+    }
+    delta = num / den;
+
+    /* Amplitude at the first r extremals, which define the polynomial of degree M */
+    sgn = 1.0;
+    for (j = 0u; j < r; j++)
+    {
+      pY[j] = pD[pExt[j]] - ((sgn * delta) / pW[pExt[j]]);
+      sgn = -sgn;
+    }
+    arm_fir_design_remez_weights(pXe, r, pAd);
+
+    /* Weighted error on the grid */
+    for (i = 0u; i < numGrid; i++)
+    {
+      pE[i] = pW[i] * (pD[i] - arm_fir_design_remez_eval(pX[i], pXe, pAd, pY, r));
+    }
+
+    /* Local extrema of the error in each band, at least as large as the deviation */
+    numCand = 0u;
+    for (b = 0u; b < numBands; b++)
+    {
+      first = pBandEnd[b];
+      last = pBandEnd[b + 1u] - 1u;
+      for (i = first; i <= last; i++)
+      {
+        e = pE[i];
+        if(fabs(e) < (fabs(delta) * (1.0 - 1e-9)))
+        {
+          continue;
+        }
+
+        if(e > 0.0)
+        {
+          if(((i > first) && (pE[i - 1u] > e)) || ((i < last) && (pE[i + 1u] > e)))
+          {
+            continue;
+          }
+        }
+        else
+        {
+          if(((i > first) && (pE[i - 1u] < e)) || ((i < last) && (pE[i + 1u] < e)))
+          {
+            continue;
+          }
+        }
+
+        /* Of two neighbours of the same sign, keep the larger one */
+        if((numCand > 0u) && ((pE[pCand[numCand - 1u]] > 0.0) == (e > 0.0)))
+        {
+          if(fabs(e) > fabs(pE[pCand[numCand - 1u]]))
+          {
+            pCand[numCand - 1u] = i;
+          }
+        }
+        else
+        {
+          pCand[numCand++] = i;
+        }
+      }
+    }
+
+    if(numCand < (r + 1u))
+    {
+      break;
+    }
+
+    /* Drop the smaller of the two ends until r+1 alternating extremals remain */
+    first = 0u;
+    while((numCand - first) > (r + 1u))
+    {
+      if(fabs(pE[pCand[first]]) < fabs(pE[pCand[numCand - 1u]]))
+      {
+        first++;
+      }
+      else
+      {
+        numCand--;
+      }
+    }
+
+    eMax = 0.0;
+    eMin = fabs(pE[pCand[first]]);
+    for (j = 0u; j <= r; j++)
+    {
+      pExt[j] = pCand[first + j];
+      e = fabs(pE[pExt[j]]);
+      eMax = (e > eMax) ? e : eMax;
+      eMin = (e < eMin) ? e : eMin;
+    }
+
+    /* The new extremals have equal errors: the polynomial is the equiripple one */
+    if((eMax - eMin) <= (1e-4 * eMax))
+    {
+      status = ARM_MATH_SUCCESS;
+      break;
+    }
+  }
+
+  /* Amplitude at the frequencies 2*pi*i/numTaps, i = 0..M */
+  for (i = 0u; i <= M; i++)
+  {
+    pE[i] = arm_fir_design_remez_eval(cos((2.0 * REMEZ_PI_F64 * (float64_t) i) / (float64_t) numTaps), pXe, pAd, pY, r);
+  }
+
+  /* Inverse DFT of the real and even amplitude gives the symmetric taps */
+  for (j = 0u; j <= M; j++)
+  {
+    acc = pE[0];
+    for (i = 1u; i <= M; i++)
+    {
+      w = (2.0 * REMEZ_PI_F64 * (float64_t) ((i * j) % numTaps)) / (float64_t) numTaps;
+      acc += 2.0 * pE[i] * cos(w);
+    }
+    acc /= (float64_t) numTaps;
+
+    pCoeffs[M - j] = (float32_t) acc;
+    pCoeffs[M + j] = (float32_t) acc;
+  }
+
+  return (status);
+}
+
+/**
+ * @} end of FilterDesign group
+ */
@@ -0,0 +1,192 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_fir_design_window_f32.c
+*
+* Description:  Linear-phase FIR filter design by the window method.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FilterDesign
+ * @{
+ */
+
+#define WINDOW_PI_F64 3.14159265358979323846
+
+/**
+ * @brief  Modified Bessel function of the first kind and order 0, by its power series.
+ * @param[in]  x  argument.
+ * @return I0(x).
+ */
+
+static float64_t arm_fir_design_bessel_i0(
+  float64_t x)
+{
+  float64_t sum = 1.0, term = 1.0;               /* Partial sum and current term */
+  float64_t h = 0.25 * x * x;                    /* (x/2)^2 */
+  uint32_t k = 1u;                               /* Term index */
+
+  /* The terms ((x/2)^k / k!)^2 decrease after k = x/2 */
+  do
+  {
+    term *= h / ((float64_t) k * (float64_t) k);
+    sum += term;
+    k++;
+  } while(term > (1e-16 * sum));
+
+  return (sum);
+}
+
+/**
+ * @brief  Designs a linear-phase FIR filter by the window method.
+ * @param[in]  type      ARM_FILTER_LOWPASS, ARM_FILTER_HIGHPASS, ARM_FILTER_BANDPASS or ARM_FILTER_BANDSTOP.
+ * @param[in]  numTaps   number of coefficients.  Odd for the high-pass and band-stop types.
+ * @param[in]  freq1     cutoff frequency, or lower band edge, as a fraction of the sample rate.
+ * @param[in]  freq2     upper band edge of the band-pass and band-stop types, ignored by the others.
+ * @param[in]  window    window type.
+ * @param[in]  beta      parameter of the Kaiser window, ignored by the others.
+ * @param[out] *pCoeffs  points to the numTaps coefficients, in the order of arm_fir_init_f32().
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if an argument is out of range.
+ *
+ * \par
+ * The ideal response, a difference of sinc functions centered on <code>(numTaps-1)/2</code>,
+ * is multiplied by the window, and the result is normalized to a gain of 1 at DC for the
+ * low-pass and band-stop types, at the Nyquist frequency for the high-pass type, and at the
+ * center of the band for the band-pass type.  The edges are at the -6 dB points.
+ *
+ * \par
+ * The window sets the transition width and the stopband attenuation: about 21 dB for the
+ * rectangular window, 44 dB for Hann, 53 dB for Hamming and 74 dB for Blackman.
+ * The Kaiser window trades both through <code>beta</code>: an attenuation of
+ * <code>A</code> dB above 50 takes <code>beta = 0.1102*(A-8.7)</code> and about
+ * <code>(A-8)/(14.36*df)</code> taps for a transition width <code>df</code>.
+ */
+
+arm_status arm_fir_design_window_f32(
+  arm_filter_type type,
+  uint16_t numTaps,
+  float32_t freq1,
+  float32_t freq2,
+  arm_window_type window,
+  float32_t beta,
+  float32_t * pCoeffs)
+{
+  float64_t f1 = (float64_t) freq1;              /* Band edges */
+  float64_t f2 = (float64_t) freq2;
+  float64_t mid = 0.5 * (float64_t) (numTaps - 1u);  /* Center of symmetry */
+  float64_t m, x, h, w, i0Beta, gain, f0;        /* Intermediate values */
+  uint32_t n;                                    /* Loop counter */
+
+  if((numTaps == 0u) || (f1 <= 0.0) || (f1 >= 0.5))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  if(((type == ARM_FILTER_BANDPASS) || (type == ARM_FILTER_BANDSTOP)) &&
+     ((f2 <= f1) || (f2 >= 0.5)))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  /* A response that does not vanish at the Nyquist frequency needs a tap at the center */
+  if(((type == ARM_FILTER_HIGHPASS) || (type == ARM_FILTER_BANDSTOP)) && ((numTaps & 1u) == 0u))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  if((type != ARM_FILTER_LOWPASS) && (type != ARM_FILTER_HIGHPASS) &&
+     (type != ARM_FILTER_BANDPASS) && (type != ARM_FILTER_BANDSTOP))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  if((window > ARM_WINDOW_KAISER) || ((window == ARM_WINDOW_KAISER) && (beta < 0.0f)))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  i0Beta = arm_fir_design_bessel_i0((float64_t) beta);
+
+  /* Frequency of unit gain */
+  f0 = (type == ARM_FILTER_HIGHPASS) ? 0.5 : ((type == ARM_FILTER_BANDPASS) ? (0.5 * (f1 + f2)) : 0.0);
+  gain = 0.0;
+
+  for (n = 0u; n < numTaps; n++)
+  {
+    m = (float64_t) n - mid;
+
+    /* Ideal response: a low-pass of edge f is sin(2*pi*f*m) / (pi*m), and 2*f at m = 0 */
+    switch (type)
+    {
+    case ARM_FILTER_LOWPASS:
+      h = (m == 0.0) ? (2.0 * f1) : (sin(2.0 * WINDOW_PI_F64 * f1 * m) / (WINDOW_PI_F64 * m));
+      break;
+
+    case ARM_FILTER_HIGHPASS:
+      h = (m == 0.0) ? (1.0 - (2.0 * f1)) : (-sin(2.0 * WINDOW_PI_F64 * f1 * m) / (WINDOW_PI_F64 * m));
+      break;
+
+    case ARM_FILTER_BANDPASS:
+      h = (m == 0.0) ? (2.0 * (f2 - f1)) :
+        ((sin(2.0 * WINDOW_PI_F64 * f2 * m) - sin(2.0 * WINDOW_PI_F64 * f1 * m)) / (WINDOW_PI_F64 * m));
+      break;
+
+    default:
+      h = (m == 0.0) ? (1.0 - (2.0 * (f2 - f1))) :
+        ((sin(2.0 * WINDOW_PI_F64 * f1 * m) - sin(2.0 * WINDOW_PI_F64 * f2 * m)) / (WINDOW_PI_F64 * m));
+      break;
+    }
+
+    /* Window, with x = 2*pi*n/(numTaps-1) */
+    x = (numTaps > 1u) ? ((2.0 * WINDOW_PI_F64 * (float64_t) n) / (float64_t) (numTaps - 1u)) : WINDOW_PI_F64;
+
+    switch (window)
+    {
+    case ARM_WINDOW_HANN:
+      w = 0.5 - (0.5 * cos(x));
+      break;
+
+    case ARM_WINDOW_HAMMING:
+      w = 0.54 - (0.46 * cos(x));
+      break;
+
+    case ARM_WINDOW_BLACKMAN:
+      w = (0.42 - (0.5 * cos(x))) + (0.08 * cos(2.0 * x));
+      break;
+
+    case ARM_WINDOW_KAISER:
+      x = (mid > 0.0) ? (m / mid) : 0.0;
+      w = arm_fir_design_bessel_i0((float64_t) beta * sqrt(1.0 - (x * x))) / i0Beta;
+      break;
+
+    default:
+      w = 1.0;
+      break;
+    }
+
+    h *= w;
+    pCoeffs[n] = (float32_t) h;
+
+    /* Gain at f0 of the symmetric response */
+    gain += h * cos(2.0 * WINDOW_PI_F64 * f0 * m);
+  }
+
+  /* Normalize to unit gain at f0 */
+  for (n = 0u; n < numTaps; n++)
+  {
+    pCoeffs[n] = (float32_t) ((float64_t) pCoeffs[n] / gain);
+  }
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of FilterDesign group
+ */
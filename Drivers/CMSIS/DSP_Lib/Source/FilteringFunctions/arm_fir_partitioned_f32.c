@@ -0,0 +1,151 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_fir_partitioned_f32.c
+*
+* Description:  Floating-point FIR filter by uniformly partitioned
+*               convolution in the frequency domain.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @defgroup FIR_Partitioned Partitioned FIR Filter
+ *
+ * This function implements the FIR filter of <code>arm_fir_f32()</code> for long
+ * impulse responses, by uniformly partitioned convolution in the frequency domain.
+ *
+ * \par Algorithm
+ * The coefficients are cut in <code>numParts</code> partitions of <code>partLen</code>
+ * taps, and the spectrum of each partition, zero-padded to <code>2*partLen</code>, is
+ * computed once by <code>arm_fir_partitioned_init_f32()</code>.
+ * The input is processed in blocks of <code>partLen</code> samples.  For each block,
+ * the last <code>2*partLen</code> input samples are transformed by the real FFT and the
+ * spectrum enters a frequency-domain delay line of <code>numParts</code> slots.
+ * The spectrum of the output is the sum over the partitions of the spectrum of the
+ * partition times the input spectrum as old as the partition is deep in the filter:
+ * <pre>
+ *    Y = X[n] * H[0] + X[n-1] * H[1] + ... + X[n-numParts+1] * H[numParts-1]
+ * </pre>
+ * and the second half of its inverse transform is the output block (overlap-save).
+ *
+ * \par
+ * Each block costs two transforms of <code>2*partLen</code> points and
+ * <code>numParts</code> spectral multiply-accumulates, instead of
+ * <code>partLen*numTaps</code> multiply-accumulates for the direct form.
+ * The output is the exact FIR output of each block, without added delay: the latency
+ * is that of block processing, bounded by <code>partLen</code>.
+ * A shorter partition lowers the latency and a longer one the cost per sample.
+ *
+ * \par
+ * <code>blockSize</code> must be a multiple of <code>partLen</code>.
+ * The coefficients take the order and the meaning of <code>arm_fir_f32()</code>,
+ * and the output matches it to floating-point rounding.
+ *
+ * \par Instance Structure
+ * The instance holds the partition spectra, the frequency-domain delay line with the
+ * input history and work buffers, and the real FFT instance.  The spectra replace the
+ * coefficients: <code>pCoeffs</code> is only read by the init function.
+ */
+
+/**
+ * @addtogroup FIR_Partitioned
+ * @{
+ */
+
+/**
+ * @brief Processing function for the floating-point partitioned FIR filter.
+ * @param[in]  *S points to an instance of the floating-point partitioned FIR structure.
+ * @param[in]  *pSrc points to the block of input data.
+ * @param[out] *pDst points to the block of output data.
+ * @param[in]  blockSize number of samples to process, a multiple of <code>partLen</code>.
+ * @return none.
+ */
+
+void arm_fir_partitioned_f32(
+  arm_fir_partitioned_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t partLen = S->partLen;                 /* Partition length */
+  uint32_t fftLen = 2u * partLen;                /* Transform length */
+  uint32_t numParts = S->numParts;               /* Number of partitions */
+  float32_t *pFdl = S->pState;                   /* Frequency-domain delay line */
+  float32_t *pHist = pFdl + (fftLen * numParts); /* Last 2*partLen input samples */
+  float32_t *pWork = pHist + fftLen;             /* Transform input and output */
+  float32_t *pAcc = pWork + fftLen;              /* Spectrum of the output */
+  float32_t *pX, *pH;                            /* Spectra of the input and the partition */
+  float32_t xr, xi, hr, hi;                      /* Spectrum values */
+  uint32_t blkCnt, p, slot, i;                   /* Loop counters */
+
+  for (blkCnt = blockSize / partLen; blkCnt > 0u; blkCnt--)
+  {
+    /* Append the new block to the input history, and transform the history
+     * into the newest slot of the delay line */
+    memcpy(pHist + partLen, pSrc, partLen * sizeof(float32_t));
+    memcpy(pWork, pHist, fftLen * sizeof(float32_t));
+    arm_rfft_fast_f32(&S->rfft, pWork, pFdl + (fftLen * S->partIndex), 0u);
+
+    /* Sum of the products of the spectra.  The first partition initializes the
+     * accumulator, and the input spectra get older as the partitions go deeper */
+    slot = S->partIndex;
+    for (p = 0u; p < numParts; p++)
+    {
+      pX = pFdl + (fftLen * slot);
+      pH = S->pSpectra + (fftLen * p);
+
+      /* Packed spectra: DC and Nyquist are real and share the first pair */
+      if(p == 0u)
+      {
+        pAcc[0] = pX[0] * pH[0];
+        pAcc[1] = pX[1] * pH[1];
+        for (i = 2u; i < fftLen; i += 2u)
+        {
+          xr = pX[i];
+          xi = pX[i + 1u];
+          hr = pH[i];
+          hi = pH[i + 1u];
+          pAcc[i] = (xr * hr) - (xi * hi);
+          pAcc[i + 1u] = (xr * hi) + (xi * hr);
+        }
+      }
+      else
+      {
+        pAcc[0] += pX[0] * pH[0];
+        pAcc[1] += pX[1] * pH[1];
+        for (i = 2u; i < fftLen; i += 2u)
+        {
+          xr = pX[i];
+          xi = pX[i + 1u];
+          hr = pH[i];
+          hi = pH[i + 1u];
+          pAcc[i] += (xr * hr) - (xi * hi);
+          pAcc[i + 1u] += (xr * hi) + (xi * hr);
+        }
+      }
+
+      slot = (slot == 0u) ? (numParts - 1u) : (slot - 1u);
+    }
+
+    /* The first half of the circular convolution wraps around */
+    arm_rfft_fast_f32(&S->rfft, pAcc, pWork, 1u);
+    memcpy(pDst, pWork + partLen, partLen * sizeof(float32_t));
+
+    /* The new block becomes the older half of the history */
+    memcpy(pHist, pHist + partLen, partLen * sizeof(float32_t));
+    S->partIndex = (uint16_t) ((S->partIndex + 1u == numParts) ? 0u : (S->partIndex + 1u));
+
+    pSrc += partLen;
+    pDst += partLen;
+  }
+}
+
+/**
+ * @} end of FIR_Partitioned group
+ */
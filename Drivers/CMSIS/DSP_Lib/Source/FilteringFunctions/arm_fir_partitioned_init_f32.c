@@ -0,0 +1,100 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_fir_partitioned_init_f32.c
+*
+* Description:  Floating-point partitioned FIR filter initialization function.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup FIR_Partitioned
+ * @{
+ */
+
+/**
+ * @details
+ *
+ * @param[in,out] *S points to an instance of the floating-point partitioned FIR filter structure.
+ * @param[in]     numTaps  Number of filter coefficients in the filter.
+ * @param[in]     *pCoeffs points to the filter coefficients buffer.
+ * @param[out]    *pSpectra points to the buffer of the partition spectra.
+ * @param[in]     *pState points to the state buffer.
+ * @param[in]     partLen partition length.
+ * @return        The function returns ARM_MATH_SUCCESS if initialization is successful or ARM_MATH_ARGUMENT_ERROR if
+ * <code>partLen</code> is not a supported value.
+ *
+ * <b>Description:</b>
+ * \par
+ * <code>pCoeffs</code> points to the array of filter coefficients stored in time reversed order,
+ * as for <code>arm_fir_init_f32()</code>:
+ * <pre>
+ *    {b[numTaps-1], b[numTaps-2], b[N-2], ..., b[1], b[0]}
+ * </pre>
+ * The coefficients are only read here: once the spectra are computed, the array may be reused.
+ * \par
+ * <code>partLen</code> is the length of a partition of the coefficients, and the number of
+ * samples of each transform block: 16, 32, 64, 128, 256, 512, 1024 or 2048.
+ * With <code>numParts = ceil(numTaps / partLen)</code>,
+ * <code>pSpectra</code> is of length <code>2*partLen*numParts</code> samples and
+ * <code>pState</code> of length <code>2*partLen*(numParts+3)</code> samples.
+ */
+
+arm_status arm_fir_partitioned_init_f32(
+  arm_fir_partitioned_instance_f32 * S,
+  uint16_t numTaps,
+  float32_t * pCoeffs,
+  float32_t * pSpectra,
+  float32_t * pState,
+  uint16_t partLen)
+{
+  float32_t *pWork;                              /* Time-domain partition */
+  uint32_t fftLen = 2u * (uint32_t) partLen;     /* Transform length */
+  uint32_t p, k, tap;                            /* Loop counters */
+
+  /* The real FFT of twice the partition length checks partLen */
+  if((partLen < 16u) || (arm_rfft_fast_init_f32(&S->rfft, (uint16_t) fftLen) != ARM_MATH_SUCCESS))
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  S->numTaps = numTaps;
+  S->partLen = partLen;
+  S->numParts = (uint16_t) ((numTaps + partLen - 1u) / partLen);
+  S->partIndex = 0u;
+  S->pSpectra = pSpectra;
+  S->pState = pState;
+
+  /* Clear the frequency-domain delay line, the input history and the work
+   * buffers: the size of the state buffer is 2*partLen*(numParts+3) */
+  memset(pState, 0, (fftLen * (S->numParts + 3u)) * sizeof(float32_t));
+
+  /* Spectrum of each partition of the time-ordered coefficients, zero-padded
+   * to the transform length */
+  pWork = pState + (fftLen * (S->numParts + 1u));
+  for (p = 0u; p < S->numParts; p++)
+  {
+    for (k = 0u; k < partLen; k++)
+    {
+      tap = (p * partLen) + k;
+      pWork[k] = (tap < numTaps) ? pCoeffs[numTaps - 1u - tap] : 0.0f;
+    }
+    memset(pWork + partLen, 0, partLen * sizeof(float32_t));
+
+    arm_rfft_fast_f32(&S->rfft, pWork, pSpectra + (p * fftLen), 0u);
+  }
+
+  memset(pWork, 0, fftLen * sizeof(float32_t));
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of FIR_Partitioned group
+ */
@@ -0,0 +1,222 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_mat_cholesky_f32.c
+*
+* Description:  Floating-point Cholesky factorization of a symmetric
+*               positive definite matrix, and solution of linear systems
+*               from the factor.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupMatrix
+ */
+
+/**
+ * @addtogroup MatrixFactor
+ * @{
+ */
+
+/**
+ * @brief  Dot product of two strided vectors.
+ * @param[in]  *pA       points to the first vector.
+ * @param[in]  strideA   distance between the elements of the first vector.
+ * @param[in]  *pB       points to the second vector.
+ * @param[in]  strideB   distance between the elements of the second vector.
+ * @param[in]  blockSize number of elements of the vectors.
+ * @return the dot product.
+ */
+
+static float32_t arm_mat_cholesky_dot(
+  const float32_t * pA,
+  uint32_t strideA,
+  const float32_t * pB,
+  uint32_t strideB,
+  uint32_t blockSize)
+{
+  float32_t sum = 0.0f;                          /* Accumulator */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    sum += pA[0] * pB[0];
+    sum += pA[strideA] * pB[strideB];
+    sum += pA[2u * strideA] * pB[2u * strideB];
+    sum += pA[3u * strideA] * pB[3u * strideB];
+    pA += 4u * strideA;
+    pB += 4u * strideB;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    sum += *pA * *pB;
+    pA += strideA;
+    pB += strideB;
+
+    blkCnt--;
+  }
+
+  return (sum);
+}
+
+/**
+ * @brief  Initialization function for the floating-point Cholesky factorization.
+ * @param[in,out] *S       points to an instance of the floating-point Cholesky structure.
+ * @param[in]     numRows  order of the matrix.
+ * @param[in]     *pData   points to the buffer of the factor, numRows*numRows values.
+ * @return none.
+ */
+
+void arm_mat_cholesky_init_f32(
+  arm_mat_cholesky_instance_f32 * S,
+  uint16_t numRows,
+  float32_t * pData)
+{
+  S->numRows = numRows;
+  S->pData = pData;
+}
+
+/**
+ * @brief  Floating-point Cholesky factorization.
+ * @param[in,out] *S     points to an instance of the floating-point Cholesky structure.
+ * @param[in]     *pSrc  points to the symmetric positive definite matrix to factor, which may share the buffer of the factor.
+ * @return ARM_MATH_SUCCESS, ARM_MATH_SIZE_MISMATCH if the matrix is not square or not of the order
+ * of the instance, or ARM_MATH_SINGULAR if the matrix is not positive definite.
+ *
+ * \par
+ * The lower triangular factor <code>L</code> of <code>A = L * L^T</code> overwrites the buffer of
+ * the instance, with zeros above the diagonal.  Only the lower triangle of the source is read.
+ */
+
+arm_status arm_mat_cholesky_f32(
+  arm_mat_cholesky_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc)
+{
+  float32_t *pL = S->pData;                      /* Factor */
+  const float32_t *pA = pSrc->pData;             /* Source */
+  uint32_t n = S->numRows;                       /* Order of the matrix */
+  float32_t sum, dot;                            /* Entry of the factor */
+  uint32_t i, j;                                 /* Loop counters */
+
+#ifdef ARM_MATH_MATRIX_CHECK
+
+  /* Check for matrix mismatch condition */
+  if((pSrc->numRows != pSrc->numCols) || (pSrc->numRows != n))
+  {
+    return (ARM_MATH_SIZE_MISMATCH);
+  }
+
+#endif /* #ifdef ARM_MATH_MATRIX_CHECK */
+
+  /* Row by row: L(i,j) only needs the rows i and j of L up to column j, already computed,
+   * so that the source can be the factor */
+  for (i = 0u; i < n; i++)
+  {
+    for (j = 0u; j <= i; j++)
+    {
+      arm_dot_prod_f32(pL + (i * n), pL + (j * n), j, &dot);
+      sum = pA[(i * n) + j] - dot;
+
+      if(j < i)
+      {
+        pL[(i * n) + j] = sum / pL[(j * n) + j];
+      }
+      else
+      {
+        if(!(sum > 0.0f))
+        {
+          return (ARM_MATH_SINGULAR);
+        }
+        arm_sqrt_f32(sum, pL + (i * n) + i);
+      }
+    }
+
+    for (j = i + 1u; j < n; j++)
+    {
+      pL[(i * n) + j] = 0.0f;
+    }
+  }
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @brief  Solves <code>A * X = B</code> from the Cholesky factor of <code>A</code>.
+ * @param[in]  *S     points to an instance of the floating-point Cholesky structure, factored by arm_mat_cholesky_f32().
+ * @param[in]  *pSrc  points to the right-hand sides <code>B</code>, numRows rows and one column per system.
+ * @param[out] *pDst  points to the solutions <code>X</code>, of the size of <code>B</code>; may be <code>B</code>.
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_SIZE_MISMATCH if the sizes do not match.
+ */
+
+arm_status arm_mat_cholesky_solve_f32(
+  const arm_mat_cholesky_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc,
+  arm_matrix_instance_f32 * pDst)
+{
+  const float32_t *pL = S->pData;                /* Factor */
+  float32_t *pX = pDst->pData;                   /* Solutions */
+  uint32_t n = S->numRows;                       /* Order of the matrix */
+  uint32_t m = pSrc->numCols;                    /* Number of right-hand sides */
+  float32_t *pElem;                              /* Element of the solutions */
+  uint32_t i, j;                                 /* Loop counters */
+
+#ifdef ARM_MATH_MATRIX_CHECK
+
+  /* Check for matrix mismatch condition */
+  if((pSrc->numRows != n) || (pDst->numRows != n) || (pDst->numCols != m))
+  {
+    return (ARM_MATH_SIZE_MISMATCH);
+  }
+
+#endif /* #ifdef ARM_MATH_MATRIX_CHECK */
+
+  if(pSrc->pData != pX)
+  {
+    memcpy(pX, pSrc->pData, n * m * sizeof(float32_t));
+  }
+
+  /* L * Y = B, then L^T * X = Y, one column at a time */
+  for (j = 0u; j < m; j++)
+  {
+    for (i = 0u; i < n; i++)
+    {
+      pElem = pX + (i * m) + j;
+      *pElem = (*pElem - arm_mat_cholesky_dot(pL + (i * n), 1u, pX + j, m, i)) / pL[(i * n) + i];
+    }
+
+    for (i = n; i > 0u; i--)
+    {
+      pElem = pX + ((i - 1u) * m) + j;
+      *pElem = (*pElem - arm_mat_cholesky_dot(pL + (i * n) + (i - 1u), n, pElem + m, m, n - i)) /
+               pL[((i - 1u) * n) + (i - 1u)];
+    }
+  }
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of MatrixFactor group
+ */
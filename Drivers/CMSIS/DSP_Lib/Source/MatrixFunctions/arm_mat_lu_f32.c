@@ -0,0 +1,354 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_mat_lu_f32.c
+*
+* Description:  Floating-point LU factorization with partial pivoting,
+*               and solution of linear systems from the factors.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupMatrix
+ */
+
+/**
+ * @defgroup MatrixFactor Matrix Factorizations
+ *
+ * Factor a matrix once, then solve any number of linear systems with it.
+ *
+ * Solving <code>A * X = B</code> with <code>arm_mat_inverse_f32()</code> costs about
+ * <code>2*n^3</code> operations for the inverse and <code>2*n^2</code> per right-hand side
+ * for the product, every time <code>A</code> changes.  A factorization costs
+ * <code>2/3*n^3</code> (LU), <code>1/3*n^3</code> (Cholesky) or <code>4/3*n^3</code> (QR), and
+ * each right-hand side then takes <code>2*n^2</code>: the solve step reuses the factors in the
+ * instance.  The triangular solves are also more accurate than a product with an inverse.
+ *
+ * \par LU
+ * <code>arm_mat_lu_f32()</code> computes <code>P * A = L * U</code> for a square matrix, with the
+ * partial pivoting of the largest element of each column.  It suits any non-singular matrix.
+ *
+ * \par Cholesky
+ * <code>arm_mat_cholesky_f32()</code> computes <code>A = L * L^T</code> for a symmetric positive
+ * definite matrix, such as a covariance matrix of a Kalman filter or the normal equations of a
+ * least-squares fit.  It needs no pivoting, and half the operations of LU.
+ *
+ * \par QR
+ * <code>arm_mat_qr_f32()</code> computes <code>A = Q * R</code> by Householder reflections, for a
+ * matrix of <code>m >= n</code> rows.  <code>arm_mat_qr_solve_f32()</code> gives the least-squares
+ * solution of an overdetermined system, without forming the normal equations and squaring the
+ * condition number.
+ *
+ * \par Instances
+ * Each instance points to a buffer for the factors, which the factorization fills; the
+ * source matrix may be that buffer, and is then factored in place.  The solve functions
+ * take <code>B</code> with one column per right-hand side, and write <code>X</code> with as many
+ * columns; <code>X</code> may be <code>B</code>.
+ *
+ * \par
+ * A factorization returns <code>ARM_MATH_SINGULAR</code> when a pivot is zero, when the matrix is
+ * not positive definite (Cholesky), or when the columns are linearly dependent (QR).  The
+ * factors are then incomplete, and must not be used to solve.
+ */
+
+/**
+ * @addtogroup MatrixFactor
+ * @{
+ */
+
+/**
+ * @brief  Row operation <code>pDst -= a * pSrc</code>.
+ * @param[in]      a        scale of the source row.
+ * @param[in]      *pSrc    points to the source row.
+ * @param[in,out]  *pDst    points to the destination row.
+ * @param[in]      numCols  number of elements of the rows.
+ * @return none.
+ */
+
+static void arm_mat_lu_row_sub(
+  float32_t a,
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t numCols)
+{
+  uint32_t blkCnt;                               /* Loop counter */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = numCols >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    pDst[0] -= a * pSrc[0];
+    pDst[1] -= a * pSrc[1];
+    pDst[2] -= a * pSrc[2];
+    pDst[3] -= a * pSrc[3];
+    pDst += 4u;
+    pSrc += 4u;
+
+    blkCnt--;
+  }
+
+  blkCnt = numCols % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = numCols;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    *pDst++ -= a * *pSrc++;
+
+    blkCnt--;
+  }
+}
+
+/**
+ * @brief  Dot product of two strided vectors.
+ * @param[in]  *pA       points to the first vector.
+ * @param[in]  strideA   distance between the elements of the first vector.
+ * @param[in]  *pB       points to the second vector.
+ * @param[in]  strideB   distance between the elements of the second vector.
+ * @param[in]  blockSize number of elements of the vectors.
+ * @return the dot product.
+ */
+
+static float32_t arm_mat_lu_dot(
+  const float32_t * pA,
+  uint32_t strideA,
+  const float32_t * pB,
+  uint32_t strideB,
+  uint32_t blockSize)
+{
+  float32_t sum = 0.0f;                          /* Accumulator */
+  uint32_t blkCnt;                               /* Loop counter */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    sum += pA[0] * pB[0];
+    sum += pA[strideA] * pB[strideB];
+    sum += pA[2u * strideA] * pB[2u * strideB];
+    sum += pA[3u * strideA] * pB[3u * strideB];
+    pA += 4u * strideA;
+    pB += 4u * strideB;
+
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    sum += *pA * *pB;
+    pA += strideA;
+    pB += strideB;
+
+    blkCnt--;
+  }
+
+  return (sum);
+}
+
+/**
+ * @brief  Initialization function for the floating-point LU factorization.
+ * @param[in,out] *S        points to an instance of the floating-point LU structure.
+ * @param[in]     numRows   order of the matrix.
+ * @param[in]     *pData    points to the buffer of the factors, numRows*numRows values.
+ * @param[in]     *pPivots  points to the buffer of the row interchanges, numRows values.
+ * @return none.
+ */
+
+void arm_mat_lu_init_f32(
+  arm_mat_lu_instance_f32 * S,
+  uint16_t numRows,
+  float32_t * pData,
+  uint16_t * pPivots)
+{
+  S->numRows = numRows;
+  S->pData = pData;
+  S->pPivots = pPivots;
+}
+
+/**
+ * @brief  Floating-point LU factorization with partial pivoting.
+ * @param[in,out] *S     points to an instance of the floating-point LU structure.
+ * @param[in]     *pSrc  points to the square matrix to factor, which may share the buffer of the factors.
+ * @return ARM_MATH_SUCCESS, ARM_MATH_SIZE_MISMATCH if the matrix is not square or not of the order
+ * of the instance, or ARM_MATH_SINGULAR if the matrix is singular.
+ *
+ * \par
+ * The factors overwrite the buffer of the instance: <code>L</code> below the diagonal, without
+ * its unit diagonal, and <code>U</code> on and above it.  Row <code>k</code> was interchanged
+ * with row <code>pPivots[k]</code> at step <code>k</code>.
+ */
+
+arm_status arm_mat_lu_f32(
+  arm_mat_lu_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc)
+{
+  float32_t *pLU = S->pData;                     /* Factors */
+  uint32_t n = S->numRows;                       /* Order of the matrix */
+  float32_t *pRowK, *pRowI;                      /* Pivot row and updated row */
+  float32_t maxC, in, inv;                       /* Pivot search and scaling */
+  uint32_t i, j, k, p;                           /* Loop counters and pivot row */
+
+#ifdef ARM_MATH_MATRIX_CHECK
+
+  /* Check for matrix mismatch condition */
+  if((pSrc->numRows != pSrc->numCols) || (pSrc->numRows != n))
+  {
+    return (ARM_MATH_SIZE_MISMATCH);
+  }
+
+#endif /* #ifdef ARM_MATH_MATRIX_CHECK */
+
+  if(pSrc->pData != pLU)
+  {
+    memcpy(pLU, pSrc->pData, n * n * sizeof(float32_t));
+  }
+
+  for (k = 0u; k < n; k++)
+  {
+    /* The largest element of the column is the pivot */
+    p = k;
+    maxC = fabsf(pLU[(k * n) + k]);
+    for (i = k + 1u; i < n; i++)
+    {
+      in = fabsf(pLU[(i * n) + k]);
+      if(in > maxC)
+      {
+        maxC = in;
+        p = i;
+      }
+    }
+
+    S->pPivots[k] = (uint16_t) p;
+    if(maxC == 0.0f)
+    {
+      return (ARM_MATH_SINGULAR);
+    }
+
+    pRowK = pLU + (k * n);
+    if(p != k)
+    {
+      pRowI = pLU + (p * n);
+      for (j = 0u; j < n; j++)
+      {
+        in = pRowK[j];
+        pRowK[j] = pRowI[j];
+        pRowI[j] = in;
+      }
+    }
+
+    /* Eliminate the column below the pivot, and keep the multipliers there */
+    inv = 1.0f / pRowK[k];
+    for (i = k + 1u; i < n; i++)
+    {
+      pRowI = pLU + (i * n);
+      pRowI[k] *= inv;
+      arm_mat_lu_row_sub(pRowI[k], pRowK + k + 1u, pRowI + k + 1u, n - k - 1u);
+    }
+  }
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @brief  Solves <code>A * X = B</code> from the LU factors of <code>A</code>.
+ * @param[in]  *S     points to an instance of the floating-point LU structure, factored by arm_mat_lu_f32().
+ * @param[in]  *pSrc  points to the right-hand sides <code>B</code>, numRows rows and one column per system.
+ * @param[out] *pDst  points to the solutions <code>X</code>, of the size of <code>B</code>; may be <code>B</code>.
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_SIZE_MISMATCH if the sizes do not match.
+ */
+
+arm_status arm_mat_lu_solve_f32(
+  const arm_mat_lu_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc,
+  arm_matrix_instance_f32 * pDst)
+{
+  const float32_t *pLU = S->pData;               /* Factors */
+  float32_t *pX = pDst->pData;                   /* Solutions */
+  uint32_t n = S->numRows;                       /* Order of the matrix */
+  uint32_t m = pSrc->numCols;                    /* Number of right-hand sides */
+  float32_t *pRowK, *pRowI;                      /* Rows and elements of the solutions */
+  float32_t in;                                  /* Interchange */
+  uint32_t i, j, k, p;                           /* Loop counters and pivot row */
+
+#ifdef ARM_MATH_MATRIX_CHECK
+
+  /* Check for matrix mismatch condition */
+  if((pSrc->numRows != n) || (pDst->numRows != n) || (pDst->numCols != m))
+  {
+    return (ARM_MATH_SIZE_MISMATCH);
+  }
+
+#endif /* #ifdef ARM_MATH_MATRIX_CHECK */
+
+  if(pSrc->pData != pX)
+  {
+    memcpy(pX, pSrc->pData, n * m * sizeof(float32_t));
+  }
+
+  /* P * B, by the interchanges of the factorization */
+  for (k = 0u; k < n; k++)
+  {
+    p = S->pPivots[k];
+    if(p != k)
+    {
+      pRowK = pX + (k * m);
+      pRowI = pX + (p * m);
+      for (j = 0u; j < m; j++)
+      {
+        in = pRowK[j];
+        pRowK[j] = pRowI[j];
+        pRowI[j] = in;
+      }
+    }
+  }
+
+  /* L * Y = P * B, L with a unit diagonal, then U * X = Y, one column at a time */
+  for (j = 0u; j < m; j++)
+  {
+    for (i = 1u; i < n; i++)
+    {
+      pX[(i * m) + j] -= arm_mat_lu_dot(pLU + (i * n), 1u, pX + j, m, i);
+    }
+
+    for (i = n; i > 0u; i--)
+    {
+      pRowI = pX + ((i - 1u) * m) + j;
+      *pRowI = (*pRowI - arm_mat_lu_dot(pLU + ((i - 1u) * n) + i, 1u, pRowI + m, m, n - i)) /
+               pLU[((i - 1u) * n) + (i - 1u)];
+    }
+  }
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of MatrixFactor group
+ */
@@ -0,0 +1,222 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_mat_qr_f32.c
+*
+* Description:  Floating-point QR factorization by Householder
+*               reflections, and least-squares solution of linear systems
+*               from the factors.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupMatrix
+ */
+
+/**
+ * @addtogroup MatrixFactor
+ * @{
+ */
+
+/**
+ * @brief  Initialization function for the floating-point QR factorization.
+ * @param[in,out] *S       points to an instance of the floating-point QR structure.
+ * @param[in]     numRows  number of rows of the matrix.
+ * @param[in]     numCols  number of columns of the matrix, at most numRows.
+ * @param[in]     *pData   points to the buffer of the factors, numRows*numCols values.
+ * @param[in]     *pTau    points to the buffer of the scales of the reflections, numCols values.
+ * @return none.
+ */
+
+void arm_mat_qr_init_f32(
+  arm_mat_qr_instance_f32 * S,
+  uint16_t numRows,
+  uint16_t numCols,
+  float32_t * pData,
+  float32_t * pTau)
+{
+  S->numRows = numRows;
+  S->numCols = numCols;
+  S->pData = pData;
+  S->pTau = pTau;
+}
+
+/**
+ * @brief  Floating-point QR factorization by Householder reflections.
+ * @param[in,out] *S     points to an instance of the floating-point QR structure.
+ * @param[in]     *pSrc  points to the matrix to factor, which may share the buffer of the factors.
+ * @return ARM_MATH_SUCCESS, ARM_MATH_SIZE_MISMATCH if the matrix has more columns than rows or is
+ * not of the size of the instance, or ARM_MATH_SINGULAR if its columns are linearly dependent.
+ *
+ * \par
+ * Reflection <code>k</code> is <code>H(k) = I - tau(k) * v * v^T</code>, with <code>v(k) = 1</code>
+ * and zeros above, and <code>Q = H(0) * H(1) * ... * H(n-1)</code>.  The factors overwrite the
+ * buffer of the instance: <code>R</code> on and above the diagonal, and the vectors <code>v</code>
+ * below it, without their unit element.
+ */
+
+arm_status arm_mat_qr_f32(
+  arm_mat_qr_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc)
+{
+  float32_t *pQR = S->pData;                     /* Factors */
+  uint32_t numRows = S->numRows;                 /* Number of rows */
+  uint32_t numCols = S->numCols;                 /* Number of columns */
+  float32_t norm, alpha, diag, scale, tau, sum;  /* Reflection */
+  uint32_t i, j, k;                              /* Loop counters */
+
+  /* A reflection per column needs at least as many rows */
+  if(numCols > numRows)
+  {
+    return (ARM_MATH_SIZE_MISMATCH);
+  }
+
+#ifdef ARM_MATH_MATRIX_CHECK
+
+  /* Check for matrix mismatch condition */
+  if((pSrc->numRows != numRows) || (pSrc->numCols != numCols))
+  {
+    return (ARM_MATH_SIZE_MISMATCH);
+  }
+
+#endif /* #ifdef ARM_MATH_MATRIX_CHECK */
+
+  if(pSrc->pData != pQR)
+  {
+    memcpy(pQR, pSrc->pData, numRows * numCols * sizeof(float32_t));
+  }
+
+  for (k = 0u; k < numCols; k++)
+  {
+    /* Norm of the column from the diagonal down */
+    sum = 0.0f;
+    for (i = k; i < numRows; i++)
+    {
+      sum += pQR[(i * numCols) + k] * pQR[(i * numCols) + k];
+    }
+    if(sum == 0.0f)
+    {
+      return (ARM_MATH_SINGULAR);
+    }
+    arm_sqrt_f32(sum, &norm);
+
+    /* The reflection maps the column to alpha * e(k), alpha of the opposite sign of the
+     * diagonal so that v(k) = diag - alpha does not cancel */
+    diag = pQR[(k * numCols) + k];
+    alpha = (diag > 0.0f) ? -norm : norm;
+    tau = (alpha - diag) / alpha;
+    scale = 1.0f / (diag - alpha);
+
+    pQR[(k * numCols) + k] = alpha;
+    for (i = k + 1u; i < numRows; i++)
+    {
+      pQR[(i * numCols) + k] *= scale;
+    }
+    S->pTau[k] = tau;
+
+    /* Apply the reflection to the columns on the right */
+    for (j = k + 1u; j < numCols; j++)
+    {
+      sum = pQR[(k * numCols) + j];
+      for (i = k + 1u; i < numRows; i++)
+      {
+        sum += pQR[(i * numCols) + k] * pQR[(i * numCols) + j];
+      }
+      sum *= tau;
+
+      pQR[(k * numCols) + j] -= sum;
+      for (i = k + 1u; i < numRows; i++)
+      {
+        pQR[(i * numCols) + j] -= sum * pQR[(i * numCols) + k];
+      }
+    }
+  }
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @brief  Least-squares solution of <code>A * X = B</code> from the QR factors of <code>A</code>.
+ * @param[in]  *S         points to an instance of the floating-point QR structure, factored by arm_mat_qr_f32().
+ * @param[in]  *pSrc      points to the right-hand sides <code>B</code>, numRows rows and one column per system.
+ * @param[out] *pDst      points to the solutions <code>X</code>, numCols rows and the columns of <code>B</code>;
+ *                        may be <code>B</code>, whose first numCols rows it then overwrites.
+ * @param[in]  *pScratch  points to a scratch buffer of numRows values.
+ * @return ARM_MATH_SUCCESS, or ARM_MATH_SIZE_MISMATCH if the sizes do not match.
+ *
+ * \par
+ * <code>X</code> minimizes the norm of <code>A * X - B</code>, column by column: it is the
+ * solution of <code>R * X = Q^T * B</code>, and the exact solution of a square system.
+ */
+
+arm_status arm_mat_qr_solve_f32(
+  const arm_mat_qr_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc,
+  arm_matrix_instance_f32 * pDst,
+  float32_t * pScratch)
+{
+  const float32_t *pQR = S->pData;               /* Factors */
+  const float32_t *pB = pSrc->pData;             /* Right-hand sides */
+  float32_t *pX = pDst->pData;                   /* Solutions */
+  uint32_t numRows = S->numRows;                 /* Number of rows */
+  uint32_t numCols = S->numCols;                 /* Number of columns */
+  uint32_t m = pSrc->numCols;                    /* Number of right-hand sides */
+  float32_t sum, dot;                            /* Reflection and substitution */
+  uint32_t c, i, k;                              /* Loop counters */
+
+#ifdef ARM_MATH_MATRIX_CHECK
+
+  /* Check for matrix mismatch condition */
+  if((pSrc->numRows != numRows) || (pDst->numRows != numCols) || (pDst->numCols != m))
+  {
+    return (ARM_MATH_SIZE_MISMATCH);
+  }
+
+#endif /* #ifdef ARM_MATH_MATRIX_CHECK */
+
+  /* B and X have the same number of columns: column c of X replaces column c of B */
+  for (c = 0u; c < m; c++)
+  {
+    for (i = 0u; i < numRows; i++)
+    {
+      pScratch[i] = pB[(i * m) + c];
+    }
+
+    /* Q^T * b = H(n-1) * ... * H(0) * b */
+    for (k = 0u; k < numCols; k++)
+    {
+      sum = pScratch[k];
+      for (i = k + 1u; i < numRows; i++)
+      {
+        sum += pQR[(i * numCols) + k] * pScratch[i];
+      }
+      sum *= S->pTau[k];
+
+      pScratch[k] -= sum;
+      for (i = k + 1u; i < numRows; i++)
+      {
+        pScratch[i] -= sum * pQR[(i * numCols) + k];
+      }
+    }
+
+    /* R * x = (Q^T * b)(0..numCols-1) */
+    for (i = numCols; i > 0u; i--)
+    {
+      arm_dot_prod_f32((float32_t *) pQR + ((i - 1u) * numCols) + i, pScratch + i, numCols - i, &dot);
+      pScratch[i - 1u] = (pScratch[i - 1u] - dot) / pQR[((i - 1u) * numCols) + (i - 1u)];
+    }
+
+    for (i = 0u; i < numCols; i++)
+    {
+      pX[(i * m) + c] = pScratch[i];
+    }
+  }
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+ * @} end of MatrixFactor group
+ */
@@ -0,0 +1,89 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_histogram_f32.c
+*
+* Description:  Histogram of a floating-point vector over bins of equal
+*               width.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @defgroup Histogram Histogram
+ *
+ * Counts the samples in <code>numBins</code> bins of equal width between
+ * <code>minVal</code> and <code>maxVal</code>.
+ *
+ * \par
+ * The counts are added to <code>pHist</code>, which the caller clears first: the histogram
+ * of a signal can then be accumulated block by block.  The samples below
+ * <code>minVal</code> are counted in the first bin, and the samples above the range in the
+ * last one, so that the counts always add up to the number of samples.
+ *
+ * \par
+ * The floating-point bin <code>b</code> holds the samples of
+ * <code>[minVal + b*w, minVal + (b+1)*w)</code>, with <code>w = (maxVal - minVal) / numBins</code>.
+ * The fixed-point range includes <code>maxVal</code>: it spans <code>maxVal - minVal + 1</code>
+ * values, at least <code>numBins</code>, and the bin of each value is computed exactly with a
+ * multiplication by a reciprocal, without a division per sample.
+ */
+
+/**
+ * @addtogroup Histogram
+ * @{
+ */
+
+/**
+ * @brief  Histogram of a floating-point vector.
+ * @param[in]     *pSrc      points to the input vector.
+ * @param[in]     blockSize  length of the input vector.
+ * @param[in]     minVal     lower edge of the first bin.
+ * @param[in]     maxVal     upper edge of the last bin, above minVal.
+ * @param[in]     numBins    number of bins, at least 1.
+ * @param[in,out] *pHist     points to the counts of the bins, incremented.
+ * @return none.
+ */
+
+void arm_histogram_f32(
+  const float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t minVal,
+  float32_t maxVal,
+  uint32_t numBins,
+  uint32_t * pHist)
+{
+  float32_t scale = (float32_t) numBins / (maxVal - minVal);  /* Bins per unit */
+  float32_t last = (float32_t) (numBins - 1u);   /* Position of the last bin */
+  float32_t in;                                  /* Position of the sample */
+
+  while(blockSize > 0u)
+  {
+    in = (*pSrc++ - minVal) * scale;
+
+    /* Below the range, including NaN, in the first bin, and above it in the last one */
+    if(!(in > 0.0f))
+    {
+      pHist[0]++;
+    }
+    else if(in < last)
+    {
+      pHist[(uint32_t) in]++;
+    }
+    else
+    {
+      pHist[numBins - 1u]++;
+    }
+
+    blockSize--;
+  }
+}
+
+/**
+ * @} end of Histogram group
+ */
@@ -0,0 +1,76 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_histogram_q15.c
+*
+* Description:  Histogram of a Q15 vector over bins of equal width.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup Histogram
+ * @{
+ */
+
+/**
+ * @brief  Histogram of a Q15 vector.
+ * @param[in]     *pSrc      points to the input vector.
+ * @param[in]     blockSize  length of the input vector.
+ * @param[in]     minVal     lowest value of the first bin.
+ * @param[in]     maxVal     highest value of the last bin, not below minVal.
+ * @param[in]     numBins    number of bins, from 1 to maxVal - minVal + 1.
+ * @param[in,out] *pHist     points to the counts of the bins, incremented.
+ * @return none.
+ *
+ * \par
+ * The bin of the value <code>x</code> is <code>floor((x - minVal) * numBins / range)</code>,
+ * with <code>range = maxVal - minVal + 1</code>.  It is computed as
+ * <code>((x - minVal) * m) >> 32</code>, with <code>m</code> the reciprocal
+ * <code>numBins * 2^32 / range</code> rounded up: the rounding adds less than
+ * <code>2^-16</code> to a quotient whose fraction is at most <code>1 - 2^-16</code>,
+ * so that it never changes the bin.
+ */
+
+void arm_histogram_q15(
+  const q15_t * pSrc,
+  uint32_t blockSize,
+  q15_t minVal,
+  q15_t maxVal,
+  uint32_t numBins,
+  uint32_t * pHist)
+{
+  uint32_t range = (uint32_t) ((int32_t) maxVal - minVal) + 1u;  /* Values of the range */
+  uint64_t m = ((((uint64_t) numBins) << 32) + range - 1u) / range;  /* Reciprocal of the bin width */
+  q15_t in;                                      /* Sample */
+
+  while(blockSize > 0u)
+  {
+    in = *pSrc++;
+
+    /* Below the range in the first bin, and above it in the last one */
+    if(in < minVal)
+    {
+      pHist[0]++;
+    }
+    else if(in > maxVal)
+    {
+      pHist[numBins - 1u]++;
+    }
+    else
+    {
+      pHist[(uint32_t) (((uint64_t) ((int32_t) in - minVal) * m) >> 32)]++;
+    }
+
+    blockSize--;
+  }
+}
+
+/**
+ * @} end of Histogram group
+ */
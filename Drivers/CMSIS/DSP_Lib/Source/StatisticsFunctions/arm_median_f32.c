@@ -0,0 +1,182 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_median_f32.c
+*
+* Description:  Median and percentile of a floating-point vector by
+*               quickselect.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @defgroup Median Median and Percentile
+ *
+ * Computes the median, or any percentile, of the samples without sorting them.
+ *
+ * \par
+ * The functions find the element of rank <code>k</code> by quickselect: a partition about a
+ * median-of-three pivot, then the same on the side that holds rank <code>k</code> only.
+ * This takes <code>O(blockSize)</code> operations on average, against
+ * <code>O(blockSize*log(blockSize))</code> for a sort.  The input is reordered in place,
+ * and must be copied first if it is still needed.
+ *
+ * \par
+ * The percentile <code>p</code> of <code>N</code> samples interpolates linearly between the
+ * samples of ranks <code>floor(p*(N-1))</code> and the next one: <code>p = 0</code> gives the
+ * minimum, <code>p = 0.5</code> the median, and <code>p = 1</code> the maximum.  The median of
+ * an even number of samples is the mean of the two middle ones.
+ *
+ * \par
+ * The fixed-point functions take <code>p</code> in the format of the data, in
+ * <code>[0, 1)</code>.  The floating-point input must not contain NaN.
+ */
+
+/**
+ * @addtogroup Median
+ * @{
+ */
+
+/**
+ * @brief  Element of rank k, by quickselect.
+ * @param[in,out] *pData     points to the vector, reordered so that the elements below k are not
+ *                           greater than the element at k, and those above are not smaller.
+ * @param[in]     blockSize  length of the vector.
+ * @param[in]     k          rank of the element, below blockSize.
+ * @return the element of rank k.
+ */
+
+static float32_t arm_median_select_f32(
+  float32_t * pData,
+  uint32_t blockSize,
+  uint32_t k)
+{
+  float32_t a, b, c, pivot, in;                  /* Pivot selection and exchange */
+  int32_t lo = 0, hi = (int32_t) blockSize - 1;  /* Partition holding rank k */
+  int32_t i, j;                                  /* Partition indices */
+
+  while(hi > lo)
+  {
+    a = pData[lo];
+    b = pData[(lo + hi) >> 1];
+    c = pData[hi];
+    if(a < b)
+    {
+      pivot = (b < c) ? b : ((a < c) ? c : a);
+    }
+    else
+    {
+      pivot = (a < c) ? a : ((b < c) ? c : b);
+    }
+
+    /* Hoare partition: [lo, j] <= pivot <= [i, hi], and [j + 1, i - 1] == pivot */
+    i = lo;
+    j = hi;
+    while(i <= j)
+    {
+      while(pData[i] < pivot)
+      {
+        i++;
+      }
+      while(pivot < pData[j])
+      {
+        j--;
+      }
+      if(i <= j)
+      {
+        in = pData[i];
+        pData[i] = pData[j];
+        pData[j] = in;
+        i++;
+        j--;
+      }
+    }
+
+    if(j < (int32_t) k)
+    {
+      lo = i;
+    }
+    if((int32_t) k < i)
+    {
+      hi = j;
+    }
+  }
+
+  return (pData[k]);
+}
+
+/**
+ * @brief  Median of a floating-point vector.
+ * @param[in,out] *pSrc      points to the input vector, reordered in place.
+ * @param[in]     blockSize  length of the input vector, at least 1.
+ * @param[out]    *pResult   median value returned here.
+ * @return none.
+ */
+
+void arm_median_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t * pResult)
+{
+  float32_t hiVal, loVal;                        /* Middle elements */
+  uint32_t k = blockSize >> 1u;                  /* Rank of the upper middle element */
+  uint32_t index;                                /* Index of the lower middle element */
+
+  hiVal = arm_median_select_f32(pSrc, blockSize, k);
+
+  if((blockSize & 1u) == 0u)
+  {
+    /* The lower middle element is the largest one below rank k */
+    arm_max_f32(pSrc, k, &loVal, &index);
+    hiVal = 0.5f * (loVal + hiVal);
+  }
+
+  *pResult = hiVal;
+}
+
+/**
+ * @brief  Percentile of a floating-point vector.
+ * @param[in,out] *pSrc      points to the input vector, reordered in place.
+ * @param[in]     blockSize  length of the input vector, at least 1.
+ * @param[in]     p          fraction of the samples below the result, in [0, 1].
+ * @param[out]    *pResult   percentile returned here.
+ * @return none.
+ */
+
+void arm_percentile_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t p,
+  float32_t * pResult)
+{
+  float32_t pos, frac, loVal, hiVal;             /* Rank and interpolation */
+  uint32_t k, index;                             /* Rank of the lower element */
+
+  pos = ((p > 0.0f) ? ((p < 1.0f) ? p : 1.0f) : 0.0f) * (float32_t) (blockSize - 1u);
+  k = (uint32_t) pos;
+  if(k > (blockSize - 1u))
+  {
+    k = blockSize - 1u;
+  }
+  frac = pos - (float32_t) k;
+
+  loVal = arm_median_select_f32(pSrc, blockSize, k);
+
+  if((frac > 0.0f) && ((k + 1u) < blockSize))
+  {
+    /* The next element is the smallest one above rank k */
+    arm_min_f32(pSrc + k + 1u, blockSize - k - 1u, &hiVal, &index);
+    loVal += frac * (hiVal - loVal);
+  }
+
+  *pResult = loVal;
+}
+
+/**
+ * @} end of Median group
+ */
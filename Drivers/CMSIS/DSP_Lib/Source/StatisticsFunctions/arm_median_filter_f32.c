@@ -0,0 +1,138 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_median_filter_f32.c
+*
+* Description:  Running median of a floating-point signal over a sliding
+*               window.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @defgroup MedianFilter Running Median Filter
+ *
+ * Each output sample is the median of the last <code>windowSize</code> input samples,
+ * which removes impulsive noise without the smearing of a moving average.
+ *
+ * \par
+ * The state keeps the window twice: in arrival order, as a circular buffer, and sorted.
+ * Each new sample replaces the oldest one in the sorted copy: a binary search finds the oldest
+ * sample, which then moves to the rank of the new one, by shifting only the samples in between.
+ * The cost per sample is <code>O(log(windowSize))</code> compares plus the distance between the
+ * two ranks, which is small for a slowly varying signal, instead of a sort of the window.
+ *
+ * \par
+ * The state buffer holds <code>2*windowSize</code> values, and starts as a window of zeros.
+ * The median of an even window is the mean of the two middle samples.  The output buffer may
+ * be the input buffer.  The floating-point input must not contain NaN.
+ */
+
+/**
+ * @addtogroup MedianFilter
+ * @{
+ */
+
+/**
+ * @brief  Initialization function for the floating-point running median filter.
+ * @param[in,out] *S           points to an instance of the floating-point running median structure.
+ * @param[in]     windowSize   number of samples of the window, at least 1.
+ * @param[in]     *pState      points to the state buffer, 2*windowSize values.
+ * @return none.
+ */
+
+void arm_median_filter_init_f32(
+  arm_median_filter_instance_f32 * S,
+  uint16_t windowSize,
+  float32_t * pState)
+{
+  S->windowSize = windowSize;
+  S->pos = 0u;
+  S->pState = pState;
+
+  /* The window starts with zeros, in both orders */
+  memset(pState, 0, 2u * windowSize * sizeof(float32_t));
+}
+
+/**
+ * @brief  Running median of a floating-point signal.
+ * @param[in,out] *S          points to an instance of the floating-point running median structure.
+ * @param[in]     *pSrc       points to the block of input samples.
+ * @param[out]    *pDst       points to the block of output samples; may be pSrc.
+ * @param[in]     blockSize   number of samples to process.
+ * @return none.
+ */
+
+void arm_median_filter_f32(
+  arm_median_filter_instance_f32 * S,
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t *pWindow = S->pState;                /* Window in arrival order */
+  float32_t *pSorted = S->pState + S->windowSize;  /* Window in ascending order */
+  uint32_t windowSize = S->windowSize;           /* Window length */
+  uint32_t mid = windowSize >> 1u;               /* Rank of the upper median */
+  uint32_t pos = S->pos;                         /* Oldest sample of the window */
+  float32_t in, old;                             /* New and oldest samples */
+  uint32_t lo, hi, idx;                          /* Binary search */
+
+  while(blockSize > 0u)
+  {
+    in = *pSrc++;
+    old = pWindow[pos];
+    pWindow[pos] = in;
+    pos = ((pos + 1u) < windowSize) ? (pos + 1u) : 0u;
+
+    /* First rank of the oldest sample */
+    lo = 0u;
+    hi = windowSize - 1u;
+    while(lo < hi)
+    {
+      idx = (lo + hi) >> 1u;
+      if(pSorted[idx] < old)
+      {
+        lo = idx + 1u;
+      }
+      else
+      {
+        hi = idx;
+      }
+    }
+
+    /* Move it to the rank of the new sample */
+    idx = lo;
+    if(old < in)
+    {
+      while(((idx + 1u) < windowSize) && (pSorted[idx + 1u] < in))
+      {
+        pSorted[idx] = pSorted[idx + 1u];
+        idx++;
+      }
+    }
+    else
+    {
+      while((idx > 0u) && (in < pSorted[idx - 1u]))
+      {
+        pSorted[idx] = pSorted[idx - 1u];
+        idx--;
+      }
+    }
+    pSorted[idx] = in;
+
+    *pDst++ = ((windowSize & 1u) != 0u) ? pSorted[mid] : (0.5f * (pSorted[mid - 1u] + pSorted[mid]));
+
+    blockSize--;
+  }
+
+  S->pos = (uint16_t) pos;
+}
+
+/**
+ * @} end of MedianFilter group
+ */
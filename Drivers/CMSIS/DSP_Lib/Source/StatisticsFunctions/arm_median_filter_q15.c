@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_median_filter_q15.c
+*
+* Description:  Running median of a Q15 signal over a sliding
+*               window.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup MedianFilter
+ * @{
+ */
+
+/**
+ * @brief  Initialization function for the Q15 running median filter.
+ * @param[in,out] *S           points to an instance of the Q15 running median structure.
+ * @param[in]     windowSize   number of samples of the window, at least 1.
+ * @param[in]     *pState      points to the state buffer, 2*windowSize values.
+ * @return none.
+ */
+
+void arm_median_filter_init_q15(
+  arm_median_filter_instance_q15 * S,
+  uint16_t windowSize,
+  q15_t * pState)
+{
+  S->windowSize = windowSize;
+  S->pos = 0u;
+  S->pState = pState;
+
+  /* The window starts with zeros, in both orders */
+  memset(pState, 0, 2u * windowSize * sizeof(q15_t));
+}
+
+/**
+ * @brief  Running median of a Q15 signal.
+ * @param[in,out] *S          points to an instance of the Q15 running median structure.
+ * @param[in]     *pSrc       points to the block of input samples.
+ * @param[out]    *pDst       points to the block of output samples; may be pSrc.
+ * @param[in]     blockSize   number of samples to process.
+ * @return none.
+ */
+
+void arm_median_filter_q15(
+  arm_median_filter_instance_q15 * S,
+  const q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize)
+{
+  q15_t *pWindow = S->pState;                    /* Window in arrival order */
+  q15_t *pSorted = S->pState + S->windowSize;    /* Window in ascending order */
+  uint32_t windowSize = S->windowSize;           /* Window length */
+  uint32_t mid = windowSize >> 1u;               /* Rank of the upper median */
+  uint32_t pos = S->pos;                         /* Oldest sample of the window */
+  q15_t in, old;                                 /* New and oldest samples */
+  uint32_t lo, hi, idx;                          /* Binary search */
+
+  while(blockSize > 0u)
+  {
+    in = *pSrc++;
+    old = pWindow[pos];
+    pWindow[pos] = in;
+    pos = ((pos + 1u) < windowSize) ? (pos + 1u) : 0u;
+
+    /* First rank of the oldest sample */
+    lo = 0u;
+    hi = windowSize - 1u;
+    while(lo < hi)
+    {
+      idx = (lo + hi) >> 1u;
+      if(pSorted[idx] < old)
+      {
+        lo = idx + 1u;
+      }
+      else
+      {
+        hi = idx;
+      }
+    }
+
+    /* Move it to the rank of the new sample */
+    idx = lo;
+    if(old < in)
+    {
+      while(((idx + 1u) < windowSize) && (pSorted[idx + 1u] < in))
+      {
+        pSorted[idx] = pSorted[idx + 1u];
+        idx++;
+      }
+    }
+    else
+    {
+      while((idx > 0u) && (in < pSorted[idx - 1u]))
+      {
+        pSorted[idx] = pSorted[idx - 1u];
+        idx--;
+      }
+    }
+    pSorted[idx] = in;
+
+    *pDst++ = ((windowSize & 1u) != 0u) ? pSorted[mid] : (q15_t) (((q31_t) pSorted[mid - 1u] + pSorted[mid]) >> 1);
+
+    blockSize--;
+  }
+
+  S->pos = (uint16_t) pos;
+}
+
+/**
+ * @} end of MedianFilter group
+ */
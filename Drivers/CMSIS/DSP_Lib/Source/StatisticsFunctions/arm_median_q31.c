@@ -0,0 +1,155 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_median_q31.c
+*
+* Description:  Median and percentile of a Q31 vector by
+*               quickselect.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup Median
+ * @{
+ */
+
+/**
+ * @brief  Element of rank k, by quickselect.
+ * @param[in,out] *pData     points to the vector, reordered so that the elements below k are not
+ *                           greater than the element at k, and those above are not smaller.
+ * @param[in]     blockSize  length of the vector.
+ * @param[in]     k          rank of the element, below blockSize.
+ * @return the element of rank k.
+ */
+
+static q31_t arm_median_select_q31(
+  q31_t * pData,
+  uint32_t blockSize,
+  uint32_t k)
+{
+  q31_t a, b, c, pivot, in;                      /* Pivot selection and exchange */
+  int32_t lo = 0, hi = (int32_t) blockSize - 1;  /* Partition holding rank k */
+  int32_t i, j;                                  /* Partition indices */
+
+  while(hi > lo)
+  {
+    a = pData[lo];
+    b = pData[(lo + hi) >> 1];
+    c = pData[hi];
+    if(a < b)
+    {
+      pivot = (b < c) ? b : ((a < c) ? c : a);
+    }
+    else
+    {
+      pivot = (a < c) ? a : ((b < c) ? c : b);
+    }
+
+    /* Hoare partition: [lo, j] <= pivot <= [i, hi], and [j + 1, i - 1] == pivot */
+    i = lo;
+    j = hi;
+    while(i <= j)
+    {
+      while(pData[i] < pivot)
+      {
+        i++;
+      }
+      while(pivot < pData[j])
+      {
+        j--;
+      }
+      if(i <= j)
+      {
+        in = pData[i];
+        pData[i] = pData[j];
+        pData[j] = in;
+        i++;
+        j--;
+      }
+    }
+
+    if(j < (int32_t) k)
+    {
+      lo = i;
+    }
+    if((int32_t) k < i)
+    {
+      hi = j;
+    }
+  }
+
+  return (pData[k]);
+}
+
+/**
+ * @brief  Median of a Q31 vector.
+ * @param[in,out] *pSrc      points to the input vector, reordered in place.
+ * @param[in]     blockSize  length of the input vector, at least 1.
+ * @param[out]    *pResult   median value returned here.
+ * @return none.
+ */
+
+void arm_median_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  q31_t * pResult)
+{
+  q31_t hiVal, loVal;                            /* Middle elements */
+  uint32_t k = blockSize >> 1u;                  /* Rank of the upper middle element */
+  uint32_t index;                                /* Index of the lower middle element */
+
+  hiVal = arm_median_select_q31(pSrc, blockSize, k);
+
+  if((blockSize & 1u) == 0u)
+  {
+    /* The lower middle element is the largest one below rank k */
+    arm_max_q31(pSrc, k, &loVal, &index);
+    hiVal = (q31_t) (((q63_t) loVal + hiVal) >> 1);
+  }
+
+  *pResult = hiVal;
+}
+
+/**
+ * @brief  Percentile of a Q31 vector.
+ * @param[in,out] *pSrc      points to the input vector, reordered in place.
+ * @param[in]     blockSize  length of the input vector, at least 1.
+ * @param[in]     p          fraction of the samples below the result, in [0, 1).
+ * @param[out]    *pResult   percentile returned here.
+ * @return none.
+ */
+
+void arm_percentile_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  q31_t p,
+  q31_t * pResult)
+{
+  q31_t loVal, hiVal;                            /* Interpolated elements */
+  q63_t pos;                                     /* Rank, in the format of p */
+  uint32_t k, index;                             /* Rank of the lower element */
+
+  pos = (q63_t) ((p > 0) ? p : 0) * (blockSize - 1u);
+  k = (uint32_t) (pos >> 31);
+
+  loVal = arm_median_select_q31(pSrc, blockSize, k);
+
+  if(((pos & 0x7FFFFFFF) != 0) && ((k + 1u) < blockSize))
+  {
+    /* The next element is the smallest one above rank k */
+    arm_min_q31(pSrc + k + 1u, blockSize - k - 1u, &hiVal, &index);
+    loVal += (q31_t) ((((q63_t) hiVal - loVal) * (pos & 0x7FFFFFFF)) >> 31);
+  }
+
+  *pResult = loVal;
+}
+
+/**
+ * @} end of Median group
+ */
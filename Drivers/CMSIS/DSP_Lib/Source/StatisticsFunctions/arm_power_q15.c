@@ -113,7 +113,7 @@ void arm_power_q15(
     /* C = A[0] * A[0] + A[1] * A[1] + A[2] * A[2] + ... + A[blockSize-1] * A[blockSize-1] */
     /* Compute Power and then store the result in a temporary variable, sum. */
     in16 = *pSrc++;
-    sum = __SMLALD(in16, in16, sum);
+    sum += ((q31_t) in16 * in16);
 
     /* Decrement the loop counter */
     blkCnt--;
@@ -0,0 +1,90 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_sort_bitonic_f32.c
+*
+* Description:  Ascending sort of a floating-point vector by a bitonic
+*               sorting network.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup Sort
+ * @{
+ */
+
+/**
+ * @brief  Ascending sort of a floating-point vector by a bitonic sorting network.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[out] *pDst      points to the sorted vector; may be pSrc.
+ * @param[in]  blockSize  length of the vectors, of any value.
+ * @return none.
+ *
+ * \par
+ * Each merge of two sorted runs of <code>k/2</code> elements first compares element
+ * <code>i</code> of the block of <code>k</code> with element <code>k-1-i</code>, then runs
+ * half-cleaners of distance <code>k/4</code> down to 1.  All the compare-exchanges put the
+ * minimum first, so that a length that is not a power of two sorts as if padded with
+ * <code>+inf</code>: the exchanges with a padding element never swap, and are skipped.
+ */
+
+void arm_sort_bitonic_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  float32_t a, b;                                /* Compared elements */
+  uint32_t k, j, base, t, lo, hi;                /* Network stages and comparators */
+
+  if(pSrc != pDst)
+  {
+    memcpy(pDst, pSrc, blockSize * sizeof(float32_t));
+  }
+
+  for (k = 2u; (k >> 1u) < blockSize; k <<= 1u)
+  {
+    /* Merge of the two runs, the second one reversed */
+    for (base = 0u; base < blockSize; base += k)
+    {
+      for (t = 0u; t < (k >> 1u); t++)
+      {
+        lo = base + t;
+        hi = base + (k - 1u) - t;
+        if(hi < blockSize)
+        {
+          a = pDst[lo];
+          b = pDst[hi];
+          pDst[lo] = (b < a) ? b : a;
+          pDst[hi] = (b < a) ? a : b;
+        }
+      }
+    }
+
+    /* Half-cleaners */
+    for (j = k >> 2u; j > 0u; j >>= 1u)
+    {
+      for (base = 0u; base < blockSize; base += 2u * j)
+      {
+        for (t = 0u; (t < j) && ((base + t + j) < blockSize); t++)
+        {
+          lo = base + t;
+          hi = lo + j;
+          a = pDst[lo];
+          b = pDst[hi];
+          pDst[lo] = (b < a) ? b : a;
+          pDst[hi] = (b < a) ? a : b;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @} end of Sort group
+ */
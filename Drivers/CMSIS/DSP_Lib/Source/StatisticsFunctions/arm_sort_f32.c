@@ -0,0 +1,239 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_sort_f32.c
+*
+* Description:  Ascending sort of a floating-point vector by introsort.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @defgroup Sort Sorting
+ *
+ * Sorts a vector in ascending order.  Each function takes a source and a destination,
+ * which may be the same buffer for an in-place sort.
+ *
+ * \par Floating-point
+ * <code>arm_sort_f32()</code> is an introsort: a quicksort with a median-of-three pivot,
+ * whose partitions of at most <code>ARM_SORT_INSERTION</code> elements are finished by
+ * insertion sort, and which falls back to heapsort on the partitions that recurse deeper than
+ * <code>2*log2(blockSize)</code>.  It runs in <code>O(blockSize*log(blockSize))</code> on any
+ * input, with a stack of <code>O(log(blockSize))</code>.
+ *
+ * \par
+ * <code>arm_sort_bitonic_f32()</code> runs a bitonic sorting network: a fixed sequence of
+ * <code>O(blockSize*log(blockSize)^2)</code> compare-exchanges, which does not depend on the
+ * data and has no data-dependent branch.  It is faster on short vectors, and its run time is
+ * the same for any input of a given length.
+ *
+ * \par
+ * The floating-point input must not contain NaN.
+ *
+ * \par Fixed-point
+ * <code>arm_sort_q31()</code> and <code>arm_sort_q15()</code> are least-significant-digit
+ * radix sorts on 8-bit digits, in <code>O(blockSize)</code>: each digit is counted, then
+ * scattered between the destination and a scratch buffer of <code>blockSize</code> values.
+ * A digit shared by all the values, such as the sign extension of a small signal, is skipped.
+ * <code>arm_sort_q7()</code> is a counting sort and needs no scratch buffer.  The counts take
+ * 1 kbyte of stack.
+ */
+
+/**
+ * @addtogroup Sort
+ * @{
+ */
+
+/**
+ * @brief  Insertion sort of a short partition.
+ * @param[in,out] *pData     points to the partition.
+ * @param[in]     blockSize  number of elements of the partition.
+ * @return none.
+ */
+
+static void arm_sort_insertion_f32(
+  float32_t * pData,
+  uint32_t blockSize)
+{
+  float32_t in;                                  /* Element to insert */
+  uint32_t i, j;                                 /* Loop counters */
+
+  for (i = 1u; i < blockSize; i++)
+  {
+    in = pData[i];
+    j = i;
+    while((j > 0u) && (in < pData[j - 1u]))
+    {
+      pData[j] = pData[j - 1u];
+      j--;
+    }
+    pData[j] = in;
+  }
+}
+
+/**
+ * @brief  Heapsort of a partition that recursed too deep.
+ * @param[in,out] *pData     points to the partition.
+ * @param[in]     blockSize  number of elements of the partition.
+ * @return none.
+ */
+
+static void arm_sort_heap_f32(
+  float32_t * pData,
+  uint32_t blockSize)
+{
+  float32_t in;                                  /* Element to sift down */
+  uint32_t i, n, parent, child;                  /* Heap indices */
+
+  /* Build a max-heap, then move its root to the end of the shrinking heap */
+  for (i = blockSize + (blockSize / 2u); i > 0u; i--)
+  {
+    if(i > blockSize)
+    {
+      parent = i - blockSize - 1u;
+      n = blockSize;
+    }
+    else
+    {
+      n = i - 1u;
+      in = pData[n];
+      pData[n] = pData[0];
+      pData[0] = in;
+      parent = 0u;
+    }
+
+    in = pData[parent];
+    child = (2u * parent) + 1u;
+    while(child < n)
+    {
+      if(((child + 1u) < n) && (pData[child] < pData[child + 1u]))
+      {
+        child++;
+      }
+      if(!(in < pData[child]))
+      {
+        break;
+      }
+      pData[parent] = pData[child];
+      parent = child;
+      child = (2u * parent) + 1u;
+    }
+    pData[parent] = in;
+  }
+}
+
+/**
+ * @brief  Quicksort with a depth limit.
+ * @param[in,out] *pData     points to the partition.
+ * @param[in]     blockSize  number of elements of the partition.
+ * @param[in]     depth      number of partitionings left before heapsort.
+ * @return none.
+ */
+
+static void arm_sort_intro_f32(
+  float32_t * pData,
+  uint32_t blockSize,
+  uint32_t depth)
+{
+  float32_t a, b, c, pivot, in;                  /* Pivot selection and exchange */
+  int32_t i, j;                                  /* Partition indices */
+
+  while(blockSize > ARM_SORT_INSERTION)
+  {
+    if(depth == 0u)
+    {
+      arm_sort_heap_f32(pData, blockSize);
+      return;
+    }
+    depth--;
+
+    /* Median of the first, middle and last elements */
+    a = pData[0];
+    b = pData[blockSize / 2u];
+    c = pData[blockSize - 1u];
+    if(a < b)
+    {
+      pivot = (b < c) ? b : ((a < c) ? c : a);
+    }
+    else
+    {
+      pivot = (a < c) ? a : ((b < c) ? c : b);
+    }
+
+    /* Hoare partition: [0, j] <= pivot <= [i, blockSize) */
+    i = 0;
+    j = (int32_t) blockSize - 1;
+    while(i <= j)
+    {
+      while(pData[i] < pivot)
+      {
+        i++;
+      }
+      while(pivot < pData[j])
+      {
+        j--;
+      }
+      if(i <= j)
+      {
+        in = pData[i];
+        pData[i] = pData[j];
+        pData[j] = in;
+        i++;
+        j--;
+      }
+    }
+
+    /* Recurse into the smaller side, and loop on the larger one */
+    if((uint32_t) (j + 1) < (blockSize - (uint32_t) i))
+    {
+      arm_sort_intro_f32(pData, (uint32_t) (j + 1), depth);
+      pData += i;
+      blockSize -= (uint32_t) i;
+    }
+    else
+    {
+      arm_sort_intro_f32(pData + i, blockSize - (uint32_t) i, depth);
+      blockSize = (uint32_t) (j + 1);
+    }
+  }
+
+  arm_sort_insertion_f32(pData, blockSize);
+}
+
+/**
+ * @brief  Ascending sort of a floating-point vector.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[out] *pDst      points to the sorted vector; may be pSrc.
+ * @param[in]  blockSize  length of the vectors.
+ * @return none.
+ */
+
+void arm_sort_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t depth = 0u;                           /* Depth limit */
+  uint32_t n;                                    /* Length of the halvings */
+
+  if(pSrc != pDst)
+  {
+    memcpy(pDst, pSrc, blockSize * sizeof(float32_t));
+  }
+
+  for (n = blockSize; n > 1u; n >>= 1u)
+  {
+    depth += 2u;
+  }
+
+  arm_sort_intro_f32(pDst, blockSize, depth);
+}
+
+/**
+ * @} end of Sort group
+ */
@@ -0,0 +1,87 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_sort_q15.c
+*
+* Description:  Ascending sort of a Q15 vector by radix sort.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup Sort
+ * @{
+ */
+
+/**
+ * @brief  Ascending sort of a Q15 vector by radix sort.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[out] *pDst      points to the sorted vector; may be pSrc.
+ * @param[in]  *pScratch  points to a scratch buffer of blockSize values.
+ * @param[in]  blockSize  length of the vectors.
+ * @return none.
+ *
+ * \par
+ * The two digits of 8 bits are sorted from the least significant one, with the sign bit
+ * inverted so that the negative values come first.  The sort is stable.
+ */
+
+void arm_sort_q15(
+  const q15_t * pSrc,
+  q15_t * pDst,
+  q15_t * pScratch,
+  uint32_t blockSize)
+{
+  uint32_t count[256];                           /* Digit counts, then offsets */
+  const q15_t *pIn = pSrc;                       /* Values sorted up to the previous digit */
+  q15_t *pOut;                                   /* Values sorted up to the current digit */
+  uint32_t key, sum, shift, i;                   /* Digit and loop counters */
+
+  for (shift = 0u; shift < 16u; shift += 8u)
+  {
+    memset(count, 0, sizeof(count));
+    for (i = 0u; i < blockSize; i++)
+    {
+      key = ((uint16_t) pIn[i] ^ 0x8000u) >> shift;
+      count[key & 0xFFu]++;
+    }
+
+    /* A digit shared by all the values leaves their order */
+    key = ((blockSize > 0u) ? ((uint16_t) pIn[0] ^ 0x8000u) >> shift : 0u) & 0xFFu;
+    if(count[key] == blockSize)
+    {
+      continue;
+    }
+
+    sum = 0u;
+    for (i = 0u; i < 256u; i++)
+    {
+      key = count[i];
+      count[i] = sum;
+      sum += key;
+    }
+
+    /* Scatter between the scratch and the destination, never into the values being read */
+    pOut = (pIn == pScratch) ? pDst : pScratch;
+    for (i = 0u; i < blockSize; i++)
+    {
+      key = (((uint16_t) pIn[i] ^ 0x8000u) >> shift) & 0xFFu;
+      pOut[count[key]++] = pIn[i];
+    }
+    pIn = pOut;
+  }
+
+  if(pIn != pDst)
+  {
+    memcpy(pDst, pIn, blockSize * sizeof(q15_t));
+  }
+}
+
+/**
+ * @} end of Sort group
+ */
@@ -0,0 +1,57 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_sort_q7.c
+*
+* Description:  Ascending sort of a Q7 vector by counting sort.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup Sort
+ * @{
+ */
+
+/**
+ * @brief  Ascending sort of a Q7 vector by counting sort.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[out] *pDst      points to the sorted vector; may be pSrc.
+ * @param[in]  blockSize  length of the vectors.
+ * @return none.
+ *
+ * \par
+ * The values are counted, then written back in order: the sort reads the input once,
+ * and needs no scratch buffer.
+ */
+
+void arm_sort_q7(
+  const q7_t * pSrc,
+  q7_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t count[256];                           /* Count of each value, from -128 */
+  uint32_t i, n;                                 /* Loop counters */
+
+  memset(count, 0, sizeof(count));
+  for (i = 0u; i < blockSize; i++)
+  {
+    count[(uint8_t) pSrc[i] ^ 0x80u]++;
+  }
+
+  for (i = 0u; i < 256u; i++)
+  {
+    n = count[i];
+    memset(pDst, (int) (i ^ 0x80u), n);
+    pDst += n;
+  }
+}
+
+/**
+ * @} end of Sort group
+ */
@@ -0,0 +1,262 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_stats_f32.c
+*
+* Description:  Mean, variance, standard deviation, RMS, minimum and
+*               maximum of a floating-point vector or stream in one pass.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @defgroup Stats Fused Statistics
+ *
+ * Computes the mean, variance, standard deviation, RMS, minimum and maximum of the
+ * samples, with the indices of the extrema, in a single pass over the input instead of
+ * one pass per function.
+ *
+ * \par Floating-point
+ * <code>arm_var_f32()</code> subtracts the square of the mean from the mean of the squares,
+ * which cancels when the mean is large against the deviation.  The fused functions instead
+ * cut the input in blocks of <code>ARM_STATS_BLOCK</code> samples: each block is read once
+ * for its sum, squares and extrema, and a second time for the squared deviations from its
+ * own mean, so that the samples are read twice but never stored.  On a processor with a
+ * data cache the second read of the short block hits the cache.  The blocks are then
+ * merged, with their means and
+ * sums of squared deviations, by the update of Chan, Golub and LeVeque:
+ * <pre>
+ *     delta = meanB - meanA
+ *     mean  = meanA + delta * nB / (nA + nB)
+ *     M2    = M2A + M2B + delta^2 * nA * nB / (nA + nB)
+ * </pre>
+ * which is Welford's update for blocks of one sample, with one division per block.
+ *
+ * \par
+ * <code>arm_stats_f32()</code> processes a vector.  For an unbounded stream, the instance of
+ * <code>arm_stats_init_f32()</code> keeps the running statistics, <code>arm_stats_update_f32()</code>
+ * merges each new block of samples into them, and <code>arm_stats_get_f32()</code> reads them at
+ * any time.  The state holds means rather than sums, so that it does not grow with the stream,
+ * and the indices of the extrema count the samples from the initialization.
+ *
+ * \par
+ * The variance is the sample variance, with <code>N - 1</code> in the denominator as in
+ * <code>arm_var_f32()</code>, and 0 for a single sample.
+ *
+ * \par Q31
+ * <code>arm_stats_q31()</code> computes, in one pass, the results of <code>arm_mean_q31()</code>,
+ * <code>arm_var_q31()</code>, <code>arm_std_q31()</code>, <code>arm_rms_q31()</code>,
+ * <code>arm_min_q31()</code> and <code>arm_max_q31()</code>, bit for bit, with their scaling and
+ * overflow behavior.
+ */
+
+/**
+ * @addtogroup Stats
+ * @{
+ */
+
+/**
+ * @brief  Initialization function for the floating-point running statistics.
+ * @param[out] *S  points to an instance of the floating-point statistics structure.
+ * @return none.
+ */
+
+void arm_stats_init_f32(
+  arm_stats_instance_f32 * S)
+{
+  S->count = 0u;
+  S->mean = 0.0f;
+  S->m2 = 0.0f;
+  S->meanSq = 0.0f;
+  S->min = 0.0f;
+  S->max = 0.0f;
+  S->minIndex = 0u;
+  S->maxIndex = 0u;
+}
+
+/**
+ * @brief  Merges a block of samples into the floating-point running statistics.
+ * @param[in,out] *S         points to an instance of the floating-point statistics structure.
+ * @param[in]     *pSrc      points to the block of samples.
+ * @param[in]     blockSize  number of samples in the block.
+ * @return none.
+ */
+
+void arm_stats_update_f32(
+  arm_stats_instance_f32 * S,
+  const float32_t * pSrc,
+  uint32_t blockSize)
+{
+  const float32_t *pIn;                          /* Samples of the current block */
+  float32_t sum, sumSq, m2, mean, d0;            /* Sums of the block */
+  float32_t in, minVal, maxVal;                  /* Extrema of the block */
+  float32_t n, f, delta;                         /* Merge of the block */
+  uint32_t minIndex, maxIndex, blkLen, blkCnt, i;  /* Indices and loop counters */
+
+  while(blockSize > 0u)
+  {
+    blkLen = (blockSize < ARM_STATS_BLOCK) ? blockSize : ARM_STATS_BLOCK;
+
+    /* Sum, squares and extrema of the block */
+    pIn = pSrc;
+    sum = 0.0f;
+    sumSq = 0.0f;
+    minVal = pIn[0];
+    maxVal = pIn[0];
+    minIndex = 0u;
+    maxIndex = 0u;
+
+    for (i = 0u; i < blkLen; i++)
+    {
+      in = pIn[i];
+      sum += in;
+      sumSq += in * in;
+      if(in < minVal)
+      {
+        minVal = in;
+        minIndex = i;
+      }
+      if(in > maxVal)
+      {
+        maxVal = in;
+        maxIndex = i;
+      }
+    }
+
+    /* Squared deviations from the mean of the block, in a second read */
+    mean = sum / (float32_t) blkLen;
+    m2 = 0.0f;
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+    /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+    /* Loop unrolling */
+    blkCnt = blkLen >> 2u;
+
+    while(blkCnt > 0u)
+    {
+      float32_t d1, d2, d3;
+
+      d0 = pIn[0] - mean;
+      d1 = pIn[1] - mean;
+      d2 = pIn[2] - mean;
+      d3 = pIn[3] - mean;
+      m2 += (d0 * d0) + (d1 * d1);
+      m2 += (d2 * d2) + (d3 * d3);
+      pIn += 4u;
+
+      blkCnt--;
+    }
+
+    blkCnt = blkLen % 0x4u;
+
+#else
+
+    /* Run the below code for Cortex-M0 */
+
+    blkCnt = blkLen;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+    while(blkCnt > 0u)
+    {
+      d0 = *pIn++ - mean;
+      m2 += d0 * d0;
+
+      blkCnt--;
+    }
+
+    /* Merge the block into the running statistics */
+    if(S->count == 0u)
+    {
+      S->mean = mean;
+      S->m2 = m2;
+      S->meanSq = sumSq / (float32_t) blkLen;
+      S->min = minVal;
+      S->max = maxVal;
+      S->minIndex = minIndex;
+      S->maxIndex = maxIndex;
+    }
+    else
+    {
+      n = (float32_t) S->count;
+      f = (float32_t) blkLen / (n + (float32_t) blkLen);
+      delta = mean - S->mean;
+
+      S->mean += delta * f;
+      S->m2 += m2 + ((delta * delta) * (n * f));
+      S->meanSq += ((sumSq / (float32_t) blkLen) - S->meanSq) * f;
+
+      if(minVal < S->min)
+      {
+        S->min = minVal;
+        S->minIndex = S->count + minIndex;
+      }
+      if(maxVal > S->max)
+      {
+        S->max = maxVal;
+        S->maxIndex = S->count + maxIndex;
+      }
+    }
+
+    S->count += blkLen;
+    pSrc += blkLen;
+    blockSize -= blkLen;
+  }
+}
+
+/**
+ * @brief  Reads the floating-point running statistics.
+ * @param[in]  *S        points to an instance of the floating-point statistics structure.
+ * @param[out] *pResult  points to the statistics of the samples merged since the initialization,
+ *                       all 0 if there is none.
+ * @return none.
+ */
+
+void arm_stats_get_f32(
+  const arm_stats_instance_f32 * S,
+  arm_stats_result_f32 * pResult)
+{
+  pResult->mean = S->mean;
+  pResult->var = (S->count > 1u) ? (S->m2 / (float32_t) (S->count - 1u)) : 0.0f;
+  arm_sqrt_f32(pResult->var, &pResult->std);
+  arm_sqrt_f32(S->meanSq, &pResult->rms);
+  pResult->min = S->min;
+  pResult->max = S->max;
+  pResult->minIndex = S->minIndex;
+  pResult->maxIndex = S->maxIndex;
+}
+
+/**
+ * @brief  Statistics of a floating-point vector in one pass.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[in]  blockSize  length of the input vector, at least 1.
+ * @param[out] *pResult   points to the statistics.
+ * @return none.
+ *
+ * \par
+ * The minimum and maximum are the first ones, with the indices that
+ * <code>arm_min_f32()</code> and <code>arm_max_f32()</code> return.
+ */
+
+void arm_stats_f32(
+  const float32_t * pSrc,
+  uint32_t blockSize,
+  arm_stats_result_f32 * pResult)
+{
+  arm_stats_instance_f32 S;                      /* Statistics of the vector */
+
+  arm_stats_init_f32(&S);
+  arm_stats_update_f32(&S, pSrc, blockSize);
+  arm_stats_get_f32(&S, pResult);
+}
+
+/**
+ * @} end of Stats group
+ */
@@ -0,0 +1,197 @@
+/* ----------------------------------------------------------------------
+* Project:      CMSIS DSP Library
+* Title:        arm_stats_q31.c
+*
+* Description:  Mean, variance, standard deviation, RMS, minimum and
+*               maximum of a Q31 vector in one pass.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup Stats
+ * @{
+ */
+
+/**
+ * @brief  Statistics of a Q31 vector in one pass.
+ * @param[in]  *pSrc      points to the input vector.
+ * @param[in]  blockSize  length of the input vector, at least 1.
+ * @param[out] *pResult   points to the statistics.
+ * @return none.
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * The results are those of the separate functions, with their accumulators: the mean
+ * of <code>arm_mean_q31()</code>, the variance and standard deviation of
+ * <code>arm_var_q31()</code> and <code>arm_std_q31()</code>, whose 1.23 sum of squares
+ * needs the input scaled down by <code>log2(blockSize)-8</code> bits, and the RMS of
+ * <code>arm_rms_q31()</code>, whose 2.62 sum of squares needs it scaled down by half of
+ * <code>log2(blockSize)</code> bits.  The variance and standard deviation of a single
+ * sample are 0.
+ */
+
+void arm_stats_q31(
+  const q31_t * pSrc,
+  uint32_t blockSize,
+  arm_stats_result_q31 * pResult)
+{
+  q63_t sum = 0;                                 /* Sum of the samples */
+  q63_t sum8 = 0;                                /* Sum of the samples in 1.23 */
+  q63_t sumSq8 = 0;                              /* Sum of the squares of the 1.23 samples */
+  q63_t sumSq = 0;                               /* Sum of the squares of the 1.31 samples */
+  q63_t meanOfSquares, squareOfMean;             /* Variance terms */
+  q31_t in, in8, minVal, maxVal;                 /* Sample and extrema */
+  uint32_t minIndex = 0u, maxIndex = 0u;         /* Indices of the extrema */
+  uint32_t blkCnt, i = 0u;                       /* Loop counters */
+
+  minVal = pSrc[0];
+  maxVal = pSrc[0];
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  /* Loop unrolling */
+  blkCnt = blockSize >> 2u;
+
+  while(blkCnt > 0u)
+  {
+    in = pSrc[i];
+    in8 = in >> 8;
+    sum += in;
+    sum8 += in8;
+    sumSq8 += ((q63_t) in8 * in8);
+    sumSq += ((q63_t) in * in);
+    if(in < minVal)
+    {
+      minVal = in;
+      minIndex = i;
+    }
+    if(in > maxVal)
+    {
+      maxVal = in;
+      maxIndex = i;
+    }
+
+    in = pSrc[i + 1u];
+    in8 = in >> 8;
+    sum += in;
+    sum8 += in8;
+    sumSq8 += ((q63_t) in8 * in8);
+    sumSq += ((q63_t) in * in);
+    if(in < minVal)
+    {
+      minVal = in;
+      minIndex = i + 1u;
+    }
+    if(in > maxVal)
+    {
+      maxVal = in;
+      maxIndex = i + 1u;
+    }
+
+    in = pSrc[i + 2u];
+    in8 = in >> 8;
+    sum += in;
+    sum8 += in8;
+    sumSq8 += ((q63_t) in8 * in8);
+    sumSq += ((q63_t) in * in);
+    if(in < minVal)
+    {
+      minVal = in;
+      minIndex = i + 2u;
+    }
+    if(in > maxVal)
+    {
+      maxVal = in;
+      maxIndex = i + 2u;
+    }
+
+    in = pSrc[i + 3u];
+    in8 = in >> 8;
+    sum += in;
+    sum8 += in8;
+    sumSq8 += ((q63_t) in8 * in8);
+    sumSq += ((q63_t) in * in);
+    if(in < minVal)
+    {
+      minVal = in;
+      minIndex = i + 3u;
+    }
+    if(in > maxVal)
+    {
+      maxVal = in;
+      maxIndex = i + 3u;
+    }
+
+    i += 4u;
+    blkCnt--;
+  }
+
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    in = pSrc[i];
+    in8 = in >> 8;
+    sum += in;
+    sum8 += in8;
+    sumSq8 += ((q63_t) in8 * in8);
+    sumSq += ((q63_t) in * in);
+    if(in < minVal)
+    {
+      minVal = in;
+      minIndex = i;
+    }
+    if(in > maxVal)
+    {
+      maxVal = in;
+      maxIndex = i;
+    }
+
+    i++;
+    blkCnt--;
+  }
+
+  pResult->mean = (q31_t) (sum / (int32_t) blockSize);
+
+  /* Variance in 1.31, from the 2.46 sums of arm_var_q31() */
+  if(blockSize > 1u)
+  {
+    meanOfSquares = sumSq8 / (q63_t) (blockSize - 1u);
+    squareOfMean = sum8 * sum8 / (q63_t) (blockSize * (blockSize - 1u));
+    pResult->var = (q31_t) ((meanOfSquares - squareOfMean) >> 15);
+    arm_sqrt_q31((q31_t) ((meanOfSquares - squareOfMean) >> 15), &pResult->std);
+  }
+  else
+  {
+    pResult->var = 0;
+    pResult->std = 0;
+  }
+
+  arm_sqrt_q31(clip_q63_to_q31((sumSq / (q63_t) blockSize) >> 31), &pResult->rms);
+
+  pResult->min = minVal;
+  pResult->max = maxVal;
+  pResult->minIndex = minIndex;
+  pResult->maxIndex = maxIndex;
+}
+
+/**
+ * @} end of Stats group
+ */
@@ -173,6 +173,11 @@
  * operate on individual values and not arrays.
  * There are separate functions for Q15, Q31, and floating-point data.
  *
+ * The block functions, such as <code>arm_sin_block_f32()</code>, apply sine, cosine, square root,
+ * exponential, logarithm or four-quadrant arctangent to arrays of floating-point values.  Their
+ * loops have no data-dependent branch, so that a vectorizing compiler or a SIMD unit can run
+ * several values at once.
+ *
  */
 
 /**
@@ -1214,6 +1219,155 @@ extern "C"
   uint32_t blockSize);
 
 
+  /**
+   * @brief Instance structure for the Q7 FIR filter on a circular delay line.
+   */
+  typedef struct
+  {
+    uint16_t numTaps;         /**< number of filter coefficients in the filter. */
+    uint16_t stateIndex;      /**< slot of the next input sample in the delay line of numTaps+3 slots. */
+    q7_t *pState;             /**< points to the state variable array, the delay line and its mirror. The array is of length 2*(numTaps+3). */
+    q7_t *pCoeffs;            /**< points to the coefficient array. The array is of length numTaps. */
+  } arm_fir_circular_instance_q7;
+
+  /**
+   * @brief Processing function for the Q7 FIR filter on a circular delay line.
+   * @param[in,out] S          points to an instance of the Q7 circular FIR structure.
+   * @param[in]     pSrc       points to the block of input data.
+   * @param[out]    pDst       points to the block of output data.
+   * @param[in]     blockSize  number of samples to process.
+   */
+  void arm_fir_circular_q7(
+  arm_fir_circular_instance_q7 * S,
+  q7_t * pSrc,
+  q7_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Initialization function for the Q7 FIR filter on a circular delay line.
+   * @param[in,out] S          points to an instance of the Q7 circular FIR structure.
+   * @param[in]     numTaps    Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs    points to the filter coefficients, in the order of arm_fir_init_q7().
+   * @param[in]     pState     points to the state buffer of 2*(numTaps+3) words.
+   */
+  void arm_fir_circular_init_q7(
+  arm_fir_circular_instance_q7 * S,
+  uint16_t numTaps,
+  q7_t * pCoeffs,
+  q7_t * pState);
+
+  /**
+   * @brief Instance structure for the Q15 FIR filter on a circular delay line.
+   */
+  typedef struct
+  {
+    uint16_t numTaps;         /**< number of filter coefficients in the filter. */
+    uint16_t stateIndex;      /**< slot of the next input sample in the delay line of numTaps+3 slots. */
+    q15_t *pState;            /**< points to the state variable array, the delay line and its mirror. The array is of length 2*(numTaps+3). */
+    q15_t *pCoeffs;           /**< points to the coefficient array. The array is of length numTaps. */
+  } arm_fir_circular_instance_q15;
+
+  /**
+   * @brief Processing function for the Q15 FIR filter on a circular delay line.
+   * @param[in,out] S          points to an instance of the Q15 circular FIR structure.
+   * @param[in]     pSrc       points to the block of input data.
+   * @param[out]    pDst       points to the block of output data.
+   * @param[in]     blockSize  number of samples to process.
+   */
+  void arm_fir_circular_q15(
+  arm_fir_circular_instance_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Initialization function for the Q15 FIR filter on a circular delay line.
+   * @param[in,out] S          points to an instance of the Q15 circular FIR structure.
+   * @param[in]     numTaps    Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs    points to the filter coefficients, in the order of arm_fir_init_q15().
+   * @param[in]     pState     points to the state buffer of 2*(numTaps+3) words.
+   */
+  void arm_fir_circular_init_q15(
+  arm_fir_circular_instance_q15 * S,
+  uint16_t numTaps,
+  q15_t * pCoeffs,
+  q15_t * pState);
+
+  /**
+   * @brief Instance structure for the Q31 FIR filter on a circular delay line.
+   */
+  typedef struct
+  {
+    uint16_t numTaps;         /**< number of filter coefficients in the filter. */
+    uint16_t stateIndex;      /**< slot of the next input sample in the delay line of numTaps+3 slots. */
+    q31_t *pState;            /**< points to the state variable array, the delay line and its mirror. The array is of length 2*(numTaps+3). */
+    q31_t *pCoeffs;           /**< points to the coefficient array. The array is of length numTaps. */
+  } arm_fir_circular_instance_q31;
+
+  /**
+   * @brief Processing function for the Q31 FIR filter on a circular delay line.
+   * @param[in,out] S          points to an instance of the Q31 circular FIR structure.
+   * @param[in]     pSrc       points to the block of input data.
+   * @param[out]    pDst       points to the block of output data.
+   * @param[in]     blockSize  number of samples to process.
+   */
+  void arm_fir_circular_q31(
+  arm_fir_circular_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Initialization function for the Q31 FIR filter on a circular delay line.
+   * @param[in,out] S          points to an instance of the Q31 circular FIR structure.
+   * @param[in]     numTaps    Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs    points to the filter coefficients, in the order of arm_fir_init_q31().
+   * @param[in]     pState     points to the state buffer of 2*(numTaps+3) words.
+   */
+  void arm_fir_circular_init_q31(
+  arm_fir_circular_instance_q31 * S,
+  uint16_t numTaps,
+  q31_t * pCoeffs,
+  q31_t * pState);
+
+  /**
+   * @brief Instance structure for the floating-point FIR filter on a circular delay line.
+   */
+  typedef struct
+  {
+    uint16_t numTaps;         /**< number of filter coefficients in the filter. */
+    uint16_t stateIndex;      /**< slot of the next input sample in the delay line of numTaps+3 slots. */
+    float32_t *pState;        /**< points to the state variable array, the delay line and its mirror. The array is of length 2*(numTaps+3). */
+    float32_t *pCoeffs;       /**< points to the coefficient array. The array is of length numTaps. */
+  } arm_fir_circular_instance_f32;
+
+  /**
+   * @brief Processing function for the floating-point FIR filter on a circular delay line.
+   * @param[in,out] S          points to an instance of the floating-point circular FIR structure.
+   * @param[in]     pSrc       points to the block of input data.
+   * @param[out]    pDst       points to the block of output data.
+   * @param[in]     blockSize  number of samples to process.
+   */
+  void arm_fir_circular_f32(
+  arm_fir_circular_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Initialization function for the floating-point FIR filter on a circular delay line.
+   * @param[in,out] S          points to an instance of the floating-point circular FIR structure.
+   * @param[in]     numTaps    Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs    points to the filter coefficients, in the order of arm_fir_init_f32().
+   * @param[in]     pState     points to the state buffer of 2*(numTaps+3) words.
+   */
+  void arm_fir_circular_init_f32(
+  arm_fir_circular_instance_f32 * S,
+  uint16_t numTaps,
+  float32_t * pCoeffs,
+  float32_t * pState);
+
+
   /**
    * @brief Instance structure for the Q15 Biquad cascade filter.
    */
@@ -2248,6 +2402,51 @@ void arm_rfft_fast_f32(
   float32_t * p, float32_t * pOut,
   uint8_t ifftFlag);
 
+  /**
+   * @brief Instance structure for the floating-point partitioned FIR filter.
+   */
+  typedef struct
+  {
+    uint16_t numTaps;                    /**< number of filter coefficients in the filter. */
+    uint16_t partLen;                    /**< length of a partition of the coefficients, and of a block of samples. */
+    uint16_t numParts;                   /**< number of partitions, ceil(numTaps / partLen). */
+    uint16_t partIndex;                  /**< slot of the newest input spectrum in the frequency-domain delay line. */
+    float32_t *pSpectra;                 /**< points to the spectra of the partitions. The array is of length 2*partLen*numParts. */
+    float32_t *pState;                   /**< points to the state variable array. The array is of length 2*partLen*(numParts+3). */
+    arm_rfft_fast_instance_f32 rfft;     /**< real FFT of length 2*partLen. */
+  } arm_fir_partitioned_instance_f32;
+
+  /**
+   * @brief Processing function for the floating-point partitioned FIR filter.
+   * @param[in]  S          points to an instance of the floating-point partitioned FIR structure.
+   * @param[in]  pSrc       points to the block of input data.
+   * @param[out] pDst       points to the block of output data.
+   * @param[in]  blockSize  number of samples to process, a multiple of partLen.
+   */
+  void arm_fir_partitioned_f32(
+  arm_fir_partitioned_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Initialization function for the floating-point partitioned FIR filter.
+   * @param[in,out] S          points to an instance of the floating-point partitioned FIR structure.
+   * @param[in]     numTaps    Number of filter coefficients in the filter.
+   * @param[in]     pCoeffs    points to the filter coefficients, in the order of arm_fir_init_f32().
+   * @param[out]    pSpectra   points to the buffer of the partition spectra, 2*partLen*numParts words.
+   * @param[in]     pState     points to the state buffer, 2*partLen*(numParts+3) words.
+   * @param[in]     partLen    partition length: 16, 32, 64, 128, 256, 512, 1024 or 2048.
+   * @return        The function returns ARM_MATH_SUCCESS if initialization is successful or ARM_MATH_ARGUMENT_ERROR if <code>partLen</code> is not a supported value.
+   */
+  arm_status arm_fir_partitioned_init_f32(
+  arm_fir_partitioned_instance_f32 * S,
+  uint16_t numTaps,
+  float32_t * pCoeffs,
+  float32_t * pSpectra,
+  float32_t * pState,
+  uint16_t partLen);
+
   /**
    * @brief Instance structure for the floating-point DCT4/IDCT4 function.
    */
@@ -3062,6 +3261,64 @@ void arm_rfft_fast_f32(
   q7_t * pDst);
 
 
+  /**
+   * @brief Transform length of the FFT convolution of floating-point sequences.
+   * @param[in]  srcALen  length of the first input sequence.
+   * @param[in]  srcBLen  length of the second input sequence.
+   * @return fftLen of arm_conv_fft_f32() and arm_correlate_fft_f32(), or 0 when the direct form is cheaper.
+   */
+  uint32_t arm_conv_fft_len_f32(
+  uint32_t srcALen,
+  uint32_t srcBLen);
+
+
+  /**
+   * @brief Convolution of floating-point sequences, by overlap-save FFT for long sequences.
+   * @param[in]  pSrcA     points to the first input sequence.
+   * @param[in]  srcALen   length of the first input sequence.
+   * @param[in]  pSrcB     points to the second input sequence.
+   * @param[in]  srcBLen   length of the second input sequence.
+   * @param[out] pDst      points to the block of output data  Length srcALen+srcBLen-1.
+   * @param[in]  pScratch  points to scratch buffer of size 3 * arm_conv_fft_len_f32(srcALen, srcBLen).
+   */
+  void arm_conv_fft_f32(
+  float32_t * pSrcA,
+  uint32_t srcALen,
+  float32_t * pSrcB,
+  uint32_t srcBLen,
+  float32_t * pDst,
+  float32_t * pScratch);
+
+
+  /**
+   * @brief Transform length of the FFT convolution of Q31 sequences.
+   * @param[in]  srcALen  length of the first input sequence.
+   * @param[in]  srcBLen  length of the second input sequence.
+   * @return fftLen of arm_conv_fft_q31() and arm_correlate_fft_q31(), or 0 when the direct form is cheaper.
+   */
+  uint32_t arm_conv_fft_len_q31(
+  uint32_t srcALen,
+  uint32_t srcBLen);
+
+
+  /**
+   * @brief Convolution of Q31 sequences, by overlap-save FFT for long sequences.
+   * @param[in]  pSrcA     points to the first input sequence.
+   * @param[in]  srcALen   length of the first input sequence.
+   * @param[in]  pSrcB     points to the second input sequence.
+   * @param[in]  srcBLen   length of the second input sequence.
+   * @param[out] pDst      points to the block of output data  Length srcALen+srcBLen-1.
+   * @param[in]  pScratch  points to scratch buffer of size 4 * arm_conv_fft_len_q31(srcALen, srcBLen).
+   */
+  void arm_conv_fft_q31(
+  q31_t * pSrcA,
+  uint32_t srcALen,
+  q31_t * pSrcB,
+  uint32_t srcBLen,
+  q31_t * pDst,
+  q31_t * pScratch);
+
+
   /**
    * @brief Partial convolution of floating-point sequences.
    * @param[in]  pSrcA       points to the first input sequence.
@@ -3717,6 +3974,242 @@ void arm_rfft_fast_f32(
   float64_t * pState);
 
 
+  /**
+   * @brief Instance structure for the floating-point multi-channel transposed direct form II Biquad cascade filter.
+   */
+  typedef struct
+  {
+    uint8_t numStages;         /**< number of 2nd order stages in the filter.  Overall order is 2*numStages. */
+    uint16_t numChannels;      /**< number of interleaved channels. */
+    float32_t *pState;         /**< points to the array of state coefficients.  The array is of length 2*numStages*numChannels. */
+    float32_t *pCoeffs;        /**< points to the array of coefficients.  The array is of length 5*numStages. */
+  } arm_biquad_cascade_multi_df2T_instance_f32;
+
+  /**
+   * @brief Instance structure for the Q31 multi-channel direct form I Biquad cascade filter.
+   */
+  typedef struct
+  {
+    uint8_t numStages;         /**< number of 2nd order stages in the filter.  Overall order is 2*numStages. */
+    uint16_t numChannels;      /**< number of interleaved channels. */
+    q31_t *pState;             /**< points to the array of state coefficients.  The array is of length 4*numStages*numChannels. */
+    q31_t *pCoeffs;            /**< points to the array of coefficients.  The array is of length 5*numStages. */
+    uint8_t postShift;         /**< additional shift, in bits, applied to each output sample. */
+  } arm_biquad_cascade_multi_df1_instance_q31;
+
+
+  /**
+   * @brief Processing function for the floating-point transposed direct form II Biquad cascade filter. N interleaved channels
+   * @param[in]  S          points to an instance of the filter data structure.
+   * @param[in]  pSrc       points to the block of interleaved input data.
+   * @param[out] pDst       points to the block of interleaved output data.
+   * @param[in]  blockSize  number of frames to process.
+   */
+  void arm_biquad_cascade_multi_df2T_f32(
+  const arm_biquad_cascade_multi_df2T_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the floating-point multi-channel transposed direct form II Biquad cascade filter.
+   * @param[in,out] S            points to an instance of the filter data structure.
+   * @param[in]     numStages    number of 2nd order stages in the filter.
+   * @param[in]     numChannels  number of interleaved channels.
+   * @param[in]     pCoeffs      points to the filter coefficients.
+   * @param[in]     pState       points to the state buffer.
+   */
+  void arm_biquad_cascade_multi_df2T_init_f32(
+  arm_biquad_cascade_multi_df2T_instance_f32 * S,
+  uint8_t numStages,
+  uint16_t numChannels,
+  float32_t * pCoeffs,
+  float32_t * pState);
+
+
+  /**
+   * @brief Processing function for the Q31 direct form I Biquad cascade filter. N interleaved channels
+   * @param[in]  S          points to an instance of the filter data structure.
+   * @param[in]  pSrc       points to the block of interleaved input data.
+   * @param[out] pDst       points to the block of interleaved output data.
+   * @param[in]  blockSize  number of frames to process.
+   */
+  void arm_biquad_cascade_multi_df1_q31(
+  const arm_biquad_cascade_multi_df1_instance_q31 * S,
+  q31_t * pSrc,
+  q31_t * pDst,
+  uint32_t blockSize);
+
+
+  /**
+   * @brief  Initialization function for the Q31 multi-channel direct form I Biquad cascade filter.
+   * @param[in,out] S            points to an instance of the filter data structure.
+   * @param[in]     numStages    number of 2nd order stages in the filter.
+   * @param[in]     numChannels  number of interleaved channels.
+   * @param[in]     pCoeffs      points to the filter coefficients.
+   * @param[in]     pState       points to the state buffer.
+   * @param[in]     postShift    shift to be applied to the output.
+   */
+  void arm_biquad_cascade_multi_df1_init_q31(
+  arm_biquad_cascade_multi_df1_instance_q31 * S,
+  uint8_t numStages,
+  uint16_t numChannels,
+  q31_t * pCoeffs,
+  q31_t * pState,
+  int8_t postShift);
+
+
+  /**
+   * @brief Response types of the filter design functions.
+   */
+  typedef enum
+  {
+    ARM_FILTER_LOWPASS = 0,              /**< low-pass */
+    ARM_FILTER_HIGHPASS = 1,             /**< high-pass */
+    ARM_FILTER_BANDPASS = 2,             /**< band-pass, 0 dB at the center frequency */
+    ARM_FILTER_BANDSTOP = 3,             /**< band-stop (notch) */
+    ARM_FILTER_ALLPASS = 4,              /**< all-pass */
+    ARM_FILTER_PEAKING = 5,              /**< peaking equalizer */
+    ARM_FILTER_LOWSHELF = 6,             /**< low shelf */
+    ARM_FILTER_HIGHSHELF = 7             /**< high shelf */
+  } arm_filter_type;
+
+  /**
+   * @brief Windows of the windowed-sinc FIR design.
+   */
+  typedef enum
+  {
+    ARM_WINDOW_RECTANGULAR = 0,          /**< no window */
+    ARM_WINDOW_HANN = 1,                 /**< Hann window */
+    ARM_WINDOW_HAMMING = 2,              /**< Hamming window */
+    ARM_WINDOW_BLACKMAN = 3,             /**< Blackman window */
+    ARM_WINDOW_KAISER = 4                /**< Kaiser window of parameter beta */
+  } arm_window_type;
+
+
+  /**
+   * @brief  Designs one Biquad section from the RBJ audio EQ cookbook.
+   * @param[in]  type      response type.
+   * @param[in]  freq      cutoff or center frequency, as a fraction of the sample rate, in (0, 0.5).
+   * @param[in]  q         quality factor, greater than 0.
+   * @param[in]  gainDb    gain in dB of the peaking and shelf types.
+   * @param[out] pCoeffs   points to the 5 coefficients {b0, b1, b2, a1, a2}.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if an argument is out of range.
+   */
+  arm_status arm_biquad_design_rbj_f32(
+  arm_filter_type type,
+  float32_t freq,
+  float32_t q,
+  float32_t gainDb,
+  float32_t * pCoeffs);
+
+
+  /**
+   * @brief  Designs a Butterworth low-pass or high-pass Biquad cascade.
+   * @param[in]  type      ARM_FILTER_LOWPASS or ARM_FILTER_HIGHPASS.
+   * @param[in]  order     filter order, 1 to 255.  The cascade has (order+1)/2 stages.
+   * @param[in]  freq      -3 dB frequency, as a fraction of the sample rate, in (0, 0.5).
+   * @param[out] pCoeffs   points to the 5*((order+1)/2) coefficients.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if an argument is out of range.
+   */
+  arm_status arm_biquad_design_butterworth_f32(
+  arm_filter_type type,
+  uint8_t order,
+  float32_t freq,
+  float32_t * pCoeffs);
+
+
+  /**
+   * @brief  Designs a Chebyshev type I low-pass or high-pass Biquad cascade.
+   * @param[in]  type      ARM_FILTER_LOWPASS or ARM_FILTER_HIGHPASS.
+   * @param[in]  order     filter order, 1 to 255.  The cascade has (order+1)/2 stages.
+   * @param[in]  freq      passband edge, as a fraction of the sample rate, in (0, 0.5).
+   * @param[in]  rippleDb  passband ripple in dB, greater than 0.
+   * @param[out] pCoeffs   points to the 5*((order+1)/2) coefficients.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if an argument is out of range.
+   */
+  arm_status arm_biquad_design_chebyshev1_f32(
+  arm_filter_type type,
+  uint8_t order,
+  float32_t freq,
+  float32_t rippleDb,
+  float32_t * pCoeffs);
+
+
+  /**
+   * @brief  Converts designed Biquad coefficients to the layout of the Q31 Biquad cascades.
+   * @param[in]  pSrc        points to the 5*numStages floating-point coefficients.
+   * @param[in]  numStages   number of 2nd order stages.
+   * @param[out] pDst        points to the 5*numStages Q31 coefficients.
+   * @param[out] pPostShift  points to the postShift of the init function.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if a coefficient needs a postShift above 15.
+   */
+  arm_status arm_biquad_design_to_q31(
+  const float32_t * pSrc,
+  uint8_t numStages,
+  q31_t * pDst,
+  int8_t * pPostShift);
+
+
+  /**
+   * @brief  Converts designed Biquad coefficients to the layout of the Q15 Biquad cascades.
+   * @param[in]  pSrc        points to the 5*numStages floating-point coefficients.
+   * @param[in]  numStages   number of 2nd order stages.
+   * @param[out] pDst        points to the 6*numStages Q15 coefficients.
+   * @param[out] pPostShift  points to the postShift of the init function.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if a coefficient needs a postShift above 15.
+   */
+  arm_status arm_biquad_design_to_q15(
+  const float32_t * pSrc,
+  uint8_t numStages,
+  q15_t * pDst,
+  int8_t * pPostShift);
+
+
+  /**
+   * @brief  Designs a linear-phase FIR filter by the window method.
+   * @param[in]  type      ARM_FILTER_LOWPASS, ARM_FILTER_HIGHPASS, ARM_FILTER_BANDPASS or ARM_FILTER_BANDSTOP.
+   * @param[in]  numTaps   number of coefficients.  Odd for the high-pass and band-stop types.
+   * @param[in]  freq1     cutoff frequency, or lower band edge, as a fraction of the sample rate.
+   * @param[in]  freq2     upper band edge of the band-pass and band-stop types.
+   * @param[in]  window    window type.
+   * @param[in]  beta      parameter of the Kaiser window.
+   * @param[out] pCoeffs   points to the numTaps coefficients, in the order of arm_fir_init_f32().
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR if an argument is out of range.
+   */
+  arm_status arm_fir_design_window_f32(
+  arm_filter_type type,
+  uint16_t numTaps,
+  float32_t freq1,
+  float32_t freq2,
+  arm_window_type window,
+  float32_t beta,
+  float32_t * pCoeffs);
+
+
+  /**
+   * @brief  Designs an equiripple linear-phase FIR filter by the Parks-McClellan algorithm.
+   * @param[in]  numTaps   number of coefficients, odd, 3 to 255.
+   * @param[in]  numBands  number of bands.
+   * @param[in]  pBands    points to the 2*numBands band edges, as fractions of the sample rate, increasing in [0, 0.5].
+   * @param[in]  pDesired  points to the numBands desired gains.
+   * @param[in]  pWeights  points to the numBands error weights.
+   * @param[out] pCoeffs   points to the numTaps coefficients, in the order of arm_fir_init_f32().
+   * @param[in]  pScratch  points to a scratch buffer of 42*(numTaps+1) + 11*numBands + 5 values.
+   * @return ARM_MATH_SUCCESS, ARM_MATH_ARGUMENT_ERROR if an argument is out of range, or
+   * ARM_MATH_TEST_FAILURE if the exchange did not converge.
+   */
+  arm_status arm_fir_design_remez_f32(
+  uint16_t numTaps,
+  uint16_t numBands,
+  const float32_t * pBands,
+  const float32_t * pDesired,
+  const float32_t * pWeights,
+  float32_t * pCoeffs,
+  float64_t * pScratch);
+
+
   /**
    * @brief Instance structure for the Q15 FIR lattice filter.
    */
@@ -4388,6 +4881,42 @@ void arm_rfft_fast_f32(
   q31_t * pDst);
 
 
+  /**
+   * @brief Correlation of floating-point sequences, by overlap-save FFT for long sequences.
+   * @param[in]  pSrcA     points to the first input sequence.
+   * @param[in]  srcALen   length of the first input sequence.
+   * @param[in]  pSrcB     points to the second input sequence.
+   * @param[in]  srcBLen   length of the second input sequence.
+   * @param[out] pDst      points to the block of output data  Length 2 * max(srcALen, srcBLen) - 1.
+   * @param[in]  pScratch  points to scratch buffer of size 3 * arm_conv_fft_len_f32(srcALen, srcBLen).
+   */
+  void arm_correlate_fft_f32(
+  float32_t * pSrcA,
+  uint32_t srcALen,
+  float32_t * pSrcB,
+  uint32_t srcBLen,
+  float32_t * pDst,
+  float32_t * pScratch);
+
+
+  /**
+   * @brief Correlation of Q31 sequences, by overlap-save FFT for long sequences.
+   * @param[in]  pSrcA     points to the first input sequence.
+   * @param[in]  srcALen   length of the first input sequence.
+   * @param[in]  pSrcB     points to the second input sequence.
+   * @param[in]  srcBLen   length of the second input sequence.
+   * @param[out] pDst      points to the block of output data  Length 2 * max(srcALen, srcBLen) - 1.
+   * @param[in]  pScratch  points to scratch buffer of size 4 * arm_conv_fft_len_q31(srcALen, srcBLen).
+   */
+  void arm_correlate_fft_q31(
+  q31_t * pSrcA,
+  uint32_t srcALen,
+  q31_t * pSrcB,
+  uint32_t srcBLen,
+  q31_t * pDst,
+  q31_t * pScratch);
+
+
  /**
    * @brief Correlation of Q7 sequences.
    * @param[in]  pSrcA      points to the first input sequence.
@@ -4943,6 +5472,145 @@ void arm_rfft_fast_f32(
   const arm_matrix_instance_f64 * src,
   arm_matrix_instance_f64 * dst);
 
+  /**
+   * @brief Instance structure for the floating-point LU factorization.
+   */
+  typedef struct
+  {
+    uint16_t numRows;                    /**< order of the matrix. */
+    float32_t *pData;                    /**< points to the factors, numRows*numRows values: L below the diagonal, U on and above it. */
+    uint16_t *pPivots;                   /**< points to the row interchanges, numRows values. */
+  } arm_mat_lu_instance_f32;
+
+  /**
+   * @brief Instance structure for the floating-point Cholesky factorization.
+   */
+  typedef struct
+  {
+    uint16_t numRows;                    /**< order of the matrix. */
+    float32_t *pData;                    /**< points to the lower triangular factor, numRows*numRows values. */
+  } arm_mat_cholesky_instance_f32;
+
+  /**
+   * @brief Instance structure for the floating-point QR factorization.
+   */
+  typedef struct
+  {
+    uint16_t numRows;                    /**< number of rows of the matrix. */
+    uint16_t numCols;                    /**< number of columns of the matrix, at most numRows. */
+    float32_t *pData;                    /**< points to the factors, numRows*numCols values: R on and above the diagonal, the reflections below it. */
+    float32_t *pTau;                     /**< points to the scales of the reflections, numCols values. */
+  } arm_mat_qr_instance_f32;
+
+  /**
+   * @brief  Initialization function for the floating-point LU factorization.
+   * @param[in,out] S        points to an instance of the floating-point LU structure.
+   * @param[in]     numRows  order of the matrix.
+   * @param[in]     pData    points to the buffer of the factors, numRows*numRows values.
+   * @param[in]     pPivots  points to the buffer of the row interchanges, numRows values.
+   */
+  void arm_mat_lu_init_f32(
+  arm_mat_lu_instance_f32 * S,
+  uint16_t numRows,
+  float32_t * pData,
+  uint16_t * pPivots);
+
+  /**
+   * @brief  Floating-point LU factorization with partial pivoting.
+   * @param[in,out] S     points to an instance of the floating-point LU structure.
+   * @param[in]     pSrc  points to the square matrix to factor; may share the buffer of the factors.
+   * @return ARM_MATH_SUCCESS, ARM_MATH_SIZE_MISMATCH if the dimensions do not match, or ARM_MATH_SINGULAR.
+   */
+  arm_status arm_mat_lu_f32(
+  arm_mat_lu_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc);
+
+  /**
+   * @brief  Solves A * X = B from the LU factors of A.
+   * @param[in]  S     points to an instance of the floating-point LU structure.
+   * @param[in]  pSrc  points to the right-hand sides B, one column per system.
+   * @param[out] pDst  points to the solutions X, of the size of B; may be B.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_SIZE_MISMATCH if the dimensions do not match.
+   */
+  arm_status arm_mat_lu_solve_f32(
+  const arm_mat_lu_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc,
+  arm_matrix_instance_f32 * pDst);
+
+  /**
+   * @brief  Initialization function for the floating-point Cholesky factorization.
+   * @param[in,out] S        points to an instance of the floating-point Cholesky structure.
+   * @param[in]     numRows  order of the matrix.
+   * @param[in]     pData    points to the buffer of the factor, numRows*numRows values.
+   */
+  void arm_mat_cholesky_init_f32(
+  arm_mat_cholesky_instance_f32 * S,
+  uint16_t numRows,
+  float32_t * pData);
+
+  /**
+   * @brief  Floating-point Cholesky factorization of a symmetric positive definite matrix.
+   * @param[in,out] S     points to an instance of the floating-point Cholesky structure.
+   * @param[in]     pSrc  points to the matrix to factor; may share the buffer of the factor.
+   * @return ARM_MATH_SUCCESS, ARM_MATH_SIZE_MISMATCH if the dimensions do not match, or
+   * ARM_MATH_SINGULAR if the matrix is not positive definite.
+   */
+  arm_status arm_mat_cholesky_f32(
+  arm_mat_cholesky_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc);
+
+  /**
+   * @brief  Solves A * X = B from the Cholesky factor of A.
+   * @param[in]  S     points to an instance of the floating-point Cholesky structure.
+   * @param[in]  pSrc  points to the right-hand sides B, one column per system.
+   * @param[out] pDst  points to the solutions X, of the size of B; may be B.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_SIZE_MISMATCH if the dimensions do not match.
+   */
+  arm_status arm_mat_cholesky_solve_f32(
+  const arm_mat_cholesky_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc,
+  arm_matrix_instance_f32 * pDst);
+
+  /**
+   * @brief  Initialization function for the floating-point QR factorization.
+   * @param[in,out] S        points to an instance of the floating-point QR structure.
+   * @param[in]     numRows  number of rows of the matrix.
+   * @param[in]     numCols  number of columns of the matrix, at most numRows.
+   * @param[in]     pData    points to the buffer of the factors, numRows*numCols values.
+   * @param[in]     pTau     points to the buffer of the scales of the reflections, numCols values.
+   */
+  void arm_mat_qr_init_f32(
+  arm_mat_qr_instance_f32 * S,
+  uint16_t numRows,
+  uint16_t numCols,
+  float32_t * pData,
+  float32_t * pTau);
+
+  /**
+   * @brief  Floating-point QR factorization by Householder reflections.
+   * @param[in,out] S     points to an instance of the floating-point QR structure.
+   * @param[in]     pSrc  points to the matrix to factor; may share the buffer of the factors.
+   * @return ARM_MATH_SUCCESS, ARM_MATH_SIZE_MISMATCH if the dimensions do not match, or
+   * ARM_MATH_SINGULAR if the columns are linearly dependent.
+   */
+  arm_status arm_mat_qr_f32(
+  arm_mat_qr_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc);
+
+  /**
+   * @brief  Least-squares solution of A * X = B from the QR factors of A.
+   * @param[in]  S         points to an instance of the floating-point QR structure.
+   * @param[in]  pSrc      points to the right-hand sides B, numRows rows, one column per system.
+   * @param[out] pDst      points to the solutions X, numCols rows and the columns of B; may be B.
+   * @param[in]  pScratch  points to a scratch buffer of numRows values.
+   * @return ARM_MATH_SUCCESS, or ARM_MATH_SIZE_MISMATCH if the dimensions do not match.
+   */
+  arm_status arm_mat_qr_solve_f32(
+  const arm_mat_qr_instance_f32 * S,
+  const arm_matrix_instance_f32 * pSrc,
+  arm_matrix_instance_f32 * pDst,
+  float32_t * pScratch);
+
 
 
   /**
@@ -5703,6 +6371,74 @@ void arm_rfft_fast_f32(
   q15_t arm_cos_q15(
   q15_t x);
 
+  /**
+   * @brief  Fast approximation to the sine of a block of floating-point values.
+   * @param[in]  pSrc       points to the input values in radians
+   * @param[out] pDst       points to the sines; may be pSrc
+   * @param[in]  blockSize  number of values
+   */
+  void arm_sin_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Fast approximation to the cosine of a block of floating-point values.
+   * @param[in]  pSrc       points to the input values in radians
+   * @param[out] pDst       points to the cosines; may be pSrc
+   * @param[in]  blockSize  number of values
+   */
+  void arm_cos_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Square root of a block of floating-point values, 0 for the negative ones.
+   * @param[in]  pSrc       points to the input values
+   * @param[out] pDst       points to the square roots; may be pSrc
+   * @param[in]  blockSize  number of values
+   */
+  void arm_sqrt_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Natural exponential of a block of floating-point values.
+   * @param[in]  pSrc       points to the input values
+   * @param[out] pDst       points to the exponentials; may be pSrc
+   * @param[in]  blockSize  number of values
+   */
+  void arm_exp_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Natural logarithm of a block of floating-point values.
+   * @param[in]  pSrc       points to the input values
+   * @param[out] pDst       points to the logarithms; may be pSrc
+   * @param[in]  blockSize  number of values
+   */
+  void arm_log_block_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Four-quadrant arctangent of a block of floating-point coordinates.
+   * @param[in]  pSrcY      points to the ordinates
+   * @param[in]  pSrcX      points to the abscissas
+   * @param[out] pDst       points to the angles in radians, in [-pi, pi]; may be pSrcY or pSrcX
+   * @param[in]  blockSize  number of points
+   */
+  void arm_atan2_block_f32(
+  const float32_t * pSrcY,
+  const float32_t * pSrcX,
+  float32_t * pDst,
+  uint32_t blockSize);
+
 
   /**
    * @ingroup groupFastMath
@@ -5859,12 +6595,13 @@ void arm_rfft_fast_f32(
   uint32_t blockSize)
   {
     uint32_t i = 0u;
-    int32_t rOffset, dst_end;
+    int32_t rOffset;
+    int32_t *dst_end;
 
     /* Copy the value of Index pointer that points
      * to the current location from where the input samples to be read */
     rOffset = *readOffset;
-    dst_end = (int32_t) (dst_base + dst_length);
+    dst_end = dst_base + dst_length;
 
     /* Loop over the blockSize */
     i = blockSize;
@@ -5877,7 +6614,7 @@ void arm_rfft_fast_f32(
       /* Update the input pointer */
       dst += dstInc;
 
-      if(dst == (int32_t *) dst_end)
+      if(dst == dst_end)
       {
         dst = dst_base;
       }
@@ -5958,13 +6695,14 @@ void arm_rfft_fast_f32(
   uint32_t blockSize)
   {
     uint32_t i = 0;
-    int32_t rOffset, dst_end;
+    int32_t rOffset;
+    q15_t *dst_end;
 
     /* Copy the value of Index pointer that points
      * to the current location from where the input samples to be read */
     rOffset = *readOffset;
 
-    dst_end = (int32_t) (dst_base + dst_length);
+    dst_end = dst_base + dst_length;
 
     /* Loop over the blockSize */
     i = blockSize;
@@ -5977,7 +6715,7 @@ void arm_rfft_fast_f32(
       /* Update the input pointer */
       dst += dstInc;
 
-      if(dst == (q15_t *) dst_end)
+      if(dst == dst_end)
       {
         dst = dst_base;
       }
@@ -6058,13 +6796,14 @@ void arm_rfft_fast_f32(
   uint32_t blockSize)
   {
     uint32_t i = 0;
-    int32_t rOffset, dst_end;
+    int32_t rOffset;
+    q7_t *dst_end;
 
     /* Copy the value of Index pointer that points
      * to the current location from where the input samples to be read */
     rOffset = *readOffset;
 
-    dst_end = (int32_t) (dst_base + dst_length);
+    dst_end = dst_base + dst_length;
 
     /* Loop over the blockSize */
     i = blockSize;
@@ -6077,7 +6816,7 @@ void arm_rfft_fast_f32(
       /* Update the input pointer */
       dst += dstInc;
 
-      if(dst == (q7_t *) dst_end)
+      if(dst == dst_end)
       {
         dst = dst_base;
       }
@@ -6540,6 +7279,360 @@ void arm_rfft_fast_f32(
   float32_t * pResult,
   uint32_t * pIndex);
 
+  /**
+   * @brief Samples of a block of the fused floating-point statistics, read once from memory and once from the cache.
+   */
+#define ARM_STATS_BLOCK 64u
+
+  /**
+   * @brief Results of the fused floating-point statistics.
+   */
+  typedef struct
+  {
+    float32_t mean;                      /**< mean of the samples. */
+    float32_t var;                       /**< sample variance, as arm_var_f32() computes it. */
+    float32_t std;                       /**< standard deviation. */
+    float32_t rms;                       /**< root mean square. */
+    float32_t min;                       /**< minimum. */
+    float32_t max;                       /**< maximum. */
+    uint32_t minIndex;                   /**< index of the first minimum. */
+    uint32_t maxIndex;                   /**< index of the first maximum. */
+  } arm_stats_result_f32;
+
+  /**
+   * @brief Results of the fused Q31 statistics.
+   */
+  typedef struct
+  {
+    q31_t mean;                          /**< mean, as arm_mean_q31() computes it. */
+    q31_t var;                           /**< variance, as arm_var_q31() computes it. */
+    q31_t std;                           /**< standard deviation, as arm_std_q31() computes it. */
+    q31_t rms;                           /**< root mean square, as arm_rms_q31() computes it. */
+    q31_t min;                           /**< minimum. */
+    q31_t max;                           /**< maximum. */
+    uint32_t minIndex;                   /**< index of the first minimum. */
+    uint32_t maxIndex;                   /**< index of the first maximum. */
+  } arm_stats_result_q31;
+
+  /**
+   * @brief Instance structure for the floating-point running statistics.
+   */
+  typedef struct
+  {
+    uint32_t count;                      /**< number of samples merged since the initialization. */
+    float32_t mean;                      /**< mean of the samples. */
+    float32_t m2;                        /**< sum of the squared deviations from the mean. */
+    float32_t meanSq;                    /**< mean of the squares of the samples. */
+    float32_t min;                       /**< minimum. */
+    float32_t max;                       /**< maximum. */
+    uint32_t minIndex;                   /**< index of the first minimum, counted from the initialization. */
+    uint32_t maxIndex;                   /**< index of the first maximum, counted from the initialization. */
+  } arm_stats_instance_f32;
+
+  /**
+   * @brief  Mean, variance, standard deviation, RMS, minimum and maximum of a floating-point vector in one pass.
+   * @param[in]  pSrc       points to the input vector
+   * @param[in]  blockSize  length of the input vector, at least 1
+   * @param[out] pResult    statistics returned here
+   */
+  void arm_stats_f32(
+  const float32_t * pSrc,
+  uint32_t blockSize,
+  arm_stats_result_f32 * pResult);
+
+  /**
+   * @brief  Mean, variance, standard deviation, RMS, minimum and maximum of a Q31 vector in one pass.
+   * @param[in]  pSrc       points to the input vector
+   * @param[in]  blockSize  length of the input vector, at least 1
+   * @param[out] pResult    statistics returned here
+   */
+  void arm_stats_q31(
+  const q31_t * pSrc,
+  uint32_t blockSize,
+  arm_stats_result_q31 * pResult);
+
+  /**
+   * @brief  Initialization function for the floating-point running statistics.
+   * @param[out] S  points to an instance of the floating-point statistics structure.
+   */
+  void arm_stats_init_f32(
+  arm_stats_instance_f32 * S);
+
+  /**
+   * @brief  Merges a block of samples into the floating-point running statistics.
+   * @param[in,out] S          points to an instance of the floating-point statistics structure.
+   * @param[in]     pSrc       points to the block of samples.
+   * @param[in]     blockSize  number of samples in the block.
+   */
+  void arm_stats_update_f32(
+  arm_stats_instance_f32 * S,
+  const float32_t * pSrc,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Reads the floating-point running statistics.
+   * @param[in]  S        points to an instance of the floating-point statistics structure.
+   * @param[out] pResult  statistics of the samples merged since the initialization returned here
+   */
+  void arm_stats_get_f32(
+  const arm_stats_instance_f32 * S,
+  arm_stats_result_f32 * pResult);
+
+  /**
+   * @brief Largest partition that the floating-point introsort finishes by insertion sort.
+   */
+#define ARM_SORT_INSERTION 16u
+
+  /**
+   * @brief  Ascending sort of a floating-point vector by introsort.
+   * @param[in]  pSrc       points to the input vector
+   * @param[out] pDst       points to the sorted vector; may be pSrc
+   * @param[in]  blockSize  length of the vectors
+   */
+  void arm_sort_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Ascending sort of a floating-point vector by a bitonic sorting network.
+   * @param[in]  pSrc       points to the input vector
+   * @param[out] pDst       points to the sorted vector; may be pSrc
+   * @param[in]  blockSize  length of the vectors
+   */
+  void arm_sort_bitonic_f32(
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Ascending sort of a Q31 vector by radix sort.
+   * @param[in]  pSrc       points to the input vector
+   * @param[out] pDst       points to the sorted vector; may be pSrc
+   * @param[in]  pScratch   points to a scratch buffer of blockSize values
+   * @param[in]  blockSize  length of the vectors
+   */
+  void arm_sort_q31(
+  const q31_t * pSrc,
+  q31_t * pDst,
+  q31_t * pScratch,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Ascending sort of a Q15 vector by radix sort.
+   * @param[in]  pSrc       points to the input vector
+   * @param[out] pDst       points to the sorted vector; may be pSrc
+   * @param[in]  pScratch   points to a scratch buffer of blockSize values
+   * @param[in]  blockSize  length of the vectors
+   */
+  void arm_sort_q15(
+  const q15_t * pSrc,
+  q15_t * pDst,
+  q15_t * pScratch,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Ascending sort of a Q7 vector by counting sort.
+   * @param[in]  pSrc       points to the input vector
+   * @param[out] pDst       points to the sorted vector; may be pSrc
+   * @param[in]  blockSize  length of the vectors
+   */
+  void arm_sort_q7(
+  const q7_t * pSrc,
+  q7_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Median of a floating-point vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered in place
+   * @param[in]     blockSize  length of the input vector, at least 1
+   * @param[out]    pResult    median value returned here
+   */
+  void arm_median_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t * pResult);
+
+  /**
+   * @brief  Median of a Q31 vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered in place
+   * @param[in]     blockSize  length of the input vector, at least 1
+   * @param[out]    pResult    median value returned here
+   */
+  void arm_median_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  q31_t * pResult);
+
+  /**
+   * @brief  Median of a Q15 vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered in place
+   * @param[in]     blockSize  length of the input vector, at least 1
+   * @param[out]    pResult    median value returned here
+   */
+  void arm_median_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  q15_t * pResult);
+
+  /**
+   * @brief  Percentile of a floating-point vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered in place
+   * @param[in]     blockSize  length of the input vector, at least 1
+   * @param[in]     p          fraction of the samples below the result, in [0, 1]
+   * @param[out]    pResult    percentile returned here
+   */
+  void arm_percentile_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t p,
+  float32_t * pResult);
+
+  /**
+   * @brief  Percentile of a Q31 vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered in place
+   * @param[in]     blockSize  length of the input vector, at least 1
+   * @param[in]     p          fraction of the samples below the result, in [0, 1)
+   * @param[out]    pResult    percentile returned here
+   */
+  void arm_percentile_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  q31_t p,
+  q31_t * pResult);
+
+  /**
+   * @brief  Percentile of a Q15 vector, by quickselect.
+   * @param[in,out] pSrc       points to the input vector, reordered in place
+   * @param[in]     blockSize  length of the input vector, at least 1
+   * @param[in]     p          fraction of the samples below the result, in [0, 1)
+   * @param[out]    pResult    percentile returned here
+   */
+  void arm_percentile_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  q15_t p,
+  q15_t * pResult);
+
+  /**
+   * @brief Instance structure for the floating-point running median filter.
+   */
+  typedef struct
+  {
+    uint16_t windowSize;                 /**< number of samples of the window. */
+    uint16_t pos;                        /**< position of the oldest sample in the window. */
+    float32_t *pState;                   /**< points to the window in arrival order, then sorted, 2*windowSize values. */
+  } arm_median_filter_instance_f32;
+
+  /**
+   * @brief Instance structure for the Q15 running median filter.
+   */
+  typedef struct
+  {
+    uint16_t windowSize;                 /**< number of samples of the window. */
+    uint16_t pos;                        /**< position of the oldest sample in the window. */
+    q15_t *pState;                       /**< points to the window in arrival order, then sorted, 2*windowSize values. */
+  } arm_median_filter_instance_q15;
+
+  /**
+   * @brief  Initialization function for the floating-point running median filter.
+   * @param[in,out] S           points to an instance of the floating-point running median structure.
+   * @param[in]     windowSize  number of samples of the window, at least 1.
+   * @param[in]     pState      points to the state buffer, 2*windowSize values.
+   */
+  void arm_median_filter_init_f32(
+  arm_median_filter_instance_f32 * S,
+  uint16_t windowSize,
+  float32_t * pState);
+
+  /**
+   * @brief  Running median of a floating-point signal.
+   * @param[in,out] S          points to an instance of the floating-point running median structure.
+   * @param[in]     pSrc       points to the block of input samples.
+   * @param[out]    pDst       points to the block of output samples; may be pSrc.
+   * @param[in]     blockSize  number of samples to process.
+   */
+  void arm_median_filter_f32(
+  arm_median_filter_instance_f32 * S,
+  const float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Initialization function for the Q15 running median filter.
+   * @param[in,out] S           points to an instance of the Q15 running median structure.
+   * @param[in]     windowSize  number of samples of the window, at least 1.
+   * @param[in]     pState      points to the state buffer, 2*windowSize values.
+   */
+  void arm_median_filter_init_q15(
+  arm_median_filter_instance_q15 * S,
+  uint16_t windowSize,
+  q15_t * pState);
+
+  /**
+   * @brief  Running median of a Q15 signal.
+   * @param[in,out] S          points to an instance of the Q15 running median structure.
+   * @param[in]     pSrc       points to the block of input samples.
+   * @param[out]    pDst       points to the block of output samples; may be pSrc.
+   * @param[in]     blockSize  number of samples to process.
+   */
+  void arm_median_filter_q15(
+  arm_median_filter_instance_q15 * S,
+  const q15_t * pSrc,
+  q15_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Histogram of a floating-point vector over bins of equal width.
+   * @param[in]     pSrc       points to the input vector
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     minVal     lower edge of the first bin
+   * @param[in]     maxVal     upper edge of the last bin, above minVal
+   * @param[in]     numBins    number of bins, at least 1
+   * @param[in,out] pHist      points to the counts of the bins, incremented
+   */
+  void arm_histogram_f32(
+  const float32_t * pSrc,
+  uint32_t blockSize,
+  float32_t minVal,
+  float32_t maxVal,
+  uint32_t numBins,
+  uint32_t * pHist);
+
+  /**
+   * @brief  Histogram of a Q15 vector over bins of equal width.
+   * @param[in]     pSrc       points to the input vector
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     minVal     lowest value of the first bin
+   * @param[in]     maxVal     highest value of the last bin, not below minVal
+   * @param[in]     numBins    number of bins, from 1 to maxVal - minVal + 1
+   * @param[in,out] pHist      points to the counts of the bins, incremented
+   */
+  void arm_histogram_q15(
+  const q15_t * pSrc,
+  uint32_t blockSize,
+  q15_t minVal,
+  q15_t maxVal,
+  uint32_t numBins,
+  uint32_t * pHist);
+
+  /**
+   * @brief  Histogram of a Q7 vector over bins of equal width.
+   * @param[in]     pSrc       points to the input vector
+   * @param[in]     blockSize  length of the input vector
+   * @param[in]     minVal     lowest value of the first bin
+   * @param[in]     maxVal     highest value of the last bin, not below minVal
+   * @param[in]     numBins    number of bins, from 1 to maxVal - minVal + 1
+   * @param[in,out] pHist      points to the counts of the bins, incremented
+   */
+  void arm_histogram_q7(
+  const q7_t * pSrc,
+  uint32_t blockSize,
+  q7_t minVal,
+  q7_t maxVal,
+  uint32_t numBins,
+  uint32_t * pHist);
+
 
   /**
    * @brief  Q15 complex-by-complex multiplication
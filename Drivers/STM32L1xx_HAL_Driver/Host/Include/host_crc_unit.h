@@ -0,0 +1,22 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        host_crc_unit.h
+*
+* Description:  Forced include of crc_stream.c in the host build: the
+*               CPU accesses to the CRC unit go to the model of
+*               Source/host_hal.c, as the DMA transfers to its data
+*               register do.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#ifndef _HOST_CRC_UNIT_H
+#define _HOST_CRC_UNIT_H
+
+#include "host_hal.h"
+
+#define CRCS_UNIT_RESET(__HANDLE__)              host_crc_reset((__HANDLE__)->Instance)
+#define CRCS_UNIT_WRITE(__HANDLE__, __WORD__)    host_crc_write((__HANDLE__)->Instance, (__WORD__))
+#define CRCS_UNIT_READ(__HANDLE__)               ((__HANDLE__)->Instance->DR)
+
+#endif /* _HOST_CRC_UNIT_H */
@@ -0,0 +1,105 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        host_hal.h
+*
+* Description:  Host stand-ins of the HAL services, memories and
+*               peripherals used by the drivers under check: tick, clock
+*               and interrupt controls, data EEPROM kept in a file mapped
+*               at its target address, with power failures injected
+*               during programming, DMA controller and CRC unit.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#ifndef _HOST_HAL_H
+#define _HOST_HAL_H
+
+#include <setjmp.h>
+
+#include "stm32l1xx_hal.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/* ----------------------------------------------------------------------
+*       Tick
+* -------------------------------------------------------------------- */
+
+/* Every HAL_GetTick() call moves the time on by 1 ms, so that the
+ * timeout loops of the drivers end */
+void     host_set_tick(uint32_t tick);
+
+/* Power failure: longjmp() target of an injected power cut */
+extern jmp_buf host_power_fail;
+
+/* ----------------------------------------------------------------------
+*       Clocks and interrupts
+* -------------------------------------------------------------------- */
+
+/* Maps zeroed registers at RCC_BASE, for the clock enable macros of the
+ * drivers; the NVIC functions do nothing */
+int      host_rcc_map(void);
+
+/* ----------------------------------------------------------------------
+*       Data EEPROM
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief Data EEPROM counters, since host_eeprom_open().
+ */
+typedef struct
+{
+  uint32_t programs;              /**< words programmed or erased */
+  uint32_t unlocks;               /**< HAL_FLASHEx_DATAEEPROM_Unlock() calls */
+  uint32_t lockedWrites;          /**< writes attempted while locked, refused */
+} host_eeprom_stats_t;
+
+int      host_eeprom_open(const char *path);
+void     host_eeprom_close(void);
+void     host_eeprom_fill(uint8_t value);
+void     host_eeprom_power_cut(uint32_t programs, int torn);
+void     host_eeprom_power_on(void);
+void     host_eeprom_stats(host_eeprom_stats_t *pStats);
+
+/* ----------------------------------------------------------------------
+*       DMA
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief Peripheral register model written by the DMA: receives every
+ *        item transferred to its address, in place of a memory write.
+ */
+typedef void (*host_sink_t)(void *ctx, uint32_t data);
+
+/**
+ * @brief DMA counters, since host_dma_reset().
+ */
+typedef struct
+{
+  uint32_t transfers;             /**< transfers started */
+  uint32_t items;                 /**< items moved */
+} host_dma_stats_t;
+
+void     host_dma_reset(void);
+void     host_dma_sink(uint32_t address, host_sink_t sink, void *ctx);
+void     host_dma_error(uint32_t transfers);
+void     host_dma_stats(host_dma_stats_t *pStats);
+
+/* ----------------------------------------------------------------------
+*       CRC unit
+* -------------------------------------------------------------------- */
+
+/* The CRC unit model keeps its register in the DR field of the
+ * CRC_TypeDef given as Instance, which must be a static object */
+void     host_crc_init(CRC_TypeDef *pUnit);
+void     host_crc_reset(CRC_TypeDef *pUnit);
+void     host_crc_write(CRC_TypeDef *pUnit, uint32_t data);
+uint32_t host_crc_writes(void);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _HOST_HAL_H */
@@ -0,0 +1,48 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        host_suites.h
+*
+* Description:  Check suites of the host build, one per driver.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#ifndef _HOST_SUITES_H
+#define _HOST_SUITES_H
+
+#include "host_util.h"
+#include "host_hal.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Suite of one driver.
+ */
+typedef struct
+{
+  const char *name;               /**< driver name */
+  void (*check)(void);            /**< checks the driver against its model */
+} host_suite_t;
+
+void check_kv(void);
+void check_crc(void);
+void check_cmac(void);
+void check_aes(void);
+
+/**
+ * @brief All the suites, in the order they run.
+ */
+#define HOST_SUITES                                              \
+  { "kv",         check_kv         },                            \
+  { "crc",        check_crc        },                            \
+  { "cmac",       check_cmac       },                            \
+  { "aes",        check_aes        }
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _HOST_SUITES_H */
@@ -0,0 +1,41 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        host_util.h
+*
+* Description:  Helpers shared by the host checks: test data and result
+*               reporting.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#ifndef _HOST_UTIL_H
+#define _HOST_UTIL_H
+
+#include <stdint.h>
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+void     host_seed(uint32_t seed);
+uint32_t host_random(void);
+uint32_t host_below(uint32_t n);
+void     host_bytes(uint8_t *pDst, uint32_t n);
+
+/* ----------------------------------------------------------------------
+*       Reporting
+* -------------------------------------------------------------------- */
+void     host_set_filter(const char *pattern);
+int      host_selected(const char *name);
+int      host_check_equal(const char *name, uint32_t size, uint32_t mismatches);
+void     host_check_summary(uint32_t *pPassed, uint32_t *pFailed);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _HOST_UTIL_H */
@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    stm32l1xx_hal.h
+  * @brief   Host replacement of the HAL top header, for the host checks of
+  *          the drivers built on the HAL.
+  *
+  *          It selects the HAL modules the checked drivers use, with the
+  *          configuration values of stm32l1xx_hal_conf.h, and declares the
+  *          HAL services that Source/host_hal.c provides in place of the
+  *          target ones.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32L1xx_HAL_H
+#define __STM32L1xx_HAL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* ########################## Module Selection ############################## */
+#define HAL_MODULE_ENABLED
+#define HAL_CORTEX_MODULE_ENABLED
+#define HAL_CRC_MODULE_ENABLED
+#define HAL_CRYP_MODULE_ENABLED
+#define HAL_DMA_MODULE_ENABLED
+#define HAL_FLASH_MODULE_ENABLED
+#define HAL_GPIO_MODULE_ENABLED
+#define HAL_I2C_MODULE_ENABLED
+#define HAL_NOR_MODULE_ENABLED
+#define HAL_PWR_MODULE_ENABLED
+#define HAL_RCC_MODULE_ENABLED
+#define HAL_SD_MODULE_ENABLED
+#define HAL_SPI_MODULE_ENABLED
+#define HAL_SRAM_MODULE_ENABLED
+#define HAL_UART_MODULE_ENABLED
+
+/* ########################## Oscillator Values adaptation ####################*/
+#define HSE_VALUE                     (8000000U)
+#define HSE_STARTUP_TIMEOUT           (100U)
+#define MSI_VALUE                     (2097000U)
+#define HSI_VALUE                     (16000000U)
+#define LSE_VALUE                     (32768U)
+#define LSE_STARTUP_TIMEOUT           (5000U)
+
+/* ########################### System Configuration ######################### */
+#define  VDD_VALUE                    (3300U)
+#define  TICK_INT_PRIORITY            (0x000FU)
+#define  USE_RTOS                     0U
+#define  PREFETCH_ENABLE              1U
+#define  INSTRUCTION_CACHE_ENABLE     0U
+#define  DATA_CACHE_ENABLE            0U
+
+#define assert_param(expr) ((void)0U)
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx_hal_def.h"
+#include "stm32l1xx_hal_rcc.h"
+#include "stm32l1xx_hal_gpio.h"
+#include "stm32l1xx_hal_dma.h"
+#include "stm32l1xx_hal_cortex.h"
+#include "stm32l1xx_hal_crc.h"
+#include "stm32l1xx_hal_cryp.h"
+#include "stm32l1xx_hal_flash.h"
+#include "stm32l1xx_hal_sram.h"
+#include "stm32l1xx_hal_nor.h"
+#include "stm32l1xx_hal_i2c.h"
+#include "stm32l1xx_hal_spi.h"
+#include "stm32l1xx_hal_sd.h"
+#include "stm32l1xx_hal_pwr.h"
+#include "stm32l1xx_hal_uart.h"
+
+/* Exported functions --------------------------------------------------------*/
+void     HAL_IncTick(void);
+void     HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetTick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32L1xx_HAL_H */
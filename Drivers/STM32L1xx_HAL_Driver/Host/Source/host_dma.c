@@ -0,0 +1,285 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        host_dma.c
+*
+* Description:  DMA controller of the host checks. A transfer runs when
+*               it starts, item by item with the increments and data
+*               sizes of the channel configuration; items written to the
+*               address of a registered sink go to its register model
+*               instead of memory.
+*
+*               A transfer started with interrupts stays busy until the
+*               check calls the interrupt handler of the driver, which
+*               then sees its end, or the transfer error armed with
+*               host_dma_error().
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <string.h>
+
+#include "host_hal.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+#define HOST_DMA_SINKS          8u
+
+static struct
+{
+  uint32_t address;
+  host_sink_t sink;
+  void *ctx;
+} hostSinks[HOST_DMA_SINKS];
+
+static uint32_t hostSinkCount = 0u;
+static host_dma_stats_t hostDmaStats;
+static uint32_t hostErrorArmed = 0u;
+static uint32_t hostErrorAfter = 0u;      /* transfers left before the error */
+static DMA_HandleTypeDef *hostErrorHandle = NULL;
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Forgets the sinks and clears the counters.
+ */
+void host_dma_reset(void)
+{
+  hostSinkCount = 0u;
+  hostErrorArmed = 0u;
+  hostErrorHandle = NULL;
+  memset(&hostDmaStats, 0, sizeof(hostDmaStats));
+}
+
+/**
+ * @brief  Arms a transfer error on a transfer started with interrupts.
+ * @param  transfers  transfers with interrupts that complete before the
+ *                    one that fails; that one moves no item
+ */
+void host_dma_error(uint32_t transfers)
+{
+  hostErrorArmed = 1u;
+  hostErrorAfter = transfers;
+}
+
+/**
+ * @brief  Registers the register model written at a peripheral address.
+ */
+void host_dma_sink(uint32_t address, host_sink_t sink, void *ctx)
+{
+  if (hostSinkCount < HOST_DMA_SINKS)
+  {
+    hostSinks[hostSinkCount].address = address;
+    hostSinks[hostSinkCount].sink = sink;
+    hostSinks[hostSinkCount].ctx = ctx;
+    hostSinkCount++;
+  }
+}
+
+void host_dma_stats(host_dma_stats_t *pStats)
+{
+  *pStats = hostDmaStats;
+}
+
+static uint32_t host_dma_read(uint32_t address, uint32_t size)
+{
+  const volatile void *p = (const volatile void *)(uintptr_t)address;
+
+  return (size == 4u) ? *(const volatile uint32_t *)p :
+         (size == 2u) ? *(const volatile uint16_t *)p : *(const volatile uint8_t *)p;
+}
+
+static void host_dma_write(uint32_t address, uint32_t data, uint32_t size)
+{
+  volatile void *p = (volatile void *)(uintptr_t)address;
+  uint32_t s;
+
+  for (s = 0u; s < hostSinkCount; s++)
+  {
+    if (hostSinks[s].address == address)
+    {
+      hostSinks[s].sink(hostSinks[s].ctx, data);
+      return;
+    }
+  }
+
+  if (size == 4u)
+  {
+    *(volatile uint32_t *)p = data;
+  }
+  else if (size == 2u)
+  {
+    *(volatile uint16_t *)p = (uint16_t)data;
+  }
+  else
+  {
+    *(volatile uint8_t *)p = (uint8_t)data;
+  }
+}
+
+/**
+ * @brief  Moves the items of a transfer. As on the controller, the
+ *         peripheral side is the source unless the direction is memory
+ *         to peripheral, an item read wider than it is written is
+ *         truncated, and the count is the 16 bits CNDTR keeps.
+ */
+static void host_dma_transfer(DMA_HandleTypeDef *hdma, uint32_t src, uint32_t dst, uint32_t count)
+{
+  const DMA_InitTypeDef *init = &hdma->Init;
+  uint32_t periphSize, memSize, srcSize, dstSize, srcInc, dstInc;
+
+  periphSize = (init->PeriphDataAlignment == DMA_PDATAALIGN_WORD) ? 4u :
+               (init->PeriphDataAlignment == DMA_PDATAALIGN_HALFWORD) ? 2u : 1u;
+  memSize    = (init->MemDataAlignment == DMA_MDATAALIGN_WORD) ? 4u :
+               (init->MemDataAlignment == DMA_MDATAALIGN_HALFWORD) ? 2u : 1u;
+
+  if (init->Direction == DMA_MEMORY_TO_PERIPH)
+  {
+    srcSize = memSize;
+    dstSize = periphSize;
+    srcInc  = (init->MemInc == DMA_MINC_ENABLE) ? memSize : 0u;
+    dstInc  = (init->PeriphInc == DMA_PINC_ENABLE) ? periphSize : 0u;
+  }
+  else
+  {
+    srcSize = periphSize;
+    dstSize = memSize;
+    srcInc  = (init->PeriphInc == DMA_PINC_ENABLE) ? periphSize : 0u;
+    dstInc  = (init->MemInc == DMA_MINC_ENABLE) ? memSize : 0u;
+  }
+
+  count &= 0xFFFFu;
+  hostDmaStats.transfers++;
+  hostDmaStats.items += count;
+  while (count-- > 0u)
+  {
+    host_dma_write(dst, host_dma_read(src, srcSize), dstSize);
+    src += srcInc;
+    dst += dstInc;
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       HAL stand-ins
+* -------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+  if (hdma == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  hdma->Lock = HAL_UNLOCKED;
+  hdma->ErrorCode = HAL_DMA_ERROR_NONE;
+  hdma->State = HAL_DMA_STATE_READY;
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength)
+{
+  if (hdma->State != HAL_DMA_STATE_READY)
+  {
+    return HAL_BUSY;
+  }
+
+  hdma->State = HAL_DMA_STATE_BUSY;
+  hdma->ErrorCode = HAL_DMA_ERROR_NONE;
+  host_dma_transfer(hdma, SrcAddress, DstAddress, DataLength);
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *hdma)
+{
+  if (hdma == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  hdma->ErrorCode = HAL_DMA_ERROR_NONE;
+  hdma->State = HAL_DMA_STATE_RESET;
+  hdma->Lock = HAL_UNLOCKED;
+
+  return HAL_OK;
+}
+
+/**
+ * @brief  The items move at once; the end, or the armed error, is only
+ *         seen by HAL_DMA_IRQHandler().
+ */
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength)
+{
+  if (hdma->State != HAL_DMA_STATE_READY)
+  {
+    return HAL_BUSY;
+  }
+
+  hdma->State = HAL_DMA_STATE_BUSY;
+  hdma->ErrorCode = HAL_DMA_ERROR_NONE;
+  if (hostErrorArmed && (hostErrorAfter-- == 0u))
+  {
+    hostErrorArmed = 0u;
+    hostErrorHandle = hdma;
+    return HAL_OK;
+  }
+  host_dma_transfer(hdma, SrcAddress, DstAddress, DataLength);
+
+  return HAL_OK;
+}
+
+/**
+ * @brief  Interrupt of a busy channel: end of its transfer, or error.
+ */
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+  if (hdma->State != HAL_DMA_STATE_BUSY)
+  {
+    return;
+  }
+
+  hdma->State = HAL_DMA_STATE_READY;
+  if (hostErrorHandle == hdma)
+  {
+    hostErrorHandle = NULL;
+    hdma->ErrorCode = HAL_DMA_ERROR_TE;
+    if (hdma->XferErrorCallback != NULL)
+    {
+      hdma->XferErrorCallback(hdma);
+    }
+  }
+  else if (hdma->XferCpltCallback != NULL)
+  {
+    hdma->XferCpltCallback(hdma);
+  }
+}
+
+/**
+ * @brief  The transfer is over by the time it is polled.
+ */
+HAL_StatusTypeDef HAL_DMA_PollForTransfer(DMA_HandleTypeDef *hdma, uint32_t CompleteLevel, uint32_t Timeout)
+{
+  if (hdma->State != HAL_DMA_STATE_BUSY)
+  {
+    hdma->ErrorCode = HAL_DMA_ERROR_NO_XFER;
+    return HAL_ERROR;
+  }
+
+  hdma->State = HAL_DMA_STATE_READY;
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma)
+{
+  if (hostErrorHandle == hdma)
+  {
+    hostErrorHandle = NULL;
+  }
+  hdma->State = HAL_DMA_STATE_READY;
+
+  return HAL_OK;
+}
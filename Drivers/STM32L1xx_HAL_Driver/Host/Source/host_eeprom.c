@@ -0,0 +1,212 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        host_eeprom.c
+*
+* Description:  Data EEPROM of the host checks: a file mapped read-only
+*               at FLASH_EEPROM_BASE, so that the drivers read it at its
+*               target addresses, and programmed through the
+*               HAL_FLASHEx_DATAEEPROM functions only.
+*
+*               A power cut armed with host_eeprom_power_cut() stops the
+*               program operation it falls on, optionally after writing
+*               half of its word, relocks the memory and jumps to
+*               host_power_fail: the file then holds what a target would
+*               find after the reset.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "host_hal.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+#define HOST_EEPROM_SIZE        (FLASH_EEPROM_END - FLASH_EEPROM_BASE + 1U)
+
+static int hostEepromFile = -1;
+static int hostEepromLocked = 1;
+static uint32_t hostCutArmed = 0u;
+static uint32_t hostCutAfter = 0u;        /* operations left before the cut */
+static int hostCutTorn = 0;
+static host_eeprom_stats_t hostEepromStats;
+
+/* ----------------------------------------------------------------------
+*       Memory
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Maps the data EEPROM file at FLASH_EEPROM_BASE, creating it
+ *         erased when it does not exist, and clears the counters.
+ * @return 0, or -1 when the file or the mapping cannot be set up
+ */
+int host_eeprom_open(const char *path)
+{
+  void *map;
+
+  hostEepromFile = open(path, O_RDWR | O_CREAT, 0644);
+  if ((hostEepromFile < 0) || (ftruncate(hostEepromFile, HOST_EEPROM_SIZE) != 0))
+  {
+    return -1;
+  }
+
+  map = mmap((void *)(uintptr_t)FLASH_EEPROM_BASE, HOST_EEPROM_SIZE, PROT_READ,
+             MAP_SHARED | MAP_FIXED_NOREPLACE, hostEepromFile, 0);
+  if (map != (void *)(uintptr_t)FLASH_EEPROM_BASE)
+  {
+    close(hostEepromFile);
+    hostEepromFile = -1;
+    return -1;
+  }
+
+  hostEepromLocked = 1;
+  hostCutArmed = 0u;
+  memset(&hostEepromStats, 0, sizeof(hostEepromStats));
+
+  return 0;
+}
+
+/**
+ * @brief  Unmaps the data EEPROM; its content stays in the file.
+ */
+void host_eeprom_close(void)
+{
+  munmap((void *)(uintptr_t)FLASH_EEPROM_BASE, HOST_EEPROM_SIZE);
+  close(hostEepromFile);
+  hostEepromFile = -1;
+}
+
+/**
+ * @brief  Sets every byte of the data EEPROM, as another firmware could
+ *         have left it.
+ */
+void host_eeprom_fill(uint8_t value)
+{
+  uint8_t page[256];
+  uint32_t offset;
+
+  memset(page, value, sizeof(page));
+  for (offset = 0u; offset < HOST_EEPROM_SIZE; offset += sizeof(page))
+  {
+    if (pwrite(hostEepromFile, page, sizeof(page), offset) != (ssize_t)sizeof(page))
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief  Arms a power cut on a program or erase operation.
+ * @param  programs  operations that complete before the cut
+ * @param  torn      nonzero to write the low half of the interrupted word
+ */
+void host_eeprom_power_cut(uint32_t programs, int torn)
+{
+  hostCutArmed = 1u;
+  hostCutAfter = programs;
+  hostCutTorn = torn;
+}
+
+/**
+ * @brief  Disarms the power cut.
+ */
+void host_eeprom_power_on(void)
+{
+  hostCutArmed = 0u;
+}
+
+void host_eeprom_stats(host_eeprom_stats_t *pStats)
+{
+  *pStats = hostEepromStats;
+}
+
+/**
+ * @brief  Writes size bytes of data at a data EEPROM address, or stops
+ *         there when the armed power cut falls on this operation.
+ */
+static HAL_StatusTypeDef host_eeprom_write(uint32_t address, uint32_t data, uint32_t size)
+{
+  uint8_t bytes[4];
+
+  if (hostEepromLocked)
+  {
+    hostEepromStats.lockedWrites++;
+    return HAL_ERROR;
+  }
+  if ((address < FLASH_EEPROM_BASE) || ((address + size - 1u) > FLASH_EEPROM_END) || ((address % size) != 0u))
+  {
+    return HAL_ERROR;
+  }
+
+  bytes[0] = (uint8_t)data;
+  bytes[1] = (uint8_t)(data >> 8);
+  bytes[2] = (uint8_t)(data >> 16);
+  bytes[3] = (uint8_t)(data >> 24);
+
+  if (hostCutArmed && (hostCutAfter-- == 0u))
+  {
+    hostCutArmed = 0u;
+    if (hostCutTorn && (size > 1u))
+    {
+      (void)pwrite(hostEepromFile, bytes, size / 2u, address - FLASH_EEPROM_BASE);
+    }
+    hostEepromLocked = 1;
+    longjmp(host_power_fail, 1);
+  }
+
+  if (pwrite(hostEepromFile, bytes, size, address - FLASH_EEPROM_BASE) != (ssize_t)size)
+  {
+    return HAL_ERROR;
+  }
+  hostEepromStats.programs++;
+
+  return HAL_OK;
+}
+
+/* ----------------------------------------------------------------------
+*       HAL stand-ins
+* -------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_FLASHEx_DATAEEPROM_Unlock(void)
+{
+  hostEepromLocked = 0;
+  hostEepromStats.unlocks++;
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_DATAEEPROM_Lock(void)
+{
+  hostEepromLocked = 1;
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_DATAEEPROM_Erase(uint32_t TypeErase, uint32_t Address)
+{
+  return host_eeprom_write(Address, 0u, 1u << TypeErase);
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_DATAEEPROM_Program(uint32_t TypeProgram, uint32_t Address, uint32_t Data)
+{
+  switch (TypeProgram)
+  {
+    case FLASH_TYPEPROGRAMDATA_BYTE:
+    case FLASH_TYPEPROGRAMDATA_FASTBYTE:
+      return host_eeprom_write(Address, Data, 1u);
+    case FLASH_TYPEPROGRAMDATA_HALFWORD:
+    case FLASH_TYPEPROGRAMDATA_FASTHALFWORD:
+      return host_eeprom_write(Address, Data, 2u);
+    case FLASH_TYPEPROGRAMDATA_WORD:
+    case FLASH_TYPEPROGRAMDATA_FASTWORD:
+      return host_eeprom_write(Address, Data, 4u);
+    default:
+      return HAL_ERROR;
+  }
+}
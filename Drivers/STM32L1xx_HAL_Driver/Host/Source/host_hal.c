@@ -0,0 +1,146 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        host_hal.c
+*
+* Description:  Host stand-ins of the HAL core services, and model of
+*               the CRC unit.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <sys/mman.h>
+
+#include "host_hal.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+static uint32_t hostTick = 0u;
+static uint32_t hostRccMapped = 0u;
+
+jmp_buf host_power_fail;
+
+/* ----------------------------------------------------------------------
+*       Tick
+* -------------------------------------------------------------------- */
+
+void host_set_tick(uint32_t tick)
+{
+  hostTick = tick;
+}
+
+void HAL_IncTick(void)
+{
+  hostTick++;
+}
+
+/**
+ * @brief  Time in ms. Nothing else moves the time on the host: every
+ *         reading advances it, as a polling loop would see it advance.
+ */
+uint32_t HAL_GetTick(void)
+{
+  return hostTick++;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+  hostTick += Delay + 1u;
+}
+
+/* ----------------------------------------------------------------------
+*       Clocks and interrupts
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Maps the page of the RCC registers at its target address,
+ *         once, so that the __HAL_RCC_xxx_CLK_ENABLE() macros of the
+ *         drivers set their bits in memory.
+ * @return 0, or -1 when the page cannot be mapped
+ */
+int host_rcc_map(void)
+{
+  uintptr_t page = (uintptr_t)RCC_BASE & ~(uintptr_t)0xFFFu;
+
+  if (!hostRccMapped)
+  {
+    if (mmap((void *)page, 0x1000u, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+             -1, 0) != (void *)page)
+    {
+      return -1;
+    }
+    hostRccMapped = 1u;
+  }
+
+  return 0;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+}
+
+/* ----------------------------------------------------------------------
+*       CRC unit
+* -------------------------------------------------------------------- */
+static uint32_t hostCrcWrites = 0u;
+
+/**
+ * @brief  Data register write of the DMA: one word through the unit.
+ */
+static void host_crc_sink(void *ctx, uint32_t data)
+{
+  host_crc_write((CRC_TypeDef *)ctx, data);
+}
+
+/**
+ * @brief  Resets the unit and routes the DMA transfers to its data
+ *         register through the model.
+ */
+void host_crc_init(CRC_TypeDef *pUnit)
+{
+  host_crc_reset(pUnit);
+  host_dma_sink((uint32_t)(uintptr_t)&pUnit->DR, host_crc_sink, pUnit);
+  hostCrcWrites = 0u;
+}
+
+/**
+ * @brief  CR.RESET: the register takes its initial value.
+ */
+void host_crc_reset(CRC_TypeDef *pUnit)
+{
+  pUnit->DR = 0xFFFFFFFFu;
+}
+
+/**
+ * @brief  Write of a word to the data register: the word is added to the
+ *         register, which is then shifted 32 times, most significant bit
+ *         first, by the CRC-32 polynomial.
+ */
+void host_crc_write(CRC_TypeDef *pUnit, uint32_t data)
+{
+  uint32_t crc = pUnit->DR ^ data, bit;
+
+  for (bit = 0u; bit < 32u; bit++)
+  {
+    crc = ((crc & 0x80000000u) != 0u) ? ((crc << 1) ^ 0x04C11DB7u) : (crc << 1);
+  }
+  pUnit->DR = crc;
+  hostCrcWrites++;
+}
+
+/**
+ * @brief  Words written to the unit by the CPU or the DMA since
+ *         host_crc_init().
+ */
+uint32_t host_crc_writes(void)
+{
+  return hostCrcWrites;
+}
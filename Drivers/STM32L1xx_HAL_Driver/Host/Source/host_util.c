@@ -0,0 +1,114 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        host_util.c
+*
+* Description:  Helpers shared by the host checks: test data and result
+*               reporting.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_util.h"
+
+/* ----------------------------------------------------------------------
+*       Private data
+* -------------------------------------------------------------------- */
+static uint32_t hostRandom = 0x12345678u;
+static const char *hostFilter = NULL;
+static uint32_t hostPassed = 0u;
+static uint32_t hostFailed = 0u;
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Restarts the test data generator, so that every suite sees the
+ *         same data whatever ran before.
+ */
+void host_seed(uint32_t seed)
+{
+  hostRandom = (seed != 0u) ? seed : 0x12345678u;
+}
+
+/**
+ * @brief  Uniform random word (xorshift32).
+ */
+uint32_t host_random(void)
+{
+  hostRandom ^= hostRandom << 13;
+  hostRandom ^= hostRandom >> 17;
+  hostRandom ^= hostRandom << 5;
+
+  return hostRandom;
+}
+
+/**
+ * @brief  Uniform random value in [0, n), n > 0.
+ */
+uint32_t host_below(uint32_t n)
+{
+  return (uint32_t)(((uint64_t)host_random() * n) >> 32);
+}
+
+/**
+ * @brief  Fills a buffer with random bytes.
+ */
+void host_bytes(uint8_t *pDst, uint32_t n)
+{
+  uint32_t i;
+
+  for (i = 0u; i < n; i++)
+  {
+    pDst[i] = (uint8_t)(host_random() >> 24);
+  }
+}
+
+/* ----------------------------------------------------------------------
+*       Reporting
+* -------------------------------------------------------------------- */
+
+void host_set_filter(const char *pattern)
+{
+  hostFilter = pattern;
+}
+
+int host_selected(const char *name)
+{
+  return (hostFilter == NULL) || (strstr(name, hostFilter) != NULL);
+}
+
+/**
+ * @brief  Reports a result that must match its reference exactly.
+ * @return 0 if there is no mismatch, 1 otherwise
+ */
+int host_check_equal(const char *name, uint32_t size, uint32_t mismatches)
+{
+  int failed = (mismatches != 0u);
+
+  if (!host_selected(name))
+  {
+    return 0;
+  }
+
+  printf("%s %-36s %6u  %u mismatch(es)\n", failed ? "FAIL" : "pass", name, size, mismatches);
+  if (failed)
+  {
+    hostFailed++;
+  }
+  else
+  {
+    hostPassed++;
+  }
+
+  return failed;
+}
+
+void host_check_summary(uint32_t *pPassed, uint32_t *pFailed)
+{
+  *pPassed = hostPassed;
+  *pFailed = hostFailed;
+}
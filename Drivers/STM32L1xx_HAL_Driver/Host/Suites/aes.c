@@ -0,0 +1,388 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        aes.c
+*
+* Description:  Checks of the AES sessions of aes_session.c, in software:
+*               SP 800-38A ECB, CBC and CTR vectors with the message split
+*               at every block boundary, in place and out of place, the
+*               CTR counter wrap and partial tail, new initialization
+*               vectors, and buffer queues with their completion callback.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <string.h>
+
+#include "host_suites.h"
+#include "aes_session.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+#define AES_MESSAGE_SIZE        64u
+#define AES_QUEUE_MAX           8u
+#define AES_QUEUE_BYTES         (AES_QUEUE_MAX * 256u)
+
+/* SP 800-38A, appendix F: AES-128 key, plaintext and initialization vectors */
+static const uint8_t aesKey[16] =
+{
+  0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t aesPlain[AES_MESSAGE_SIZE] =
+{
+  0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+  0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+  0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+  0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+static const uint8_t aesCbcIv[16] =
+{
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const uint8_t aesCtrIv[16] =
+{
+  0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+
+static const struct
+{
+  const char *name;
+  uint32_t mode;
+  const uint8_t *pInitVect;
+  uint8_t cipher[AES_MESSAGE_SIZE];
+} aesVectors[] =
+{
+  /* F.1.1 ECB-AES128 */
+  { "aes/sp800-38a ecb", AESS_MODE_ECB, NULL,
+    { 0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+      0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+      0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88,
+      0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f, 0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4 } },
+  /* F.2.1 CBC-AES128 */
+  { "aes/sp800-38a cbc", AESS_MODE_CBC, aesCbcIv,
+    { 0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+      0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+      0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+      0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7 } },
+  /* F.5.1 CTR-AES128 */
+  { "aes/sp800-38a ctr", AESS_MODE_CTR, aesCtrIv,
+    { 0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+      0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+      0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+      0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee } }
+};
+
+/* One byte more than the data, to run on unaligned buffers too */
+static uint8_t aesInput[AES_QUEUE_BYTES + 1u], aesOutput[AES_QUEUE_BYTES + 1u];
+static uint8_t aesExpected[AES_QUEUE_BYTES];
+
+/* Completion callback record */
+static AESS_HandleTypeDef *aesCpltHandle;
+static uint32_t aesCpltCount, aesCpltIndex;
+
+void AESS_QueueCpltCallback(AESS_HandleTypeDef *haes)
+{
+  aesCpltHandle = haes;
+  aesCpltIndex = haes->QueueIndex;
+  aesCpltCount++;
+}
+
+/* ----------------------------------------------------------------------
+*       Helpers
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Starts a software session.
+ * @return 0, or 1 when AESS_Start() fails
+ */
+static uint32_t aes_start(AESS_HandleTypeDef *haes, const uint8_t *pKey, uint32_t mode, uint32_t direction,
+                          const uint8_t *pInitVect)
+{
+  memset(haes, 0, sizeof(*haes));
+  haes->Init.Mode = mode;
+  haes->Init.Direction = direction;
+  haes->Init.pKey = pKey;
+  haes->Init.pInitVect = pInitVect;
+
+  return (AESS_Start(haes) != HAL_OK) ? 1u : 0u;
+}
+
+/**
+ * @brief  Processes a message in up to three pieces cut at first and
+ *         second, from aesInput + shift to aesOutput + shift, or in place
+ *         in aesInput + shift.
+ * @return pieces AESS_Process() refused
+ */
+static uint32_t aes_pieces(AESS_HandleTypeDef *haes, const uint8_t *pMessage, uint32_t size, uint32_t first,
+                           uint32_t second, uint32_t shift, uint32_t inPlace, uint8_t **ppResult)
+{
+  uint8_t *input = aesInput + shift;
+  uint8_t *output = (inPlace != 0u) ? input : (aesOutput + shift);
+  uint32_t bad = 0u;
+
+  memcpy(input, pMessage, size);
+  bad += (AESS_Process(haes, input, first, output, 10u) != HAL_OK) ? 1u : 0u;
+  bad += (AESS_Process(haes, input + first, second - first, output + first, 10u) != HAL_OK) ? 1u : 0u;
+  bad += (AESS_Process(haes, input + second, size - second, output + second, 10u) != HAL_OK) ? 1u : 0u;
+  *ppResult = output;
+
+  return bad;
+}
+
+/**
+ * @brief  Increments the 32-bit big endian counter of a counter block,
+ *         without carry into the other bytes.
+ */
+static void aes_increment(uint8_t *pCounter)
+{
+  uint32_t i = 16u;
+
+  do
+  {
+    i--;
+    pCounter[i]++;
+  }
+  while ((pCounter[i] == 0u) && (i > 12u));
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  SP 800-38A vectors both ways, the message cut in three pieces at
+ *         every pair of block boundaries, in place and out of place, on
+ *         aligned and unaligned buffers; in CTR mode, every length of the
+ *         message, the last piece ending with a partial block.
+ */
+static void check_vectors(void)
+{
+  AESS_HandleTypeDef haes;
+  const uint8_t *from, *to;
+  uint8_t *result;
+  uint32_t v, direction, first, second, size, variant, runs, bad;
+
+  for (v = 0u; v < (sizeof(aesVectors) / sizeof(aesVectors[0])); v++)
+  {
+    runs = 0u;
+    bad = 0u;
+    for (direction = AESS_ENCRYPT; direction <= AESS_DECRYPT; direction++)
+    {
+      from = (direction == AESS_ENCRYPT) ? aesPlain : aesVectors[v].cipher;
+      to = (direction == AESS_ENCRYPT) ? aesVectors[v].cipher : aesPlain;
+      for (size = (aesVectors[v].mode == AESS_MODE_CTR) ? 1u : AES_MESSAGE_SIZE; size <= AES_MESSAGE_SIZE; size++)
+      {
+        for (first = 0u; first <= size; first += AESS_BLOCK_SIZE)
+        {
+          for (second = first; second <= size; second += AESS_BLOCK_SIZE)
+          {
+            for (variant = 0u; variant < 4u; variant++)
+            {
+              bad += aes_start(&haes, aesKey, aesVectors[v].mode, direction, aesVectors[v].pInitVect);
+              bad += aes_pieces(&haes, from, size, first, second, variant / 2u, variant % 2u, &result);
+              bad += (memcmp(result, to, size) != 0) ? 1u : 0u;
+              bad += (AESS_Stop(&haes) != HAL_OK) ? 1u : 0u;
+              runs++;
+            }
+          }
+        }
+      }
+    }
+    host_check_equal(aesVectors[v].name, runs, bad);
+  }
+}
+
+/**
+ * @brief  The chain carries over between calls until a new initialization
+ *         vector restarts it with the same key.
+ */
+static void check_init_vect(void)
+{
+  AESS_HandleTypeDef haes;
+  uint8_t *result;
+  uint32_t v, bad = 0u;
+
+  for (v = 1u; v < (sizeof(aesVectors) / sizeof(aesVectors[0])); v++)
+  {
+    bad += aes_start(&haes, aesKey, aesVectors[v].mode, AESS_ENCRYPT, aesVectors[v].pInitVect);
+    bad += aes_pieces(&haes, aesPlain, AES_MESSAGE_SIZE, 16u, 32u, 0u, 0u, &result);
+
+    /* Carried over: the same plaintext again gives another ciphertext */
+    bad += aes_pieces(&haes, aesPlain, AES_MESSAGE_SIZE, 16u, 32u, 0u, 0u, &result);
+    bad += (memcmp(result, aesVectors[v].cipher, AES_MESSAGE_SIZE) == 0) ? 1u : 0u;
+
+    bad += (AESS_SetInitVect(&haes, aesVectors[v].pInitVect) != HAL_OK) ? 1u : 0u;
+    bad += aes_pieces(&haes, aesPlain, AES_MESSAGE_SIZE, 48u, 48u, 1u, 1u, &result);
+    bad += (memcmp(result, aesVectors[v].cipher, AES_MESSAGE_SIZE) != 0) ? 1u : 0u;
+    bad += (AESS_Stop(&haes) != HAL_OK) ? 1u : 0u;
+  }
+
+  host_check_equal("aes/set init vect", 2u, bad);
+}
+
+/**
+ * @brief  The CTR counter is the last 32 bits of the counter block, and
+ *         wraps without carry; a partial block takes a whole counter.
+ */
+static void check_ctr_counter(void)
+{
+  AESS_HandleTypeDef haes;
+  uint8_t roundKey[176], key[16], counter[16], start[16], stream[16];
+  uint32_t i, trial, bad = 0u;
+
+  for (trial = 0u; trial < 64u; trial++)
+  {
+    host_bytes(key, sizeof(key));
+    host_bytes(start, sizeof(start));
+    if (trial < 32u)
+    {
+      /* Counters 0xFFFFFFFE, 0xFFFFFFFF, 0, 1... */
+      memset(&start[12], 0xFF, 4u);
+      start[15] = 0xFEu;
+    }
+    host_bytes(aesInput, 100u);
+
+    /* 100 bytes in pieces of 20, 16 and 64: the 4-byte tail of the first
+       piece ends its counter block */
+    bad += aes_start(&haes, key, AESS_MODE_CTR, AESS_ENCRYPT, start);
+    bad += (AESS_Process(&haes, aesInput, 20u, aesOutput, 10u) != HAL_OK) ? 1u : 0u;
+    bad += (AESS_Process(&haes, aesInput + 20u, 16u, aesOutput + 32u, 10u) != HAL_OK) ? 1u : 0u;
+    bad += (AESS_Process(&haes, aesInput + 36u, 64u, aesOutput + 48u, 10u) != HAL_OK) ? 1u : 0u;
+
+    AESS_ExpandKey(key, roundKey);
+    memcpy(counter, start, sizeof(counter));
+    memcpy(aesExpected, aesInput, 20u);
+    memset(aesExpected + 20u, 0, 12u);
+    memcpy(aesExpected + 32u, aesInput + 20u, 80u);
+    for (i = 0u; i < 112u; i++)
+    {
+      if ((i % 16u) == 0u)
+      {
+        AESS_EncryptBlock(roundKey, counter, stream);
+        aes_increment(counter);
+      }
+      aesExpected[i] ^= stream[i % 16u];
+    }
+    bad += (memcmp(aesOutput, aesExpected, 20u) != 0) ? 1u : 0u;
+    bad += (memcmp(aesOutput + 32u, aesExpected + 32u, 80u) != 0) ? 1u : 0u;
+    bad += (memcmp(haes.Chain, counter, sizeof(counter)) != 0) ? 1u : 0u;
+    bad += (AESS_Stop(&haes) != HAL_OK) ? 1u : 0u;
+  }
+
+  host_check_equal("aes/ctr counter", 64u, bad);
+}
+
+/**
+ * @brief  Calls refused by the state or the sizes, and the key material
+ *         wiped by AESS_Stop().
+ */
+static void check_refused(void)
+{
+  static const uint8_t zero[16] = {0};
+  AESS_HandleTypeDef haes;
+  AESS_BufferTypeDef buffer = { aesInput, aesOutput, 24u };
+  uint32_t bad = 0u;
+
+  memset(&haes, 0, sizeof(haes));
+  bad += (AESS_Process(&haes, aesInput, 16u, aesOutput, 10u) != HAL_ERROR) ? 1u : 0u;
+  bad += (AESS_SetInitVect(&haes, aesCbcIv) != HAL_ERROR) ? 1u : 0u;
+
+  haes.Init.Mode = AESS_MODE_CTR + 1u;
+  haes.Init.pKey = aesKey;
+  haes.Init.pInitVect = aesCbcIv;
+  bad += (AESS_Start(&haes) != HAL_ERROR) ? 1u : 0u;
+  haes.Init.Mode = AESS_MODE_CBC;
+  haes.Init.pInitVect = NULL;
+  bad += (AESS_Start(&haes) != HAL_ERROR) ? 1u : 0u;
+
+  bad += aes_start(&haes, aesKey, AESS_MODE_CBC, AESS_ENCRYPT, aesCbcIv);
+  bad += (AESS_Process(&haes, aesInput, 20u, aesOutput, 10u) != HAL_ERROR) ? 1u : 0u;
+  aesCpltCount = 0u;
+  bad += (AESS_Submit(&haes, &buffer, 1u) != HAL_ERROR) ? 1u : 0u;
+  bad += (AESS_Submit(&haes, &buffer, 0u) != HAL_OK) ? 1u : 0u;
+  bad += (aesCpltCount != 0u) ? 1u : 0u;
+
+  bad += (AESS_Stop(&haes) != HAL_OK) ? 1u : 0u;
+  bad += ((haes.State != AESS_STATE_RESET) || (memcmp(haes.Key, zero, 16u) != 0) ||
+          (memcmp(haes.Chain, zero, 16u) != 0) || (memcmp(haes.RoundKey, zero, 16u) != 0)) ? 1u : 0u;
+  bad += (AESS_Process(&haes, aesInput, 16u, aesOutput, 10u) != HAL_ERROR) ? 1u : 0u;
+
+  host_check_equal("aes/refused", 1u, bad);
+}
+
+/**
+ * @brief  Queues of buffers of random sizes, some in place and some
+ *         unaligned, give what one call over their concatenation gives,
+ *         call the completion callback once, and leave the chain where the
+ *         last buffer ends.
+ */
+static void check_queue(void)
+{
+  static const uint32_t modes[3][2] =
+  {
+    { AESS_MODE_CBC, AESS_ENCRYPT }, { AESS_MODE_CBC, AESS_DECRYPT }, { AESS_MODE_CTR, AESS_ENCRYPT }
+  };
+  AESS_HandleTypeDef haes, reference;
+  AESS_BufferTypeDef queue[AES_QUEUE_MAX];
+  uint8_t key[16], iv[16];
+  uint32_t trial, count, i, offset, shift, total, bad = 0u;
+
+  for (trial = 0u; trial < 300u; trial++)
+  {
+    host_bytes(key, sizeof(key));
+    host_bytes(iv, sizeof(iv));
+    host_bytes(aesInput, sizeof(aesInput));
+    memcpy(aesOutput, aesInput, sizeof(aesOutput));
+    count = 1u + host_below(AES_QUEUE_MAX);
+    shift = host_below(2u);
+
+    /* The reference: one call over the concatenation, then one block */
+    total = 0u;
+    for (i = 0u; i < count; i++)
+    {
+      queue[i].Size = AESS_BLOCK_SIZE * host_below(16u);
+      total += queue[i].Size;
+    }
+    bad += aes_start(&reference, key, modes[trial % 3u][0], modes[trial % 3u][1], iv);
+    bad += (AESS_Process(&reference, aesInput + shift, total + AESS_BLOCK_SIZE, aesExpected, 10u) != HAL_OK) ? 1u : 0u;
+
+    offset = shift;
+    for (i = 0u; i < count; i++)
+    {
+      queue[i].pInput = aesInput + offset;
+      queue[i].pOutput = (host_below(2u) != 0u) ? (aesInput + offset) : (aesOutput + offset);
+      offset += queue[i].Size;
+    }
+
+    bad += aes_start(&haes, key, modes[trial % 3u][0], modes[trial % 3u][1], iv);
+    aesCpltCount = 0u;
+    aesCpltHandle = NULL;
+    bad += (AESS_Submit(&haes, queue, count) != HAL_OK) ? 1u : 0u;
+    bad += ((aesCpltCount != 1u) || (aesCpltHandle != &haes) || (aesCpltIndex != count)) ? 1u : 0u;
+    bad += ((AESS_PollForQueue(&haes, 10u) != HAL_OK) || (haes.State != AESS_STATE_READY)) ? 1u : 0u;
+
+    offset = 0u;
+    for (i = 0u; i < count; i++)
+    {
+      bad += (memcmp(queue[i].pOutput, aesExpected + offset, queue[i].Size) != 0) ? 1u : 0u;
+      offset += queue[i].Size;
+    }
+
+    /* The chain goes on from the end of the queue */
+    bad += (AESS_Process(&haes, aesOutput + shift + total, AESS_BLOCK_SIZE, aesOutput + shift + total, 10u) != HAL_OK) ? 1u : 0u;
+    bad += (memcmp(aesOutput + shift + total, aesExpected + total, AESS_BLOCK_SIZE) != 0) ? 1u : 0u;
+    bad += (AESS_Stop(&haes) != HAL_OK) ? 1u : 0u;
+    bad += (AESS_Stop(&reference) != HAL_OK) ? 1u : 0u;
+  }
+
+  host_check_equal("aes/submit queue", 300u, bad);
+}
+
+void check_aes(void)
+{
+  check_vectors();
+  check_init_vect();
+  check_ctr_counter();
+  check_refused();
+  check_queue();
+}
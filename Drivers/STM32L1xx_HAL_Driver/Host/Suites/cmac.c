@@ -0,0 +1,243 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        cmac.c
+*
+* Description:  Checks of the AES-CMAC and of the encrypt-then-MAC
+*               records of aes_cmac.c, on the software AES of
+*               aes_session.c: FIPS-197 and RFC 4493 vectors, messages
+*               split in any pieces, and records rejected after any
+*               alteration.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_suites.h"
+#include "aes_cmac.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+#define CMAC_MAX_RECORD         1000u     /* longest payload of the record checks */
+
+/* RFC 4493, section 4 */
+static const uint8_t cmacKey[16] =
+{
+  0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const uint8_t cmacK1[16] =
+{
+  0xfb, 0xee, 0xd6, 0x18, 0x35, 0x71, 0x33, 0x66, 0x7c, 0x85, 0xe0, 0x8f, 0x72, 0x36, 0xa8, 0xde
+};
+static const uint8_t cmacK2[16] =
+{
+  0xf7, 0xdd, 0xac, 0x30, 0x6a, 0xe2, 0x66, 0xcc, 0xf9, 0x0b, 0xc1, 0x1e, 0xe4, 0x6d, 0x51, 0x3b
+};
+static const uint8_t cmacMessage[64] =
+{
+  0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+  0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+  0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+  0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+static const struct
+{
+  uint32_t length;
+  uint8_t  mac[16];
+} cmacVectors[] =
+{
+  {  0u, { 0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28, 0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46 } },
+  { 16u, { 0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44, 0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c } },
+  { 40u, { 0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30, 0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27 } },
+  { 64u, { 0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92, 0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe } }
+};
+
+static uint8_t cmacPlain[CMAC_MAX_RECORD], cmacOpened[CMAC_MAX_RECORD];
+static uint8_t cmacRecord[CMAC_MAX_RECORD + ETM_OVERHEAD];
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  FIPS-197 appendix C.1: AES-128 block, both ways.
+ */
+static void check_block(void)
+{
+  static const uint8_t key[16] =
+  {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+  };
+  static const uint8_t plain[16] =
+  {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+  static const uint8_t cipher[16] =
+  {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+  };
+  uint8_t roundKey[11u * AESS_BLOCK_SIZE], block[16];
+  uint32_t bad = 0u;
+
+  AESS_ExpandKey(key, roundKey);
+  AESS_EncryptBlock(roundKey, plain, block);
+  bad += (memcmp(block, cipher, 16u) != 0) ? 1u : 0u;
+  AESS_DecryptBlock(roundKey, cipher, block);
+  bad += (memcmp(block, plain, 16u) != 0) ? 1u : 0u;
+  host_check_equal("cmac/aes-128 block", 2u, bad);
+}
+
+/**
+ * @brief  RFC 4493 subkeys and MACs, the message passed whole, cut in
+ *         two at every position, and byte by byte.
+ */
+static void check_vectors(void)
+{
+  CMAC_HandleTypeDef hcmac;
+  uint8_t mac[16];
+  uint32_t v, split, i, count, bad;
+  HAL_StatusTypeDef status;
+
+  memset(&hcmac, 0, sizeof(hcmac));
+  hcmac.Init.pKey = cmacKey;
+  bad = (CMAC_Init(&hcmac) != HAL_OK) ? 1u : 0u;
+  bad += (memcmp(hcmac.K1, cmacK1, 16u) != 0) ? 1u : 0u;
+  bad += (memcmp(hcmac.K2, cmacK2, 16u) != 0) ? 1u : 0u;
+  host_check_equal("cmac/subkeys", 2u, bad);
+
+  for (v = 0u; v < (sizeof(cmacVectors) / sizeof(cmacVectors[0])); v++)
+  {
+    status = CMAC_Start(&hcmac);
+    status |= CMAC_Update(&hcmac, cmacMessage, cmacVectors[v].length);
+    status |= CMAC_Finish(&hcmac, mac);
+    bad = ((status != HAL_OK) || (memcmp(mac, cmacVectors[v].mac, 16u) != 0)) ? 1u : 0u;
+
+    for (split = 0u, count = 1u; split <= cmacVectors[v].length; split++, count++)
+    {
+      status = CMAC_Start(&hcmac);
+      status |= CMAC_Update(&hcmac, cmacMessage, split);
+      status |= CMAC_Update(&hcmac, &cmacMessage[split], cmacVectors[v].length - split);
+      status |= CMAC_Finish(&hcmac, mac);
+      bad += ((status != HAL_OK) || (memcmp(mac, cmacVectors[v].mac, 16u) != 0)) ? 1u : 0u;
+    }
+
+    status = CMAC_Start(&hcmac);
+    for (i = 0u; i < cmacVectors[v].length; i++)
+    {
+      status |= CMAC_Update(&hcmac, &cmacMessage[i], 1u);
+    }
+    status |= CMAC_Finish(&hcmac, mac);
+    bad += ((status != HAL_OK) || (memcmp(mac, cmacVectors[v].mac, 16u) != 0)) ? 1u : 0u;
+
+    host_check_equal((v == 0u) ? "cmac/rfc4493 empty" : (v == 1u) ? "cmac/rfc4493 16" :
+                     (v == 2u) ? "cmac/rfc4493 40" : "cmac/rfc4493 64", count + 1u, bad);
+  }
+
+  /* The key material is wiped */
+  CMAC_DeInit(&hcmac);
+  for (i = 0u, bad = 0u; i < 16u; i++)
+  {
+    bad += ((hcmac.K1[i] | hcmac.K2[i]) != 0u) ? 1u : 0u;
+  }
+  host_check_equal("cmac/deinit", 32u, bad);
+}
+
+/**
+ * @brief  Records of several sizes: the ciphertext is the AES-CTR of the
+ *         payload from the counter block of the header, the record opens
+ *         to its payload, and any altered, truncated or extended record is
+ *         rejected without a byte of payload in the output: cleared, or
+ *         left as it was when the header is malformed.
+ */
+static void check_records(void)
+{
+  static const uint32_t lengths[] = { 0u, 1u, 15u, 16u, 17u, 255u, 256u, 257u, CMAC_MAX_RECORD };
+  static const uint8_t macKey[16] =
+  {
+    0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf
+  };
+  ETM_HandleTypeDef hetm;
+  ETM_HeaderTypeDef header, opened;
+  uint8_t roundKey[11u * AESS_BLOCK_SIZE], counter[16], stream[16];
+  uint32_t l, i, size, block, clear, bad = 0u, rejected = 0u, tampered = 0u;
+
+  memset(&hetm, 0, sizeof(hetm));
+  hetm.Init.pEncKey = cmacKey;
+  hetm.Init.pMacKey = macKey;
+  if (ETM_Init(&hetm) != HAL_OK)
+  {
+    host_check_equal("cmac/etm init", 1u, 1u);
+    return;
+  }
+  AESS_ExpandKey(cmacKey, roundKey);
+
+  for (l = 0u; l < (sizeof(lengths) / sizeof(lengths[0])); l++)
+  {
+    host_bytes(cmacPlain, lengths[l]);
+    header.Type = 0x17u;
+    header.Sequence = 0x01020304u + l;
+    host_bytes(header.Nonce, ETM_NONCE_SIZE);
+    size = lengths[l] + ETM_OVERHEAD;
+
+    bad += (ETM_Seal(&hetm, &header, cmacPlain, lengths[l], cmacRecord) != HAL_OK) ? 1u : 0u;
+
+    /* Counter block: nonce, sequence number, block counter from 1 */
+    memcpy(counter, header.Nonce, 8u);
+    counter[8]  = (uint8_t)(header.Sequence >> 24);
+    counter[9]  = (uint8_t)(header.Sequence >> 16);
+    counter[10] = (uint8_t)(header.Sequence >> 8);
+    counter[11] = (uint8_t)header.Sequence;
+    for (i = 0u, block = 1u; i < lengths[l]; i++)
+    {
+      if ((i % 16u) == 0u)
+      {
+        counter[12] = (uint8_t)(block >> 24);
+        counter[13] = (uint8_t)(block >> 16);
+        counter[14] = (uint8_t)(block >> 8);
+        counter[15] = (uint8_t)block++;
+        AESS_EncryptBlock(roundKey, counter, stream);
+      }
+      bad += (cmacRecord[ETM_HEADER_SIZE + i] != (cmacPlain[i] ^ stream[i % 16u])) ? 1u : 0u;
+    }
+
+    memset(cmacOpened, 0xA5, lengths[l]);
+    bad += ((ETM_Open(&hetm, cmacRecord, size, &opened, cmacOpened) != HAL_OK) ||
+            (memcmp(cmacOpened, cmacPlain, lengths[l]) != 0) || (opened.Type != header.Type) ||
+            (opened.Length != lengths[l]) || (opened.Sequence != header.Sequence) ||
+            (memcmp(opened.Nonce, header.Nonce, ETM_NONCE_SIZE) != 0)) ? 1u : 0u;
+
+    /* Every bit of the header and the tag, and bits across the payload */
+    for (i = 0u; i < (size * 8u); i += ((i / 8u) < ETM_HEADER_SIZE) || ((i / 8u) >= (size - ETM_TAG_SIZE)) ? 1u : 13u)
+    {
+      cmacRecord[i / 8u] ^= (uint8_t)(1u << (i % 8u));
+      memset(cmacOpened, 0xA5, lengths[l]);
+      if (ETM_Open(&hetm, cmacRecord, size, &opened, cmacOpened) != HAL_OK)
+      {
+        for (block = 0u, clear = 1u; block < lengths[l]; block++)
+        {
+          clear &= ((cmacOpened[block] == 0u) || (cmacOpened[block] == 0xA5u)) ? 1u : 0u;
+        }
+        rejected += clear;
+      }
+      tampered++;
+      cmacRecord[i / 8u] ^= (uint8_t)(1u << (i % 8u));
+    }
+
+    /* Truncated and extended records */
+    rejected += (ETM_Open(&hetm, cmacRecord, size - 1u, &opened, cmacOpened) != HAL_OK) ? 1u : 0u;
+    rejected += (ETM_Open(&hetm, cmacRecord, size + 1u, &opened, cmacOpened) != HAL_OK) ? 1u : 0u;
+    tampered += 2u;
+  }
+
+  host_check_equal("cmac/etm seal and open", sizeof(lengths) / sizeof(lengths[0]), bad);
+  host_check_equal("cmac/etm tampering", tampered, tampered - rejected);
+}
+
+void check_cmac(void)
+{
+  check_block();
+  check_vectors();
+  check_records();
+}
@@ -0,0 +1,236 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        crc.c
+*
+* Description:  Checks of the streaming CRC of crc_stream.c, fed by the
+*               CPU and by DMA to the model of the CRC unit, against a
+*               bitwise reference of its CRC definition.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_suites.h"
+#include "crc_stream.h"
+
+/* ----------------------------------------------------------------------
+*       Test data
+* -------------------------------------------------------------------- */
+#define CRC_MAX_LENGTH          1024u     /* longest stream of the random checks */
+#define CRC_STREAMS             4u        /* streams computed at the same time */
+#define CRC_LARGE_WORDS         (CRCS_DMA_MAX_WORDS + 3u)
+
+/* Static, as the DMA addresses are 32-bit */
+static CRC_TypeDef crcUnit;
+static CRC_HandleTypeDef crcHandle;
+static DMA_HandleTypeDef crcDma;
+static uint32_t crcData[CRC_STREAMS][(CRC_MAX_LENGTH / 4u) + 2u];
+static uint32_t crcLarge[CRC_LARGE_WORDS + 1u];
+
+/**
+ * @brief  CRC of the definition: whole little-endian words through the
+ *         unit, then the remaining bytes one at a time, most significant
+ *         bit first.
+ */
+static uint32_t crc_reference(const uint8_t *pData, uint32_t length)
+{
+  uint32_t crc = 0xFFFFFFFFu, word, bits, i = 0u;
+
+  for (; (length - i) >= 4u; i += 4u)
+  {
+    word = (uint32_t)pData[i] | ((uint32_t)pData[i + 1u] << 8) |
+           ((uint32_t)pData[i + 2u] << 16) | ((uint32_t)pData[i + 3u] << 24);
+    for (crc ^= word, bits = 0u; bits < 32u; bits++)
+    {
+      crc = ((crc & 0x80000000u) != 0u) ? ((crc << 1) ^ 0x04C11DB7u) : (crc << 1);
+    }
+  }
+  for (; i < length; i++)
+  {
+    for (crc ^= (uint32_t)pData[i] << 24, bits = 0u; bits < 8u; bits++)
+    {
+      crc = ((crc & 0x80000000u) != 0u) ? ((crc << 1) ^ 0x04C11DB7u) : (crc << 1);
+    }
+  }
+
+  return crc;
+}
+
+/**
+ * @brief  Sets up a stream, fed by the CPU only when dma is 0.
+ */
+static void crc_start(CRCS_HandleTypeDef *hcrcs, int dma, uint32_t threshold)
+{
+  hcrcs->Init.hcrc = &crcHandle;
+  hcrcs->Init.hdma = dma ? &crcDma : NULL;
+  hcrcs->Init.DmaThreshold = threshold;
+  CRCS_Start(hcrcs);
+}
+
+/**
+ * @brief  Streams of random lengths and alignments, passed in random
+ *         pieces, short ones around the word size and longer ones.
+ * @return streams whose CRC differs from the reference
+ */
+static uint32_t crc_pieces(int dma, uint32_t streams)
+{
+  CRCS_HandleTypeDef hcrcs;
+  const uint8_t *data = (const uint8_t *)crcData[0];
+  uint32_t s, offset, length, done, piece, bad = 0u;
+  HAL_StatusTypeDef status;
+
+  for (s = 0u; s < streams; s++)
+  {
+    offset = host_below(4u);
+    length = host_below(CRC_MAX_LENGTH + 1u);
+    host_bytes((uint8_t *)crcData[0], sizeof(crcData[0]));
+
+    crc_start(&hcrcs, dma, 16u);
+    for (done = 0u, status = HAL_OK; done < length; done += piece)
+    {
+      piece = (host_below(2u) != 0u) ? host_below(9u) : host_below(200u);
+      piece = (piece < (length - done)) ? piece : (length - done);
+      status |= CRCS_Update(&hcrcs, &data[offset + done], piece);
+    }
+    bad += ((status != HAL_OK) || (CRCS_Finish(&hcrcs) != crc_reference(&data[offset], length)) ||
+            (hcrcs.Length != length)) ? 1u : 0u;
+  }
+
+  return bad;
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  CRCS_Software() for every length and alignment up to a few
+ *         words, and continued from a CRC over whole words.
+ */
+static void check_software(void)
+{
+  const uint8_t *data = (const uint8_t *)crcData[0];
+  uint32_t offset, length, split, bad = 0u, count = 0u;
+
+  host_bytes((uint8_t *)crcData[0], sizeof(crcData[0]));
+  for (offset = 0u; offset < 4u; offset++)
+  {
+    for (length = 0u; length <= 67u; length++, count++)
+    {
+      bad += (CRCS_Software(CRCS_INIT_VALUE, &data[offset], length) != crc_reference(&data[offset], length)) ? 1u : 0u;
+      for (split = 4u; split <= length; split += 4u)
+      {
+        bad += (CRCS_Software(CRCS_Software(CRCS_INIT_VALUE, &data[offset], split), &data[offset + split], length - split) !=
+                crc_reference(&data[offset], length)) ? 1u : 0u;
+      }
+    }
+  }
+  host_check_equal("crc/software", count, bad);
+}
+
+/**
+ * @brief  Several streams computed at the same time, each piece of one
+ *         reloading its CRC into the shared unit.
+ */
+static void check_interleaved(int dma)
+{
+  CRCS_HandleTypeDef hcrcs[CRC_STREAMS];
+  uint32_t length[CRC_STREAMS], done[CRC_STREAMS];
+  uint32_t trial, s, piece, left, bad = 0u;
+  HAL_StatusTypeDef status = HAL_OK;
+
+  for (trial = 0u; trial < 200u; trial++)
+  {
+    for (s = 0u, left = 0u; s < CRC_STREAMS; s++)
+    {
+      host_bytes((uint8_t *)crcData[s], sizeof(crcData[s]));
+      length[s] = host_below(CRC_MAX_LENGTH + 1u);
+      done[s] = 0u;
+      left += (length[s] != 0u) ? 1u : 0u;
+      crc_start(&hcrcs[s], dma, 32u);
+    }
+
+    while (left > 0u)
+    {
+      s = host_below(CRC_STREAMS);
+      if (done[s] == length[s])
+      {
+        continue;
+      }
+      piece = host_below(64u);
+      piece = (piece < (length[s] - done[s])) ? piece : (length[s] - done[s]);
+      status |= CRCS_Update(&hcrcs[s], (const uint8_t *)crcData[s] + done[s], piece);
+      done[s] += piece;
+      left -= (done[s] == length[s]) ? 1u : 0u;
+    }
+
+    for (s = 0u; s < CRC_STREAMS; s++)
+    {
+      bad += (CRCS_Finish(&hcrcs[s]) != crc_reference((const uint8_t *)crcData[s], length[s])) ? 1u : 0u;
+    }
+  }
+  host_check_equal(dma ? "crc/interleaved dma" : "crc/interleaved", 200u * CRC_STREAMS, bad + (status != HAL_OK));
+}
+
+/**
+ * @brief  Word-aligned runs reach the unit once per word: by DMA from the
+ *         threshold on, over several transfers beyond the largest one,
+ *         and by the CPU below it.
+ */
+static void check_dma(void)
+{
+  CRCS_HandleTypeDef hcrcs;
+  host_dma_stats_t stats;
+  uint32_t writes, bad = 0u;
+
+  host_bytes((uint8_t *)crcLarge, sizeof(crcLarge));
+
+  crc_start(&hcrcs, 1, 64u);
+  writes = host_crc_writes();
+  bad += (CRCS_Update(&hcrcs, crcLarge, 60u) != HAL_OK) ? 1u : 0u;
+  host_dma_stats(&stats);
+  bad += ((stats.transfers != 0u) || ((host_crc_writes() - writes) != 15u)) ? 1u : 0u;
+  bad += (CRCS_Update(&hcrcs, &crcLarge[15], 64u) != HAL_OK) ? 1u : 0u;
+  host_dma_stats(&stats);
+  bad += ((stats.transfers != 1u) || (stats.items != 16u) || ((host_crc_writes() - writes) != 32u)) ? 1u : 0u;
+  bad += (CRCS_Finish(&hcrcs) != crc_reference((const uint8_t *)crcLarge, 124u)) ? 1u : 0u;
+  host_check_equal("crc/dma threshold", 124u, bad);
+
+  bad = 0u;
+  crc_start(&hcrcs, 1, 64u);
+  bad += (CRCS_Update(&hcrcs, crcLarge, (CRC_LARGE_WORDS * 4u) + 3u) != HAL_OK) ? 1u : 0u;
+  host_dma_stats(&stats);
+  bad += ((stats.transfers != 3u) || (stats.items != (16u + CRC_LARGE_WORDS))) ? 1u : 0u;
+  bad += (CRCS_Finish(&hcrcs) != crc_reference((const uint8_t *)crcLarge, (CRC_LARGE_WORDS * 4u) + 3u)) ? 1u : 0u;
+  host_check_equal("crc/dma chunks", (CRC_LARGE_WORDS * 4u) + 3u, bad);
+}
+
+void check_crc(void)
+{
+  crcHandle.Instance = &crcUnit;
+  crcHandle.Lock = HAL_UNLOCKED;
+  crcHandle.State = HAL_CRC_STATE_READY;
+
+  crcDma.Init.Direction = DMA_MEMORY_TO_MEMORY;
+  crcDma.Init.PeriphInc = DMA_PINC_ENABLE;
+  crcDma.Init.MemInc = DMA_MINC_DISABLE;
+  crcDma.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+  crcDma.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+  crcDma.Init.Mode = DMA_NORMAL;
+  HAL_DMA_Init(&crcDma);
+
+  host_dma_reset();
+  host_crc_init(&crcUnit);
+
+  check_software();
+  host_check_equal("crc/pieces", 500u, crc_pieces(0, 500u));
+  host_check_equal("crc/pieces dma", 500u, crc_pieces(1, 500u));
+  check_interleaved(0);
+  check_interleaved(1);
+
+  host_dma_reset();
+  host_crc_init(&crcUnit);
+  check_dma();
+}
@@ -0,0 +1,325 @@
+/* ----------------------------------------------------------------------
+* Project:      STM32L1xx HAL drivers
+* Title:        kv.c
+*
+* Description:  Checks of the key-value store of eeprom_kv.c against a
+*               model of its content, on the file-backed data EEPROM,
+*               across power failures at every program operation.
+*
+* Target Processor: Host (x86-64, AArch64 Linux)
+* -------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host_suites.h"
+#include "eeprom_kv.h"
+
+/* ----------------------------------------------------------------------
+*       Model
+* -------------------------------------------------------------------- */
+#define KV_KEYS                 8u        /* keys used by the checks */
+#define KV_LENGTH               40u       /* longest value of the random updates */
+#define KV_SMALL_SIZE           1024u     /* area of the power cut checks: 2 banks of 512 bytes */
+#define KV_SCRIPT               60u       /* updates under the power cut */
+#define KV_AFTER                60u       /* updates after the restart */
+
+typedef struct
+{
+  uint32_t present;
+  uint32_t length;
+  uint8_t  data[KV_MAX_VALUE_SIZE];
+} kv_value_t;
+
+typedef struct
+{
+  kv_value_t key[KV_KEYS];
+} kv_model_t;
+
+/* Static, as they must survive the longjmp() of a power cut */
+static KV_HandleTypeDef kvHandle;
+static kv_model_t kvModel;                /* content before the update in progress */
+static kv_model_t kvNext;                 /* content after it */
+static uint32_t kvErrors;                 /* updates that returned an error */
+static uint32_t kvBad, kvInterrupted;
+
+/**
+ * @brief  Count of the keys whose value in the store differs from the model.
+ */
+static uint32_t kv_diff(KV_HandleTypeDef *hkv, const kv_model_t *pModel)
+{
+  uint8_t value[KV_MAX_VALUE_SIZE];
+  uint32_t k, length, count = 0u, bad = 0u;
+
+  for (k = 0u; k < KV_KEYS; k++)
+  {
+    if (KV_Get(hkv, (uint16_t)k, value, sizeof(value), &length) != HAL_OK)
+    {
+      bad += pModel->key[k].present ? 1u : 0u;
+      continue;
+    }
+    count++;
+    bad += (!pModel->key[k].present || (length != pModel->key[k].length) ||
+            (memcmp(value, pModel->key[k].data, length) != 0)) ? 1u : 0u;
+  }
+
+  /* No key outside the ones written */
+  return bad + ((hkv->KeyCount != count) ? 1u : 0u);
+}
+
+/**
+ * @brief  Restarts the store from its data EEPROM content, as after a reset.
+ */
+static void kv_mount(uint32_t size)
+{
+  memset(&kvHandle, 0, sizeof(kvHandle));
+  kvHandle.Init.BaseAddress = FLASH_EEPROM_BASE;
+  kvHandle.Init.Size = size;
+  if (KV_Init(&kvHandle) != HAL_OK)
+  {
+    kvErrors++;
+  }
+}
+
+/**
+ * @brief  Erases the data EEPROM and mounts an empty store.
+ */
+static void kv_reset(uint32_t size)
+{
+  host_eeprom_fill(0u);
+  memset(&kvModel, 0, sizeof(kvModel));
+  kv_mount(size);
+}
+
+/**
+ * @brief  One random update, mostly writes, some deletions and forced
+ *         compactions, applied to the store and to the model.
+ */
+static void kv_step(void)
+{
+  uint32_t op = host_below(10u), k = host_below(KV_KEYS);
+  HAL_StatusTypeDef status;
+
+  kvNext = kvModel;
+  if (op < 7u)
+  {
+    kvNext.key[k].present = 1u;
+    kvNext.key[k].length = host_below(KV_LENGTH + 1u);
+    host_bytes(kvNext.key[k].data, kvNext.key[k].length);
+    status = KV_Put(&kvHandle, (uint16_t)k, kvNext.key[k].data, kvNext.key[k].length);
+  }
+  else if (op < 9u)
+  {
+    kvNext.key[k].present = 0u;
+    status = KV_Delete(&kvHandle, (uint16_t)k);
+  }
+  else
+  {
+    status = KV_Compact(&kvHandle);
+  }
+
+  kvErrors += (status != HAL_OK) ? 1u : 0u;
+  kvModel = kvNext;
+}
+
+/* ----------------------------------------------------------------------
+*       Checks
+* -------------------------------------------------------------------- */
+
+/**
+ * @brief  Long run of updates on the whole data EEPROM, then a remount
+ *         of the file.
+ */
+static void check_updates(const char *path)
+{
+  host_eeprom_stats_t stats;
+  uint32_t i, bad = 0u, batch;
+
+  kvErrors = 0u;
+  kv_reset(FLASH_EEPROM_END - FLASH_EEPROM_BASE + 1u);
+  for (i = 0u; i < 3000u; i++)
+  {
+    kv_step();
+    bad += (kv_diff(&kvHandle, &kvModel) != 0u) ? 1u : 0u;
+  }
+  host_check_equal("kv/updates", 3000u, bad + kvErrors);
+
+  /* The content is the one of the file */
+  host_eeprom_close();
+  if (host_eeprom_open(path) != 0)
+  {
+    host_check_equal("kv/remount", KV_KEYS, KV_KEYS);
+    return;
+  }
+  kv_mount(FLASH_EEPROM_END - FLASH_EEPROM_BASE + 1u);
+  host_check_equal("kv/remount", KV_KEYS, kv_diff(&kvHandle, &kvModel) + kvErrors);
+
+  /* A batch programs in one unlock window, and nothing is ever programmed
+   * while the memory is locked */
+  host_eeprom_stats(&stats);
+  batch = stats.unlocks;
+  KV_BeginBatch(&kvHandle);
+  for (i = 0u; i < 16u; i++)
+  {
+    kv_step();
+  }
+  KV_EndBatch(&kvHandle);
+  host_eeprom_stats(&stats);
+  host_check_equal("kv/batch", 16u, (stats.unlocks - batch - 1u) + kvErrors + kv_diff(&kvHandle, &kvModel));
+  host_check_equal("kv/locked writes", stats.programs, stats.lockedWrites);
+
+  /* A foreign area is formatted */
+  host_eeprom_fill(0xFFu);
+  memset(&kvModel, 0, sizeof(kvModel));
+  kv_mount(FLASH_EEPROM_END - FLASH_EEPROM_BASE + 1u);
+  host_check_equal("kv/foreign area", KV_KEYS, kv_diff(&kvHandle, &kvModel) + kvErrors);
+}
+
+/**
+ * @brief  The same run of updates, cut by a power failure after each of
+ *         its program operations in turn, whole or torn. After the
+ *         restart the interrupted update is either complete or absent,
+ *         and the updates and compactions that follow, and a last
+ *         restart, keep matching the model.
+ */
+static void check_power_cut(int torn)
+{
+  host_eeprom_stats_t stats;
+  uint32_t programs, cut, i;
+
+  /* Program operations of the run */
+  kv_reset(KV_SMALL_SIZE);
+  host_eeprom_stats(&stats);
+  programs = stats.programs;
+  host_seed(30u);
+  for (i = 0u; i < KV_SCRIPT; i++)
+  {
+    kv_step();
+  }
+  host_eeprom_stats(&stats);
+  programs = stats.programs - programs;
+
+  kvErrors = 0u;
+  kvBad = 0u;
+  kvInterrupted = 0u;
+  for (cut = 0u; cut < programs; cut++)
+  {
+    kv_reset(KV_SMALL_SIZE);
+    host_seed(30u);
+    host_eeprom_power_cut(cut, torn);
+    if (setjmp(host_power_fail) == 0)
+    {
+      for (i = 0u; i < KV_SCRIPT; i++)
+      {
+        kv_step();
+      }
+      host_eeprom_power_on();
+    }
+    else
+    {
+      kvInterrupted++;
+      kv_mount(KV_SMALL_SIZE);
+      if (kv_diff(&kvHandle, &kvNext) == 0u)
+      {
+        kvModel = kvNext;
+      }
+      kvBad += (kv_diff(&kvHandle, &kvModel) != 0u) ? 1u : 0u;
+    }
+
+    for (i = 0u; i < KV_AFTER; i++)
+    {
+      kv_step();
+      kvBad += (kv_diff(&kvHandle, &kvModel) != 0u) ? 1u : 0u;
+    }
+    kv_mount(KV_SMALL_SIZE);
+    kvBad += (kv_diff(&kvHandle, &kvModel) != 0u) ? 1u : 0u;
+  }
+
+  host_check_equal(torn ? "kv/power cut torn" : "kv/power cut", programs,
+                   kvBad + kvErrors + (programs - kvInterrupted));
+}
+
+/**
+ * @brief  A compaction cut before its commit leaves records of the next
+ *         generation in the spare bank. The next compaction writes that
+ *         generation again, with the two last keys deleted, so that its
+ *         log ends where the stale records of these keys start; then
+ *         keys are rewritten over them one by one. Neither the deleted
+ *         keys nor their old values may come back, before or after a
+ *         restart.
+ */
+static void check_interrupted_compaction(void)
+{
+  static uint32_t cut;
+  host_eeprom_stats_t stats;
+  uint32_t programs, k, i;
+
+  kvErrors = 0u;
+  kvBad = 0u;
+  kvInterrupted = 0u;
+  for (cut = 0u; ; cut++)
+  {
+    kv_reset(KV_SMALL_SIZE);
+    for (k = 0u; k < KV_KEYS; k++)
+    {
+      kvModel.key[k].present = 1u;
+      kvModel.key[k].length = 12u;
+      host_bytes(kvModel.key[k].data, 12u);
+      kvErrors += (KV_Put(&kvHandle, (uint16_t)k, kvModel.key[k].data, 12u) != HAL_OK) ? 1u : 0u;
+    }
+
+    host_eeprom_stats(&stats);
+    programs = stats.programs;
+    host_eeprom_power_cut(cut, 0);
+    if (setjmp(host_power_fail) == 0)
+    {
+      kvErrors += (KV_Compact(&kvHandle) != HAL_OK) ? 1u : 0u;
+      host_eeprom_power_on();
+      host_eeprom_stats(&stats);
+      host_check_equal("kv/interrupted compaction", stats.programs - programs,
+                       kvBad + kvErrors + ((stats.programs - programs) - kvInterrupted));
+      return;
+    }
+    kvInterrupted++;
+    kv_mount(KV_SMALL_SIZE);
+
+    for (k = KV_KEYS - 2u; k < KV_KEYS; k++)
+    {
+      kvModel.key[k].present = 0u;
+      kvErrors += (KV_Delete(&kvHandle, (uint16_t)k) != HAL_OK) ? 1u : 0u;
+    }
+    kvErrors += (KV_Compact(&kvHandle) != HAL_OK) ? 1u : 0u;
+    kvBad += (kv_diff(&kvHandle, &kvModel) != 0u) ? 1u : 0u;
+
+    for (i = 0u; i < 2u; i++)
+    {
+      host_bytes(kvModel.key[i].data, 12u);
+      kvErrors += (KV_Put(&kvHandle, (uint16_t)i, kvModel.key[i].data, 12u) != HAL_OK) ? 1u : 0u;
+      kvBad += (kv_diff(&kvHandle, &kvModel) != 0u) ? 1u : 0u;
+      kv_mount(KV_SMALL_SIZE);
+      kvBad += (kv_diff(&kvHandle, &kvModel) != 0u) ? 1u : 0u;
+    }
+  }
+}
+
+void check_kv(void)
+{
+  char path[] = "/tmp/hal_check_kv.XXXXXX";
+  int file = mkstemp(path);
+
+  if ((file < 0) || (close(file) != 0) || (host_eeprom_open(path) != 0))
+  {
+    host_check_equal("kv/data EEPROM file", 1u, 1u);
+    return;
+  }
+
+  check_updates(path);
+  check_power_cut(0);
+  check_power_cut(1);
+  check_interrupted_compaction();
+
+  host_eeprom_close();
+  unlink(path);
+}
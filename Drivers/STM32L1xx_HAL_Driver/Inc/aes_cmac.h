@@ -0,0 +1,171 @@
+/**
+  ******************************************************************************
+  * @file    aes_cmac.h
+  * @brief   Header file of the AES-CMAC and of the encrypt-then-MAC record
+  *          format built on the AES sessions.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __AES_CMAC_H
+#define __AES_CMAC_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "aes_session.h"
+
+/** @addtogroup AES_CMAC
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup AES_CMAC_Exported_Constants AES_CMAC Exported Constants
+  * @{
+  */
+#define CMAC_SIZE                16U       /*!< CMAC tag size in bytes */
+
+#define ETM_VERSION              0x01U     /*!< Record format version */
+#define ETM_NONCE_SIZE           8U        /*!< Record nonce size in bytes */
+#define ETM_HEADER_SIZE          16U       /*!< Authenticated clear header */
+#define ETM_TAG_SIZE             CMAC_SIZE /*!< Tag appended to the record */
+#define ETM_OVERHEAD             (ETM_HEADER_SIZE + ETM_TAG_SIZE)
+#define ETM_MAX_LENGTH           0xFFFFU   /*!< Largest payload of one record */
+
+#ifndef ETM_CHUNK_SIZE
+#define ETM_CHUNK_SIZE           256U      /*!< Payload encrypted by DMA while the previous
+                                                chunk is MACed, a multiple of 16 */
+#endif /* ETM_CHUNK_SIZE */
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup AES_CMAC_Exported_Types AES_CMAC Exported Types
+  * @{
+  */
+
+/**
+  * @brief  AES-CMAC configuration structure definition
+  */
+typedef struct
+{
+  const uint8_t *pKey;           /*!< 16-byte key */
+
+#if defined(AESS_USE_CRYP)
+  CRYP_HandleTypeDef *hcryp;     /*!< AES unit handle, NULL to run in software */
+#endif /* AESS_USE_CRYP */
+} CMAC_InitTypeDef;
+
+/**
+  * @brief  AES-CMAC context structure definition
+  */
+typedef struct
+{
+  CMAC_InitTypeDef Init;                  /*!< Context configuration */
+
+  AESS_HandleTypeDef Session;             /*!< CBC session computing the MAC */
+
+  uint8_t K1[AESS_BLOCK_SIZE];            /*!< Subkey for a complete last block */
+
+  uint8_t K2[AESS_BLOCK_SIZE];            /*!< Subkey for a padded last block */
+
+  uint8_t Buffer[AESS_BLOCK_SIZE];        /*!< Last block, held back until CMAC_Finish() */
+
+  uint32_t BufferCount;                   /*!< Number of bytes in Buffer */
+
+  uint8_t Mac[AESS_BLOCK_SIZE];           /*!< CBC-MAC of the blocks processed so far */
+} CMAC_HandleTypeDef;
+
+/**
+  * @brief  Encrypt-then-MAC record keys
+  */
+typedef struct
+{
+  const uint8_t *pEncKey;        /*!< 16-byte AES-CTR key */
+
+  const uint8_t *pMacKey;        /*!< 16-byte AES-CMAC key, distinct from pEncKey */
+
+#if defined(AESS_USE_CRYP)
+  CRYP_HandleTypeDef *hcryp;     /*!< AES unit running the encryption, NULL to run in
+                                      software. The MAC always runs in software, in
+                                      parallel with the DMA transfers */
+#endif /* AESS_USE_CRYP */
+} ETM_InitTypeDef;
+
+/**
+  * @brief  Encrypt-then-MAC record context
+  */
+typedef struct
+{
+  ETM_InitTypeDef    Init;                /*!< Record keys */
+
+  AESS_HandleTypeDef Ctr;                 /*!< Encryption session */
+
+  CMAC_HandleTypeDef Cmac;                /*!< Authentication context */
+} ETM_HandleTypeDef;
+
+/**
+  * @brief  Record header, sent in clear and authenticated
+  */
+typedef struct
+{
+  uint8_t  Type;                          /*!< Application record type */
+
+  uint16_t Length;                        /*!< Payload length, set by ETM_Seal() */
+
+  uint32_t Sequence;                      /*!< Record number */
+
+  uint8_t  Nonce[ETM_NONCE_SIZE];         /*!< Sender nonce. Nonce and Sequence must never
+                                               repeat under one key */
+} ETM_HeaderTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup AES_CMAC_Exported_Functions
+  * @{
+  */
+
+/** @addtogroup AES_CMAC_Exported_Functions_Group1
+  * @{
+  */
+/* AES-CMAC functions *********************************************************/
+HAL_StatusTypeDef CMAC_Init(CMAC_HandleTypeDef *hcmac);
+HAL_StatusTypeDef CMAC_Start(CMAC_HandleTypeDef *hcmac);
+HAL_StatusTypeDef CMAC_Update(CMAC_HandleTypeDef *hcmac, const uint8_t *pData, uint32_t Length);
+HAL_StatusTypeDef CMAC_Finish(CMAC_HandleTypeDef *hcmac, uint8_t *pMac);
+HAL_StatusTypeDef CMAC_DeInit(CMAC_HandleTypeDef *hcmac);
+/**
+  * @}
+  */
+
+/** @addtogroup AES_CMAC_Exported_Functions_Group2
+  * @{
+  */
+/* Record functions ***********************************************************/
+HAL_StatusTypeDef ETM_Init(ETM_HandleTypeDef *hetm);
+HAL_StatusTypeDef ETM_Seal(ETM_HandleTypeDef *hetm, ETM_HeaderTypeDef *pHeader, const uint8_t *pPlain, uint32_t Length, uint8_t *pRecord);
+HAL_StatusTypeDef ETM_Open(ETM_HandleTypeDef *hetm, const uint8_t *pRecord, uint32_t RecordSize, ETM_HeaderTypeDef *pHeader, uint8_t *pPlain);
+HAL_StatusTypeDef ETM_DeInit(ETM_HandleTypeDef *hetm);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AES_CMAC_H */
@@ -0,0 +1,191 @@
+/**
+  ******************************************************************************
+  * @file    aes_session.h
+  * @brief   Header file of the session-based AES-128 engine, running on the
+  *          AES unit when the device has one and in software otherwise.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __AES_SESSION_H
+#define __AES_SESSION_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx_hal.h"
+
+/** @addtogroup AES_SESSION
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup AES_SESSION_Exported_Constants AES_SESSION Exported Constants
+  * @{
+  */
+
+/** @defgroup AES_SESSION_Config Configuration
+  * @{
+  */
+#if defined(AES) && defined(HAL_CRYP_MODULE_ENABLED)
+#define AESS_USE_CRYP                          /*!< Sessions may run on the AES unit */
+#endif /* AES && HAL_CRYP_MODULE_ENABLED */
+/**
+  * @}
+  */
+
+#define AESS_BLOCK_SIZE          16U       /*!< AES block size in bytes */
+#define AESS_KEY_SIZE            16U       /*!< AES-128 key size in bytes */
+
+/** @defgroup AES_SESSION_Mode Chaining modes
+  * @{
+  */
+#define AESS_MODE_ECB            0x00U
+#define AESS_MODE_CBC            0x01U
+#define AESS_MODE_CTR            0x02U
+/**
+  * @}
+  */
+
+/** @defgroup AES_SESSION_Direction Directions
+  * @{
+  */
+#define AESS_ENCRYPT             0x00U
+#define AESS_DECRYPT             0x01U
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup AES_SESSION_Exported_Types AES_SESSION Exported Types
+  * @{
+  */
+
+/**
+  * @brief  AES session configuration structure definition
+  */
+typedef struct
+{
+  uint32_t Mode;                 /*!< Chaining mode, a value of @ref AES_SESSION_Mode */
+
+  uint32_t Direction;            /*!< A value of @ref AES_SESSION_Direction */
+
+  const uint8_t *pKey;           /*!< 16-byte key, copied by AESS_Start() */
+
+  const uint8_t *pInitVect;      /*!< 16-byte CBC initialization vector or CTR initial
+                                      counter block, unused in ECB mode */
+
+#if defined(AESS_USE_CRYP)
+  CRYP_HandleTypeDef *hcryp;     /*!< AES unit handle, initialized with HAL_CRYP_Init()
+                                      and linked to its DMA channels, NULL to run in
+                                      software */
+#endif /* AESS_USE_CRYP */
+} AESS_InitTypeDef;
+
+/**
+  * @brief  Buffer of a DMA queue
+  */
+typedef struct
+{
+  const uint8_t *pInput;         /*!< Input data, word aligned */
+
+  uint8_t *pOutput;              /*!< Output data, word aligned, may be pInput */
+
+  uint32_t Size;                 /*!< Size in bytes, a multiple of AESS_BLOCK_SIZE */
+} AESS_BufferTypeDef;
+
+/**
+  * @brief  AES session state definition
+  */
+typedef enum
+{
+  AESS_STATE_RESET         = 0x00U,  /*!< Session not started */
+  AESS_STATE_READY         = 0x01U,  /*!< Key loaded, ready to process data */
+  AESS_STATE_BUSY          = 0x02U,  /*!< DMA queue running */
+  AESS_STATE_ERROR         = 0x03U   /*!< DMA queue aborted by an error */
+} AESS_StateTypeDef;
+
+/**
+  * @brief  AES session handle structure definition
+  */
+typedef struct
+{
+  AESS_InitTypeDef Init;                  /*!< Session configuration */
+
+  uint8_t Key[AESS_KEY_SIZE];             /*!< Session key */
+
+  uint8_t Chain[AESS_BLOCK_SIZE];         /*!< Software mode: last CBC block or next CTR counter */
+
+  uint8_t RoundKey[11U * AESS_BLOCK_SIZE];/*!< Software mode: expanded key */
+
+  const AESS_BufferTypeDef *pQueue;       /*!< Buffers of the running DMA queue */
+
+  uint32_t QueueCount;                    /*!< Number of buffers of the queue */
+
+  __IO uint32_t QueueIndex;               /*!< Buffer being processed */
+
+  __IO AESS_StateTypeDef State;           /*!< Session state */
+} AESS_HandleTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup AES_SESSION_Exported_Functions
+  * @{
+  */
+
+/** @addtogroup AES_SESSION_Exported_Functions_Group1
+  * @{
+  */
+/* Session functions **********************************************************/
+HAL_StatusTypeDef AESS_Start(AESS_HandleTypeDef *haes);
+HAL_StatusTypeDef AESS_SetInitVect(AESS_HandleTypeDef *haes, const uint8_t *pInitVect);
+HAL_StatusTypeDef AESS_Stop(AESS_HandleTypeDef *haes);
+/**
+  * @}
+  */
+
+/** @addtogroup AES_SESSION_Exported_Functions_Group2
+  * @{
+  */
+/* Processing functions *******************************************************/
+HAL_StatusTypeDef AESS_Process(AESS_HandleTypeDef *haes, const uint8_t *pInput, uint32_t Size, uint8_t *pOutput, uint32_t Timeout);
+HAL_StatusTypeDef AESS_Submit(AESS_HandleTypeDef *haes, const AESS_BufferTypeDef *pQueue, uint32_t Count);
+HAL_StatusTypeDef AESS_PollForQueue(AESS_HandleTypeDef *haes, uint32_t Timeout);
+void              AESS_QueueCpltCallback(AESS_HandleTypeDef *haes);
+/**
+  * @}
+  */
+
+/** @addtogroup AES_SESSION_Exported_Functions_Group3
+  * @{
+  */
+/* Software block cipher ******************************************************/
+void AESS_ExpandKey(const uint8_t *pKey, uint8_t *pRoundKey);
+void AESS_EncryptBlock(const uint8_t *pRoundKey, const uint8_t *pInput, uint8_t *pOutput);
+void AESS_DecryptBlock(const uint8_t *pRoundKey, const uint8_t *pInput, uint8_t *pOutput);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AES_SESSION_H */
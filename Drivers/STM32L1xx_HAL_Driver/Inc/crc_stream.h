@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file    crc_stream.h
+  * @brief   Header file of the streaming CRC computation on the CRC unit.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CRC_STREAM_H
+#define __CRC_STREAM_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx_hal.h"
+
+/** @addtogroup CRC_STREAM
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup CRC_STREAM_Exported_Constants CRC_STREAM Exported Constants
+  * @{
+  */
+#define CRCS_INIT_VALUE          0xFFFFFFFFU  /*!< CRC unit value after reset */
+#define CRCS_POLYNOMIAL          0x04C11DB7U  /*!< CRC-32 polynomial of the CRC unit */
+#define CRCS_DMA_MAX_WORDS       0xFFFFU      /*!< Largest DMA transfer, in words */
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup CRC_STREAM_Exported_Types CRC_STREAM Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Streaming CRC configuration structure definition
+  */
+typedef struct
+{
+  CRC_HandleTypeDef *hcrc;       /*!< CRC unit handle, initialized with HAL_CRC_Init() */
+
+  DMA_HandleTypeDef *hdma;       /*!< Memory-to-memory DMA channel feeding the CRC unit,
+                                      NULL to feed it from the CPU only */
+
+  uint32_t DmaThreshold;         /*!< Smallest run of bytes handed to the DMA. Shorter
+                                      runs are written by the CPU */
+} CRCS_InitTypeDef;
+
+/**
+  * @brief  Streaming CRC context structure definition
+  */
+typedef struct
+{
+  CRCS_InitTypeDef Init;         /*!< Context configuration */
+
+  uint32_t Crc;                  /*!< CRC of the whole words processed so far */
+
+  uint32_t Length;               /*!< Number of bytes processed so far */
+
+  uint8_t  Pending[4];           /*!< Bytes of the incomplete word at the end of the stream */
+
+  uint32_t PendingCount;         /*!< Number of bytes in Pending */
+} CRCS_HandleTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup CRC_STREAM_Exported_Functions
+  * @{
+  */
+void              CRCS_Start(CRCS_HandleTypeDef *hcrcs);
+HAL_StatusTypeDef CRCS_Update(CRCS_HandleTypeDef *hcrcs, const void *pData, uint32_t Length);
+uint32_t          CRCS_Finish(CRCS_HandleTypeDef *hcrcs);
+uint32_t          CRCS_Software(uint32_t Crc, const void *pData, uint32_t Length);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRC_STREAM_H */
@@ -0,0 +1,140 @@
+/**
+  ******************************************************************************
+  * @file    eeprom_kv.h
+  * @brief   Header file of the wear-levelled key-value store kept in the
+  *          STM32L1 data EEPROM.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __EEPROM_KV_H
+#define __EEPROM_KV_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx_hal.h"
+
+/** @addtogroup EEPROM_KV
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup EEPROM_KV_Exported_Constants EEPROM_KV Exported Constants
+  * @{
+  */
+
+/** @defgroup EEPROM_KV_Config Configuration
+  * @{
+  */
+#ifndef KV_MAX_KEYS
+#define KV_MAX_KEYS              32U       /*!< Number of distinct live keys tracked in RAM */
+#endif /* KV_MAX_KEYS */
+
+#define KV_MAX_VALUE_SIZE        255U      /*!< Largest value stored in one record */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup EEPROM_KV_Exported_Types EEPROM_KV Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Key-value store configuration structure definition
+  */
+typedef struct
+{
+  uint32_t BaseAddress;   /*!< Start of the data EEPROM area used by the store,
+                               must be word aligned */
+
+  uint32_t Size;          /*!< Size of the area in bytes. It is split in two banks
+                               of Size/2 bytes, each a multiple of 4 bytes */
+} KV_InitTypeDef;
+
+/**
+  * @brief  In-RAM index entry: latest record of one key
+  */
+typedef struct
+{
+  uint16_t Key;           /*!< Record key */
+
+  uint16_t Length;        /*!< Value length in bytes */
+
+  uint32_t Address;       /*!< Address of the record header in the data EEPROM */
+} KV_IndexTypeDef;
+
+/**
+  * @brief  Key-value store handle structure definition
+  */
+typedef struct
+{
+  KV_InitTypeDef   Init;                    /*!< Store configuration */
+
+  KV_IndexTypeDef  Index[KV_MAX_KEYS];      /*!< Latest record of every live key, sorted by key */
+
+  uint32_t         KeyCount;                /*!< Number of used index entries */
+
+  uint32_t         BankAddress;             /*!< Start of the active bank */
+
+  uint32_t         WriteAddress;            /*!< Next free record slot in the active bank */
+
+  uint16_t         Sequence;                /*!< Generation number of the active bank */
+
+  uint16_t         BatchDepth;              /*!< Nesting level of KV_BeginBatch() */
+} KV_HandleTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup EEPROM_KV_Exported_Functions
+  * @{
+  */
+
+/** @addtogroup EEPROM_KV_Exported_Functions_Group1
+  * @{
+  */
+/* Initialization functions ***************************************************/
+HAL_StatusTypeDef KV_Init(KV_HandleTypeDef *hkv);
+HAL_StatusTypeDef KV_Format(KV_HandleTypeDef *hkv);
+/**
+  * @}
+  */
+
+/** @addtogroup EEPROM_KV_Exported_Functions_Group2
+  * @{
+  */
+/* Record access functions ****************************************************/
+HAL_StatusTypeDef KV_Get(KV_HandleTypeDef *hkv, uint16_t Key, void *pData, uint32_t Size, uint32_t *pLength);
+HAL_StatusTypeDef KV_Put(KV_HandleTypeDef *hkv, uint16_t Key, const void *pData, uint32_t Length);
+HAL_StatusTypeDef KV_Delete(KV_HandleTypeDef *hkv, uint16_t Key);
+HAL_StatusTypeDef KV_BeginBatch(KV_HandleTypeDef *hkv);
+HAL_StatusTypeDef KV_EndBatch(KV_HandleTypeDef *hkv);
+HAL_StatusTypeDef KV_Compact(KV_HandleTypeDef *hkv);
+uint32_t          KV_GetFreeSpace(KV_HandleTypeDef *hkv);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EEPROM_KV_H */
@@ -0,0 +1,593 @@
+/**
+  ******************************************************************************
+  * @file    aes_cmac.c
+  * @brief   AES-CMAC (RFC 4493) and encrypt-then-MAC records (AES-CTR and
+  *          AES-CMAC), built on the AES sessions.
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) AES-CMAC: fill CMAC_HandleTypeDef.Init with the key and call
+       CMAC_Init() once; it derives the subkeys. For every message call
+       CMAC_Start(), CMAC_Update() as many times as needed and CMAC_Finish().
+       CMAC_DeInit() wipes the key material.
+   (#) Records: fill ETM_HandleTypeDef.Init with two distinct keys and call
+       ETM_Init() once. ETM_Seal() turns a payload into a record, ETM_Open()
+       checks a record and returns its payload. A record is protected by
+       ETM_OVERHEAD bytes: a clear header and a tag.
+
+                     ##### Record format #####
+  ==============================================================================
+  [..]
+   (#) Header, 16 bytes: version, type, payload length (16 bits) and
+       sequence number (32 bits), both big endian, then the 8-byte nonce.
+   (#) Payload, encrypted with AES-CTR under the encryption key. The initial
+       counter block is the nonce, the sequence number and a 32-bit block
+       counter starting at 1. The same nonce and sequence number must never
+       be used twice with one key.
+   (#) Tag, 16 bytes: AES-CMAC under the MAC key of the header and of the
+       encrypted payload. ETM_Open() returns the payload only when the tag
+       is right, and clears the output otherwise. A record with a wrong
+       version or length is rejected before anything is written.
+   (#) Encryption and authentication run in a single pass over the payload,
+       in chunks of ETM_CHUNK_SIZE bytes. When the encryption session runs
+       on the AES unit and the buffers are word aligned, each chunk is
+       encrypted by DMA while the CPU computes the CMAC of the previous one;
+       otherwise each chunk is encrypted and authenticated in turn. A device
+       has a single AES unit, so the CMAC of a record always runs in
+       software.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "aes_cmac.h"
+#include <string.h>
+
+/** @defgroup AES_CMAC AES_CMAC
+  * @brief AES-CMAC and encrypt-then-MAC records
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+/** @defgroup AES_CMAC_Private_Constants AES_CMAC Private Constants
+  * @{
+  */
+#define CMAC_RB                  0x87U      /* Subkey generation constant */
+#define CMAC_TIMEOUT             10U        /* ms, per block on the AES unit */
+#define ETM_TIMEOUT              100U       /* ms, per DMA chunk */
+/**
+  * @}
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/** @defgroup AES_CMAC_Private_Variables AES_CMAC Private Variables
+  * @{
+  */
+static const uint8_t CMACZero[AESS_BLOCK_SIZE] = {0};
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup AES_CMAC_Private_Functions AES_CMAC Private Functions
+  * @{
+  */
+static void              CMAC_Double(const uint8_t *pInput, uint8_t *pOutput);
+static HAL_StatusTypeDef CMAC_Block(CMAC_HandleTypeDef *hcmac, const uint8_t *pBlock);
+static void              ETM_WriteHeader(const ETM_HeaderTypeDef *pHeader, uint8_t *pOutput);
+static void              ETM_SetCounter(ETM_HandleTypeDef *hetm, const ETM_HeaderTypeDef *pHeader);
+static HAL_StatusTypeDef ETM_Process(ETM_HandleTypeDef *hetm, const uint8_t *pInput, uint8_t *pOutput, uint32_t Length, uint8_t MacInput);
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup AES_CMAC_Exported_Functions AES_CMAC Exported Functions
+  * @{
+  */
+
+/** @defgroup AES_CMAC_Exported_Functions_Group1 AES-CMAC functions
+ *  @brief    AES-CMAC functions
+ *
+@verbatim
+ ===============================================================================
+                      ##### AES-CMAC functions #####
+ ===============================================================================
+    [..]
+    This section provides functions allowing to:
+      (+) Load a key and derive the CMAC subkeys
+      (+) Compute the CMAC of a message given in pieces
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Loads the key and derives the subkeys.
+  * @param  hcmac: pointer to a CMAC_HandleTypeDef structure whose Init is filled
+  * @retval HAL status
+  */
+HAL_StatusTypeDef CMAC_Init(CMAC_HandleTypeDef *hcmac)
+{
+  uint8_t l[AESS_BLOCK_SIZE];
+
+  hcmac->Session.Init.Mode      = AESS_MODE_CBC;
+  hcmac->Session.Init.Direction = AESS_ENCRYPT;
+  hcmac->Session.Init.pKey      = hcmac->Init.pKey;
+  hcmac->Session.Init.pInitVect = CMACZero;
+#if defined(AESS_USE_CRYP)
+  hcmac->Session.Init.hcryp     = hcmac->Init.hcryp;
+#endif /* AESS_USE_CRYP */
+
+  if(AESS_Start(&hcmac->Session) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+
+  /* L = AES(K, 0), K1 = 2.L, K2 = 4.L */
+  if(AESS_Process(&hcmac->Session, CMACZero, AESS_BLOCK_SIZE, l, CMAC_TIMEOUT) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+  CMAC_Double(l, hcmac->K1);
+  CMAC_Double(hcmac->K1, hcmac->K2);
+  memset(l, 0, sizeof(l));
+
+  return CMAC_Start(hcmac);
+}
+
+/**
+  * @brief  Starts a new message.
+  * @param  hcmac: pointer to a CMAC_HandleTypeDef structure
+  * @retval HAL status
+  */
+HAL_StatusTypeDef CMAC_Start(CMAC_HandleTypeDef *hcmac)
+{
+  hcmac->BufferCount = 0U;
+  memset(hcmac->Mac, 0, AESS_BLOCK_SIZE);
+
+  return AESS_SetInitVect(&hcmac->Session, CMACZero);
+}
+
+/**
+  * @brief  Adds data to the message.
+  * @param  hcmac: pointer to a CMAC_HandleTypeDef structure
+  * @param  pData: data
+  * @param  Length: data length in bytes
+  * @retval HAL status
+  */
+HAL_StatusTypeDef CMAC_Update(CMAC_HandleTypeDef *hcmac, const uint8_t *pData, uint32_t Length)
+{
+  uint32_t count = 0U;
+
+  while(Length > 0U)
+  {
+    /* The buffered block is not the last one: process it */
+    if(hcmac->BufferCount == AESS_BLOCK_SIZE)
+    {
+      if(CMAC_Block(hcmac, hcmac->Buffer) != HAL_OK)
+      {
+        return HAL_ERROR;
+      }
+      hcmac->BufferCount = 0U;
+    }
+
+    /* Process whole blocks in place, holding back the last one */
+    while((hcmac->BufferCount == 0U) && (Length > AESS_BLOCK_SIZE))
+    {
+      if(CMAC_Block(hcmac, pData) != HAL_OK)
+      {
+        return HAL_ERROR;
+      }
+      pData  += AESS_BLOCK_SIZE;
+      Length -= AESS_BLOCK_SIZE;
+    }
+
+    count = AESS_BLOCK_SIZE - hcmac->BufferCount;
+    if(count > Length)
+    {
+      count = Length;
+    }
+    memcpy(&hcmac->Buffer[hcmac->BufferCount], pData, count);
+    hcmac->BufferCount += count;
+    pData  += count;
+    Length -= count;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Ends the message and returns its CMAC.
+  * @param  hcmac: pointer to a CMAC_HandleTypeDef structure
+  * @param  pMac: receives the CMAC_SIZE-byte tag
+  * @retval HAL status
+  */
+HAL_StatusTypeDef CMAC_Finish(CMAC_HandleTypeDef *hcmac, uint8_t *pMac)
+{
+  uint8_t last[AESS_BLOCK_SIZE];
+  uint32_t index = 0U;
+
+  if(hcmac->BufferCount == AESS_BLOCK_SIZE)
+  {
+    for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+    {
+      last[index] = hcmac->Buffer[index] ^ hcmac->K1[index];
+    }
+  }
+  else
+  {
+    /* Pad with 10...0 */
+    memset(last, 0, AESS_BLOCK_SIZE);
+    memcpy(last, hcmac->Buffer, hcmac->BufferCount);
+    last[hcmac->BufferCount] = 0x80U;
+    for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+    {
+      last[index] ^= hcmac->K2[index];
+    }
+  }
+
+  if(CMAC_Block(hcmac, last) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+  memcpy(pMac, hcmac->Mac, CMAC_SIZE);
+  hcmac->BufferCount = 0U;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Releases the session and wipes the key material.
+  * @param  hcmac: pointer to a CMAC_HandleTypeDef structure
+  * @retval HAL status
+  */
+HAL_StatusTypeDef CMAC_DeInit(CMAC_HandleTypeDef *hcmac)
+{
+  memset(hcmac->K1, 0, AESS_BLOCK_SIZE);
+  memset(hcmac->K2, 0, AESS_BLOCK_SIZE);
+  memset(hcmac->Buffer, 0, AESS_BLOCK_SIZE);
+  memset(hcmac->Mac, 0, AESS_BLOCK_SIZE);
+  hcmac->BufferCount = 0U;
+
+  return AESS_Stop(&hcmac->Session);
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup AES_CMAC_Exported_Functions_Group2 Record functions
+ *  @brief    Record functions
+ *
+@verbatim
+ ===============================================================================
+                      ##### Record functions #####
+ ===============================================================================
+    [..]
+    This section provides functions allowing to:
+      (+) Load the record keys
+      (+) Encrypt and authenticate a payload into a record
+      (+) Check a record and decrypt its payload
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Loads the record keys.
+  * @param  hetm: pointer to an ETM_HandleTypeDef structure whose Init is filled
+  * @retval HAL status
+  */
+HAL_StatusTypeDef ETM_Init(ETM_HandleTypeDef *hetm)
+{
+  if((hetm->Init.pEncKey == NULL) || (hetm->Init.pMacKey == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  hetm->Ctr.Init.Mode      = AESS_MODE_CTR;
+  hetm->Ctr.Init.Direction = AESS_ENCRYPT;
+  hetm->Ctr.Init.pKey      = hetm->Init.pEncKey;
+  hetm->Ctr.Init.pInitVect = CMACZero;
+#if defined(AESS_USE_CRYP)
+  hetm->Ctr.Init.hcryp     = hetm->Init.hcryp;
+  hetm->Cmac.Init.hcryp    = NULL;
+#endif /* AESS_USE_CRYP */
+  hetm->Cmac.Init.pKey     = hetm->Init.pMacKey;
+
+  if(AESS_Start(&hetm->Ctr) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+
+  return CMAC_Init(&hetm->Cmac);
+}
+
+/**
+  * @brief  Encrypts and authenticates a payload into a record.
+  * @param  hetm: pointer to an ETM_HandleTypeDef structure
+  * @param  pHeader: record header; its Length is set to the payload length
+  * @param  pPlain: payload, may be pRecord + ETM_HEADER_SIZE
+  * @param  Length: payload length in bytes, at most ETM_MAX_LENGTH
+  * @param  pRecord: receives the record, Length + ETM_OVERHEAD bytes
+  * @retval HAL status
+  */
+HAL_StatusTypeDef ETM_Seal(ETM_HandleTypeDef *hetm, ETM_HeaderTypeDef *pHeader, const uint8_t *pPlain, uint32_t Length, uint8_t *pRecord)
+{
+  if(Length > ETM_MAX_LENGTH)
+  {
+    return HAL_ERROR;
+  }
+
+  pHeader->Length = (uint16_t)Length;
+  ETM_WriteHeader(pHeader, pRecord);
+  ETM_SetCounter(hetm, pHeader);
+
+  if((CMAC_Start(&hetm->Cmac) != HAL_OK) ||
+     (CMAC_Update(&hetm->Cmac, pRecord, ETM_HEADER_SIZE) != HAL_OK) ||
+     (ETM_Process(hetm, pPlain, &pRecord[ETM_HEADER_SIZE], Length, 0U) != HAL_OK))
+  {
+    return HAL_ERROR;
+  }
+
+  return CMAC_Finish(&hetm->Cmac, &pRecord[ETM_HEADER_SIZE + Length]);
+}
+
+/**
+  * @brief  Checks a record and decrypts its payload.
+  * @param  hetm: pointer to an ETM_HandleTypeDef structure
+  * @param  pRecord: record
+  * @param  RecordSize: record size in bytes
+  * @param  pHeader: receives the record header
+  * @param  pPlain: receives the payload, RecordSize - ETM_OVERHEAD bytes. It
+  *         may be pRecord + ETM_HEADER_SIZE. It is cleared when the record
+  *         is not authentic.
+  * @retval HAL_OK when the record is authentic, HAL_ERROR otherwise
+  */
+HAL_StatusTypeDef ETM_Open(ETM_HandleTypeDef *hetm, const uint8_t *pRecord, uint32_t RecordSize, ETM_HeaderTypeDef *pHeader, uint8_t *pPlain)
+{
+  uint8_t tag[ETM_TAG_SIZE];
+  uint32_t length = 0U, index = 0U;
+  uint8_t diff = 0U;
+
+  if((RecordSize < ETM_OVERHEAD) || (pRecord[0] != ETM_VERSION))
+  {
+    return HAL_ERROR;
+  }
+  length = ((uint32_t)pRecord[2] << 8) | pRecord[3];
+  if(length != (RecordSize - ETM_OVERHEAD))
+  {
+    return HAL_ERROR;
+  }
+
+  pHeader->Type     = pRecord[1];
+  pHeader->Length   = (uint16_t)length;
+  pHeader->Sequence = ((uint32_t)pRecord[4] << 24) | ((uint32_t)pRecord[5] << 16) | ((uint32_t)pRecord[6] << 8) | pRecord[7];
+  memcpy(pHeader->Nonce, &pRecord[8], ETM_NONCE_SIZE);
+  ETM_SetCounter(hetm, pHeader);
+
+  if((CMAC_Start(&hetm->Cmac) != HAL_OK) ||
+     (CMAC_Update(&hetm->Cmac, pRecord, ETM_HEADER_SIZE) != HAL_OK) ||
+     (ETM_Process(hetm, &pRecord[ETM_HEADER_SIZE], pPlain, length, 1U) != HAL_OK) ||
+     (CMAC_Finish(&hetm->Cmac, tag) != HAL_OK))
+  {
+    memset(pPlain, 0, length);
+    return HAL_ERROR;
+  }
+
+  /* Constant-time comparison */
+  for(index = 0U; index < ETM_TAG_SIZE; index++)
+  {
+    diff |= tag[index] ^ pRecord[ETM_HEADER_SIZE + length + index];
+  }
+  if(diff != 0U)
+  {
+    memset(pPlain, 0, length);
+    return HAL_ERROR;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Releases the sessions and wipes the key material.
+  * @param  hetm: pointer to an ETM_HandleTypeDef structure
+  * @retval HAL status
+  */
+HAL_StatusTypeDef ETM_DeInit(ETM_HandleTypeDef *hetm)
+{
+  HAL_StatusTypeDef status = AESS_Stop(&hetm->Ctr);
+
+  if(CMAC_DeInit(&hetm->Cmac) != HAL_OK)
+  {
+    status = HAL_ERROR;
+  }
+
+  return status;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Private functions ---------------------------------------------------------*/
+/** @addtogroup AES_CMAC_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Multiplies a block by x in GF(2^128).
+  * @param  pInput: input block
+  * @param  pOutput: receives the result
+  * @retval None
+  */
+static void CMAC_Double(const uint8_t *pInput, uint8_t *pOutput)
+{
+  uint8_t carry = (uint8_t)((pInput[0] & 0x80U) != 0U);
+  uint32_t index = 0U;
+
+  for(index = 0U; index < (AESS_BLOCK_SIZE - 1U); index++)
+  {
+    pOutput[index] = (uint8_t)((pInput[index] << 1) | (pInput[index + 1U] >> 7));
+  }
+  pOutput[AESS_BLOCK_SIZE - 1U] = (uint8_t)(pInput[AESS_BLOCK_SIZE - 1U] << 1);
+  if(carry != 0U)
+  {
+    pOutput[AESS_BLOCK_SIZE - 1U] ^= CMAC_RB;
+  }
+}
+
+/**
+  * @brief  Runs one block through the CBC-MAC.
+  * @param  hcmac: pointer to a CMAC_HandleTypeDef structure
+  * @param  pBlock: 16-byte block
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef CMAC_Block(CMAC_HandleTypeDef *hcmac, const uint8_t *pBlock)
+{
+  return AESS_Process(&hcmac->Session, pBlock, AESS_BLOCK_SIZE, hcmac->Mac, CMAC_TIMEOUT);
+}
+
+/**
+  * @brief  Serializes a record header.
+  * @param  pHeader: record header
+  * @param  pOutput: receives the ETM_HEADER_SIZE bytes
+  * @retval None
+  */
+static void ETM_WriteHeader(const ETM_HeaderTypeDef *pHeader, uint8_t *pOutput)
+{
+  pOutput[0] = ETM_VERSION;
+  pOutput[1] = pHeader->Type;
+  pOutput[2] = (uint8_t)(pHeader->Length >> 8);
+  pOutput[3] = (uint8_t)pHeader->Length;
+  pOutput[4] = (uint8_t)(pHeader->Sequence >> 24);
+  pOutput[5] = (uint8_t)(pHeader->Sequence >> 16);
+  pOutput[6] = (uint8_t)(pHeader->Sequence >> 8);
+  pOutput[7] = (uint8_t)pHeader->Sequence;
+  memcpy(&pOutput[8], pHeader->Nonce, ETM_NONCE_SIZE);
+}
+
+/**
+  * @brief  Loads the initial counter block of a record.
+  * @param  hetm: pointer to an ETM_HandleTypeDef structure
+  * @param  pHeader: record header
+  * @retval None
+  */
+static void ETM_SetCounter(ETM_HandleTypeDef *hetm, const ETM_HeaderTypeDef *pHeader)
+{
+  uint8_t counter[AESS_BLOCK_SIZE];
+
+  memcpy(counter, pHeader->Nonce, ETM_NONCE_SIZE);
+  counter[8]  = (uint8_t)(pHeader->Sequence >> 24);
+  counter[9]  = (uint8_t)(pHeader->Sequence >> 16);
+  counter[10] = (uint8_t)(pHeader->Sequence >> 8);
+  counter[11] = (uint8_t)pHeader->Sequence;
+  counter[12] = 0x00U;
+  counter[13] = 0x00U;
+  counter[14] = 0x00U;
+  counter[15] = 0x01U;
+
+  AESS_SetInitVect(&hetm->Ctr, counter);
+}
+
+/**
+  * @brief  Encrypts or decrypts a payload and feeds the CMAC in one pass.
+  * @param  hetm: pointer to an ETM_HandleTypeDef structure
+  * @param  pInput: input payload
+  * @param  pOutput: output payload, may be pInput
+  * @param  Length: payload length in bytes
+  * @param  MacInput: 1 to authenticate the input (opening a record), 0 to
+  *         authenticate the output (sealing a record)
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef ETM_Process(ETM_HandleTypeDef *hetm, const uint8_t *pInput, uint8_t *pOutput, uint32_t Length, uint8_t MacInput)
+{
+  uint32_t offset = 0U, chunk = 0U;
+
+#if defined(AESS_USE_CRYP)
+  AESS_BufferTypeDef buffer;
+  uint32_t whole = Length - (Length % AESS_BLOCK_SIZE), previous = 0U;
+
+  if((hetm->Ctr.Init.hcryp != NULL) && ((((uint32_t)pInput | (uint32_t)pOutput) & 3U) == 0U) && (whole > 0U))
+  {
+    /* The DMA encrypts chunk n while the CPU authenticates the chunk that is
+       not being transferred: n - 1 when sealing, n + 1 when opening, so that
+       in-place operation never reads a chunk while the DMA rewrites it */
+    if(MacInput != 0U)
+    {
+      chunk = (whole > ETM_CHUNK_SIZE) ? ETM_CHUNK_SIZE : whole;
+      CMAC_Update(&hetm->Cmac, pInput, chunk);
+    }
+    for(offset = 0U; offset < whole; offset += chunk)
+    {
+      chunk = ((whole - offset) > ETM_CHUNK_SIZE) ? ETM_CHUNK_SIZE : (whole - offset);
+      buffer.pInput  = &pInput[offset];
+      buffer.pOutput = &pOutput[offset];
+      buffer.Size    = chunk;
+      if(AESS_Submit(&hetm->Ctr, &buffer, 1U) != HAL_OK)
+      {
+        return HAL_ERROR;
+      }
+
+      if(MacInput != 0U)
+      {
+        if((offset + chunk) < whole)
+        {
+          CMAC_Update(&hetm->Cmac, &pInput[offset + chunk],
+                      ((whole - offset - chunk) > ETM_CHUNK_SIZE) ? ETM_CHUNK_SIZE : (whole - offset - chunk));
+        }
+      }
+      else if(offset > 0U)
+      {
+        CMAC_Update(&hetm->Cmac, &pOutput[previous], offset - previous);
+      }
+      previous = offset;
+
+      if(AESS_PollForQueue(&hetm->Ctr, ETM_TIMEOUT) != HAL_OK)
+      {
+        return HAL_ERROR;
+      }
+    }
+    if(MacInput == 0U)
+    {
+      CMAC_Update(&hetm->Cmac, &pOutput[previous], whole - previous);
+    }
+
+    pInput  += whole;
+    pOutput += whole;
+    Length  -= whole;
+  }
+#endif /* AESS_USE_CRYP */
+
+  for(offset = 0U; offset < Length; offset += chunk)
+  {
+    chunk = ((Length - offset) > ETM_CHUNK_SIZE) ? ETM_CHUNK_SIZE : (Length - offset);
+    if(MacInput != 0U)
+    {
+      CMAC_Update(&hetm->Cmac, &pInput[offset], chunk);
+    }
+    if(AESS_Process(&hetm->Ctr, &pInput[offset], chunk, &pOutput[offset], CMAC_TIMEOUT) != HAL_OK)
+    {
+      return HAL_ERROR;
+    }
+    if(MacInput == 0U)
+    {
+      CMAC_Update(&hetm->Cmac, &pOutput[offset], chunk);
+    }
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
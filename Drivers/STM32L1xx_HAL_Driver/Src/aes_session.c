@@ -0,0 +1,853 @@
+/**
+  ******************************************************************************
+  * @file    aes_session.c
+  * @brief   Session-based AES-128 engine: the key is loaded once, the CBC and
+  *          CTR chaining state carries over from one call to the next, and
+  *          buffers can be queued through DMA back-to-back.
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) Fill AESS_HandleTypeDef.Init with the mode, direction, key and
+       initialization vector. On devices with an AES unit (STM32L162xx), set
+       hcryp to a handle initialized with HAL_CRYP_Init() to run on the unit,
+       or to NULL to run in software. Other devices always run in software.
+   (#) Call AESS_Start() once: the key is loaded into the AES unit, or
+       expanded in software, and kept until AESS_Stop(). While a session
+       runs on the AES unit it owns the unit: HAL_CRYP functions must not be
+       called until AESS_Stop().
+   (#) Process data with AESS_Process(). Successive calls continue the same
+       CBC chain or CTR counter, so a stream can be processed piece by piece.
+       Sizes are multiples of 16 bytes, except for the last piece of a CTR
+       stream. Call AESS_SetInitVect() to start a new chain with the same key,
+       for instance for the next record.
+   (#) Queue several buffers with AESS_Submit(): on the AES unit they are
+       transferred by the CRYP DMA channels one after the other from the DMA
+       interrupt, without reloading the key. The DMA interrupt handlers must
+       call HAL_DMA_IRQHandler() as for HAL_CRYP_AESxxx_DMA() functions.
+       AESS_QueueCpltCallback() is called when the queue is done; the queue
+       can also be waited for with AESS_PollForQueue(). In software, the
+       queue is processed before AESS_Submit() returns.
+   (#) AESS_ExpandKey(), AESS_EncryptBlock() and AESS_DecryptBlock() give the
+       software block cipher alone, for host tools and other modes.
+   (#) As on the AES unit, the CTR counter is the last 32 bits of the counter
+       block, big endian; it wraps without carrying into the other bits.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "aes_session.h"
+#include <string.h>
+
+/** @defgroup AES_SESSION AES_SESSION
+  * @brief Session-based AES-128 engine
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+/** @defgroup AES_SESSION_Private_Constants AES_SESSION Private Constants
+  * @{
+  */
+#define AESS_ROUNDS              10U
+#define AESS_CTR_OFFSET          12U        /* Counter bytes in the counter block */
+/**
+  * @}
+  */
+
+/* Private macro -------------------------------------------------------------*/
+/** @defgroup AES_SESSION_Private_Macros AES_SESSION Private Macros
+  * @{
+  */
+#define AESS_XTIME(__X__)        ((uint8_t)(((__X__) << 1) ^ ((((__X__) >> 7) & 1U) * 0x1BU)))
+#define AESS_BE32(__P__)         (((uint32_t)(__P__)[0] << 24) | ((uint32_t)(__P__)[1] << 16) | \
+                                  ((uint32_t)(__P__)[2] << 8)  |  (uint32_t)(__P__)[3])
+/**
+  * @}
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/** @defgroup AES_SESSION_Private_Variables AES_SESSION Private Variables
+  * @{
+  */
+static const uint8_t AESS_Sbox[256] =
+{
+  0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+  0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+  0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+  0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+  0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+  0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+  0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+  0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+  0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+  0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+  0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+  0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+  0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+  0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+  0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+  0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+static const uint8_t AESS_InvSbox[256] =
+{
+  0x52, 0x09, 0x6A, 0xD5, 0x30, 0x36, 0xA5, 0x38, 0xBF, 0x40, 0xA3, 0x9E, 0x81, 0xF3, 0xD7, 0xFB,
+  0x7C, 0xE3, 0x39, 0x82, 0x9B, 0x2F, 0xFF, 0x87, 0x34, 0x8E, 0x43, 0x44, 0xC4, 0xDE, 0xE9, 0xCB,
+  0x54, 0x7B, 0x94, 0x32, 0xA6, 0xC2, 0x23, 0x3D, 0xEE, 0x4C, 0x95, 0x0B, 0x42, 0xFA, 0xC3, 0x4E,
+  0x08, 0x2E, 0xA1, 0x66, 0x28, 0xD9, 0x24, 0xB2, 0x76, 0x5B, 0xA2, 0x49, 0x6D, 0x8B, 0xD1, 0x25,
+  0x72, 0xF8, 0xF6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xD4, 0xA4, 0x5C, 0xCC, 0x5D, 0x65, 0xB6, 0x92,
+  0x6C, 0x70, 0x48, 0x50, 0xFD, 0xED, 0xB9, 0xDA, 0x5E, 0x15, 0x46, 0x57, 0xA7, 0x8D, 0x9D, 0x84,
+  0x90, 0xD8, 0xAB, 0x00, 0x8C, 0xBC, 0xD3, 0x0A, 0xF7, 0xE4, 0x58, 0x05, 0xB8, 0xB3, 0x45, 0x06,
+  0xD0, 0x2C, 0x1E, 0x8F, 0xCA, 0x3F, 0x0F, 0x02, 0xC1, 0xAF, 0xBD, 0x03, 0x01, 0x13, 0x8A, 0x6B,
+  0x3A, 0x91, 0x11, 0x41, 0x4F, 0x67, 0xDC, 0xEA, 0x97, 0xF2, 0xCF, 0xCE, 0xF0, 0xB4, 0xE6, 0x73,
+  0x96, 0xAC, 0x74, 0x22, 0xE7, 0xAD, 0x35, 0x85, 0xE2, 0xF9, 0x37, 0xE8, 0x1C, 0x75, 0xDF, 0x6E,
+  0x47, 0xF1, 0x1A, 0x71, 0x1D, 0x29, 0xC5, 0x89, 0x6F, 0xB7, 0x62, 0x0E, 0xAA, 0x18, 0xBE, 0x1B,
+  0xFC, 0x56, 0x3E, 0x4B, 0xC6, 0xD2, 0x79, 0x20, 0x9A, 0xDB, 0xC0, 0xFE, 0x78, 0xCD, 0x5A, 0xF4,
+  0x1F, 0xDD, 0xA8, 0x33, 0x88, 0x07, 0xC7, 0x31, 0xB1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xEC, 0x5F,
+  0x60, 0x51, 0x7F, 0xA9, 0x19, 0xB5, 0x4A, 0x0D, 0x2D, 0xE5, 0x7A, 0x9F, 0x93, 0xC9, 0x9C, 0xEF,
+  0xA0, 0xE0, 0x3B, 0x4D, 0xAE, 0x2A, 0xF5, 0xB0, 0xC8, 0xEB, 0xBB, 0x3C, 0x83, 0x53, 0x99, 0x61,
+  0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26, 0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D
+};
+
+#if defined(AESS_USE_CRYP)
+static AESS_HandleTypeDef *AESSActive = NULL;        /* Session of the running DMA queue */
+#endif /* AESS_USE_CRYP */
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup AES_SESSION_Private_Functions AES_SESSION Private Functions
+  * @{
+  */
+static void              AESS_SoftwareBlock(AESS_HandleTypeDef *haes, const uint8_t *pInput, uint8_t *pOutput, uint32_t Size);
+#if defined(AESS_USE_CRYP)
+static void              AESS_LoadKeyAndIV(AESS_HandleTypeDef *haes);
+static HAL_StatusTypeDef AESS_CrypBlock(AESS_HandleTypeDef *haes, const uint8_t *pInput, uint8_t *pOutput, uint32_t Timeout);
+static void              AESS_StartBuffer(AESS_HandleTypeDef *haes);
+static void              AESS_DMAOutCplt(DMA_HandleTypeDef *hdma);
+static void              AESS_DMAError(DMA_HandleTypeDef *hdma);
+#endif /* AESS_USE_CRYP */
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup AES_SESSION_Exported_Functions AES_SESSION Exported Functions
+  * @{
+  */
+
+/** @defgroup AES_SESSION_Exported_Functions_Group1 Session functions
+ *  @brief    Session functions
+ *
+@verbatim
+ ===============================================================================
+                      ##### Session functions #####
+ ===============================================================================
+    [..]
+    This section provides functions allowing to:
+      (+) Load the key and the initialization vector
+      (+) Restart the chain with a new initialization vector
+      (+) Release the AES unit and wipe the key material
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Starts a session: loads the key and the initialization vector.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure whose Init is filled
+  * @retval HAL status
+  */
+HAL_StatusTypeDef AESS_Start(AESS_HandleTypeDef *haes)
+{
+  if((haes == NULL) || (haes->Init.pKey == NULL) || (haes->Init.Mode > AESS_MODE_CTR) ||
+     ((haes->Init.Mode != AESS_MODE_ECB) && (haes->Init.pInitVect == NULL)))
+  {
+    return HAL_ERROR;
+  }
+
+  memcpy(haes->Key, haes->Init.pKey, AESS_KEY_SIZE);
+  memset(haes->Chain, 0, AESS_BLOCK_SIZE);
+  if(haes->Init.Mode != AESS_MODE_ECB)
+  {
+    memcpy(haes->Chain, haes->Init.pInitVect, AESS_BLOCK_SIZE);
+  }
+  haes->pQueue = NULL;
+  haes->QueueCount = 0U;
+  haes->QueueIndex = 0U;
+
+#if defined(AESS_USE_CRYP)
+  if(haes->Init.hcryp != NULL)
+  {
+    if(haes->Init.hcryp->State != HAL_CRYP_STATE_READY)
+    {
+      return HAL_BUSY;
+    }
+    /* The session owns the unit until AESS_Stop() */
+    haes->Init.hcryp->State = HAL_CRYP_STATE_BUSY;
+    AESS_LoadKeyAndIV(haes);
+    haes->State = AESS_STATE_READY;
+    return HAL_OK;
+  }
+#endif /* AESS_USE_CRYP */
+
+  AESS_ExpandKey(haes->Key, haes->RoundKey);
+  haes->State = AESS_STATE_READY;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Starts a new CBC chain or CTR counter, keeping the key.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @param  pInitVect: 16-byte initialization vector or initial counter block
+  * @retval HAL status
+  */
+HAL_StatusTypeDef AESS_SetInitVect(AESS_HandleTypeDef *haes, const uint8_t *pInitVect)
+{
+  if((haes->State != AESS_STATE_READY) && (haes->State != AESS_STATE_ERROR))
+  {
+    return (haes->State == AESS_STATE_BUSY) ? HAL_BUSY : HAL_ERROR;
+  }
+
+  memcpy(haes->Chain, pInitVect, AESS_BLOCK_SIZE);
+  haes->State = AESS_STATE_READY;
+
+#if defined(AESS_USE_CRYP)
+  if(haes->Init.hcryp != NULL)
+  {
+    AESS_LoadKeyAndIV(haes);
+  }
+#endif /* AESS_USE_CRYP */
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Ends a session: releases the AES unit and wipes the key material.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @retval HAL status
+  */
+HAL_StatusTypeDef AESS_Stop(AESS_HandleTypeDef *haes)
+{
+  if(haes->State == AESS_STATE_BUSY)
+  {
+    return HAL_BUSY;
+  }
+
+#if defined(AESS_USE_CRYP)
+  if((haes->Init.hcryp != NULL) && (haes->State != AESS_STATE_RESET))
+  {
+    __HAL_CRYP_DISABLE(haes->Init.hcryp);
+    haes->Init.hcryp->Instance->KEYR0 = 0U;
+    haes->Init.hcryp->Instance->KEYR1 = 0U;
+    haes->Init.hcryp->Instance->KEYR2 = 0U;
+    haes->Init.hcryp->Instance->KEYR3 = 0U;
+    haes->Init.hcryp->State = HAL_CRYP_STATE_READY;
+  }
+#endif /* AESS_USE_CRYP */
+
+  memset(haes->Key, 0, sizeof(haes->Key));
+  memset(haes->RoundKey, 0, sizeof(haes->RoundKey));
+  memset(haes->Chain, 0, sizeof(haes->Chain));
+  haes->State = AESS_STATE_RESET;
+
+  return HAL_OK;
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup AES_SESSION_Exported_Functions_Group2 Processing functions
+ *  @brief    Processing functions
+ *
+@verbatim
+ ===============================================================================
+                      ##### Processing functions #####
+ ===============================================================================
+    [..]
+    This section provides functions allowing to:
+      (+) Process a buffer in polling mode
+      (+) Queue buffers through DMA and wait for the queue
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Processes a buffer, continuing the chain of the previous call.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @param  pInput: input data, any alignment
+  * @param  Size: size in bytes, a multiple of 16 except for the last piece
+  *         of a CTR stream
+  * @param  pOutput: output data, any alignment, may be pInput
+  * @param  Timeout: timeout per block on the AES unit, in ms
+  * @retval HAL status
+  */
+HAL_StatusTypeDef AESS_Process(AESS_HandleTypeDef *haes, const uint8_t *pInput, uint32_t Size, uint8_t *pOutput, uint32_t Timeout)
+{
+  uint8_t block[AESS_BLOCK_SIZE];
+  uint32_t tail = Size % AESS_BLOCK_SIZE;
+
+#if !defined(AESS_USE_CRYP)
+  /* Prevent unused argument(s) compilation warning: only the AES unit times out */
+  UNUSED(Timeout);
+#endif /* AESS_USE_CRYP */
+
+  if(haes->State != AESS_STATE_READY)
+  {
+    return (haes->State == AESS_STATE_BUSY) ? HAL_BUSY : HAL_ERROR;
+  }
+  if((tail != 0U) && (haes->Init.Mode != AESS_MODE_CTR))
+  {
+    return HAL_ERROR;
+  }
+
+  for(Size -= tail; Size > 0U; Size -= AESS_BLOCK_SIZE)
+  {
+#if defined(AESS_USE_CRYP)
+    if(haes->Init.hcryp != NULL)
+    {
+      if(AESS_CrypBlock(haes, pInput, pOutput, Timeout) != HAL_OK)
+      {
+        return HAL_TIMEOUT;
+      }
+    }
+    else
+#endif /* AESS_USE_CRYP */
+    {
+      AESS_SoftwareBlock(haes, pInput, pOutput, AESS_BLOCK_SIZE);
+    }
+    pInput  += AESS_BLOCK_SIZE;
+    pOutput += AESS_BLOCK_SIZE;
+  }
+
+  /* Last partial CTR block: use the start of one key stream block */
+  if(tail != 0U)
+  {
+    memset(block, 0, AESS_BLOCK_SIZE);
+    memcpy(block, pInput, tail);
+#if defined(AESS_USE_CRYP)
+    if(haes->Init.hcryp != NULL)
+    {
+      if(AESS_CrypBlock(haes, block, block, Timeout) != HAL_OK)
+      {
+        return HAL_TIMEOUT;
+      }
+    }
+    else
+#endif /* AESS_USE_CRYP */
+    {
+      AESS_SoftwareBlock(haes, block, block, AESS_BLOCK_SIZE);
+    }
+    memcpy(pOutput, block, tail);
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Queues buffers to be processed one after the other.
+  * @note   On the AES unit the call returns at once; the buffers and the
+  *         queue array must stay valid until the queue is done. The DMA
+  *         channels move words: buffers that are not word aligned are
+  *         refused there.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @param  pQueue: array of buffers
+  * @param  Count: number of buffers
+  * @retval HAL status
+  */
+HAL_StatusTypeDef AESS_Submit(AESS_HandleTypeDef *haes, const AESS_BufferTypeDef *pQueue, uint32_t Count)
+{
+  uint32_t index = 0U;
+
+  if(haes->State != AESS_STATE_READY)
+  {
+    return (haes->State == AESS_STATE_BUSY) ? HAL_BUSY : HAL_ERROR;
+  }
+  for(index = 0U; index < Count; index++)
+  {
+    if(((pQueue[index].Size % AESS_BLOCK_SIZE) != 0U) || ((pQueue[index].Size / 4U) > 0xFFFFU))
+    {
+      return HAL_ERROR;
+    }
+#if defined(AESS_USE_CRYP)
+    if((haes->Init.hcryp != NULL) &&
+       ((((uint32_t)pQueue[index].pInput | (uint32_t)pQueue[index].pOutput) & 3U) != 0U))
+    {
+      return HAL_ERROR;
+    }
+#endif /* AESS_USE_CRYP */
+  }
+  if(Count == 0U)
+  {
+    return HAL_OK;
+  }
+
+  haes->pQueue = pQueue;
+  haes->QueueCount = Count;
+  haes->QueueIndex = 0U;
+
+#if defined(AESS_USE_CRYP)
+  if(haes->Init.hcryp != NULL)
+  {
+    CRYP_HandleTypeDef *hcryp = haes->Init.hcryp;
+
+    AESSActive = haes;
+    haes->State = AESS_STATE_BUSY;
+
+    hcryp->hdmain->XferCpltCallback   = NULL;
+    hcryp->hdmain->XferErrorCallback  = AESS_DMAError;
+    hcryp->hdmaout->XferCpltCallback  = AESS_DMAOutCplt;
+    hcryp->hdmaout->XferErrorCallback = AESS_DMAError;
+
+    AESS_StartBuffer(haes);
+    SET_BIT(hcryp->Instance->CR, (AES_CR_DMAINEN | AES_CR_DMAOUTEN));
+    return HAL_OK;
+  }
+#endif /* AESS_USE_CRYP */
+
+  for(index = 0U; index < Count; index++)
+  {
+    haes->QueueIndex = index;
+    AESS_SoftwareBlock(haes, pQueue[index].pInput, pQueue[index].pOutput, pQueue[index].Size);
+  }
+  haes->QueueIndex = Count;
+  AESS_QueueCpltCallback(haes);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Waits for the end of the DMA queue.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @param  Timeout: timeout in ms
+  * @retval HAL status, HAL_ERROR when the queue was aborted by a DMA error
+  */
+HAL_StatusTypeDef AESS_PollForQueue(AESS_HandleTypeDef *haes, uint32_t Timeout)
+{
+  uint32_t tickstart = HAL_GetTick();
+
+  while(haes->State == AESS_STATE_BUSY)
+  {
+    if((Timeout != HAL_MAX_DELAY) && ((HAL_GetTick() - tickstart) > Timeout))
+    {
+      return HAL_TIMEOUT;
+    }
+  }
+
+  return (haes->State == AESS_STATE_READY) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+  * @brief  DMA queue completion callback.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @retval None
+  */
+__weak void AESS_QueueCpltCallback(AESS_HandleTypeDef *haes)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(haes);
+
+  /* NOTE : This function should not be modified; when the callback is needed,
+            the AESS_QueueCpltCallback can be implemented in the user file
+   */
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup AES_SESSION_Exported_Functions_Group3 Software block cipher
+ *  @brief    Software block cipher
+ *
+@verbatim
+ ===============================================================================
+                      ##### Software block cipher #####
+ ===============================================================================
+    [..]
+    This section provides the portable AES-128 block cipher (FIPS-197) the
+    software sessions run on.
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Expands an AES-128 key.
+  * @param  pKey: 16-byte key
+  * @param  pRoundKey: receives the 176-byte key schedule
+  * @retval None
+  */
+void AESS_ExpandKey(const uint8_t *pKey, uint8_t *pRoundKey)
+{
+  uint8_t temp[4];
+  uint8_t rcon = 0x01U, swap = 0U;
+  uint32_t index = 0U;
+
+  memcpy(pRoundKey, pKey, AESS_KEY_SIZE);
+
+  for(index = AESS_KEY_SIZE; index < ((AESS_ROUNDS + 1U) * AESS_BLOCK_SIZE); index += 4U)
+  {
+    memcpy(temp, &pRoundKey[index - 4U], 4U);
+    if((index % AESS_KEY_SIZE) == 0U)
+    {
+      /* RotWord, SubWord, Rcon */
+      swap    = temp[0];
+      temp[0] = AESS_Sbox[temp[1]] ^ rcon;
+      temp[1] = AESS_Sbox[temp[2]];
+      temp[2] = AESS_Sbox[temp[3]];
+      temp[3] = AESS_Sbox[swap];
+      rcon    = AESS_XTIME(rcon);
+    }
+    pRoundKey[index]      = pRoundKey[index - AESS_KEY_SIZE]      ^ temp[0];
+    pRoundKey[index + 1U] = pRoundKey[index - AESS_KEY_SIZE + 1U] ^ temp[1];
+    pRoundKey[index + 2U] = pRoundKey[index - AESS_KEY_SIZE + 2U] ^ temp[2];
+    pRoundKey[index + 3U] = pRoundKey[index - AESS_KEY_SIZE + 3U] ^ temp[3];
+  }
+}
+
+/**
+  * @brief  Encrypts one block.
+  * @param  pRoundKey: key schedule from AESS_ExpandKey()
+  * @param  pInput: 16-byte plain block
+  * @param  pOutput: receives the cipher block, may be pInput
+  * @retval None
+  */
+void AESS_EncryptBlock(const uint8_t *pRoundKey, const uint8_t *pInput, uint8_t *pOutput)
+{
+  uint8_t state[AESS_BLOCK_SIZE], shifted[AESS_BLOCK_SIZE];
+  uint8_t a0 = 0U, a1 = 0U, a2 = 0U, a3 = 0U, all = 0U;
+  uint32_t round = 0U, column = 0U, index = 0U;
+
+  for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+  {
+    state[index] = pInput[index] ^ pRoundKey[index];
+  }
+
+  for(round = 1U; round <= AESS_ROUNDS; round++)
+  {
+    /* SubBytes and ShiftRows: row r of column c comes from column c + r */
+    for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+    {
+      shifted[index] = AESS_Sbox[state[(index + (4U * (index & 3U))) & 15U]];
+    }
+
+    /* MixColumns, except in the last round */
+    for(column = 0U; column < AESS_BLOCK_SIZE; column += 4U)
+    {
+      a0 = shifted[column];
+      a1 = shifted[column + 1U];
+      a2 = shifted[column + 2U];
+      a3 = shifted[column + 3U];
+      if(round != AESS_ROUNDS)
+      {
+        all = a0 ^ a1 ^ a2 ^ a3;
+        shifted[column]      = a0 ^ all ^ AESS_XTIME(a0 ^ a1);
+        shifted[column + 1U] = a1 ^ all ^ AESS_XTIME(a1 ^ a2);
+        shifted[column + 2U] = a2 ^ all ^ AESS_XTIME(a2 ^ a3);
+        shifted[column + 3U] = a3 ^ all ^ AESS_XTIME(a3 ^ a0);
+      }
+    }
+
+    for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+    {
+      state[index] = shifted[index] ^ pRoundKey[(round * AESS_BLOCK_SIZE) + index];
+    }
+  }
+
+  memcpy(pOutput, state, AESS_BLOCK_SIZE);
+}
+
+/**
+  * @brief  Decrypts one block.
+  * @param  pRoundKey: key schedule from AESS_ExpandKey()
+  * @param  pInput: 16-byte cipher block
+  * @param  pOutput: receives the plain block, may be pInput
+  * @retval None
+  */
+void AESS_DecryptBlock(const uint8_t *pRoundKey, const uint8_t *pInput, uint8_t *pOutput)
+{
+  uint8_t state[AESS_BLOCK_SIZE], shifted[AESS_BLOCK_SIZE];
+  uint8_t a0 = 0U, a1 = 0U, a2 = 0U, a3 = 0U, u = 0U, v = 0U, all = 0U;
+  uint32_t round = 0U, column = 0U, index = 0U;
+
+  for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+  {
+    state[index] = pInput[index] ^ pRoundKey[(AESS_ROUNDS * AESS_BLOCK_SIZE) + index];
+  }
+
+  for(round = AESS_ROUNDS; round > 0U; round--)
+  {
+    /* InvShiftRows and InvSubBytes: row r of column c comes from column c - r */
+    for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+    {
+      shifted[index] = AESS_InvSbox[state[(index + 16U - (4U * (index & 3U))) & 15U]];
+    }
+
+    for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+    {
+      shifted[index] ^= pRoundKey[((round - 1U) * AESS_BLOCK_SIZE) + index];
+    }
+
+    /* InvMixColumns, except in the last round: a pre-multiplication
+       by {04}x^2 + {05} turns it into MixColumns */
+    if(round != 1U)
+    {
+      for(column = 0U; column < AESS_BLOCK_SIZE; column += 4U)
+      {
+        u  = AESS_XTIME(AESS_XTIME(shifted[column] ^ shifted[column + 2U]));
+        v  = AESS_XTIME(AESS_XTIME(shifted[column + 1U] ^ shifted[column + 3U]));
+        a0 = shifted[column] ^ u;
+        a1 = shifted[column + 1U] ^ v;
+        a2 = shifted[column + 2U] ^ u;
+        a3 = shifted[column + 3U] ^ v;
+        all = a0 ^ a1 ^ a2 ^ a3;
+        shifted[column]      = a0 ^ all ^ AESS_XTIME(a0 ^ a1);
+        shifted[column + 1U] = a1 ^ all ^ AESS_XTIME(a1 ^ a2);
+        shifted[column + 2U] = a2 ^ all ^ AESS_XTIME(a2 ^ a3);
+        shifted[column + 3U] = a3 ^ all ^ AESS_XTIME(a3 ^ a0);
+      }
+    }
+
+    memcpy(state, shifted, AESS_BLOCK_SIZE);
+  }
+
+  memcpy(pOutput, state, AESS_BLOCK_SIZE);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Private functions ---------------------------------------------------------*/
+/** @addtogroup AES_SESSION_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Processes whole blocks in software, updating the chain.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @param  pInput: input data
+  * @param  pOutput: output data, may be pInput
+  * @param  Size: size in bytes, a multiple of 16
+  * @retval None
+  */
+static void AESS_SoftwareBlock(AESS_HandleTypeDef *haes, const uint8_t *pInput, uint8_t *pOutput, uint32_t Size)
+{
+  uint8_t block[AESS_BLOCK_SIZE], saved[AESS_BLOCK_SIZE];
+  uint32_t index = 0U, counter = 0U;
+
+  for(; Size > 0U; Size -= AESS_BLOCK_SIZE)
+  {
+    switch(haes->Init.Mode)
+    {
+      case AESS_MODE_CBC:
+        if(haes->Init.Direction == AESS_ENCRYPT)
+        {
+          for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+          {
+            block[index] = pInput[index] ^ haes->Chain[index];
+          }
+          AESS_EncryptBlock(haes->RoundKey, block, pOutput);
+          memcpy(haes->Chain, pOutput, AESS_BLOCK_SIZE);
+        }
+        else
+        {
+          memcpy(saved, pInput, AESS_BLOCK_SIZE);
+          AESS_DecryptBlock(haes->RoundKey, saved, block);
+          for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+          {
+            pOutput[index] = block[index] ^ haes->Chain[index];
+          }
+          memcpy(haes->Chain, saved, AESS_BLOCK_SIZE);
+        }
+        break;
+
+      case AESS_MODE_CTR:
+        AESS_EncryptBlock(haes->RoundKey, haes->Chain, block);
+        for(index = 0U; index < AESS_BLOCK_SIZE; index++)
+        {
+          pOutput[index] = pInput[index] ^ block[index];
+        }
+        counter = AESS_BE32(&haes->Chain[AESS_CTR_OFFSET]) + 1U;
+        haes->Chain[AESS_CTR_OFFSET]      = (uint8_t)(counter >> 24);
+        haes->Chain[AESS_CTR_OFFSET + 1U] = (uint8_t)(counter >> 16);
+        haes->Chain[AESS_CTR_OFFSET + 2U] = (uint8_t)(counter >> 8);
+        haes->Chain[AESS_CTR_OFFSET + 3U] = (uint8_t)counter;
+        break;
+
+      default:
+        if(haes->Init.Direction == AESS_ENCRYPT)
+        {
+          AESS_EncryptBlock(haes->RoundKey, pInput, pOutput);
+        }
+        else
+        {
+          AESS_DecryptBlock(haes->RoundKey, pInput, pOutput);
+        }
+        break;
+    }
+    pInput  += AESS_BLOCK_SIZE;
+    pOutput += AESS_BLOCK_SIZE;
+  }
+}
+
+#if defined(AESS_USE_CRYP)
+/**
+  * @brief  Configures the AES unit and loads the key and the chain block.
+  * @note   Decryption modes derive the decryption key when the unit is
+  *         enabled, so the key is written again with every new vector.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @retval None
+  */
+static void AESS_LoadKeyAndIV(AESS_HandleTypeDef *haes)
+{
+  CRYP_HandleTypeDef *hcryp = haes->Init.hcryp;
+  uint32_t mode = CRYP_CR_ALGOMODE_AES_ECB_ENCRYPT;
+
+  switch(haes->Init.Mode)
+  {
+    case AESS_MODE_CBC:
+      mode = (haes->Init.Direction == AESS_ENCRYPT) ? CRYP_CR_ALGOMODE_AES_CBC_ENCRYPT : CRYP_CR_ALGOMODE_AES_CBC_KEYDERDECRYPT;
+      break;
+    case AESS_MODE_CTR:
+      mode = (haes->Init.Direction == AESS_ENCRYPT) ? CRYP_CR_ALGOMODE_AES_CTR_ENCRYPT : CRYP_CR_ALGOMODE_AES_CTR_DECRYPT;
+      break;
+    default:
+      mode = (haes->Init.Direction == AESS_ENCRYPT) ? CRYP_CR_ALGOMODE_AES_ECB_ENCRYPT : CRYP_CR_ALGOMODE_AES_ECB_KEYDERDECRYPT;
+      break;
+  }
+
+  __HAL_CRYP_DISABLE(hcryp);
+  MODIFY_REG(hcryp->Instance->CR, (AES_CR_DATATYPE | CRYP_CR_ALGOMODE_DIRECTION | AES_CR_DMAINEN | AES_CR_DMAOUTEN),
+             (CRYP_DATATYPE_8B | mode));
+
+  hcryp->Instance->KEYR3 = AESS_BE32(&haes->Key[0]);
+  hcryp->Instance->KEYR2 = AESS_BE32(&haes->Key[4]);
+  hcryp->Instance->KEYR1 = AESS_BE32(&haes->Key[8]);
+  hcryp->Instance->KEYR0 = AESS_BE32(&haes->Key[12]);
+  if(haes->Init.Mode != AESS_MODE_ECB)
+  {
+    hcryp->Instance->IVR3 = AESS_BE32(&haes->Chain[0]);
+    hcryp->Instance->IVR2 = AESS_BE32(&haes->Chain[4]);
+    hcryp->Instance->IVR1 = AESS_BE32(&haes->Chain[8]);
+    hcryp->Instance->IVR0 = AESS_BE32(&haes->Chain[12]);
+  }
+
+  __HAL_CRYP_CLEAR_FLAG(hcryp, CRYP_CLEARFLAG_CCF);
+  __HAL_CRYP_ENABLE(hcryp);
+}
+
+/**
+  * @brief  Processes one block on the AES unit in polling mode.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @param  pInput: 16-byte input block, any alignment
+  * @param  pOutput: receives the output block, any alignment
+  * @param  Timeout: timeout in ms
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef AESS_CrypBlock(AESS_HandleTypeDef *haes, const uint8_t *pInput, uint8_t *pOutput, uint32_t Timeout)
+{
+  AES_TypeDef *instance = haes->Init.hcryp->Instance;
+  uint32_t words[4];
+  uint32_t tickstart = 0U;
+
+  memcpy(words, pInput, AESS_BLOCK_SIZE);
+  instance->DINR = words[0];
+  instance->DINR = words[1];
+  instance->DINR = words[2];
+  instance->DINR = words[3];
+
+  tickstart = HAL_GetTick();
+  while(HAL_IS_BIT_CLR(instance->SR, AES_SR_CCF))
+  {
+    if((Timeout != HAL_MAX_DELAY) && ((HAL_GetTick() - tickstart) > Timeout))
+    {
+      return HAL_TIMEOUT;
+    }
+  }
+  __HAL_CRYP_CLEAR_FLAG(haes->Init.hcryp, CRYP_CLEARFLAG_CCF);
+
+  words[0] = instance->DOUTR;
+  words[1] = instance->DOUTR;
+  words[2] = instance->DOUTR;
+  words[3] = instance->DOUTR;
+  memcpy(pOutput, words, AESS_BLOCK_SIZE);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Starts the DMA transfers of the current queue buffer.
+  * @param  haes: pointer to an AESS_HandleTypeDef structure
+  * @retval None
+  */
+static void AESS_StartBuffer(AESS_HandleTypeDef *haes)
+{
+  CRYP_HandleTypeDef *hcryp = haes->Init.hcryp;
+  const AESS_BufferTypeDef *buffer = &haes->pQueue[haes->QueueIndex];
+
+  /* Output first, so that no result is produced before its channel runs */
+  HAL_DMA_Start_IT(hcryp->hdmaout, (uint32_t)&hcryp->Instance->DOUTR, (uint32_t)buffer->pOutput, buffer->Size / 4U);
+  HAL_DMA_Start_IT(hcryp->hdmain, (uint32_t)buffer->pInput, (uint32_t)&hcryp->Instance->DINR, buffer->Size / 4U);
+}
+
+/**
+  * @brief  Output DMA complete callback: chains the next queue buffer.
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void AESS_DMAOutCplt(DMA_HandleTypeDef *hdma)
+{
+  AESS_HandleTypeDef *haes = AESSActive;
+
+  UNUSED(hdma);
+
+  haes->QueueIndex++;
+  if(haes->QueueIndex < haes->QueueCount)
+  {
+    AESS_StartBuffer(haes);
+    return;
+  }
+
+  CLEAR_BIT(haes->Init.hcryp->Instance->CR, (AES_CR_DMAINEN | AES_CR_DMAOUTEN));
+  haes->State = AESS_STATE_READY;
+  AESSActive = NULL;
+  AESS_QueueCpltCallback(haes);
+}
+
+/**
+  * @brief  DMA error callback: aborts the queue.
+  * @note   The chain state of the unit is lost: the session must be
+  *         restarted with AESS_SetInitVect() after AESS_STATE_ERROR.
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void AESS_DMAError(DMA_HandleTypeDef *hdma)
+{
+  AESS_HandleTypeDef *haes = AESSActive;
+
+  UNUSED(hdma);
+
+  HAL_DMA_Abort(haes->Init.hcryp->hdmain);
+  HAL_DMA_Abort(haes->Init.hcryp->hdmaout);
+  CLEAR_BIT(haes->Init.hcryp->Instance->CR, (AES_CR_DMAINEN | AES_CR_DMAOUTEN));
+  haes->State = AESS_STATE_ERROR;
+  AESSActive = NULL;
+  AESS_QueueCpltCallback(haes);
+}
+#endif /* AESS_USE_CRYP */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
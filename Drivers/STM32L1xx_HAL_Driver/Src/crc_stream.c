@@ -0,0 +1,336 @@
+/**
+  ******************************************************************************
+  * @file    crc_stream.c
+  * @brief   Streaming CRC computation on the CRC unit, for byte buffers of any
+  *          length and alignment, fed by the CPU or by DMA.
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) Initialize the CRC unit with HAL_CRC_Init(). For DMA feeding, also
+       initialize a DMA channel with HAL_DMA_Init() in memory-to-memory mode:
+       the buffer is the source (PeriphInc enabled), the CRC data register
+       the destination (MemInc disabled), both with word alignment, normal
+       mode. Any free channel can be used.
+   (#) Fill CRCS_HandleTypeDef.Init and call CRCS_Start() for every new
+       stream, then pass the data with CRCS_Update() in as many pieces as
+       needed, and get the result with CRCS_Finish().
+   (#) Several streams can be computed at the same time: each context keeps
+       its own CRC value and reloads it into the unit on every CRCS_Update().
+   (#) CRCS_Software() computes the same CRC without the CRC unit, for
+       checking the result or for a host tool.
+
+                     ##### CRC definition #####
+  ==============================================================================
+  [..]
+   (#) The stream is cut into 32-bit little-endian words from its first byte,
+       and every word goes through the CRC unit as HAL_CRC_Calculate() does:
+       CRC-32 polynomial 0x04C11DB7, initial value 0xFFFFFFFF, most
+       significant bit first, no output inversion. A stream of whole words
+       thus gives the HAL_CRC_Calculate() value of the same buffer.
+   (#) The last 1 to 3 bytes of a stream that is not a whole number of words
+       are processed one at a time, most significant bit first.
+   (#) Pieces given to CRCS_Update() need not end on a word: the bytes of an
+       incomplete word are kept in the context until the word is complete.
+       Words whose bytes are not aligned in memory are assembled by the CPU;
+       word-aligned runs of at least DmaThreshold bytes go to the DMA.
+   (#) The CRC unit cannot be preset to a value. A context's CRC is reloaded
+       by resetting the unit, then writing the one word that brings
+       0xFFFFFFFF to that value.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "crc_stream.h"
+
+/** @defgroup CRC_STREAM CRC_STREAM
+  * @brief Streaming CRC computation on the CRC unit
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+/** @defgroup CRC_STREAM_Private_Constants CRC_STREAM Private Constants
+  * @{
+  */
+#define CRCS_DMA_TIMEOUT         1000U      /* ms, per DMA transfer */
+/**
+  * @}
+  */
+
+/* Private macro -------------------------------------------------------------*/
+/** @defgroup CRC_STREAM_Private_Macros CRC_STREAM Private Macros
+  * @{
+  */
+/* Access to the CRC unit, which a host build can replace by a model */
+#ifndef CRCS_UNIT_RESET
+#define CRCS_UNIT_RESET(__HANDLE__)              __HAL_CRC_DR_RESET(__HANDLE__)
+#define CRCS_UNIT_WRITE(__HANDLE__, __WORD__)    ((__HANDLE__)->Instance->DR = (__WORD__))
+#define CRCS_UNIT_READ(__HANDLE__)               ((__HANDLE__)->Instance->DR)
+#endif /* CRCS_UNIT_RESET */
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup CRC_STREAM_Private_Functions CRC_STREAM Private Functions
+  * @{
+  */
+static uint32_t          CRCS_Shift(uint32_t Crc, uint32_t Bits);
+static uint32_t          CRCS_Unshift(uint32_t Crc);
+static HAL_StatusTypeDef CRCS_FeedDMA(CRCS_HandleTypeDef *hcrcs, const uint32_t *pWords, uint32_t Count);
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup CRC_STREAM_Exported_Functions CRC_STREAM Exported Functions
+  * @{
+  */
+
+/**
+  * @brief  Starts a new stream.
+  * @param  hcrcs: pointer to a CRCS_HandleTypeDef structure whose Init is filled
+  * @retval None
+  */
+void CRCS_Start(CRCS_HandleTypeDef *hcrcs)
+{
+  hcrcs->Crc          = CRCS_INIT_VALUE;
+  hcrcs->Length       = 0U;
+  hcrcs->PendingCount = 0U;
+}
+
+/**
+  * @brief  Adds data to a stream.
+  * @param  hcrcs: pointer to a CRCS_HandleTypeDef structure
+  * @param  pData: data, any alignment
+  * @param  Length: data length in bytes
+  * @retval HAL status
+  */
+HAL_StatusTypeDef CRCS_Update(CRCS_HandleTypeDef *hcrcs, const void *pData, uint32_t Length)
+{
+  CRC_HandleTypeDef *hcrc = hcrcs->Init.hcrc;
+  const uint8_t *data = (const uint8_t *)pData;
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t words = 0U, word = 0U;
+
+  hcrcs->Length += Length;
+
+  /* Not enough to complete a word: keep the bytes for later */
+  if((hcrcs->PendingCount + Length) < 4U)
+  {
+    while(Length-- > 0U)
+    {
+      hcrcs->Pending[hcrcs->PendingCount++] = *data++;
+    }
+    return HAL_OK;
+  }
+
+  /* Process Locked */
+  __HAL_LOCK(hcrc);
+  hcrc->State = HAL_CRC_STATE_BUSY;
+
+  /* Load the CRC of the context into the unit */
+  CRCS_UNIT_RESET(hcrc);
+  if(hcrcs->Crc != CRCS_INIT_VALUE)
+  {
+    CRCS_UNIT_WRITE(hcrc, CRCS_Unshift(hcrcs->Crc) ^ CRCS_INIT_VALUE);
+  }
+
+  /* Complete the pending word */
+  if(hcrcs->PendingCount != 0U)
+  {
+    while(hcrcs->PendingCount < 4U)
+    {
+      hcrcs->Pending[hcrcs->PendingCount++] = *data++;
+      Length--;
+    }
+    CRCS_UNIT_WRITE(hcrc, (uint32_t)hcrcs->Pending[0] | ((uint32_t)hcrcs->Pending[1] << 8) |
+                          ((uint32_t)hcrcs->Pending[2] << 16) | ((uint32_t)hcrcs->Pending[3] << 24));
+    hcrcs->PendingCount = 0U;
+  }
+
+  words = Length / 4U;
+  if(((uint32_t)data & 3U) != 0U)
+  {
+    /* Misaligned run: assemble each word from bytes */
+    while(words-- > 0U)
+    {
+      word = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+      CRCS_UNIT_WRITE(hcrc, word);
+      data += 4;
+    }
+  }
+  else if((hcrcs->Init.hdma != NULL) && ((words * 4U) >= hcrcs->Init.DmaThreshold))
+  {
+    status = CRCS_FeedDMA(hcrcs, (const uint32_t *)data, words);
+    data += words * 4U;
+  }
+  else
+  {
+    while(words-- > 0U)
+    {
+      CRCS_UNIT_WRITE(hcrc, *(const uint32_t *)data);
+      data += 4;
+    }
+  }
+
+  /* Keep the tail for the next call */
+  for(Length &= 3U; Length > 0U; Length--)
+  {
+    hcrcs->Pending[hcrcs->PendingCount++] = *data++;
+  }
+
+  hcrcs->Crc = CRCS_UNIT_READ(hcrc);
+
+  hcrc->State = (status == HAL_OK) ? HAL_CRC_STATE_READY : HAL_CRC_STATE_ERROR;
+  __HAL_UNLOCK(hcrc);
+
+  return status;
+}
+
+/**
+  * @brief  Ends a stream and returns its CRC.
+  * @param  hcrcs: pointer to a CRCS_HandleTypeDef structure
+  * @retval CRC of the stream
+  */
+uint32_t CRCS_Finish(CRCS_HandleTypeDef *hcrcs)
+{
+  uint32_t crc = hcrcs->Crc, index = 0U;
+
+  for(index = 0U; index < hcrcs->PendingCount; index++)
+  {
+    crc = CRCS_Shift(crc ^ ((uint32_t)hcrcs->Pending[index] << 24), 8U);
+  }
+  hcrcs->PendingCount = 0U;
+  hcrcs->Crc = crc;
+
+  return crc;
+}
+
+/**
+  * @brief  Computes the CRC of a buffer without the CRC unit.
+  * @note   The result is the one of CRCS_Start(), CRCS_Update() and
+  *         CRCS_Finish() over the same bytes. Crc may also be the result of
+  *         a previous call over a whole number of words.
+  * @param  Crc: initial value, CRCS_INIT_VALUE for a new stream
+  * @param  pData: data, any alignment
+  * @param  Length: data length in bytes
+  * @retval CRC of the buffer
+  */
+uint32_t CRCS_Software(uint32_t Crc, const void *pData, uint32_t Length)
+{
+  static const uint32_t table[16] =
+  {
+    0x00000000U, 0x04C11DB7U, 0x09823B6EU, 0x0D4326D9U, 0x130476DCU, 0x17C56B6BU, 0x1A864DB2U, 0x1E475005U,
+    0x2608EDB8U, 0x22C9F00FU, 0x2F8AD6D6U, 0x2B4BCB61U, 0x350C9B64U, 0x31CD86D3U, 0x3C8EA00AU, 0x384FBDBDU
+  };
+  const uint8_t *data = (const uint8_t *)pData;
+  uint32_t word = 0U, nibble = 0U;
+
+  for(; Length >= 4U; Length -= 4U)
+  {
+    word = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    Crc ^= word;
+    for(nibble = 0U; nibble < 8U; nibble++)
+    {
+      Crc = (Crc << 4) ^ table[Crc >> 28];
+    }
+    data += 4;
+  }
+
+  for(; Length > 0U; Length--)
+  {
+    Crc ^= (uint32_t)*data++ << 24;
+    Crc = (Crc << 4) ^ table[Crc >> 28];
+    Crc = (Crc << 4) ^ table[Crc >> 28];
+  }
+
+  return Crc;
+}
+
+/**
+  * @}
+  */
+
+/* Private functions ---------------------------------------------------------*/
+/** @addtogroup CRC_STREAM_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Shifts bits out of a CRC register, most significant bit first.
+  * @param  Crc: CRC register
+  * @param  Bits: number of bits
+  * @retval CRC register
+  */
+static uint32_t CRCS_Shift(uint32_t Crc, uint32_t Bits)
+{
+  while(Bits-- > 0U)
+  {
+    Crc = ((Crc & 0x80000000U) != 0U) ? ((Crc << 1) ^ CRCS_POLYNOMIAL) : (Crc << 1);
+  }
+
+  return Crc;
+}
+
+/**
+  * @brief  Reverts 32 shifts of a CRC register.
+  * @note   The polynomial has its low bit set, so the low bit of a shifted
+  *         register tells whether the polynomial was added.
+  * @param  Crc: CRC register
+  * @retval Register value that CRCS_Shift(Value, 32) turns into Crc
+  */
+static uint32_t CRCS_Unshift(uint32_t Crc)
+{
+  uint32_t bits = 0U;
+
+  for(bits = 0U; bits < 32U; bits++)
+  {
+    Crc = ((Crc & 1U) != 0U) ? (((Crc ^ CRCS_POLYNOMIAL) >> 1) | 0x80000000U) : (Crc >> 1);
+  }
+
+  return Crc;
+}
+
+/**
+  * @brief  Feeds word-aligned words to the CRC unit by DMA.
+  * @param  hcrcs: pointer to a CRCS_HandleTypeDef structure
+  * @param  pWords: words, word aligned
+  * @param  Count: number of words
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef CRCS_FeedDMA(CRCS_HandleTypeDef *hcrcs, const uint32_t *pWords, uint32_t Count)
+{
+  DMA_HandleTypeDef *hdma = hcrcs->Init.hdma;
+  uint32_t chunk = 0U;
+
+  while(Count > 0U)
+  {
+    chunk = (Count > CRCS_DMA_MAX_WORDS) ? CRCS_DMA_MAX_WORDS : Count;
+
+    if(HAL_DMA_Start(hdma, (uint32_t)pWords, (uint32_t)&hcrcs->Init.hcrc->Instance->DR, chunk) != HAL_OK)
+    {
+      return HAL_ERROR;
+    }
+    if(HAL_DMA_PollForTransfer(hdma, HAL_DMA_FULL_TRANSFER, CRCS_DMA_TIMEOUT) != HAL_OK)
+    {
+      HAL_DMA_Abort(hdma);
+      return HAL_ERROR;
+    }
+
+    pWords += chunk;
+    Count  -= chunk;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
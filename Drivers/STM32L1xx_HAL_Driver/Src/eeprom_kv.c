@@ -0,0 +1,823 @@
+/**
+  ******************************************************************************
+  * @file    eeprom_kv.c
+  * @brief   Wear-levelled key-value store kept in the STM32L1 data EEPROM.
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+   (#) Fill KV_HandleTypeDef.Init with the data EEPROM area given to the store,
+       for instance the whole memory:
+         hkv.Init.BaseAddress = FLASH_EEPROM_BASE;
+         hkv.Init.Size        = FLASH_EEPROM_END - FLASH_EEPROM_BASE + 1;
+   (#) Call KV_Init() once at start-up. It finds the active bank, replays the
+       record log into the in-RAM index and drops a record torn by a power
+       failure. An empty or foreign area is formatted.
+   (#) Read values with KV_Get(), store them with KV_Put() and remove them with
+       KV_Delete(). Keys are 16-bit numbers, values hold up to 255 bytes.
+   (#) Surround a group of updates with KV_BeginBatch() / KV_EndBatch() to
+       program them all inside one data EEPROM unlock window.
+
+                     ##### Storage layout #####
+  ==============================================================================
+  [..]
+   (#) The area is split in two banks. The active bank starts with a header
+       holding a generation number and is filled by appending records, so
+       successive updates of one key spread over the whole bank instead of
+       wearing the same cells.
+   (#) A record is a header word (key, length, tag), a word holding the bank
+       generation and a CRC-16 of the record, then the value padded to a word.
+       The header word is programmed last: a record whose header, generation
+       or CRC does not check marks the end of the log.
+   (#) When the active bank is full, the latest record of every live key and
+       the pending update are copied to the other bank, then its header is
+       written with the next generation number. Until that header is complete
+       the old bank stays the newest one, so an interrupted compaction loses
+       nothing.
+   (#) Erased data EEPROM reads as zero and needs no block erase: the spare
+       bank is overwritten in place and stale records from older generations
+       are told apart by their generation number.
+   (#) An interrupted compaction leaves records of the next generation in the
+       spare bank, which the next compaction writes again. Before a record is
+       committed, and before a compaction commits its bank, the slot that
+       follows is cleared to a zero word when it holds a record of the same
+       generation, so that such leftovers never extend the log.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "eeprom_kv.h"
+#include <string.h>
+
+/** @defgroup EEPROM_KV EEPROM_KV
+  * @brief Wear-levelled key-value store in data EEPROM
+  * @{
+  */
+
+/* Private define ------------------------------------------------------------*/
+/** @defgroup EEPROM_KV_Private_Constants EEPROM_KV Private Constants
+  * @{
+  */
+#define KV_BANK_MAGIC            0x4B56U    /* 'KV' */
+#define KV_BANK_HEADER_SIZE      8U
+#define KV_RECORD_HEADER_SIZE    8U
+#define KV_TAG_DATA              0x5AU
+#define KV_TAG_DELETED           0xA5U
+#define KV_TAG_NONE              0x00U
+#define KV_CRC_INIT              0xFFFFU
+#define KV_CRC_POLY              0x1021U
+/**
+  * @}
+  */
+
+/* Private macro -------------------------------------------------------------*/
+/** @defgroup EEPROM_KV_Private_Macros EEPROM_KV Private Macros
+  * @{
+  */
+#define KV_READ_WORD(__ADDRESS__)          (*(__IO uint32_t *)(__ADDRESS__))
+#define KV_ALIGN(__LENGTH__)               (((__LENGTH__) + 3U) & ~3U)
+#define KV_RECORD_SIZE(__LENGTH__)         (KV_RECORD_HEADER_SIZE + KV_ALIGN(__LENGTH__))
+#define KV_BANK_SIZE(__HANDLE__)           ((__HANDLE__)->Init.Size / 2U)
+#define KV_BANK_END(__HANDLE__)            ((__HANDLE__)->BankAddress + KV_BANK_SIZE(__HANDLE__))
+#define KV_HEADER(__KEY__, __LEN__, __TAG__) (((uint32_t)(__KEY__) << 16) | ((uint32_t)(__LEN__) << 8) | (__TAG__))
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup EEPROM_KV_Private_Functions EEPROM_KV Private Functions
+  * @{
+  */
+static uint16_t          KV_RecordCrc(uint32_t Header, uint16_t Sequence, const uint8_t *pData, uint32_t Length);
+static uint32_t          KV_ReadBankHeader(uint32_t Address, uint16_t *pSequence);
+static HAL_StatusTypeDef KV_Scan(KV_HandleTypeDef *hkv);
+static uint32_t          KV_IndexFind(KV_HandleTypeDef *hkv, uint16_t Key, uint32_t *pPosition);
+static HAL_StatusTypeDef KV_IndexUpdate(KV_HandleTypeDef *hkv, uint16_t Key, uint16_t Length, uint32_t Address);
+static void              KV_IndexRemove(KV_HandleTypeDef *hkv, uint16_t Key);
+static void              KV_Unlock(KV_HandleTypeDef *hkv);
+static void              KV_Lock(KV_HandleTypeDef *hkv);
+static HAL_StatusTypeDef KV_ProgramWord(uint32_t Address, uint32_t Data);
+static HAL_StatusTypeDef KV_EndLog(uint32_t Address, uint32_t End, uint16_t Sequence);
+static HAL_StatusTypeDef KV_WriteRecord(uint32_t Address, uint32_t Header, uint16_t Sequence, const uint8_t *pData, uint32_t Length);
+static HAL_StatusTypeDef KV_Update(KV_HandleTypeDef *hkv, uint16_t Key, uint32_t Tag, const uint8_t *pData, uint32_t Length);
+static HAL_StatusTypeDef KV_Rewrite(KV_HandleTypeDef *hkv, uint16_t Key, uint32_t Tag, const uint8_t *pData, uint32_t Length);
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup EEPROM_KV_Exported_Functions EEPROM_KV Exported Functions
+  * @{
+  */
+
+/** @defgroup EEPROM_KV_Exported_Functions_Group1 Initialization functions
+ *  @brief    Initialization functions
+ *
+@verbatim
+ ===============================================================================
+                      ##### Initialization functions #####
+ ===============================================================================
+    [..]
+    This section provides functions allowing to:
+      (+) Mount the store and rebuild its index
+      (+) Erase the store
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Mounts the key-value store and rebuilds the in-RAM index.
+  * @param  hkv: key-value store handle, Init fields filled in.
+  * @note   The area is formatted when no bank holds a valid header.
+  * @retval HAL status: HAL_ERROR on a bad configuration or when the area
+  *         holds more live keys than KV_MAX_KEYS.
+  */
+HAL_StatusTypeDef KV_Init(KV_HandleTypeDef *hkv)
+{
+  uint32_t bank0 = 0, bank1 = 0;
+  uint32_t valid0 = 0, valid1 = 0;
+  uint16_t seq0 = 0, seq1 = 0;
+
+  if(hkv == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  /* Both banks must hold a bank header and at least one record */
+  if(((hkv->Init.BaseAddress & 3U) != 0U) || ((KV_BANK_SIZE(hkv) & 3U) != 0U) ||
+     (KV_BANK_SIZE(hkv) < (KV_BANK_HEADER_SIZE + KV_RECORD_SIZE(KV_MAX_VALUE_SIZE))))
+  {
+    return HAL_ERROR;
+  }
+
+  hkv->BatchDepth = 0;
+
+  bank0 = hkv->Init.BaseAddress;
+  bank1 = bank0 + KV_BANK_SIZE(hkv);
+  valid0 = KV_ReadBankHeader(bank0, &seq0);
+  valid1 = KV_ReadBankHeader(bank1, &seq1);
+
+  if((valid0 == 0U) && (valid1 == 0U))
+  {
+    return KV_Format(hkv);
+  }
+
+  /* The newest generation wins, wrap-around included */
+  if((valid1 != 0U) && ((valid0 == 0U) || ((int16_t)(seq1 - seq0) > 0)))
+  {
+    hkv->BankAddress = bank1;
+    hkv->Sequence = seq1;
+  }
+  else
+  {
+    hkv->BankAddress = bank0;
+    hkv->Sequence = seq0;
+  }
+
+  return KV_Scan(hkv);
+}
+
+/**
+  * @brief  Erases every key of the store.
+  * @param  hkv: key-value store handle, Init fields filled in.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef KV_Format(KV_HandleTypeDef *hkv)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t bank0 = hkv->Init.BaseAddress;
+  uint32_t bank1 = bank0 + KV_BANK_SIZE(hkv);
+  uint16_t seq0 = 0, seq1 = 0;
+  uint16_t sequence = 0;
+
+  /* Start above any generation left in the area so that its stale records
+     can never be taken for records of the new one */
+  KV_ReadBankHeader(bank0, &seq0);
+  KV_ReadBankHeader(bank1, &seq1);
+  sequence = (uint16_t)((((int16_t)(seq1 - seq0) > 0) ? seq1 : seq0) + 1U);
+
+  KV_Unlock(hkv);
+
+  /* Drop the other bank header, then open bank 0 with an empty log */
+  status = HAL_FLASHEx_DATAEEPROM_Erase(FLASH_TYPEERASEDATA_WORD, bank1);
+  if(status == HAL_OK)
+  {
+    status = KV_ProgramWord(bank0 + KV_BANK_HEADER_SIZE, 0);
+  }
+  if(status == HAL_OK)
+  {
+    status = KV_ProgramWord(bank0, ((uint32_t)KV_BANK_MAGIC << 16) | sequence);
+  }
+  if(status == HAL_OK)
+  {
+    status = KV_ProgramWord(bank0 + 4U, ~(((uint32_t)KV_BANK_MAGIC << 16) | sequence));
+  }
+
+  KV_Lock(hkv);
+
+  if(status == HAL_OK)
+  {
+    hkv->BankAddress = bank0;
+    hkv->Sequence = sequence;
+    hkv->WriteAddress = bank0 + KV_BANK_HEADER_SIZE;
+    hkv->KeyCount = 0;
+  }
+
+  return status;
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup EEPROM_KV_Exported_Functions_Group2 Record access functions
+ *  @brief    Record access functions
+ *
+@verbatim
+ ===============================================================================
+                      ##### Record access functions #####
+ ===============================================================================
+    [..]
+    This section provides functions allowing to:
+      (+) Read, write and delete values
+      (+) Group updates in one unlock window
+      (+) Force a compaction
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Reads the value of a key.
+  * @param  hkv: key-value store handle
+  * @param  Key: key to read
+  * @param  pData: destination buffer
+  * @param  Size: size of the destination buffer, the value is truncated to it
+  * @param  pLength: receives the full value length, can be NULL
+  * @retval HAL status: HAL_ERROR when the key is not stored.
+  */
+HAL_StatusTypeDef KV_Get(KV_HandleTypeDef *hkv, uint16_t Key, void *pData, uint32_t Size, uint32_t *pLength)
+{
+  uint32_t position = 0;
+  uint32_t length = 0;
+
+  if(KV_IndexFind(hkv, Key, &position) == 0U)
+  {
+    return HAL_ERROR;
+  }
+
+  length = hkv->Index[position].Length;
+  if(pLength != NULL)
+  {
+    *pLength = length;
+  }
+
+  memcpy(pData, (const void *)(hkv->Index[position].Address + KV_RECORD_HEADER_SIZE),
+         (length < Size) ? length : Size);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Stores the value of a key.
+  * @param  hkv: key-value store handle
+  * @param  Key: key to write
+  * @param  pData: value to store
+  * @param  Length: value length, up to KV_MAX_VALUE_SIZE bytes
+  * @note   Writing the value already stored programs nothing.
+  * @retval HAL status: HAL_ERROR when the value is too long, the index is
+  *         full or the programming fails.
+  */
+HAL_StatusTypeDef KV_Put(KV_HandleTypeDef *hkv, uint16_t Key, const void *pData, uint32_t Length)
+{
+  uint32_t position = 0;
+
+  if((Length > KV_MAX_VALUE_SIZE) || ((pData == NULL) && (Length != 0U)))
+  {
+    return HAL_ERROR;
+  }
+
+  if(KV_IndexFind(hkv, Key, &position) != 0U)
+  {
+    if((hkv->Index[position].Length == Length) &&
+       (memcmp((const void *)(hkv->Index[position].Address + KV_RECORD_HEADER_SIZE), pData, Length) == 0))
+    {
+      return HAL_OK;
+    }
+  }
+  else if(hkv->KeyCount >= KV_MAX_KEYS)
+  {
+    return HAL_ERROR;
+  }
+
+  return KV_Update(hkv, Key, KV_TAG_DATA, (const uint8_t *)pData, Length);
+}
+
+/**
+  * @brief  Removes a key from the store.
+  * @param  hkv: key-value store handle
+  * @param  Key: key to remove
+  * @retval HAL status: HAL_OK as well when the key is not stored.
+  */
+HAL_StatusTypeDef KV_Delete(KV_HandleTypeDef *hkv, uint16_t Key)
+{
+  uint32_t position = 0;
+
+  if(KV_IndexFind(hkv, Key, &position) == 0U)
+  {
+    return HAL_OK;
+  }
+
+  return KV_Update(hkv, Key, KV_TAG_DELETED, NULL, 0);
+}
+
+/**
+  * @brief  Opens a batch: the data EEPROM stays unlocked until the matching
+  *         KV_EndBatch() call. Batches can be nested.
+  * @param  hkv: key-value store handle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef KV_BeginBatch(KV_HandleTypeDef *hkv)
+{
+  KV_Unlock(hkv);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Closes a batch opened by KV_BeginBatch().
+  * @param  hkv: key-value store handle
+  * @retval HAL status: HAL_ERROR when no batch is open.
+  */
+HAL_StatusTypeDef KV_EndBatch(KV_HandleTypeDef *hkv)
+{
+  if(hkv->BatchDepth == 0U)
+  {
+    return HAL_ERROR;
+  }
+
+  KV_Lock(hkv);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Copies the live records to the spare bank, reclaiming the space
+  *         of overwritten and deleted values.
+  * @param  hkv: key-value store handle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef KV_Compact(KV_HandleTypeDef *hkv)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+
+  KV_Unlock(hkv);
+  status = KV_Rewrite(hkv, 0, KV_TAG_NONE, NULL, 0);
+  KV_Lock(hkv);
+
+  return status;
+}
+
+/**
+  * @brief  Returns the number of bytes left in the active bank before the
+  *         next compaction. A record takes 8 bytes plus its padded value.
+  * @param  hkv: key-value store handle
+  * @retval Free bytes
+  */
+uint32_t KV_GetFreeSpace(KV_HandleTypeDef *hkv)
+{
+  return KV_BANK_END(hkv) - hkv->WriteAddress;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup EEPROM_KV_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Computes the CRC-16 (CCITT) of a record.
+  * @param  Header: record header word
+  * @param  Sequence: bank generation the record belongs to
+  * @param  pData: record value
+  * @param  Length: value length
+  * @retval CRC value
+  */
+static uint16_t KV_RecordCrc(uint32_t Header, uint16_t Sequence, const uint8_t *pData, uint32_t Length)
+{
+  uint8_t  head[6];
+  uint16_t crc = KV_CRC_INIT;
+  uint32_t index = 0, bit = 0;
+  uint8_t  byte = 0;
+
+  head[0] = (uint8_t)Header;
+  head[1] = (uint8_t)(Header >> 8);
+  head[2] = (uint8_t)(Header >> 16);
+  head[3] = (uint8_t)(Header >> 24);
+  head[4] = (uint8_t)Sequence;
+  head[5] = (uint8_t)(Sequence >> 8);
+
+  for(index = 0; index < (sizeof(head) + Length); index++)
+  {
+    byte = (index < sizeof(head)) ? head[index] : pData[index - sizeof(head)];
+    crc ^= (uint16_t)byte << 8;
+    for(bit = 0; bit < 8U; bit++)
+    {
+      crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ KV_CRC_POLY) : (uint16_t)(crc << 1);
+    }
+  }
+
+  return crc;
+}
+
+/**
+  * @brief  Checks a bank header.
+  * @param  Address: bank start address
+  * @param  pSequence: receives the bank generation, left unchanged when the
+  *         header is not valid
+  * @retval 1 when the header is valid, 0 otherwise
+  */
+static uint32_t KV_ReadBankHeader(uint32_t Address, uint16_t *pSequence)
+{
+  uint32_t header = KV_READ_WORD(Address);
+
+  if(((header >> 16) != KV_BANK_MAGIC) || (KV_READ_WORD(Address + 4U) != ~header))
+  {
+    return 0;
+  }
+
+  *pSequence = (uint16_t)header;
+
+  return 1;
+}
+
+/**
+  * @brief  Replays the log of the active bank into the index and finds the
+  *         first free record slot.
+  * @param  hkv: key-value store handle
+  * @retval HAL status: HAL_ERROR when the index overflows.
+  */
+static HAL_StatusTypeDef KV_Scan(KV_HandleTypeDef *hkv)
+{
+  uint32_t address = hkv->BankAddress + KV_BANK_HEADER_SIZE;
+  uint32_t end = KV_BANK_END(hkv);
+  uint32_t header = 0, check = 0, length = 0, tag = 0;
+
+  hkv->KeyCount = 0;
+
+  while((address + KV_RECORD_HEADER_SIZE) <= end)
+  {
+    header = KV_READ_WORD(address);
+    tag = header & 0xFFU;
+    length = (header >> 8) & 0xFFU;
+
+    if(((tag != KV_TAG_DATA) && (tag != KV_TAG_DELETED)) ||
+       ((tag == KV_TAG_DELETED) && (length != 0U)) ||
+       ((address + KV_RECORD_SIZE(length)) > end))
+    {
+      break;
+    }
+
+    /* A stale record of an older generation or a torn write ends the log */
+    check = KV_READ_WORD(address + 4U);
+    if(((check >> 16) != hkv->Sequence) ||
+       ((uint16_t)check != KV_RecordCrc(header, hkv->Sequence,
+                                        (const uint8_t *)(address + KV_RECORD_HEADER_SIZE), length)))
+    {
+      break;
+    }
+
+    if(tag == KV_TAG_DELETED)
+    {
+      KV_IndexRemove(hkv, (uint16_t)(header >> 16));
+    }
+    else if(KV_IndexUpdate(hkv, (uint16_t)(header >> 16), (uint16_t)length, address) != HAL_OK)
+    {
+      return HAL_ERROR;
+    }
+
+    address += KV_RECORD_SIZE(length);
+  }
+
+  hkv->WriteAddress = address;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Looks a key up in the sorted index.
+  * @param  hkv: key-value store handle
+  * @param  Key: key to look up
+  * @param  pPosition: receives the entry position, or the insertion position
+  *         when the key is not found
+  * @retval 1 when the key is found, 0 otherwise
+  */
+static uint32_t KV_IndexFind(KV_HandleTypeDef *hkv, uint16_t Key, uint32_t *pPosition)
+{
+  uint32_t low = 0, high = hkv->KeyCount, middle = 0;
+
+  while(low < high)
+  {
+    middle = (low + high) / 2U;
+    if(hkv->Index[middle].Key < Key)
+    {
+      low = middle + 1U;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  *pPosition = low;
+
+  return ((low < hkv->KeyCount) && (hkv->Index[low].Key == Key)) ? 1U : 0U;
+}
+
+/**
+  * @brief  Points the index entry of a key at its latest record.
+  * @param  hkv: key-value store handle
+  * @param  Key: record key
+  * @param  Length: value length
+  * @param  Address: record address
+  * @retval HAL status: HAL_ERROR when a new key does not fit in the index.
+  */
+static HAL_StatusTypeDef KV_IndexUpdate(KV_HandleTypeDef *hkv, uint16_t Key, uint16_t Length, uint32_t Address)
+{
+  uint32_t position = 0;
+
+  if(KV_IndexFind(hkv, Key, &position) == 0U)
+  {
+    if(hkv->KeyCount >= KV_MAX_KEYS)
+    {
+      return HAL_ERROR;
+    }
+    memmove(&hkv->Index[position + 1U], &hkv->Index[position],
+            (hkv->KeyCount - position) * sizeof(KV_IndexTypeDef));
+    hkv->KeyCount++;
+    hkv->Index[position].Key = Key;
+  }
+
+  hkv->Index[position].Length = Length;
+  hkv->Index[position].Address = Address;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Removes a key from the index.
+  * @param  hkv: key-value store handle
+  * @param  Key: key to remove
+  * @retval None
+  */
+static void KV_IndexRemove(KV_HandleTypeDef *hkv, uint16_t Key)
+{
+  uint32_t position = 0;
+
+  if(KV_IndexFind(hkv, Key, &position) != 0U)
+  {
+    hkv->KeyCount--;
+    memmove(&hkv->Index[position], &hkv->Index[position + 1U],
+            (hkv->KeyCount - position) * sizeof(KV_IndexTypeDef));
+  }
+}
+
+/**
+  * @brief  Unlocks the data EEPROM unless a batch already did.
+  * @param  hkv: key-value store handle
+  * @retval None
+  */
+static void KV_Unlock(KV_HandleTypeDef *hkv)
+{
+  if(hkv->BatchDepth++ == 0U)
+  {
+    HAL_FLASHEx_DATAEEPROM_Unlock();
+  }
+}
+
+/**
+  * @brief  Locks the data EEPROM when the outermost batch ends.
+  * @param  hkv: key-value store handle
+  * @retval None
+  */
+static void KV_Lock(KV_HandleTypeDef *hkv)
+{
+  if(--hkv->BatchDepth == 0U)
+  {
+    HAL_FLASHEx_DATAEEPROM_Lock();
+  }
+}
+
+/**
+  * @brief  Programs a data EEPROM word, skipping words already holding the
+  *         value to save a write cycle.
+  * @param  Address: word address
+  * @param  Data: value to program
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef KV_ProgramWord(uint32_t Address, uint32_t Data)
+{
+  if(KV_READ_WORD(Address) == Data)
+  {
+    return HAL_OK;
+  }
+
+  return HAL_FLASHEx_DATAEEPROM_Program(FLASH_TYPEPROGRAMDATA_WORD, Address, Data);
+}
+
+/**
+  * @brief  Ends the log at a record slot: clears its header word when the
+  *         slot holds a record of the same generation, left there by an
+  *         interrupted compaction.
+  * @param  Address: record slot following the last record of the log
+  * @param  End: end of the bank
+  * @param  Sequence: bank generation
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef KV_EndLog(uint32_t Address, uint32_t End, uint16_t Sequence)
+{
+  if(((Address + KV_RECORD_HEADER_SIZE) > End) || ((KV_READ_WORD(Address + 4U) >> 16) != Sequence))
+  {
+    return HAL_OK;
+  }
+
+  return KV_ProgramWord(Address, 0);
+}
+
+/**
+  * @brief  Programs a record: value first, then the check word, then the
+  *         header word which commits it.
+  * @param  Address: record address
+  * @param  Header: record header word
+  * @param  Sequence: bank generation
+  * @param  pData: record value, can be located in the data EEPROM
+  * @param  Length: value length
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef KV_WriteRecord(uint32_t Address, uint32_t Header, uint16_t Sequence, const uint8_t *pData, uint32_t Length)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t offset = 0, index = 0, word = 0;
+
+  for(offset = 0; (offset < Length) && (status == HAL_OK); offset += 4U)
+  {
+    word = 0;
+    for(index = 0; (index < 4U) && ((offset + index) < Length); index++)
+    {
+      word |= (uint32_t)pData[offset + index] << (8U * index);
+    }
+    status = KV_ProgramWord(Address + KV_RECORD_HEADER_SIZE + offset, word);
+  }
+
+  if(status == HAL_OK)
+  {
+    status = KV_ProgramWord(Address + 4U,
+                            ((uint32_t)Sequence << 16) | KV_RecordCrc(Header, Sequence, pData, Length));
+  }
+  if(status == HAL_OK)
+  {
+    status = KV_ProgramWord(Address, Header);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Appends a data or deletion record, compacting the store first
+  *         when the active bank is full.
+  * @param  hkv: key-value store handle
+  * @param  Key: record key
+  * @param  Tag: KV_TAG_DATA or KV_TAG_DELETED
+  * @param  pData: record value
+  * @param  Length: value length
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef KV_Update(KV_HandleTypeDef *hkv, uint16_t Key, uint32_t Tag, const uint8_t *pData, uint32_t Length)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t address = hkv->WriteAddress;
+
+  KV_Unlock(hkv);
+
+  if((address + KV_RECORD_SIZE(Length)) > KV_BANK_END(hkv))
+  {
+    status = KV_Rewrite(hkv, Key, Tag, pData, Length);
+  }
+  else
+  {
+    status = KV_EndLog(address + KV_RECORD_SIZE(Length), KV_BANK_END(hkv), hkv->Sequence);
+    if(status == HAL_OK)
+    {
+      status = KV_WriteRecord(address, KV_HEADER(Key, Length, Tag), hkv->Sequence, pData, Length);
+    }
+    if(status == HAL_OK)
+    {
+      hkv->WriteAddress = address + KV_RECORD_SIZE(Length);
+      if(Tag == KV_TAG_DELETED)
+      {
+        KV_IndexRemove(hkv, Key);
+      }
+      else
+      {
+        status = KV_IndexUpdate(hkv, Key, (uint16_t)Length, address);
+      }
+    }
+  }
+
+  KV_Lock(hkv);
+
+  return status;
+}
+
+/**
+  * @brief  Copies the live records to the spare bank together with a pending
+  *         update, then makes the spare bank active.
+  * @param  hkv: key-value store handle
+  * @param  Key: key of the pending update
+  * @param  Tag: KV_TAG_DATA to store pData, KV_TAG_DELETED to drop the key,
+  *         KV_TAG_NONE for a plain compaction
+  * @param  pData: value of the pending update
+  * @param  Length: value length
+  * @note   The data EEPROM must be unlocked.
+  * @retval HAL status: HAL_ERROR when the live records do not fit in a bank.
+  */
+static HAL_StatusTypeDef KV_Rewrite(KV_HandleTypeDef *hkv, uint16_t Key, uint32_t Tag, const uint8_t *pData, uint32_t Length)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t bank = 0, end = 0, address = 0, index = 0, header = 0;
+  uint16_t sequence = (uint16_t)(hkv->Sequence + 1U);
+  KV_IndexTypeDef *entry = NULL;
+
+  bank = (hkv->BankAddress == hkv->Init.BaseAddress) ?
+         (hkv->Init.BaseAddress + KV_BANK_SIZE(hkv)) : hkv->Init.BaseAddress;
+  end = bank + KV_BANK_SIZE(hkv);
+  address = bank + KV_BANK_HEADER_SIZE;
+
+  for(index = 0; (index < hkv->KeyCount) && (status == HAL_OK); index++)
+  {
+    entry = &hkv->Index[index];
+    if((Tag != KV_TAG_NONE) && (entry->Key == Key))
+    {
+      continue;
+    }
+    if((address + KV_RECORD_SIZE(entry->Length)) > end)
+    {
+      return HAL_ERROR;
+    }
+    status = KV_WriteRecord(address, KV_READ_WORD(entry->Address), sequence,
+                            (const uint8_t *)(entry->Address + KV_RECORD_HEADER_SIZE), entry->Length);
+    address += KV_RECORD_SIZE(entry->Length);
+  }
+
+  /* A deleted key is simply left out of the new bank */
+  if((status == HAL_OK) && (Tag == KV_TAG_DATA))
+  {
+    if((address + KV_RECORD_SIZE(Length)) > end)
+    {
+      return HAL_ERROR;
+    }
+    status = KV_WriteRecord(address, KV_HEADER(Key, Length, Tag), sequence, pData, Length);
+    address += KV_RECORD_SIZE(Length);
+  }
+
+  /* Leftovers of an interrupted compaction to this generation end here */
+  if(status == HAL_OK)
+  {
+    status = KV_EndLog(address, end, sequence);
+  }
+
+  /* Commit: the bank becomes the newest one once both header words match */
+  header = ((uint32_t)KV_BANK_MAGIC << 16) | sequence;
+  if(status == HAL_OK)
+  {
+    status = KV_ProgramWord(bank, header);
+  }
+  if(status == HAL_OK)
+  {
+    status = KV_ProgramWord(bank + 4U, ~header);
+  }
+
+  if(status == HAL_OK)
+  {
+    hkv->BankAddress = bank;
+    hkv->Sequence = sequence;
+    status = KV_Scan(hkv);
+  }
+
+  return status;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
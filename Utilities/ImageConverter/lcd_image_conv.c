@@ -0,0 +1,388 @@
+/**
+  ******************************************************************************
+  * @file    lcd_image_conv.c
+  * @brief   Host tool converting a BMP picture into the run-length encoded
+  *          image format drawn by BSP_LCD_DrawRLEImage().
+  @verbatim
+  ==============================================================================
+                     ##### How to use this tool #####
+  ==============================================================================
+  [..]
+   (#) Build it with any C99 host compiler:
+         cc -O2 -o lcd_image_conv lcd_image_conv.c
+   (#) Convert an uncompressed 16, 24 or 32 bpp BMP file into a C array:
+         lcd_image_conv logo.bmp logo.c logo
+       16 bpp files are RGB(5-5-5), or RGB(5-6-5) when their BI_BITFIELDS
+       masks say so.
+   (#) Pictures with at most 256 colors are palette indexed, the others keep
+       RGB(5-6-5) pixels. Both are run-length encoded, top-down.
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define RLE_HEADER_SIZE      12
+#define RLE_FORMAT_RGB565    0x00
+#define RLE_FORMAT_INDEXED   0x01
+#define RLE_MAX_PACKET       128
+#define RLE_MIN_RUN          3
+
+/* Private types -------------------------------------------------------------*/
+typedef struct
+{
+  uint8_t  *pData;
+  uint32_t Size;
+  uint32_t Capacity;
+} Buffer_TypeDef;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t rd16(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static uint32_t rd32(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put8(Buffer_TypeDef *pBuf, uint8_t Value)
+{
+  if(pBuf->Size == pBuf->Capacity)
+  {
+    pBuf->Capacity = (pBuf->Capacity == 0) ? 4096 : (pBuf->Capacity * 2);
+    pBuf->pData = realloc(pBuf->pData, pBuf->Capacity);
+    if(pBuf->pData == NULL)
+    {
+      fprintf(stderr, "out of memory\n");
+      exit(1);
+    }
+  }
+  pBuf->pData[pBuf->Size++] = Value;
+}
+
+static void put16(Buffer_TypeDef *pBuf, uint16_t Value)
+{
+  put8(pBuf, (uint8_t)Value);
+  put8(pBuf, (uint8_t)(Value >> 8));
+}
+
+static uint8_t *load_file(const char *pName, uint32_t *pSize)
+{
+  FILE *f = fopen(pName, "rb");
+  uint8_t *pdata = NULL;
+  long size = 0;
+
+  if(f == NULL)
+  {
+    return NULL;
+  }
+  fseek(f, 0, SEEK_END);
+  size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  pdata = malloc((size_t)size);
+  if((pdata != NULL) && (fread(pdata, 1, (size_t)size, f) != (size_t)size))
+  {
+    free(pdata);
+    pdata = NULL;
+  }
+  fclose(f);
+  *pSize = (uint32_t)size;
+  return pdata;
+}
+
+/**
+  * @brief  Decodes a BMP file into top-down RGB(5-6-5) pixels.
+  * @retval Pixels array or NULL on unsupported file
+  */
+static uint16_t *decode_bmp(const uint8_t *pBmp, uint32_t Size, uint32_t *pWidth, uint32_t *pHeight)
+{
+  uint32_t offset, bpp, compression, stride, x, y, row;
+  uint32_t rmask = 0, gmask = 0, bmask = 0;
+  int32_t width, height;
+  int bottomup = 1, rgb565 = 0;
+  const uint8_t *ppix;
+  uint16_t *pout;
+
+  if((Size < 54) || (pBmp[0] != 'B') || (pBmp[1] != 'M'))
+  {
+    return NULL;
+  }
+
+  offset      = rd32(pBmp + 10);
+  width       = (int32_t)rd32(pBmp + 18);
+  height      = (int32_t)rd32(pBmp + 22);
+  bpp         = rd16(pBmp + 28);
+  compression = rd32(pBmp + 30);
+
+  if(height < 0)
+  {
+    height = -height;
+    bottomup = 0;
+  }
+
+  if((width <= 0) || (height == 0) || (width > 0xFFFF) || (height > 0xFFFF) ||
+     ((bpp != 16) && (bpp != 24) && (bpp != 32)) || ((compression != 0) && (compression != 3)))
+  {
+    return NULL;
+  }
+
+  /* BI_RGB is RGB(5-5-5) at 16 bpp. BI_BITFIELDS masks follow the 40-byte
+     info header, and only the usual RGB(5-5-5), RGB(5-6-5) and 8-8-8
+     layouts are taken */
+  if(compression == 3)
+  {
+    if(Size < 66)
+    {
+      return NULL;
+    }
+    rmask = rd32(pBmp + 54);
+    gmask = rd32(pBmp + 58);
+    bmask = rd32(pBmp + 62);
+    if((bpp == 16) && (rmask == 0xF800) && (gmask == 0x07E0) && (bmask == 0x001F))
+    {
+      rgb565 = 1;
+    }
+    else if(!((bpp == 16) && (rmask == 0x7C00) && (gmask == 0x03E0) && (bmask == 0x001F)) &&
+            !((bpp == 32) && (rmask == 0xFF0000) && (gmask == 0xFF00) && (bmask == 0xFF)))
+    {
+      return NULL;
+    }
+  }
+
+  stride = ((width * bpp / 8) + 3) & ~3u;
+  if(offset + (stride * height) > Size)
+  {
+    return NULL;
+  }
+
+  pout = malloc(sizeof(uint16_t) * width * height);
+  if(pout == NULL)
+  {
+    return NULL;
+  }
+
+  for(y = 0; y < (uint32_t)height; y++)
+  {
+    row  = bottomup ? ((uint32_t)height - 1 - y) : y;
+    ppix = pBmp + offset + (row * stride);
+
+    for(x = 0; x < (uint32_t)width; x++)
+    {
+      uint16_t color;
+
+      if((bpp == 16) && rgb565)
+      {
+        color = (uint16_t)rd16(ppix + (x * 2));
+      }
+      else if(bpp == 16)
+      {
+        /* RGB(5-5-5): the 6-bit green repeats its top bit */
+        color = (uint16_t)rd16(ppix + (x * 2));
+        color = (uint16_t)(((color & 0x7C00) << 1) | ((color & 0x03E0) << 1) | ((color & 0x0200) >> 4) | (color & 0x001F));
+      }
+      else
+      {
+        const uint8_t *p = ppix + (x * (bpp / 8));
+        color = (uint16_t)(((p[2] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[0] >> 3));
+      }
+      pout[(y * width) + x] = color;
+    }
+  }
+
+  *pWidth  = (uint32_t)width;
+  *pHeight = (uint32_t)height;
+  return pout;
+}
+
+/**
+  * @brief  Builds the palette, returns the number of colors or 0 if more than 256.
+  */
+static uint32_t build_palette(const uint16_t *pPixels, uint32_t Count, uint16_t *pPalette, uint8_t *pIndex)
+{
+  static int16_t lut[65536];
+  uint32_t colors = 0, i;
+
+  memset(lut, 0xFF, sizeof(lut));
+  for(i = 0; i < Count; i++)
+  {
+    if(lut[pPixels[i]] < 0)
+    {
+      if(colors == 256)
+      {
+        return 0;
+      }
+      lut[pPixels[i]] = (int16_t)colors;
+      pPalette[colors++] = pPixels[i];
+    }
+    pIndex[i] = (uint8_t)lut[pPixels[i]];
+  }
+  return colors;
+}
+
+static void put_pixel(Buffer_TypeDef *pBuf, const uint16_t *pPixels, const uint8_t *pIndex, uint32_t Pos)
+{
+  if(pIndex != NULL)
+  {
+    put8(pBuf, pIndex[Pos]);
+  }
+  else
+  {
+    put16(pBuf, pPixels[Pos]);
+  }
+}
+
+/**
+  * @brief  Run-length encodes the pixels (indexes when pIndex is not NULL).
+  */
+static void encode_rle(Buffer_TypeDef *pBuf, const uint16_t *pPixels, const uint8_t *pIndex, uint32_t Count)
+{
+  uint32_t pos = 0, run, lit, i;
+
+#define SAME(a, b) ((pIndex != NULL) ? (pIndex[a] == pIndex[b]) : (pPixels[a] == pPixels[b]))
+
+  while(pos < Count)
+  {
+    /* Length of the run starting at pos */
+    run = 1;
+    while(((pos + run) < Count) && (run < RLE_MAX_PACKET) && SAME(pos, pos + run))
+    {
+      run++;
+    }
+
+    if(run >= RLE_MIN_RUN)
+    {
+      put8(pBuf, (uint8_t)(0x80 | (run - 1)));
+      put_pixel(pBuf, pPixels, pIndex, pos);
+      pos += run;
+      continue;
+    }
+
+    /* Literal packet up to the next worthwhile run */
+    lit = 0;
+    while(((pos + lit) < Count) && (lit < RLE_MAX_PACKET))
+    {
+      run = 1;
+      while(((pos + lit + run) < Count) && (run < RLE_MIN_RUN) && SAME(pos + lit, pos + lit + run))
+      {
+        run++;
+      }
+      if(run >= RLE_MIN_RUN)
+      {
+        break;
+      }
+      lit++;
+    }
+
+    put8(pBuf, (uint8_t)(lit - 1));
+    for(i = 0; i < lit; i++)
+    {
+      put_pixel(pBuf, pPixels, pIndex, pos + i);
+    }
+    pos += lit;
+  }
+
+#undef SAME
+}
+
+static int write_c_array(const char *pName, const char *pSymbol, const Buffer_TypeDef *pBuf,
+                         const char *pSource, uint32_t Width, uint32_t Height)
+{
+  FILE *f = fopen(pName, "w");
+  uint32_t i;
+
+  if(f == NULL)
+  {
+    return -1;
+  }
+
+  fprintf(f, "/* Generated by lcd_image_conv from %s: %ux%u, %u bytes (raw RGB565: %u bytes) */\n",
+          pSource, (unsigned)Width, (unsigned)Height, (unsigned)pBuf->Size, (unsigned)(Width * Height * 2));
+  fprintf(f, "#include <stdint.h>\n\n");
+  fprintf(f, "const uint8_t %s[%u] =\n{", pSymbol, (unsigned)pBuf->Size);
+  for(i = 0; i < pBuf->Size; i++)
+  {
+    fprintf(f, "%s0x%02X%s", ((i % 16) == 0) ? "\n  " : "", pBuf->pData[i], (i + 1 < pBuf->Size) ? ", " : "");
+  }
+  fprintf(f, "\n};\n");
+
+  return fclose(f);
+}
+
+int main(int argc, char **argv)
+{
+  Buffer_TypeDef out = {0};
+  uint16_t palette[256];
+  uint16_t *ppixels;
+  uint8_t *pbmp, *pindex;
+  uint32_t size = 0, width = 0, height = 0, count, colors, i;
+
+  if(argc != 4)
+  {
+    fprintf(stderr, "usage: %s <input.bmp> <output.c> <symbol>\n", argv[0]);
+    return 2;
+  }
+
+  pbmp = load_file(argv[1], &size);
+  if(pbmp == NULL)
+  {
+    fprintf(stderr, "cannot read %s\n", argv[1]);
+    return 1;
+  }
+
+  ppixels = decode_bmp(pbmp, size, &width, &height);
+  if(ppixels == NULL)
+  {
+    fprintf(stderr, "%s: unsupported BMP (16, 24 or 32 bpp uncompressed, or the usual bit fields, only)\n", argv[1]);
+    return 1;
+  }
+
+  count  = width * height;
+  pindex = malloc(count);
+  colors = (pindex != NULL) ? build_palette(ppixels, count, palette, pindex) : 0;
+
+  /* Header */
+  put8(&out, 'R');
+  put8(&out, 'L');
+  put8(&out, 'I');
+  put8(&out, '1');
+  put16(&out, (uint16_t)width);
+  put16(&out, (uint16_t)height);
+  put8(&out, (colors != 0) ? RLE_FORMAT_INDEXED : RLE_FORMAT_RGB565);
+  put8(&out, (uint8_t)colors);
+  put16(&out, 0);
+
+  if(colors != 0)
+  {
+    for(i = 0; i < colors; i++)
+    {
+      put16(&out, palette[i]);
+    }
+    encode_rle(&out, ppixels, pindex, count);
+  }
+  else
+  {
+    encode_rle(&out, ppixels, NULL, count);
+  }
+
+  if(write_c_array(argv[2], argv[3], &out, argv[1], width, height) != 0)
+  {
+    fprintf(stderr, "cannot write %s\n", argv[2]);
+    return 1;
+  }
+
+  printf("%s: %ux%u, %u colors%s, %u -> %u bytes\n", argv[1], (unsigned)width, (unsigned)height,
+         (unsigned)colors, (colors != 0) ? "" : " (>256, RGB565)", (unsigned)(count * 2), (unsigned)out.Size);
+
+  free(out.pData);
+  free(pindex);
+  free(ppixels);
+  free(pbmp);
+  return 0;
+}